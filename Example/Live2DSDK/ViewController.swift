@@ -288,12 +288,14 @@ extension ViewController {
         stopAmplitudeAudioEngine()
         let inputNode = audioEngine.inputNode
         let format = inputNode.outputFormat(forBus: 0)
+        NYLDModelManager.shared().startLipSyncAnalysis(withSampleRate: format.sampleRate)
         
         inputNode.installTap(onBus: 0, bufferSize: 1024, format: format) { [weak self] buffer, _ in
             guard let `self` = self else { return }
             guard let floatChannelData = buffer.floatChannelData else { return }
             let frameLength = Int(buffer.frameLength)
             let samples = floatChannelData[0]
+            NYLDModelManager.shared().appendLipSyncPCM(samples, count: frameLength)
             
             let batchSize = 64
             var batchAmplitudes: [Float] = []
@@ -329,6 +331,7 @@ extension ViewController {
     func stopAmplitudeAudioEngine() {
         audioEngine.stop()
         audioEngine.inputNode.removeTap(onBus: 0)
+        NYLDModelManager.shared().stopLipSyncAnalysis()
         NYLDModelManager.shared().mouthOpenRate = 0.0
         
         freshAIAnswerTextView(text: "", shouldHide: true)
@@ -7,6 +7,7 @@
 
 #include "CubismFramework.hpp"
 #include "CubismDebug.hpp"
+#include "CubismProfiler.hpp"
 #include "CubismJson.hpp"
 #include "CubismIdManager.hpp"
 #include "CubismRenderer.hpp"
@@ -224,6 +225,8 @@ void* CubismFramework::Allocate(csmSizeType size, const csmChar* fileName, csmIn
 {
     void* address = GetAllocator()->Allocate(size);
 
+    CSM_PROFILE_COUNTER_ADD(Counter_Allocations, 1);
+
     CubismLogVerbose("CubismFramework::Allocate(0x%p, %dbytes) %s(%d)", address, size, fileName, lineNumber);
 
     if (s_allocationList)
@@ -238,6 +241,8 @@ void* CubismFramework::AllocateAligned(csmSizeType size, csmUint32 alignment, co
 {
     void* address = GetAllocator()->AllocateAligned(size, alignment);
 
+    CSM_PROFILE_COUNTER_ADD(Counter_Allocations, 1);
+
     CubismLogVerbose("CubismFramework::AllocateAligned(0x%p, a:%d, %dbytes) %s(%d)", address, alignment, size, fileName, lineNumber);
 
     if (s_allocationList)
@@ -304,11 +309,15 @@ void CubismFramework::DeallocateAligned(void* address, const csmChar* fileName,
 
 void* CubismFramework::Allocate(csmSizeType size)
 {
+    CSM_PROFILE_COUNTER_ADD(Counter_Allocations, 1);
+
     return GetAllocator()->Allocate(size);
 }
 
 void* CubismFramework::AllocateAligned(csmSizeType size, csmUint32 alignment)
 {
+    CSM_PROFILE_COUNTER_ADD(Counter_Allocations, 1);
+
     return GetAllocator()->AllocateAligned(size, alignment);
 }
 
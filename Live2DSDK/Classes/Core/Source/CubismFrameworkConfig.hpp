@@ -24,6 +24,13 @@
  */
 // #define CSM_DEBUG_MEMORY_LEAKING
 
+/**
+ * Enables the frame profiler.
+ *
+ * @note When not defined, the CSM_PROFILE_* macros expand to nothing and CubismProfiler is not compiled.
+ */
+// #define CSM_PROFILE
+
 
 /**
  * A set of macros to configure the logging level forcefully.
@@ -7,7 +7,86 @@
 
 #include "CubismMatrix44.hpp"
 
+// Define CSM_NO_SIMD to build the scalar code only, e.g. to test it on a SIMD capable machine.
+#if defined(CSM_NO_SIMD)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CSM_MATRIX44_NEON
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CSM_MATRIX44_SSE
+#endif
+
 namespace Live2D { namespace Cubism { namespace Framework {
+
+namespace {
+
+#if defined(CSM_MATRIX44_NEON)
+typedef float32x4_t Vec4;
+
+inline Vec4 Load4(const csmFloat32* p) { return vld1q_f32(p); }
+inline void Store4(csmFloat32* p, Vec4 v) { vst1q_f32(p, v); }
+inline Vec4 Splat4(csmFloat32 x) { return vdupq_n_f32(x); }
+inline Vec4 Set4(csmFloat32 x, csmFloat32 y, csmFloat32 z, csmFloat32 w) { const csmFloat32 v[4] = { x, y, z, w }; return vld1q_f32(v); }
+inline Vec4 Add4(Vec4 a, Vec4 b) { return vaddq_f32(a, b); }
+inline Vec4 Sub4(Vec4 a, Vec4 b) { return vsubq_f32(a, b); }
+inline Vec4 Mul4(Vec4 a, Vec4 b) { return vmulq_f32(a, b); }
+inline csmFloat32 Lane0(Vec4 v) { return vgetq_lane_f32(v, 0); }
+
+// (a[n], a[n], b[n], b[n])
+template <int N>
+inline Vec4 SplatPair4(Vec4 a, Vec4 b)
+{
+    return vcombine_f32(vdup_n_f32(vgetq_lane_f32(a, N)), vdup_n_f32(vgetq_lane_f32(b, N)));
+}
+
+inline void Transpose4(Vec4& r0, Vec4& r1, Vec4& r2, Vec4& r3)
+{
+    const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+    const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+#elif defined(CSM_MATRIX44_SSE)
+typedef __m128 Vec4;
+
+inline Vec4 Load4(const csmFloat32* p) { return _mm_loadu_ps(p); }
+inline void Store4(csmFloat32* p, Vec4 v) { _mm_storeu_ps(p, v); }
+inline Vec4 Splat4(csmFloat32 x) { return _mm_set1_ps(x); }
+inline Vec4 Set4(csmFloat32 x, csmFloat32 y, csmFloat32 z, csmFloat32 w) { return _mm_setr_ps(x, y, z, w); }
+inline Vec4 Add4(Vec4 a, Vec4 b) { return _mm_add_ps(a, b); }
+inline Vec4 Sub4(Vec4 a, Vec4 b) { return _mm_sub_ps(a, b); }
+inline Vec4 Mul4(Vec4 a, Vec4 b) { return _mm_mul_ps(a, b); }
+inline csmFloat32 Lane0(Vec4 v) { return _mm_cvtss_f32(v); }
+
+// (a[n], a[n], b[n], b[n])
+template <int N>
+inline Vec4 SplatPair4(Vec4 a, Vec4 b)
+{
+    return _mm_shuffle_ps(a, b, _MM_SHUFFLE(N, N, N, N));
+}
+
+inline void Transpose4(Vec4& r0, Vec4& r1, Vec4& r2, Vec4& r3)
+{
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+}
+#endif
+
+#if defined(CSM_MATRIX44_NEON) || defined(CSM_MATRIX44_SSE)
+// 2x2 minors of the column pair (p, q) stored as (c, c, s, s),
+// where c is taken from rows 2 and 3 and s is taken from rows 0 and 1.
+template <int P, int Q>
+inline Vec4 PairMinor4(Vec4 row0, Vec4 row1, Vec4 row2, Vec4 row3)
+{
+    return Sub4(Mul4(SplatPair4<P>(row2, row0), SplatPair4<Q>(row3, row1)),
+                Mul4(SplatPair4<P>(row3, row1), SplatPair4<Q>(row2, row0)));
+}
+#endif
+
+}
+
 CubismMatrix44::CubismMatrix44()
 {
     LoadIdentity();
@@ -35,6 +114,30 @@ csmFloat32* CubismMatrix44::GetArray()
 
 void CubismMatrix44::Multiply(csmFloat32* a, csmFloat32* b, csmFloat32* dst)
 {
+#if defined(CSM_MATRIX44_NEON) || defined(CSM_MATRIX44_SSE)
+    // Each row of the result is a linear combination of the rows of b.
+    // All rows are kept in registers until the end, so dst may be the same array as a or b.
+    const Vec4 b0 = Load4(b);
+    const Vec4 b1 = Load4(b + 4);
+    const Vec4 b2 = Load4(b + 8);
+    const Vec4 b3 = Load4(b + 12);
+
+    Vec4 c[4];
+    for (csmInt32 i = 0; i < 4; ++i)
+    {
+        const csmFloat32* ai = a + i * 4;
+        Vec4 row = Mul4(Splat4(ai[0]), b0);
+        row = Add4(row, Mul4(Splat4(ai[1]), b1));
+        row = Add4(row, Mul4(Splat4(ai[2]), b2));
+        row = Add4(row, Mul4(Splat4(ai[3]), b3));
+        c[i] = row;
+    }
+
+    Store4(dst, c[0]);
+    Store4(dst + 4, c[1]);
+    Store4(dst + 8, c[2]);
+    Store4(dst + 12, c[3]);
+#else
     csmFloat32 c[16] = {
                         0.0f, 0.0f, 0.0f, 0.0f,
                         0.0f, 0.0f, 0.0f, 0.0f,
@@ -58,6 +161,155 @@ void CubismMatrix44::Multiply(csmFloat32* a, csmFloat32* b, csmFloat32* dst)
     {
         dst[i] = c[i];
     }
+#endif
+}
+
+csmBool CubismMatrix44::Invert(const csmFloat32* src, csmFloat32* dst)
+{
+#if defined(CSM_MATRIX44_NEON) || defined(CSM_MATRIX44_SSE)
+    const Vec4 r0 = Load4(src);
+    const Vec4 r1 = Load4(src + 4);
+    const Vec4 r2 = Load4(src + 8);
+    const Vec4 r3 = Load4(src + 12);
+
+    // Dpq = (c, c, s, s) for the 2x2 minors of columns p and q
+    const Vec4 d01 = PairMinor4<0, 1>(r0, r1, r2, r3);
+    const Vec4 d02 = PairMinor4<0, 2>(r0, r1, r2, r3);
+    const Vec4 d03 = PairMinor4<0, 3>(r0, r1, r2, r3);
+    const Vec4 d12 = PairMinor4<1, 2>(r0, r1, r2, r3);
+    const Vec4 d13 = PairMinor4<1, 3>(r0, r1, r2, r3);
+    const Vec4 d23 = PairMinor4<2, 3>(r0, r1, r2, r3);
+
+    // xk = (src[4 + k], src[k], src[12 + k], src[8 + k])
+    Vec4 x0 = r1;
+    Vec4 x1 = r0;
+    Vec4 x2 = r3;
+    Vec4 x3 = r2;
+    Transpose4(x0, x1, x2, x3);
+
+    // Rows of the adjugate matrix before the alternating signs are applied
+    const Vec4 u0 = Add4(Sub4(Mul4(x1, d23), Mul4(x2, d13)), Mul4(x3, d12));
+    const Vec4 u1 = Add4(Sub4(Mul4(x0, d23), Mul4(x2, d03)), Mul4(x3, d02));
+    const Vec4 u2 = Add4(Sub4(Mul4(x0, d13), Mul4(x1, d03)), Mul4(x3, d01));
+    const Vec4 u3 = Add4(Sub4(Mul4(x0, d12), Mul4(x1, d02)), Mul4(x2, d01));
+
+    const csmFloat32 det = src[0] * Lane0(u0) - src[1] * Lane0(u1) + src[2] * Lane0(u2) - src[3] * Lane0(u3);
+    if (det == 0.0f)
+    {
+        return false;
+    }
+
+    const csmFloat32 invDet = 1.0f / det;
+    const Vec4 evenRow = Set4(invDet, -invDet, invDet, -invDet);
+    const Vec4 oddRow = Set4(-invDet, invDet, -invDet, invDet);
+
+    Store4(dst, Mul4(u0, evenRow));
+    Store4(dst + 4, Mul4(u1, oddRow));
+    Store4(dst + 8, Mul4(u2, evenRow));
+    Store4(dst + 12, Mul4(u3, oddRow));
+#else
+    const csmFloat32* m = src;
+
+    const csmFloat32 s0 = m[0] * m[5] - m[4] * m[1];
+    const csmFloat32 s1 = m[0] * m[6] - m[4] * m[2];
+    const csmFloat32 s2 = m[0] * m[7] - m[4] * m[3];
+    const csmFloat32 s3 = m[1] * m[6] - m[5] * m[2];
+    const csmFloat32 s4 = m[1] * m[7] - m[5] * m[3];
+    const csmFloat32 s5 = m[2] * m[7] - m[6] * m[3];
+
+    const csmFloat32 c0 = m[8] * m[13] - m[12] * m[9];
+    const csmFloat32 c1 = m[8] * m[14] - m[12] * m[10];
+    const csmFloat32 c2 = m[8] * m[15] - m[12] * m[11];
+    const csmFloat32 c3 = m[9] * m[14] - m[13] * m[10];
+    const csmFloat32 c4 = m[9] * m[15] - m[13] * m[11];
+    const csmFloat32 c5 = m[10] * m[15] - m[14] * m[11];
+
+    const csmFloat32 det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (det == 0.0f)
+    {
+        return false;
+    }
+
+    const csmFloat32 invDet = 1.0f / det;
+
+    csmFloat32 inv[16];
+    inv[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * invDet;
+    inv[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * invDet;
+    inv[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * invDet;
+    inv[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * invDet;
+
+    inv[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * invDet;
+    inv[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * invDet;
+    inv[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * invDet;
+    inv[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * invDet;
+
+    inv[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * invDet;
+    inv[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * invDet;
+    inv[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * invDet;
+    inv[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * invDet;
+
+    inv[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * invDet;
+    inv[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * invDet;
+    inv[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * invDet;
+    inv[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * invDet;
+
+    for (csmInt32 i = 0; i < 16; ++i)
+    {
+        dst[i] = inv[i];
+    }
+#endif
+
+    return true;
+}
+
+void CubismMatrix44::TransformPoints(const csmFloat32* matrix, const csmFloat32* src, csmFloat32* dst, csmInt32 pointCount)
+{
+    const csmFloat32 m0 = matrix[0];
+    const csmFloat32 m1 = matrix[1];
+    const csmFloat32 m4 = matrix[4];
+    const csmFloat32 m5 = matrix[5];
+    const csmFloat32 m12 = matrix[12];
+    const csmFloat32 m13 = matrix[13];
+
+    csmInt32 i = 0;
+
+#if defined(CSM_MATRIX44_NEON)
+    // 4 points at a time, deinterleaved into x and y lanes
+    const float32x4_t vm0 = vdupq_n_f32(m0);
+    const float32x4_t vm1 = vdupq_n_f32(m1);
+    const float32x4_t vm4 = vdupq_n_f32(m4);
+    const float32x4_t vm5 = vdupq_n_f32(m5);
+    const float32x4_t vm12 = vdupq_n_f32(m12);
+    const float32x4_t vm13 = vdupq_n_f32(m13);
+    for (; i + 4 <= pointCount; i += 4)
+    {
+        const float32x4x2_t p = vld2q_f32(src + i * 2);
+        float32x4x2_t q;
+        q.val[0] = vaddq_f32(vaddq_f32(vmulq_f32(vm0, p.val[0]), vmulq_f32(vm4, p.val[1])), vm12);
+        q.val[1] = vaddq_f32(vaddq_f32(vmulq_f32(vm1, p.val[0]), vmulq_f32(vm5, p.val[1])), vm13);
+        vst2q_f32(dst + i * 2, q);
+    }
+#elif defined(CSM_MATRIX44_SSE)
+    // 2 points at a time as (x0, y0, x1, y1)
+    const __m128 vmx = _mm_setr_ps(m0, m1, m0, m1);
+    const __m128 vmy = _mm_setr_ps(m4, m5, m4, m5);
+    const __m128 vmt = _mm_setr_ps(m12, m13, m12, m13);
+    for (; i + 2 <= pointCount; i += 2)
+    {
+        const __m128 p = _mm_loadu_ps(src + i * 2);
+        const __m128 xx = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 yy = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+        _mm_storeu_ps(dst + i * 2, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vmx, xx), _mm_mul_ps(vmy, yy)), vmt));
+    }
+#endif
+
+    for (; i < pointCount; ++i)
+    {
+        const csmFloat32 x = src[i * 2];
+        const csmFloat32 y = src[i * 2 + 1];
+        dst[i * 2] = m0 * x + m4 * y + m12;
+        dst[i * 2 + 1] = m1 * x + m5 * y + m13;
+    }
 }
 
 void CubismMatrix44::TranslateRelative(csmFloat32 x, csmFloat32 y)
@@ -116,6 +368,18 @@ csmFloat32 CubismMatrix44::InvertTransformY(csmFloat32 src)
     return (src - _tr[13]) / _tr[5];
 }
 
+void CubismMatrix44::TransformPoints(const csmFloat32* src, csmFloat32* dst, csmInt32 pointCount) const
+{
+    TransformPoints(_tr, src, dst, pointCount);
+}
+
+CubismMatrix44 CubismMatrix44::GetInvert() const
+{
+    CubismMatrix44 dst;
+    Invert(_tr, dst._tr);
+    return dst;
+}
+
 void CubismMatrix44::SetMatrix(csmFloat32* tr)
 {
     for (csmInt32 i = 0; i < 16; ++i)
@@ -36,6 +36,29 @@ public:
      */
     static void Multiply(csmFloat32* a, csmFloat32* b, csmFloat32* dst);
 
+    /**
+     * Calculates the inverse of the given matrix and stores it in the destination matrix.
+     * dst may be the same array as src.
+     *
+     * @param src Matrix to invert
+     * @param dst Destination matrix for storing the result. Left unchanged if the matrix is singular.
+     *
+     * @return true if the inverse matrix was calculated, false if the matrix is singular
+     */
+    static csmBool Invert(const csmFloat32* src, csmFloat32* dst);
+
+    /**
+     * Transforms an array of 2D points by the given matrix.
+     * Each point is treated as (x, y, 0, 1), so rotation and shear components are also applied.
+     * dst may be the same array as src.
+     *
+     * @param matrix 4x4 matrix represented by 16 floating-point numbers
+     * @param src Source points stored as interleaved x, y pairs
+     * @param dst Destination array for storing the transformed points as interleaved x, y pairs
+     * @param pointCount Number of points
+     */
+    static void TransformPoints(const csmFloat32* matrix, const csmFloat32* src, csmFloat32* dst, csmInt32 pointCount);
+
     /**
      * Sets the identity matrix.
      */
@@ -119,6 +142,22 @@ public:
      */
     csmFloat32      InvertTransformY(csmFloat32 src);
 
+    /**
+     * Transforms an array of 2D points using the current matrix.
+     *
+     * @param src Source points stored as interleaved x, y pairs
+     * @param dst Destination array for storing the transformed points. May be the same array as src.
+     * @param pointCount Number of points
+     */
+    void            TransformPoints(const csmFloat32* src, csmFloat32* dst, csmInt32 pointCount) const;
+
+    /**
+     * Returns the inverse of the current matrix.
+     *
+     * @return Inverse matrix. Identity matrix if the current matrix is singular.
+     */
+    CubismMatrix44  GetInvert() const;
+
     /**
      * Moves relatively based on the current matrix position.
      *
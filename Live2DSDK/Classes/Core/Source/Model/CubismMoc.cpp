@@ -7,6 +7,7 @@
 
 #include "CubismMoc.hpp"
 #include "CubismModel.hpp"
+#include "CubismMocConsistencyCache.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -19,8 +20,15 @@ CubismMoc* CubismMoc::Create(const csmByte* mocBytes, csmSizeInt size, csmBool s
 
     if (shouldCheckMocConsistency)
     {
-        // .moc3の整合性を確認
-        csmBool consistency = HasMocConsistency(alignedBuffer, size);
+        // .moc3の整合性を確認。確認済みの内容であれば結果を再利用する
+        const CubismMocConsistencyCache::Hash hash = CubismMocConsistencyCache::ComputeHash(mocBytes, size);
+        csmBool consistency = false;
+        if (!CubismMocConsistencyCache::Find(hash, size, consistency))
+        {
+            consistency = HasMocConsistency(alignedBuffer, size);
+            CubismMocConsistencyCache::Store(hash, size, consistency);
+        }
+
         if (!consistency)
         {
             CSM_FREE_ALLIGNED(alignedBuffer);
@@ -86,6 +94,11 @@ void CubismMoc::DeleteModel(CubismModel* model)
     --_modelCount;
 }
 
+csmInt32 CubismMoc::GetModelCount() const
+{
+    return _modelCount;
+}
+
 Core::csmMocVersion CubismMoc::GetLatestMocVersion()
 {
     return Core::csmGetLatestMocVersion();
@@ -51,6 +51,13 @@ public:
      */
     void DeleteModel(CubismModel* model);
 
+    /**
+     * Returns the number of model instances made from this MOC that are not yet destroyed.
+     *
+     * @return Number of model instances
+     */
+    csmInt32 GetModelCount() const;
+
     /**
      * Returns the latest MOC file version.
      *
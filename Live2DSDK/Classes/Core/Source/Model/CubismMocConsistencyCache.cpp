@@ -0,0 +1,366 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismMocConsistencyCache.hpp"
+#include <stdlib.h>
+#include <mutex>
+#include "CubismMoc.hpp"
+
+#if defined(__APPLE__)
+#include <CommonCrypto/CommonDigest.h>
+#endif
+
+namespace Live2D { namespace Cubism { namespace Framework {
+
+namespace {
+
+/// One cached result.
+struct CacheEntry
+{
+    CubismMocConsistencyCache::Hash Hash;   ///< Hash of the MOC3 file.
+    csmUint64 Size;                         ///< Size of the MOC3 file in bytes.
+    csmBool IsConsistent;                   ///< Result of the consistency check.
+};
+
+const csmByte SerializedMagic[4] = { 'M', 'C', 'C', '2' };
+const csmSizeInt SerializedHeaderSize = 8;
+const csmSizeInt SerializedEntrySize = CubismMocConsistencyCache::HashSize + 8 + 1;
+
+// Fixed storage so that the cache does not depend on the allocator of CubismFramework.
+std::mutex s_mutex;
+CacheEntry s_entries[CubismMocConsistencyCache::MaxEntryCount];
+csmInt32 s_entryCount = 0;
+csmInt32 s_nextReplaceIndex = 0;
+
+/// Appends a value in little endian.
+void WriteUint(csmVector<csmByte>& output, csmUint64 value, csmInt32 byteCount)
+{
+    for (csmInt32 i = 0; i < byteCount; ++i)
+    {
+        output.PushBack(static_cast<csmByte>(value >> (i * 8)));
+    }
+}
+
+/// Reads a value written by WriteUint.
+csmUint64 ReadUint(const csmByte* input, csmInt32 byteCount)
+{
+    csmUint64 value = 0;
+    for (csmInt32 i = 0; i < byteCount; ++i)
+    {
+        value |= static_cast<csmUint64>(input[i]) << (i * 8);
+    }
+    return value;
+}
+
+/// Checks a MOC3 file that may not be aligned to csmAlignofMoc, such as a memory-mapped NSData.
+/// The file is copied to an aligned buffer taken from malloc rather than the allocator of CubismFramework,
+/// which is not safe to call from worker threads.
+csmBool CheckConsistency(const csmByte* mocBytes, csmSizeInt size)
+{
+    csmByte* allocation = static_cast<csmByte*>(malloc(size + Core::csmAlignofMoc));
+    if (allocation == NULL)
+    {
+        return false;
+    }
+
+    const size_t shift = reinterpret_cast<size_t>(allocation) % Core::csmAlignofMoc;
+    csmByte* alignedBuffer = allocation + (shift ? Core::csmAlignofMoc - shift : 0);
+    memcpy(alignedBuffer, mocBytes, size);
+
+    const csmBool isConsistent = CubismMoc::HasMocConsistency(alignedBuffer, static_cast<csmUint32>(size));
+
+    free(allocation);
+
+    return isConsistent;
+}
+
+#if !defined(__APPLE__)
+/// SHA-256 (FIPS 180-4) for platforms without CommonCrypto.
+class Sha256
+{
+public:
+    Sha256()
+        : _length(0)
+        , _bufferSize(0)
+    {
+        static const csmUint32 InitialState[8] =
+        {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+        };
+        memcpy(_state, InitialState, sizeof(_state));
+    }
+
+    void Update(const csmByte* data, csmSizeInt size)
+    {
+        _length += size;
+
+        if (_bufferSize > 0)
+        {
+            const csmSizeInt copySize = (size < 64 - _bufferSize) ? size : 64 - _bufferSize;
+            memcpy(_buffer + _bufferSize, data, copySize);
+            _bufferSize += copySize;
+            data += copySize;
+            size -= copySize;
+
+            if (_bufferSize < 64)
+            {
+                return;
+            }
+
+            ProcessBlock(_buffer);
+            _bufferSize = 0;
+        }
+
+        for (; size >= 64; data += 64, size -= 64)
+        {
+            ProcessBlock(data);
+        }
+
+        memcpy(_buffer, data, size);
+        _bufferSize = size;
+    }
+
+    void Finish(csmByte* digest)
+    {
+        const csmUint64 bitLength = _length * 8;
+
+        const csmByte padding[64] = { 0x80 };
+        Update(padding, (_bufferSize < 56) ? 56 - _bufferSize : 120 - _bufferSize);
+
+        csmByte lengthBytes[8];
+        for (csmInt32 i = 0; i < 8; ++i)
+        {
+            lengthBytes[i] = static_cast<csmByte>(bitLength >> (56 - i * 8));
+        }
+        Update(lengthBytes, 8);
+
+        for (csmInt32 i = 0; i < 8; ++i)
+        {
+            digest[i * 4 + 0] = static_cast<csmByte>(_state[i] >> 24);
+            digest[i * 4 + 1] = static_cast<csmByte>(_state[i] >> 16);
+            digest[i * 4 + 2] = static_cast<csmByte>(_state[i] >> 8);
+            digest[i * 4 + 3] = static_cast<csmByte>(_state[i]);
+        }
+    }
+
+private:
+    static csmUint32 RotateRight(csmUint32 value, csmInt32 count)
+    {
+        return (value >> count) | (value << (32 - count));
+    }
+
+    void ProcessBlock(const csmByte* block)
+    {
+        static const csmUint32 RoundConstants[64] =
+        {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+        };
+
+        csmUint32 w[64];
+        for (csmInt32 i = 0; i < 16; ++i)
+        {
+            w[i] = (static_cast<csmUint32>(block[i * 4]) << 24) | (static_cast<csmUint32>(block[i * 4 + 1]) << 16)
+                | (static_cast<csmUint32>(block[i * 4 + 2]) << 8) | static_cast<csmUint32>(block[i * 4 + 3]);
+        }
+        for (csmInt32 i = 16; i < 64; ++i)
+        {
+            const csmUint32 s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const csmUint32 s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        csmUint32 a = _state[0], b = _state[1], c = _state[2], d = _state[3];
+        csmUint32 e = _state[4], f = _state[5], g = _state[6], h = _state[7];
+        for (csmInt32 i = 0; i < 64; ++i)
+        {
+            const csmUint32 t1 = h + (RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25)) + ((e & f) ^ (~e & g)) + RoundConstants[i] + w[i];
+            const csmUint32 t2 = (RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        _state[0] += a; _state[1] += b; _state[2] += c; _state[3] += d;
+        _state[4] += e; _state[5] += f; _state[6] += g; _state[7] += h;
+    }
+
+    csmUint32 _state[8];
+    csmUint64 _length;
+    csmByte _buffer[64];
+    csmSizeInt _bufferSize;
+};
+#endif
+
+csmBool IsSameKey(const CacheEntry& entry, const CubismMocConsistencyCache::Hash& hash, csmUint64 size)
+{
+    return entry.Size == size && memcmp(entry.Hash.Bytes, hash.Bytes, sizeof(hash.Bytes)) == 0;
+}
+
+/// Stores a result. s_mutex must be held.
+void StoreLocked(const CubismMocConsistencyCache::Hash& hash, csmUint64 size, csmBool isConsistent)
+{
+    for (csmInt32 i = 0; i < s_entryCount; ++i)
+    {
+        if (IsSameKey(s_entries[i], hash, size))
+        {
+            s_entries[i].IsConsistent = isConsistent;
+            return;
+        }
+    }
+
+    csmInt32 index = s_entryCount;
+    if (s_entryCount < CubismMocConsistencyCache::MaxEntryCount)
+    {
+        ++s_entryCount;
+    }
+    else
+    {
+        index = s_nextReplaceIndex;
+        s_nextReplaceIndex = (s_nextReplaceIndex + 1) % CubismMocConsistencyCache::MaxEntryCount;
+    }
+
+    s_entries[index].Hash = hash;
+    s_entries[index].Size = size;
+    s_entries[index].IsConsistent = isConsistent;
+}
+
+}
+
+CubismMocConsistencyCache::Hash CubismMocConsistencyCache::ComputeHash(const csmByte* mocBytes, csmSizeInt size)
+{
+    Hash hash;
+
+#if defined(__APPLE__)
+    CC_SHA256_CTX context;
+    CC_SHA256_Init(&context);
+    // CC_LONGは32ビットのため分割して渡す
+    for (csmSizeInt offset = 0; offset < size;)
+    {
+        const csmSizeInt chunkSize = (size - offset < 0x40000000) ? size - offset : 0x40000000;
+        CC_SHA256_Update(&context, mocBytes + offset, static_cast<CC_LONG>(chunkSize));
+        offset += chunkSize;
+    }
+    CC_SHA256_Final(hash.Bytes, &context);
+#else
+    Sha256 sha256;
+    sha256.Update(mocBytes, size);
+    sha256.Finish(hash.Bytes);
+#endif
+
+    return hash;
+}
+
+csmBool CubismMocConsistencyCache::Find(const Hash& hash, csmSizeInt size, csmBool& isConsistent)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    for (csmInt32 i = 0; i < s_entryCount; ++i)
+    {
+        if (IsSameKey(s_entries[i], hash, size))
+        {
+            isConsistent = s_entries[i].IsConsistent;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CubismMocConsistencyCache::Store(const Hash& hash, csmSizeInt size, csmBool isConsistent)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    StoreLocked(hash, size, isConsistent);
+}
+
+csmBool CubismMocConsistencyCache::HasMocConsistency(const csmByte* mocBytes, csmSizeInt size)
+{
+    const Hash hash = ComputeHash(mocBytes, size);
+
+    csmBool isConsistent = false;
+    if (Find(hash, size, isConsistent))
+    {
+        return isConsistent;
+    }
+
+    isConsistent = CheckConsistency(mocBytes, size);
+    Store(hash, size, isConsistent);
+
+    return isConsistent;
+}
+
+void CubismMocConsistencyCache::Serialize(csmVector<csmByte>& output)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    output.Clear();
+    output.PrepareCapacity(static_cast<csmInt32>(SerializedHeaderSize + SerializedEntrySize * s_entryCount));
+
+    for (csmInt32 i = 0; i < 4; ++i)
+    {
+        output.PushBack(SerializedMagic[i]);
+    }
+    WriteUint(output, static_cast<csmUint64>(s_entryCount), 4);
+
+    for (csmInt32 i = 0; i < s_entryCount; ++i)
+    {
+        for (csmInt32 j = 0; j < HashSize; ++j)
+        {
+            output.PushBack(s_entries[i].Hash.Bytes[j]);
+        }
+        WriteUint(output, s_entries[i].Size, 8);
+        output.PushBack(s_entries[i].IsConsistent ? 1 : 0);
+    }
+}
+
+csmBool CubismMocConsistencyCache::Deserialize(const csmByte* buffer, csmSizeInt size)
+{
+    if (buffer == NULL || size < SerializedHeaderSize || memcmp(buffer, SerializedMagic, sizeof(SerializedMagic)) != 0)
+    {
+        return false;
+    }
+
+    const csmUint64 count = ReadUint(buffer + 4, 4);
+    if (size != SerializedHeaderSize + SerializedEntrySize * count)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    const csmByte* entry = buffer + SerializedHeaderSize;
+    for (csmUint64 i = 0; i < count; ++i, entry += SerializedEntrySize)
+    {
+        Hash hash;
+        memcpy(hash.Bytes, entry, HashSize);
+        StoreLocked(hash, ReadUint(entry + HashSize, 8), entry[HashSize + 8] != 0);
+    }
+
+    return true;
+}
+
+void CubismMocConsistencyCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    s_entryCount = 0;
+    s_nextReplaceIndex = 0;
+}
+
+}}}
@@ -0,0 +1,110 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+#include "csmVector.hpp"
+
+namespace Live2D { namespace Cubism { namespace Framework {
+
+/**
+ * Caches the results of the MOC3 consistency check, keyed by the SHA-256 hash of the file contents.
+ *
+ * `CubismMoc::Create` consults the cache when the consistency check is requested,
+ * so a file that has been checked once is not checked again on later loads.
+ * The cache can be serialized to persist results across launches, and `HasMocConsistency`
+ * can be called from a worker thread to check files ahead of time.
+ *
+ * @note The key is collision resistant, so a crafted file cannot reuse the result of another file.
+ *       The cache file itself is not authenticated. Store it where the app alone can write it.
+ */
+class CubismMocConsistencyCache
+{
+public:
+    static const csmInt32 MaxEntryCount = 256;    ///< Number of results kept; the oldest result is replaced when full
+    static const csmInt32 HashSize = 32;          ///< Size of the SHA-256 hash in bytes
+
+    /**
+     * SHA-256 hash of a MOC3 file.
+     */
+    struct Hash
+    {
+        csmByte Bytes[HashSize];
+    };
+
+    /**
+     * Computes the hash of the MOC3 file used as the key.
+     * Uses CommonCrypto on Apple platforms.
+     *
+     * @param mocBytes Buffer of the MOC3 file
+     * @param size Size of the buffer in bytes
+     *
+     * @return SHA-256 hash of the contents
+     */
+    static Hash ComputeHash(const csmByte* mocBytes, csmSizeInt size);
+
+    /**
+     * Looks up the result for a MOC3 file.
+     *
+     * @param hash Hash computed by `ComputeHash`
+     * @param size Size of the MOC3 file in bytes
+     * @param isConsistent Receives the cached result when found
+     *
+     * @return true if a result is cached; otherwise false
+     */
+    static csmBool Find(const Hash& hash, csmSizeInt size, csmBool& isConsistent);
+
+    /**
+     * Stores the result for a MOC3 file.
+     *
+     * @param hash Hash computed by `ComputeHash`
+     * @param size Size of the MOC3 file in bytes
+     * @param isConsistent Result of the consistency check
+     */
+    static void Store(const Hash& hash, csmSizeInt size, csmBool isConsistent);
+
+    /**
+     * Checks the consistency of the MOC3 file, using the cached result if any.
+     * Thread safe; intended for checking files on a worker thread before they are loaded.
+     * The buffer need not be aligned; it is copied to an aligned buffer without using the allocator of CubismFramework.
+     *
+     * @param mocBytes Buffer of the MOC3 file
+     * @param size Size of the buffer in bytes
+     *
+     * @return true if the file is consistent; otherwise false
+     */
+    static csmBool HasMocConsistency(const csmByte* mocBytes, csmSizeInt size);
+
+    /**
+     * Writes the cached results to a buffer to persist them.
+     *
+     * @param output Buffer to write to. Existing contents are discarded.
+     */
+    static void Serialize(csmVector<csmByte>& output);
+
+    /**
+     * Adds the results written by `Serialize` to the cache.
+     * Caches written by earlier versions, which used a weaker key, are rejected.
+     *
+     * @param buffer Buffer written by `Serialize`
+     * @param size Size of the buffer in bytes
+     *
+     * @return true if the buffer was read; false if it is not a valid cache
+     */
+    static csmBool Deserialize(const csmByte* buffer, csmSizeInt size);
+
+    /**
+     * Discards all cached results.
+     */
+    static void Clear();
+
+private:
+    CubismMocConsistencyCache();
+};
+
+}}}
@@ -9,6 +9,7 @@
 #include "CubismRenderer.hpp"
 #include "CubismId.hpp"
 #include "CubismIdManager.hpp"
+#include "CubismMath.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -23,6 +24,8 @@ CubismModel::CubismModel(Core::csmModel* model)
     , _parameterMaximumValues(NULL)
     , _parameterMinimumValues(NULL)
     , _partOpacities(NULL)
+    , _isParametersDirty(true)
+    , _isUpdateSkipped(false)
     , _isOverwrittenModelMultiplyColors(false)
     , _isOverwrittenModelScreenColors(false)
     , _isOverwrittenCullings(false)
@@ -71,11 +74,31 @@ void CubismModel::MultiplyParameterValue(csmInt32 parameterIndex, csmFloat32 val
 
 void CubismModel::Update() const
 {
+    // Keep the previous results and flags if nothing that affects them has changed.
+    if (!_isParametersDirty)
+    {
+        _isUpdateSkipped = true;
+        return;
+    }
+
     // Update model.
     Core::csmUpdateModel(_model);
 
     // Reset dynamic drawable flags.
     Core::csmResetDrawableDynamicFlags(_model);
+
+    _isParametersDirty = false;
+    _isUpdateSkipped = false;
+}
+
+csmBool CubismModel::IsUpdateSkipped() const
+{
+    return _isUpdateSkipped;
+}
+
+void CubismModel::MarkParametersDirty()
+{
+    _isParametersDirty = true;
 }
 
 void CubismModel::SetPartOpacity(CubismIdHandle partId, csmFloat32 opacity)
@@ -102,7 +125,11 @@ void CubismModel::SetPartOpacity(csmInt32 partIndex, csmFloat32 opacity)
     //インデックスの範囲内検知
     CSM_ASSERT(0 <= partIndex && partIndex < GetPartCount());
 
-    _partOpacities[partIndex] = opacity;
+    if (_partOpacities[partIndex] != opacity)
+    {
+        _partOpacities[partIndex] = opacity;
+        _isParametersDirty = true;
+    }
 }
 
 csmFloat32 CubismModel::GetPartOpacity(CubismIdHandle partId)
@@ -230,9 +257,16 @@ void CubismModel::SetParameterValue(csmInt32 parameterIndex, csmFloat32 value, c
         value = Core::csmGetParameterMinimumValues(_model)[parameterIndex];
     }
 
-    _parameterValues[parameterIndex] = (weight == 1)
-                                      ? value
-                                      : _parameterValues[parameterIndex] = (_parameterValues[parameterIndex] * (1 - weight)) + (value * weight);
+    value = (weight == 1)
+            ? value
+            : (_parameterValues[parameterIndex] * (1 - weight)) + (value * weight);
+
+    // 値が変わった場合のみモデルの再計算を要求する
+    if (_parameterValues[parameterIndex] != value)
+    {
+        _parameterValues[parameterIndex] = value;
+        _isParametersDirty = true;
+    }
 }
 
 csmFloat32 CubismModel::GetCanvasWidthPixel() const
@@ -652,7 +686,11 @@ void CubismModel::LoadParameters()
 
     for (csmInt32 i = 0; i < parameterCount; ++i)
     {
-        _parameterValues[i] = _savedParameters[i];
+        if (_parameterValues[i] != _savedParameters[i])
+        {
+            _parameterValues[i] = _savedParameters[i];
+            _isParametersDirty = true;
+        }
     }
 }
 
@@ -674,6 +712,127 @@ void CubismModel::SaveParameters()
     }
 }
 
+void CubismModel::CaptureParameters(csmFloat32* values) const
+{
+    const csmInt32 parameterCount = Core::csmGetParameterCount(_model);
+
+    memcpy(values, _parameterValues, sizeof(csmFloat32) * parameterCount);
+}
+
+void CubismModel::RestoreParameters(const csmFloat32* values)
+{
+    const csmInt32 parameterCount = Core::csmGetParameterCount(_model);
+
+    if (memcmp(_parameterValues, values, sizeof(csmFloat32) * parameterCount) != 0)
+    {
+        memcpy(_parameterValues, values, sizeof(csmFloat32) * parameterCount);
+        _isParametersDirty = true;
+    }
+}
+
+csmInt32 CubismModel::DiffParameters(const csmFloat32* snapshot, csmFloat32 threshold, ParameterDiff* diffs) const
+{
+    const csmInt32 parameterCount = Core::csmGetParameterCount(_model);
+    csmInt32 diffCount = 0;
+
+    for (csmInt32 i = 0; i < parameterCount; ++i)
+    {
+        const csmFloat32 difference = _parameterValues[i] - snapshot[i];
+        if (difference > threshold || difference < -threshold)
+        {
+            diffs[diffCount].Index = i;
+            diffs[diffCount].Value = _parameterValues[i];
+            ++diffCount;
+        }
+    }
+
+    return diffCount;
+}
+
+void CubismModel::ApplyParameterDiffs(const ParameterDiff* diffs, csmInt32 count)
+{
+    const csmInt32 parameterCount = Core::csmGetParameterCount(_model);
+
+    for (csmInt32 i = 0; i < count; ++i)
+    {
+        //インデックスの範囲内検知
+        CSM_ASSERT(0 <= diffs[i].Index && diffs[i].Index < parameterCount);
+        if (diffs[i].Index < 0 || diffs[i].Index >= parameterCount)
+        {
+            continue;
+        }
+
+        if (_parameterValues[diffs[i].Index] != diffs[i].Value)
+        {
+            _parameterValues[diffs[i].Index] = diffs[i].Value;
+            _isParametersDirty = true;
+        }
+    }
+}
+
+void CubismModel::ApplyParameterUpdates(const ParameterUpdate* updates, csmInt32 count)
+{
+    const csmInt32 parameterCount = Core::csmGetParameterCount(_model);
+
+    for (csmInt32 i = 0; i < count; ++i)
+    {
+        const ParameterUpdate& update = updates[i];
+
+        if (update.Index < 0)
+        {
+            continue;
+        }
+
+        // モデルに存在しないパラメータは個別の処理に任せる
+        if (update.Index >= parameterCount)
+        {
+            switch (update.Operation)
+            {
+            case ParameterOperation_Add:
+                AddParameterValue(update.Index, update.Value, update.Weight);
+                break;
+            case ParameterOperation_Multiply:
+                MultiplyParameterValue(update.Index, update.Value, update.Weight);
+                break;
+            default:
+                SetParameterValue(update.Index, update.Value, update.Weight);
+                break;
+            }
+            continue;
+        }
+
+        const csmFloat32 current = _parameterValues[update.Index];
+        csmFloat32 value;
+        csmFloat32 weight = 1.0f;
+
+        switch (update.Operation)
+        {
+        case ParameterOperation_Add:
+            value = current + (update.Value * update.Weight);
+            break;
+        case ParameterOperation_Multiply:
+            value = current * (1.0f + (update.Value - 1.0f) * update.Weight);
+            break;
+        default:
+            value = update.Value;
+            weight = update.Weight;
+            break;
+        }
+
+        value = CubismMath::RangeF(value, _parameterMinimumValues[update.Index], _parameterMaximumValues[update.Index]);
+
+        value = (weight == 1.0f)
+                ? value
+                : (current * (1.0f - weight)) + (value * weight);
+
+        if (current != value)
+        {
+            _parameterValues[update.Index] = value;
+            _isParametersDirty = true;
+        }
+    }
+}
+
 Rendering::CubismRenderer::CubismTextureColor CubismModel::GetMultiplyColor(csmInt32 drawableIndex) const
 {
     if (GetOverwriteFlagForModelMultiplyColors() || GetOverwriteFlagForDrawableMultiplyColors(drawableIndex))
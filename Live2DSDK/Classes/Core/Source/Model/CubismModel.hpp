@@ -119,11 +119,57 @@ public:
         Rendering::CubismRenderer::CubismTextureColor Color;        ///< Color
     };
 
+    /**
+     * Operation applied to a parameter by `ApplyParameterUpdates`
+     */
+    enum ParameterOperation
+    {
+        ParameterOperation_Set = 0,     ///< Same as `SetParameterValue`
+        ParameterOperation_Add,         ///< Same as `AddParameterValue`
+        ParameterOperation_Multiply,    ///< Same as `MultiplyParameterValue`
+    };
+
+    /**
+     * Structure to describe one parameter update applied by `ApplyParameterUpdates`
+     */
+    struct ParameterUpdate
+    {
+        csmInt32 Index;         ///< Parameter index returned by `GetParameterIndex`
+        csmInt32 Operation;     ///< ParameterOperation
+        csmFloat32 Value;       ///< Value of the operation
+        csmFloat32 Weight;      ///< Weight of the operation
+    };
+
+    /**
+     * Structure to describe one changed parameter found by `DiffParameters`
+     */
+    struct ParameterDiff
+    {
+        csmInt32 Index;         ///< Parameter index
+        csmFloat32 Value;       ///< Current value of the parameter
+    };
+
     /**
      * Calculates and updates the model state based on the set parameters.
+     *
+     * The calculation is skipped when no parameter value or part opacity has changed since the last update.
+     * The drawable data and dynamic flags are then left as they were after the last update.
      */
     void    Update() const;
 
+    /**
+     * Checks whether the last `Update` was skipped because nothing had changed.
+     *
+     * @return true if the drawable data is unchanged from the update before; otherwise false
+     */
+    csmBool IsUpdateSkipped() const;
+
+    /**
+     * Makes the next `Update` recalculate the model.
+     * Call after writing to the parameter values or part opacities of the Core model directly, without the setters of this class.
+     */
+    void    MarkParametersDirty();
+
     /**
      * Returns the width of the canvas.
      *
@@ -609,6 +655,52 @@ public:
      */
     void    SaveParameters();
 
+    /**
+     * Copies the values of all parameters to caller-owned storage.
+     * Only the parameters of the MOC are copied; IDs not in the MOC are excluded.
+     *
+     * @param values Destination with room for `GetParameterCount()` values
+     */
+    void    CaptureParameters(csmFloat32* values) const;
+
+    /**
+     * Restores the values of all parameters from a snapshot made by `CaptureParameters`.
+     * The values are written as they are, without clamping.
+     *
+     * @param values Snapshot with `GetParameterCount()` values
+     */
+    void    RestoreParameters(const csmFloat32* values);
+
+    /**
+     * Finds the parameters whose values differ from a snapshot.
+     *
+     * @param snapshot Snapshot made by `CaptureParameters`
+     * @param threshold Differences less than or equal to this value are ignored
+     * @param diffs Destination with room for `GetParameterCount()` entries; receives the current values of the changed parameters
+     *
+     * @return Number of changed parameters written to `diffs`
+     */
+    csmInt32 DiffParameters(const csmFloat32* snapshot, csmFloat32 threshold, ParameterDiff* diffs) const;
+
+    /**
+     * Sets the values found by `DiffParameters`, for example on another instance of the same model.
+     * Entries whose index is out of range are ignored.
+     *
+     * @param diffs Changed parameters
+     * @param count Number of entries in `diffs`
+     */
+    void    ApplyParameterDiffs(const ParameterDiff* diffs, csmInt32 count);
+
+    /**
+     * Applies a batch of parameter updates in order.
+     * Gives the same result as calling `SetParameterValue`, `AddParameterValue` or `MultiplyParameterValue` for each entry,
+     * without looking up IDs. Entries with a negative index are skipped.
+     *
+     * @param updates Updates to apply
+     * @param count Number of entries in `updates`
+     */
+    void    ApplyParameterUpdates(const ParameterUpdate* updates, csmInt32 count);
+
     /**
      * Returns the multiply color from the list of drawables.
      *
@@ -877,6 +969,9 @@ private:
 
     csmFloat32*         _partOpacities;
 
+    mutable csmBool     _isParametersDirty;     ///< Whether a parameter value or part opacity changed since the last update
+    mutable csmBool     _isUpdateSkipped;       ///< Whether the last update was skipped
+
     csmFloat32 _modelOpacity;
 
     csmVector<CubismIdHandle> _parameterIds;
@@ -58,7 +58,11 @@ CubismUserModel::~CubismUserModel()
     {
         _moc->DeleteModel(_model);
     }
-    CubismMoc::Delete(_moc);
+    // MOCを共有している他のインスタンスが残っている場合は破棄しない
+    if (_moc == NULL || _moc->GetModelCount() == 0)
+    {
+        CubismMoc::Delete(_moc);
+    }
     CSM_DELETE(_modelMatrix);
     CubismPose::Delete(_pose);
     CubismEyeBlink::Delete(_eyeBlink);
@@ -100,6 +104,28 @@ void CubismUserModel::LoadModel(const csmByte* buffer, csmSizeInt size, csmBool
 
 }
 
+void CubismUserModel::ShareModel(const CubismUserModel* source)
+{
+    if (source == NULL || source->_moc == NULL)
+    {
+        CubismLogError("Failed to ShareModel().");
+        return;
+    }
+
+    _moc = source->_moc;
+    _mocConsistency = source->_mocConsistency;
+    _model = _moc->CreateModel();
+
+    if (_model == NULL)
+    {
+        CubismLogError("Failed to CreateModel().");
+        return;
+    }
+
+    _model->SaveParameters();
+    _modelMatrix = CSM_NEW CubismModelMatrix(_model->GetCanvasWidth(), _model->GetCanvasHeight());
+}
+
 ACubismMotion* CubismUserModel::LoadExpression(const csmByte* buffer, csmSizeInt size, const csmChar* name)
 {
     if (!buffer)
@@ -129,6 +155,20 @@ void CubismUserModel::LoadPhysics(const csmByte* buffer, csmSizeInt size)
     }
 }
 
+void CubismUserModel::SharePhysics(const CubismUserModel* source)
+{
+    if (source == NULL || source->_physics == NULL)
+    {
+        return;
+    }
+
+    _physics = CubismPhysics::CreateShared(source->_physics);
+    if (!_physics)
+    {
+        CubismLogError("Failed to SharePhysics().");
+    }
+}
+
 void CubismUserModel::LoadUserData(const csmByte* buffer, csmSizeInt size)
 {
     if (!buffer)
@@ -113,6 +113,14 @@ public:
      */
     virtual void            LoadModel(const csmByte* buffer, csmSizeInt size, csmBool shouldCheckMocConsistency = false);
 
+    /**
+     * Makes the model from the MOC already loaded by another instance.
+     * The MOC is shared and destroyed together with the last model made from it; parameters and drawables are per instance.
+     *
+     * @param source Instance that has loaded the MOC3 file
+     */
+    virtual void            ShareModel(const CubismUserModel* source);
+
     /**
      * Loads motion from a motion file.
      * If a fade value is defined in model3.json, the fade value defined in motion3.json will be overwritten.
@@ -158,6 +166,14 @@ public:
      */
     virtual void            LoadPhysics(const csmByte* buffer, csmSizeInt size);
 
+    /**
+     * Makes the physics from the physics already loaded by another instance.
+     * The physics settings are shared and destroyed together with the last instance using them; the simulation state is per instance.
+     *
+     * @param source Instance that has loaded the physics configuration file
+     */
+    virtual void            SharePhysics(const CubismUserModel* source);
+
     /**
      * Loads user data from a user data file.
      *
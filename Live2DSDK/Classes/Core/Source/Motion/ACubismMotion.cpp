@@ -25,7 +25,6 @@ ACubismMotion::ACubismMotion()
     , _offsetSeconds(0.0f) // 再生の開始時刻
     , _isLoop(false)       // trueから false へデフォルトを変更
     , _isLoopFadeIn(true)  // ループ時にフェードインが有効かどうかのフラグ
-    , _previousLoopState(_isLoop)
     , _onBeganMotion(NULL)
     , _onBeganMotionCustomData(NULL)
     , _onFinishedMotion(NULL)
@@ -72,7 +71,7 @@ void ACubismMotion::SetupMotionQueueEntry(CubismMotionQueueEntry* motionQueueEnt
     motionQueueEntry->IsStarted(true);
     motionQueueEntry->SetStartTime(userTimeSeconds - _offsetSeconds); //モーションの開始時刻を記録
     motionQueueEntry->SetFadeInStartTime(userTimeSeconds); //フェードインの開始時刻
-
+    motionQueueEntry->_previousLoopState = _isLoop; // 再生中にループ設定が変わったことを検出するため
 
     if (motionQueueEntry->GetEndTime() < 0)
     {
@@ -80,9 +79,9 @@ void ACubismMotion::SetupMotionQueueEntry(CubismMotionQueueEntry* motionQueueEnt
         AdjustEndTime(motionQueueEntry);
     }
 
-    if (this->_onBeganMotion != NULL)
+    if (motionQueueEntry->_onBeganMotion != NULL)
     {
-        this->_onBeganMotion(this);
+        motionQueueEntry->_onBeganMotion(this);
     }
 }
 
@@ -181,9 +180,10 @@ csmBool ACubismMotion::GetLoopFadeIn() const
     return this->_isLoopFadeIn;
 }
 
-const csmVector<const csmString*>& ACubismMotion::GetFiredEvent(csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds)
+const csmVector<const csmString*>& ACubismMotion::GetFiredEvent(CubismMotionQueueEntry* motionQueueEntry, csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds)
 {
-    return _firedEventValues;
+    motionQueueEntry->_firedEventValues.UpdateSize(0);
+    return motionQueueEntry->_firedEventValues;
 }
 
 void ACubismMotion::SetBeganMotionHandler(BeganMotionCallback onBeganMotionHandler)
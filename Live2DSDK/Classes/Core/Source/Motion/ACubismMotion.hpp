@@ -155,8 +155,9 @@ public:
     csmBool GetLoopFadeIn() const;
 
     /**
-     * Returns the triggered user data events.
+     * Returns the triggered user data events, resuming from the position kept in the queue entry.
      *
+     * @param motionQueueEntry motion managed by CubismMotionQueueManager
      * @param beforeCheckTimeSeconds previous playback time in seconds
      * @param motionTimeSeconds current playback time in seconds
      *
@@ -164,7 +165,8 @@ public:
      *
      * @note The input times should be in seconds, with the motion timing set to zero.
      */
-    virtual const csmVector<const csmString*>& GetFiredEvent(csmFloat32 beforeCheckTimeSeconds,
+    virtual const csmVector<const csmString*>& GetFiredEvent(CubismMotionQueueEntry* motionQueueEntry,
+                                                                   csmFloat32 beforeCheckTimeSeconds,
                                                                    csmFloat32 motionTimeSeconds);
 
     /**
@@ -174,6 +176,9 @@ public:
      *   1. When the motion being played is set as "loop"
      *   2. When NULL is set as the callback
      *
+     * The handler is copied into each playback when it is started, and later changes do not affect playbacks already started.
+     * Use CubismMotionQueueEntry::SetBeganMotionHandler to set a handler for one playback of a motion shared by several models.
+     *
      * @param   onBeganMotionHandler     Motion playback start callback function
      */
     void SetBeganMotionHandler(BeganMotionCallback onBeganMotionHandler);
@@ -220,6 +225,9 @@ public:
      *       Not called in the following states:
      *       1. When the playing motion is a loop motion
      *       2. When the callback function is not set
+     *
+     *       The handler is copied into each playback when it is started, and later changes do not affect playbacks already started.
+     *       Use CubismMotionQueueEntry::SetFinishedMotionHandler to set a handler for one playback of a motion shared by several models.
      */
     void SetFinishedMotionHandler(FinishedMotionCallback onFinishedMotionHandler);
 
@@ -308,9 +316,6 @@ protected:
     csmFloat32    _offsetSeconds;
     csmBool       _isLoop;
     csmBool       _isLoopFadeIn;
-    csmBool       _previousLoopState;
-
-    csmVector<const csmString*>    _firedEventValues;
 
     BeganMotionCallback _onBeganMotion;
     void* _onBeganMotionCustomData;
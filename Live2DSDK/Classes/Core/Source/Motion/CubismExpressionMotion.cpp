@@ -31,6 +31,7 @@ const csmFloat32 DefaultFadeTime = 1.0f;
 
 
 CubismExpressionMotion::CubismExpressionMotion()
+    : _fadeWeight(0.0f)
 { }
 
 CubismExpressionMotion::~CubismExpressionMotion()
@@ -83,9 +84,9 @@ void CubismExpressionMotion::CalculateExpressionParameters(CubismModel* model, c
         return;
     }
 
-    // CubismExpressionMotion._fadeWeight は廃止予定です。
-    // 互換性のために処理は残りますが、実際には使用しておりません。
-    _fadeWeight = UpdateFadeWeight(motionQueueEntry, userTimeSeconds);
+    // フェードの状態はキューのエントリに記録する。
+    // 表情は複数のモデルで共有されることがあるため、廃止予定の CubismExpressionMotion._fadeWeight には書き込まない。
+    UpdateFadeWeight(motionQueueEntry, userTimeSeconds);
 
     // モデルに適用する値を計算
     for (csmInt32 i = 0; i < expressionParameterValues->GetSize(); ++i)
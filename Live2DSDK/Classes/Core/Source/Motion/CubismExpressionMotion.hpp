@@ -84,6 +84,7 @@ public:
      *
      * @deprecated Not recommended due to the planned removal of CubismExpressionMotion._fadeWeight.
      *             Use CubismExpressionMotionManager.getFadeWeight(int index) instead.
+     *             The value is no longer updated during playback, because an expression may be played by several models at once.
      *
      * @see CubismExpressionMotionManager#getFadeWeight(int index)
      */
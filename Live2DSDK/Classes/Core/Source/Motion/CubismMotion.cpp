@@ -56,6 +56,8 @@ csmFloat32 LinearEvaluate(const CubismMotionPoint* points, const csmFloat32 time
     return points[0].Value + ((points[1].Value - points[0].Value) * t);
 }
 
+}
+
 csmFloat32 BezierEvaluate(const CubismMotionPoint* points, const csmFloat32 time)
 {
     csmFloat32 t = (time - points[0].Time) / (points[3].Time - points[0].Time);
@@ -177,6 +179,82 @@ csmFloat32 BezierEvaluateCardanoInterpretation(const CubismMotionPoint* points,
     return LerpPoints(p012, p123, t).Value;
 }
 
+/// Precomputes the polynomial form of a Bezier segment.
+CubismMotionBezier CreateBezier(const CubismMotionPoint* points, const csmBool isTimeLinear)
+{
+    CubismMotionBezier bezier;
+
+    const csmFloat32 x0 = 0.0f;
+    const csmFloat32 x1 = points[1].Time - points[0].Time;
+    const csmFloat32 x2 = points[2].Time - points[0].Time;
+    const csmFloat32 x3 = points[3].Time - points[0].Time;
+
+    bezier.TimeA = x3 - 3.0f * x2 + 3.0f * x1 - x0;
+    bezier.TimeB = 3.0f * x2 - 6.0f * x1 + 3.0f * x0;
+    bezier.TimeC = 3.0f * x1 - 3.0f * x0;
+    bezier.StartTime = points[0].Time;
+    bezier.InverseDuration = (x3 != 0.0f) ? 1.0f / x3 : 0.0f;
+
+    bezier.ValueA = points[3].Value - 3.0f * points[2].Value + 3.0f * points[1].Value - points[0].Value;
+    bezier.ValueB = 3.0f * points[2].Value - 6.0f * points[1].Value + 3.0f * points[0].Value;
+    bezier.ValueC = 3.0f * points[1].Value - 3.0f * points[0].Value;
+    bezier.ValueD = points[0].Value;
+
+    bezier.IsTimeLinear = isTimeLinear;
+
+    return bezier;
+}
+
+/// Evaluates a Bezier segment from its precomputed coefficients.
+/// t is solved from the time by Newton steps seeded with the linear estimate, kept inside a bisection bracket.
+csmFloat32 BezierEvaluateCoefficients(const CubismMotionBezier& bezier, const csmFloat32 time)
+{
+    const csmInt32 MaxNewtonIterations = 8;
+    const csmFloat32 TimeTolerance = 1.0e-6f;
+
+    const csmFloat32 localTime = time - bezier.StartTime;
+    csmFloat32 t = CubismMath::RangeF(localTime * bezier.InverseDuration, 0.0f, 1.0f);
+
+    if (!bezier.IsTimeLinear)
+    {
+        csmFloat32 lower = 0.0f;
+        csmFloat32 upper = 1.0f;
+
+        for (csmInt32 i = 0; i < MaxNewtonIterations; ++i)
+        {
+            const csmFloat32 error = ((bezier.TimeA * t + bezier.TimeB) * t + bezier.TimeC) * t - localTime;
+            if (CubismMath::AbsF(error) <= TimeTolerance)
+            {
+                break;
+            }
+
+            if (error < 0.0f)
+            {
+                lower = t;
+            }
+            else
+            {
+                upper = t;
+            }
+
+            const csmFloat32 slope = (3.0f * bezier.TimeA * t + 2.0f * bezier.TimeB) * t + bezier.TimeC;
+            csmFloat32 next = (slope != 0.0f) ? t - error / slope : lower - 1.0f;
+
+            // 区間を外れる場合は二分法に切り替える
+            if (!(next > lower && next < upper))
+            {
+                next = (lower + upper) * 0.5f;
+            }
+
+            t = next;
+        }
+    }
+
+    return ((bezier.ValueA * t + bezier.ValueB) * t + bezier.ValueC) * t + bezier.ValueD;
+}
+
+namespace {
+
 csmFloat32 SteppedEvaluate(const CubismMotionPoint* points, const csmFloat32 time)
 {
     return points[0].Value;
@@ -261,17 +339,67 @@ csmFloat32 EvaluateCurve(const CubismMotionData* motionData, const csmInt32 inde
 
     const CubismMotionSegment& segment = motionData->Segments[target];
 
+    if (segment.BezierIndex >= 0)
+    {
+        return BezierEvaluateCoefficients(motionData->Beziers[segment.BezierIndex], time);
+    }
+
     return segment.Evaluate(&motionData->Points[segment.BasePointIndex], time);
 }
 
+/// Stable insertion sort of the events by fire time; events are usually already in order.
+void SortEventsByFireTime(csmVector<CubismMotionEvent>& events)
+{
+    for (csmUint32 i = 1; i < events.GetSize(); ++i)
+    {
+        if (events[i - 1].FireTime <= events[i].FireTime)
+        {
+            continue;
+        }
+
+        const CubismMotionEvent event = events[i];
+        csmUint32 j = i;
+
+        for (; j > 0 && events[j - 1].FireTime > event.FireTime; --j)
+        {
+            events[j] = events[j - 1];
+        }
+
+        events[j] = event;
+    }
+}
+
+/// Returns the index of the first event that fires after the time.
+csmInt32 FindFirstEventAfter(const CubismMotionData* motionData, const csmFloat32 time)
+{
+    csmInt32 lower = 0;
+    csmInt32 upper = motionData->EventCount;
+
+    while (lower < upper)
+    {
+        const csmInt32 middle = lower + (upper - lower) / 2;
+
+        if (motionData->Events[middle].FireTime <= time)
+        {
+            lower = middle + 1;
+        }
+        else
+        {
+            upper = middle;
+        }
+    }
+
+    return lower;
+}
+
 }
 
 CubismMotion::CubismMotion()
     : _sourceFrameRate(30.0f)
     , _loopDurationSeconds(-1.0f)
     , _motionBehavior(MotionBehavior_V2)
-    , _lastWeight(0.0f)
     , _motionData(NULL)
+    , _bakedData(NULL)
     , _modelCurveIdEyeBlink(NULL)
     , _modelCurveIdLipSync(NULL)
     , _modelCurveIdOpacity(NULL)
@@ -281,6 +409,7 @@ CubismMotion::CubismMotion()
 CubismMotion::~CubismMotion()
 {
     CSM_DELETE(_motionData);
+    CSM_DELETE(_bakedData);
 }
 
 CubismMotion* CubismMotion::Create(const csmByte* buffer, csmSizeInt size, FinishedMotionCallback onFinishedMotionHandler, BeganMotionCallback onBeganMotionHandler)
@@ -323,11 +452,11 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
 
     if (_motionBehavior == MotionBehavior_V2)
     {
-        if (_previousLoopState != _isLoop)
+        if (motionQueueEntry->_previousLoopState != _isLoop)
         {
             // 終了時間を再計算する
             AdjustEndTime(motionQueueEntry);
-            _previousLoopState = _isLoop;
+            motionQueueEntry->_previousLoopState = _isLoop;
         }
     }
 
@@ -386,11 +515,17 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
 
     csmVector<CubismMotionCurve>& curves = _motionData->Curves;
 
+    // ベイク済みであれば補間する2行と重みを求めておく
+    const csmFloat32* bakedRow = NULL;
+    csmFloat32 bakedAlpha = 0.0f;
+    const csmBool isBaked = SampleBakedCurves(time, isCorrection, duration, bakedRow, bakedAlpha);
+    const csmInt32 bakedStride = _motionData->CurveCount;
+
     // Evaluate model curves.
     for (c = 0; c < _motionData->CurveCount && curves[c].Type == CubismMotionCurveTarget_Model; ++c)
     {
         // Evaluate curve and call handler.
-        value = EvaluateCurve(_motionData, c, time, isCorrection, duration);
+        value = isBaked ? bakedRow[c] + (bakedRow[c + bakedStride] - bakedRow[c]) * bakedAlpha : EvaluateCurve(_motionData, c, time, isCorrection, duration);
 
         if (curves[c].Id == _modelCurveIdEyeBlink)
         {
@@ -427,7 +562,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         const csmFloat32 sourceValue = model->GetParameterValue(parameterIndex);
 
         // Evaluate curve and apply value.
-        value = EvaluateCurve(_motionData, c, time, isCorrection, duration);
+        value = isBaked ? bakedRow[c] + (bakedRow[c + bakedStride] - bakedRow[c]) * bakedAlpha : EvaluateCurve(_motionData, c, time, isCorrection, duration);
 
         if (eyeBlinkValue != FLT_MAX)
         {
@@ -547,7 +682,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         }
 
         // Evaluate curve and apply value.
-        value = EvaluateCurve(_motionData, c, time, isCorrection, duration);
+        value = isBaked ? bakedRow[c] + (bakedRow[c + bakedStride] - bakedRow[c]) * bakedAlpha : EvaluateCurve(_motionData, c, time, isCorrection, duration);
 
         model->SetParameterValue(parameterIndex, value);
     }
@@ -560,16 +695,144 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         }
         else
         {
-            if (this->_onFinishedMotion != NULL)
+            if (motionQueueEntry->_onFinishedMotion != NULL)
             {
-                this->_onFinishedMotion(this);
+                motionQueueEntry->_onFinishedMotion(this);
             }
 
             motionQueueEntry->IsFinished(true);
         }
     }
+}
 
-    _lastWeight = fadeWeight;
+CubismMotion::BakeReport CubismMotion::Bake(csmFloat32 sampleRate, csmFloat32 maxError)
+{
+    ReleaseBake();
+
+    BakeReport report;
+    report.IsBaked = false;
+    report.SampleRate = 0.0f;
+    report.FrameCount = 0;
+    report.MemorySize = 0;
+    report.MaxError = 0.0f;
+    report.MaxErrorCurveIndex = -1;
+
+    // DoUpdateParametersと同じ条件で評価する範囲を決める
+    const csmBool isCorrection = _motionBehavior == MotionBehavior_V2 && _isLoop;
+    csmFloat32 endTime = _motionData->Duration;
+    if (isCorrection)
+    {
+        endTime += 1.0f / _motionData->Fps;
+    }
+
+    if (sampleRate <= 0.0f)
+    {
+        sampleRate = _motionData->Fps * 2.0f;
+    }
+
+    const csmInt32 curveCount = _motionData->CurveCount;
+    if (curveCount <= 0 || endTime <= 0.0f || sampleRate <= 0.0f)
+    {
+        return report;
+    }
+
+    // 最後のサンプルが終了時刻に一致するようにサンプル間隔を調整する
+    csmInt32 frameCount = static_cast<csmInt32>(endTime * sampleRate);
+    if (static_cast<csmFloat32>(frameCount) < endTime * sampleRate)
+    {
+        ++frameCount;
+    }
+    frameCount += 1;
+    const csmFloat32 interval = endTime / static_cast<csmFloat32>(frameCount - 1);
+
+    CubismMotionBakedData* bakedData = CSM_NEW CubismMotionBakedData();
+    bakedData->SampleRate = 1.0f / interval;
+    bakedData->EndTime = endTime;
+    bakedData->IsCorrection = isCorrection;
+    bakedData->FrameCount = frameCount;
+    bakedData->Values.UpdateSize(frameCount * curveCount, 0.0f, true);
+
+    for (csmInt32 frame = 0; frame < frameCount; ++frame)
+    {
+        const csmFloat32 time = (frame == frameCount - 1) ? endTime : interval * static_cast<csmFloat32>(frame);
+        for (csmInt32 c = 0; c < curveCount; ++c)
+        {
+            bakedData->Values[frame * curveCount + c] = EvaluateCurve(_motionData, c, time, isCorrection, endTime);
+        }
+    }
+
+    // サンプルの間の点で元のカーブとの誤差を測る
+    const csmInt32 ErrorCheckDivision = 4;
+    for (csmInt32 frame = 0; frame < frameCount - 1; ++frame)
+    {
+        for (csmInt32 division = 1; division < ErrorCheckDivision; ++division)
+        {
+            const csmFloat32 alpha = static_cast<csmFloat32>(division) / static_cast<csmFloat32>(ErrorCheckDivision);
+            const csmFloat32 time = interval * (static_cast<csmFloat32>(frame) + alpha);
+            const csmFloat32* row = &bakedData->Values[frame * curveCount];
+
+            for (csmInt32 c = 0; c < curveCount; ++c)
+            {
+                const csmFloat32 baked = row[c] + (row[c + curveCount] - row[c]) * alpha;
+                const csmFloat32 error = CubismMath::AbsF(baked - EvaluateCurve(_motionData, c, time, isCorrection, endTime));
+
+                if (error > report.MaxError)
+                {
+                    report.MaxError = error;
+                    report.MaxErrorCurveIndex = c;
+                }
+            }
+        }
+    }
+
+    report.SampleRate = bakedData->SampleRate;
+    report.FrameCount = frameCount;
+    report.MemorySize = sizeof(csmFloat32) * frameCount * curveCount;
+
+    if (maxError >= 0.0f && report.MaxError > maxError)
+    {
+        CSM_DELETE(bakedData);
+        return report;
+    }
+
+    _bakedData = bakedData;
+    report.IsBaked = true;
+
+    return report;
+}
+
+void CubismMotion::ReleaseBake()
+{
+    CSM_DELETE(_bakedData);
+    _bakedData = NULL;
+}
+
+csmBool CubismMotion::IsBaked() const
+{
+    return _bakedData != NULL;
+}
+
+csmBool CubismMotion::SampleBakedCurves(csmFloat32 time, csmBool isCorrection, csmFloat32 endTime, const csmFloat32*& row, csmFloat32& alpha) const
+{
+    // ベイク後にループの設定が変わった場合は元のカーブを評価する
+    if (_bakedData == NULL || _bakedData->IsCorrection != isCorrection || _bakedData->EndTime != endTime)
+    {
+        return false;
+    }
+
+    const csmInt32 curveCount = _motionData->CurveCount;
+    const csmFloat32 position = CubismMath::RangeF(time * _bakedData->SampleRate, 0.0f, static_cast<csmFloat32>(_bakedData->FrameCount - 1));
+    csmInt32 frame = static_cast<csmInt32>(position);
+    if (frame >= _bakedData->FrameCount - 1)
+    {
+        frame = _bakedData->FrameCount - 2;
+    }
+
+    // 隣り合う2行の間を呼び出し側で線形補間する。共有されるモーションに書き込まないよう、結果はここで保持しない
+    alpha = position - static_cast<csmFloat32>(frame);
+    row = &_bakedData->Values[frame * curveCount];
+
+    return true;
 }
 
 void CubismMotion::UpdateForNextLoop(CubismMotionQueueEntry* motionQueueEntry, const csmFloat32 userTimeSeconds, const csmFloat32 time)
@@ -585,9 +848,9 @@ void CubismMotion::UpdateForNextLoop(CubismMotionQueueEntry* motionQueueEntry, c
             motionQueueEntry->SetFadeInStartTime(userTimeSeconds - time);
         }
 
-        if (this->_onFinishedMotion != NULL)
+        if (motionQueueEntry->_onFinishedMotion != NULL)
         {
-            this->_onFinishedMotion(this);
+            motionQueueEntry->_onFinishedMotion(this);
         }
         break;
     case MotionBehavior_V1:
@@ -743,6 +1006,11 @@ void CubismMotion::Parse(const csmByte* motionJson, const csmSizeInt size)
                 _motionData->Points[totalPointCount + 2].Time = json->GetMotionCurveSegment(curveCount, (segmentPosition + 5));
                 _motionData->Points[totalPointCount + 2].Value = json->GetMotionCurveSegment(curveCount, (segmentPosition + 6));
 
+                // 毎フレームの評価で多項式を組み直さないよう、係数を求めておく
+                _motionData->Segments[totalSegmentCount].BezierIndex = static_cast<csmInt32>(_motionData->Beziers.GetSize());
+                _motionData->Beziers.PushBack(CreateBezier(&_motionData->Points[_motionData->Segments[totalSegmentCount].BasePointIndex],
+                    areBeziersRestricted || UseOldBeziersCurveMotion));
+
                 totalPointCount += 3;
                 segmentPosition += 7;
 
@@ -790,6 +1058,9 @@ void CubismMotion::Parse(const csmByte* motionJson, const csmSizeInt size)
         _motionData->Events[userdatacount].Value = json->GetEventValue(userdatacount);
     }
 
+    // 発火判定を二分探索と走査位置の保持で行えるよう、発火時刻順に並べておく
+    SortEventsByFireTime(_motionData->Events);
+
     CSM_DELETE(json);
 }
 
@@ -900,20 +1171,53 @@ void CubismMotion::SetEffectIds(const csmVector<CubismIdHandle>& eyeBlinkParamet
     _lipSyncParameterIds = lipSyncParameterIds;
 }
 
-const csmVector<const csmString*>& CubismMotion::GetFiredEvent(csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds)
+const csmVector<const csmString*>& CubismMotion::GetFiredEvent(CubismMotionQueueEntry* motionQueueEntry, csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds)
 {
-    _firedEventValues.UpdateSize(0);
-    /// イベントの発火チェック
-    for (csmInt32 u = 0; u < _motionData->EventCount; ++u)
+    // 同じモーションを複数のモデルで再生できるよう、結果はキューのエントリに書き出す
+    csmVector<const csmString*>& firedEventValues = motionQueueEntry->_firedEventValues;
+    firedEventValues.UpdateSize(0);
+
+    const csmInt32 eventCount = _motionData->EventCount;
+    const csmFloat32 startTime = motionQueueEntry->GetStartTime();
+    csmInt32 cursor = motionQueueEntry->GetEventCursor();
+
+    // 前回の確認以降にループで開始時刻が変わっていれば、前のループの終端までに残ったイベントを発火させる
+    if (cursor >= 0 && motionQueueEntry->GetEventCursorStartTime() != startTime)
     {
-        if ((_motionData->Events[u].FireTime >beforeCheckTimeSeconds) &&
-            (_motionData->Events[u].FireTime <= motionTimeSeconds))
+        if (_isLoop)
         {
-            _firedEventValues.PushBack(&_motionData->Events[u].Value);
+            csmFloat32 loopDuration = _motionData->Duration;
+            if (_motionBehavior == MotionBehavior_V2)
+            {
+                loopDuration += 1.0f / _motionData->Fps;
+            }
+
+            for (; cursor < eventCount && _motionData->Events[cursor].FireTime <= loopDuration; ++cursor)
+            {
+                firedEventValues.PushBack(&_motionData->Events[cursor].Value);
+            }
         }
+
+        cursor = -1;
+    }
+
+    // 走査位置が前回の確認時刻と食い違う場合は探し直す
+    if (cursor < 0
+        || cursor > eventCount
+        || (cursor > 0 && _motionData->Events[cursor - 1].FireTime > beforeCheckTimeSeconds)
+        || (cursor < eventCount && _motionData->Events[cursor].FireTime <= beforeCheckTimeSeconds))
+    {
+        cursor = FindFirstEventAfter(_motionData, beforeCheckTimeSeconds);
     }
 
-    return _firedEventValues;
+    for (; cursor < eventCount && _motionData->Events[cursor].FireTime <= motionTimeSeconds; ++cursor)
+    {
+        firedEventValues.PushBack(&_motionData->Events[cursor].Value);
+    }
+
+    motionQueueEntry->SetEventCursor(cursor, startTime);
+
+    return firedEventValues;
 }
 
 csmBool CubismMotion::IsExistModelOpacity() const
@@ -16,6 +16,7 @@ namespace Live2D { namespace Cubism { namespace Framework {
 
 class CubismMotionQueueEntry;
 struct CubismMotionData;
+struct CubismMotionBakedData;
 
 /**
  * Handles motions.
@@ -33,6 +34,19 @@ public:
         MotionBehavior_V2,
     };
 
+    /**
+     * Result of baking the curves of a motion.
+     */
+    struct BakeReport
+    {
+        csmBool IsBaked;                ///< Whether the baked curves are used for evaluation
+        csmFloat32 SampleRate;          ///< Samples per second
+        csmInt32 FrameCount;            ///< Number of samples per curve
+        csmSizeInt MemorySize;          ///< Size of the baked curves in bytes
+        csmFloat32 MaxError;            ///< Largest difference from the analytic curves
+        csmInt32 MaxErrorCurveIndex;    ///< Index of the curve with the largest difference, or -1
+    };
+
     /**
      * Makes an instance.
      *
@@ -170,8 +184,12 @@ public:
     void SetEffectIds(const csmVector<CubismIdHandle>& eyeBlinkParameterIds, const csmVector<CubismIdHandle>& lipSyncParameterIds);
 
     /**
-     * Returns the triggered user data events.
+     * Returns the triggered user data events, resuming from the position kept in the queue entry.
      *
+     * Only the events between the position and the current time are examined.
+     * When a looping motion has restarted since the last check, the events left at the end of the previous loop are also returned.
+     *
+     * @param motionQueueEntry motion managed by CubismMotionQueueManager
      * @param beforeCheckTimeSeconds previous playback time in seconds
      * @param motionTimeSeconds current playback time in seconds
      *
@@ -179,7 +197,7 @@ public:
      *
      * @note The input times should be in seconds, with the motion timing set to zero.
      */
-    virtual const csmVector<const csmString*>& GetFiredEvent(csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds);
+    virtual const csmVector<const csmString*>& GetFiredEvent(CubismMotionQueueEntry* motionQueueEntry, csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds);
 
     /**
      * Checks whether there is an opacity curve.
@@ -202,6 +220,31 @@ public:
      */
     CubismIdHandle GetModelOpacityId(csmInt32 index);
 
+    /**
+     * Resamples all curves into a table at a uniform rate.
+     * While baked, the curves are evaluated by interpolating between two rows of the table instead of per segment.
+     * A higher rate uses more memory and follows the analytic curves more closely; stepped curves are approximated by ramps.
+     * The table is made for the current loop setting and is not used after the setting changes.
+     *
+     * @param sampleRate samples per second; twice the frame rate of the motion if 0 or less
+     * @param maxError largest allowed difference from the analytic curves; if exceeded, the table is discarded. Negative means no limit.
+     *
+     * @return size and accuracy of the table
+     */
+    BakeReport Bake(csmFloat32 sampleRate = 0.0f, csmFloat32 maxError = -1.0f);
+
+    /**
+     * Discards the table made by `Bake` and evaluates the analytic curves.
+     */
+    void ReleaseBake();
+
+    /**
+     * Checks whether the curves are baked.
+     *
+     * @return true if baked; otherwise false
+     */
+    csmBool IsBaked() const;
+
 protected:
     csmFloat32 GetModelOpacityValue() const;
 
@@ -217,12 +260,14 @@ private:
 
     void Parse(const csmByte* motionJson, const csmSizeInt size);
 
+    csmBool SampleBakedCurves(csmFloat32 time, csmBool isCorrection, csmFloat32 endTime, const csmFloat32*& row, csmFloat32& alpha) const;
+
     csmFloat32      _sourceFrameRate;
     csmFloat32      _loopDurationSeconds;
     MotionBehavior  _motionBehavior;
-    csmFloat32      _lastWeight;
 
     CubismMotionData*    _motionData;
+    CubismMotionBakedData*    _bakedData;
 
     csmVector<CubismIdHandle>  _eyeBlinkParameterIds;
     csmVector<CubismIdHandle>  _lipSyncParameterIds;
@@ -69,13 +69,104 @@ struct CubismMotionSegment
         : Evaluate(NULL)
         , BasePointIndex(0)
         , SegmentType(0)
+        , BezierIndex(-1)
     { }
 
     csmMotionSegmentEvaluationFunction Evaluate;        ///< Function to evaluate segment
     csmInt32 BasePointIndex;                            ///< Index of the first control point
     csmInt32 SegmentType;                               ///< Segment type
+    csmInt32 BezierIndex;                               ///< Index of the polynomial coefficients for Bezier segments, or -1
 };
 
+/**
+ * Polynomial coefficients of a Bezier segment, precomputed on parse
+ *
+ * The segment is x(t) = ((TimeA * t + TimeB) * t + TimeC) * t relative to the first control point,
+ * and y(t) = ((ValueA * t + ValueB) * t + ValueC) * t + ValueD, for t in [0, 1].
+ */
+struct CubismMotionBezier
+{
+    /**
+     * Constructor
+     */
+    CubismMotionBezier()
+        : TimeA(0.0f)
+        , TimeB(0.0f)
+        , TimeC(0.0f)
+        , StartTime(0.0f)
+        , InverseDuration(0.0f)
+        , ValueA(0.0f)
+        , ValueB(0.0f)
+        , ValueC(0.0f)
+        , ValueD(0.0f)
+        , IsTimeLinear(false)
+    { }
+
+    csmFloat32 TimeA;               ///< Cubic coefficient of time
+    csmFloat32 TimeB;               ///< Quadratic coefficient of time
+    csmFloat32 TimeC;               ///< Linear coefficient of time
+    csmFloat32 StartTime;           ///< Time of the first control point [seconds]
+    csmFloat32 InverseDuration;     ///< Reciprocal of the length of the segment [1/seconds]
+    csmFloat32 ValueA;              ///< Cubic coefficient of value
+    csmFloat32 ValueB;              ///< Quadratic coefficient of value
+    csmFloat32 ValueC;              ///< Linear coefficient of value
+    csmFloat32 ValueD;              ///< Value of the first control point
+    csmBool IsTimeLinear;           ///< Whether t is proportional to time (restricted Beziers)
+};
+
+/**
+ * Evaluates a restricted Bezier segment by de Casteljau interpolation, with t proportional to time.
+ * Previous evaluation of restricted Beziers; kept as the reference for BezierEvaluateCoefficients.
+ *
+ * @param points four control points
+ * @param time time in seconds
+ *
+ * @return value at the time
+ */
+csmFloat32 BezierEvaluate(const CubismMotionPoint* points, const csmFloat32 time);
+
+/**
+ * Evaluates a Bezier segment, solving t by bisection to a time error of 0.01 seconds.
+ *
+ * @param points four control points
+ * @param time time in seconds
+ *
+ * @return value at the time
+ */
+csmFloat32 BezierEvaluateBinarySearch(const CubismMotionPoint* points, const csmFloat32 time);
+
+/**
+ * Evaluates a Bezier segment, solving t with Cardano's formula.
+ * Previous evaluation of unrestricted Beziers; kept as the reference for BezierEvaluateCoefficients.
+ *
+ * @param points four control points
+ * @param time time in seconds
+ *
+ * @return value at the time
+ */
+csmFloat32 BezierEvaluateCardanoInterpretation(const CubismMotionPoint* points, const csmFloat32 time);
+
+/**
+ * Precomputes the polynomial form of a Bezier segment.
+ *
+ * @param points four control points
+ * @param isTimeLinear true for restricted Beziers, whose t is proportional to time
+ *
+ * @return coefficients of the segment
+ */
+CubismMotionBezier CreateBezier(const CubismMotionPoint* points, const csmBool isTimeLinear);
+
+/**
+ * Evaluates a Bezier segment from its precomputed coefficients.
+ * t is solved from the time by Newton steps seeded with the linear estimate, kept inside a bisection bracket.
+ *
+ * @param bezier coefficients made by CreateBezier
+ * @param time time in seconds
+ *
+ * @return value at the time
+ */
+csmFloat32 BezierEvaluateCoefficients(const CubismMotionBezier& bezier, const csmFloat32 time);
+
 /**
  * Data for motion curve
  */
@@ -140,7 +231,30 @@ struct CubismMotionData
     csmVector<CubismMotionCurve> Curves;            ///< Curve collection
     csmVector<CubismMotionSegment> Segments;        ///< Segment collection
     csmVector<CubismMotionPoint> Points;            ///< Control point collection
+    csmVector<CubismMotionBezier> Beziers;          ///< Coefficients of the Bezier segments
     csmVector<CubismMotionEvent> Events;            ///< User data event collection
 };
 
+/**
+ * Motion curves resampled at a uniform rate
+ */
+struct CubismMotionBakedData
+{
+    /**
+     * Constructor
+     */
+    CubismMotionBakedData()
+        : SampleRate(0.0f)
+        , EndTime(0.0f)
+        , IsCorrection(false)
+        , FrameCount(0)
+    { }
+
+    csmFloat32 SampleRate;                          ///< Samples per second
+    csmFloat32 EndTime;                             ///< Time of the last sample [seconds]
+    csmBool IsCorrection;                           ///< Whether the end point correction for looping is included
+    csmInt32 FrameCount;                            ///< Number of samples per curve
+    csmVector<csmFloat32> Values;                   ///< Sampled values of all curves, time-major (FrameCount x CurveCount)
+};
+
 }}}
@@ -22,9 +22,14 @@ CubismMotionQueueEntry::CubismMotionQueueEntry()
     , _stateTimeSeconds(0.0f)
     , _stateWeight(0.0f)
     , _lastEventCheckSeconds(0.0f)
+    , _eventCursor(-1)
+    , _eventCursorStartTimeSeconds(0.0f)
+    , _previousLoopState(false)
     , _motionQueueEntryHandle(NULL)
     , _fadeOutSeconds(0.0f)
     , _IsTriggeredFadeOut(false)
+    , _onBeganMotion(NULL)
+    , _onFinishedMotion(NULL)
 {
     this->_motionQueueEntryHandle = this;
 }
@@ -141,6 +146,22 @@ void CubismMotionQueueEntry::SetLastCheckEventTime(csmFloat32 checkTime)
     this->_lastEventCheckSeconds = checkTime;
 }
 
+csmInt32 CubismMotionQueueEntry::GetEventCursor() const
+{
+    return this->_eventCursor;
+}
+
+csmFloat32 CubismMotionQueueEntry::GetEventCursorStartTime() const
+{
+    return this->_eventCursorStartTimeSeconds;
+}
+
+void CubismMotionQueueEntry::SetEventCursor(csmInt32 cursor, csmFloat32 startTime)
+{
+    this->_eventCursor = cursor;
+    this->_eventCursorStartTimeSeconds = startTime;
+}
+
 csmBool CubismMotionQueueEntry::IsTriggeredFadeOut()
 {
     return this->_IsTriggeredFadeOut;
@@ -156,4 +177,24 @@ ACubismMotion* CubismMotionQueueEntry::GetCubismMotion()
     return _motion;
 }
 
+void CubismMotionQueueEntry::SetBeganMotionHandler(ACubismMotion::BeganMotionCallback onBeganMotionHandler)
+{
+    _onBeganMotion = onBeganMotionHandler;
+}
+
+ACubismMotion::BeganMotionCallback CubismMotionQueueEntry::GetBeganMotionHandler() const
+{
+    return _onBeganMotion;
+}
+
+void CubismMotionQueueEntry::SetFinishedMotionHandler(ACubismMotion::FinishedMotionCallback onFinishedMotionHandler)
+{
+    _onFinishedMotion = onFinishedMotionHandler;
+}
+
+ACubismMotion::FinishedMotionCallback CubismMotionQueueEntry::GetFinishedMotionHandler() const
+{
+    return _onFinishedMotion;
+}
+
 }}}
@@ -170,6 +170,28 @@ public:
      */
     void        SetLastCheckEventTime(csmFloat32 checkTime);
 
+    /**
+     * Returns the index of the next user data event to check.
+     *
+     * @return index into the events sorted by fire time; -1 if not checked yet
+     */
+    csmInt32    GetEventCursor() const;
+
+    /**
+     * Returns the start time of the motion when the event cursor was set.
+     *
+     * @return start time in seconds
+     */
+    csmFloat32  GetEventCursorStartTime() const;
+
+    /**
+     * Sets the index of the next user data event to check.
+     *
+     * @param cursor index into the events sorted by fire time; -1 to search again on the next check
+     * @param startTime start time of the motion the index refers to, in seconds
+     */
+    void        SetEventCursor(csmInt32 cursor, csmFloat32 startTime);
+
     /**
      * Checks whether the motion is currently fading out.
      *
@@ -186,6 +208,40 @@ public:
 
     ACubismMotion* GetCubismMotion();
 
+    /**
+     * Sets the callback for when this playback starts.
+     *
+     * The handler of the motion is copied when the playback is started.
+     * Setting it here only affects this playback, so that each model sharing a motion can have its own handler.
+     *
+     * @param onBeganMotionHandler motion playback start callback function; NULL for none
+     */
+    void        SetBeganMotionHandler(ACubismMotion::BeganMotionCallback onBeganMotionHandler);
+
+    /**
+     * Returns the callback for when this playback starts.
+     *
+     * @return motion playback start callback function; NULL if no function is set
+     */
+    ACubismMotion::BeganMotionCallback GetBeganMotionHandler() const;
+
+    /**
+     * Sets the callback for when this playback ends.
+     *
+     * The handler of the motion is copied when the playback is started.
+     * Setting it here only affects this playback, so that each model sharing a motion can have its own handler.
+     *
+     * @param onFinishedMotionHandler motion playback completion callback function; NULL for none
+     */
+    void        SetFinishedMotionHandler(ACubismMotion::FinishedMotionCallback onFinishedMotionHandler);
+
+    /**
+     * Returns the callback for when this playback ends.
+     *
+     * @return motion playback completion callback function; NULL if no function is set
+     */
+    ACubismMotion::FinishedMotionCallback GetFinishedMotionHandler() const;
+
 private:
     csmBool         _autoDelete;
     ACubismMotion*  _motion;
@@ -199,9 +255,17 @@ private:
     csmFloat32      _stateTimeSeconds;
     csmFloat32      _stateWeight;
     csmFloat32      _lastEventCheckSeconds;
+    csmInt32        _eventCursor;
+    csmFloat32      _eventCursorStartTimeSeconds;
+    csmBool         _previousLoopState;
     csmFloat32      _fadeOutSeconds;
     csmBool         _IsTriggeredFadeOut;
 
+    csmVector<const csmString*>  _firedEventValues;
+
+    ACubismMotion::BeganMotionCallback     _onBeganMotion;
+    ACubismMotion::FinishedMotionCallback  _onFinishedMotion;
+
     CubismMotionQueueEntryHandle  _motionQueueEntryHandle;
 };
 
@@ -55,6 +55,8 @@ CubismMotionQueueEntryHandle CubismMotionQueueManager::StartMotion(ACubismMotion
     motionQueueEntry = CSM_NEW CubismMotionQueueEntry(); // 終了時に破棄する
     motionQueueEntry->_autoDelete = autoDelete;
     motionQueueEntry->_motion = motion;
+    motionQueueEntry->_onBeganMotion = motion->GetBeganMotionHandler();
+    motionQueueEntry->_onFinishedMotion = motion->GetFinishedMotionHandler();
 
     _motions.PushBack(motionQueueEntry, false);
 
@@ -89,6 +91,8 @@ CubismMotionQueueEntryHandle CubismMotionQueueManager::StartMotion(ACubismMotion
     motionQueueEntry = CSM_NEW CubismMotionQueueEntry(); // 終了時に破棄する
     motionQueueEntry->_autoDelete = autoDelete;
     motionQueueEntry->_motion = motion;
+    motionQueueEntry->_onBeganMotion = motion->GetBeganMotionHandler();
+    motionQueueEntry->_onFinishedMotion = motion->GetFinishedMotionHandler();
 
     _motions.PushBack(motionQueueEntry, false);
 
@@ -128,7 +132,8 @@ csmBool CubismMotionQueueManager::DoUpdateMotion(CubismModel* model, csmFloat32
 
         // ------ ユーザトリガーイベントを検査する ----
         const csmVector<const csmString*>& firedList = motion->GetFiredEvent(
-            motionQueueEntry->GetLastCheckEventTime() - motionQueueEntry->GetStartTime()
+            motionQueueEntry
+            , motionQueueEntry->GetLastCheckEventTime() - motionQueueEntry->GetStartTime()
             , userTimeSeconds - motionQueueEntry->GetStartTime()
         );
 
@@ -35,6 +35,76 @@ const csmFloat32 MovementThreshold = 0.001f;
 /// Constant of maximum allowed delta time
 const csmFloat32 MaxDeltaTime = 5.0f;
 
+/// Minimum count of sub rigs to update in parallel.
+/// Dispatching costs more than it saves for models with only a few sub rigs.
+const csmInt32 ParallelUpdateMinimumSubRigCount = 8;
+
+/// Checks whether two sub rigs share a parameter that at least one of them writes.
+///
+/// @param  rig  Physics rig.
+/// @param  a    Index of the first sub rig.
+/// @param  b    Index of the second sub rig.
+///
+/// @return  true if the result depends on the order of evaluation.
+csmBool IsSubRigDependent(const CubismPhysicsRig* rig, csmInt32 a, csmInt32 b)
+{
+    const CubismPhysicsSubRig& settingA = rig->Settings[a];
+    const CubismPhysicsSubRig& settingB = rig->Settings[b];
+
+    for (csmInt32 i = 0; i < settingA.OutputCount; ++i)
+    {
+        const CubismIdHandle destination = rig->Outputs[settingA.BaseOutputIndex + i].Destination.Id;
+
+        for (csmInt32 j = 0; j < settingB.InputCount; ++j)
+        {
+            if (rig->Inputs[settingB.BaseInputIndex + j].Source.Id == destination)
+            {
+                return true;
+            }
+        }
+
+        for (csmInt32 j = 0; j < settingB.OutputCount; ++j)
+        {
+            if (rig->Outputs[settingB.BaseOutputIndex + j].Destination.Id == destination)
+            {
+                return true;
+            }
+        }
+    }
+
+    for (csmInt32 i = 0; i < settingB.OutputCount; ++i)
+    {
+        const CubismIdHandle destination = rig->Outputs[settingB.BaseOutputIndex + i].Destination.Id;
+
+        for (csmInt32 j = 0; j < settingA.InputCount; ++j)
+        {
+            if (rig->Inputs[settingA.BaseInputIndex + j].Source.Id == destination)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/// Finds the representative sub rig of the group.
+///
+/// @param  parents  Parent of each sub rig.
+/// @param  index    Index of the sub rig.
+///
+/// @return  Index of the representative sub rig.
+csmInt32 FindSubRigGroupRoot(csmVector<csmInt32>& parents, csmInt32 index)
+{
+    while (parents[index] != index)
+    {
+        parents[index] = parents[parents[index]];
+        index = parents[index];
+    }
+
+    return index;
+}
+
 csmFloat32 GetRangeValue(csmFloat32 min, csmFloat32 max)
 {
     csmFloat32 maxValue = CubismMath::Max(min, max);
@@ -145,8 +215,8 @@ csmFloat32 NormalizeParameterValue(
 void GetInputTranslationXFromNormalizedParameterValue(CubismVector2* targetTranslation, csmFloat32* targetAngle, csmFloat32 value,
     csmFloat32 parameterMinimumValue, csmFloat32 parameterMaximumValue,
     csmFloat32 parameterDefaultValue,
-    CubismPhysicsNormalization* normalizationPosition,
-    CubismPhysicsNormalization* normalizationAngle, csmInt32 isInverted,
+    const CubismPhysicsNormalization* normalizationPosition,
+    const CubismPhysicsNormalization* normalizationAngle, csmInt32 isInverted,
     csmFloat32 weight)
 {
     targetTranslation->X += NormalizeParameterValue(
@@ -164,8 +234,8 @@ void GetInputTranslationXFromNormalizedParameterValue(CubismVector2* targetTrans
 void GetInputTranslationYFromNormalizedParameterValue(CubismVector2* targetTranslation, csmFloat32* targetAngle, csmFloat32 value,
     csmFloat32 parameterMinimumValue, csmFloat32 parameterMaximumValue,
     csmFloat32 parameterDefaultValue,
-    CubismPhysicsNormalization* normalizationPosition,
-    CubismPhysicsNormalization* normalizationAngle,
+    const CubismPhysicsNormalization* normalizationPosition,
+    const CubismPhysicsNormalization* normalizationAngle,
     csmInt32 isInverted, csmFloat32 weight)
 {
     targetTranslation->Y += NormalizeParameterValue(
@@ -183,8 +253,8 @@ void GetInputTranslationYFromNormalizedParameterValue(CubismVector2* targetTrans
 void GetInputAngleFromNormalizedParameterValue(CubismVector2* targetTranslation, csmFloat32* targetAngle, csmFloat32 value,
     csmFloat32 parameterMinimumValue, csmFloat32 parameterMaximumValue,
     csmFloat32 parameterDefaultValue,
-    CubismPhysicsNormalization* normalizationPosition,
-    CubismPhysicsNormalization* normalizationAngle,
+    const CubismPhysicsNormalization* normalizationPosition,
+    const CubismPhysicsNormalization* normalizationAngle,
     csmInt32 isInverted, csmFloat32 weight)
 {
     *targetAngle += NormalizeParameterValue(
@@ -199,7 +269,7 @@ void GetInputAngleFromNormalizedParameterValue(CubismVector2* targetTranslation,
     ) * weight;
 }
 
-csmFloat32 GetOutputTranslationX(CubismVector2 translation, CubismPhysicsParticle* particles, csmInt32 particleIndex,
+csmFloat32 GetOutputTranslationX(CubismVector2 translation, CubismPhysicsParticleState* particles, csmInt32 particleIndex,
     csmInt32 isInverted, CubismVector2 parentGravity)
 {
     csmFloat32 outputValue = translation.X;
@@ -212,7 +282,7 @@ csmFloat32 GetOutputTranslationX(CubismVector2 translation, CubismPhysicsParticl
     return outputValue;
 }
 
-csmFloat32 GetOutputTranslationY(CubismVector2 translation, CubismPhysicsParticle* particles, csmInt32 particleIndex,
+csmFloat32 GetOutputTranslationY(CubismVector2 translation, CubismPhysicsParticleState* particles, csmInt32 particleIndex,
     csmInt32 isInverted, CubismVector2 parentGravity)
 {
     csmFloat32 outputValue = translation.Y;
@@ -225,7 +295,7 @@ csmFloat32 GetOutputTranslationY(CubismVector2 translation, CubismPhysicsParticl
     return outputValue;
 }
 
-csmFloat32 GetOutputAngle(CubismVector2 translation, CubismPhysicsParticle* particles, csmInt32 particleIndex, csmInt32 isInverted,
+csmFloat32 GetOutputAngle(CubismVector2 translation, CubismPhysicsParticleState* particles, csmInt32 particleIndex, csmInt32 isInverted,
     CubismVector2 parentGravity)
 {
     csmFloat32 outputValue;
@@ -267,6 +337,7 @@ csmFloat32 GetOutputScaleAngle(CubismVector2 translationScale, csmFloat32 angleS
 /// Updates particles.
 ///
 /// @param  strand            Target array of particle.
+/// @param  states            States of the target particles.
 /// @param  strandCount       Count of particle.
 /// @param  totalTranslation  Total translation value.
 /// @param  totalAngle        Total angle.
@@ -274,7 +345,7 @@ csmFloat32 GetOutputScaleAngle(CubismVector2 translationScale, csmFloat32 angleS
 /// @param  thresholdValue    Threshold of movement.
 /// @param  deltaTimeSeconds  Delta time.
 /// @param  airResistance     Air resistance.
-void UpdateParticles(CubismPhysicsParticle* strand, csmInt32 strandCount, CubismVector2 totalTranslation, csmFloat32 totalAngle,
+void UpdateParticles(const CubismPhysicsParticle* strand, CubismPhysicsParticleState* states, csmInt32 strandCount, CubismVector2 totalTranslation, csmFloat32 totalAngle,
     CubismVector2 windDirection, csmFloat32 thresholdValue, csmFloat32 deltaTimeSeconds, csmFloat32 airResistance)
 {
     csmInt32 i;
@@ -286,8 +357,10 @@ void UpdateParticles(CubismPhysicsParticle* strand, csmInt32 strandCount, Cubism
     CubismVector2 velocity;
     CubismVector2 force;
     CubismVector2 newDirection;
+    CubismVector2 particleForce;
+    CubismVector2 lastPosition;
 
-    strand[0].Position = totalTranslation;
+    states[0].Position = totalTranslation;
 
     totalRadian = CubismMath::DegreesToRadian(totalAngle);
     currentGravity = CubismMath::RadianToDirection(totalRadian);
@@ -295,49 +368,48 @@ void UpdateParticles(CubismPhysicsParticle* strand, csmInt32 strandCount, Cubism
 
     for (i = 1; i < strandCount; ++i)
     {
-        strand[i].Force = (currentGravity * strand[i].Acceleration) + windDirection;
+        particleForce = (currentGravity * strand[i].Acceleration) + windDirection;
 
-        strand[i].LastPosition = strand[i].Position;
+        lastPosition = states[i].Position;
 
         delay = strand[i].Delay * deltaTimeSeconds * 30.0f;
 
-        direction.X = strand[i].Position.X - strand[i - 1].Position.X;
-        direction.Y = strand[i].Position.Y - strand[i - 1].Position.Y;
+        direction.X = states[i].Position.X - states[i - 1].Position.X;
+        direction.Y = states[i].Position.Y - states[i - 1].Position.Y;
 
-        radian = CubismMath::DirectionToRadian(strand[i].LastGravity, currentGravity) / airResistance;
+        radian = CubismMath::DirectionToRadian(states[i].LastGravity, currentGravity) / airResistance;
 
         direction.X = ((CubismMath::CosF(radian) * direction.X) - (direction.Y * CubismMath::SinF(radian)));
         direction.Y = ((CubismMath::SinF(radian) * direction.X) + (direction.Y * CubismMath::CosF(radian)));
 
-        strand[i].Position = strand[i - 1].Position + direction;
+        states[i].Position = states[i - 1].Position + direction;
 
-        velocity.X = strand[i].Velocity.X * delay;
-        velocity.Y = strand[i].Velocity.Y * delay;
-        force = strand[i].Force * delay * delay;
+        velocity.X = states[i].Velocity.X * delay;
+        velocity.Y = states[i].Velocity.Y * delay;
+        force = particleForce * delay * delay;
 
-        strand[i].Position = strand[i].Position + velocity + force;
+        states[i].Position = states[i].Position + velocity + force;
 
-        newDirection = strand[i].Position - strand[i - 1].Position;
+        newDirection = states[i].Position - states[i - 1].Position;
 
         newDirection.Normalize();
 
-        strand[i].Position = strand[i - 1].Position + (newDirection * strand[i].Radius);
+        states[i].Position = states[i - 1].Position + (newDirection * strand[i].Radius);
 
-        if (CubismMath::AbsF(strand[i].Position.X) < thresholdValue)
+        if (CubismMath::AbsF(states[i].Position.X) < thresholdValue)
         {
-            strand[i].Position.X = 0.0f;
+            states[i].Position.X = 0.0f;
         }
 
         if (delay != 0.0f)
         {
-            strand[i].Velocity.X = strand[i].Position.X - strand[i].LastPosition.X;
-            strand[i].Velocity.Y = strand[i].Position.Y - strand[i].LastPosition.Y;
-            strand[i].Velocity /= delay;
-            strand[i].Velocity *= strand[i].Mobility;
+            states[i].Velocity.X = states[i].Position.X - lastPosition.X;
+            states[i].Velocity.Y = states[i].Position.Y - lastPosition.Y;
+            states[i].Velocity /= delay;
+            states[i].Velocity *= strand[i].Mobility;
         }
 
-        strand[i].Force = CubismVector2(0.0f, 0.0f);
-        strand[i].LastGravity = currentGravity;
+        states[i].LastGravity = currentGravity;
     }
 }
 
@@ -345,13 +417,14 @@ void UpdateParticles(CubismPhysicsParticle* strand, csmInt32 strandCount, Cubism
  * Updates particles for stabilization.
  *
  * @param strand                Target array of particle.
+ * @param states                States of the target particles.
  * @param strandCount           Count of particle.
  * @param totalTranslation      Total translation value.
  * @param totalAngle            Total angle.
  * @param windDirection         Direction of Wind.
  * @param thresholdValue        Threshold of movement.
  */
-void UpdateParticlesForStabilization(CubismPhysicsParticle* strand, csmInt32 strandCount, CubismVector2 totalTranslation, csmFloat32 totalAngle,
+void UpdateParticlesForStabilization(const CubismPhysicsParticle* strand, CubismPhysicsParticleState* states, csmInt32 strandCount, CubismVector2 totalTranslation, csmFloat32 totalAngle,
     CubismVector2 windDirection, csmFloat32 thresholdValue)
 {
     csmInt32 i;
@@ -359,7 +432,7 @@ void UpdateParticlesForStabilization(CubismPhysicsParticle* strand, csmInt32 str
     CubismVector2 currentGravity;
     CubismVector2 force;
 
-    strand[0].Position = totalTranslation;
+    states[0].Position = totalTranslation;
 
     totalRadian = CubismMath::DegreesToRadian(totalAngle);
     currentGravity = CubismMath::RadianToDirection(totalRadian);
@@ -367,25 +440,21 @@ void UpdateParticlesForStabilization(CubismPhysicsParticle* strand, csmInt32 str
 
     for (i = 1; i < strandCount; ++i)
     {
-        strand[i].Force = (currentGravity * strand[i].Acceleration) + windDirection;
-
-        strand[i].LastPosition = strand[i].Position;
+        force = (currentGravity * strand[i].Acceleration) + windDirection;
 
-        strand[i].Velocity = CubismVector2(0.0, 0.0);
+        states[i].Velocity = CubismVector2(0.0, 0.0);
 
-        force = strand[i].Force;
         force.Normalize();
 
         force *= strand[i].Radius;
-        strand[i].Position = strand[i - 1].Position + force;
+        states[i].Position = states[i - 1].Position + force;
 
-        if (CubismMath::AbsF(strand[i].Position.X) < thresholdValue)
+        if (CubismMath::AbsF(states[i].Position.X) < thresholdValue)
         {
-            strand[i].Position.X = 0.0f;
+            states[i].Position.X = 0.0f;
         }
 
-        strand[i].Force = CubismVector2(0.0f, 0.0f);
-        strand[i].LastGravity = currentGravity;
+        states[i].LastGravity = currentGravity;
     }
 }
 
@@ -395,8 +464,10 @@ void UpdateParticlesForStabilization(CubismPhysicsParticle* strand, csmInt32 str
 /// @param  parameterValueMinimum  Minimum of parameter value.
 /// @param  parameterValueMaximum  Maximum of parameter value.
 /// @param  translation            Translation value.
+/// @param  output                 Output setting.
+/// @param  outputState            State of the output.
 void UpdateOutputParameterValue(csmFloat32* parameterValue, csmFloat32 parameterValueMinimum, csmFloat32 parameterValueMaximum,
-    csmFloat32 translation, CubismPhysicsOutput* output)
+    csmFloat32 translation, const CubismPhysicsOutput* output, CubismPhysicsOutputState* outputState)
 {
     csmFloat32 outputScale;
     csmFloat32 value;
@@ -408,18 +479,18 @@ void UpdateOutputParameterValue(csmFloat32* parameterValue, csmFloat32 parameter
 
     if (value < parameterValueMinimum)
     {
-        if (value < output->ValueBelowMinimum)
+        if (value < outputState->ValueBelowMinimum)
         {
-            output->ValueBelowMinimum = value;
+            outputState->ValueBelowMinimum = value;
         }
 
         value = parameterValueMinimum;
     }
     else if (value > parameterValueMaximum)
     {
-        if (value > output->ValueExceededMaximum)
+        if (value > outputState->ValueExceededMaximum)
         {
-            output->ValueExceededMaximum = value;
+            outputState->ValueExceededMaximum = value;
         }
 
         value = parameterValueMaximum;
@@ -442,6 +513,7 @@ void UpdateOutputParameterValue(csmFloat32* parameterValue, csmFloat32 parameter
 
 CubismPhysics::CubismPhysics()
     : _physicsRig(NULL)
+    , _isParameterIndicesResolved(false)
 {
     // set default options.
     _options.Gravity.Y = -1.0f;
@@ -449,52 +521,134 @@ CubismPhysics::CubismPhysics()
     _options.Wind.X = 0;
     _options.Wind.Y = 0;
     _currentRemainTime = 0.0f;
+    _lastInterpolationWeight = 0.0f;
+    _levelOfDetail = LevelOfDetail_Full;
+    _reducedStepScale = 2.0f;
+    _reducedSubRigRatio = 0.5f;
+    _parallelFor = NULL;
 }
 
 CubismPhysics::~CubismPhysics()
 {
-    CSM_DELETE(_physicsRig);
+    if (_physicsRig != NULL)
+    {
+        // 減算と判定を1つの操作で行い、別スレッドで同時に破棄された場合も1回だけ削除する
+        if (_physicsRig->ReferenceCount.fetch_sub(1) == 1)
+        {
+            CSM_DELETE(_physicsRig);
+        }
+    }
     _parameterCaches.Clear();
     _parameterInputCaches.Clear();
 }
 
+/// Allocates the per-instance state for the shared rig.
+void CubismPhysics::CreateState()
+{
+    const csmInt32 inputCount = static_cast<csmInt32>(_physicsRig->Inputs.GetSize());
+    const csmInt32 outputCount = static_cast<csmInt32>(_physicsRig->Outputs.GetSize());
+
+    _particleStates.UpdateSize(_physicsRig->Particles.GetSize(), CubismPhysicsParticleState(), true);
+
+    CubismPhysicsOutputState outputState;
+    outputState.ValueBelowMinimum = 0.0f;
+    outputState.ValueExceededMaximum = 0.0f;
+    _outputStates.UpdateSize(outputCount, outputState, true);
+
+    _inputParameterIndices.UpdateSize(inputCount, -1, true);
+    _outputParameterIndices.UpdateSize(outputCount, -1, true);
+    _cachedParameterIndices.Clear();
+    _isParameterIndicesResolved = false;
+
+    _currentRigOutputs.UpdateSize(outputCount, 0.0f, true);
+    _previousRigOutputs.UpdateSize(outputCount, 0.0f, true);
+
+    Initialize();
+}
+
 /// Initializes physics.
 ///
 /// @param  physics  Target rig.
 void CubismPhysics::Initialize()
 {
-    CubismPhysicsParticle* strand;
-    CubismPhysicsSubRig* currentSetting;
+    CubismPhysicsParticleState* states;
+    const CubismPhysicsSubRig* currentSetting;
     csmInt32 i, settingIndex;
-    CubismVector2 radius;
 
     for (settingIndex = 0; settingIndex < _physicsRig->SubRigCount; ++settingIndex)
     {
         currentSetting = &_physicsRig->Settings[settingIndex];
-        strand = &_physicsRig->Particles[currentSetting->BaseParticleIndex];
+        states = &_particleStates[currentSetting->BaseParticleIndex];
 
         // Initialize the top of particle.
-        strand[0].InitialPosition = CubismVector2(0.0f, 0.0f);
-        strand[0].LastPosition = strand[0].InitialPosition;
-        strand[0].LastGravity = CubismVector2(0.0f, -1.0f);
-        strand[0].LastGravity.Y *= -1.0f;
-        strand[0].Velocity = CubismVector2(0.0f, 0.0f);
-        strand[0].Force = CubismVector2(0.0f, 0.0f);
+        states[0].LastGravity = CubismVector2(0.0f, -1.0f);
+        states[0].LastGravity.Y *= -1.0f;
+        states[0].Velocity = CubismVector2(0.0f, 0.0f);
 
         // Initialize particles.
         for (i = 1; i < currentSetting->ParticleCount; ++i)
         {
-            radius = CubismVector2(0.0f, 0.0f);
-            radius.Y = strand[i].Radius;
-            strand[i].InitialPosition = strand[i - 1].InitialPosition + radius;
-            strand[i].Position = strand[i].InitialPosition;
-            strand[i].LastPosition = strand[i].InitialPosition;
-            strand[i].LastGravity = CubismVector2(0.0f, -1.0f);
-            strand[i].LastGravity.Y *= -1.0f;
-            strand[i].Velocity = CubismVector2(0.0f, 0.0f);
-            strand[i].Force = CubismVector2(0.0f, 0.0f);
+            states[i].Position = _physicsRig->Particles[currentSetting->BaseParticleIndex + i].InitialPosition;
+            states[i].LastGravity = CubismVector2(0.0f, -1.0f);
+            states[i].LastGravity.Y *= -1.0f;
+            states[i].Velocity = CubismVector2(0.0f, 0.0f);
+        }
+    }
+}
+
+/// Resolves the parameter indices of inputs and outputs,
+/// and collects the parameters that have to be cached during evaluation.
+///
+/// @param  model  Target model.
+void CubismPhysics::ResolveParameterIndices(CubismModel* model)
+{
+    if (_isParameterIndicesResolved)
+    {
+        return;
+    }
+
+    _cachedParameterIndices.Clear();
+
+    const csmInt32 parameterCount = model->GetParameterCount();
+    csmVector<csmBool> isCached(parameterCount);
+    isCached.UpdateSize(parameterCount, false, true);
+
+    // 入力元だけでなく、出力先も前の値との重み付けとグループ間の値の伝搬でキャッシュを読むため対象に含める。
+    for (csmUint32 i = 0; i < _physicsRig->Inputs.GetSize(); ++i)
+    {
+        if (_inputParameterIndices[i] == -1)
+        {
+            _inputParameterIndices[i] = model->GetParameterIndex(_physicsRig->Inputs[i].Source.Id);
+        }
+
+        if (0 <= _inputParameterIndices[i] && _inputParameterIndices[i] < parameterCount)
+        {
+            isCached[_inputParameterIndices[i]] = true;
         }
     }
+
+    for (csmUint32 i = 0; i < _physicsRig->Outputs.GetSize(); ++i)
+    {
+        if (_outputParameterIndices[i] == -1)
+        {
+            _outputParameterIndices[i] = model->GetParameterIndex(_physicsRig->Outputs[i].Destination.Id);
+        }
+
+        if (0 <= _outputParameterIndices[i] && _outputParameterIndices[i] < parameterCount)
+        {
+            isCached[_outputParameterIndices[i]] = true;
+        }
+    }
+
+    for (csmInt32 i = 0; i < parameterCount; ++i)
+    {
+        if (isCached[i])
+        {
+            _cachedParameterIndices.PushBack(i);
+        }
+    }
+
+    _isParameterIndicesResolved = true;
 }
 
 /// Reset the physics states.
@@ -506,11 +660,6 @@ void CubismPhysics::Reset()
     _options.Wind.X = 0.0f;
     _options.Wind.Y = 0.0f;
 
-    _physicsRig->Gravity.X = 0.0f;
-    _physicsRig->Gravity.Y = 0.0f;
-    _physicsRig->Wind.X = 0.0f;
-    _physicsRig->Wind.Y = 0.0f;
-
     Initialize();
 }
 
@@ -526,7 +675,24 @@ CubismPhysics* CubismPhysics::Create(const csmByte* buffer, csmSizeInt size)
         return NULL;
     }
 
-    ret->_physicsRig->Gravity.Y = 0;
+    ret->CreateState();
+    return ret;
+}
+
+CubismPhysics* CubismPhysics::CreateShared(const CubismPhysics* source)
+{
+    if (source == NULL || source->_physicsRig == NULL)
+    {
+        return NULL;
+    }
+
+    CubismPhysics* ret = CSM_NEW CubismPhysics();
+
+    ret->_physicsRig = source->_physicsRig;
+    ++ret->_physicsRig->ReferenceCount;
+    ret->_isJsonValid = true;
+
+    ret->CreateState();
     return ret;
 }
 
@@ -538,6 +704,7 @@ void CubismPhysics::Delete(CubismPhysics* physics)
 void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
 {
     _physicsRig = CSM_NEW CubismPhysicsRig;
+    _physicsRig->ReferenceCount = 1;
 
     CubismPhysicsJson* json = CSM_NEW CubismPhysicsJson(physicsJson, size);
 
@@ -550,6 +717,7 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
     }
 
     _physicsRig->Gravity = json->GetGravity();
+    _physicsRig->Gravity.Y = 0;
     _physicsRig->Wind = json->GetWind();
     _physicsRig->SubRigCount = json->GetSubRigCount();
 
@@ -560,9 +728,6 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
     _physicsRig->Outputs.UpdateSize(json->GetTotalOutputCount(), CubismPhysicsOutput(), true);
     _physicsRig->Particles.UpdateSize(json->GetVertexCount(), CubismPhysicsParticle(), true);
 
-    _currentRigOutputs.Clear();
-    _previousRigOutputs.Clear();
-
     csmInt32 inputIndex = 0, outputIndex = 0, particleIndex = 0;
     for (csmUint32 i = 0; i < _physicsRig->Settings.GetSize(); ++i)
     {
@@ -579,7 +744,6 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
         _physicsRig->Settings[i].BaseInputIndex = inputIndex;
         for (csmInt32 j = 0; j < _physicsRig->Settings[i].InputCount; ++j)
         {
-            _physicsRig->Inputs[inputIndex + j].SourceParameterIndex = -1;
             _physicsRig->Inputs[inputIndex + j].Weight = json->GetInputWeight(i, j);
             _physicsRig->Inputs[inputIndex + j].Reflect = json->GetInputReflect(i, j);
 
@@ -608,17 +772,8 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
         _physicsRig->Settings[i].OutputCount = json->GetOutputCount(i);
         _physicsRig->Settings[i].BaseOutputIndex = outputIndex;
 
-        PhysicsOutput currentRigOutput;
-        currentRigOutput.outputs.Resize(_physicsRig->Settings[i].OutputCount);
-        _currentRigOutputs.PushBack(currentRigOutput);
-
-        PhysicsOutput previousRigOutput;
-        previousRigOutput.outputs.Resize(_physicsRig->Settings[i].OutputCount);
-        _previousRigOutputs.PushBack(previousRigOutput);
-
         for (csmInt32 j = 0; j < _physicsRig->Settings[i].OutputCount; ++j)
         {
-            _physicsRig->Outputs[outputIndex + j].DestinationParameterIndex = -1;
             _physicsRig->Outputs[outputIndex + j].VertexIndex = json->GetOutputVertexIndex(i, j);
             _physicsRig->Outputs[outputIndex + j].AngleScale = json->GetOutputAngleScale(i, j);
             _physicsRig->Outputs[outputIndex + j].Weight = json->GetOutputWeight(i, j);
@@ -657,13 +812,100 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
             _physicsRig->Particles[particleIndex + j].Delay = json->GetParticleDelay(i, j);
             _physicsRig->Particles[particleIndex + j].Acceleration = json->GetParticleAcceleration(i, j);
             _physicsRig->Particles[particleIndex + j].Radius = json->GetParticleRadius(i, j);
-            _physicsRig->Particles[particleIndex + j].Position = json->GetParticlePosition(i, j);
+        }
+
+        // Initial positions hang straight down from the top of particle.
+        CubismPhysicsParticle* strand = &_physicsRig->Particles[particleIndex];
+        for (csmInt32 j = 0; j < _physicsRig->Settings[i].ParticleCount; ++j)
+        {
+            if (j == 0)
+            {
+                strand[j].InitialPosition = CubismVector2(0.0f, 0.0f);
+            }
+            else
+            {
+                strand[j].InitialPosition = strand[j - 1].InitialPosition + CubismVector2(0.0f, strand[j].Radius);
+            }
         }
 
         particleIndex += _physicsRig->Settings[i].ParticleCount;
     }
 
-    Initialize();
+    // 振り子が長いサブリグほど見た目への影響が大きいとみなし、詳細度を下げた時の優先順位を決める。
+    csmVector<csmFloat32> strandLengths(_physicsRig->SubRigCount);
+    for (csmInt32 i = 0; i < _physicsRig->SubRigCount; ++i)
+    {
+        const CubismPhysicsSubRig& setting = _physicsRig->Settings[i];
+        csmFloat32 length = 0.0f;
+        for (csmInt32 j = 1; j < setting.ParticleCount; ++j)
+        {
+            length += _physicsRig->Particles[setting.BaseParticleIndex + j].Radius;
+        }
+        strandLengths.PushBack(length);
+    }
+
+    for (csmInt32 i = 0; i < _physicsRig->SubRigCount; ++i)
+    {
+        csmInt32 rank = 0;
+        for (csmInt32 j = 0; j < _physicsRig->SubRigCount; ++j)
+        {
+            if (strandLengths[j] > strandLengths[i] || (strandLengths[j] == strandLengths[i] && j < i))
+            {
+                ++rank;
+            }
+        }
+        _physicsRig->Settings[i].ImportanceRank = rank;
+    }
+
+    // パラメータを介して依存し合うサブリグを同じグループにまとめる。
+    // グループの代表は最も小さいインデックスのサブリグとし、グループ内は元の順序を保つ。
+    csmVector<csmInt32> groupParents(_physicsRig->SubRigCount);
+    for (csmInt32 i = 0; i < _physicsRig->SubRigCount; ++i)
+    {
+        groupParents.PushBack(i);
+    }
+
+    for (csmInt32 a = 0; a < _physicsRig->SubRigCount; ++a)
+    {
+        for (csmInt32 b = a + 1; b < _physicsRig->SubRigCount; ++b)
+        {
+            if (!IsSubRigDependent(_physicsRig, a, b))
+            {
+                continue;
+            }
+
+            const csmInt32 rootA = FindSubRigGroupRoot(groupParents, a);
+            const csmInt32 rootB = FindSubRigGroupRoot(groupParents, b);
+            if (rootA < rootB)
+            {
+                groupParents[rootB] = rootA;
+            }
+            else if (rootB < rootA)
+            {
+                groupParents[rootA] = rootB;
+            }
+        }
+    }
+
+    _physicsRig->SubRigGroupOrder.Clear();
+    _physicsRig->SubRigGroupOffsets.Clear();
+    for (csmInt32 root = 0; root < _physicsRig->SubRigCount; ++root)
+    {
+        if (FindSubRigGroupRoot(groupParents, root) != root)
+        {
+            continue;
+        }
+
+        _physicsRig->SubRigGroupOffsets.PushBack(static_cast<csmInt32>(_physicsRig->SubRigGroupOrder.GetSize()));
+        for (csmInt32 i = root; i < _physicsRig->SubRigCount; ++i)
+        {
+            if (FindSubRigGroupRoot(groupParents, i) == root)
+            {
+                _physicsRig->SubRigGroupOrder.PushBack(i);
+            }
+        }
+    }
+    _physicsRig->SubRigGroupOffsets.PushBack(static_cast<csmInt32>(_physicsRig->SubRigGroupOrder.GetSize()));
 
     CSM_DELETE(json);
 }
@@ -677,10 +919,15 @@ void CubismPhysics::Stabilization(CubismModel* model)
     csmFloat32 outputValue;
     CubismVector2 totalTranslation;
     csmInt32 i, settingIndex, particleIndex;
-    CubismPhysicsSubRig* currentSetting;
-    CubismPhysicsInput* currentInputs;
-    CubismPhysicsOutput* currentOutputs;
-    CubismPhysicsParticle* currentParticles;
+    const CubismPhysicsSubRig* currentSetting;
+    const CubismPhysicsInput* currentInputs;
+    const CubismPhysicsOutput* currentOutputs;
+    const CubismPhysicsParticle* currentParticles;
+    const csmInt32* currentInputParameterIndices;
+    const csmInt32* currentOutputParameterIndices;
+    CubismPhysicsParticleState* currentParticleStates;
+    CubismPhysicsOutputState* currentOutputStates;
+    csmFloat32* currentRigOutputs;
 
     csmFloat32* parameterValues;
     const csmFloat32* parameterMaximumValues;
@@ -692,6 +939,8 @@ void CubismPhysics::Stabilization(CubismModel* model)
     parameterMinimumValues = Core::csmGetParameterMinimumValues(model->GetModel());
     parameterDefaultValues = Core::csmGetParameterDefaultValues(model->GetModel());
 
+    ResolveParameterIndices(model);
+
     if (_parameterCaches.GetSize() < model->GetParameterCount())
     {
         _parameterCaches.Resize(model->GetParameterCount());
@@ -701,10 +950,14 @@ void CubismPhysics::Stabilization(CubismModel* model)
         _parameterInputCaches.Resize(model->GetParameterCount());
     }
 
-    for (int j = 0; j < model->GetParameterCount(); ++j)
+    // 物理演算が参照するパラメータだけをキャッシュする
+    const csmInt32* cachedParameterIndices = _cachedParameterIndices.GetPtr();
+    const csmInt32 cachedParameterCount = static_cast<csmInt32>(_cachedParameterIndices.GetSize());
+    for (csmInt32 j = 0; j < cachedParameterCount; ++j)
     {
-        _parameterCaches[j] = parameterValues[j];
-        _parameterInputCaches[j] = parameterValues[j];
+        const csmInt32 parameterIndex = cachedParameterIndices[j];
+        _parameterCaches[parameterIndex] = parameterValues[parameterIndex];
+        _parameterInputCaches[parameterIndex] = parameterValues[parameterIndex];
     }
 
     for (settingIndex = 0; settingIndex < _physicsRig->SubRigCount; ++settingIndex)
@@ -716,32 +969,32 @@ void CubismPhysics::Stabilization(CubismModel* model)
         currentInputs = &_physicsRig->Inputs[currentSetting->BaseInputIndex];
         currentOutputs = &_physicsRig->Outputs[currentSetting->BaseOutputIndex];
         currentParticles = &_physicsRig->Particles[currentSetting->BaseParticleIndex];
+        currentInputParameterIndices = &_inputParameterIndices[currentSetting->BaseInputIndex];
+        currentOutputParameterIndices = &_outputParameterIndices[currentSetting->BaseOutputIndex];
+        currentParticleStates = &_particleStates[currentSetting->BaseParticleIndex];
+        currentOutputStates = &_outputStates[currentSetting->BaseOutputIndex];
+        currentRigOutputs = &_currentRigOutputs[currentSetting->BaseOutputIndex];
 
         // Load input parameters
         for (i = 0; i < currentSetting->InputCount; ++i)
         {
             weight = currentInputs[i].Weight / MaximumWeight;
 
-            if (currentInputs[i].SourceParameterIndex == -1)
-            {
-                currentInputs[i].SourceParameterIndex = model->GetParameterIndex(currentInputs[i].Source.Id);
-            }
-
             currentInputs[i].GetNormalizedParameterValue(
                 &totalTranslation,
                 &totalAngle,
-                parameterValues[currentInputs[i].SourceParameterIndex],
-                parameterMinimumValues[currentInputs[i].SourceParameterIndex],
-                parameterMaximumValues[currentInputs[i].SourceParameterIndex],
-                parameterDefaultValues[currentInputs[i].SourceParameterIndex],
+                parameterValues[currentInputParameterIndices[i]],
+                parameterMinimumValues[currentInputParameterIndices[i]],
+                parameterMaximumValues[currentInputParameterIndices[i]],
+                parameterDefaultValues[currentInputParameterIndices[i]],
                 &currentSetting->NormalizationPosition,
                 &currentSetting->NormalizationAngle,
                 currentInputs[i].Reflect,
                 weight
             );
 
-            _parameterCaches[currentInputs[i].SourceParameterIndex] =
-                parameterValues[currentInputs[i].SourceParameterIndex];
+            _parameterCaches[currentInputParameterIndices[i]] =
+                parameterValues[currentInputParameterIndices[i]];
         }
 
         radAngle = CubismMath::DegreesToRadian(-totalAngle);
@@ -752,6 +1005,7 @@ void CubismPhysics::Stabilization(CubismModel* model)
         // Calculate particles position.
         UpdateParticlesForStabilization(
             currentParticles,
+            currentParticleStates,
             currentSetting->ParticleCount,
             totalTranslation,
             totalAngle,
@@ -764,44 +1018,58 @@ void CubismPhysics::Stabilization(CubismModel* model)
         {
             particleIndex = currentOutputs[i].VertexIndex;
 
-            if (currentOutputs[i].DestinationParameterIndex == -1)
-            {
-                currentOutputs[i].DestinationParameterIndex = model->GetParameterIndex(
-                    currentOutputs[i].Destination.Id);
-            }
-
             if (particleIndex < 1 || particleIndex >= currentSetting->ParticleCount)
             {
                 continue;
             }
 
             CubismVector2 translation;
-            translation.X = currentParticles[particleIndex].Position.X - currentParticles[particleIndex - 1].Position.X;
-            translation.Y = currentParticles[particleIndex].Position.Y - currentParticles[particleIndex - 1].Position.Y;
+            translation.X = currentParticleStates[particleIndex].Position.X - currentParticleStates[particleIndex - 1].Position.X;
+            translation.Y = currentParticleStates[particleIndex].Position.Y - currentParticleStates[particleIndex - 1].Position.Y;
 
             outputValue = currentOutputs[i].GetValue(
                 translation,
-                currentParticles,
+                currentParticleStates,
                 particleIndex,
                 currentOutputs[i].Reflect,
                 _options.Gravity
             );
 
-            _currentRigOutputs[settingIndex].outputs[i] = outputValue;
-            _previousRigOutputs[settingIndex].outputs[i] = outputValue;
+            currentRigOutputs[i] = outputValue;
+            _previousRigOutputs[currentSetting->BaseOutputIndex + i] = outputValue;
+
+            const csmFloat32 previousValue = parameterValues[currentOutputParameterIndices[i]];
 
             UpdateOutputParameterValue(
-                &parameterValues[currentOutputs[i].DestinationParameterIndex],
-                parameterMinimumValues[currentOutputs[i].DestinationParameterIndex],
-                parameterMaximumValues[currentOutputs[i].DestinationParameterIndex],
+                &parameterValues[currentOutputParameterIndices[i]],
+                parameterMinimumValues[currentOutputParameterIndices[i]],
+                parameterMaximumValues[currentOutputParameterIndices[i]],
                 outputValue,
-                &currentOutputs[i]);
+                &currentOutputs[i],
+                &currentOutputStates[i]);
+
+            // パラメータを直接書き換えているため、値が変わればモデルに再計算を要求する
+            if (parameterValues[currentOutputParameterIndices[i]] != previousValue)
+            {
+                model->MarkParametersDirty();
+            }
 
-            _parameterCaches[currentOutputs[i].DestinationParameterIndex] = parameterValues[currentOutputs[i].DestinationParameterIndex];
+            _parameterCaches[currentOutputParameterIndices[i]] = parameterValues[currentOutputParameterIndices[i]];
         }
     }
 }
 
+/// Parameters shared by the sub-rig jobs dispatched from Evaluate.
+struct CubismPhysics::SubRigUpdateContext
+{
+    CubismPhysics* Physics;                     ///< 演算するインスタンス
+    csmFloat32 PhysicsDeltaTime;                ///< 1ステップの時間[秒]
+    csmInt32 ActiveSubRigCount;                 ///< 演算するサブリグの数（優先順位がこれ未満のものを演算する）
+    const csmFloat32* ParameterMinimumValues;   ///< パラメータの最小値
+    const csmFloat32* ParameterMaximumValues;   ///< パラメータの最大値
+    const csmFloat32* ParameterDefaultValues;   ///< パラメータのデフォルト値
+};
+
 /// Pendulum interpolation weights
 ///
 /// 振り子の計算結果は保存され、パラメータへの出力は保存された前回の結果で補間されます。
@@ -842,16 +1110,7 @@ void CubismPhysics::Stabilization(CubismModel* model)
 /// @param deltaTimeSeconds  rendering delta time.
 void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
 {
-    csmFloat32 totalAngle;
-    csmFloat32 weight;
-    csmFloat32 radAngle;
-    csmFloat32 outputValue;
-    CubismVector2 totalTranslation;
-    csmInt32 i, settingIndex, particleIndex;
-    CubismPhysicsSubRig* currentSetting;
-    CubismPhysicsInput* currentInputs;
-    CubismPhysicsOutput* currentOutputs;
-    CubismPhysicsParticle* currentParticles;
+    csmInt32 settingIndex;
 
     if (0.0f >= deltaTimeSeconds)
     {
@@ -864,6 +1123,36 @@ void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
     const csmFloat32* parameterDefaultValues;
 
     csmFloat32 physicsDeltaTime;
+
+    if (_physicsRig->Fps > 0.0f)
+    {
+        physicsDeltaTime = 1.0f / _physicsRig->Fps;
+    }
+    else
+    {
+        physicsDeltaTime = deltaTimeSeconds;
+    }
+
+    if (_levelOfDetail == LevelOfDetail_Frozen)
+    {
+        // 演算を進めず、前回と同じ出力を適用する。
+        // LevelOfDetail_Reducedから切り替えた直後は残り時間が通常の演算間隔を超えていることがあるため、重みは計算し直さない
+        ResolveParameterIndices(model);
+        Interpolate(model, _lastInterpolationWeight);
+        return;
+    }
+
+    csmInt32 activeSubRigCount = _physicsRig->SubRigCount;
+    if (_levelOfDetail == LevelOfDetail_Reduced)
+    {
+        physicsDeltaTime *= _reducedStepScale;
+        activeSubRigCount = static_cast<csmInt32>(ceilf(_physicsRig->SubRigCount * _reducedSubRigRatio));
+        if (activeSubRigCount < 1)
+        {
+            activeSubRigCount = 1;
+        }
+    }
+
     _currentRemainTime += deltaTimeSeconds;
     if (_currentRemainTime > MaxDeltaTime)
     {
@@ -875,6 +1164,11 @@ void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
     parameterMinimumValues = Core::csmGetParameterMinimumValues(model->GetModel());
     parameterDefaultValues = Core::csmGetParameterDefaultValues(model->GetModel());
 
+    ResolveParameterIndices(model);
+
+    const csmInt32* cachedParameterIndices = _cachedParameterIndices.GetPtr();
+    const csmInt32 cachedParameterCount = static_cast<csmInt32>(_cachedParameterIndices.GetSize());
+
     if (_parameterCaches.GetSize() < model->GetParameterCount())
     {
         _parameterCaches.Resize(model->GetParameterCount());
@@ -882,145 +1176,202 @@ void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
     if (_parameterInputCaches.GetSize() < model->GetParameterCount())
     {
         _parameterInputCaches.Resize(model->GetParameterCount());
-        for (int j = 0; j < model->GetParameterCount(); ++j) {
-            _parameterInputCaches[j] = parameterValues[j];
+        for (csmInt32 j = 0; j < cachedParameterCount; ++j)
+        {
+            _parameterInputCaches[cachedParameterIndices[j]] = parameterValues[cachedParameterIndices[j]];
         }
     }
 
-    if (_physicsRig->Fps > 0.0f)
-    {
-        physicsDeltaTime = 1.0f / _physicsRig->Fps;
-    }
-    else
-    {
-        physicsDeltaTime = deltaTimeSeconds;
-    }
-
     while (_currentRemainTime >= physicsDeltaTime)
     {
         // copyRigOutputs _currentRigOutputs to _previousRigOutputs
-        for (settingIndex = 0; settingIndex < _physicsRig->SubRigCount; ++settingIndex)
+        for (csmUint32 j = 0; j < _currentRigOutputs.GetSize(); ++j)
         {
-            currentSetting = &_physicsRig->Settings[settingIndex];
-            currentOutputs = &_physicsRig->Outputs[currentSetting->BaseOutputIndex];
-            for (i = 0; i < currentSetting->OutputCount; ++i)
-            {
-                _previousRigOutputs[settingIndex].outputs[i] = _currentRigOutputs[settingIndex].outputs[i];
-            }
+            _previousRigOutputs[j] = _currentRigOutputs[j];
         }
 
         // 入力キャッシュとパラメータで線形補間してUpdateParticlesするタイミングでの入力を計算する。
         // Calculate the input at the timing to UpdateParticles by linear interpolation with the _parameterInputCaches and parameterValues.
         // _parameterCachesはグループ間での値の伝搬の役割があるので_parameterInputCachesとの分離が必要。
         // _parameterCaches needs to be separated from _parameterInputCaches because of its role in propagating values between groups.
+        // 物理演算の入力・出力で参照しないパラメータのキャッシュは読まれないため、参照するパラメータだけを計算する。
+        // Only the parameters referenced by inputs and outputs are interpolated, since the other caches are never read.
         float inputWeight =  physicsDeltaTime / _currentRemainTime;
-        for (csmInt32 j = 0; j < model->GetParameterCount(); ++j)
+        for (csmInt32 j = 0; j < cachedParameterCount; ++j)
         {
-            _parameterCaches[j] = _parameterInputCaches[j] * (1.0f - inputWeight) + parameterValues[j] * inputWeight;
-            _parameterInputCaches[j] = _parameterCaches[j];
+            const csmInt32 parameterIndex = cachedParameterIndices[j];
+            _parameterCaches[parameterIndex] = _parameterInputCaches[parameterIndex] * (1.0f - inputWeight) + parameterValues[parameterIndex] * inputWeight;
+            _parameterInputCaches[parameterIndex] = _parameterCaches[parameterIndex];
         }
 
-        for (settingIndex = 0; settingIndex < _physicsRig->SubRigCount; ++settingIndex)
+        const csmInt32 groupCount = static_cast<csmInt32>(_physicsRig->SubRigGroupOffsets.GetSize()) - 1;
+        if (_parallelFor != NULL && groupCount >= 2 && activeSubRigCount >= ParallelUpdateMinimumSubRigCount)
         {
-            totalAngle = 0.0f;
-            totalTranslation.X = 0.0f;
-            totalTranslation.Y = 0.0f;
-            currentSetting = &_physicsRig->Settings[settingIndex];
-            currentInputs = &_physicsRig->Inputs[currentSetting->BaseInputIndex];
-            currentOutputs = &_physicsRig->Outputs[currentSetting->BaseOutputIndex];
-            currentParticles = &_physicsRig->Particles[currentSetting->BaseParticleIndex];
-
-            // Load input parameters.
-            for (i = 0; i < currentSetting->InputCount; ++i)
+            SubRigUpdateContext context;
+            context.Physics = this;
+            context.PhysicsDeltaTime = physicsDeltaTime;
+            context.ActiveSubRigCount = activeSubRigCount;
+            context.ParameterMinimumValues = parameterMinimumValues;
+            context.ParameterMaximumValues = parameterMaximumValues;
+            context.ParameterDefaultValues = parameterDefaultValues;
+
+            _parallelFor(groupCount, &context, UpdateSubRigGroup);
+        }
+        else
+        {
+            for (settingIndex = 0; settingIndex < _physicsRig->SubRigCount; ++settingIndex)
             {
-                weight = currentInputs[i].Weight / MaximumWeight;
-
-                if (currentInputs[i].SourceParameterIndex == -1)
+                // 詳細度を下げている場合、優先順位の低いサブリグは前回の出力を保持する
+                if (_physicsRig->Settings[settingIndex].ImportanceRank >= activeSubRigCount)
                 {
-                    currentInputs[i].SourceParameterIndex = model->GetParameterIndex(currentInputs[i].Source.Id);
+                    continue;
                 }
 
-                currentInputs[i].GetNormalizedParameterValue(
-                    &totalTranslation,
-                    &totalAngle,
-                    _parameterCaches[currentInputs[i].SourceParameterIndex],
-                    parameterMinimumValues[currentInputs[i].SourceParameterIndex],
-                    parameterMaximumValues[currentInputs[i].SourceParameterIndex],
-                    parameterDefaultValues[currentInputs[i].SourceParameterIndex],
-                    &currentSetting->NormalizationPosition,
-                    &currentSetting->NormalizationAngle,
-                    currentInputs[i].Reflect,
-                    weight
-                );
+                UpdateSubRig(settingIndex, physicsDeltaTime, parameterMinimumValues, parameterMaximumValues, parameterDefaultValues);
             }
+        }
 
-            radAngle = CubismMath::DegreesToRadian(-totalAngle);
-
-            totalTranslation.X = (totalTranslation.X * CubismMath::CosF(radAngle) - totalTranslation.Y * CubismMath::SinF(radAngle));
-            totalTranslation.Y = (totalTranslation.X * CubismMath::SinF(radAngle) + totalTranslation.Y * CubismMath::CosF(radAngle));
-
-            // Calculate particles position.
-            UpdateParticles(
-                currentParticles,
-                currentSetting->ParticleCount,
-                totalTranslation,
-                totalAngle,
-                _options.Wind,
-                MovementThreshold * currentSetting->NormalizationPosition.Maximum,
-                physicsDeltaTime,
-                AirResistance
-            );
+        _currentRemainTime -= physicsDeltaTime;
+    }
 
-            // Update output parameters.
-            for (i = 0; i < currentSetting->OutputCount; ++i)
-            {
-                particleIndex = currentOutputs[i].VertexIndex;
+    const float alpha = _currentRemainTime / physicsDeltaTime;
+    _lastInterpolationWeight = alpha;
+    Interpolate(model, alpha);
+}
 
-                if (currentOutputs[i].DestinationParameterIndex == -1)
-                {
-                    currentOutputs[i].DestinationParameterIndex = model->GetParameterIndex(currentOutputs[i].Destination.Id);
-                }
+void CubismPhysics::UpdateSubRig(csmInt32 settingIndex, csmFloat32 physicsDeltaTime,
+    const csmFloat32* parameterMinimumValues, const csmFloat32* parameterMaximumValues, const csmFloat32* parameterDefaultValues)
+{
+    csmFloat32 totalAngle;
+    csmFloat32 weight;
+    csmFloat32 radAngle;
+    csmFloat32 outputValue;
+    CubismVector2 totalTranslation;
+    csmInt32 i, particleIndex;
+    const CubismPhysicsSubRig* currentSetting;
+    const CubismPhysicsInput* currentInputs;
+    const CubismPhysicsOutput* currentOutputs;
+    const CubismPhysicsParticle* currentParticles;
+    const csmInt32* currentInputParameterIndices;
+    const csmInt32* currentOutputParameterIndices;
+    CubismPhysicsParticleState* currentParticleStates;
+    CubismPhysicsOutputState* currentOutputStates;
+    csmFloat32* currentRigOutputs;
+
+    totalAngle = 0.0f;
+    totalTranslation.X = 0.0f;
+    totalTranslation.Y = 0.0f;
+    currentSetting = &_physicsRig->Settings[settingIndex];
+    currentInputs = &_physicsRig->Inputs[currentSetting->BaseInputIndex];
+    currentOutputs = &_physicsRig->Outputs[currentSetting->BaseOutputIndex];
+    currentParticles = &_physicsRig->Particles[currentSetting->BaseParticleIndex];
+    currentInputParameterIndices = &_inputParameterIndices[currentSetting->BaseInputIndex];
+    currentOutputParameterIndices = &_outputParameterIndices[currentSetting->BaseOutputIndex];
+    currentParticleStates = &_particleStates[currentSetting->BaseParticleIndex];
+    currentOutputStates = &_outputStates[currentSetting->BaseOutputIndex];
+    currentRigOutputs = &_currentRigOutputs[currentSetting->BaseOutputIndex];
+
+    // Load input parameters.
+    for (i = 0; i < currentSetting->InputCount; ++i)
+    {
+        weight = currentInputs[i].Weight / MaximumWeight;
+
+        currentInputs[i].GetNormalizedParameterValue(
+            &totalTranslation,
+            &totalAngle,
+            _parameterCaches[currentInputParameterIndices[i]],
+            parameterMinimumValues[currentInputParameterIndices[i]],
+            parameterMaximumValues[currentInputParameterIndices[i]],
+            parameterDefaultValues[currentInputParameterIndices[i]],
+            &currentSetting->NormalizationPosition,
+            &currentSetting->NormalizationAngle,
+            currentInputs[i].Reflect,
+            weight
+        );
+    }
 
-                if (particleIndex < 1 || particleIndex >= currentSetting->ParticleCount)
-                {
-                    continue;
-                }
+    radAngle = CubismMath::DegreesToRadian(-totalAngle);
+
+    totalTranslation.X = (totalTranslation.X * CubismMath::CosF(radAngle) - totalTranslation.Y * CubismMath::SinF(radAngle));
+    totalTranslation.Y = (totalTranslation.X * CubismMath::SinF(radAngle) + totalTranslation.Y * CubismMath::CosF(radAngle));
+
+    // Calculate particles position.
+    UpdateParticles(
+        currentParticles,
+        currentParticleStates,
+        currentSetting->ParticleCount,
+        totalTranslation,
+        totalAngle,
+        _options.Wind,
+        MovementThreshold * currentSetting->NormalizationPosition.Maximum,
+        physicsDeltaTime,
+        AirResistance
+    );
+
+    // Update output parameters.
+    for (i = 0; i < currentSetting->OutputCount; ++i)
+    {
+        particleIndex = currentOutputs[i].VertexIndex;
 
-                CubismVector2 translation;
-                translation.X = currentParticles[particleIndex].Position.X - currentParticles[particleIndex - 1].Position.X;
-                translation.Y = currentParticles[particleIndex].Position.Y - currentParticles[particleIndex - 1].Position.Y;
-
-                outputValue = currentOutputs[i].GetValue(
-                    translation,
-                    currentParticles,
-                    particleIndex,
-                    currentOutputs[i].Reflect,
-                    _options.Gravity
-                );
-
-                _currentRigOutputs[settingIndex].outputs[i] = outputValue;
-
-                UpdateOutputParameterValue(
-                        &_parameterCaches[currentOutputs[i].DestinationParameterIndex],
-                        parameterMinimumValues[currentOutputs[i].DestinationParameterIndex],
-                        parameterMaximumValues[currentOutputs[i].DestinationParameterIndex],
-                        outputValue,
-                        &currentOutputs[i]);
-            }
+        if (particleIndex < 1 || particleIndex >= currentSetting->ParticleCount)
+        {
+            continue;
         }
 
-        _currentRemainTime -= physicsDeltaTime;
+        CubismVector2 translation;
+        translation.X = currentParticleStates[particleIndex].Position.X - currentParticleStates[particleIndex - 1].Position.X;
+        translation.Y = currentParticleStates[particleIndex].Position.Y - currentParticleStates[particleIndex - 1].Position.Y;
+
+        outputValue = currentOutputs[i].GetValue(
+            translation,
+            currentParticleStates,
+            particleIndex,
+            currentOutputs[i].Reflect,
+            _options.Gravity
+        );
+
+        currentRigOutputs[i] = outputValue;
+
+        UpdateOutputParameterValue(
+                &_parameterCaches[currentOutputParameterIndices[i]],
+                parameterMinimumValues[currentOutputParameterIndices[i]],
+                parameterMaximumValues[currentOutputParameterIndices[i]],
+                outputValue,
+                &currentOutputs[i],
+                &currentOutputStates[i]);
     }
+}
 
-    const float alpha = _currentRemainTime / physicsDeltaTime;
-    Interpolate(model, alpha);
+void CubismPhysics::UpdateSubRigGroup(void* context, csmInt32 groupIndex)
+{
+    const SubRigUpdateContext* updateContext = static_cast<const SubRigUpdateContext*>(context);
+    CubismPhysics* physics = updateContext->Physics;
+    const CubismPhysicsRig* rig = physics->_physicsRig;
+
+    for (csmInt32 i = rig->SubRigGroupOffsets[groupIndex]; i < rig->SubRigGroupOffsets[groupIndex + 1]; ++i)
+    {
+        const csmInt32 settingIndex = rig->SubRigGroupOrder[i];
+
+        if (rig->Settings[settingIndex].ImportanceRank >= updateContext->ActiveSubRigCount)
+        {
+            continue;
+        }
+
+        physics->UpdateSubRig(
+            settingIndex,
+            updateContext->PhysicsDeltaTime,
+            updateContext->ParameterMinimumValues,
+            updateContext->ParameterMaximumValues,
+            updateContext->ParameterDefaultValues
+        );
+    }
 }
 
 void CubismPhysics::Interpolate(CubismModel* model, csmFloat32 weight)
 {
-    csmInt32 i, settingIndex;
-    CubismPhysicsOutput* currentOutputs;
-    CubismPhysicsSubRig* currentSetting;
+    csmInt32 i, settingIndex, outputIndex;
+    const CubismPhysicsOutput* currentOutputs;
+    const CubismPhysicsSubRig* currentSetting;
     csmFloat32* parameterValues;
     const csmFloat32* parameterMaximumValues;
     const csmFloat32* parameterMinimumValues;
@@ -1037,18 +1388,29 @@ void CubismPhysics::Interpolate(CubismModel* model, csmFloat32 weight)
         // Load input parameters.
         for (i = 0; i < currentSetting->OutputCount; ++i)
         {
-            if (currentOutputs[i].DestinationParameterIndex == -1)
+            outputIndex = currentSetting->BaseOutputIndex + i;
+
+            if (_outputParameterIndices[outputIndex] == -1)
             {
                 continue;
             }
 
+            const csmFloat32 previousValue = parameterValues[_outputParameterIndices[outputIndex]];
+
             UpdateOutputParameterValue(
-                &parameterValues[currentOutputs[i].DestinationParameterIndex],
-                parameterMinimumValues[currentOutputs[i].DestinationParameterIndex],
-                parameterMaximumValues[currentOutputs[i].DestinationParameterIndex],
-                _previousRigOutputs[settingIndex].outputs[i] * (1 - weight) + _currentRigOutputs[settingIndex].outputs[i] * weight,
-                &currentOutputs[i]
+                &parameterValues[_outputParameterIndices[outputIndex]],
+                parameterMinimumValues[_outputParameterIndices[outputIndex]],
+                parameterMaximumValues[_outputParameterIndices[outputIndex]],
+                _previousRigOutputs[outputIndex] * (1 - weight) + _currentRigOutputs[outputIndex] * weight,
+                &currentOutputs[i],
+                &_outputStates[outputIndex]
             );
+
+            // パラメータを直接書き換えているため、値が変わればモデルに再計算を要求する
+            if (parameterValues[_outputParameterIndices[outputIndex]] != previousValue)
+            {
+                model->MarkParametersDirty();
+            }
         }
     }
 }
@@ -1063,4 +1425,25 @@ const CubismPhysics::Options& CubismPhysics::GetOptions() const
     return _options;
 }
 
+void CubismPhysics::SetLevelOfDetail(LevelOfDetail level)
+{
+    _levelOfDetail = level;
+}
+
+CubismPhysics::LevelOfDetail CubismPhysics::GetLevelOfDetail() const
+{
+    return _levelOfDetail;
+}
+
+void CubismPhysics::SetReducedLevelOfDetail(csmFloat32 stepScale, csmFloat32 subRigRatio)
+{
+    _reducedStepScale = CubismMath::Max(stepScale, 1.0f);
+    _reducedSubRigRatio = CubismMath::RangeF(subRigRatio, 0.0f, 1.0f);
+}
+
+void CubismPhysics::SetParallelFor(ParallelForFunction parallelFor)
+{
+    _parallelFor = parallelFor;
+}
+
 }}}
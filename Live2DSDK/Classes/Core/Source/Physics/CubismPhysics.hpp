@@ -34,6 +34,38 @@ public:
         CubismVector2 Wind; ///< 風の方向
     };
 
+    /**
+     * @brief 詳細度
+     *
+     * 物理演算の詳細度。画面上で小さく表示されるモデルの演算を間引くために使用する。
+     */
+    enum LevelOfDetail
+    {
+        LevelOfDetail_Full,         ///< 全てのサブリグを設定されたFPSで演算する
+        LevelOfDetail_Reduced,      ///< 演算の間隔を広げ、重要度の高いサブリグだけを演算する。出力は前後の演算結果から補間する
+        LevelOfDetail_Frozen,       ///< 演算を行わず、最後の出力を適用し続ける
+    };
+
+    /**
+     * @brief 並列実行するタスクの関数
+     *
+     * @param[in]   context     ParallelForFunctionに渡されたコンテキスト
+     * @param[in]   index       タスクの番号
+     */
+    typedef void (*TaskFunction)(void* context, csmInt32 index);
+
+    /**
+     * @brief 並列実行関数
+     *
+     * taskをindexが0〜count-1のそれぞれについて1回ずつ呼び出し、全ての呼び出しが完了してから戻ること。
+     * 呼び出し順序やスレッドは問わない。
+     *
+     * @param[in]   count       タスクの数
+     * @param[in]   context     taskに渡すコンテキスト
+     * @param[in]   task        タスクの関数
+     */
+    typedef void (*ParallelForFunction)(csmInt32 count, void* context, TaskFunction task);
+
     /**
      * @brief 物理演算出力結果
      *
@@ -55,6 +87,18 @@ public:
      */
     static CubismPhysics* Create(const csmByte* buffer, csmSizeInt size);
 
+    /**
+     * @brief 設定を共有するインスタンスの作成
+     *
+     * sourceと物理演算の設定（CubismPhysicsRig）を共有するインスタンスを作成する。
+     * 新しく確保するのは物理点や出力の状態だけで、状態とオプションは初期値になる。
+     * 同じキャラクターを複数体表示する場合に使用する。
+     *
+     * @param[in]   source      設定の共有元のインスタンス
+     * @return  作成されたインスタンス
+     */
+    static CubismPhysics* CreateShared(const CubismPhysics* source);
+
     /**
      * @brief インスタンスの破棄
      *
@@ -105,7 +149,48 @@ public:
      */
     const Options& GetOptions() const;
 
+    /**
+     * @brief 詳細度の設定
+     *
+     * 詳細度を設定する。次回のEvaluateから反映される。
+     *
+     * @param[in]   level       詳細度
+     */
+    void SetLevelOfDetail(LevelOfDetail level);
+
+    /**
+     * @brief 詳細度の取得
+     *
+     * 詳細度を取得する。
+     *
+     * @return 詳細度
+     */
+    LevelOfDetail GetLevelOfDetail() const;
+
+    /**
+     * @brief LevelOfDetail_Reducedの設定
+     *
+     * 詳細度を下げた時の演算間隔とサブリグの数を設定する。
+     *
+     * @param[in]   stepScale       演算間隔の倍率。2.0の場合は設定されたFPSの半分で演算する（1.0以上）
+     * @param[in]   subRigRatio     演算するサブリグの割合（0〜1）。重要度の高いものから選ばれ、最低1つは演算する
+     */
+    void SetReducedLevelOfDetail(csmFloat32 stepScale, csmFloat32 subRigRatio);
+
+    /**
+     * @brief 並列実行関数の設定
+     *
+     * 設定した場合、Evaluateはパラメータを介して依存し合わないサブリグのグループを並列に演算する。
+     * グループ内のサブリグは元の順序で演算するため、結果は逐次実行と一致する。
+     * NULLを設定すると逐次実行に戻る。
+     *
+     * @param[in]   parallelFor     並列実行関数
+     */
+    void SetParallelFor(ParallelForFunction parallelFor);
+
 private:
+    struct SubRigUpdateContext;
+
     /**
      * @brief コンストラクタ
      *
@@ -134,13 +219,31 @@ private:
      */
     void Parse(const csmByte* physicsJson, csmSizeInt size);
 
+    /**
+     * @brief 状態の確保
+     *
+     * 共有している設定に合わせて、インスタンスごとの状態を確保して初期化する。
+     */
+    void CreateState();
+
     /**
      * @brief 初期化
      *
-     * 初期化する。
+     * 物理点の状態を初期位置に戻す。
      */
     void Initialize();
 
+    /**
+     * @brief 入力・出力のパラメータのインデックスの解決
+     *
+     * 全ての入力元・出力先のパラメータのインデックスを解決し、
+     * 演算中にキャッシュする必要のあるパラメータのインデックスのリストを作成する。
+     * 解決済みの場合は何もしない。
+     *
+     * @param[in]   model       物理演算の結果を適用するモデル
+     */
+    void ResolveParameterIndices(CubismModel* model);
+
     /**
      * @brief 物理演算結果の適用
      *
@@ -151,13 +254,51 @@ private:
      */
     void Interpolate(CubismModel* model, csmFloat32 weight);
 
-    CubismPhysicsRig* _physicsRig; ///< 物理演算のデータ
+    /**
+     * @brief サブリグの演算
+     *
+     * サブリグ1つ分の振り子を1ステップ進め、出力を_parameterCachesに書き込む。
+     *
+     * @param[in]   settingIndex            サブリグのインデックス
+     * @param[in]   physicsDeltaTime        1ステップの時間[秒]
+     * @param[in]   parameterMinimumValues  パラメータの最小値
+     * @param[in]   parameterMaximumValues  パラメータの最大値
+     * @param[in]   parameterDefaultValues  パラメータのデフォルト値
+     */
+    void UpdateSubRig(csmInt32 settingIndex, csmFloat32 physicsDeltaTime,
+        const csmFloat32* parameterMinimumValues, const csmFloat32* parameterMaximumValues, const csmFloat32* parameterDefaultValues);
+
+    /**
+     * @brief サブリグのグループの演算
+     *
+     * ParallelForFunctionから呼び出され、グループ内のサブリグを元の順序で演算する。
+     *
+     * @param[in]   context     SubRigUpdateContext
+     * @param[in]   groupIndex  グループのインデックス
+     */
+    static void UpdateSubRigGroup(void* context, csmInt32 groupIndex);
+
+    CubismPhysicsRig* _physicsRig; ///< 物理演算のデータ。他のインスタンスと共有するため読み取り専用
     Options _options; ///< オプション
 
-    csmVector<PhysicsOutput> _currentRigOutputs; ///< 最新の振り子計算の結果
-    csmVector<PhysicsOutput> _previousRigOutputs; ///< 一つ前の振り子計算の結果
+    csmVector<CubismPhysicsParticleState> _particleStates; ///< 物理点の状態。_physicsRig->Particlesと同じ並び
+    csmVector<CubismPhysicsOutputState> _outputStates; ///< 出力の状態。_physicsRig->Outputsと同じ並び
+    csmVector<csmInt32> _inputParameterIndices; ///< 入力元のパラメータのインデックス。_physicsRig->Inputsと同じ並び
+    csmVector<csmInt32> _outputParameterIndices; ///< 出力先のパラメータのインデックス。_physicsRig->Outputsと同じ並び
+    csmVector<csmInt32> _cachedParameterIndices; ///< 入力・出力で参照するパラメータのインデックスのリスト（重複なし、昇順）
+    csmBool _isParameterIndicesResolved; ///< 入力・出力のパラメータのインデックスを解決済みか
+
+    csmVector<csmFloat32> _currentRigOutputs; ///< 最新の振り子計算の結果。_physicsRig->Outputsと同じ並び
+    csmVector<csmFloat32> _previousRigOutputs; ///< 一つ前の振り子計算の結果。_physicsRig->Outputsと同じ並び
 
     csmFloat32 _currentRemainTime; ///< 物理演算が処理していない時間
+    csmFloat32 _lastInterpolationWeight; ///< 最後に出力を補間した重み。LevelOfDetail_Frozenでそのまま使う
+
+    LevelOfDetail _levelOfDetail; ///< 詳細度
+    csmFloat32 _reducedStepScale; ///< LevelOfDetail_Reducedでの演算間隔の倍率
+    csmFloat32 _reducedSubRigRatio; ///< LevelOfDetail_Reducedで演算するサブリグの割合
+
+    ParallelForFunction _parallelFor; ///< 並列実行関数。NULLの場合は逐次実行
 
     csmVector<csmFloat32> _parameterCaches;      ///< Evaluateで利用するパラメータのキャッシュ
     csmVector<csmFloat32> _parameterInputCaches; ///< UpdateParticlesが動くときの入力をキャッシュ
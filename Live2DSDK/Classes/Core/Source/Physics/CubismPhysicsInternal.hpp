@@ -11,6 +11,7 @@
 #include "CubismModel.hpp"
 #include "CubismVector2.hpp"
 #include "CubismId.hpp"
+#include <atomic>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -74,6 +75,7 @@ struct CubismPhysicsNormalization
  * @brief 物理演算の演算に使用する物理点の情報
  *
  * 物理演算の演算に使用する物理点の情報。
+ * 同じ物理演算の設定を持つインスタンス間で共有され、演算中に変更されない。
  */
 struct CubismPhysicsParticle
 {
@@ -82,10 +84,18 @@ struct CubismPhysicsParticle
     csmFloat32 Delay;                       ///< 遅れ
     csmFloat32 Acceleration;                ///< 加速度
     csmFloat32 Radius;                      ///< 距離
+};
+
+/**
+ * @brief 物理点の状態
+ *
+ * インスタンスごとに持つ物理点の演算状態。
+ * CubismPhysicsRig::Particlesと同じ並びで連続して確保される。
+ */
+struct CubismPhysicsParticleState
+{
     CubismVector2 Position;                 ///< 現在の位置
-    CubismVector2 LastPosition;             ///< 最後の位置
     CubismVector2 LastGravity;              ///< 最後の重力
-    CubismVector2 Force;                    ///< 現在かかっている力
     CubismVector2 Velocity;                 ///< 現在の速度
 };
 
@@ -104,6 +114,7 @@ struct CubismPhysicsSubRig
     csmInt32 BaseParticleIndex;                                 ///< 物理点の最初のインデックス
     CubismPhysicsNormalization NormalizationPosition;           ///< 正規化された位置
     CubismPhysicsNormalization NormalizationAngle;              ///< 正規化された角度
+    csmInt32 ImportanceRank;                                    ///< 詳細度を下げた時に演算する優先順位（0が最も重要）
 };
 
 /**
@@ -129,8 +140,8 @@ typedef void (*NormalizedPhysicsParameterValueGetter)(
     csmFloat32 parameterMinimumValue,
     csmFloat32 parameterMaximumValue,
     csmFloat32 parameterDefaultValue,
-    CubismPhysicsNormalization* normalizationPosition,
-    CubismPhysicsNormalization* normalizationAngle,
+    const CubismPhysicsNormalization* normalizationPosition,
+    const CubismPhysicsNormalization* normalizationAngle,
     csmInt32 isInverted,
     csmFloat32 weight
 );
@@ -141,14 +152,14 @@ typedef void (*NormalizedPhysicsParameterValueGetter)(
  * 物理演算の値の取得関数の宣言。
  *
  * @param[in]       translation     移動値
- * @param[in]       particles       物理点のリスト
+ * @param[in]       particles       物理点の状態のリスト
  * @param[in]       isInverted      値が反転されているか？
  * @param[in]       parentGravity   重力
  * @return  値
  */
 typedef csmFloat32 (*PhysicsValueGetter)(
     CubismVector2 translation,
-    CubismPhysicsParticle* particles,
+    CubismPhysicsParticleState* particles,
     csmInt32 particleIndex,
     csmInt32 isInverted,
     CubismVector2 parentGravity
@@ -173,7 +184,6 @@ typedef csmFloat32 (*PhysicsScaleGetter)(CubismVector2 translationScale, csmFloa
 struct CubismPhysicsInput
 {
     CubismPhysicsParameter Source;                  ///< 入力元のパラメータ
-    csmInt32 SourceParameterIndex;                  ///< 入力元のパラメータのインデックス
     csmFloat32 Weight;                              ///< 重み
     csmInt16 Type;                                  ///< 入力の種類
     csmInt16 Reflect;                               ///< 値が反転されているかどうか
@@ -188,23 +198,33 @@ struct CubismPhysicsInput
 struct CubismPhysicsOutput
 {
     CubismPhysicsParameter Destination;         ///< 出力先のパラメータ
-    csmInt32 DestinationParameterIndex;         ///< 出力先のパラメータのインデックス
     csmInt32 VertexIndex;                       ///< 振り子のインデックス
     CubismVector2 TranslationScale;             ///< 移動値のスケール
     csmFloat32 AngleScale;                      ///< 角度のスケール
     csmFloat32 Weight;                          /// 重み
     CubismPhysicsSource Type;                   ///< 出力の種類
     csmInt16 Reflect;                           ///< 値が反転されているかどうか
-    csmFloat32 ValueBelowMinimum;               ///< 最小値を下回った時の値
-    csmFloat32 ValueExceededMaximum;            ///< 最大値をこえた時の値
     PhysicsValueGetter GetValue;                ///< 物理演算の値の取得関数
     PhysicsScaleGetter GetScale;                ///< 物理演算のスケール値の取得関数
 };
 
+/**
+ * @brief 物理演算の出力の状態
+ *
+ * インスタンスごとに持つ出力の演算状態。
+ */
+struct CubismPhysicsOutputState
+{
+    csmFloat32 ValueBelowMinimum;               ///< 最小値を下回った時の値
+    csmFloat32 ValueExceededMaximum;            ///< 最大値をこえた時の値
+};
+
 /**
  * @brief 物理演算のデータ
  *
  * 物理演算のデータ。
+ * physics3.jsonから作成した読み取り専用の設定で、同じ設定を使うCubismPhysicsのインスタンス間で共有される。
+ * 演算中に変化する値はCubismPhysics側の状態に持つ。
  */
 struct CubismPhysicsRig
 {
@@ -216,6 +236,9 @@ struct CubismPhysicsRig
     CubismVector2 Gravity;                          ///< 重力
     CubismVector2 Wind;                             ///< 風
     csmFloat32 Fps;                                 ///< 物理演算動作FPS
+    csmVector<csmInt32> SubRigGroupOrder;           ///< パラメータを介して依存し合うサブリグをまとめたグループ順に並べたサブリグのインデックス。グループ内は元の順序
+    csmVector<csmInt32> SubRigGroupOffsets;         ///< SubRigGroupOrder上の各グループの開始位置。要素数はグループ数 + 1
+    std::atomic<csmInt32> ReferenceCount;           ///< このデータを参照しているCubismPhysicsの数。インスタンスは別々のスレッドで作成・破棄されることがある
 };
 
 }}}
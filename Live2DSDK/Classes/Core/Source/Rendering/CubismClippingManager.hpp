@@ -97,6 +97,22 @@ public:
      */
     void CalcClippedDrawTotalBounds(CubismModel& model, T_ClippingContext* clippingContext);
 
+    /**
+     * @brief   マスクのレイアウトと、マスク生成・描画用の行列を計算する<br>
+     *           グラフィックスAPIを呼び出さないため、描画スレッド以外からも呼び出せる。
+     *
+     * @param[in]   model   ->  モデルのインスタンス
+     * @return      使用中のクリッピングコンテキストの数
+     */
+    csmInt32 SetupClippingLayout(CubismModel& model);
+
+    /**
+     * @brief   マスク生成に使用するクリッピングコンテキストのリストを取得する
+     *
+     * @return  マスク生成に使用するクリッピングコンテキストのリスト
+     */
+    csmVector<T_ClippingContext*>* GetClippingContextListForMask();
+
     /**
      * @brief   画面描画に使用するクリッピングマスクのリストを取得する
      *
@@ -133,6 +149,15 @@ public:
      */
     void SetClippingMaskBufferSize(csmFloat32 width, csmFloat32 height);
 
+    /**
+     * @brief   画面外と判定された描画オブジェクトを設定する<br>
+     *           マスクされる描画オブジェクトが全て画面外のクリッピングマスクは生成しない。
+     *           マスクのセットアップの直前にレンダラが設定し、終わったらNULLに戻す。
+     *
+     * @param[in]   culledDrawableFlags ->  描画オブジェクトごとの判定結果。NULLの場合は全て画面内として扱う
+     */
+    void SetCulledDrawableFlags(const csmVector<csmBool>* culledDrawableFlags);
+
 protected:
     T_OffscreenSurface* _currentMaskBuffer; /// オフスクリーンサーフェイスのアドレス
     csmVector<csmBool> _clearedMaskBufferFlags; /// マスクのクリアフラグの配列
@@ -147,6 +172,8 @@ protected:
     CubismMatrix44 _tmpMatrixForMask;       ///< マスク計算用の行列
     CubismMatrix44 _tmpMatrixForDraw;       ///< マスク計算用の行列
     csmRectF _tmpBoundsOnModel;       ///< マスク配置計算用の矩形
+
+    const csmVector<csmBool>* _culledDrawableFlags;  ///< 画面外と判定された描画オブジェクト。NULLの場合は判定しない
 };
 
 #include "CubismClippingManager.tpp"
@@ -11,6 +11,7 @@
 template <class T_ClippingContext, class T_OffscreenSurface>
 CubismClippingManager<T_ClippingContext, T_OffscreenSurface>::CubismClippingManager() :
                                                                     _clippingMaskBufferSize(256, 256)
+                                                                    , _culledDrawableFlags(NULL)
 {
     CubismRenderer::CubismTextureColor* tmp = NULL;
     tmp = CSM_NEW CubismRenderer::CubismTextureColor();
@@ -435,6 +436,12 @@ void CubismClippingManager<T_ClippingContext, T_OffscreenSurface>::CalcClippedDr
         // マスクを使用する描画オブジェクトの描画される矩形を求める
         const csmInt32 drawableIndex = (*clippingContext->_clippedDrawableIndexList)[clippedDrawableIndex];
 
+        // 画面外の描画オブジェクトは描画しないため、マスクも必要ない
+        if (_culledDrawableFlags != NULL && (*_culledDrawableFlags)[drawableIndex])
+        {
+            continue;
+        }
+
         csmInt32 drawableVertexCount = model.GetDrawableVertexCount(drawableIndex);
         csmFloat32* drawableVertexes = const_cast<csmFloat32*>(model.GetDrawableVertices(drawableIndex));
 
@@ -481,6 +488,68 @@ void CubismClippingManager<T_ClippingContext, T_OffscreenSurface>::CalcClippedDr
     }
 }
 
+template <class T_ClippingContext, class T_OffscreenSurface>
+csmInt32 CubismClippingManager<T_ClippingContext, T_OffscreenSurface>::SetupClippingLayout(CubismModel& model)
+{
+    // 全てのクリッピングを用意する
+    // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
+    csmInt32 usingClipCount = 0;
+    for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
+    {
+        // １つのクリッピングマスクに関して
+        T_ClippingContext* cc = _clippingContextListForMask[clipIndex];
+
+        // このクリップを利用する描画オブジェクト群全体を囲む矩形を計算
+        CalcClippedDrawTotalBounds(model, cc);
+
+        if (cc->_isUsing)
+        {
+            usingClipCount++; //使用中としてカウント
+        }
+    }
+
+    if (usingClipCount <= 0)
+    {
+        return 0;
+    }
+
+    // 各マスクのレイアウトを決定していく
+    SetupLayoutBounds(usingClipCount);
+
+    for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
+    {
+        T_ClippingContext* clipContext = _clippingContextListForMask[clipIndex];
+        csmRectF* allClippedDrawRect = clipContext->_allClippedDrawRect; //このマスクを使う、全ての描画オブジェクトの論理座標上の囲み矩形
+        csmRectF* layoutBoundsOnTex01 = clipContext->_layoutBounds; //この中にマスクを収める
+        const csmFloat32 MARGIN = 0.05f;
+
+        if (!clipContext->_isUsing)
+        {
+            continue;
+        }
+
+        // モデル座標上の矩形を、適宜マージンを付けて使う
+        _tmpBoundsOnModel.SetRect(allClippedDrawRect);
+        _tmpBoundsOnModel.Expand(allClippedDrawRect->Width * MARGIN, allClippedDrawRect->Height * MARGIN);
+        csmFloat32 scaleX = layoutBoundsOnTex01->Width / _tmpBoundsOnModel.Width;
+        csmFloat32 scaleY = layoutBoundsOnTex01->Height / _tmpBoundsOnModel.Height;
+
+        // マスク生成時に使う行列を求める
+        createMatrixForMask(false, layoutBoundsOnTex01, scaleX, scaleY);
+
+        clipContext->_matrixForMask.SetMatrix(_tmpMatrixForMask.GetArray());
+        clipContext->_matrixForDraw.SetMatrix(_tmpMatrixForDraw.GetArray());
+    }
+
+    return usingClipCount;
+}
+
+template <class T_ClippingContext, class T_OffscreenSurface>
+csmVector<T_ClippingContext*>* CubismClippingManager<T_ClippingContext, T_OffscreenSurface>::GetClippingContextListForMask()
+{
+    return &_clippingContextListForMask;
+}
+
 template <class T_ClippingContext, class T_OffscreenSurface>
 csmVector<T_ClippingContext*>* CubismClippingManager<T_ClippingContext, T_OffscreenSurface>::GetClippingContextListForDraw()
 {
@@ -510,3 +579,9 @@ void CubismClippingManager<T_ClippingContext, T_OffscreenSurface>::SetClippingMa
 {
     _clippingMaskBufferSize = CubismVector2(width, height);
 }
+
+template <class T_ClippingContext, class T_OffscreenSurface>
+void CubismClippingManager<T_ClippingContext, T_OffscreenSurface>::SetCulledDrawableFlags(const csmVector<csmBool>* culledDrawableFlags)
+{
+    _culledDrawableFlags = culledDrawableFlags;
+}
@@ -0,0 +1,102 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismRenderCommandList.hpp"
+#include <string.h>
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+CubismRenderCommandList::CubismRenderCommandList()
+    : _reservedCommandCount(0)
+    , _reservedVertexCount(0)
+    , _isPremultipliedAlpha(false)
+{
+}
+
+CubismRenderCommandList::~CubismRenderCommandList()
+{
+}
+
+void CubismRenderCommandList::Clear()
+{
+    // サイズのみ0にしてキャパシティは残す
+    _commands.UpdateSize(0, CubismRenderCommand(), true);
+    _vertexPositions.UpdateSize(0, 0.0f, false);
+}
+
+void CubismRenderCommandList::Reserve(csmInt32 commandCount, csmInt32 vertexCount)
+{
+    // PrepareCapacityは今のキャパシティ以下であれば何もしない
+    _commands.PrepareCapacity(commandCount);
+    _vertexPositions.PrepareCapacity(vertexCount * 2);
+
+    _reservedCommandCount = commandCount;
+    _reservedVertexCount = vertexCount;
+}
+
+CubismRenderCommand& CubismRenderCommandList::AddCommand(CubismRenderCommand::CommandType type)
+{
+    CSM_ASSERT(_reservedCommandCount == 0 || static_cast<csmInt32>(_commands.GetSize()) < _reservedCommandCount);
+
+    CubismRenderCommand command;
+    command.Type = type;
+    _commands.PushBack(command);
+
+    return _commands[_commands.GetSize() - 1];
+}
+
+csmInt32 CubismRenderCommandList::AddVertexPositions(const csmFloat32* positions, csmInt32 vertexCount)
+{
+    const csmInt32 vertexOffset = static_cast<csmInt32>(_vertexPositions.GetSize()) / 2;
+
+    CSM_ASSERT(_reservedCommandCount == 0 || vertexOffset + vertexCount <= _reservedVertexCount);
+
+    _vertexPositions.UpdateSize((vertexOffset + vertexCount) * 2, 0.0f, false);
+    memcpy(_vertexPositions.GetPtr() + vertexOffset * 2, positions, sizeof(csmFloat32) * 2 * vertexCount);
+
+    return vertexOffset;
+}
+
+csmUint32 CubismRenderCommandList::GetCommandCount() const
+{
+    return _commands.GetSize();
+}
+
+const CubismRenderCommand& CubismRenderCommandList::GetCommand(csmUint32 index) const
+{
+    return _commands[index];
+}
+
+const csmFloat32* CubismRenderCommandList::GetVertexPositions(csmInt32 vertexOffset) const
+{
+    return &_vertexPositions[vertexOffset * 2];
+}
+
+void CubismRenderCommandList::SetMvpMatrix(const CubismMatrix44& matrix)
+{
+    _mvpMatrix = matrix;
+}
+
+const CubismMatrix44& CubismRenderCommandList::GetMvpMatrix() const
+{
+    return _mvpMatrix;
+}
+
+void CubismRenderCommandList::IsPremultipliedAlpha(csmBool enable)
+{
+    _isPremultipliedAlpha = enable;
+}
+
+csmBool CubismRenderCommandList::IsPremultipliedAlpha() const
+{
+    return _isPremultipliedAlpha;
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,180 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+#include "CubismRenderer.hpp"
+#include "CubismMatrix44.hpp"
+#include "csmVector.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief   描画コマンド1件分<br>
+ *           グラフィックスAPIに依存しない値のみを保持し、実行時にレンダラがAPIの命令に置き換える。
+ */
+struct CubismRenderCommand
+{
+    /**
+     * @brief   コマンドの種類
+     */
+    enum CommandType
+    {
+        CommandType_BeginMask = 0,  ///< マスクバッファへの描画を開始し、バッファをクリアする
+        CommandType_DrawMask,       ///< マスクバッファにメッシュを描画する
+        CommandType_EndMask,        ///< マスクバッファへの描画を終了する
+        CommandType_Draw,           ///< 描画先にメッシュを描画する
+    };
+
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismRenderCommand()
+        : Type(CommandType_Draw)
+        , DrawableIndex(-1)
+        , TextureIndex(-1)
+        , MaskBufferIndex(-1)
+        , BlendMode(CubismRenderer::CubismBlendMode_Normal)
+        , IsCulling(false)
+        , IsInvertedMask(false)
+        , VertexOffset(0)
+        , VertexCount(0)
+        , Uvs(NULL)
+        , Indices(NULL)
+        , IndexCount(0)
+    { }
+
+    CommandType Type;                                   ///< コマンドの種類
+    csmInt32 DrawableIndex;                             ///< 描画するDrawableのインデックス
+    csmInt32 TextureIndex;                              ///< モデルのテクスチャ番号
+    csmInt32 MaskBufferIndex;                           ///< マスクバッファの番号。BeginMask・DrawMaskは描画先、Drawは参照するバッファ。マスクを使わない場合は-1
+    CubismRenderer::CubismBlendMode BlendMode;          ///< カラーブレンディングのモード
+    csmBool IsCulling;                                  ///< カリングを行うか
+    csmBool IsInvertedMask;                             ///< マスクを反転して使用するか
+    csmInt32 VertexOffset;                              ///< コマンドリストが保持する頂点座標の先頭（頂点単位）
+    csmInt32 VertexCount;                               ///< 頂点の数
+    const csmFloat32* Uvs;                              ///< UV座標。モデルが保持する配列を指す
+    const csmUint16* Indices;                           ///< 頂点インデックス。モデルが保持する配列を指す
+    csmInt32 IndexCount;                                ///< 頂点インデックスの数
+    CubismRenderer::CubismTextureColor BaseColor;       ///< ベースカラー。DrawMaskではマスクを収める矩形（NDC）
+    CubismRenderer::CubismTextureColor MultiplyColor;   ///< 乗算色
+    CubismRenderer::CubismTextureColor ScreenColor;     ///< スクリーン色
+    CubismRenderer::CubismTextureColor ChannelFlag;     ///< マスクを書き込む・読み出すカラーチャンネル
+    CubismMatrix44 ClipMatrix;                          ///< DrawMaskではマスク生成用の行列、マスクを使うDrawではマスク参照用の行列
+};
+
+/**
+ * @brief   記録した描画コマンドのリスト<br>
+ *           レンダラはモデルの描画に必要なCPU側の処理（描画順のソート・マスクのレイアウト・色や行列の計算）を
+ *           任意のスレッドでこのリストに記録し、描画スレッドではリストを実行するだけで済ませる。<br>
+ *           頂点座標は記録時にコピーするため、記録後にモデルを更新しても実行結果は変わらない。
+ *           UVと頂点インデックスはモデルの配列を参照するため、モデルの破棄後は実行できない。
+ */
+class CubismRenderCommandList
+{
+public:
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismRenderCommandList();
+
+    /**
+     * @brief   デストラクタ
+     */
+    ~CubismRenderCommandList();
+
+    /**
+     * @brief   記録したコマンドと頂点を破棄する<br>
+     *           確保したメモリは次の記録で使い回す。
+     */
+    void Clear();
+
+    /**
+     * @brief   記録に必要なメモリを確保しておく<br>
+     *           CubismFrameworkのアロケータはスレッドセーフではないため、描画スレッド以外で記録する場合は事前に描画スレッドで呼び出す。
+     *           以降の記録で指定した数を超えて追加するとアサートする。
+     *
+     * @param[in]   commandCount    ->  記録するコマンドの最大数
+     * @param[in]   vertexCount     ->  記録する頂点の最大数
+     */
+    void Reserve(csmInt32 commandCount, csmInt32 vertexCount);
+
+    /**
+     * @brief   コマンドを追加する
+     *
+     * @param[in]   type    ->  コマンドの種類
+     *
+     * @return  追加したコマンド。次にコマンドを追加するまで有効
+     */
+    CubismRenderCommand& AddCommand(CubismRenderCommand::CommandType type);
+
+    /**
+     * @brief   頂点座標をコピーして追加する
+     *
+     * @param[in]   positions       ->  頂点座標（x, yの並び）
+     * @param[in]   vertexCount     ->  頂点の数
+     *
+     * @return  追加した頂点の先頭（頂点単位）。CubismRenderCommand::VertexOffsetに設定する
+     */
+    csmInt32 AddVertexPositions(const csmFloat32* positions, csmInt32 vertexCount);
+
+    /**
+     * @brief   コマンドの数を取得する
+     */
+    csmUint32 GetCommandCount() const;
+
+    /**
+     * @brief   コマンドを取得する
+     *
+     * @param[in]   index   ->  コマンドの番号
+     */
+    const CubismRenderCommand& GetCommand(csmUint32 index) const;
+
+    /**
+     * @brief   頂点座標を取得する
+     *
+     * @param[in]   vertexOffset    ->  CubismRenderCommand::VertexOffset
+     */
+    const csmFloat32* GetVertexPositions(csmInt32 vertexOffset) const;
+
+    /**
+     * @brief   Model-View-Projection 行列を設定する
+     */
+    void SetMvpMatrix(const CubismMatrix44& matrix);
+
+    /**
+     * @brief   Model-View-Projection 行列を取得する
+     */
+    const CubismMatrix44& GetMvpMatrix() const;
+
+    /**
+     * @brief   乗算済みアルファとして描画するかを設定する
+     */
+    void IsPremultipliedAlpha(csmBool enable);
+
+    /**
+     * @brief   乗算済みアルファとして描画するかを取得する
+     */
+    csmBool IsPremultipliedAlpha() const;
+
+private:
+    // Prevention of copy Constructor
+    CubismRenderCommandList(const CubismRenderCommandList&);
+    CubismRenderCommandList& operator=(const CubismRenderCommandList&);
+
+    csmVector<CubismRenderCommand> _commands;   ///< 記録したコマンド
+    csmVector<csmFloat32> _vertexPositions;     ///< 記録時にコピーした頂点座標
+    csmInt32 _reservedCommandCount;             ///< Reserveで確保したコマンドの数。0の場合は必要に応じて確保する
+    csmInt32 _reservedVertexCount;              ///< Reserveで確保した頂点の数
+    CubismMatrix44 _mvpMatrix;                  ///< Model-View-Projection 行列
+    csmBool _isPremultipliedAlpha;              ///< 乗算済みアルファとして描画するか
+};
+
+}}}}
+//------------ LIVE2D NAMESPACE ------------
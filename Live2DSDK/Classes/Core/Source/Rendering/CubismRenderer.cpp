@@ -8,6 +8,7 @@
 #include "CubismRenderer.hpp"
 #include "CubismFramework.hpp"
 #include "CubismModel.hpp"
+#include <float.h>
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
@@ -23,6 +24,9 @@ CubismRenderer::CubismRenderer()
     , _anisotropy(0.0f)
     , _model(NULL)
     , _useHighPrecisionMask(false)
+    , _isViewportCulling(true)
+    , _hasModelBounds(false)
+    , _isModelCulled(false)
 {
     //単位行列に初期化
     _mvpMatrix4x4.LoadIdentity();
@@ -39,6 +43,12 @@ void CubismRenderer::Initialize(Framework::CubismModel* model)
 void CubismRenderer::Initialize(Framework::CubismModel* model, csmInt32 maskBufferCount)
 {
     _model = model;
+
+    // 描画スレッド以外で記録する場合にメモリを確保しないよう、画面外カリングの配列は初期化時に確保する
+    const csmInt32 drawableCount = model->GetDrawableCount();
+    _drawableBounds.UpdateSize(drawableCount, csmRectF(), true);
+    _hasDrawableBounds.UpdateSize(drawableCount, false, true);
+    _culledDrawableFlags.UpdateSize(drawableCount, false, true);
 }
 
 void CubismRenderer::DrawModel()
@@ -153,6 +163,236 @@ csmBool CubismRenderer::IsUsingHighPrecisionMask()
     return _useHighPrecisionMask;
 }
 
+void CubismRenderer::IsViewportCulling(csmBool enable)
+{
+    _isViewportCulling = enable;
+}
+
+csmBool CubismRenderer::IsViewportCulling() const
+{
+    return _isViewportCulling;
+}
+
+csmBool CubismRenderer::IsInViewport(CubismMatrix44& mvp, csmFloat32 margin) const
+{
+    if (!_isViewportCulling || !_hasModelBounds)
+    {
+        return true;
+    }
+
+    csmRectF bounds(_modelBounds);
+    bounds.Expand(bounds.Width * margin, bounds.Height * margin);
+
+    return !IsOutsideViewport(mvp.GetArray(), bounds);
+}
+
+csmBool CubismRenderer::UpdateViewportCulling()
+{
+    CubismModel* model = GetModel();
+    const csmInt32 drawableCount = model->GetDrawableCount();
+    csmBool isChanged = false;
+
+    if (static_cast<csmInt32>(_culledDrawableFlags.GetSize()) != drawableCount)
+    {
+        _drawableBounds.UpdateSize(drawableCount, csmRectF(), true);
+        _hasDrawableBounds.UpdateSize(drawableCount, false, true);
+        _culledDrawableFlags.UpdateSize(drawableCount, false, true);
+        isChanged = true;
+    }
+
+    if (!_isViewportCulling)
+    {
+        // 無効にした時点で画面外の判定を全て解除する
+        for (csmInt32 i = 0; i < drawableCount; ++i)
+        {
+            if (_culledDrawableFlags[i])
+            {
+                _culledDrawableFlags[i] = false;
+                isChanged = true;
+            }
+        }
+        _isModelCulled = false;
+        return isChanged;
+    }
+
+    const csmFloat32* mvp = _mvpMatrix4x4.GetArray();
+    csmFloat32 modelMinX = FLT_MAX, modelMinY = FLT_MAX;
+    csmFloat32 modelMaxX = -FLT_MAX, modelMaxY = -FLT_MAX;
+    csmBool isModelCulled = true;
+
+    for (csmInt32 drawableIndex = 0; drawableIndex < drawableCount; ++drawableIndex)
+    {
+        if (!model->GetDrawableDynamicFlagIsVisible(drawableIndex))
+        {
+            continue;
+        }
+
+        if (!UpdateDrawableBounds(drawableIndex))
+        {
+            // 頂点が無い場合は判定できないため、画面内として扱う
+            if (_culledDrawableFlags[drawableIndex])
+            {
+                _culledDrawableFlags[drawableIndex] = false;
+                isChanged = true;
+            }
+            isModelCulled = false;
+            continue;
+        }
+
+        const csmRectF& bounds = _drawableBounds[drawableIndex];
+        if (bounds.X < modelMinX) modelMinX = bounds.X;
+        if (bounds.Y < modelMinY) modelMinY = bounds.Y;
+        if (bounds.GetRight() > modelMaxX) modelMaxX = bounds.GetRight();
+        if (bounds.GetBottom() > modelMaxY) modelMaxY = bounds.GetBottom();
+
+        const csmBool isCulled = IsOutsideViewport(mvp, bounds);
+        if (isCulled != _culledDrawableFlags[drawableIndex])
+        {
+            _culledDrawableFlags[drawableIndex] = isCulled;
+            isChanged = true;
+        }
+
+        if (!isCulled)
+        {
+            isModelCulled = false;
+        }
+    }
+
+    _hasModelBounds = (modelMinX != FLT_MAX);
+    if (_hasModelBounds)
+    {
+        _modelBounds = csmRectF(modelMinX, modelMinY, modelMaxX - modelMinX, modelMaxY - modelMinY);
+    }
+    _isModelCulled = isModelCulled && _hasModelBounds;
+
+    return isChanged;
+}
+
+void CubismRenderer::UpdateModelBounds()
+{
+    CubismModel* model = GetModel();
+    if (model == NULL)
+    {
+        return;
+    }
+
+    const csmInt32 drawableCount = model->GetDrawableCount();
+    if (static_cast<csmInt32>(_hasDrawableBounds.GetSize()) != drawableCount)
+    {
+        _drawableBounds.UpdateSize(drawableCount, csmRectF(), true);
+        _hasDrawableBounds.UpdateSize(drawableCount, false, true);
+    }
+
+    csmFloat32 modelMinX = FLT_MAX, modelMinY = FLT_MAX;
+    csmFloat32 modelMaxX = -FLT_MAX, modelMaxY = -FLT_MAX;
+
+    for (csmInt32 drawableIndex = 0; drawableIndex < drawableCount; ++drawableIndex)
+    {
+        if (!model->GetDrawableDynamicFlagIsVisible(drawableIndex) || !UpdateDrawableBounds(drawableIndex))
+        {
+            continue;
+        }
+
+        const csmRectF& bounds = _drawableBounds[drawableIndex];
+        if (bounds.X < modelMinX) modelMinX = bounds.X;
+        if (bounds.Y < modelMinY) modelMinY = bounds.Y;
+        if (bounds.GetRight() > modelMaxX) modelMaxX = bounds.GetRight();
+        if (bounds.GetBottom() > modelMaxY) modelMaxY = bounds.GetBottom();
+    }
+
+    _hasModelBounds = (modelMinX != FLT_MAX);
+    if (_hasModelBounds)
+    {
+        _modelBounds = csmRectF(modelMinX, modelMinY, modelMaxX - modelMinX, modelMaxY - modelMinY);
+    }
+}
+
+csmBool CubismRenderer::UpdateDrawableBounds(csmInt32 drawableIndex)
+{
+    CubismModel* model = GetModel();
+
+    // 頂点が更新された場合のみ矩形を計算し直す
+    if (_hasDrawableBounds[drawableIndex] && !model->GetDrawableDynamicFlagVertexPositionsDidChange(drawableIndex))
+    {
+        return true;
+    }
+
+    const csmInt32 vertexCount = model->GetDrawableVertexCount(drawableIndex);
+    const csmFloat32* vertices = model->GetDrawableVertices(drawableIndex);
+
+    csmFloat32 minX = FLT_MAX, minY = FLT_MAX;
+    csmFloat32 maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (csmInt32 i = 0; i < vertexCount; ++i)
+    {
+        const csmFloat32 x = vertices[i * 2];
+        const csmFloat32 y = vertices[i * 2 + 1];
+        if (x < minX) minX = x;
+        if (x > maxX) maxX = x;
+        if (y < minY) minY = y;
+        if (y > maxY) maxY = y;
+    }
+
+    if (minX == FLT_MAX)
+    {
+        _hasDrawableBounds[drawableIndex] = false;
+        return false;
+    }
+
+    _drawableBounds[drawableIndex] = csmRectF(minX, minY, maxX - minX, maxY - minY);
+    _hasDrawableBounds[drawableIndex] = true;
+    return true;
+}
+
+csmBool CubismRenderer::IsDrawableCulled(csmInt32 drawableIndex) const
+{
+    if (!_isViewportCulling || drawableIndex >= static_cast<csmInt32>(_culledDrawableFlags.GetSize()))
+    {
+        return false;
+    }
+
+    return _culledDrawableFlags[drawableIndex];
+}
+
+csmBool CubismRenderer::IsModelCulled() const
+{
+    return _isModelCulled;
+}
+
+const csmVector<csmBool>* CubismRenderer::GetCulledDrawableFlags() const
+{
+    // UpdateViewportCullingを呼んでいないレンダラでは判定結果が無い
+    if (!_isViewportCulling || _culledDrawableFlags.GetSize() == 0)
+    {
+        return NULL;
+    }
+
+    return &_culledDrawableFlags;
+}
+
+csmBool CubismRenderer::IsOutsideViewport(const csmFloat32* mvp, const csmRectF& bounds)
+{
+    const csmFloat32 xs[2] = { bounds.X, bounds.GetRight() };
+    const csmFloat32 ys[2] = { bounds.Y, bounds.GetBottom() };
+
+    // 4隅を変換し、全てがクリップ空間のいずれか1つの面の外側にあれば画面外
+    csmInt32 outsideLeft = 0, outsideRight = 0, outsideBottom = 0, outsideTop = 0;
+    for (csmInt32 i = 0; i < 4; ++i)
+    {
+        const csmFloat32 x = xs[i & 1];
+        const csmFloat32 y = ys[i >> 1];
+        const csmFloat32 clipX = mvp[0] * x + mvp[4] * y + mvp[12];
+        const csmFloat32 clipY = mvp[1] * x + mvp[5] * y + mvp[13];
+        const csmFloat32 clipW = mvp[3] * x + mvp[7] * y + mvp[15];
+
+        if (clipX < -clipW) ++outsideLeft;
+        if (clipX > clipW) ++outsideRight;
+        if (clipY < -clipW) ++outsideBottom;
+        if (clipY > clipW) ++outsideTop;
+    }
+
+    return outsideLeft == 4 || outsideRight == 4 || outsideBottom == 4 || outsideTop == 4;
+}
+
 /*********************************************************************************************************************
 *                                      CubismClippingContext
 ********************************************************************************************************************/
@@ -224,6 +224,40 @@ public:
      */
     csmBool IsUsingHighPrecisionMask();
 
+    /**
+     * @brief  画面外カリングの有効・無効をセットする。<br>
+     *          有効な場合、MVP行列で変換した矩形がビューポートの外にある描画オブジェクトは描画せず、マスクも生成しない。
+     *          全ての描画オブジェクトが画面外にある場合はモデルの描画自体を省略する。
+     */
+    void IsViewportCulling(csmBool enable);
+
+    /**
+     * @brief  画面外カリングの有効・無効を取得する。
+     *
+     * @retval  true    ->  画面外カリング有効
+     * @retval  false   ->  画面外カリング無効
+     */
+    csmBool IsViewportCulling() const;
+
+    /**
+     * @brief   前回の描画で計算したモデルの矩形がビューポートに入るかを判定する<br>
+     *           モデルの更新前に、画面外のモデルの更新を省略するかを決めるために使用する。
+     *           画面外カリングが無効な場合や、まだ描画していない場合は常にtrueを返す。
+     *
+     * @param[in]   mvp     ->  判定に使用するModel-View-Projection行列
+     * @param[in]   margin  ->  矩形を上下左右に広げる割合。更新による移動を見込む
+     *
+     * @return  ビューポートに入る場合はtrue
+     */
+    csmBool IsInViewport(CubismMatrix44& mvp, csmFloat32 margin) const;
+
+    /**
+     * @brief   描画せずにモデルの矩形を現在の頂点から計算し直す<br>
+     *           画面外のため描画を省略しているモデルを更新した後に呼び出し、IsInViewportの判定を追従させる。
+     *           描画オブジェクトごとの画面外の判定は変更しない。
+     */
+    void UpdateModelBounds();
+
 protected:
     /**
      * @brief   コンストラクタ
@@ -252,7 +286,53 @@ protected:
      */
     virtual void RestoreProfile() = 0;
 
+    /**
+     * @brief   描画オブジェクトの矩形を更新し、現在のMVP行列で画面外にあるかを判定する<br>
+     *           矩形は頂点が更新された描画オブジェクトのみ計算し直す。DoDrawModelの先頭で呼び出す。
+     *
+     * @return  前回から画面外と判定された描画オブジェクトが変わった場合はtrue
+     */
+    csmBool UpdateViewportCulling();
+
+    /**
+     * @brief   描画オブジェクトが画面外と判定されたかを取得する
+     *
+     * @param[in]   drawableIndex   ->  描画オブジェクトのインデックス
+     */
+    csmBool IsDrawableCulled(csmInt32 drawableIndex) const;
+
+    /**
+     * @brief   表示状態の描画オブジェクトが全て画面外と判定されたかを取得する
+     */
+    csmBool IsModelCulled() const;
+
+    /**
+     * @brief   描画オブジェクトごとの画面外の判定結果を取得する
+     *
+     * @return  判定結果の配列。画面外カリングが無効な場合はNULL
+     */
+    const csmVector<csmBool>* GetCulledDrawableFlags() const;
+
 private:
+    /**
+     * @brief   モデル座標の矩形をMVP行列で変換し、ビューポートの外にあるかを判定する
+     *
+     * @param[in]   mvp     ->  Model-View-Projection 行列の配列
+     * @param[in]   bounds  ->  モデル座標の矩形
+     *
+     * @return  ビューポートの外にある場合はtrue
+     */
+    static csmBool IsOutsideViewport(const csmFloat32* mvp, const csmRectF& bounds);
+
+    /**
+     * @brief   描画オブジェクトの矩形を、頂点が更新されている場合のみ計算し直す
+     *
+     * @param[in]   drawableIndex   ->  描画オブジェクトのインデックス
+     *
+     * @return  矩形が有効な場合はtrue。頂点が無い場合はfalse
+     */
+    csmBool UpdateDrawableBounds(csmInt32 drawableIndex);
+
     // コピーコンストラクタを隠す
     CubismRenderer(const CubismRenderer&);
     CubismRenderer& operator=(const CubismRenderer&);
@@ -265,6 +345,14 @@ private:
     CubismModel*        _model;                 ///< レンダリング対象のモデル
 
     csmBool             _useHighPrecisionMask;  ///< falseの場合、マスクを纏めて描画する trueの場合、マスクはパーツ描画ごとに書き直す
+
+    csmBool             _isViewportCulling;     ///< 画面外カリングが有効ならtrue
+    csmVector<csmRectF> _drawableBounds;        ///< 描画オブジェクトごとのモデル座標の矩形。頂点が更新された時のみ計算し直す
+    csmVector<csmBool>  _hasDrawableBounds;     ///< _drawableBoundsが計算済みならtrue
+    csmVector<csmBool>  _culledDrawableFlags;   ///< 描画オブジェクトが画面外ならtrue
+    csmRectF            _modelBounds;           ///< 表示状態の描画オブジェクト全体を囲むモデル座標の矩形
+    csmBool             _hasModelBounds;        ///< _modelBoundsが計算済みならtrue
+    csmBool             _isModelCulled;         ///< 表示状態の描画オブジェクトが全て画面外ならtrue
 };
 
 
@@ -6,7 +6,9 @@
  */
 
 #include "CubismOffscreenSurface_OpenGLES2.hpp"
+#ifdef CSM_TARGET_IPHONE_ES2
 #import <OpenGLES/ES2/gl.h>
+#endif
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
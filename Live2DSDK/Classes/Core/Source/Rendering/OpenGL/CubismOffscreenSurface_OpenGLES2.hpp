@@ -12,7 +12,9 @@
 #include "csmRectF.hpp"
 #include "csmMap.hpp"
 #include <float.h>
+#ifdef CSM_TARGET_IPHONE_ES2
 #import <OpenGLES/gltypes.h>
+#endif
 
 #ifdef CSM_TARGET_ANDROID_ES2
 #include <jni.h>
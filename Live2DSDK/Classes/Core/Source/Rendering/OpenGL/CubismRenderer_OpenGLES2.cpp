@@ -9,9 +9,12 @@
 #include "CubismMatrix44.hpp"
 #include "csmVector.hpp"
 #include "CubismModel.hpp"
+#include "CubismProfiler.hpp"
 #include <float.h>
+#ifdef CSM_TARGET_IPHONE_ES2
 #import <OpenGLES/ES2/gl.h>
 #import <OpenGLES/ES2/glext.h>
+#endif
 
 #ifdef CSM_TARGET_WIN_GL
 #include <Windows.h>
@@ -31,6 +34,8 @@ namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering
 ********************************************************************************************************************/
 void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, CubismRenderer_OpenGLES2* renderer, GLint lastFBO, GLint lastViewport[4])
 {
+    CSM_PROFILE_ZONE("SetupClippingContext");
+
     // 全てのクリッピングを用意する
     // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
     csmInt32 usingClipCount = 0;
@@ -126,6 +131,8 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
         clipContext->_matrixForMask.SetMatrix(_tmpMatrixForMask.GetArray());
         clipContext->_matrixForDraw.SetMatrix(_tmpMatrixForDraw.GetArray());
 
+        CSM_PROFILE_COUNTER_ADD(Counter_MaskRedraws, 1);
+
         // 実際の描画を行う
         const csmInt32 clipDrawCount = clipContext->_clippingIdCount;
         for (csmInt32 i = 0; i < clipDrawCount; i++)
@@ -434,6 +441,9 @@ void CubismRenderer::StaticRelease()
 CubismRenderer_OpenGLES2::CubismRenderer_OpenGLES2() : _clippingManager(NULL)
                                                      , _clippingContextBufferForMask(NULL)
                                                      , _clippingContextBufferForDraw(NULL)
+                                                     , _clippingMaskSource(NULL)
+                                                     , _clippingMaskShareCount(0)
+                                                     , _isClippingMaskReusable(false)
 {
     // テクスチャ対応マップの容量を確保しておく.
     _textures.PrepareCapacity(32, true);
@@ -441,6 +451,20 @@ CubismRenderer_OpenGLES2::CubismRenderer_OpenGLES2() : _clippingManager(NULL)
 
 CubismRenderer_OpenGLES2::~CubismRenderer_OpenGLES2()
 {
+    ReleaseClippingMask();
+}
+
+void CubismRenderer_OpenGLES2::ReleaseClippingMask()
+{
+    // 共有しているマスクは共有元が破棄する
+    if (_clippingMaskSource != NULL)
+    {
+        --_clippingMaskSource->_clippingMaskShareCount;
+        _clippingManager = NULL;
+        _clippingMaskSource = NULL;
+        return;
+    }
+
     CSM_DELETE_SELF(CubismClippingManager_OpenGLES2, _clippingManager);
 
     for (csmInt32 i = 0; i < _offscreenSurfaces.GetSize(); ++i)
@@ -534,6 +558,21 @@ void CubismRenderer_OpenGLES2::PreDraw()
 
 void CubismRenderer_OpenGLES2::DoDrawModel()
 {
+    CSM_PROFILE_ZONE("DoDrawModel");
+
+    // 画面外と判定された描画オブジェクトが変わった場合は、生成するマスクも変わるので作り直す
+    if (UpdateViewportCulling())
+    {
+        _isClippingMaskReusable = false;
+    }
+
+    // 全ての描画オブジェクトが画面外の場合はマスクの生成も含めて省略する
+    if (IsModelCulled())
+    {
+        CSM_PROFILE_COUNTER_ADD(Counter_CulledModels, 1);
+        return;
+    }
+
     //------------ クリッピングマスク・バッファ前処理方式の場合 ------------
     if (_clippingManager != NULL)
     {
@@ -542,22 +581,33 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
         // サイズが違う場合はここで作成しなおし
         for (csmInt32 i = 0; i < _clippingManager->GetRenderTextureCount(); ++i)
         {
-            if (_offscreenSurfaces[i].GetBufferWidth() != static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().X) ||
-                _offscreenSurfaces[i].GetBufferHeight() != static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().Y))
+            CubismOffscreenSurface_OpenGLES2* maskBuffer = GetMaskBuffer(i);
+            if (maskBuffer->GetBufferWidth() != static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().X) ||
+                maskBuffer->GetBufferHeight() != static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().Y))
             {
-                _offscreenSurfaces[i].CreateOffscreenSurface(
+                maskBuffer->CreateOffscreenSurface(
                     static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().X), static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().Y));
+                _isClippingMaskReusable = false;
             }
         }
 
+        // 画面外の描画オブジェクトだけが使うマスクは生成しない
+        _clippingManager->SetCulledDrawableFlags(GetCulledDrawableFlags());
+
         if (IsUsingHighPrecisionMask())
         {
            _clippingManager->SetupMatrixForHighPrecision(*GetModel(), false);
+           _isClippingMaskReusable = false;
         }
-        else
+        else if (!_isClippingMaskReusable || !GetModel()->IsUpdateSkipped())
         {
            _clippingManager->SetupClippingContext(*GetModel(), this, _rendererProfile._lastFBO, _rendererProfile._lastViewport);
+
+           // 他のレンダラと共有していないマスクは、モデルの更新が省略されている間はそのまま使い続ける
+           _isClippingMaskReusable = (_clippingMaskSource == NULL && _clippingMaskShareCount == 0);
         }
+
+        _clippingManager->SetCulledDrawableFlags(NULL);
     }
 
     // 上記クリッピング処理内でも一度PreDrawを呼ぶので注意!!
@@ -584,6 +634,13 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
             continue;
         }
 
+        // 画面外のDrawableは描画しない
+        if (IsDrawableCulled(drawableIndex))
+        {
+            CSM_PROFILE_COUNTER_ADD(Counter_CulledDrawables, 1);
+            continue;
+        }
+
         // クリッピングマスク
         CubismClippingContext_OpenGLES2* clipContext = (_clippingManager != NULL)
             ? (*_clippingManager->GetClippingContextListForDraw())[drawableIndex]
@@ -606,6 +663,8 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
                 // 1が無効（描かれない）領域、0が有効（描かれる）領域。（シェーダで Cd*Csで0に近い値をかけてマスクを作る。1をかけると何も起こらない）
                 glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
                 glClear(GL_COLOR_BUFFER_BIT);
+
+                CSM_PROFILE_COUNTER_ADD(Counter_MaskRedraws, 1);
             }
 
             {
@@ -688,6 +747,9 @@ void CubismRenderer_OpenGLES2::DrawMeshOpenGL(const CubismModel& model, const cs
         csmInt32 indexCount = model.GetDrawableVertexIndexCount(index);
         csmUint16* indexArray = const_cast<csmUint16*>(model.GetDrawableVertexIndices(index));
         glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, indexArray);
+
+        CSM_PROFILE_COUNTER_ADD(Counter_DrawCalls, 1);
+        CSM_PROFILE_COUNTER_ADD(Counter_UploadedVertices, model.GetDrawableVertexCount(index));
     }
 
     // 後処理
@@ -696,6 +758,331 @@ void CubismRenderer_OpenGLES2::DrawMeshOpenGL(const CubismModel& model, const cs
     SetClippingContextBufferForMask(NULL);
 }
 
+void CubismRenderer_OpenGLES2::PrepareRecordDrawModel(CubismRenderCommandList& commandList)
+{
+    if (GetModel() == NULL)
+    {
+        return;
+    }
+
+    const CubismModel& model = *GetModel();
+    const csmInt32 drawableCount = model.GetDrawableCount();
+
+    // 全ての描画オブジェクトを描画する場合
+    csmInt32 commandCount = drawableCount;
+    csmInt32 vertexCount = 0;
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        vertexCount += model.GetDrawableVertexCount(i);
+    }
+
+    // 全てのマスクを生成する場合
+    if (_clippingManager != NULL)
+    {
+        commandCount += _clippingManager->GetRenderTextureCount() * 2;
+
+        const csmVector<CubismClippingContext_OpenGLES2*>* contextList = _clippingManager->GetClippingContextListForMask();
+        for (csmUint32 clipIndex = 0; clipIndex < contextList->GetSize(); ++clipIndex)
+        {
+            const CubismClippingContext_OpenGLES2* clipContext = (*contextList)[clipIndex];
+            commandCount += clipContext->_clippingIdCount;
+            for (csmInt32 i = 0; i < clipContext->_clippingIdCount; ++i)
+            {
+                vertexCount += model.GetDrawableVertexCount(clipContext->_clippingIdList[i]);
+            }
+        }
+    }
+
+    commandList.Reserve(commandCount, vertexCount);
+}
+
+csmBool CubismRenderer_OpenGLES2::RecordDrawModel(CubismRenderCommandList& commandList)
+{
+    CSM_PROFILE_ZONE("RecordDrawModel");
+
+    commandList.Clear();
+
+    if (GetModel() == NULL)
+    {
+        return false;
+    }
+
+    if (IsUsingHighPrecisionMask())
+    {
+        CubismLogWarning("A model using the high precision mask cannot be recorded. Use DrawModel instead.");
+        return false;
+    }
+
+    commandList.SetMvpMatrix(GetMvpMatrix());
+    commandList.IsPremultipliedAlpha(IsPremultipliedAlpha());
+
+    // 画面外と判定された描画オブジェクトが変わった場合は、生成するマスクも変わるので作り直す
+    if (UpdateViewportCulling())
+    {
+        _isClippingMaskReusable = false;
+    }
+
+    // 全ての描画オブジェクトが画面外の場合は何も記録しない
+    if (IsModelCulled())
+    {
+        CSM_PROFILE_COUNTER_ADD(Counter_CulledModels, 1);
+        return true;
+    }
+
+    //------------ クリッピングマスク・バッファ前処理方式の場合 ------------
+    if (_clippingManager != NULL)
+    {
+        // サイズが違う場合は実行時に作成しなおすので、マスクも描き直す
+        for (csmInt32 i = 0; i < _clippingManager->GetRenderTextureCount(); ++i)
+        {
+            CubismOffscreenSurface_OpenGLES2* maskBuffer = GetMaskBuffer(i);
+            if (maskBuffer->GetBufferWidth() != static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().X) ||
+                maskBuffer->GetBufferHeight() != static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().Y))
+            {
+                _isClippingMaskReusable = false;
+            }
+        }
+
+        if (!_isClippingMaskReusable || !GetModel()->IsUpdateSkipped())
+        {
+            RecordClippingMask(commandList);
+
+            // 他のレンダラと共有していないマスクは、モデルの更新が省略されている間はそのまま使い続ける
+            _isClippingMaskReusable = (_clippingMaskSource == NULL && _clippingMaskShareCount == 0);
+        }
+    }
+
+    const csmInt32 drawableCount = GetModel()->GetDrawableCount();
+    const csmInt32* renderOrder = GetModel()->GetDrawableRenderOrders();
+
+    // インデックスを描画順でソート
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        const csmInt32 order = renderOrder[i];
+        _sortedDrawableIndexList[order] = i;
+    }
+
+    // 描画
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        const csmInt32 drawableIndex = _sortedDrawableIndexList[i];
+
+        // Drawableが表示状態でなければ処理をパスする
+        if (!GetModel()->GetDrawableDynamicFlagIsVisible(drawableIndex))
+        {
+            continue;
+        }
+
+        // 画面外のDrawableは描画しない
+        if (IsDrawableCulled(drawableIndex))
+        {
+            CSM_PROFILE_COUNTER_ADD(Counter_CulledDrawables, 1);
+            continue;
+        }
+
+        // クリッピングマスク
+        CubismClippingContext_OpenGLES2* clipContext = (_clippingManager != NULL)
+            ? (*_clippingManager->GetClippingContextListForDraw())[drawableIndex]
+            : NULL;
+
+        AddDrawableCommand(commandList, CubismRenderCommand::CommandType_Draw, drawableIndex, clipContext);
+    }
+
+    return true;
+}
+
+void CubismRenderer_OpenGLES2::ExecuteCommandList(const CubismRenderCommandList& commandList)
+{
+    CSM_PROFILE_ZONE("ExecuteCommandList");
+
+    SaveProfile();
+
+    // サイズが違う場合はここで作成しなおし
+    if (_clippingManager != NULL)
+    {
+        for (csmInt32 i = 0; i < _clippingManager->GetRenderTextureCount(); ++i)
+        {
+            CubismOffscreenSurface_OpenGLES2* maskBuffer = GetMaskBuffer(i);
+            if (maskBuffer->GetBufferWidth() != static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().X) ||
+                maskBuffer->GetBufferHeight() != static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().Y))
+            {
+                maskBuffer->CreateOffscreenSurface(
+                    static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().X), static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().Y));
+            }
+        }
+    }
+
+    PreDraw();
+
+    for (csmUint32 i = 0; i < commandList.GetCommandCount(); ++i)
+    {
+        const CubismRenderCommand& command = commandList.GetCommand(i);
+
+        switch (command.Type)
+        {
+        case CubismRenderCommand::CommandType_BeginMask:
+            // 生成したOffscreenSurfaceと同じサイズでビューポートを設定
+            glViewport(0, 0, _clippingManager->GetClippingMaskBufferSize().X, _clippingManager->GetClippingMaskBufferSize().Y);
+
+            // ---------- マスク描画処理 ----------
+            // マスク用RenderTextureをactiveにセット
+            GetMaskBuffer(command.MaskBufferIndex)->BeginDraw(_rendererProfile._lastFBO);
+
+            // マスクをクリアする
+            // 1が無効（描かれない）領域、0が有効（描かれる）領域。（シェーダで Cd*Csで0に近い値をかけてマスクを作る。1をかけると何も起こらない）
+            glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            break;
+
+        case CubismRenderCommand::CommandType_EndMask:
+            // --- 後処理 ---
+            GetMaskBuffer(command.MaskBufferIndex)->EndDraw();
+            glViewport(_rendererProfile._lastViewport[0], _rendererProfile._lastViewport[1], _rendererProfile._lastViewport[2], _rendererProfile._lastViewport[3]);
+
+            PreDraw(); // バッファをクリアする
+            break;
+
+        case CubismRenderCommand::CommandType_DrawMask:
+        case CubismRenderCommand::CommandType_Draw:
+        default:
+            DrawCommandOpenGL(commandList, command);
+            break;
+        }
+    }
+
+    PostDraw();
+
+    RestoreProfile();
+}
+
+void CubismRenderer_OpenGLES2::RecordClippingMask(CubismRenderCommandList& commandList)
+{
+    // 画面外の描画オブジェクトだけが使うマスクは生成しない
+    _clippingManager->SetCulledDrawableFlags(GetCulledDrawableFlags());
+    const csmInt32 usingClipCount = _clippingManager->SetupClippingLayout(*GetModel());
+    _clippingManager->SetCulledDrawableFlags(NULL);
+    if (usingClipCount <= 0)
+    {
+        return;
+    }
+
+    csmVector<CubismClippingContext_OpenGLES2*>* contextList = _clippingManager->GetClippingContextListForMask();
+
+    for (csmInt32 bufferIndex = 0; bufferIndex < _clippingManager->GetRenderTextureCount(); ++bufferIndex)
+    {
+        CubismRenderCommand& beginCommand = commandList.AddCommand(CubismRenderCommand::CommandType_BeginMask);
+        beginCommand.MaskBufferIndex = bufferIndex;
+
+        // 実際に１つのマスクを生成する
+        for (csmUint32 clipIndex = 0; clipIndex < contextList->GetSize(); ++clipIndex)
+        {
+            CubismClippingContext_OpenGLES2* clipContext = (*contextList)[clipIndex];
+            if (!clipContext->_isUsing || clipContext->_bufferIndex != bufferIndex)
+            {
+                continue;
+            }
+
+            const csmInt32 clipDrawCount = clipContext->_clippingIdCount;
+            for (csmInt32 i = 0; i < clipDrawCount; ++i)
+            {
+                const csmInt32 clipDrawIndex = clipContext->_clippingIdList[i];
+
+                // 頂点情報が更新されておらず、信頼性がない場合は描画をパスする
+                if (!GetModel()->GetDrawableDynamicFlagVertexPositionsDidChange(clipDrawIndex))
+                {
+                    continue;
+                }
+
+                AddDrawableCommand(commandList, CubismRenderCommand::CommandType_DrawMask, clipDrawIndex, clipContext);
+            }
+        }
+
+        CubismRenderCommand& endCommand = commandList.AddCommand(CubismRenderCommand::CommandType_EndMask);
+        endCommand.MaskBufferIndex = bufferIndex;
+    }
+
+    CSM_PROFILE_COUNTER_ADD(Counter_MaskRedraws, usingClipCount);
+}
+
+void CubismRenderer_OpenGLES2::AddDrawableCommand(CubismRenderCommandList& commandList, CubismRenderCommand::CommandType type, csmInt32 drawableIndex, CubismClippingContext_OpenGLES2* clipContext)
+{
+    const CubismModel& model = *GetModel();
+    const csmInt32 vertexCount = model.GetDrawableVertexCount(drawableIndex);
+
+    // 頂点座標はモデルの更新で書き換わるのでコピーする
+    const csmInt32 vertexOffset = commandList.AddVertexPositions(model.GetDrawableVertices(drawableIndex), vertexCount);
+
+    CubismRenderCommand& command = commandList.AddCommand(type);
+    command.DrawableIndex = drawableIndex;
+    command.TextureIndex = model.GetDrawableTextureIndex(drawableIndex);
+    command.BlendMode = model.GetDrawableBlendMode(drawableIndex);
+    command.IsCulling = model.GetDrawableCulling(drawableIndex) != 0;
+    command.IsInvertedMask = model.GetDrawableInvertedMask(drawableIndex);
+    command.VertexOffset = vertexOffset;
+    command.VertexCount = vertexCount;
+    command.Uvs = reinterpret_cast<const csmFloat32*>(model.GetDrawableVertexUvs(drawableIndex));
+    command.Indices = model.GetDrawableVertexIndices(drawableIndex);
+    command.IndexCount = model.GetDrawableVertexIndexCount(drawableIndex);
+    command.MultiplyColor = model.GetMultiplyColor(drawableIndex);
+    command.ScreenColor = model.GetScreenColor(drawableIndex);
+
+    if (type == CubismRenderCommand::CommandType_DrawMask)
+    {
+        const csmRectF* rect = clipContext->_layoutBounds;
+        command.BaseColor = CubismTextureColor(rect->X * 2.0f - 1.0f, rect->Y * 2.0f - 1.0f, rect->GetRight() * 2.0f - 1.0f, rect->GetBottom() * 2.0f - 1.0f);
+        command.ClipMatrix = clipContext->_matrixForMask;
+    }
+    else
+    {
+        command.BaseColor = GetModelColorWithOpacity(model.GetDrawableOpacity(drawableIndex));
+        if (clipContext != NULL)
+        {
+            command.ClipMatrix = clipContext->_matrixForDraw;
+        }
+    }
+
+    if (clipContext != NULL)
+    {
+        command.MaskBufferIndex = clipContext->_bufferIndex;
+        command.ChannelFlag = *_clippingManager->GetChannelFlagAsColor(clipContext->_layoutChannelIndex);
+    }
+}
+
+void CubismRenderer_OpenGLES2::DrawCommandOpenGL(const CubismRenderCommandList& commandList, const CubismRenderCommand& command)
+{
+
+#ifdef CSM_TARGET_WIN_GL
+    if (s_isFirstInitializeGlFunctions) return;  // WindowsプラットフォームではGL命令のバインドを済ませておく必要がある
+#endif
+
+#ifndef CSM_DEBUG
+    if (_textures[command.TextureIndex] == 0) return;    // モデルが参照するテクスチャがバインドされていない場合は描画をスキップする
+#endif
+
+    // 裏面描画の有効・無効
+    if (command.IsCulling)
+    {
+        glEnable(GL_CULL_FACE);
+    }
+    else
+    {
+        glDisable(GL_CULL_FACE);
+    }
+
+    glFrontFace(GL_CCW);    // Cubism SDK OpenGLはマスク・アートメッシュ共にCCWが表面
+
+    CubismShader_OpenGLES2::GetInstance()->SetupShaderProgramForCommand(this, commandList, command);
+
+    // ポリゴンメッシュを描画する
+    glDrawElements(GL_TRIANGLES, command.IndexCount, GL_UNSIGNED_SHORT, command.Indices);
+
+    CSM_PROFILE_COUNTER_ADD(Counter_DrawCalls, 1);
+    CSM_PROFILE_COUNTER_ADD(Counter_UploadedVertices, command.VertexCount);
+
+    // 後処理
+    glUseProgram(0);
+}
+
 void CubismRenderer_OpenGLES2::SaveProfile()
 {
     _rendererProfile.Save();
@@ -718,7 +1105,8 @@ const csmMap<csmInt32, GLuint>& CubismRenderer_OpenGLES2::GetBindedTextures() co
 
 void CubismRenderer_OpenGLES2::SetClippingMaskBufferSize(csmFloat32 width, csmFloat32 height)
 {
-    if (_clippingManager == NULL)
+    // 共有しているマスクのサイズは共有元で変更する
+    if (_clippingManager == NULL || _clippingMaskSource != NULL)
     {
         return;
     }
@@ -732,6 +1120,7 @@ void CubismRenderer_OpenGLES2::SetClippingMaskBufferSize(csmFloat32 width, csmFl
     _clippingManager = CSM_NEW CubismClippingManager_OpenGLES2();
 
     _clippingManager->SetClippingMaskBufferSize(width, height);
+    _isClippingMaskReusable = false;
 
     _clippingManager->Initialize(
         *GetModel(),
@@ -751,9 +1140,33 @@ CubismVector2 CubismRenderer_OpenGLES2::GetClippingMaskBufferSize() const
 
 CubismOffscreenSurface_OpenGLES2* CubismRenderer_OpenGLES2::GetMaskBuffer(csmInt32 index)
 {
+    if (_clippingMaskSource != NULL)
+    {
+        return _clippingMaskSource->GetMaskBuffer(index);
+    }
+
     return &_offscreenSurfaces[index];
 }
 
+void CubismRenderer_OpenGLES2::ShareClippingMask(CubismRenderer_OpenGLES2* source)
+{
+    if (source == NULL || source == this || source->_clippingMaskSource != NULL)
+    {
+        CubismLogWarning("The source of the clipping mask must be a renderer that owns its clipping mask.");
+        return;
+    }
+
+    ReleaseClippingMask();
+
+    _clippingManager = source->_clippingManager;
+    _clippingMaskSource = (_clippingManager != NULL) ? source : NULL;
+
+    if (_clippingMaskSource != NULL)
+    {
+        ++_clippingMaskSource->_clippingMaskShareCount;
+    }
+}
+
 void CubismRenderer_OpenGLES2::SetClippingContextBufferForMask(CubismClippingContext_OpenGLES2* clip)
 {
     _clippingContextBufferForMask = clip;
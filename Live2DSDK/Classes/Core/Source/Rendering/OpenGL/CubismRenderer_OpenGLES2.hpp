@@ -12,6 +12,7 @@
 #include "CubismFramework.hpp"
 #include "CubismOffscreenSurface_OpenGLES2.hpp"
 #include "CubismShader_OpenGLES2.hpp"
+#include "CubismRenderCommandList.hpp"
 #include "csmVector.hpp"
 #include "csmRectF.hpp"
 #include "CubismVector2.hpp"
@@ -239,6 +240,49 @@ public:
      */
     CubismOffscreenSurface_OpenGLES2* GetMaskBuffer(csmInt32 index);
 
+    /**
+     * @brief  同じMOCから作成したモデルのレンダラとクリッピングマスクを共有する<br>
+     *         マスクは描画の度に生成し直すため、同じモデルを多数描画する場合にマスク用のバッファを1組にできる。
+     *         共有元のレンダラは共有先より後に破棄すること。
+     *         共有中はモデルの更新が省略されたフレームでも、共有元・共有先ともにマスクを生成し直す。
+     *
+     * @param[in]  source -> クリッピングマスクを保持しているレンダラ
+     *
+     */
+    void ShareClippingMask(CubismRenderer_OpenGLES2* source);
+
+    /**
+     * @brief  RecordDrawModelが使うメモリを確保する<br>
+     *         描画オブジェクトとマスクの数から記録するコマンドと頂点の最大数を求め、コマンドリストに確保する。
+     *         RecordDrawModelを描画スレッド以外から呼び出す場合は、事前に描画スレッドで呼び出すこと。
+     *
+     * @param[out]  commandList -> 記録先のコマンドリスト
+     */
+    void PrepareRecordDrawModel(CubismRenderCommandList& commandList);
+
+    /**
+     * @brief  モデルの描画をコマンドリストに記録する<br>
+     *         OpenGLの命令は発行しないため、描画スレッド以外から呼び出せる。
+     *         PrepareRecordDrawModelで確保したコマンドリストに記録する場合は、CubismFrameworkのアロケータを使わない。
+     *         記録後にモデルを更新しても、ExecuteCommandListは記録時点の状態を描画する。<br>
+     *         高精細マスクを使用している場合は記録できないため、DrawModelで描画すること。
+     *         クリッピングマスクを共有しているレンダラ同士は同時に記録しないこと。
+     *         また、記録中は同じマスクを使うレンダラのExecuteCommandList・DrawModelを呼び出さないこと。
+     *
+     * @param[out]  commandList -> 記録先のコマンドリスト。記録前にクリアする
+     *
+     * @return  記録できた場合はtrue
+     */
+    csmBool RecordDrawModel(CubismRenderCommandList& commandList);
+
+    /**
+     * @brief  RecordDrawModelで記録したコマンドリストを実行してモデルを描画する<br>
+     *         描画スレッドから呼び出すこと。
+     *
+     * @param[in]   commandList -> このレンダラで記録したコマンドリスト
+     */
+    void ExecuteCommandList(const CubismRenderCommandList& commandList);
+
 protected:
     /**
      * @brief   コンストラクタ
@@ -265,6 +309,15 @@ protected:
      */
     void DrawMeshOpenGL(const CubismModel& model, const csmInt32 index);
 
+    /**
+     * @brief    記録した描画コマンド（DrawMask・Draw）を実行する。
+     *
+     * @param[in]   commandList ->  コマンドを記録したリスト
+     * @param[in]   command     ->  実行するコマンド
+     *
+     */
+    void DrawCommandOpenGL(const CubismRenderCommandList& commandList, const CubismRenderCommand& command);
+
 #ifdef CSM_TARGET_ANDROID_ES2
 public:
     /**
@@ -292,6 +345,29 @@ private:
      */
     static void DoStaticRelease();
 
+    /**
+     * @brief   クリッピングマスク管理オブジェクトとマスク用のフレームバッファを解放する<br>
+     *           共有している場合は参照を外すのみ
+     */
+    void ReleaseClippingMask();
+
+    /**
+     * @brief   クリッピングマスクのレイアウトを計算し、マスクの描画をコマンドリストに記録する
+     *
+     * @param[out]  commandList ->  記録先のコマンドリスト
+     */
+    void RecordClippingMask(CubismRenderCommandList& commandList);
+
+    /**
+     * @brief   Drawableを描画するコマンドを記録する
+     *
+     * @param[out]  commandList     ->  記録先のコマンドリスト
+     * @param[in]   type            ->  CommandType_DrawMaskまたはCommandType_Draw
+     * @param[in]   drawableIndex   ->  描画するDrawableのインデックス
+     * @param[in]   clipContext     ->  マスクの生成先、または描画時に参照するクリッピングコンテキスト。マスクを使わない場合はNULL
+     */
+    void AddDrawableCommand(CubismRenderCommandList& commandList, CubismRenderCommand::CommandType type, csmInt32 drawableIndex, CubismClippingContext_OpenGLES2* clipContext);
+
     /**
      * @brief   描画開始時の追加処理。<br>
      *           モデルを描画する前にクリッピングマスクに必要な処理を実装している。
@@ -378,6 +454,9 @@ private:
     CubismClippingContext_OpenGLES2* _clippingContextBufferForDraw;  ///< 画面上描画するためのクリッピングコンテキスト
 
     csmVector<CubismOffscreenSurface_OpenGLES2>   _offscreenSurfaces;          ///< マスク描画用のフレームバッファ
+    CubismRenderer_OpenGLES2* _clippingMaskSource;                   ///< クリッピングマスクの共有元。共有していない場合はNULL
+    csmInt32 _clippingMaskShareCount;                               ///< このレンダラのクリッピングマスクを共有しているレンダラの数
+    csmBool _isClippingMaskReusable;                                ///< モデルの更新が省略された場合に前回生成したマスクをそのまま使えるか
 };
 
 }}}}
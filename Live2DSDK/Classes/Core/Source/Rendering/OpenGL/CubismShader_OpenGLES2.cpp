@@ -8,7 +8,10 @@
 #include "CubismShader_OpenGLES2.hpp"
 #include <float.h>
 #include "csmRectF.hpp"
+#include "CubismRenderCommandList.hpp"
+#ifdef CSM_TARGET_IPHONE_ES2
 #import <OpenGLES/ES2/gl.h>
+#endif
 
 #ifdef CSM_TARGET_WIN_GL
 #include <Windows.h>
@@ -20,6 +23,13 @@
 
 #define CSM_FRAGMENT_SHADER_FP_PRECISION CSM_FRAGMENT_SHADER_FP_PRECISION_HIGH
 
+// プログラムバイナリはOpenGL 4.1・OpenGL ES 3.0以降の標準機能、またはOES_get_program_binary拡張で取得できる
+#if defined(GL_ES_VERSION_3_0) || defined(GL_VERSION_4_1) || defined(GL_ARB_get_program_binary)
+#define CSM_PROGRAM_BINARY_CORE
+#elif defined(GL_OES_get_program_binary) && defined(GL_GLEXT_PROTOTYPES)
+#define CSM_PROGRAM_BINARY_OES
+#endif
+
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
 
@@ -29,6 +39,87 @@ namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering
 namespace {
     const csmInt32 ShaderCount = 19; ///< シェーダの数 = マスク生成用 + (通常 + 加算 + 乗算) * (マスク無 + マスク有 + マスク有反転 + マスク無の乗算済アルファ対応版 + マスク有の乗算済アルファ対応版 + マスク有反転の乗算済アルファ対応版)
     CubismShader_OpenGLES2* s_instance;
+
+    // Layout of the program binary cache:
+    // header = magic(4) driverHash(8) entryCount(4), entry = sourceHash(8) format(4) size(4) binary(size)
+    const csmByte ProgramBinaryCacheMagic[4] = { 'C', 'S', 'B', '1' };
+    const csmSizeInt ProgramBinaryCacheHeaderSize = 16;
+    const csmSizeInt ProgramBinaryEntryHeaderSize = 16;
+
+    const csmUint64 FnvOffsetBasis = 14695981039346656037ULL;
+    const csmUint64 FnvPrime = 1099511628211ULL;
+
+    /// Feeds a NUL-terminated string and its terminator into an FNV-1a hash.
+    csmUint64 HashString(csmUint64 hash, const csmChar* str)
+    {
+        if (str != NULL)
+        {
+            for (; *str != '\0'; ++str)
+            {
+                hash = (hash ^ static_cast<csmByte>(*str)) * FnvPrime;
+            }
+        }
+        return hash * FnvPrime;
+    }
+
+    /// Writes a value in little endian.
+    void WriteUint(csmByte* output, csmUint64 value, csmInt32 byteCount)
+    {
+        for (csmInt32 i = 0; i < byteCount; ++i)
+        {
+            output[i] = static_cast<csmByte>(value >> (i * 8));
+        }
+    }
+
+    /// Reads a value written by WriteUint.
+    csmUint64 ReadUint(const csmByte* input, csmInt32 byteCount)
+    {
+        csmUint64 value = 0;
+        for (csmInt32 i = 0; i < byteCount; ++i)
+        {
+            value |= static_cast<csmUint64>(input[i]) << (i * 8);
+        }
+        return value;
+    }
+
+    /// Checks that a cache buffer has a header and that its entries exactly fill it.
+    csmBool IsValidProgramBinaryCache(const csmByte* buffer, csmSizeInt size)
+    {
+        if (buffer == NULL || size < ProgramBinaryCacheHeaderSize || memcmp(buffer, ProgramBinaryCacheMagic, sizeof(ProgramBinaryCacheMagic)) != 0)
+        {
+            return false;
+        }
+
+        const csmUint64 entryCount = ReadUint(buffer + 12, 4);
+        csmSizeInt offset = ProgramBinaryCacheHeaderSize;
+        for (csmUint64 i = 0; i < entryCount; ++i)
+        {
+            if (size - offset < ProgramBinaryEntryHeaderSize)
+            {
+                return false;
+            }
+
+            const csmUint64 binarySize = ReadUint(buffer + offset + 12, 4);
+            offset += ProgramBinaryEntryHeaderSize;
+            if (size - offset < binarySize)
+            {
+                return false;
+            }
+            offset += static_cast<csmSizeInt>(binarySize);
+        }
+
+        return offset == size;
+    }
+
+    /// Identifies the driver that produced the program binaries.
+    csmUint64 ComputeDriverHash()
+    {
+        csmUint64 hash = FnvOffsetBasis;
+        hash = HashString(hash, reinterpret_cast<const csmChar*>(glGetString(GL_VENDOR)));
+        hash = HashString(hash, reinterpret_cast<const csmChar*>(glGetString(GL_RENDERER)));
+        hash = HashString(hash, reinterpret_cast<const csmChar*>(glGetString(GL_VERSION)));
+        return hash;
+    }
 }
 
 enum ShaderNames
@@ -485,6 +576,8 @@ void CubismShader_OpenGLES2::ReleaseInvalidShaderProgram()
 
 
 CubismShader_OpenGLES2::CubismShader_OpenGLES2()
+    : _isProgramBinarySupported(false)
+    , _isProgramBinaryCacheUpdated(false)
 { }
 
 CubismShader_OpenGLES2::~CubismShader_OpenGLES2()
@@ -519,8 +612,209 @@ void CubismShader_OpenGLES2::SetExtShaderMode(csmBool extMode, csmBool extPAMode
 }
 #endif
 
+void CubismShader_OpenGLES2::PrepareShaderPrograms()
+{
+    if (_shaderSets.GetSize() == 0)
+    {
+        GenerateShaders();
+    }
+}
+
+csmBool CubismShader_OpenGLES2::DeserializeProgramBinaryCache(const csmByte* buffer, csmSizeInt size)
+{
+    if (!IsValidProgramBinaryCache(buffer, size))
+    {
+        return false;
+    }
+
+    // ドライバの確認はコンテキストが必要なので、シェーダプログラムの生成時に行う
+    _programBinaryCache.Clear();
+    _programBinaryCache.UpdateSize(static_cast<csmInt32>(size), 0, false);
+    memcpy(_programBinaryCache.GetPtr(), buffer, size);
+    _isProgramBinaryCacheUpdated = false;
+
+    return true;
+}
+
+void CubismShader_OpenGLES2::SerializeProgramBinaryCache(csmVector<csmByte>& output)
+{
+    output.Clear();
+    if (_programBinaryCache.GetSize() > 0)
+    {
+        output.UpdateSize(_programBinaryCache.GetSize(), 0, false);
+        memcpy(output.GetPtr(), _programBinaryCache.GetPtr(), _programBinaryCache.GetSize());
+    }
+    _isProgramBinaryCacheUpdated = false;
+}
+
+csmBool CubismShader_OpenGLES2::IsProgramBinaryCacheUpdated() const
+{
+    return _isProgramBinaryCacheUpdated;
+}
+
+void CubismShader_OpenGLES2::BeginProgramBinaryCache()
+{
+    _isProgramBinarySupported = false;
+    _linkedProgramHashes.Clear();
+    _linkedPrograms.Clear();
+
+#if defined(CSM_PROGRAM_BINARY_CORE) || defined(CSM_PROGRAM_BINARY_OES)
+    // 形式が1つも無い場合はドライバがバイナリの取得に対応していない
+    GLint formatCount = 0;
+#ifdef CSM_PROGRAM_BINARY_CORE
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+#else
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &formatCount);
+#endif
+    _isProgramBinarySupported = (formatCount > 0);
+#endif
+
+    if (!_isProgramBinarySupported)
+    {
+        return;
+    }
+
+    // ドライバが更新された場合、以前のバイナリは使えない
+    const csmUint64 driverHash = ComputeDriverHash();
+    if (_programBinaryCache.GetSize() < ProgramBinaryCacheHeaderSize ||
+        ReadUint(_programBinaryCache.GetPtr() + 4, 8) != driverHash)
+    {
+        ResetProgramBinaryCache(driverHash);
+    }
+}
+
+GLuint CubismShader_OpenGLES2::LoadProgramBinary(csmUint64 sourceHash)
+{
+#if defined(CSM_PROGRAM_BINARY_CORE) || defined(CSM_PROGRAM_BINARY_OES)
+    if (!_isProgramBinarySupported)
+    {
+        return 0;
+    }
+
+    const csmByte* cache = _programBinaryCache.GetPtr();
+    const csmUint64 entryCount = ReadUint(cache + 12, 4);
+    csmSizeInt offset = ProgramBinaryCacheHeaderSize;
+    for (csmUint64 i = 0; i < entryCount; ++i)
+    {
+        const csmUint64 entryHash = ReadUint(cache + offset, 8);
+        const GLenum format = static_cast<GLenum>(ReadUint(cache + offset + 8, 4));
+        const GLsizei binarySize = static_cast<GLsizei>(ReadUint(cache + offset + 12, 4));
+        offset += ProgramBinaryEntryHeaderSize;
+
+        if (entryHash != sourceHash)
+        {
+            offset += binarySize;
+            continue;
+        }
+
+        GLuint shaderProgram = glCreateProgram();
+#ifdef CSM_PROGRAM_BINARY_CORE
+        glProgramBinary(shaderProgram, format, cache + offset, binarySize);
+#else
+        glProgramBinaryOES(shaderProgram, format, cache + offset, binarySize);
+#endif
+
+        GLint status = GL_FALSE;
+        glGetProgramiv(shaderProgram, GL_LINK_STATUS, &status);
+        if (status == GL_TRUE)
+        {
+            return shaderProgram;
+        }
+
+        // 同じドライバでも受け付けない場合があるので、キャッシュを作り直す
+        // 既に生成したプログラムはこの後読み込まれないため、ここでバイナリを追加し直す
+        CubismLogWarning("The cached program binary was rejected. Compiling shaders from source.");
+        glDeleteProgram(shaderProgram);
+        ResetProgramBinaryCache(ReadUint(cache + 4, 8));
+        for (csmUint32 j = 0; j < _linkedPrograms.GetSize(); ++j)
+        {
+            StoreProgramBinary(_linkedProgramHashes[j], _linkedPrograms[j]);
+        }
+        _isProgramBinaryCacheUpdated = true;
+        return 0;
+    }
+#else
+    (void)sourceHash;
+#endif
+
+    return 0;
+}
+
+void CubismShader_OpenGLES2::StoreProgramBinary(csmUint64 sourceHash, GLuint shaderProgram)
+{
+#if defined(CSM_PROGRAM_BINARY_CORE) || defined(CSM_PROGRAM_BINARY_OES)
+    if (!_isProgramBinarySupported || shaderProgram == 0)
+    {
+        return;
+    }
+
+    GLint binaryLength = 0;
+#ifdef CSM_PROGRAM_BINARY_CORE
+    glGetProgramiv(shaderProgram, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+#else
+    glGetProgramiv(shaderProgram, GL_PROGRAM_BINARY_LENGTH_OES, &binaryLength);
+#endif
+    if (binaryLength <= 0)
+    {
+        return;
+    }
+
+    const csmInt32 entryOffset = static_cast<csmInt32>(_programBinaryCache.GetSize());
+    _programBinaryCache.UpdateSize(entryOffset + static_cast<csmInt32>(ProgramBinaryEntryHeaderSize) + binaryLength, 0, false);
+
+    csmByte* entry = _programBinaryCache.GetPtr() + entryOffset;
+    GLsizei writtenLength = 0;
+    GLenum format = 0;
+#ifdef CSM_PROGRAM_BINARY_CORE
+    glGetProgramBinary(shaderProgram, binaryLength, &writtenLength, &format, entry + ProgramBinaryEntryHeaderSize);
+#else
+    glGetProgramBinaryOES(shaderProgram, binaryLength, &writtenLength, &format, entry + ProgramBinaryEntryHeaderSize);
+#endif
+    if (writtenLength <= 0)
+    {
+        _programBinaryCache.UpdateSize(entryOffset, 0, false);
+        return;
+    }
+
+    WriteUint(entry, sourceHash, 8);
+    WriteUint(entry + 8, format, 4);
+    WriteUint(entry + 12, static_cast<csmUint64>(writtenLength), 4);
+    _programBinaryCache.UpdateSize(entryOffset + static_cast<csmInt32>(ProgramBinaryEntryHeaderSize) + writtenLength, 0, false);
+
+    csmByte* header = _programBinaryCache.GetPtr();
+    WriteUint(header + 12, ReadUint(header + 12, 4) + 1, 4);
+    _isProgramBinaryCacheUpdated = true;
+#else
+    (void)sourceHash;
+    (void)shaderProgram;
+#endif
+}
+
+void CubismShader_OpenGLES2::AddLinkedProgram(csmUint64 sourceHash, GLuint shaderProgram)
+{
+    if (!_isProgramBinarySupported || shaderProgram == 0)
+    {
+        return;
+    }
+
+    _linkedProgramHashes.PushBack(sourceHash);
+    _linkedPrograms.PushBack(shaderProgram);
+}
+
+void CubismShader_OpenGLES2::ResetProgramBinaryCache(csmUint64 driverHash)
+{
+    _programBinaryCache.UpdateSize(static_cast<csmInt32>(ProgramBinaryCacheHeaderSize), 0, false);
+
+    csmByte* header = _programBinaryCache.GetPtr();
+    memcpy(header, ProgramBinaryCacheMagic, sizeof(ProgramBinaryCacheMagic));
+    WriteUint(header + 4, driverHash, 8);
+    WriteUint(header + 12, 0, 4);
+}
+
 void CubismShader_OpenGLES2::GenerateShaders()
 {
+    BeginProgramBinaryCache();
+
     for (csmInt32 i = 0; i < ShaderCount; i++)
     {
         _shaderSets.PushBack(CSM_NEW CubismShaderSet());
@@ -811,46 +1105,10 @@ void CubismShader_OpenGLES2::SetupShaderProgramForDraw(CubismRenderer_OpenGLES2*
     }
 
     // Blending
-    csmInt32 SRC_COLOR;
-    csmInt32 DST_COLOR;
-    csmInt32 SRC_ALPHA;
-    csmInt32 DST_ALPHA;
+    GLenum blendFactors[4];
 
-    // _shaderSets用のオフセット計算
     const csmBool masked = renderer->GetClippingContextBufferForDraw() != NULL;  // この描画オブジェクトはマスク対象か
-    const csmBool invertedMask = model.GetDrawableInvertedMask(index);
-    const csmBool isPremultipliedAlpha = renderer->IsPremultipliedAlpha();
-    const csmInt32 offset = (masked ? ( invertedMask ? 2 : 1 ) : 0) + (isPremultipliedAlpha ? 3 : 0);
-
-    // シェーダーセット
-    CubismShaderSet* shaderSet;
-    switch (model.GetDrawableBlendMode(index))
-    {
-    case CubismRenderer::CubismBlendMode_Normal:
-    default:
-        shaderSet = _shaderSets[ShaderNames_Normal + offset];
-        SRC_COLOR = GL_ONE;
-        DST_COLOR = GL_ONE_MINUS_SRC_ALPHA;
-        SRC_ALPHA = GL_ONE;
-        DST_ALPHA = GL_ONE_MINUS_SRC_ALPHA;
-        break;
-
-    case CubismRenderer::CubismBlendMode_Additive:
-        shaderSet = _shaderSets[ShaderNames_Add + offset];
-        SRC_COLOR = GL_ONE;
-        DST_COLOR = GL_ONE;
-        SRC_ALPHA = GL_ZERO;
-        DST_ALPHA = GL_ONE;
-        break;
-
-    case CubismRenderer::CubismBlendMode_Multiplicative:
-        shaderSet = _shaderSets[ShaderNames_Mult + offset];
-        SRC_COLOR = GL_DST_COLOR;
-        DST_COLOR = GL_ONE_MINUS_SRC_ALPHA;
-        SRC_ALPHA = GL_ZERO;
-        DST_ALPHA = GL_ONE;
-        break;
-    }
+    CubismShaderSet* shaderSet = SelectShaderSetForDraw(model.GetDrawableBlendMode(index), masked, model.GetDrawableInvertedMask(index), renderer->IsPremultipliedAlpha(), blendFactors);
 
     glUseProgram(shaderSet->ShaderProgram);
 
@@ -886,7 +1144,7 @@ void CubismShader_OpenGLES2::SetupShaderProgramForDraw(CubismRenderer_OpenGLES2*
     CubismRenderer::CubismTextureColor screenColor = model.GetScreenColor(index);
     SetColorUniformVariables(renderer, model, index, shaderSet, baseColor, multiplyColor, screenColor);
 
-    glBlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
+    glBlendFuncSeparate(blendFactors[0], blendFactors[1], blendFactors[2], blendFactors[3]);
 }
 
 void CubismShader_OpenGLES2::SetupShaderProgramForMask(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index)
@@ -926,6 +1184,118 @@ void CubismShader_OpenGLES2::SetupShaderProgramForMask(CubismRenderer_OpenGLES2*
     glBlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
 }
 
+void CubismShader_OpenGLES2::SetupShaderProgramForCommand(CubismRenderer_OpenGLES2* renderer, const CubismRenderCommandList& commandList, const CubismRenderCommand& command)
+{
+    if (_shaderSets.GetSize() == 0)
+    {
+        GenerateShaders();
+    }
+
+    // Blending
+    GLenum blendFactors[4];
+
+    CubismShaderSet* shaderSet;
+    if (command.Type == CubismRenderCommand::CommandType_DrawMask)
+    {
+        shaderSet = _shaderSets[ShaderNames_SetupMask];
+        blendFactors[0] = GL_ZERO;
+        blendFactors[1] = GL_ONE_MINUS_SRC_COLOR;
+        blendFactors[2] = GL_ZERO;
+        blendFactors[3] = GL_ONE_MINUS_SRC_ALPHA;
+    }
+    else
+    {
+        const csmBool masked = command.MaskBufferIndex >= 0;
+        shaderSet = SelectShaderSetForDraw(command.BlendMode, masked, command.IsInvertedMask, commandList.IsPremultipliedAlpha(), blendFactors);
+    }
+
+    glUseProgram(shaderSet->ShaderProgram);
+
+    //テクスチャ設定
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, renderer->GetBindedTextureId(command.TextureIndex));
+    glUniform1i(shaderSet->SamplerTexture0Location, 0);
+
+    // 頂点属性設定
+    SetVertexAttributes(commandList.GetVertexPositions(command.VertexOffset), command.Uvs, shaderSet);
+
+    CubismMatrix44 clipMatrix = command.ClipMatrix;
+
+    if (command.Type == CubismRenderCommand::CommandType_DrawMask)
+    {
+        // 使用するカラーチャンネルを設定
+        SetColorChannelUniformVariables(shaderSet, command.ChannelFlag);
+
+        glUniformMatrix4fv(shaderSet->UniformClipMatrixLocation, 1, GL_FALSE, clipMatrix.GetArray());
+    }
+    else
+    {
+        if (command.MaskBufferIndex >= 0)
+        {
+            glActiveTexture(GL_TEXTURE1);
+
+            // frameBufferに書かれたテクスチャ
+            glBindTexture(GL_TEXTURE_2D, renderer->GetMaskBuffer(command.MaskBufferIndex)->GetColorBuffer());
+            glUniform1i(shaderSet->SamplerTexture1Location, 1);
+
+            // View座標をClippingContextの座標に変換するための行列を設定
+            glUniformMatrix4fv(shaderSet->UniformClipMatrixLocation, 1, 0, clipMatrix.GetArray());
+
+            // 使用するカラーチャンネルを設定
+            SetColorChannelUniformVariables(shaderSet, command.ChannelFlag);
+        }
+
+        //座標変換
+        CubismMatrix44 mvpMatrix = commandList.GetMvpMatrix();
+        glUniformMatrix4fv(shaderSet->UniformMatrixLocation, 1, 0, mvpMatrix.GetArray());
+    }
+
+    // ユニフォーム変数設定
+    glUniform4f(shaderSet->UniformBaseColorLocation, command.BaseColor.R, command.BaseColor.G, command.BaseColor.B, command.BaseColor.A);
+    glUniform4f(shaderSet->UniformMultiplyColorLocation, command.MultiplyColor.R, command.MultiplyColor.G, command.MultiplyColor.B, command.MultiplyColor.A);
+    glUniform4f(shaderSet->UniformScreenColorLocation, command.ScreenColor.R, command.ScreenColor.G, command.ScreenColor.B, command.ScreenColor.A);
+
+    glBlendFuncSeparate(blendFactors[0], blendFactors[1], blendFactors[2], blendFactors[3]);
+}
+
+CubismShader_OpenGLES2::CubismShaderSet* CubismShader_OpenGLES2::SelectShaderSetForDraw(CubismRenderer::CubismBlendMode blendMode, csmBool masked, csmBool invertedMask, csmBool isPremultipliedAlpha, GLenum blendFactors[4])
+{
+    // _shaderSets用のオフセット計算
+    const csmInt32 offset = (masked ? ( invertedMask ? 2 : 1 ) : 0) + (isPremultipliedAlpha ? 3 : 0);
+
+    // シェーダーセット
+    CubismShaderSet* shaderSet;
+    switch (blendMode)
+    {
+    case CubismRenderer::CubismBlendMode_Normal:
+    default:
+        shaderSet = _shaderSets[ShaderNames_Normal + offset];
+        blendFactors[0] = GL_ONE;
+        blendFactors[1] = GL_ONE_MINUS_SRC_ALPHA;
+        blendFactors[2] = GL_ONE;
+        blendFactors[3] = GL_ONE_MINUS_SRC_ALPHA;
+        break;
+
+    case CubismRenderer::CubismBlendMode_Additive:
+        shaderSet = _shaderSets[ShaderNames_Add + offset];
+        blendFactors[0] = GL_ONE;
+        blendFactors[1] = GL_ONE;
+        blendFactors[2] = GL_ZERO;
+        blendFactors[3] = GL_ONE;
+        break;
+
+    case CubismRenderer::CubismBlendMode_Multiplicative:
+        shaderSet = _shaderSets[ShaderNames_Mult + offset];
+        blendFactors[0] = GL_DST_COLOR;
+        blendFactors[1] = GL_ONE_MINUS_SRC_ALPHA;
+        blendFactors[2] = GL_ZERO;
+        blendFactors[3] = GL_ONE;
+        break;
+    }
+
+    return shaderSet;
+}
+
 csmBool CubismShader_OpenGLES2::CompileShaderSource(GLuint* outShader, GLenum shaderType, const csmChar* shaderSource)
 {
     GLint status;
@@ -1004,6 +1374,15 @@ csmBool CubismShader_OpenGLES2::ValidateProgram(GLuint shaderProgram)
 
 GLuint CubismShader_OpenGLES2::LoadShaderProgram(const csmChar* vertShaderSrc, const csmChar* fragShaderSrc)
 {
+    // キャッシュしたバイナリがあればコンパイルしない
+    const csmUint64 sourceHash = HashString(HashString(FnvOffsetBasis, vertShaderSrc), fragShaderSrc);
+    GLuint cachedProgram = LoadProgramBinary(sourceHash);
+    if (cachedProgram != 0)
+    {
+        AddLinkedProgram(sourceHash, cachedProgram);
+        return cachedProgram;
+    }
+
     GLuint vertShader, fragShader;
 
     // Create shader program.
@@ -1028,6 +1407,14 @@ GLuint CubismShader_OpenGLES2::LoadShaderProgram(const csmChar* vertShaderSrc, c
     // Attach fragment shader to program.
     glAttachShader(shaderProgram, fragShader);
 
+#ifdef CSM_PROGRAM_BINARY_CORE
+    // リンク後にバイナリを取得できるようにする
+    if (_isProgramBinarySupported)
+    {
+        glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+#endif
+
     // Link program.
     if (!LinkProgram(shaderProgram))
     {
@@ -1065,18 +1452,24 @@ GLuint CubismShader_OpenGLES2::LoadShaderProgram(const csmChar* vertShaderSrc, c
         glDeleteShader(fragShader);
     }
 
+    StoreProgramBinary(sourceHash, shaderProgram);
+    AddLinkedProgram(sourceHash, shaderProgram);
+
     return shaderProgram;
 }
 
 void CubismShader_OpenGLES2::SetVertexAttributes(const CubismModel& model, const csmInt32 index, CubismShaderSet* shaderSet)
+{
+    SetVertexAttributes(model.GetDrawableVertices(index), reinterpret_cast<const csmFloat32*>(model.GetDrawableVertexUvs(index)), shaderSet);
+}
+
+void CubismShader_OpenGLES2::SetVertexAttributes(const csmFloat32* vertexArray, const csmFloat32* uvArray, CubismShaderSet* shaderSet)
 {
     // 頂点位置属性の設定
-    const csmFloat32* vertexArray = model.GetDrawableVertices(index);
     glEnableVertexAttribArray(shaderSet->AttributePositionLocation);
     glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, vertexArray);
 
     // テクスチャ座標属性の設定
-    const csmFloat32* uvArray = reinterpret_cast<const csmFloat32*>(model.GetDrawableVertexUvs(index));
     glEnableVertexAttribArray(shaderSet->AttributeTexCoordLocation);
     glVertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, uvArray);
 }
@@ -1102,7 +1495,12 @@ void CubismShader_OpenGLES2::SetColorChannelUniformVariables(CubismShaderSet* sh
 {
     const csmInt32 channelIndex = contextBuffer->_layoutChannelIndex;
     CubismRenderer::CubismTextureColor* colorChannel = contextBuffer->GetClippingManager()->GetChannelFlagAsColor(channelIndex);
-    glUniform4f(shaderSet->UnifromChannelFlagLocation, colorChannel->R, colorChannel->G, colorChannel->B, colorChannel->A);
+    SetColorChannelUniformVariables(shaderSet, *colorChannel);
+}
+
+void CubismShader_OpenGLES2::SetColorChannelUniformVariables(CubismShaderSet* shaderSet, const CubismRenderer::CubismTextureColor& channelFlag)
+{
+    glUniform4f(shaderSet->UnifromChannelFlagLocation, channelFlag.R, channelFlag.G, channelFlag.B, channelFlag.A);
 }
 
 }}}}
@@ -44,6 +44,8 @@ namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering
 
 class CubismRenderer_OpenGLES2;
 class CubismClippingContext_OpenGLES2;
+class CubismRenderCommandList;
+struct CubismRenderCommand;
 
 /**
  * @brief   OpenGLES2用のシェーダプログラムを生成・破棄するクラス<br>
@@ -89,6 +91,50 @@ public:
      */
     void SetupShaderProgramForMask(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index);
 
+    /**
+     * @brief   記録した描画コマンド（DrawMask・Draw）のシェーダプログラムの一連のセットアップを実行する
+     *
+     * @param[in]   renderer              ->  レンダラー
+     * @param[in]   commandList           ->  コマンドを記録したリスト
+     * @param[in]   command               ->  描画コマンド
+     */
+    void SetupShaderProgramForCommand(CubismRenderer_OpenGLES2* renderer, const CubismRenderCommandList& commandList, const CubismRenderCommand& command);
+
+    /**
+     * @brief   シェーダプログラムを生成する<br>
+     *           最初の描画より前に呼び出しておくと、描画時にシェーダをコンパイルせずに済む。生成済みの場合は何もしない。
+     *           OpenGLのコンテキストがカレントのスレッドから呼び出すこと。
+     */
+    void PrepareShaderPrograms();
+
+    /**
+     * @brief   プログラムバイナリのキャッシュを読み込む<br>
+     *           シェーダプログラムの生成時、ソースとドライバが一致するバイナリがあればコンパイルせずに使用する。
+     *           プログラムバイナリを取得できない環境ではソースからコンパイルする。
+     *           シェーダプログラムを生成する前に呼び出すこと。
+     *
+     * @param[in]   buffer  ->  SerializeProgramBinaryCacheで書き出したデータ
+     * @param[in]   size    ->  データのサイズ
+     *
+     * @return  読み込めた場合はtrue
+     */
+    csmBool DeserializeProgramBinaryCache(const csmByte* buffer, csmSizeInt size);
+
+    /**
+     * @brief   プログラムバイナリのキャッシュを書き出す<br>
+     *           書き出すとIsProgramBinaryCacheUpdatedはfalseに戻る。
+     *
+     * @param[out]  output  ->  書き出し先。既存の内容は破棄する
+     */
+    void SerializeProgramBinaryCache(csmVector<csmByte>& output);
+
+    /**
+     * @brief   読み込み・書き出しの後にキャッシュが更新されたかを取得する
+     *
+     * @return  ソースからコンパイルしたプログラムを追加した場合はtrue
+     */
+    csmBool IsProgramBinaryCacheUpdated() const;
+
 private:
     /**
     * @bref    シェーダープログラムとシェーダ変数のアドレスを保持する構造体
@@ -171,6 +217,58 @@ private:
      */
     csmBool ValidateProgram(GLuint shaderProgram);
 
+    /**
+     * @brief   プログラムバイナリのキャッシュを使用できるか確認する<br>
+     *           ドライバが異なるキャッシュは破棄する。シェーダプログラムの生成前に呼び出す。
+     */
+    void BeginProgramBinaryCache();
+
+    /**
+     * @brief   キャッシュしたプログラムバイナリからシェーダプログラムを生成する
+     *
+     * @param[in]   sourceHash  ->  シェーダソースのハッシュ
+     *
+     * @return  シェーダプログラムのアドレス。キャッシュに無い、または読み込めない場合は0
+     */
+    GLuint LoadProgramBinary(csmUint64 sourceHash);
+
+    /**
+     * @brief   リンクしたシェーダプログラムのバイナリをキャッシュに追加する
+     *
+     * @param[in]   sourceHash      ->  シェーダソースのハッシュ
+     * @param[in]   shaderProgram   ->  リンク済みのシェーダプログラム
+     */
+    void StoreProgramBinary(csmUint64 sourceHash, GLuint shaderProgram);
+
+    /**
+     * @brief   シェーダプログラムの生成で得たプログラムを記録する<br>
+     *           キャッシュを作り直した際に、記録したプログラムのバイナリを追加し直す。
+     *
+     * @param[in]   sourceHash      ->  シェーダソースのハッシュ
+     * @param[in]   shaderProgram   ->  リンク済み、またはバイナリから生成したシェーダプログラム
+     */
+    void AddLinkedProgram(csmUint64 sourceHash, GLuint shaderProgram);
+
+    /**
+     * @brief   プログラムバイナリのキャッシュを空にする
+     *
+     * @param[in]   driverHash  ->  キャッシュを作成したドライバのハッシュ
+     */
+    void ResetProgramBinaryCache(csmUint64 driverHash);
+
+    /**
+     * @brief   描画用のシェーダプログラムとブレンド係数を選択する
+     *
+     * @param[in]   blendMode             ->  カラーブレンディングのモード
+     * @param[in]   masked                ->  マスクを使用するか
+     * @param[in]   invertedMask          ->  マスクを反転して使用するか
+     * @param[in]   isPremultipliedAlpha  ->  乗算済みアルファか
+     * @param[out]  blendFactors          ->  glBlendFuncSeparateに渡す係数(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA)
+     *
+     * @return  シェーダープログラムのセット
+     */
+    CubismShaderSet* SelectShaderSetForDraw(CubismRenderer::CubismBlendMode blendMode, csmBool masked, csmBool invertedMask, csmBool isPremultipliedAlpha, GLenum blendFactors[4]);
+
     /**
      * @brief   必要な頂点属性を設定する
      *
@@ -180,6 +278,15 @@ private:
      */
     void SetVertexAttributes(const CubismModel& model, const csmInt32 index, CubismShaderSet* shaderSet);
 
+    /**
+     * @brief   必要な頂点属性を設定する
+     *
+     * @param[in]   vertexArray           ->  頂点座標の配列
+     * @param[in]   uvArray               ->  UV座標の配列
+     * @param[in]   shaderSet             ->  シェーダープログラムのセット
+     */
+    void SetVertexAttributes(const csmFloat32* vertexArray, const csmFloat32* uvArray, CubismShaderSet* shaderSet);
+
     /**
      * @brief   テクスチャの設定を行う
      *
@@ -212,6 +319,14 @@ private:
      */
     void SetColorChannelUniformVariables(CubismShaderSet* shaderSet, CubismClippingContext_OpenGLES2* contextBuffer);
 
+    /**
+     * @brief   カラーチャンネル関連のユニフォーム変数の設定を行う
+     *
+     * @param[in]   shaderSet             ->  シェーダープログラムのセット
+     * @param[in]   channelFlag           ->  使用するカラーチャンネル
+     */
+    void SetColorChannelUniformVariables(CubismShaderSet* shaderSet, const CubismRenderer::CubismTextureColor& channelFlag);
+
 #ifdef CSM_TARGET_ANDROID_ES2
 public:
     /**
@@ -228,6 +343,11 @@ private:
 #endif
 
     csmVector<CubismShaderSet*> _shaderSets;   ///< ロードしたシェーダプログラムを保持する変数
+    csmVector<csmByte> _programBinaryCache;     ///< プログラムバイナリのキャッシュ（書き出す形式のまま保持する）
+    csmBool _isProgramBinarySupported;          ///< 現在のコンテキストでプログラムバイナリを取得・設定できるか
+    csmBool _isProgramBinaryCacheUpdated;       ///< 読み込み・書き出しの後にキャッシュを更新したか
+    csmVector<csmUint64> _linkedProgramHashes;  ///< 生成中のシェーダプログラムのソースのハッシュ
+    csmVector<GLuint> _linkedPrograms;          ///< 生成中に得たシェーダプログラム。キャッシュを作り直した際に追加し直す
 
 };
 
@@ -0,0 +1,976 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismRenderer_Software.hpp"
+#include "CubismMatrix44.hpp"
+#include "csmVector.hpp"
+#include "CubismModel.hpp"
+#include "CubismProfiler.hpp"
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+// CSM_NO_SIMDが定義されている場合はスカラーの処理だけでビルドする
+#if defined(CSM_NO_SIMD)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CSM_SOFTWARE_RENDERER_NEON
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CSM_SOFTWARE_RENDERER_SSE
+#endif
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+namespace {
+
+const csmInt32 BandHeight = 32;     ///< 並列に描画する帯の高さ[px]
+const csmFloat32 ByteToFloat = 1.0f / 255.0f;
+
+// 1ピクセル（R, G, B, A）を1本のベクタで扱う
+#if defined(CSM_SOFTWARE_RENDERER_NEON)
+typedef float32x4_t Vec4;
+
+inline Vec4 Splat4(csmFloat32 x) { return vdupq_n_f32(x); }
+inline Vec4 Set4(csmFloat32 x, csmFloat32 y, csmFloat32 z, csmFloat32 w) { const csmFloat32 v[4] = { x, y, z, w }; return vld1q_f32(v); }
+inline void Store4(csmFloat32* p, Vec4 v) { vst1q_f32(p, v); }
+inline Vec4 Add4(Vec4 a, Vec4 b) { return vaddq_f32(a, b); }
+inline Vec4 Sub4(Vec4 a, Vec4 b) { return vsubq_f32(a, b); }
+inline Vec4 Mul4(Vec4 a, Vec4 b) { return vmulq_f32(a, b); }
+inline Vec4 Clamp01(Vec4 v) { return vminq_f32(vmaxq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f)); }
+inline Vec4 SplatAlpha4(Vec4 v) { return vdupq_n_f32(vgetq_lane_f32(v, 3)); }
+#elif defined(CSM_SOFTWARE_RENDERER_SSE)
+typedef __m128 Vec4;
+
+inline Vec4 Splat4(csmFloat32 x) { return _mm_set1_ps(x); }
+inline Vec4 Set4(csmFloat32 x, csmFloat32 y, csmFloat32 z, csmFloat32 w) { return _mm_setr_ps(x, y, z, w); }
+inline void Store4(csmFloat32* p, Vec4 v) { _mm_storeu_ps(p, v); }
+inline Vec4 Add4(Vec4 a, Vec4 b) { return _mm_add_ps(a, b); }
+inline Vec4 Sub4(Vec4 a, Vec4 b) { return _mm_sub_ps(a, b); }
+inline Vec4 Mul4(Vec4 a, Vec4 b) { return _mm_mul_ps(a, b); }
+inline Vec4 Clamp01(Vec4 v) { return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f)); }
+inline Vec4 SplatAlpha4(Vec4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)); }
+#else
+struct Vec4
+{
+    csmFloat32 V[4];
+};
+
+inline Vec4 Splat4(csmFloat32 x) { const Vec4 r = { { x, x, x, x } }; return r; }
+inline Vec4 Set4(csmFloat32 x, csmFloat32 y, csmFloat32 z, csmFloat32 w) { const Vec4 r = { { x, y, z, w } }; return r; }
+inline void Store4(csmFloat32* p, Vec4 v) { p[0] = v.V[0]; p[1] = v.V[1]; p[2] = v.V[2]; p[3] = v.V[3]; }
+inline Vec4 Add4(Vec4 a, Vec4 b) { return Set4(a.V[0] + b.V[0], a.V[1] + b.V[1], a.V[2] + b.V[2], a.V[3] + b.V[3]); }
+inline Vec4 Sub4(Vec4 a, Vec4 b) { return Set4(a.V[0] - b.V[0], a.V[1] - b.V[1], a.V[2] - b.V[2], a.V[3] - b.V[3]); }
+inline Vec4 Mul4(Vec4 a, Vec4 b) { return Set4(a.V[0] * b.V[0], a.V[1] * b.V[1], a.V[2] * b.V[2], a.V[3] * b.V[3]); }
+inline csmFloat32 Clamp01(csmFloat32 x) { return (x < 0.0f) ? 0.0f : ((x > 1.0f) ? 1.0f : x); }
+inline Vec4 Clamp01(Vec4 v) { return Set4(Clamp01(v.V[0]), Clamp01(v.V[1]), Clamp01(v.V[2]), Clamp01(v.V[3])); }
+inline Vec4 SplatAlpha4(Vec4 v) { return Splat4(v.V[3]); }
+#endif
+
+/// Converts an RGBA8 pixel to a vector in [0, 1].
+inline Vec4 LoadPixel(const csmUint8* p)
+{
+    return Mul4(Set4(p[0], p[1], p[2], p[3]), Splat4(ByteToFloat));
+}
+
+/// Stores a vector as an RGBA8 pixel, rounding to the nearest value like an 8-bit framebuffer does.
+inline void StorePixel(csmUint8* p, Vec4 v)
+{
+    csmFloat32 values[4];
+    Store4(values, Add4(Mul4(Clamp01(v), Splat4(255.0f)), Splat4(0.5f)));
+    p[0] = static_cast<csmUint8>(values[0]);
+    p[1] = static_cast<csmUint8>(values[1]);
+    p[2] = static_cast<csmUint8>(values[2]);
+    p[3] = static_cast<csmUint8>(values[3]);
+}
+
+/// Samples an RGBA8 image with bilinear filtering and clamp-to-edge addressing, where row 0 is at t = 0.
+inline Vec4 SampleBilinear(const csmUint8* pixels, csmInt32 width, csmInt32 height, csmFloat32 s, csmFloat32 t)
+{
+    const csmFloat32 fx = s * width - 0.5f;
+    const csmFloat32 fy = t * height - 0.5f;
+    const csmFloat32 floorX = floorf(fx);
+    const csmFloat32 floorY = floorf(fy);
+    const Vec4 weightX = Splat4(fx - floorX);
+    const Vec4 weightY = Splat4(fy - floorY);
+
+    csmInt32 x0 = static_cast<csmInt32>(floorX);
+    csmInt32 y0 = static_cast<csmInt32>(floorY);
+    csmInt32 x1 = x0 + 1;
+    csmInt32 y1 = y0 + 1;
+    x0 = (x0 < 0) ? 0 : ((x0 >= width) ? width - 1 : x0);
+    x1 = (x1 < 0) ? 0 : ((x1 >= width) ? width - 1 : x1);
+    y0 = (y0 < 0) ? 0 : ((y0 >= height) ? height - 1 : y0);
+    y1 = (y1 < 0) ? 0 : ((y1 >= height) ? height - 1 : y1);
+
+    const csmUint8* row0 = pixels + static_cast<csmSizeInt>(y0) * width * 4;
+    const csmUint8* row1 = pixels + static_cast<csmSizeInt>(y1) * width * 4;
+    const Vec4 p00 = LoadPixel(row0 + x0 * 4);
+    const Vec4 p10 = LoadPixel(row0 + x1 * 4);
+    const Vec4 p01 = LoadPixel(row1 + x0 * 4);
+    const Vec4 p11 = LoadPixel(row1 + x1 * 4);
+
+    const Vec4 top = Add4(p00, Mul4(Sub4(p10, p00), weightX));
+    const Vec4 bottom = Add4(p01, Mul4(Sub4(p11, p01), weightX));
+    return Add4(top, Mul4(Sub4(bottom, top), weightY));
+}
+
+/// Returns whether an edge owns the pixels lying exactly on it, so that shared edges are drawn only once.
+inline csmBool IsOwnedEdge(csmFloat32 dx, csmFloat32 dy)
+{
+    return (dy > 0.0f) || (dy == 0.0f && dx > 0.0f);
+}
+
+/**
+ * Rasterizes one triangle into the rows [rowBegin, rowEnd) and calls the shader for each covered pixel center.
+ *
+ * Positions are x, y pairs in pixels; attributes are four values per vertex interpolated linearly.
+ * frontSign selects the winding that is drawn when culling (the sign of the signed area), or 0 to draw both.
+ */
+template <class T_Shader>
+void RasterizeTriangle(const csmFloat32* p0, const csmFloat32* p1, const csmFloat32* p2,
+                       Vec4 a0, Vec4 a1, Vec4 a2,
+                       csmInt32 width, csmInt32 rowBegin, csmInt32 rowEnd, csmFloat32 frontSign, T_Shader& shader)
+{
+    csmFloat32 area = (p1[0] - p0[0]) * (p2[1] - p0[1]) - (p1[1] - p0[1]) * (p2[0] - p0[0]);
+
+    if (area == 0.0f || area * frontSign < 0.0f)
+    {
+        return;
+    }
+
+    if (area < 0.0f)
+    {
+        const csmFloat32* p = p1;
+        p1 = p2;
+        p2 = p;
+        const Vec4 a = a1;
+        a1 = a2;
+        a2 = a;
+        area = -area;
+    }
+
+    const csmFloat32 minXf = fminf(p0[0], fminf(p1[0], p2[0]));
+    const csmFloat32 maxXf = fmaxf(p0[0], fmaxf(p1[0], p2[0]));
+    const csmFloat32 minYf = fminf(p0[1], fminf(p1[1], p2[1]));
+    const csmFloat32 maxYf = fmaxf(p0[1], fmaxf(p1[1], p2[1]));
+
+    // ピクセルの中心(+0.5)が含まれる範囲
+    const csmInt32 minX = (minXf - 0.5f > 0.0f) ? static_cast<csmInt32>(ceilf(minXf - 0.5f)) : 0;
+    const csmInt32 maxX = (maxXf - 0.5f < width - 1) ? static_cast<csmInt32>(floorf(maxXf - 0.5f)) : width - 1;
+    const csmInt32 minY = (minYf - 0.5f > rowBegin) ? static_cast<csmInt32>(ceilf(minYf - 0.5f)) : rowBegin;
+    const csmInt32 maxY = (maxYf - 0.5f < rowEnd - 1) ? static_cast<csmInt32>(floorf(maxYf - 0.5f)) : rowEnd - 1;
+
+    if (minX > maxX || minY > maxY)
+    {
+        return;
+    }
+
+    // 辺ごとのエッジ関数 E(x, y) = A * x + B * y + C。内側で正になる
+    const csmFloat32* edgeStart[3] = { p1, p2, p0 };
+    const csmFloat32* edgeEnd[3] = { p2, p0, p1 };
+    csmFloat32 stepX[3];
+    csmFloat32 stepY[3];
+    csmFloat32 origin[3];
+    csmBool isOwned[3];
+
+    for (csmInt32 i = 0; i < 3; ++i)
+    {
+        const csmFloat32 dx = edgeEnd[i][0] - edgeStart[i][0];
+        const csmFloat32 dy = edgeEnd[i][1] - edgeStart[i][1];
+        stepX[i] = -dy;
+        stepY[i] = dx;
+        origin[i] = dy * edgeStart[i][0] - dx * edgeStart[i][1];
+        isOwned[i] = IsOwnedEdge(dx, dy);
+    }
+
+    const csmFloat32 inverseArea = 1.0f / area;
+
+    for (csmInt32 y = minY; y <= maxY; ++y)
+    {
+        const csmFloat32 centerY = y + 0.5f;
+        const csmFloat32 centerX = minX + 0.5f;
+        csmFloat32 e0 = stepX[0] * centerX + stepY[0] * centerY + origin[0];
+        csmFloat32 e1 = stepX[1] * centerX + stepY[1] * centerY + origin[1];
+        csmFloat32 e2 = stepX[2] * centerX + stepY[2] * centerY + origin[2];
+        csmBool wasInside = false;
+
+        for (csmInt32 x = minX; x <= maxX; ++x, e0 += stepX[0], e1 += stepX[1], e2 += stepX[2])
+        {
+            const csmBool isInside = (e0 > 0.0f || (e0 == 0.0f && isOwned[0])) &&
+                                     (e1 > 0.0f || (e1 == 0.0f && isOwned[1])) &&
+                                     (e2 > 0.0f || (e2 == 0.0f && isOwned[2]));
+
+            if (!isInside)
+            {
+                // 三角形は凸なので、一度内側に入った後で外に出たら行の残りは外側
+                if (wasInside)
+                {
+                    break;
+                }
+                continue;
+            }
+            wasInside = true;
+
+            const Vec4 attributes = Add4(Add4(Mul4(a0, Splat4(e0 * inverseArea)), Mul4(a1, Splat4(e1 * inverseArea))), Mul4(a2, Splat4(e2 * inverseArea)));
+            shader.Shade(x, y, attributes);
+        }
+    }
+}
+
+/**
+ * Shades a pixel of an art mesh the same way as the fragment shaders of CubismShader_OpenGLES2,
+ * then blends it into the render target with the blend function of the drawable.
+ *
+ * Attributes are (u, v, mask u, mask v).
+ */
+class DrawShader
+{
+public:
+    DrawShader(const csmUint8* texture, csmInt32 textureWidth, csmInt32 textureHeight,
+               csmUint8* target, csmInt32 targetWidth,
+               CubismRenderer::CubismBlendMode blendMode, csmBool isPremultipliedAlpha,
+               const CubismRenderer::CubismTextureColor& baseColor,
+               const CubismRenderer::CubismTextureColor& multiplyColor,
+               const CubismRenderer::CubismTextureColor& screenColor)
+        : _texture(texture)
+        , _textureWidth(textureWidth)
+        , _textureHeight(textureHeight)
+        , _target(target)
+        , _targetWidth(targetWidth)
+        , _blendMode(blendMode)
+        , _isPremultipliedAlpha(isPremultipliedAlpha)
+        , _baseColor(Set4(baseColor.R, baseColor.G, baseColor.B, baseColor.A))
+        , _multiplyColor(Set4(multiplyColor.R, multiplyColor.G, multiplyColor.B, 1.0f))
+        , _screenColor(Set4(screenColor.R, screenColor.G, screenColor.B, 0.0f))
+        , _colorLanes(Set4(1.0f, 1.0f, 1.0f, 0.0f))
+        , _alphaLane(Set4(0.0f, 0.0f, 0.0f, 1.0f))
+        , _mask(NULL)
+        , _maskWidth(0)
+        , _maskHeight(0)
+        , _channelFlag(Splat4(0.0f))
+        , _isInvertedMask(false)
+    { }
+
+    /// Enables sampling of a clipping mask buffer; channelFlag selects the channel of the mask.
+    void SetMask(const csmUint8* mask, csmInt32 maskWidth, csmInt32 maskHeight,
+                 const CubismRenderer::CubismTextureColor& channelFlag, csmBool isInvertedMask)
+    {
+        _mask = mask;
+        _maskWidth = maskWidth;
+        _maskHeight = maskHeight;
+        _channelFlag = Set4(channelFlag.R, channelFlag.G, channelFlag.B, channelFlag.A);
+        _isInvertedMask = isInvertedMask;
+    }
+
+    void Shade(csmInt32 x, csmInt32 y, Vec4 attributes)
+    {
+        csmFloat32 coordinates[4];
+        Store4(coordinates, attributes);
+
+        // 頂点シェーダと同じくVを反転する
+        const Vec4 texColor = SampleBilinear(_texture, _textureWidth, _textureHeight, coordinates[0], 1.0f - coordinates[1]);
+        Vec4 color = Mul4(texColor, _multiplyColor);
+        Vec4 source;
+
+        if (_isPremultipliedAlpha)
+        {
+            color = Sub4(Add4(color, Mul4(_screenColor, SplatAlpha4(texColor))), Mul4(color, _screenColor));
+            source = Mul4(color, _baseColor);
+        }
+        else
+        {
+            color = Sub4(Add4(color, _screenColor), Mul4(color, _screenColor));
+            color = Mul4(color, _baseColor);
+            source = Mul4(color, Add4(Mul4(SplatAlpha4(color), _colorLanes), _alphaLane));
+        }
+
+        if (_mask != NULL)
+        {
+            // マスクは1が描かれない領域、0が描かれる領域
+            csmFloat32 clip[4];
+            Store4(clip, Mul4(Sub4(Splat4(1.0f), SampleBilinear(_mask, _maskWidth, _maskHeight, coordinates[2], coordinates[3])), _channelFlag));
+            csmFloat32 maskValue = clip[0] + clip[1] + clip[2] + clip[3];
+
+            if (_isInvertedMask)
+            {
+                maskValue = 1.0f - maskValue;
+            }
+
+            source = Mul4(source, Splat4(maskValue));
+        }
+
+        csmUint8* pixel = _target + (static_cast<csmSizeInt>(y) * _targetWidth + x) * 4;
+        const Vec4 destination = LoadPixel(pixel);
+        const Vec4 oneMinusSourceAlpha = Sub4(Splat4(1.0f), SplatAlpha4(source));
+        Vec4 result;
+
+        switch (_blendMode)
+        {
+        case CubismRenderer::CubismBlendMode_Normal:
+        default:
+            // (GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA)
+            result = Add4(source, Mul4(destination, oneMinusSourceAlpha));
+            break;
+
+        case CubismRenderer::CubismBlendMode_Additive:
+            // (GL_ONE, GL_ONE, GL_ZERO, GL_ONE)
+            result = Add4(destination, Mul4(source, _colorLanes));
+            break;
+
+        case CubismRenderer::CubismBlendMode_Multiplicative:
+            // (GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE)
+            result = Mul4(destination, Add4(Mul4(Add4(source, oneMinusSourceAlpha), _colorLanes), _alphaLane));
+            break;
+        }
+
+        StorePixel(pixel, result);
+    }
+
+private:
+    const csmUint8* _texture;
+    csmInt32 _textureWidth;
+    csmInt32 _textureHeight;
+    csmUint8* _target;
+    csmInt32 _targetWidth;
+    CubismRenderer::CubismBlendMode _blendMode;
+    csmBool _isPremultipliedAlpha;
+    Vec4 _baseColor;
+    Vec4 _multiplyColor;        ///< (R, G, B, 1)
+    Vec4 _screenColor;          ///< (R, G, B, 0)
+    Vec4 _colorLanes;           ///< (1, 1, 1, 0)
+    Vec4 _alphaLane;            ///< (0, 0, 0, 1)
+    const csmUint8* _mask;
+    csmInt32 _maskWidth;
+    csmInt32 _maskHeight;
+    Vec4 _channelFlag;
+    csmBool _isInvertedMask;
+};
+
+/**
+ * Writes a mask drawable into one channel of a mask buffer, the same way as the SetupMask shader
+ * with the (GL_ZERO, GL_ONE_MINUS_SRC_COLOR) blend: destination *= 1 - channelFlag * texture alpha.
+ *
+ * Attributes are (u, v, -, -). Pixels outside the layout bounds of the clipping context are left untouched.
+ */
+class MaskShader
+{
+public:
+    MaskShader(const csmUint8* texture, csmInt32 textureWidth, csmInt32 textureHeight,
+               csmUint8* target, csmInt32 targetWidth, csmInt32 targetHeight,
+               const CubismRenderer::CubismTextureColor& channelFlag, const csmRectF& layoutBounds)
+        : _texture(texture)
+        , _textureWidth(textureWidth)
+        , _textureHeight(textureHeight)
+        , _target(target)
+        , _targetWidth(targetWidth)
+        , _channelFlag(Set4(channelFlag.R, channelFlag.G, channelFlag.B, channelFlag.A))
+    {
+        // レイアウトの矩形（テクスチャ座標0..1）をピクセル中心で判定できるようにする
+        _left = layoutBounds.X * targetWidth;
+        _right = layoutBounds.GetRight() * targetWidth;
+        _bottom = layoutBounds.Y * targetHeight;
+        _top = layoutBounds.GetBottom() * targetHeight;
+    }
+
+    void Shade(csmInt32 x, csmInt32 y, Vec4 attributes)
+    {
+        const csmFloat32 centerX = x + 0.5f;
+        const csmFloat32 centerY = y + 0.5f;
+
+        if (centerX < _left || centerX > _right || centerY < _bottom || centerY > _top)
+        {
+            return;
+        }
+
+        csmFloat32 coordinates[4];
+        Store4(coordinates, attributes);
+
+        const Vec4 texColor = SampleBilinear(_texture, _textureWidth, _textureHeight, coordinates[0], 1.0f - coordinates[1]);
+        const Vec4 source = Mul4(_channelFlag, SplatAlpha4(texColor));
+
+        csmUint8* pixel = _target + (static_cast<csmSizeInt>(y) * _targetWidth + x) * 4;
+        StorePixel(pixel, Mul4(LoadPixel(pixel), Sub4(Splat4(1.0f), source)));
+    }
+
+private:
+    const csmUint8* _texture;
+    csmInt32 _textureWidth;
+    csmInt32 _textureHeight;
+    csmUint8* _target;
+    csmInt32 _targetWidth;
+    Vec4 _channelFlag;
+    csmFloat32 _left;
+    csmFloat32 _right;
+    csmFloat32 _bottom;
+    csmFloat32 _top;
+};
+
+/// Rasterizes every triangle of a drawable into the rows [rowBegin, rowEnd).
+template <class T_Shader>
+void RasterizeDrawable(const CubismModel& model, csmInt32 drawableIndex, const csmFloat32* vertices,
+                       csmInt32 width, csmInt32 rowBegin, csmInt32 rowEnd, csmFloat32 frontSign, T_Shader& shader)
+{
+    const csmInt32 indexCount = model.GetDrawableVertexIndexCount(drawableIndex);
+    const csmUint16* indices = model.GetDrawableVertexIndices(drawableIndex);
+    const Core::csmVector2* uvs = model.GetDrawableVertexUvs(drawableIndex);
+
+    for (csmInt32 i = 0; i + 2 < indexCount; i += 3)
+    {
+        const csmInt32 i0 = indices[i];
+        const csmInt32 i1 = indices[i + 1];
+        const csmInt32 i2 = indices[i + 2];
+        const csmFloat32* v0 = vertices + i0 * 4;
+        const csmFloat32* v1 = vertices + i1 * 4;
+        const csmFloat32* v2 = vertices + i2 * 4;
+
+        RasterizeTriangle(v0, v1, v2,
+                          Set4(uvs[i0].X, uvs[i0].Y, v0[2], v0[3]),
+                          Set4(uvs[i1].X, uvs[i1].Y, v1[2], v1[3]),
+                          Set4(uvs[i2].X, uvs[i2].Y, v2[2], v2[3]),
+                          width, rowBegin, rowEnd, frontSign, shader);
+    }
+}
+
+}
+
+/*********************************************************************************************************************
+*                                      CubismOffscreenSurface_Software
+********************************************************************************************************************/
+CubismOffscreenSurface_Software::CubismOffscreenSurface_Software()
+    : _pixels(NULL)
+    , _bufferWidth(0)
+    , _bufferHeight(0)
+{
+}
+
+CubismOffscreenSurface_Software::~CubismOffscreenSurface_Software()
+{
+    DestroyOffscreenSurface();
+}
+
+csmBool CubismOffscreenSurface_Software::CreateOffscreenSurface(csmUint32 width, csmUint32 height)
+{
+    DestroyOffscreenSurface();
+
+    if (width == 0 || height == 0)
+    {
+        return false;
+    }
+
+    _pixels = static_cast<csmUint8*>(CSM_MALLOC(static_cast<csmSizeType>(width) * height * 4));
+    if (_pixels == NULL)
+    {
+        return false;
+    }
+
+    _bufferWidth = width;
+    _bufferHeight = height;
+
+    return true;
+}
+
+void CubismOffscreenSurface_Software::DestroyOffscreenSurface()
+{
+    if (_pixels != NULL)
+    {
+        CSM_FREE(_pixels);
+        _pixels = NULL;
+    }
+
+    _bufferWidth = 0;
+    _bufferHeight = 0;
+}
+
+void CubismOffscreenSurface_Software::Clear(csmFloat32 r, csmFloat32 g, csmFloat32 b, csmFloat32 a)
+{
+    if (_pixels == NULL)
+    {
+        return;
+    }
+
+    csmUint8 color[4];
+    StorePixel(color, Set4(r, g, b, a));
+
+    const csmSizeType pixelCount = static_cast<csmSizeType>(_bufferWidth) * _bufferHeight;
+    for (csmSizeType i = 0; i < pixelCount; ++i)
+    {
+        memcpy(_pixels + i * 4, color, 4);
+    }
+}
+
+csmUint8* CubismOffscreenSurface_Software::GetPixels()
+{
+    return _pixels;
+}
+
+const csmUint8* CubismOffscreenSurface_Software::GetPixels() const
+{
+    return _pixels;
+}
+
+csmUint32 CubismOffscreenSurface_Software::GetBufferWidth() const
+{
+    return _bufferWidth;
+}
+
+csmUint32 CubismOffscreenSurface_Software::GetBufferHeight() const
+{
+    return _bufferHeight;
+}
+
+csmBool CubismOffscreenSurface_Software::IsValid() const
+{
+    return _pixels != NULL;
+}
+
+/*********************************************************************************************************************
+*                                      CubismClippingContext_Software
+********************************************************************************************************************/
+CubismClippingContext_Software::CubismClippingContext_Software(CubismClippingManager<CubismClippingContext_Software, CubismOffscreenSurface_Software>* manager, CubismModel& model, const csmInt32* clippingDrawableIndices, csmInt32 clipCount)
+    : CubismClippingContext(clippingDrawableIndices, clipCount)
+{
+    // CubismClippingManagerから共通の引数で生成されるが、CPU描画ではモデルを参照しない
+    (void)model;
+    _owner = manager;
+}
+
+CubismClippingContext_Software::~CubismClippingContext_Software()
+{
+}
+
+CubismClippingManager<CubismClippingContext_Software, CubismOffscreenSurface_Software>* CubismClippingContext_Software::GetClippingManager()
+{
+    return _owner;
+}
+
+/*********************************************************************************************************************
+ *                                      CubismRenderer_Software
+ ********************************************************************************************************************/
+CubismRenderer_Software* CubismRenderer_Software::Create()
+{
+    return CSM_NEW CubismRenderer_Software();
+}
+
+CubismRenderer_Software::CubismRenderer_Software() : _clippingManager(NULL)
+                                                   , _renderTarget(NULL)
+                                                   , _parallelFor(NULL)
+                                                   , _maskBandCount(0)
+                                                   , _targetBandCount(0)
+{
+    // テクスチャ対応マップの容量を確保しておく.
+    _textures.PrepareCapacity(32, true);
+}
+
+CubismRenderer_Software::~CubismRenderer_Software()
+{
+    ReleaseClippingMask();
+}
+
+void CubismRenderer_Software::ReleaseClippingMask()
+{
+    CSM_DELETE_SELF(CubismClippingManager_Software, _clippingManager);
+    _clippingManager = NULL;
+
+    for (csmUint32 i = 0; i < _maskBuffers.GetSize(); ++i)
+    {
+        CSM_DELETE_SELF(CubismOffscreenSurface_Software, _maskBuffers[i]);
+    }
+    _maskBuffers.Clear();
+}
+
+void CubismRenderer_Software::Initialize(CubismModel* model)
+{
+    Initialize(model, 1);
+}
+
+void CubismRenderer_Software::Initialize(CubismModel* model, csmInt32 maskBufferCount)
+{
+    // 1未満は1に補正する
+    if (maskBufferCount < 1)
+    {
+        maskBufferCount = 1;
+        CubismLogWarning("The number of render textures must be an integer greater than or equal to 1. Set the number of render textures to 1.");
+    }
+
+    if (model->IsUsingMasking())
+    {
+        _clippingManager = CSM_NEW CubismClippingManager_Software();  //クリッピングマスク・バッファ前処理方式を初期化
+        _clippingManager->Initialize(
+            *model,
+            maskBufferCount
+        );
+
+        for (csmInt32 i = 0; i < maskBufferCount; ++i)
+        {
+            CubismOffscreenSurface_Software* maskBuffer = CSM_NEW CubismOffscreenSurface_Software();
+            maskBuffer->CreateOffscreenSurface(static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().X), static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().Y));
+            _maskBuffers.PushBack(maskBuffer);
+        }
+    }
+
+    _sortedDrawableIndexList.Resize(model->GetDrawableCount(), 0);
+
+    CubismRenderer::Initialize(model, maskBufferCount);  //親クラスの処理を呼ぶ
+}
+
+void CubismRenderer_Software::DoDrawModel()
+{
+    CSM_PROFILE_ZONE("DoDrawModel");
+
+    if (_renderTarget == NULL || !_renderTarget->IsValid())
+    {
+        CubismLogWarning("The render target of the software renderer is not set.");
+        return;
+    }
+
+    _vertexBuffer.Clear();
+
+    //------------ クリッピングマスク・バッファ前処理方式の場合 ------------
+    if (_clippingManager != NULL)
+    {
+        // サイズが違う場合はここで作成しなおし
+        const csmUint32 maskWidth = static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().X);
+        const csmUint32 maskHeight = static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize().Y);
+        for (csmInt32 i = 0; i < _clippingManager->GetRenderTextureCount(); ++i)
+        {
+            if (_maskBuffers[i]->GetBufferWidth() != maskWidth || _maskBuffers[i]->GetBufferHeight() != maskHeight)
+            {
+                _maskBuffers[i]->CreateOffscreenSurface(maskWidth, maskHeight);
+            }
+        }
+
+        if (SetupMaskCommands())
+        {
+            CSM_PROFILE_COUNTER_ADD(Counter_MaskRedraws, _maskCommands.GetSize());
+
+            _maskBandCount = (static_cast<csmInt32>(maskHeight) + BandHeight - 1) / BandHeight;
+            RunTasks(_clippingManager->GetRenderTextureCount() * _maskBandCount, &DrawMaskBand);
+        }
+    }
+
+    SetupDrawCommands();
+
+    CSM_PROFILE_COUNTER_ADD(Counter_DrawCalls, _drawCommands.GetSize());
+
+    _targetBandCount = (static_cast<csmInt32>(_renderTarget->GetBufferHeight()) + BandHeight - 1) / BandHeight;
+    RunTasks(_targetBandCount, &DrawTargetBand);
+}
+
+csmBool CubismRenderer_Software::SetupMaskCommands()
+{
+    _maskCommands.Clear();
+
+    if (_clippingManager->SetupClippingLayout(*GetModel()) <= 0)
+    {
+        return false;
+    }
+
+    csmVector<CubismClippingContext_Software*>* clipContexts = _clippingManager->GetClippingContextListForMask();
+    for (csmUint32 clipIndex = 0; clipIndex < clipContexts->GetSize(); ++clipIndex)
+    {
+        CubismClippingContext_Software* clipContext = (*clipContexts)[clipIndex];
+
+        if (!clipContext->_isUsing)
+        {
+            continue;
+        }
+
+        for (csmInt32 i = 0; i < clipContext->_clippingIdCount; ++i)
+        {
+            const csmInt32 clipDrawIndex = clipContext->_clippingIdList[i];
+
+            // 頂点情報が更新されておらず、信頼性がない場合は描画をパスする
+            if (!GetModel()->GetDrawableDynamicFlagVertexPositionsDidChange(clipDrawIndex))
+            {
+                continue;
+            }
+
+            AddDrawCommand(_maskCommands, clipDrawIndex, clipContext, true);
+        }
+    }
+
+    return true;
+}
+
+void CubismRenderer_Software::SetupDrawCommands()
+{
+    _drawCommands.Clear();
+
+    const csmInt32 drawableCount = GetModel()->GetDrawableCount();
+    const csmInt32* renderOrder = GetModel()->GetDrawableRenderOrders();
+
+    // インデックスを描画順でソート
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        const csmInt32 order = renderOrder[i];
+        _sortedDrawableIndexList[order] = i;
+    }
+
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        const csmInt32 drawableIndex = _sortedDrawableIndexList[i];
+
+        // Drawableが表示状態でなければ処理をパスする
+        if (!GetModel()->GetDrawableDynamicFlagIsVisible(drawableIndex))
+        {
+            continue;
+        }
+
+        // クリッピングマスク
+        CubismClippingContext_Software* clipContext = (_clippingManager != NULL)
+            ? (*_clippingManager->GetClippingContextListForDraw())[drawableIndex]
+            : NULL;
+
+        AddDrawCommand(_drawCommands, drawableIndex, clipContext, false);
+    }
+}
+
+void CubismRenderer_Software::AddDrawCommand(csmVector<DrawCommand>& commands, csmInt32 drawableIndex, CubismClippingContext_Software* clipContext, csmBool isMask)
+{
+    const CubismModel* model = GetModel();
+    const csmInt32 textureIndex = model->GetDrawableTextureIndex(drawableIndex);
+
+    // モデルが参照するテクスチャが設定されていない場合は描画をスキップする
+    if (!_textures.IsExist(textureIndex) || _textures[textureIndex].Pixels == NULL)
+    {
+        return;
+    }
+
+    const csmInt32 vertexCount = model->GetDrawableVertexCount(drawableIndex);
+    const csmFloat32* positions = model->GetDrawableVertices(drawableIndex);
+    const csmInt32 vertexOffset = static_cast<csmInt32>(_vertexBuffer.GetSize());
+    _vertexBuffer.UpdateSize(vertexOffset + vertexCount * 4, 0.0f, false);
+
+    // マスクはY軸が上向きのまま、描画先は上の行から並べるためY軸を反転してピクセル座標にする
+    CubismMatrix44 mvpMatrix = GetMvpMatrix();
+    const csmFloat32* matrix;
+    csmFloat32 width;
+    csmFloat32 height;
+    csmFloat32 flipY;
+    if (isMask)
+    {
+        matrix = clipContext->_matrixForMask.GetArray();
+        width = static_cast<csmFloat32>(_maskBuffers[clipContext->_bufferIndex]->GetBufferWidth());
+        height = static_cast<csmFloat32>(_maskBuffers[clipContext->_bufferIndex]->GetBufferHeight());
+        flipY = 1.0f;
+    }
+    else
+    {
+        matrix = mvpMatrix.GetArray();
+        width = static_cast<csmFloat32>(_renderTarget->GetBufferWidth());
+        height = static_cast<csmFloat32>(_renderTarget->GetBufferHeight());
+        flipY = -1.0f;
+    }
+
+    const csmFloat32* clipMatrix = (!isMask && clipContext != NULL) ? clipContext->_matrixForDraw.GetArray() : NULL;
+    csmFloat32* vertices = _vertexBuffer.GetPtr() + vertexOffset;
+    csmFloat32 minY = FLT_MAX;
+    csmFloat32 maxY = -FLT_MAX;
+
+    for (csmInt32 i = 0; i < vertexCount; ++i)
+    {
+        const csmFloat32 x = positions[i * 2];
+        const csmFloat32 y = positions[i * 2 + 1];
+        const csmFloat32 w = matrix[3] * x + matrix[7] * y + matrix[15];
+        const csmFloat32 ndcX = (matrix[0] * x + matrix[4] * y + matrix[12]) / w;
+        const csmFloat32 ndcY = (matrix[1] * x + matrix[5] * y + matrix[13]) / w;
+
+        csmFloat32* vertex = vertices + i * 4;
+        vertex[0] = (ndcX * 0.5f + 0.5f) * width;
+        vertex[1] = (ndcY * 0.5f * flipY + 0.5f) * height;
+
+        // マスクのテクスチャ座標（0..1）
+        if (clipMatrix != NULL)
+        {
+            const csmFloat32 clipW = clipMatrix[3] * x + clipMatrix[7] * y + clipMatrix[15];
+            vertex[2] = (clipMatrix[0] * x + clipMatrix[4] * y + clipMatrix[12]) / clipW;
+            vertex[3] = (clipMatrix[1] * x + clipMatrix[5] * y + clipMatrix[13]) / clipW;
+        }
+        else
+        {
+            vertex[2] = 0.0f;
+            vertex[3] = 0.0f;
+        }
+
+        minY = (vertex[1] < minY) ? vertex[1] : minY;
+        maxY = (vertex[1] > maxY) ? vertex[1] : maxY;
+    }
+
+    DrawCommand command;
+    command.DrawableIndex = drawableIndex;
+    command.VertexOffset = vertexOffset;
+    command.Texture = &_textures[textureIndex];
+    command.ClipContext = clipContext;
+    command.IsCulling = (model->GetDrawableCulling(drawableIndex) != 0);
+    command.MinY = minY;
+    command.MaxY = maxY;
+    commands.PushBack(command);
+}
+
+void CubismRenderer_Software::RunTasks(csmInt32 count, TaskFunction task)
+{
+    if (_parallelFor != NULL && count > 1)
+    {
+        _parallelFor(count, this, task);
+        return;
+    }
+
+    for (csmInt32 i = 0; i < count; ++i)
+    {
+        task(this, i);
+    }
+}
+
+void CubismRenderer_Software::DrawMaskBand(void* context, csmInt32 index)
+{
+    CubismRenderer_Software* renderer = static_cast<CubismRenderer_Software*>(context);
+    const CubismModel& model = *renderer->GetModel();
+    const csmInt32 bufferIndex = index / renderer->_maskBandCount;
+    const csmInt32 bandIndex = index % renderer->_maskBandCount;
+
+    CubismOffscreenSurface_Software* maskBuffer = renderer->_maskBuffers[bufferIndex];
+    const csmInt32 width = static_cast<csmInt32>(maskBuffer->GetBufferWidth());
+    const csmInt32 height = static_cast<csmInt32>(maskBuffer->GetBufferHeight());
+    const csmInt32 rowBegin = bandIndex * BandHeight;
+    const csmInt32 rowEnd = (rowBegin + BandHeight < height) ? rowBegin + BandHeight : height;
+
+    // 1が無効（描かれない）領域、0が有効（描かれる）領域
+    memset(maskBuffer->GetPixels() + static_cast<csmSizeInt>(rowBegin) * width * 4, 0xFF, static_cast<csmSizeInt>(rowEnd - rowBegin) * width * 4);
+
+    for (csmUint32 i = 0; i < renderer->_maskCommands.GetSize(); ++i)
+    {
+        const DrawCommand& command = renderer->_maskCommands[i];
+        CubismClippingContext_Software* clipContext = command.ClipContext;
+
+        if (clipContext->_bufferIndex != bufferIndex || command.MaxY < rowBegin || command.MinY > rowEnd)
+        {
+            continue;
+        }
+
+        MaskShader shader(command.Texture->Pixels, command.Texture->Width, command.Texture->Height,
+                          maskBuffer->GetPixels(), width, height,
+                          *clipContext->GetClippingManager()->GetChannelFlagAsColor(clipContext->_layoutChannelIndex),
+                          *clipContext->_layoutBounds);
+
+        // マスクはY軸が上向きなので、表面（CCW）は符号付き面積が正
+        RasterizeDrawable(model, command.DrawableIndex, renderer->_vertexBuffer.GetPtr() + command.VertexOffset,
+                          width, rowBegin, rowEnd, command.IsCulling ? 1.0f : 0.0f, shader);
+    }
+}
+
+void CubismRenderer_Software::DrawTargetBand(void* context, csmInt32 bandIndex)
+{
+    CubismRenderer_Software* renderer = static_cast<CubismRenderer_Software*>(context);
+    const CubismModel& model = *renderer->GetModel();
+
+    CubismOffscreenSurface_Software* target = renderer->_renderTarget;
+    const csmInt32 width = static_cast<csmInt32>(target->GetBufferWidth());
+    const csmInt32 height = static_cast<csmInt32>(target->GetBufferHeight());
+    const csmInt32 rowBegin = bandIndex * BandHeight;
+    const csmInt32 rowEnd = (rowBegin + BandHeight < height) ? rowBegin + BandHeight : height;
+
+    for (csmUint32 i = 0; i < renderer->_drawCommands.GetSize(); ++i)
+    {
+        const DrawCommand& command = renderer->_drawCommands[i];
+
+        if (command.MaxY < rowBegin || command.MinY > rowEnd)
+        {
+            continue;
+        }
+
+        const csmInt32 drawableIndex = command.DrawableIndex;
+        DrawShader shader(command.Texture->Pixels, command.Texture->Width, command.Texture->Height,
+                          target->GetPixels(), width,
+                          model.GetDrawableBlendMode(drawableIndex), renderer->IsPremultipliedAlpha(),
+                          renderer->GetModelColorWithOpacity(model.GetDrawableOpacity(drawableIndex)),
+                          model.GetMultiplyColor(drawableIndex),
+                          model.GetScreenColor(drawableIndex));
+
+        CubismClippingContext_Software* clipContext = command.ClipContext;
+        if (clipContext != NULL)
+        {
+            CubismOffscreenSurface_Software* maskBuffer = renderer->_maskBuffers[clipContext->_bufferIndex];
+            shader.SetMask(maskBuffer->GetPixels(), static_cast<csmInt32>(maskBuffer->GetBufferWidth()), static_cast<csmInt32>(maskBuffer->GetBufferHeight()),
+                           *clipContext->GetClippingManager()->GetChannelFlagAsColor(clipContext->_layoutChannelIndex),
+                           model.GetDrawableInvertedMask(drawableIndex));
+        }
+
+        // 描画先はY軸が下向きなので、表面（CCW）は符号付き面積が負
+        RasterizeDrawable(model, drawableIndex, renderer->_vertexBuffer.GetPtr() + command.VertexOffset,
+                          width, rowBegin, rowEnd, command.IsCulling ? -1.0f : 0.0f, shader);
+    }
+}
+
+void CubismRenderer_Software::SaveProfile()
+{
+}
+
+void CubismRenderer_Software::RestoreProfile()
+{
+}
+
+void CubismRenderer_Software::BindTexture(csmUint32 modelTextureIndex, const csmUint8* pixels, csmUint32 width, csmUint32 height)
+{
+    TextureData& texture = _textures[modelTextureIndex];
+    texture.Pixels = pixels;
+    texture.Width = static_cast<csmInt32>(width);
+    texture.Height = static_cast<csmInt32>(height);
+}
+
+void CubismRenderer_Software::SetRenderTarget(CubismOffscreenSurface_Software* target)
+{
+    _renderTarget = target;
+}
+
+void CubismRenderer_Software::SetParallelFor(ParallelForFunction parallelFor)
+{
+    _parallelFor = parallelFor;
+}
+
+void CubismRenderer_Software::SetClippingMaskBufferSize(csmFloat32 width, csmFloat32 height)
+{
+    if (_clippingManager == NULL)
+    {
+        return;
+    }
+
+    // インスタンス破棄前にレンダーテクスチャの数を保存
+    const csmInt32 renderTextureCount = _clippingManager->GetRenderTextureCount();
+
+    // マスクのバッファは次回の描画で作り直す
+    CSM_DELETE_SELF(CubismClippingManager_Software, _clippingManager);
+
+    _clippingManager = CSM_NEW CubismClippingManager_Software();
+
+    _clippingManager->SetClippingMaskBufferSize(width, height);
+
+    _clippingManager->Initialize(
+        *GetModel(),
+        renderTextureCount
+    );
+}
+
+csmInt32 CubismRenderer_Software::GetRenderTextureCount() const
+{
+    return _clippingManager->GetRenderTextureCount();
+}
+
+CubismVector2 CubismRenderer_Software::GetClippingMaskBufferSize() const
+{
+    return _clippingManager->GetClippingMaskBufferSize();
+}
+
+CubismOffscreenSurface_Software* CubismRenderer_Software::GetMaskBuffer(csmInt32 index)
+{
+    return _maskBuffers[index];
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,392 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismRenderer.hpp"
+#include "CubismClippingManager.hpp"
+#include "CubismFramework.hpp"
+#include "csmVector.hpp"
+#include "csmRectF.hpp"
+#include "CubismVector2.hpp"
+#include "csmMap.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+//  前方宣言
+class CubismRenderer_Software;
+class CubismClippingContext_Software;
+
+/**
+ * @brief  CPUで描画するRGBA8のバッファ
+ *
+ * 1ピクセル4バイト（R, G, B, A）で、行の間に隙間は無い。
+ */
+class CubismOffscreenSurface_Software
+{
+public:
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismOffscreenSurface_Software();
+
+    /**
+     * @brief   デストラクタ
+     */
+    ~CubismOffscreenSurface_Software();
+
+    /**
+     * @brief   バッファを作成する。既に作成済みの場合は作り直す
+     *
+     * @param[in]   width   ->  バッファの幅[px]
+     * @param[in]   height  ->  バッファの高さ[px]
+     *
+     * @return  作成できた場合はtrue
+     */
+    csmBool CreateOffscreenSurface(csmUint32 width, csmUint32 height);
+
+    /**
+     * @brief   バッファを破棄する
+     */
+    void DestroyOffscreenSurface();
+
+    /**
+     * @brief   バッファを指定の色でクリアする
+     *
+     * @param[in]   r   ->  赤(0.0~1.0)
+     * @param[in]   g   ->  緑(0.0~1.0)
+     * @param[in]   b   ->  青(0.0~1.0)
+     * @param[in]   a   ->  α(0.0~1.0)
+     */
+    void Clear(csmFloat32 r, csmFloat32 g, csmFloat32 b, csmFloat32 a);
+
+    /**
+     * @brief   ピクセルの先頭アドレスを取得する
+     */
+    csmUint8* GetPixels();
+
+    /**
+     * @brief   ピクセルの先頭アドレスを取得する
+     */
+    const csmUint8* GetPixels() const;
+
+    /**
+     * @brief   バッファ幅取得
+     */
+    csmUint32 GetBufferWidth() const;
+
+    /**
+     * @brief   バッファ高さ取得
+     */
+    csmUint32 GetBufferHeight() const;
+
+    /**
+     * @brief   現在有効かどうか
+     */
+    csmBool IsValid() const;
+
+private:
+    // Prevention of copy Constructor
+    CubismOffscreenSurface_Software(const CubismOffscreenSurface_Software&);
+    CubismOffscreenSurface_Software& operator=(const CubismOffscreenSurface_Software&);
+
+    csmUint8*   _pixels;                ///< ピクセル
+    csmUint32   _bufferWidth;           ///< Create時に指定された幅
+    csmUint32   _bufferHeight;          ///< Create時に指定された高さ
+};
+
+/**
+ * @brief  クリッピングマスクの処理を実行するクラス<br>
+ *         レイアウトと行列はSetupClippingLayoutで計算し、マスクの描画はレンダラがまとめて行う。
+ *
+ */
+class CubismClippingManager_Software : public CubismClippingManager<CubismClippingContext_Software, CubismOffscreenSurface_Software>
+{
+};
+
+/**
+ * @brief   クリッピングマスクのコンテキスト
+ */
+class CubismClippingContext_Software : public CubismClippingContext
+{
+    friend class CubismClippingManager_Software;
+    friend class CubismRenderer_Software;
+
+public:
+    /**
+     * @brief   引数付きコンストラクタ
+     *
+     */
+    CubismClippingContext_Software(CubismClippingManager<CubismClippingContext_Software, CubismOffscreenSurface_Software>* manager, CubismModel& model, const csmInt32* clippingDrawableIndices, csmInt32 clipCount);
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismClippingContext_Software();
+
+    /**
+     * @brief   このマスクを管理するマネージャのインスタンスを取得する。
+     *
+     * @return  クリッピングマネージャのインスタンス
+     */
+    CubismClippingManager<CubismClippingContext_Software, CubismOffscreenSurface_Software>* GetClippingManager();
+
+    CubismClippingManager<CubismClippingContext_Software, CubismOffscreenSurface_Software>* _owner;        ///< このマスクを管理しているマネージャのインスタンス
+};
+
+/**
+ * @brief   CPUでモデルを描画するレンダラ
+ *
+ * GLコンテキストの無い環境でサムネイル等を生成するためのレンダラ。
+ * CubismRenderer_OpenGLES2のシェーダと同じ計算で、通常・加算・乗算の各ブレンド、乗算済みα、
+ * 乗算色・スクリーン色、クリッピングマスク（反転を含む）を再現する。
+ * テクスチャの縮小はミップマップを使わずバイリニア補間のみで行う。
+ * 高精細マスクには対応せず、UseHighPrecisionMaskの設定によらず通常のマスクで描画する。
+ *
+ * 描画先は行ごとの帯に分け、SetParallelForで渡した並列実行関数で帯ごとに並列に描画する。
+ * 帯は互いに重ならず、帯の中では描画順を守るため、結果は並列実行の有無によらず同じになる。
+ */
+class CubismRenderer_Software : public CubismRenderer
+{
+    friend class CubismClippingManager_Software;
+
+public:
+    /**
+     * @brief 並列実行するタスクの関数
+     *
+     * @param[in]   context     ParallelForFunctionに渡されたコンテキスト
+     * @param[in]   index       タスクの番号
+     */
+    typedef void (*TaskFunction)(void* context, csmInt32 index);
+
+    /**
+     * @brief 並列実行関数
+     *
+     * taskをindexが0〜count-1のそれぞれについて1回ずつ呼び出し、全ての呼び出しが完了してから戻ること。
+     * 呼び出し順序やスレッドは問わない。CubismPhysics::ParallelForFunctionと同じ形式。
+     *
+     * @param[in]   count       タスクの数
+     * @param[in]   context     taskに渡すコンテキスト
+     * @param[in]   task        タスクの関数
+     */
+    typedef void (*ParallelForFunction)(csmInt32 count, void* context, TaskFunction task);
+
+    /**
+     * @brief   レンダラを作成する<br>
+     *           CubismRenderer::Createは環境ごとのレンダラを作成するため、CPUで描画する場合はこちらを使う。
+     *           破棄はCubismRenderer::Deleteで行う。
+     *
+     * @return  レンダラのインスタンス
+     */
+    static CubismRenderer_Software* Create();
+
+    /**
+     * @brief    レンダラの初期化処理を実行する<br>
+     *           引数に渡したモデルからレンダラの初期化処理に必要な情報を取り出すことができる
+     *
+     * @param[in]  model -> モデルのインスタンス
+     */
+    void Initialize(Framework::CubismModel* model);
+
+    void Initialize(Framework::CubismModel* model, csmInt32 maskBufferCount);
+
+    /**
+     * @brief   テクスチャを設定する<br>
+     *           ピクセルは呼び出し側が保持し、描画が終わるまで解放しないこと。
+     *
+     * @param[in]   modelTextureIndex  ->  セットするモデルテクスチャの番号
+     * @param[in]   pixels             ->  RGBA8のピクセル。上の行から順に並べる
+     * @param[in]   width              ->  テクスチャの幅[px]
+     * @param[in]   height             ->  テクスチャの高さ[px]
+     */
+    void BindTexture(csmUint32 modelTextureIndex, const csmUint8* pixels, csmUint32 width, csmUint32 height);
+
+    /**
+     * @brief   描画先を設定する<br>
+     *           描画先全体をビューポートとして、上の行から順に描画する。結果は乗算済みαになる。
+     *           描画前のクリアは行わないため、必要であれば呼び出し側でクリアする。
+     *
+     * @param[in]   target  ->  描画先のバッファ
+     */
+    void SetRenderTarget(CubismOffscreenSurface_Software* target);
+
+    /**
+     * @brief   並列実行関数を設定する
+     *
+     * @param[in]   parallelFor     並列実行関数。NULLの場合は逐次実行
+     */
+    void SetParallelFor(ParallelForFunction parallelFor);
+
+    /**
+     * @brief  クリッピングマスクバッファのサイズを設定する<br>
+     *         マスク用のバッファを破棄・再作成するため処理コストは高い。
+     *
+     * @param[in]  size -> クリッピングマスクバッファのサイズ
+     *
+     */
+    void SetClippingMaskBufferSize(csmFloat32 width, csmFloat32 height);
+
+    /**
+     * @brief  レンダーテクスチャの枚数を取得する。
+     *
+     * @return  レンダーテクスチャの枚数
+     *
+     */
+    csmInt32 GetRenderTextureCount() const;
+
+    /**
+     * @brief  クリッピングマスクバッファのサイズを取得する
+     *
+     * @return クリッピングマスクバッファのサイズ
+     *
+     */
+    CubismVector2 GetClippingMaskBufferSize() const;
+
+    /**
+     * @brief  クリッピングマスクのバッファを取得する
+     *
+     * @return クリッピングマスクのバッファへのポインタ
+     *
+     */
+    CubismOffscreenSurface_Software* GetMaskBuffer(csmInt32 index);
+
+protected:
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismRenderer_Software();
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismRenderer_Software();
+
+    /**
+     * @brief   モデルを描画する実際の処理
+     *
+     */
+    virtual void DoDrawModel() override;
+
+private:
+    /**
+     * @brief   描画するテクスチャ
+     */
+    struct TextureData
+    {
+        TextureData()
+            : Pixels(NULL)
+            , Width(0)
+            , Height(0)
+        { }
+
+        const csmUint8* Pixels;     ///< RGBA8のピクセル
+        csmInt32 Width;             ///< 幅[px]
+        csmInt32 Height;            ///< 高さ[px]
+    };
+
+    /**
+     * @brief   1つの描画オブジェクトの描画命令
+     *
+     * 頂点は描画先（またはマスク）のピクセル座標に変換済みのものを_vertexBufferに格納する。
+     */
+    struct DrawCommand
+    {
+        csmInt32 DrawableIndex;                         ///< 描画オブジェクトのインデックス
+        csmInt32 VertexOffset;                          ///< _vertexBuffer内の先頭の位置
+        const TextureData* Texture;                     ///< 描画オブジェクトのテクスチャ
+        CubismClippingContext_Software* ClipContext;    ///< クリッピングマスク。マスク生成時は描画先のマスク
+        csmBool IsCulling;                              ///< 裏面を描画しないかどうか
+        csmFloat32 MinY;                                ///< 頂点の最小のY座標[px]。帯と重ならない描画命令を飛ばすのに使う
+        csmFloat32 MaxY;                                ///< 頂点の最大のY座標[px]
+    };
+
+    // Prevention of copy Constructor
+    CubismRenderer_Software(const CubismRenderer_Software&);
+    CubismRenderer_Software& operator=(const CubismRenderer_Software&);
+
+    /**
+     * @brief   クリッピングマスク管理オブジェクトとマスク用のバッファを解放する
+     */
+    void ReleaseClippingMask();
+
+    /**
+     * @brief   モデル描画直前のステートを保持する。CPU描画では保持するステートが無い
+     */
+    virtual void SaveProfile();
+
+    /**
+     * @brief   モデル描画直前のステートを復帰させる。CPU描画では復帰するステートが無い
+     */
+    virtual void RestoreProfile();
+
+    /**
+     * @brief   マスク生成の描画命令を作成する
+     *
+     * @return  描画するマスクがある場合はtrue
+     */
+    csmBool SetupMaskCommands();
+
+    /**
+     * @brief   画面描画の描画命令を作成する
+     */
+    void SetupDrawCommands();
+
+    /**
+     * @brief   描画命令を追加し、頂点を変換して_vertexBufferに格納する
+     *
+     * @param[out]  commands        ->  追加先の描画命令のリスト
+     * @param[in]   drawableIndex   ->  描画オブジェクトのインデックス
+     * @param[in]   clipContext     ->  クリッピングマスク
+     * @param[in]   isMask          ->  マスク生成の描画命令かどうか
+     */
+    void AddDrawCommand(csmVector<DrawCommand>& commands, csmInt32 drawableIndex, CubismClippingContext_Software* clipContext, csmBool isMask);
+
+    /**
+     * @brief   帯の数に応じてタスクを並列実行する
+     *
+     * @param[in]   count   ->  タスクの数
+     * @param[in]   task    ->  タスクの関数
+     */
+    void RunTasks(csmInt32 count, TaskFunction task);
+
+    /**
+     * @brief   マスクの帯を描画する
+     *
+     * ParallelForFunctionから呼び出される。indexはマスクバッファの番号と帯の番号を合わせたもの。
+     *
+     * @param[in]   context     レンダラ
+     * @param[in]   index       タスクの番号
+     */
+    static void DrawMaskBand(void* context, csmInt32 index);
+
+    /**
+     * @brief   描画先の帯を描画する
+     *
+     * ParallelForFunctionから呼び出される。
+     *
+     * @param[in]   context     レンダラ
+     * @param[in]   bandIndex   帯の番号
+     */
+    static void DrawTargetBand(void* context, csmInt32 bandIndex);
+
+    csmMap<csmInt32, TextureData> _textures;                     ///< モデルが参照するテクスチャ
+    csmVector<csmInt32> _sortedDrawableIndexList;               ///< 描画オブジェクトのインデックスを描画順に並べたリスト
+    CubismClippingManager_Software* _clippingManager;           ///< クリッピングマスク管理オブジェクト
+    csmVector<CubismOffscreenSurface_Software*> _maskBuffers;  ///< マスク描画用のバッファ
+    CubismOffscreenSurface_Software* _renderTarget;             ///< 描画先のバッファ
+    ParallelForFunction _parallelFor;                           ///< 並列実行関数。NULLの場合は逐次実行
+
+    csmVector<DrawCommand> _maskCommands;                       ///< マスク生成の描画命令
+    csmVector<DrawCommand> _drawCommands;                       ///< 画面描画の描画命令
+    csmVector<csmFloat32> _vertexBuffer;                        ///< 変換済みの頂点（x, y, マスクのx, マスクのyの順）
+    csmInt32 _maskBandCount;                                    ///< マスクバッファ1枚あたりの帯の数
+    csmInt32 _targetBandCount;                                  ///< 描画先の帯の数
+};
+
+}}}}
+//------------ LIVE2D NAMESPACE ------------
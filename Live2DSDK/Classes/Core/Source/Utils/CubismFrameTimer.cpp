@@ -0,0 +1,199 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismFrameTimer.hpp"
+#include <math.h>
+#include <chrono>
+
+namespace Live2D { namespace Cubism { namespace Framework {
+
+CubismFrameTimer::CubismFrameTimer()
+    : _fixedDeltaTime(1.0f / 60.0f)
+    , _maxFrameDeltaTime(0.25f)
+    , _maxStepCount(4)
+    , _hitchThreshold(0.05f)
+{
+    Reset();
+}
+
+void CubismFrameTimer::Reset()
+{
+    _lastTime = 0;
+    _isTicked = false;
+    _frameDeltaTime = 0.0f;
+    _accumulator = 0.0f;
+    _stepCount = 0;
+    _frameCount = 0;
+    _hitchCount = 0;
+
+    for (csmInt32 i = 0; i < FrameTimeSampleCount; ++i)
+    {
+        _frameTimes[i] = 0.0f;
+    }
+}
+
+csmUint64 CubismFrameTimer::GetMonotonicTimeNanoseconds()
+{
+    return static_cast<csmUint64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+    );
+}
+
+void CubismFrameTimer::Tick()
+{
+    const csmUint64 now = GetMonotonicTimeNanoseconds();
+    csmFloat32 frameDeltaSeconds = 0.0f;
+
+    if (_isTicked)
+    {
+        frameDeltaSeconds = static_cast<csmFloat32>(static_cast<double>(now - _lastTime) * 1.0e-9);
+    }
+
+    _lastTime = now;
+    _isTicked = true;
+
+    Advance(frameDeltaSeconds);
+}
+
+void CubismFrameTimer::Advance(csmFloat32 frameDeltaSeconds)
+{
+    if (frameDeltaSeconds < 0.0f)
+    {
+        frameDeltaSeconds = 0.0f;
+    }
+
+    // 統計は切り詰める前の時間で取る
+    _frameTimes[_frameCount % FrameTimeSampleCount] = frameDeltaSeconds;
+    ++_frameCount;
+    if (frameDeltaSeconds > _hitchThreshold)
+    {
+        ++_hitchCount;
+    }
+
+    _frameDeltaTime = (frameDeltaSeconds > _maxFrameDeltaTime) ? _maxFrameDeltaTime : frameDeltaSeconds;
+    _accumulator += _frameDeltaTime;
+
+    _stepCount = static_cast<csmInt32>(_accumulator / _fixedDeltaTime);
+    if (_stepCount > _maxStepCount)
+    {
+        // 追いつけない分の時間は破棄する
+        _stepCount = _maxStepCount;
+        _accumulator = _fixedDeltaTime * _stepCount;
+    }
+
+    _accumulator -= _fixedDeltaTime * _stepCount;
+    if (_accumulator < 0.0f)
+    {
+        _accumulator = 0.0f;
+    }
+}
+
+void CubismFrameTimer::SetFixedDeltaTime(csmFloat32 seconds)
+{
+    if (seconds > 0.0f)
+    {
+        _fixedDeltaTime = seconds;
+    }
+}
+
+void CubismFrameTimer::SetMaxFrameDeltaTime(csmFloat32 seconds)
+{
+    if (seconds > 0.0f)
+    {
+        _maxFrameDeltaTime = seconds;
+    }
+}
+
+void CubismFrameTimer::SetMaxStepCount(csmInt32 count)
+{
+    if (count > 0)
+    {
+        _maxStepCount = count;
+    }
+}
+
+void CubismFrameTimer::SetHitchThreshold(csmFloat32 seconds)
+{
+    _hitchThreshold = seconds;
+}
+
+csmFloat32 CubismFrameTimer::GetFrameDeltaTime() const
+{
+    return _frameDeltaTime;
+}
+
+csmFloat32 CubismFrameTimer::GetFixedDeltaTime() const
+{
+    return _fixedDeltaTime;
+}
+
+csmInt32 CubismFrameTimer::GetStepCount() const
+{
+    return _stepCount;
+}
+
+csmFloat32 CubismFrameTimer::GetInterpolationAlpha() const
+{
+    const csmFloat32 alpha = _accumulator / _fixedDeltaTime;
+    return (alpha > 1.0f) ? 1.0f : alpha;
+}
+
+csmFloat32 CubismFrameTimer::GetFrameTimePercentile(csmFloat32 percentile) const
+{
+    const csmInt32 count = (_frameCount < static_cast<csmUint32>(FrameTimeSampleCount)) ? static_cast<csmInt32>(_frameCount) : FrameTimeSampleCount;
+
+    if (count == 0)
+    {
+        return 0.0f;
+    }
+
+    // 統計の取得は毎フレーム行うものではないため、コピーを挿入ソートする
+    csmFloat32 sorted[FrameTimeSampleCount];
+    for (csmInt32 i = 0; i < count; ++i)
+    {
+        const csmFloat32 value = _frameTimes[i];
+        csmInt32 j = i;
+
+        for (; j > 0 && sorted[j - 1] > value; --j)
+        {
+            sorted[j] = sorted[j - 1];
+        }
+
+        sorted[j] = value;
+    }
+
+    // nearest-rank法
+    if (percentile <= 0.0f)
+    {
+        return sorted[0];
+    }
+
+    csmInt32 rank = static_cast<csmInt32>(ceilf(percentile * 0.01f * count));
+    if (rank > count)
+    {
+        rank = count;
+    }
+
+    return sorted[rank - 1];
+}
+
+csmFloat32 CubismFrameTimer::GetMaxFrameTime() const
+{
+    return GetFrameTimePercentile(100.0f);
+}
+
+csmUint32 CubismFrameTimer::GetFrameCount() const
+{
+    return _frameCount;
+}
+
+csmUint32 CubismFrameTimer::GetHitchCount() const
+{
+    return _hitchCount;
+}
+
+}}}
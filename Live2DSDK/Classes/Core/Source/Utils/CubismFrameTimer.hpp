@@ -0,0 +1,172 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+
+//--------- LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework {
+
+/**
+ * @brief 固定ステップ更新のためのフレームタイマー
+ *
+ * 単調増加するクロックからフレーム間の経過時間を求め、固定の時間刻みで何ステップ演算するかと、
+ * 直近2ステップの状態を描画用に補間するための重みを計算する。
+ * フレーム時間の統計（パーセンタイル、ヒッチ数）も保持する。
+ *
+ * Tickの代わりにAdvanceで経過時間を直接与えることで、記録したフレーム時間を決定的に再生できる。
+ * プラットフォームに依存しないため、描画環境の無いLinux等でも動作する。
+ */
+class CubismFrameTimer
+{
+public:
+    static const csmInt32 FrameTimeSampleCount = 256;   ///< 統計に使用する直近のフレーム数
+
+    /**
+     * @brief コンストラクタ
+     */
+    CubismFrameTimer();
+
+    /**
+     * @brief 状態と統計をリセットする
+     *
+     * 次回のTickは経過時間0として扱う。
+     */
+    void Reset();
+
+    /**
+     * @brief 単調増加するクロックの現在値を取得する
+     *
+     * @return  現在時刻[ナノ秒]。起点は不定
+     */
+    static csmUint64 GetMonotonicTimeNanoseconds();
+
+    /**
+     * @brief 単調増加するクロックから経過時間を求め、1フレーム進める
+     */
+    void Tick();
+
+    /**
+     * @brief 経過時間を指定して1フレーム進める
+     *
+     * 記録したフレーム時間の再生やテストで使用する。
+     *
+     * @param[in]   frameDeltaSeconds   前回フレームからの経過時間[秒]
+     */
+    void Advance(csmFloat32 frameDeltaSeconds);
+
+    /**
+     * @brief 固定ステップの時間刻みを設定する
+     *
+     * @param[in]   seconds     1ステップの時間[秒]。デフォルトは1/60
+     */
+    void SetFixedDeltaTime(csmFloat32 seconds);
+
+    /**
+     * @brief 1フレームの経過時間の上限を設定する
+     *
+     * ヒッチ等でこれを超えた場合、演算に使う経過時間はこの値に切り詰める。
+     *
+     * @param[in]   seconds     経過時間の上限[秒]。デフォルトは0.25
+     */
+    void SetMaxFrameDeltaTime(csmFloat32 seconds);
+
+    /**
+     * @brief 1フレームで演算するステップ数の上限を設定する
+     *
+     * 上限を超える分の時間は破棄し、演算が描画に追いつかなくなるのを防ぐ。
+     *
+     * @param[in]   count   ステップ数の上限。デフォルトは4
+     */
+    void SetMaxStepCount(csmInt32 count);
+
+    /**
+     * @brief ヒッチとみなすフレーム時間を設定する
+     *
+     * @param[in]   seconds     フレーム時間[秒]。デフォルトは0.05
+     */
+    void SetHitchThreshold(csmFloat32 seconds);
+
+    /**
+     * @brief 演算に使う1フレームの経過時間を取得する
+     *
+     * @return  上限で切り詰めた経過時間[秒]
+     */
+    csmFloat32 GetFrameDeltaTime() const;
+
+    /**
+     * @brief 固定ステップの時間刻みを取得する
+     *
+     * @return  1ステップの時間[秒]
+     */
+    csmFloat32 GetFixedDeltaTime() const;
+
+    /**
+     * @brief 今回のフレームで演算するステップ数を取得する
+     *
+     * @return  ステップ数
+     */
+    csmInt32 GetStepCount() const;
+
+    /**
+     * @brief 描画用の補間の重みを取得する
+     *
+     * 直前のステップの状態を0、最後のステップの状態を1とした重み。
+     *
+     * @return  補間の重み（0〜1）
+     */
+    csmFloat32 GetInterpolationAlpha() const;
+
+    /**
+     * @brief 直近のフレーム時間のパーセンタイルを取得する
+     *
+     * 切り詰める前の経過時間を対象とする。
+     *
+     * @param[in]   percentile  パーセンタイル（0〜100）
+     * @return  フレーム時間[秒]。フレームが無い場合は0
+     */
+    csmFloat32 GetFrameTimePercentile(csmFloat32 percentile) const;
+
+    /**
+     * @brief 直近のフレーム時間の最大値を取得する
+     *
+     * @return  フレーム時間[秒]
+     */
+    csmFloat32 GetMaxFrameTime() const;
+
+    /**
+     * @brief Reset以降のフレーム数を取得する
+     */
+    csmUint32 GetFrameCount() const;
+
+    /**
+     * @brief Reset以降のヒッチの数を取得する
+     */
+    csmUint32 GetHitchCount() const;
+
+private:
+    csmFloat32 _fixedDeltaTime;         ///< 1ステップの時間
+    csmFloat32 _maxFrameDeltaTime;      ///< 1フレームの経過時間の上限
+    csmInt32 _maxStepCount;             ///< 1フレームのステップ数の上限
+    csmFloat32 _hitchThreshold;         ///< ヒッチとみなすフレーム時間
+
+    csmUint64 _lastTime;                ///< 前回Tickした時刻[ナノ秒]
+    csmBool _isTicked;                  ///< Reset以降にTickしたか
+
+    csmFloat32 _frameDeltaTime;         ///< 今回のフレームの経過時間（切り詰め後）
+    csmFloat32 _accumulator;            ///< 演算に消化していない時間
+    csmInt32 _stepCount;                ///< 今回のフレームのステップ数
+
+    csmFloat32 _frameTimes[FrameTimeSampleCount];  ///< 直近のフレーム時間のリングバッファ
+    csmUint32 _frameCount;              ///< Reset以降のフレーム数
+    csmUint32 _hitchCount;              ///< Reset以降のヒッチの数
+};
+
+}}}
+
+//--------- LIVE2D NAMESPACE ------------
@@ -0,0 +1,378 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismProfiler.hpp"
+
+#ifdef CSM_PROFILE
+
+#include <stdio.h>
+#include <atomic>
+#include "CubismFrameTimer.hpp"
+#include "csmVector.hpp"
+
+//--------- LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Utils {
+
+namespace {
+
+/// Kind of a recorded event.
+enum EventType
+{
+    EventType_Zone = 0,     ///< Complete event with a duration.
+    EventType_Counter,      ///< Counter value at the end of a frame.
+};
+
+/// One recorded event.
+struct ProfilerEvent
+{
+    const csmChar* Name;    ///< Zone name, or NULL for counters.
+    csmUint64 Time;         ///< Begin time [ns].
+    csmUint64 Value;        ///< Duration [ns] for zones, counter value for counters.
+    csmInt32 Type;          ///< EventType.
+    csmInt32 Counter;       ///< CubismProfiler::Counter for counter events.
+};
+
+/// Event ring buffer owned by a single thread.
+/// Only the owner writes. Count is the number of events ever written, and is published with release ordering
+/// so that readers see complete events. Once the buffer is full, the oldest events are overwritten.
+/// WriteCount is raised before an event is written, so that readers can tell which events may have been overwritten while copying.
+struct ProfilerThreadBuffer
+{
+    ProfilerEvent Events[CubismProfiler::ThreadEventCapacity];
+    std::atomic<csmUint32> Count;
+    std::atomic<csmUint32> WriteCount;
+};
+
+const csmChar* CounterNames[CubismProfiler::Counter_Count] =
+{
+    "DrawCalls",
+    "UploadedVertices",
+    "MaskRedraws",
+    "CulledDrawables",
+    "CulledModels",
+    "Allocations",
+};
+
+const csmUint32 Capacity = static_cast<csmUint32>(CubismProfiler::ThreadEventCapacity);
+
+std::atomic<csmBool> s_isEnabled(false);
+std::atomic<csmUint64> s_counters[CubismProfiler::Counter_Count];
+std::atomic<csmUint32> s_droppedEventCount(0);
+std::atomic<csmBool> s_isSlotInUse[CubismProfiler::MaxThreadCount];
+std::atomic<csmInt32> s_usedSlotCount(0);
+ProfilerThreadBuffer s_threadBuffers[CubismProfiler::MaxThreadCount];
+
+/// Slot of a thread in s_threadBuffers. The slot is released when the thread exits, so that other threads can reuse it.
+struct ThreadSlot
+{
+    ThreadSlot()
+        : Index(-1)
+    { }
+
+    ~ThreadSlot()
+    {
+        if (Index >= 0)
+        {
+            s_isSlotInUse[Index].store(false, std::memory_order_release);
+        }
+    }
+
+    csmInt32 Index;     ///< -1 until a slot is claimed.
+};
+
+thread_local ThreadSlot t_threadSlot;
+
+/// Returns the buffer of the calling thread, claiming a free slot on first use. NULL while all slots are in use.
+ProfilerThreadBuffer* GetThreadBuffer()
+{
+    if (t_threadSlot.Index < 0)
+    {
+        for (csmInt32 slot = 0; slot < CubismProfiler::MaxThreadCount; ++slot)
+        {
+            csmBool isInUse = false;
+            if (s_isSlotInUse[slot].compare_exchange_strong(isInUse, true, std::memory_order_acquire))
+            {
+                t_threadSlot.Index = slot;
+
+                csmInt32 usedSlotCount = s_usedSlotCount.load(std::memory_order_relaxed);
+                while (usedSlotCount < slot + 1 && !s_usedSlotCount.compare_exchange_weak(usedSlotCount, slot + 1, std::memory_order_release))
+                {
+                }
+                break;
+            }
+        }
+
+        if (t_threadSlot.Index < 0)
+        {
+            return NULL;
+        }
+    }
+
+    return &s_threadBuffers[t_threadSlot.Index];
+}
+
+/// Appends an event to the buffer of the calling thread, overwriting the oldest event when the buffer is full.
+void PushEvent(const ProfilerEvent& event)
+{
+    ProfilerThreadBuffer* buffer = GetThreadBuffer();
+    if (buffer == NULL)
+    {
+        s_droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const csmUint32 count = buffer->Count.load(std::memory_order_relaxed);
+    buffer->WriteCount.store(count + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    buffer->Events[count % Capacity] = event;
+    buffer->Count.store(count + 1, std::memory_order_release);
+}
+
+/// Copies the events still held in a buffer, oldest first.
+void CopyEvents(const ProfilerThreadBuffer& buffer, csmVector<ProfilerEvent>& events)
+{
+    events.Clear();
+
+    const csmUint32 count = buffer.Count.load(std::memory_order_acquire);
+    const csmUint32 begin = (count > Capacity) ? count - Capacity : 0;
+    for (csmUint32 i = begin; i < count; ++i)
+    {
+        events.PushBack(buffer.Events[i % Capacity]);
+    }
+
+    // コピー中に上書きされた可能性があるイベントを捨てる
+    // writeCount個目のイベントは、writeCount - Capacity個目のイベントと同じ要素に書き込まれる
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const csmUint32 writeCount = buffer.WriteCount.load(std::memory_order_relaxed);
+    if (writeCount > begin + Capacity)
+    {
+        const csmUint32 overwrittenCount = writeCount - (begin + Capacity);
+        const csmUint32 copiedCount = events.GetSize();
+        const csmUint32 keptCount = (overwrittenCount < copiedCount) ? copiedCount - overwrittenCount : 0;
+        for (csmUint32 i = 0; i < keptCount; ++i)
+        {
+            events[i] = events[i + copiedCount - keptCount];
+        }
+        events.Resize(keptCount);
+    }
+}
+
+/// Appends a string to the output.
+void AppendText(csmVector<csmChar>& output, const csmChar* text)
+{
+    for (; *text != '\0'; ++text)
+    {
+        output.PushBack(*text);
+    }
+}
+
+/// Appends a string to the output as a JSON string literal.
+void AppendJsonString(csmVector<csmChar>& output, const csmChar* text)
+{
+    output.PushBack('"');
+    for (; *text != '\0'; ++text)
+    {
+        if (*text == '"' || *text == '\\')
+        {
+            output.PushBack('\\');
+        }
+        else if (static_cast<csmUchar>(*text) < 0x20)
+        {
+            continue;
+        }
+
+        output.PushBack(*text);
+    }
+    output.PushBack('"');
+}
+
+}
+
+const csmInt32 CubismProfiler::MaxThreadCount;
+const csmInt32 CubismProfiler::ThreadEventCapacity;
+
+void CubismProfiler::SetEnabled(csmBool enabled)
+{
+    s_isEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+csmBool CubismProfiler::IsEnabled()
+{
+    return s_isEnabled.load(std::memory_order_relaxed);
+}
+
+void CubismProfiler::RecordZone(const csmChar* name, csmUint64 beginTime, csmUint64 endTime)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    ProfilerEvent event;
+    event.Name = name;
+    event.Time = beginTime;
+    event.Value = (endTime > beginTime) ? endTime - beginTime : 0;
+    event.Type = EventType_Zone;
+    event.Counter = 0;
+
+    PushEvent(event);
+}
+
+void CubismProfiler::AddCounter(Counter counter, csmUint64 value)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    s_counters[counter].fetch_add(value, std::memory_order_relaxed);
+}
+
+csmUint64 CubismProfiler::GetCounter(Counter counter)
+{
+    return s_counters[counter].load(std::memory_order_relaxed);
+}
+
+void CubismProfiler::MarkFrame()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    const csmUint64 now = CubismFrameTimer::GetMonotonicTimeNanoseconds();
+
+    for (csmInt32 i = 0; i < Counter_Count; ++i)
+    {
+        ProfilerEvent event;
+        event.Name = NULL;
+        event.Time = now;
+        event.Value = s_counters[i].exchange(0, std::memory_order_relaxed);
+        event.Type = EventType_Counter;
+        event.Counter = i;
+
+        PushEvent(event);
+    }
+}
+
+csmString CubismProfiler::ExportChromeTrace()
+{
+    const csmInt32 slotCount = s_usedSlotCount.load(std::memory_order_acquire);
+
+    csmVector<ProfilerEvent> threadEvents[MaxThreadCount];
+    for (csmInt32 thread = 0; thread < slotCount; ++thread)
+    {
+        CopyEvents(s_threadBuffers[thread], threadEvents[thread]);
+    }
+
+    // タイムスタンプは最初のイベントを0とする
+    csmUint64 origin = 0;
+    csmBool hasOrigin = false;
+    for (csmInt32 thread = 0; thread < slotCount; ++thread)
+    {
+        for (csmUint32 i = 0; i < threadEvents[thread].GetSize(); ++i)
+        {
+            if (!hasOrigin || threadEvents[thread][i].Time < origin)
+            {
+                origin = threadEvents[thread][i].Time;
+                hasOrigin = true;
+            }
+        }
+    }
+
+    csmVector<csmChar> output;
+    csmChar line[160];
+    csmBool isFirst = true;
+
+    AppendText(output, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    for (csmInt32 thread = 0; thread < slotCount; ++thread)
+    {
+        for (csmUint32 i = 0; i < threadEvents[thread].GetSize(); ++i)
+        {
+            const ProfilerEvent& event = threadEvents[thread][i];
+            const double timestamp = static_cast<double>(event.Time - origin) * 1.0e-3;
+
+            AppendText(output, isFirst ? "\n" : ",\n");
+            isFirst = false;
+
+            if (event.Type == EventType_Zone)
+            {
+                AppendText(output, "{\"name\":");
+                AppendJsonString(output, event.Name);
+                snprintf(line, sizeof(line), ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    thread + 1, timestamp, static_cast<double>(event.Value) * 1.0e-3);
+            }
+            else
+            {
+                AppendText(output, "{\"name\":");
+                AppendJsonString(output, CounterNames[event.Counter]);
+                snprintf(line, sizeof(line), ",\"ph\":\"C\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"value\":%llu}}",
+                    thread + 1, timestamp, static_cast<unsigned long long>(event.Value));
+            }
+
+            AppendText(output, line);
+        }
+    }
+
+    AppendText(output, "\n]}\n");
+
+    return csmString(output.GetPtr(), static_cast<csmInt32>(output.GetSize()));
+}
+
+csmUint32 CubismProfiler::GetDroppedEventCount()
+{
+    return s_droppedEventCount.load(std::memory_order_relaxed);
+}
+
+void CubismProfiler::Reset()
+{
+    for (csmInt32 thread = 0; thread < MaxThreadCount; ++thread)
+    {
+        s_threadBuffers[thread].Count.store(0, std::memory_order_relaxed);
+        s_threadBuffers[thread].WriteCount.store(0, std::memory_order_relaxed);
+    }
+
+    for (csmInt32 i = 0; i < Counter_Count; ++i)
+    {
+        s_counters[i].store(0, std::memory_order_relaxed);
+    }
+
+    s_droppedEventCount.store(0, std::memory_order_relaxed);
+}
+
+void CubismProfiler::BeginCapture()
+{
+    SetEnabled(false);
+    Reset();
+    SetEnabled(true);
+}
+
+void CubismProfiler::EndCapture()
+{
+    SetEnabled(false);
+}
+
+CubismProfilerZone::CubismProfilerZone(const csmChar* name)
+    : _name(name)
+    , _beginTime(CubismProfiler::IsEnabled() ? CubismFrameTimer::GetMonotonicTimeNanoseconds() : 0)
+{
+}
+
+CubismProfilerZone::~CubismProfilerZone()
+{
+    if (_beginTime != 0)
+    {
+        CubismProfiler::RecordZone(_name, _beginTime, CubismFrameTimer::GetMonotonicTimeNanoseconds());
+    }
+}
+
+}}}}
+
+//--------- LIVE2D NAMESPACE ------------
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+
+#ifdef CSM_PROFILE
+
+#include "csmString.hpp"
+
+#define CSM_PROFILE_CONCAT_INNER(a, b)          a ## b
+#define CSM_PROFILE_CONCAT(a, b)                CSM_PROFILE_CONCAT_INNER(a, b)
+#define CSM_PROFILE_ZONE(name)                  Live2D::Cubism::Framework::Utils::CubismProfilerZone CSM_PROFILE_CONCAT(csmProfilerZone, __LINE__)(name)
+#define CSM_PROFILE_COUNTER_ADD(counter, value) Live2D::Cubism::Framework::Utils::CubismProfiler::AddCounter(Live2D::Cubism::Framework::Utils::CubismProfiler::counter, value)
+#define CSM_PROFILE_FRAME()                     Live2D::Cubism::Framework::Utils::CubismProfiler::MarkFrame()
+
+//--------- LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Utils {
+
+/**
+ * @brief   フレーム内の処理時間を計測するプロファイラ
+ *
+ * CSM_PROFILE_ZONEで囲んだ区間の処理時間と、描画回数等のカウンタを記録し、
+ * Chromeのトレース形式（chrome://tracing、Perfetto）のJSONで出力する。
+ *
+ * 区間はスレッド毎に固定長のリングバッファに記録するため、記録時にロックやメモリ確保は行わない。
+ * バッファが一杯になると古いイベントから上書きするため、常に直近の記録が残る。
+ * 特定の区間だけを記録する場合はBeginCapture・EndCaptureで囲む。
+ * CSM_PROFILEが定義されていない場合、CSM_PROFILE_*マクロは何も展開しない。
+ */
+class CubismProfiler
+{
+public:
+    /**
+     * @brief   カウンタの種類
+     */
+    enum Counter
+    {
+        Counter_DrawCalls = 0,      ///< 描画命令の発行回数
+        Counter_UploadedVertices,   ///< 描画のために転送した頂点数
+        Counter_MaskRedraws,        ///< クリッピングマスクを描き直した回数
+        Counter_CulledDrawables,    ///< 画面外のため描画を省略した描画オブジェクトの数
+        Counter_CulledModels,       ///< 画面外のため描画を省略したモデルの数
+        Counter_Allocations,        ///< CubismFrameworkを通したメモリ確保の回数
+        Counter_Count
+    };
+
+    static const csmInt32 MaxThreadCount = 8;           ///< 同時に記録できるスレッドの数。終了したスレッドの枠は再利用する
+    static const csmInt32 ThreadEventCapacity = 8192;   ///< スレッド毎に保持するイベントの数
+
+    /**
+     * @brief   記録の有効・無効を設定する
+     *
+     * 無効の間は区間・カウンタとも記録しない。初期状態は無効。
+     *
+     * @param[in]   enabled     trueの場合は記録する
+     */
+    static void SetEnabled(csmBool enabled);
+
+    /**
+     * @brief   記録が有効かを取得する
+     */
+    static csmBool IsEnabled();
+
+    /**
+     * @brief   区間を記録する
+     *
+     * 通常はCSM_PROFILE_ZONEを使用する。
+     *
+     * @param[in]   name        区間の名前。記録を出力するまで有効な文字列（文字列リテラル等）であること
+     * @param[in]   beginTime   開始時刻[ナノ秒]
+     * @param[in]   endTime     終了時刻[ナノ秒]
+     */
+    static void RecordZone(const csmChar* name, csmUint64 beginTime, csmUint64 endTime);
+
+    /**
+     * @brief   カウンタに加算する
+     *
+     * @param[in]   counter     カウンタの種類
+     * @param[in]   value       加算する値
+     */
+    static void AddCounter(Counter counter, csmUint64 value);
+
+    /**
+     * @brief   前回のMarkFrame以降のカウンタの値を取得する
+     *
+     * @param[in]   counter     カウンタの種類
+     * @return  カウンタの値
+     */
+    static csmUint64 GetCounter(Counter counter);
+
+    /**
+     * @brief   フレームの区切りを記録する
+     *
+     * 各カウンタの値を呼び出したスレッドのバッファに記録し、カウンタを0に戻す。
+     * 1フレームに1回、描画の完了後に呼び出す。
+     */
+    static void MarkFrame();
+
+    /**
+     * @brief   記録をChromeのトレース形式のJSONで出力する
+     *
+     * 記録中のスレッドがあっても呼び出せるが、出力中に記録・上書きされた区間は含まれない場合がある。
+     * 終了したスレッドの枠を再利用した場合、同じtidに両方のスレッドの記録が含まれる。
+     *
+     * @return  JSON文字列
+     */
+    static csmString ExportChromeTrace();
+
+    /**
+     * @brief   スレッドの枠が足りず記録できなかったイベントの数を取得する
+     */
+    static csmUint32 GetDroppedEventCount();
+
+    /**
+     * @brief   記録とカウンタを消去する
+     *
+     * 記録中のスレッドが無い状態で呼び出すこと。
+     */
+    static void Reset();
+
+    /**
+     * @brief   記録を消去して記録を開始する
+     *
+     * Resetと同様に、記録中のスレッドが無い状態で呼び出すこと。
+     */
+    static void BeginCapture();
+
+    /**
+     * @brief   記録を終了する
+     *
+     * 記録した内容は次のResetまたはBeginCaptureまで残るので、ExportChromeTraceで出力する。
+     */
+    static void EndCapture();
+
+private:
+    // コンストラクタ・デストラクタ呼び出し不可な静的クラスにする
+    CubismProfiler();
+};
+
+/**
+ * @brief   スコープの開始から終了までを区間として記録する
+ */
+class CubismProfilerZone
+{
+public:
+    /**
+     * @brief   コンストラクタ
+     *
+     * @param[in]   name    区間の名前（文字列リテラル）
+     */
+    explicit CubismProfilerZone(const csmChar* name);
+
+    /**
+     * @brief   デストラクタ
+     */
+    ~CubismProfilerZone();
+
+private:
+    // コピー禁止
+    CubismProfilerZone(const CubismProfilerZone&);
+    CubismProfilerZone& operator=(const CubismProfilerZone&);
+
+    const csmChar* _name;   ///< 区間の名前
+    csmUint64 _beginTime;   ///< 開始時刻[ナノ秒]。記録しない場合は0
+};
+
+}}}}
+
+//--------- LIVE2D NAMESPACE ------------
+
+#else
+
+#define CSM_PROFILE_ZONE(name)
+#define CSM_PROFILE_COUNTER_ADD(counter, value)
+#define CSM_PROFILE_FRAME()
+
+#endif
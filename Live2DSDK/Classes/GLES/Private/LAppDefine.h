@@ -47,6 +47,52 @@ namespace LAppDefine {
     extern const csmChar* HitAreaNameHead;          ///< 当たり判定の[Head]タグ
     extern const csmChar* HitAreaNameBody;          ///< 当たり判定の[Body]タグ
 
+    // 外部定義ファイル(json)と合わせる
+    extern const csmChar* LipSyncVowelParameterIds[5];  ///< 母音リップシンク用パラメータID（A/I/U/E/Oの順）
+
+    // モーションのベイク
+    extern const csmBool MotionBakeEnable;          ///< モーションのカーブを一定間隔のテーブルに変換して評価するかどうか
+    extern const csmFloat32 MotionBakeSampleRate;   ///< ベイクのサンプリングレート[回/秒]。0以下の場合はモーションのFPSの2倍
+    extern const csmFloat32 MotionBakeMaxError;     ///< ベイクを採用する元のカーブとの最大誤差。超える場合は元のカーブで評価する
+
+    // MOC3の整合性検証
+    extern const csmBool MocConsistencyValidationEnable;    ///< MOC3の整合性検証機能の有効・無効。アプリに同梱したモデルは信頼できるため無効とし、ダウンロードしたモデル等の信頼できないファイルを読み込む場合に有効にする
+    extern const csmChar* MocConsistencyCacheFileName;      ///< 整合性検証の結果を保存するファイル名（Cachesディレクトリ）
+
+    // 更新間隔
+    extern const csmFloat32 SimulationFps;          ///< モーション・物理演算等を更新する固定のフレームレート
+    extern const csmFloat32 MaxFrameDeltaTime;      ///< 1フレームの経過時間の上限[秒]。ヒッチ時はこの値に切り詰める
+    extern const csmInt32 MaxSimulationStepCount;   ///< 1フレームで更新する最大ステップ数
+    extern const csmFloat32 FrameHitchThreshold;    ///< ヒッチとして統計に数えるフレーム時間[秒]
+
+    // 物理演算の詳細度
+    extern const csmFloat32 PhysicsReducedLevelHeight;  ///< 画面上の高さ[px]がこの値未満のモデルは物理演算を間引く
+    extern const csmFloat32 PhysicsFrozenLevelHeight;   ///< 画面上の高さ[px]がこの値未満のモデルは物理演算を止める
+
+    // 群衆表示
+    extern const csmFloat32 CrowdInstanceSpacing;   ///< 同じモデルを複数表示する際のモデル同士の横方向の間隔
+
+    // 描画キャッシュ（インポスター）
+    extern const csmBool ImpostorEnable;                        ///< 状態が変わらないモデルを描画済みのテクスチャで表示するかどうか。加算・乗算のDrawableを持つモデルには使わない
+    extern const csmFloat32 ImpostorParameterTolerance;         ///< パラメータ・パーツ不透明度の変化をこの値以下であれば無視する
+    extern const csmFloat32 ImpostorScaleTolerance;             ///< 画面上の高さの変化がこの割合以下であればテクスチャを描き直さない
+    extern const csmFloat32 ImpostorSmallModelHeight;           ///< 画面上の高さ[px]がこの値未満のモデルは動いていてもテクスチャで表示する
+    extern const csmFloat32 ImpostorSmallModelRefreshInterval;  ///< 小さく表示されているモデルのテクスチャを描き直す間隔[秒]
+    extern const csmInt32 ImpostorMaxTextureSize;               ///< テクスチャの一辺の最大長[px]
+
+    // 画面外カリング
+    extern const csmBool OffscreenModelSkipEnable;  ///< 前回の描画で画面外だったモデルの描画を省略し、更新の頻度を下げるかどうか
+    extern const csmFloat32 OffscreenModelUpdateInterval;   ///< 画面外のモデルを更新する間隔[秒]。更新の度にモデルの矩形を計算し直す
+    extern const csmFloat32 OffscreenModelMargin;   ///< 画面外の判定でモデルの矩形を上下左右に広げる割合。低い頻度で更新している間の動きを見込む
+
+    // 描画コマンドの記録
+    extern const csmBool RenderCommandRecordingEnable;  ///< 描画をワーカースレッドで並列に記録してから描画スレッドで実行するかどうか。インポスターで表示するモデルは記録しない
+
+    // シェーダのプログラムバイナリ
+    // iOSのOpenGL ES 2.0コンテキストではプログラムバイナリを取得できないため、キャッシュは作られず毎回ソースからコンパイルする。
+    // 効果があるのはOpenGL ES 3.0以降、またはOES_get_program_binary拡張に対応した環境のみ
+    extern const csmChar* ShaderProgramCacheFileName;   ///< リンク済みのシェーダプログラムを保存するファイル名（Cachesディレクトリ）
+
     // モーションの優先度定数
     extern const csmInt32 PriorityNone;             ///< モーションの優先度定数: 0
     extern const csmInt32 PriorityIdle;             ///< モーションの優先度定数: 1
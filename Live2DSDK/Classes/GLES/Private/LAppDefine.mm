@@ -46,6 +46,50 @@ namespace LAppDefine {
     const csmChar* HitAreaNameHead = "Head";
     const csmChar* HitAreaNameBody = "Body";
 
+    // 外部定義ファイル(json)と合わせる
+    const csmChar* LipSyncVowelParameterIds[5] = { "ParamA", "ParamI", "ParamU", "ParamE", "ParamO" };
+
+    // モーションのベイク
+    const csmBool MotionBakeEnable = true;
+    const csmFloat32 MotionBakeSampleRate = 0.0f;
+    const csmFloat32 MotionBakeMaxError = 0.05f;
+
+    // MOC3の整合性検証
+    const csmBool MocConsistencyValidationEnable = false;
+    const csmChar* MocConsistencyCacheFileName = "Live2DMocConsistency.cache";
+
+    // 更新間隔
+    const csmFloat32 SimulationFps = 60.0f;
+    const csmFloat32 MaxFrameDeltaTime = 0.25f;
+    const csmInt32 MaxSimulationStepCount = 4;
+    const csmFloat32 FrameHitchThreshold = 0.05f;
+
+    // 物理演算の詳細度
+    const csmFloat32 PhysicsReducedLevelHeight = 360.0f;
+    const csmFloat32 PhysicsFrozenLevelHeight = 96.0f;
+
+    // 群衆表示
+    const csmFloat32 CrowdInstanceSpacing = 0.6f;
+
+    // 描画キャッシュ（インポスター）
+    const csmBool ImpostorEnable = false;
+    const csmFloat32 ImpostorParameterTolerance = 0.001f;
+    const csmFloat32 ImpostorScaleTolerance = 0.15f;
+    const csmFloat32 ImpostorSmallModelHeight = 240.0f;
+    const csmFloat32 ImpostorSmallModelRefreshInterval = 0.2f;
+    const csmInt32 ImpostorMaxTextureSize = 2048;
+
+    // 画面外カリング
+    const csmBool OffscreenModelSkipEnable = true;
+    const csmFloat32 OffscreenModelMargin = 0.1f;
+    const csmFloat32 OffscreenModelUpdateInterval = 0.25f;
+
+    // 描画コマンドの記録
+    const csmBool RenderCommandRecordingEnable = true;
+
+    // シェーダのプログラムバイナリ
+    const csmChar* ShaderProgramCacheFileName = "Live2DShaderPrograms.cache";
+
     // モーションの優先度定数
     const csmInt32 PriorityNone = 0;
     const csmInt32 PriorityIdle = 1;
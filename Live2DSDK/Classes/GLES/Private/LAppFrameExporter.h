@@ -0,0 +1,144 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#ifndef LAppFrameExporter_h
+#define LAppFrameExporter_h
+
+#import <CubismFramework.hpp>
+#import <CubismUserModel.hpp>
+#import <ICubismModelSetting.hpp>
+#import <csmVector.hpp>
+#import <CubismRenderer_Software.hpp>
+#import <chrono>
+#import <dispatch/dispatch.h>
+
+/**
+ * @brief モーションを連番画像に書き出すクラス
+ *
+ * 画面に表示せず、ソフトウェアレンダラでオフスクリーンに描画する。OpenGLのコンテキストは不要。
+ * CubismIdManagerとアロケータは表示中のモデルと共有しているため、フレームワークを使う処理は全てメインキューで行う。
+ * モーション・物理演算・ポーズ・まばたきの固定ステップの更新と描画は、画面の更新を止めないよう1フレームずつメインキューに積む。
+ * 描画は帯ごとに、画像のエンコードとファイルへの書き込みはフレームごとにワーカースレッドで並列に行う。
+ */
+class LAppFrameExporter : public Csm::CubismUserModel
+{
+public:
+    /**
+     * @brief 書き出す形式
+     */
+    enum OutputFormat
+    {
+        OutputFormat_Png = 0,   ///< 1フレームごとにPNGファイルを書き出す
+        OutputFormat_Raw,       ///< 全フレームを1つのファイルに、乗算済みアルファのRGBA8で連続して書き出す
+    };
+
+    /**
+     * @brief 書き出しの完了を通知するハンドラ
+     *
+     * @param[in]   frameCount  書き出したフレーム数。失敗した場合は-1
+     */
+    typedef void (^CompletionHandler)(Csm::csmInt32 frameCount);
+
+    /**
+     * @brief コンストラクタ
+     */
+    LAppFrameExporter();
+
+    /**
+     * @brief デストラクタ
+     */
+    virtual ~LAppFrameExporter();
+
+    /**
+     * @brief model3.jsonが置かれたディレクトリとファイルパスからモデルを生成する
+     *
+     * @param[in]   dir         model3.jsonが置かれたディレクトリ
+     * @param[in]   fileName    model3.jsonのファイル名
+     *
+     * @return  生成に成功した場合はtrue
+     */
+    Csm::csmBool LoadAssets(const Csm::csmChar* dir, const Csm::csmChar* fileName);
+
+    /**
+     * @brief モーションを1回分（ループするモーションは1ループ分）再生し、各フレームを書き出す
+     *
+     * メインスレッドから呼び出し、すぐに戻る。全フレームの書き込みが終わるか失敗すると、メインキューでcompletionを呼ぶ。
+     * completionが呼ばれるまではインスタンスを破棄せず、次の書き出しも始めない。
+     *
+     * @param[in]   group           モーショングループ名
+     * @param[in]   no              グループ内の番号
+     * @param[in]   framesPerSecond 1秒あたりのフレーム数
+     * @param[in]   width           画像の幅[px]
+     * @param[in]   height          画像の高さ[px]
+     * @param[in]   format          書き出す形式
+     * @param[in]   outputDir       書き出し先のディレクトリ（絶対パス）
+     * @param[in]   completion      完了時に呼ぶハンドラ
+     */
+    void ExportMotion(const Csm::csmChar* group, Csm::csmInt32 no, Csm::csmFloat32 framesPerSecond,
+                      Csm::csmUint32 width, Csm::csmUint32 height, OutputFormat format, const Csm::csmChar* outputDir,
+                      CompletionHandler completion);
+
+private:
+    /**
+     * @brief テクスチャをデコードしてレンダラに設定する
+     *
+     * @return  全てのテクスチャを設定できた場合はtrue
+     */
+    Csm::csmBool SetupTextures();
+
+    /**
+     * @brief テクスチャのピクセルデータを解放する
+     */
+    void ReleaseTextures();
+
+    /**
+     * @brief モーションを読み込み、描画先と書き出し先を用意する
+     *
+     * @return  用意できた場合はtrue
+     */
+    Csm::csmBool BeginExport(const Csm::csmChar* group, Csm::csmInt32 no, Csm::csmFloat32 framesPerSecond,
+                             Csm::csmUint32 width, Csm::csmUint32 height, OutputFormat format, const Csm::csmChar* outputDir);
+
+    /**
+     * @brief 1フレームを更新・描画してエンコードに渡し、次のフレームをメインキューに積む<br>
+     *         エンコード待ちのフレームが多い場合は、少し待ってからやり直す。
+     */
+    void ExportNextFrame();
+
+    /**
+     * @brief 全フレームのエンコードが終わった後に書き出し先を閉じ、completionを呼ぶ
+     */
+    void FinishExport();
+
+    /**
+     * @brief モーション・まばたき・物理演算・ポーズによるパラメータの更新を1ステップ分行う
+     *
+     * @param[in]   deltaTimeSeconds    1ステップの時間[秒]
+     */
+    void UpdateSimulation(Csm::csmFloat32 deltaTimeSeconds);
+
+    Csm::ICubismModelSetting* _modelSetting; ///< モデルセッティング情報
+    Csm::csmString _modelHomeDir; ///< モデルセッティングが置かれたディレクトリ
+    Csm::csmVector<Csm::CubismIdHandle> _eyeBlinkIds; ///< モデルに設定されたまばたき機能用パラメータID
+    Csm::csmVector<Csm::CubismIdHandle> _lipSyncIds; ///< モデルに設定されたリップシンク機能用パラメータID
+    Csm::csmVector<Csm::csmByte*> _texturePixels; ///< デコードしたテクスチャのピクセルデータ
+    Csm::Rendering::CubismRenderer_Software* _softwareRenderer; ///< _rendererを描画先の設定に使用する型で保持したもの
+    Csm::Rendering::CubismOffscreenSurface_Software _surface; ///< 書き出し中の描画先
+    Csm::csmString _motionName; ///< 書き出し中のモーションの名前。出力ファイル名に使う
+    Csm::csmString _outputDir; ///< 書き出し先のディレクトリ
+    Csm::csmInt32 _rawFile; ///< RAW形式の出力ファイル。PNG形式の場合は-1
+    Csm::csmInt32 _frame; ///< 次に書き出すフレーム
+    Csm::csmInt32 _frameCount; ///< 書き出すフレーム数
+    Csm::csmFloat32 _deltaTimeSeconds; ///< 1フレームの時間[秒]
+    volatile Csm::csmInt32 _failedFrameCount; ///< 書き込みに失敗したフレーム数。ワーカースレッドから加算する
+    dispatch_group_t _encodeGroup; ///< エンコード中のフレーム
+    dispatch_semaphore_t _framesInFlight; ///< エンコード待ちにできるフレーム数
+    std::chrono::steady_clock::time_point _beginTime; ///< 書き出しを始めた時刻
+    CompletionHandler _completion; ///< 書き出しの完了を通知するハンドラ
+};
+
+#endif /* LAppFrameExporter_h */
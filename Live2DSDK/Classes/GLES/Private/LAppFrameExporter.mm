@@ -0,0 +1,494 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#import <UIKit/UIKit.h>
+#import "LAppFrameExporter.h"
+#import <cmath>
+#import <fcntl.h>
+#import <unistd.h>
+#import <CubismModelSettingJson.hpp>
+#import <CubismMotion.hpp>
+#import <CubismPhysics.hpp>
+#import <CubismString.hpp>
+#import <CubismProfiler.hpp>
+#import "LAppDefine.h"
+#import "LAppPal.h"
+#import "LAppTextureDecoder.h"
+
+using namespace Live2D::Cubism::Framework;
+using namespace LAppDefine;
+
+namespace {
+    const csmInt32 MaxFramesInFlight = 8;   ///< エンコード待ちにできるフレーム数。これを超えるとシミュレーションを待たせる
+    const int64_t EncodeWaitNanoseconds = 2 * NSEC_PER_MSEC;   ///< エンコード待ちのフレームが多い場合に、次のフレームを積み直すまでの時間
+
+    csmByte* CreateBuffer(const csmChar* path, csmSizeInt* size)
+    {
+        if (DebugLogEnable)
+        {
+            LAppPal::PrintLogLn("[APP]create buffer: %s ", path);
+        }
+        return LAppPal::LoadFileAsBytes(path,size);
+    }
+
+    void DeleteBuffer(csmByte* buffer, const csmChar* path = "")
+    {
+        if (DebugLogEnable)
+        {
+            LAppPal::PrintLogLn("[APP]delete buffer: %s", path);
+        }
+        LAppPal::ReleaseBytes(buffer);
+    }
+
+    /**
+     * @brief 乗算済みアルファのRGBA8をPNGファイルに書き出す
+     */
+    csmBool WritePng(const csmByte* pixels, csmUint32 width, csmUint32 height, NSString* path)
+    {
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+        CGDataProviderRef provider = CGDataProviderCreateWithData(NULL, pixels, static_cast<size_t>(width) * height * 4, NULL);
+        CGImageRef image = CGImageCreate(width, height, 8, 32, width * 4, colorSpace,
+                                         kCGBitmapByteOrderDefault | kCGImageAlphaPremultipliedLast,
+                                         provider, NULL, false, kCGRenderingIntentDefault);
+
+        NSData* data = UIImagePNGRepresentation([UIImage imageWithCGImage:image]);
+        const csmBool isWritten = [data writeToFile:path atomically:NO];
+
+        CGImageRelease(image);
+        CGDataProviderRelease(provider);
+        CGColorSpaceRelease(colorSpace);
+
+        return isWritten;
+    }
+}
+
+LAppFrameExporter::LAppFrameExporter()
+: CubismUserModel()
+, _modelSetting(NULL)
+, _softwareRenderer(NULL)
+, _rawFile(-1)
+, _frame(0)
+, _frameCount(0)
+, _deltaTimeSeconds(0.0f)
+, _failedFrameCount(0)
+, _encodeGroup(NULL)
+, _framesInFlight(NULL)
+, _completion(NULL)
+{
+    if (DebugLogEnable)
+    {
+        _debugMode = true;
+    }
+}
+
+LAppFrameExporter::~LAppFrameExporter()
+{
+    // 書き出し中のフレームはメインキューからthisを参照している
+    CSM_ASSERT(_completion == NULL);
+
+    // レンダラがテクスチャを参照しているため先に破棄する
+    DeleteRenderer();
+    ReleaseTextures();
+
+    delete _modelSetting;
+}
+
+csmBool LAppFrameExporter::LoadAssets(const csmChar* dir, const csmChar* fileName)
+{
+    _modelHomeDir = dir;
+
+    csmSizeInt size;
+    csmString path = csmString(dir) + fileName;
+
+    csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+    if (buffer == NULL)
+    {
+        return false;
+    }
+    _modelSetting = new CubismModelSettingJson(buffer, size);
+    DeleteBuffer(buffer, path.GetRawString());
+
+    //Cubism Model
+    if (strcmp(_modelSetting->GetModelFileName(), "") == 0)
+    {
+        LAppPal::PrintLogLn("Failed to LoadAssets().");
+        return false;
+    }
+
+    path = _modelHomeDir + _modelSetting->GetModelFileName();
+    buffer = CreateBuffer(path.GetRawString(), &size);
+    LoadModel(buffer, size, MocConsistencyValidationEnable);
+    DeleteBuffer(buffer, path.GetRawString());
+
+    if (_model == NULL)
+    {
+        LAppPal::PrintLogLn("Failed to LoadAssets().");
+        return false;
+    }
+
+    //Physics
+    if (strcmp(_modelSetting->GetPhysicsFileName(), "") != 0)
+    {
+        path = _modelHomeDir + _modelSetting->GetPhysicsFileName();
+        buffer = CreateBuffer(path.GetRawString(), &size);
+        LoadPhysics(buffer, size);
+        DeleteBuffer(buffer, path.GetRawString());
+
+        if (_physics != NULL)
+        {
+            _physics->SetParallelFor(LAppPal::ParallelFor);
+        }
+    }
+
+    //Pose
+    if (strcmp(_modelSetting->GetPoseFileName(), "") != 0)
+    {
+        path = _modelHomeDir + _modelSetting->GetPoseFileName();
+        buffer = CreateBuffer(path.GetRawString(), &size);
+        LoadPose(buffer, size);
+        DeleteBuffer(buffer, path.GetRawString());
+    }
+
+    //EyeBlink
+    if (_modelSetting->GetEyeBlinkParameterCount() > 0)
+    {
+        _eyeBlink = CubismEyeBlink::Create(_modelSetting);
+    }
+
+    for (csmInt32 i = 0; i < _modelSetting->GetEyeBlinkParameterCount(); ++i)
+    {
+        _eyeBlinkIds.PushBack(_modelSetting->GetEyeBlinkParameterId(i));
+    }
+
+    for (csmInt32 i = 0; i < _modelSetting->GetLipSyncParameterCount(); ++i)
+    {
+        _lipSyncIds.PushBack(_modelSetting->GetLipSyncParameterId(i));
+    }
+
+    //Layout
+    csmMap<csmString, csmFloat32> layout;
+    _modelSetting->GetLayoutMap(layout);
+    _modelMatrix->SetupFromLayout(layout);
+
+    _model->SaveParameters();
+
+    // OpenGLを使わないため、CreateRendererではなくソフトウェアレンダラを直接生成する
+    _softwareRenderer = Rendering::CubismRenderer_Software::Create();
+    _softwareRenderer->Initialize(_model);
+    _softwareRenderer->SetParallelFor(LAppPal::ParallelFor);
+    _softwareRenderer->IsPremultipliedAlpha(true);
+    _renderer = _softwareRenderer;
+
+    return SetupTextures();
+}
+
+csmBool LAppFrameExporter::SetupTextures()
+{
+    csmVector<csmInt32> textureNumbers;
+    csmVector<csmString> texturePaths;
+    csmVector<LAppTextureDecoder::DecodeJob> jobs;
+
+    for (csmInt32 modelTextureNumber = 0; modelTextureNumber < _modelSetting->GetTextureCount(); modelTextureNumber++)
+    {
+        // テクスチャ名が空文字だった場合はロード・バインド処理をスキップ
+        if (strcmp(_modelSetting->GetTextureFileName(modelTextureNumber), "") == 0)
+        {
+            continue;
+        }
+
+        const csmString texturePath = _modelHomeDir + _modelSetting->GetTextureFileName(modelTextureNumber);
+
+        LAppTextureDecoder::DecodeJob job;
+        job.fileData = CreateBuffer(texturePath.GetRawString(), &job.fileSize);
+        job.pixels = NULL;
+        job.width = 0;
+        job.height = 0;
+
+        textureNumbers.PushBack(modelTextureNumber);
+        texturePaths.PushBack(texturePath);
+        jobs.PushBack(job);
+    }
+
+    // 全テクスチャをまとめて並列にデコードする
+    LAppTextureDecoder::DecodePngBatch(jobs.GetPtr(), jobs.GetSize(), true);
+
+    csmBool isSucceeded = true;
+    for (csmUint32 i = 0; i < jobs.GetSize(); ++i)
+    {
+        DeleteBuffer(const_cast<csmByte*>(jobs[i].fileData), texturePaths[i].GetRawString());
+
+        if (jobs[i].pixels == NULL)
+        {
+            LAppPal::PrintLogLn("Failed to load texture: %s", texturePaths[i].GetRawString());
+            isSucceeded = false;
+            continue;
+        }
+
+        _texturePixels.PushBack(jobs[i].pixels);
+        _softwareRenderer->BindTexture(textureNumbers[i], jobs[i].pixels, jobs[i].width, jobs[i].height);
+    }
+
+    return isSucceeded;
+}
+
+void LAppFrameExporter::ReleaseTextures()
+{
+    for (csmUint32 i = 0; i < _texturePixels.GetSize(); ++i)
+    {
+        LAppTextureDecoder::ReleasePixels(_texturePixels[i]);
+    }
+    _texturePixels.Clear();
+}
+
+void LAppFrameExporter::ExportMotion(const csmChar* group, csmInt32 no, csmFloat32 framesPerSecond,
+                                     csmUint32 width, csmUint32 height, OutputFormat format, const csmChar* outputDir,
+                                     CompletionHandler completion)
+{
+    CSM_ASSERT(_completion == NULL);
+
+    if (!BeginExport(group, no, framesPerSecond, width, height, format, outputDir))
+    {
+        CompletionHandler failed = Block_copy(completion);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            failed(-1);
+            Block_release(failed);
+        });
+        return;
+    }
+
+    _completion = Block_copy(completion);
+
+    // 1フレームずつメインキューに積み、その間の画面の更新を止めない
+    dispatch_async(dispatch_get_main_queue(), ^{
+        ExportNextFrame();
+    });
+}
+
+csmBool LAppFrameExporter::BeginExport(const csmChar* group, csmInt32 no, csmFloat32 framesPerSecond,
+                                       csmUint32 width, csmUint32 height, OutputFormat format, const csmChar* outputDir)
+{
+    if (_model == NULL || _softwareRenderer == NULL || framesPerSecond <= 0.0f || width == 0 || height == 0)
+    {
+        LAppPal::PrintLogLn("[APP]invalid export settings.");
+        return false;
+    }
+
+    //------------ モーションの読み込み ------------
+    const csmString motionPath = _modelHomeDir + _modelSetting->GetMotionFileName(group, no);
+    csmSizeInt size;
+    csmByte* buffer = CreateBuffer(motionPath.GetRawString(), &size);
+    if (buffer == NULL)
+    {
+        return false;
+    }
+
+    _motionName = Utils::CubismString::GetFormatedString("%s_%d", group, no);
+    CubismMotion* motion = static_cast<CubismMotion*>(LoadMotion(buffer, size, _motionName.GetRawString(), NULL, NULL, _modelSetting, group, no));
+    DeleteBuffer(buffer, motionPath.GetRawString());
+
+    if (motion == NULL)
+    {
+        return false;
+    }
+
+    const csmFloat32 duration = motion->GetLoopDuration();
+    if (duration <= 0.0f)
+    {
+        LAppPal::PrintLogLn("[APP]can't export motion without a fixed length: [%s]", _motionName.GetRawString());
+        ACubismMotion::Delete(motion);
+        return false;
+    }
+
+    motion->SetEffectIds(_eyeBlinkIds, _lipSyncIds);
+    _motionManager->StopAllMotions();
+    _motionManager->StartMotionPriority(motion, true, PriorityForce);
+
+    //------------ 描画先 ------------
+    if (!_surface.CreateOffscreenSurface(width, height))
+    {
+        return false;
+    }
+    _softwareRenderer->SetRenderTarget(&_surface);
+
+    // NYLDModelManagerの表示と同じ配置にする
+    CubismMatrix44 projection;
+    if (_model->GetCanvasWidth() > 1.0f && width < height)
+    {
+        _modelMatrix->SetWidth(2.0f);
+        projection.Scale(1.0f, static_cast<csmFloat32>(width) / static_cast<csmFloat32>(height));
+    }
+    else
+    {
+        projection.Scale(static_cast<csmFloat32>(height) / static_cast<csmFloat32>(width), 1.0f);
+    }
+    projection.MultiplyByMatrix(_modelMatrix);
+    _softwareRenderer->SetMvpMatrix(&projection);
+
+    //------------ 書き出し先 ------------
+    _outputDir = outputDir;
+    _rawFile = -1;
+    if (format == OutputFormat_Raw)
+    {
+        const csmString rawPath = Utils::CubismString::GetFormatedString("%s/%s.rgba", outputDir, _motionName.GetRawString());
+        _rawFile = open(rawPath.GetRawString(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (_rawFile < 0)
+        {
+            LAppPal::PrintLogLn("[APP]failed to open: %s", rawPath.GetRawString());
+            _softwareRenderer->SetRenderTarget(NULL);
+            _motionManager->StopAllMotions();
+            return false;
+        }
+    }
+
+    _encodeGroup = dispatch_group_create();
+    _framesInFlight = dispatch_semaphore_create(MaxFramesInFlight);
+    _failedFrameCount = 0;
+
+    _frame = 0;
+    _frameCount = static_cast<csmInt32>(ceilf(duration * framesPerSecond));
+    _deltaTimeSeconds = 1.0f / framesPerSecond;
+    _beginTime = std::chrono::steady_clock::now();
+
+    return true;
+}
+
+void LAppFrameExporter::ExportNextFrame()
+{
+    if (_frame >= _frameCount)
+    {
+        FinishExport();
+        return;
+    }
+
+    // エンコードが追いつかない場合は、メインスレッドを止めずに少し待ってから積み直す
+    if (dispatch_semaphore_wait(_framesInFlight, DISPATCH_TIME_NOW) != 0)
+    {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, EncodeWaitNanoseconds), dispatch_get_main_queue(), ^{
+            ExportNextFrame();
+        });
+        return;
+    }
+
+    {
+        CSM_PROFILE_ZONE("LAppFrameExporter::Frame");
+
+        // 最初のフレームはモーションの開始時点の状態を描画する
+        UpdateSimulation(_frame == 0 ? 0.0f : _deltaTimeSeconds);
+        _model->Update();
+
+        _surface.Clear(0.0f, 0.0f, 0.0f, 0.0f);
+        _softwareRenderer->DrawModel();
+    }
+
+    const csmUint32 width = _surface.GetBufferWidth();
+    const csmUint32 height = _surface.GetBufferHeight();
+    const csmSizeType frameBytes = static_cast<csmSizeType>(width) * height * 4;
+    csmByte* pixels = static_cast<csmByte*>(malloc(frameBytes));
+    memcpy(pixels, _surface.GetPixels(), frameBytes);
+
+    // ワーカースレッドではフレームワークのアロケータを使わないよう、csmStringではなくNSStringで渡す
+    const csmInt32 frame = _frame;
+    const csmInt32 rawFile = _rawFile;
+    volatile csmInt32* failedFrameCount = &_failedFrameCount;
+    dispatch_semaphore_t framesInFlight = _framesInFlight;
+    NSString* framePath = [[NSString alloc] initWithUTF8String:Utils::CubismString::GetFormatedString("%s/%s_%05d.png", _outputDir.GetRawString(), _motionName.GetRawString(), frame).GetRawString()];
+
+    dispatch_group_async(_encodeGroup, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        @autoreleasepool
+        {
+            csmBool isWritten;
+            if (rawFile >= 0)
+            {
+                // フレームごとの書き込み位置が決まっているので、完了順に関わらず並列に書き込める
+                isWritten = pwrite(rawFile, pixels, frameBytes, static_cast<off_t>(frameBytes) * frame) == static_cast<ssize_t>(frameBytes);
+            }
+            else
+            {
+                isWritten = WritePng(pixels, width, height, framePath);
+            }
+
+            if (!isWritten)
+            {
+                __sync_fetch_and_add(failedFrameCount, 1);
+            }
+
+            [framePath release];
+            free(pixels);
+            dispatch_semaphore_signal(framesInFlight);
+        }
+    });
+
+    ++_frame;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        ExportNextFrame();
+    });
+}
+
+void LAppFrameExporter::FinishExport()
+{
+    dispatch_group_notify(_encodeGroup, dispatch_get_main_queue(), ^{
+        dispatch_release(_encodeGroup);
+        dispatch_release(_framesInFlight);
+        _encodeGroup = NULL;
+        _framesInFlight = NULL;
+
+        if (_rawFile >= 0)
+        {
+            close(_rawFile);
+            _rawFile = -1;
+        }
+
+        const double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _beginTime).count();
+        LAppPal::PrintLogLn("[APP]exported %d frames of [%s] (%ux%u) in %.2f s: %.1f frames/s",
+                            _frameCount, _motionName.GetRawString(), _surface.GetBufferWidth(), _surface.GetBufferHeight(), elapsedSeconds,
+                            elapsedSeconds > 0.0 ? _frameCount / elapsedSeconds : 0.0);
+
+        csmInt32 frameCount = _frameCount;
+        if (_failedFrameCount > 0)
+        {
+            LAppPal::PrintLogLn("[APP]failed to write %d frames.", _failedFrameCount);
+            frameCount = -1;
+        }
+
+        _softwareRenderer->SetRenderTarget(NULL);
+        _surface.DestroyOffscreenSurface();
+        _motionManager->StopAllMotions();
+
+        // completionの中でインスタンスが破棄されてもよいように、メンバを片付けてから呼ぶ
+        CompletionHandler completion = _completion;
+        _completion = NULL;
+        completion(frameCount);
+        Block_release(completion);
+    });
+}
+
+void LAppFrameExporter::UpdateSimulation(csmFloat32 deltaTimeSeconds)
+{
+    //-----------------------------------------------------------------
+    _model->LoadParameters(); // 前回セーブされた状態をロード
+    const csmBool motionUpdated = _motionManager->UpdateMotion(_model, deltaTimeSeconds); // モーションを更新
+    _model->SaveParameters(); // 状態を保存
+    //-----------------------------------------------------------------
+
+    // まばたき
+    if (!motionUpdated && _eyeBlink != NULL)
+    {
+        _eyeBlink->UpdateParameters(_model, deltaTimeSeconds); // 目パチ
+    }
+
+    // 物理演算の設定
+    if (_physics != NULL)
+    {
+        _physics->Evaluate(_model, deltaTimeSeconds);
+    }
+
+    // ポーズの設定
+    if (_pose != NULL)
+    {
+        _pose->UpdateParameters(_model, deltaTimeSeconds);
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#ifndef LAppImpostor_h
+#define LAppImpostor_h
+
+#import <GLKit/GLKit.h>
+#import <CubismFramework.hpp>
+#import <CubismMatrix44.hpp>
+#import <CubismModel.hpp>
+#import <CubismRenderer_OpenGLES2.hpp>
+#import <CubismOffscreenSurface_OpenGLES2.hpp>
+#import "LAppImpostorCache.h"
+
+/**
+ * @brief モデルを描画済みのテクスチャで代替表示するクラス
+ *
+ * モデルを画面上の解像度でテクスチャに描画しておき、パラメータ・パーツ不透明度・モデルの不透明度が変わらず、
+ * 画面上の大きさの変化が許容範囲内であれば、テクスチャを貼った矩形を描画するだけで済ませる。
+ * テクスチャはモデルの座標系で保持するため、移動・回転しただけであれば描き直さない。
+ * 状態が変わり続けている間は直接描画し、止まったフレームでテクスチャを描き直す。
+ * 画面上で小さく表示されているモデルは、状態が変わっていても一定間隔でのみ描き直す。
+ * いずれを行うかはLAppImpostorCacheが決める。
+ */
+class LAppImpostor
+{
+public:
+    /**
+     * @brief コンストラクタ
+     */
+    LAppImpostor();
+
+    /**
+     * @brief デストラクタ
+     */
+    ~LAppImpostor();
+
+    /**
+     * @brief 描画済みのテクスチャでモデルを描画する
+     *
+     * @param[in]   model           描画するモデル
+     * @param[in]   renderer        モデルのレンダラ。テクスチャを描き直す際に使用する
+     * @param[in]   mvp             モデル行列を含むView-Projection行列
+     * @param[in]   viewportWidth   ビューポートの幅[px]
+     * @param[in]   viewportHeight  ビューポートの高さ[px]
+     * @param[in]   deltaTimeSeconds    前回の描画からの経過時間[秒]
+     *
+     * @return  描画した場合はtrue。モデルの状態が変わっている間はfalseを返すので、呼び出し側で直接描画する
+     */
+    Csm::csmBool Draw(Csm::CubismModel* model, Csm::Rendering::CubismRenderer_OpenGLES2* renderer, Csm::CubismMatrix44& mvp,
+                      Csm::csmFloat32 viewportWidth, Csm::csmFloat32 viewportHeight, Csm::csmFloat32 deltaTimeSeconds);
+
+    /**
+     * @brief モデルをテクスチャで代替表示できるかどうかを調べる<br>
+     *         加算・乗算のDrawableは描画先の色と合成するため、透明な背景に描いたテクスチャでは結果が変わる。
+     *
+     * @param[in]   model   モデル
+     *
+     * @return  全てのDrawableが通常の合成であればtrue
+     */
+    static Csm::csmBool IsSupported(Csm::CubismModel* model);
+
+    /**
+     * @brief テクスチャ等のOpenGLのリソースを解放する<br>
+     *         レンダラを作り直す際に呼び出す。次回の描画でテクスチャを描き直す。
+     */
+    void Release();
+
+private:
+    /**
+     * @brief 表示されているDrawableの頂点を囲む矩形をモデルの座標系で求める
+     *
+     * @param[in]   model   モデル
+     *
+     * @return  表示されている頂点が無い場合はfalse
+     */
+    Csm::csmBool CalculateBounds(Csm::CubismModel* model);
+
+    /**
+     * @brief モデルの現在の状態をテクスチャに描き直す
+     *
+     * @param[in]   model           描画するモデル
+     * @param[in]   renderer        モデルのレンダラ
+     * @param[in]   mvp             モデル行列を含むView-Projection行列
+     * @param[in]   viewportWidth   ビューポートの幅[px]
+     * @param[in]   viewportHeight  ビューポートの高さ[px]
+     *
+     * @return  描き直した場合はtrue。表示されているDrawableが無い場合はfalse
+     */
+    Csm::csmBool Refresh(Csm::CubismModel* model, Csm::Rendering::CubismRenderer_OpenGLES2* renderer, Csm::CubismMatrix44& mvp,
+                         Csm::csmFloat32 viewportWidth, Csm::csmFloat32 viewportHeight);
+
+    /**
+     * @brief テクスチャを貼った矩形を描画する
+     *
+     * @param[in]   mvp     モデル行列を含むView-Projection行列
+     */
+    void DrawCached(Csm::CubismMatrix44& mvp);
+
+    Csm::Rendering::CubismOffscreenSurface_OpenGLES2 _surface; ///< モデルを描画したテクスチャ
+    GLKBaseEffect* _effect; ///< 矩形の描画に使用するエフェクト
+    LAppImpostorCache _cache; ///< テクスチャを描き直すかどうかの判断
+    Csm::csmFloat32 _boundsLeft; ///< テクスチャに描画した範囲の左端（モデルの座標系）
+    Csm::csmFloat32 _boundsRight; ///< テクスチャに描画した範囲の右端（モデルの座標系）
+    Csm::csmFloat32 _boundsBottom; ///< テクスチャに描画した範囲の下端（モデルの座標系）
+    Csm::csmFloat32 _boundsTop; ///< テクスチャに描画した範囲の上端（モデルの座標系）
+};
+
+#endif /* LAppImpostor_h */
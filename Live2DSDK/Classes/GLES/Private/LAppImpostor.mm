@@ -0,0 +1,243 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#import "LAppImpostor.h"
+#import <cfloat>
+#import <CubismMath.hpp>
+#import "LAppDefine.h"
+
+using namespace Csm;
+using namespace LAppDefine;
+
+namespace {
+    const csmUint32 TextureSizeAlignment = 16;    ///< テクスチャの一辺をこの値の倍数に揃え、大きさが少し変わる度に作り直さないようにする
+
+    /**
+     * @brief 画面上の長さ[px]からテクスチャの一辺の長さを求める
+     */
+    csmUint32 CalculateTextureSize(csmFloat32 length)
+    {
+        csmUint32 size = static_cast<csmUint32>(length) + 2;
+        size = (size + TextureSizeAlignment - 1) / TextureSizeAlignment * TextureSizeAlignment;
+
+        if (size > static_cast<csmUint32>(ImpostorMaxTextureSize))
+        {
+            size = static_cast<csmUint32>(ImpostorMaxTextureSize);
+        }
+
+        return size;
+    }
+}
+
+LAppImpostor::LAppImpostor()
+: _effect(nil)
+, _cache(ImpostorParameterTolerance, ImpostorScaleTolerance, ImpostorSmallModelHeight, ImpostorSmallModelRefreshInterval)
+, _boundsLeft(0.0f)
+, _boundsRight(0.0f)
+, _boundsBottom(0.0f)
+, _boundsTop(0.0f)
+{
+}
+
+LAppImpostor::~LAppImpostor()
+{
+    Release();
+}
+
+void LAppImpostor::Release()
+{
+    if (_surface.IsValid())
+    {
+        _surface.DestroyOffscreenSurface();
+    }
+
+    [_effect release];
+    _effect = nil;
+
+    _cache.Invalidate();
+}
+
+csmBool LAppImpostor::Draw(CubismModel* model, Rendering::CubismRenderer_OpenGLES2* renderer, CubismMatrix44& mvp,
+                           csmFloat32 viewportWidth, csmFloat32 viewportHeight, csmFloat32 deltaTimeSeconds)
+{
+    switch (_cache.Update(model, mvp, viewportWidth, viewportHeight, deltaTimeSeconds))
+    {
+    case LAppImpostorCache::Action_DrawDirect:
+        return false;
+
+    case LAppImpostorCache::Action_Refresh:
+        if (!Refresh(model, renderer, mvp, viewportWidth, viewportHeight))
+        {
+            _cache.Invalidate();
+            return false;
+        }
+        _cache.MarkRendered(model);
+        break;
+
+    case LAppImpostorCache::Action_DrawCached:
+    default:
+        break;
+    }
+
+    DrawCached(mvp);
+    return true;
+}
+
+csmBool LAppImpostor::IsSupported(CubismModel* model)
+{
+    return LAppImpostorCache::IsSupported(model);
+}
+
+csmBool LAppImpostor::CalculateBounds(CubismModel* model)
+{
+    csmFloat32 left = FLT_MAX;
+    csmFloat32 right = -FLT_MAX;
+    csmFloat32 bottom = FLT_MAX;
+    csmFloat32 top = -FLT_MAX;
+
+    for (csmInt32 drawableIndex = 0; drawableIndex < model->GetDrawableCount(); ++drawableIndex)
+    {
+        if (!model->GetDrawableDynamicFlagIsVisible(drawableIndex))
+        {
+            continue;
+        }
+
+        const csmInt32 vertexCount = model->GetDrawableVertexCount(drawableIndex);
+        const csmFloat32* vertices = model->GetDrawableVertices(drawableIndex);
+
+        for (csmInt32 i = 0; i < vertexCount; ++i)
+        {
+            const csmFloat32 x = vertices[i * 2];
+            const csmFloat32 y = vertices[i * 2 + 1];
+
+            left = (x < left) ? x : left;
+            right = (x > right) ? x : right;
+            bottom = (y < bottom) ? y : bottom;
+            top = (y > top) ? y : top;
+        }
+    }
+
+    if (left >= right || bottom >= top)
+    {
+        return false;
+    }
+
+    _boundsLeft = left;
+    _boundsRight = right;
+    _boundsBottom = bottom;
+    _boundsTop = top;
+
+    return true;
+}
+
+csmBool LAppImpostor::Refresh(CubismModel* model, Rendering::CubismRenderer_OpenGLES2* renderer, CubismMatrix44& mvp,
+                              csmFloat32 viewportWidth, csmFloat32 viewportHeight)
+{
+    if (!CalculateBounds(model))
+    {
+        return false;
+    }
+
+    // 矩形の各辺が画面上で占める長さからテクスチャの大きさを決める（回転していても辺の長さで測る）
+    csmFloat32 corners[6] =
+    {
+        _boundsLeft, _boundsBottom,
+        _boundsRight, _boundsBottom,
+        _boundsLeft, _boundsTop,
+    };
+    mvp.TransformPoints(corners, corners, 3);
+
+    const csmFloat32 widthX = (corners[2] - corners[0]) * 0.5f * viewportWidth;
+    const csmFloat32 widthY = (corners[3] - corners[1]) * 0.5f * viewportHeight;
+    const csmFloat32 heightX = (corners[4] - corners[0]) * 0.5f * viewportWidth;
+    const csmFloat32 heightY = (corners[5] - corners[1]) * 0.5f * viewportHeight;
+
+    const csmUint32 textureWidth = CalculateTextureSize(CubismMath::SqrtF(widthX * widthX + widthY * widthY));
+    const csmUint32 textureHeight = CalculateTextureSize(CubismMath::SqrtF(heightX * heightX + heightY * heightY));
+
+    if (!_surface.IsValid() || _surface.GetBufferWidth() != textureWidth || _surface.GetBufferHeight() != textureHeight)
+    {
+        if (_surface.IsValid())
+        {
+            _surface.DestroyOffscreenSurface();
+        }
+        _surface.CreateOffscreenSurface(textureWidth, textureHeight);
+    }
+
+    // 縁の頂点が欠けないよう、1テクセル分広げておく
+    const csmFloat32 marginX = (_boundsRight - _boundsLeft) / textureWidth;
+    const csmFloat32 marginY = (_boundsTop - _boundsBottom) / textureHeight;
+    _boundsLeft -= marginX;
+    _boundsRight += marginX;
+    _boundsBottom -= marginY;
+    _boundsTop += marginY;
+
+    // 描画範囲がテクスチャ全体に収まるように変換する
+    const csmFloat32 boundsWidth = _boundsRight - _boundsLeft;
+    const csmFloat32 boundsHeight = _boundsTop - _boundsBottom;
+    CubismMatrix44 textureMatrix;
+    textureMatrix.Scale(2.0f / boundsWidth, 2.0f / boundsHeight);
+    textureMatrix.Translate(-(_boundsLeft + _boundsRight) / boundsWidth, -(_boundsBottom + _boundsTop) / boundsHeight);
+
+    GLint lastFBO;
+    GLint lastViewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &lastFBO);
+    glGetIntegerv(GL_VIEWPORT, lastViewport);
+
+    _surface.BeginDraw(lastFBO);
+    glViewport(0, 0, textureWidth, textureHeight);
+    _surface.Clear(0.0f, 0.0f, 0.0f, 0.0f);
+
+    renderer->SetMvpMatrix(&textureMatrix);
+    renderer->DrawModel();
+
+    _surface.EndDraw();
+    glViewport(lastViewport[0], lastViewport[1], lastViewport[2], lastViewport[3]);
+
+    return true;
+}
+
+void LAppImpostor::DrawCached(CubismMatrix44& mvp)
+{
+    if (_effect == nil)
+    {
+        _effect = [[GLKBaseEffect alloc] init];
+        _effect.useConstantColor = GL_TRUE;
+        _effect.constantColor = GLKVector4Make(1.0f, 1.0f, 1.0f, 1.0f);
+        _effect.texture2d0.enabled = GL_TRUE;
+    }
+
+    // 位置3要素、テクスチャ座標2要素
+    const GLfloat vertices[] =
+    {
+        _boundsLeft,  _boundsBottom, 0.0f,  0.0f, 0.0f,
+        _boundsRight, _boundsBottom, 0.0f,  1.0f, 0.0f,
+        _boundsLeft,  _boundsTop,    0.0f,  0.0f, 1.0f,
+        _boundsRight, _boundsTop,    0.0f,  1.0f, 1.0f,
+    };
+
+    _effect.texture2d0.name = _surface.GetColorBuffer();
+    _effect.transform.projectionMatrix = GLKMatrix4MakeWithArray(mvp.GetArray());
+    [_effect prepareToDraw];
+
+    // テクスチャは乗算済みアルファで描画されている
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glEnableVertexAttribArray(GLKVertexAttribPosition);
+    glVertexAttribPointer(GLKVertexAttribPosition, 3, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 5, vertices);
+    glEnableVertexAttribArray(GLKVertexAttribTexCoord0);
+    glVertexAttribPointer(GLKVertexAttribTexCoord0, 2, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 5, vertices + 3);
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    // 頂点配列はこの関数内のものなので、以降の描画で参照されないよう無効にしておく
+    glDisableVertexAttribArray(GLKVertexAttribPosition);
+    glDisableVertexAttribArray(GLKVertexAttribTexCoord0);
+}
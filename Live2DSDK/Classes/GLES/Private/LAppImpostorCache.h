@@ -0,0 +1,127 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#ifndef LAppImpostorCache_h
+#define LAppImpostorCache_h
+
+#import <CubismFramework.hpp>
+#import <CubismMatrix44.hpp>
+#import <CubismModel.hpp>
+
+/**
+ * @brief 描画済みのテクスチャでモデルを代替表示できるかを判断するクラス
+ *
+ * テクスチャを描画した時点のパラメータ・パーツ不透明度・モデルの不透明度と画面上の高さを記録しておき、
+ * フレーム毎に直接描画・テクスチャの描き直し・テクスチャの表示のいずれを行うかを決める。
+ * 画面上の高さはモデルのY軸の長さで測るため、移動・回転しただけであればテクスチャを描き直さない。
+ * OpenGLを使わないため、LAppImpostorから切り離してテストできる。
+ */
+class LAppImpostorCache
+{
+public:
+    /**
+     * @brief フレーム毎に行う描画
+     */
+    enum Action
+    {
+        Action_DrawDirect = 0,  ///< モデルの状態が変わっているため、直接描画する
+        Action_Refresh,         ///< テクスチャを描き直してから表示する
+        Action_DrawCached       ///< 描画済みのテクスチャをそのまま表示する
+    };
+
+    /**
+     * @brief コンストラクタ
+     *
+     * @param[in]   parameterTolerance          パラメータ・パーツ不透明度の変化をこの値以下であれば無視する
+     * @param[in]   scaleTolerance              画面上の高さの変化がこの割合以下であればテクスチャを描き直さない
+     * @param[in]   smallModelHeight            画面上の高さ[px]がこの値未満のモデルは動いていてもテクスチャで表示する
+     * @param[in]   smallModelRefreshInterval   小さく表示されているモデルのテクスチャを描き直す間隔[秒]
+     */
+    LAppImpostorCache(Csm::csmFloat32 parameterTolerance, Csm::csmFloat32 scaleTolerance,
+                      Csm::csmFloat32 smallModelHeight, Csm::csmFloat32 smallModelRefreshInterval);
+
+    /**
+     * @brief デストラクタ
+     */
+    ~LAppImpostorCache();
+
+    /**
+     * @brief このフレームで行う描画を決める
+     *
+     * Action_DrawDirectを返した場合は、その時点の状態を記録し、次に状態が変わらなかったフレームで描き直す。
+     *
+     * @param[in]   model               モデル
+     * @param[in]   mvp                 モデル行列を含むView-Projection行列
+     * @param[in]   viewportWidth       ビューポートの幅[px]
+     * @param[in]   viewportHeight      ビューポートの高さ[px]
+     * @param[in]   deltaTimeSeconds    前回の描画からの経過時間[秒]
+     *
+     * @return  行う描画
+     */
+    Action Update(Csm::CubismModel* model, Csm::CubismMatrix44& mvp,
+                  Csm::csmFloat32 viewportWidth, Csm::csmFloat32 viewportHeight, Csm::csmFloat32 deltaTimeSeconds);
+
+    /**
+     * @brief テクスチャを描き直したことを記録する<br>
+     *         Action_Refreshを返したフレームで描き直しが済んだ後に呼び出す。
+     *
+     * @param[in]   model   描き直したモデル
+     */
+    void MarkRendered(Csm::CubismModel* model);
+
+    /**
+     * @brief テクスチャを無効にする。次回のUpdateで描き直しを求める
+     */
+    void Invalidate();
+
+    /**
+     * @brief 最後にUpdateで求めたモデルの画面上の高さ[px]を取得する
+     */
+    Csm::csmFloat32 GetScreenHeight() const;
+
+    /**
+     * @brief モデルをテクスチャで代替表示できるかどうかを調べる<br>
+     *         加算・乗算のDrawableは描画先の色と合成するため、透明な背景に描いたテクスチャでは結果が変わる。
+     *
+     * @param[in]   model   モデル
+     *
+     * @return  全てのDrawableが通常の合成であればtrue
+     */
+    static Csm::csmBool IsSupported(Csm::CubismModel* model);
+
+private:
+    /**
+     * @brief 記録した時点からモデルの状態が変わったかどうかを調べる
+     *
+     * @param[in]   model   モデル
+     *
+     * @return  変わっている場合はtrue
+     */
+    Csm::csmBool IsStateChanged(Csm::CubismModel* model);
+
+    /**
+     * @brief モデルの現在の状態を記録する
+     *
+     * @param[in]   model   モデル
+     */
+    void CaptureState(Csm::CubismModel* model);
+
+    Csm::csmFloat32 _parameterTolerance; ///< パラメータ・パーツ不透明度の変化を無視する幅
+    Csm::csmFloat32 _scaleTolerance; ///< 画面上の高さの変化を無視する割合
+    Csm::csmFloat32 _smallModelHeight; ///< 小さく表示されているとみなす画面上の高さ[px]
+    Csm::csmFloat32 _smallModelRefreshInterval; ///< 小さく表示されているモデルのテクスチャを描き直す間隔[秒]
+    Csm::csmVector<Csm::csmFloat32> _parameterValues; ///< 記録したパラメータの値
+    Csm::csmVector<Csm::csmFloat32> _partOpacities; ///< 記録したパーツの不透明度
+    Csm::csmVector<Csm::CubismModel::ParameterDiff> _parameterDiffs; ///< パラメータの比較に使用する作業領域
+    Csm::csmFloat32 _modelOpacity; ///< 記録したモデルの不透明度
+    Csm::csmFloat32 _screenHeight; ///< 最後にUpdateで求めた画面上の高さ[px]
+    Csm::csmFloat32 _renderedScreenHeight; ///< テクスチャを描画した時点の画面上の高さ[px]
+    Csm::csmFloat32 _elapsedSeconds; ///< テクスチャを描画してからの経過時間[秒]
+    Csm::csmBool _isTextureValid; ///< テクスチャが記録した状態を描画したものかどうか
+};
+
+#endif /* LAppImpostorCache_h */
@@ -0,0 +1,160 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#import "LAppImpostorCache.h"
+#import <CubismMath.hpp>
+#import <CubismRenderer.hpp>
+
+using namespace Csm;
+
+LAppImpostorCache::LAppImpostorCache(csmFloat32 parameterTolerance, csmFloat32 scaleTolerance,
+                                     csmFloat32 smallModelHeight, csmFloat32 smallModelRefreshInterval)
+: _parameterTolerance(parameterTolerance)
+, _scaleTolerance(scaleTolerance)
+, _smallModelHeight(smallModelHeight)
+, _smallModelRefreshInterval(smallModelRefreshInterval)
+, _modelOpacity(1.0f)
+, _screenHeight(0.0f)
+, _renderedScreenHeight(0.0f)
+, _elapsedSeconds(0.0f)
+, _isTextureValid(false)
+{
+}
+
+LAppImpostorCache::~LAppImpostorCache()
+{
+}
+
+LAppImpostorCache::Action LAppImpostorCache::Update(CubismModel* model, CubismMatrix44& mvp,
+                                                    csmFloat32 viewportWidth, csmFloat32 viewportHeight, csmFloat32 deltaTimeSeconds)
+{
+    _elapsedSeconds += deltaTimeSeconds;
+
+    // モデルのY軸が画面上で占める長さを高さとする。回転しても変わらない
+    const csmFloat32 axisX = mvp.GetArray()[4] * viewportWidth;
+    const csmFloat32 axisY = mvp.GetArray()[5] * viewportHeight;
+    _screenHeight = CubismMath::SqrtF(axisX * axisX + axisY * axisY) * model->GetCanvasHeight() * 0.5f;
+
+    const csmBool isStateChanged = IsStateChanged(model);
+    const csmBool isScaleChanged = CubismMath::AbsF(_screenHeight - _renderedScreenHeight) > _renderedScreenHeight * _scaleTolerance;
+
+    if (_screenHeight < _smallModelHeight)
+    {
+        // 小さく表示されているモデルは、状態が変わっていても一定間隔でのみ描き直す
+        if (!_isTextureValid || ((isStateChanged || isScaleChanged) && _elapsedSeconds >= _smallModelRefreshInterval))
+        {
+            return Action_Refresh;
+        }
+
+        return Action_DrawCached;
+    }
+
+    if (isStateChanged)
+    {
+        // 動いている間はテクスチャを経由すると余分な描画になるため、直接描画させる
+        CaptureState(model);
+        _isTextureValid = false;
+        return Action_DrawDirect;
+    }
+
+    if (!_isTextureValid || isScaleChanged)
+    {
+        return Action_Refresh;
+    }
+
+    return Action_DrawCached;
+}
+
+void LAppImpostorCache::MarkRendered(CubismModel* model)
+{
+    CaptureState(model);
+
+    _renderedScreenHeight = _screenHeight;
+    _elapsedSeconds = 0.0f;
+    _isTextureValid = true;
+}
+
+void LAppImpostorCache::Invalidate()
+{
+    _isTextureValid = false;
+}
+
+csmFloat32 LAppImpostorCache::GetScreenHeight() const
+{
+    return _screenHeight;
+}
+
+csmBool LAppImpostorCache::IsSupported(CubismModel* model)
+{
+    for (csmInt32 i = 0; i < model->GetDrawableCount(); ++i)
+    {
+        if (model->GetDrawableBlendMode(i) != Rendering::CubismRenderer::CubismBlendMode_Normal)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+csmBool LAppImpostorCache::IsStateChanged(CubismModel* model)
+{
+    const csmInt32 parameterCount = model->GetParameterCount();
+    const csmInt32 partCount = model->GetPartCount();
+
+    if (static_cast<csmInt32>(_parameterValues.GetSize()) != parameterCount ||
+        static_cast<csmInt32>(_partOpacities.GetSize()) != partCount)
+    {
+        return true;
+    }
+
+    if (model->GetModelOpacity() != _modelOpacity)
+    {
+        return true;
+    }
+
+    if (model->DiffParameters(_parameterValues.GetPtr(), _parameterTolerance, _parameterDiffs.GetPtr()) > 0)
+    {
+        return true;
+    }
+
+    for (csmInt32 i = 0; i < partCount; ++i)
+    {
+        if (CubismMath::AbsF(model->GetPartOpacity(i) - _partOpacities[i]) > _parameterTolerance)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void LAppImpostorCache::CaptureState(CubismModel* model)
+{
+    const csmInt32 parameterCount = model->GetParameterCount();
+    const csmInt32 partCount = model->GetPartCount();
+
+    if (static_cast<csmInt32>(_parameterValues.GetSize()) != parameterCount)
+    {
+        _parameterValues.Clear();
+        _parameterDiffs.Clear();
+        _parameterValues.UpdateSize(parameterCount, 0.0f, true);
+        _parameterDiffs.UpdateSize(parameterCount, CubismModel::ParameterDiff(), true);
+    }
+    if (static_cast<csmInt32>(_partOpacities.GetSize()) != partCount)
+    {
+        _partOpacities.Clear();
+        _partOpacities.UpdateSize(partCount, 0.0f, true);
+    }
+
+    model->CaptureParameters(_parameterValues.GetPtr());
+    for (csmInt32 i = 0; i < partCount; ++i)
+    {
+        _partOpacities[i] = model->GetPartOpacity(i);
+    }
+    _modelOpacity = model->GetModelOpacity();
+}
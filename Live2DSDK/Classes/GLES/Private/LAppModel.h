@@ -13,6 +13,9 @@
 #import <ICubismModelSetting.hpp>
 #import <csmRectF.hpp>
 #import <CubismOffscreenSurface_OpenGLES2.hpp>
+#import <CubismRenderCommandList.hpp>
+#import "LAppVowelAnalyzer.h"
+#import "LAppImpostor.h"
 
 /**
  * @brief ユーザーが実際に使用するモデルの実装クラス<br>
@@ -40,6 +43,16 @@ public:
      */
     void LoadAssets(const char* dir, const char* fileName);
 
+    /**
+     * @brief 読み込み済みのモデルと同じモデルを、データを共有して生成する<br>
+     *         MOC・モーション・表情・モデルセッティング・クリッピングマスク・テクスチャを共有し、
+     *         パラメータ・物理演算・ポーズ・まばたき・呼吸の状態はインスタンス毎に持つ。
+     *         共有元は共有先より後に破棄すること。
+     *
+     * @param[in]   source  LoadAssetsで読み込み済みのモデル
+     */
+    void LoadAssetsShared(LAppModel* source);
+
     /**
      * @brief レンダラを再構築する
      *
@@ -49,9 +62,21 @@ public:
     /**
      * @brief   モデルの更新処理。モデルのパラメータから描画状態を決定する。
      *
+     * モーション・物理演算等はLAppPal::GetFrameTimerの固定ステップで更新し、
+     * 描画には直近2ステップのパラメータを補間した値を使用する。
      */
     void Update();
 
+    /**
+     * @brief   画面外のため描画を省略しているモデルの更新処理
+     *
+     * OffscreenModelUpdateIntervalごとに、それまでの経過時間をまとめて1回更新し、モデルの矩形を計算し直す。
+     * 動いて画面内に戻ったモデルをIsInViewportで検出できるようにするため、描画しない間も呼び出す。
+     *
+     * @param[in]   deltaTimeSeconds    前回の呼び出しからの経過時間[秒]
+     */
+    void UpdateOffscreen(Csm::csmFloat32 deltaTimeSeconds);
+
     /**
      * @brief   モデルを描画する処理。モデルを描画する空間のView-Projection行列を渡す。
      *
@@ -59,6 +84,55 @@ public:
      */
     void Draw(Csm::CubismMatrix44& matrix);
 
+    /**
+     * @brief   モデルを描画する処理。状態が変わっていない間は描画済みのテクスチャで表示する。<br>
+     *          加算・乗算のDrawableを持つモデルは常に直接描画する。
+     *
+     * @param[in]  matrix              View-Projection行列
+     * @param[in]  viewportWidth       ビューポートの幅[px]
+     * @param[in]  viewportHeight      ビューポートの高さ[px]
+     * @param[in]  deltaTimeSeconds    前回の描画からの経過時間[秒]
+     */
+    void DrawWithImpostor(Csm::CubismMatrix44& matrix, Csm::csmFloat32 viewportWidth, Csm::csmFloat32 viewportHeight, Csm::csmFloat32 deltaTimeSeconds);
+
+    /**
+     * @brief   RecordDrawが使うメモリを確保する。描画スレッドから呼び出す。
+     *
+     * CubismFrameworkのアロケータはスレッドセーフではないため、RecordDrawを描画スレッド以外から呼び出す前に必ず呼び出す。
+     */
+    void PrepareRecordDraw();
+
+    /**
+     * @brief   モデルの描画をコマンドリストに記録する。OpenGLの命令は発行しないため、描画スレッド以外から呼び出せる。
+     *
+     * 描画はExecuteRecordedDrawで行う。データを共有しているモデル同士はクリッピングマスクも共有するため、同時に記録しないこと。
+     * 描画スレッド以外から呼び出す場合は、事前にPrepareRecordDrawを呼び出しておく。
+     *
+     * @param[in]  matrix  View-Projection行列
+     */
+    void RecordDraw(Csm::CubismMatrix44& matrix);
+
+    /**
+     * @brief   RecordDrawで記録した描画を実行する。描画スレッドから呼び出す。
+     *
+     * 記録できなかった場合（高精細マスクを使用している場合）は通常の描画を行う。
+     */
+    void ExecuteRecordedDraw();
+
+    /**
+     * @brief   データの共有元を取得する
+     *
+     * @return  共有元のモデル。共有していない場合はNULL
+     */
+    LAppModel* GetSharedSource() const;
+
+    /**
+     * @brief   描画済みのテクスチャで代替表示できるモデルかどうかを取得する
+     *
+     * @return  全てのDrawableが通常の合成であればtrue
+     */
+    Csm::csmBool IsImpostorSupported() const;
+
     /**
      * @brief   引数で指定したモーションの再生を開始する。
      *
@@ -111,6 +185,36 @@ public:
      */
     virtual Csm::csmBool HitTest(const Csm::csmChar* hitAreaName, Csm::csmFloat32 x, Csm::csmFloat32 y);
 
+    /**
+     * @brief   音声解析による母音リップシンクの結果を設定する
+     *
+     * 次回のUpdateで、モデルに母音パラメータ（ParamA等）があればその値に反映する。
+     *
+     * @param[in]   frame   母音解析の結果
+     */
+    void SetLipSyncVisemes(const LAppVowelAnalyzer::VisemeFrame& frame);
+
+    /**
+     * @brief   画面上の表示サイズから物理演算の詳細度を決める
+     *
+     * モデルのキャンバスが画面上で何ピクセルの高さになるかを求め、小さく表示されている場合は物理演算を間引く、または止める。
+     * Updateの前に呼び出す。
+     *
+     * @param[in]   projection      描画に使用するView-Projection行列（モデル行列は含まない）
+     * @param[in]   viewportHeight  ビューポートの高さ[px]
+     */
+    void UpdatePhysicsLevelOfDetail(Csm::CubismMatrix44& projection, Csm::csmFloat32 viewportHeight);
+
+    /**
+     * @brief   前回の描画で計算したモデルの矩形が画面内に入るかを判定する
+     *
+     * Updateの前に呼び出し、画面外であれば描画を省略してUpdateOffscreenで低い頻度で更新するために使用する。
+     *
+     * @param[in]   projection      描画に使用するView-Projection行列（モデル行列は含まない）
+     * @return      画面内に入る場合、またはまだ描画していないため判定できない場合はtrue
+     */
+    Csm::csmBool IsInViewport(Csm::CubismMatrix44& projection);
+
     /**
      * @brief   別ターゲットに描画する際に使用するバッファの取得
      */
@@ -140,6 +244,18 @@ private:
      */
     void SetupTextures();
 
+    /**
+     * @brief   モーション・物理演算等によるパラメータの更新を1ステップ分行う
+     *
+     * @param[in]   deltaTimeSeconds    1ステップの時間[秒]
+     */
+    void UpdateSimulation(Csm::csmFloat32 deltaTimeSeconds);
+
+    /**
+     * @brief ドラッグ・リップシンクで毎ステップ更新するパラメータのインデックスを解決し、まとめて適用するためのリストを作成する
+     */
+    void SetupParameterUpdates();
+
     /**
      * @brief   モーションデータをグループ名から一括でロードする。<br>
      *           モーションデータの名前は内部でModelSettingから取得する。
@@ -171,8 +287,10 @@ private:
     void ReleaseExpressions();
 
     Csm::ICubismModelSetting* _modelSetting; ///< モデルセッティング情報
+    LAppModel* _sharedSource; ///< データの共有元。共有していない場合はNULL
     Csm::csmString _modelHomeDir; ///< モデルセッティングが置かれたディレクトリ
     Csm::csmFloat32 _userTimeSeconds; ///< デルタ時間の積算値[秒]
+    Csm::csmFloat32 _offscreenElapsedSeconds; ///< 画面外で最後に更新してからの経過時間[秒]
     Csm::csmVector<Csm::CubismIdHandle> _eyeBlinkIds; ///< モデルに設定されたまばたき機能用パラメータID
     Csm::csmVector<Csm::CubismIdHandle> _lipSyncIds; ///< モデルに設定されたリップシンク機能用パラメータID
     Csm::csmMap<Csm::csmString, Csm::ACubismMotion*>   _motions; ///< 読み込まれているモーションのリスト
@@ -185,6 +303,17 @@ private:
     const Csm::CubismId* _idParamBodyAngleX; ///< パラメータID: ParamBodyAngleX
     const Csm::CubismId* _idParamEyeBallX; ///< パラメータID: ParamEyeBallX
     const Csm::CubismId* _idParamEyeBallY; ///< パラメータID: ParamEyeBallXY
+    Csm::csmInt32 _vowelParameterIndices[LAppVowelAnalyzer::Vowel_Count]; ///< 母音リップシンク用パラメータのインデックス。モデルに無い場合は-1
+    LAppVowelAnalyzer::VisemeFrame _visemeFrame; ///< 母音解析の最新の結果
+    Csm::csmVector<Csm::csmFloat32> _previousParameterValues; ///< 1つ前のステップで更新したパラメータの値
+    Csm::csmVector<Csm::csmFloat32> _currentParameterValues; ///< 最後のステップで更新したパラメータの値
+    Csm::csmVector<Csm::csmFloat32> _blendedParameterValues; ///< 描画用に補間したパラメータの値
+    Csm::csmVector<Csm::CubismModel::ParameterUpdate> _dragParameterUpdates; ///< ドラッグによるパラメータの更新（AngleX, AngleY, AngleZ, BodyAngleX, EyeBallX, EyeBallYの順）
+    Csm::csmVector<Csm::CubismModel::ParameterUpdate> _lipSyncParameterUpdates; ///< リップシンクによるパラメータの更新（リップシンク用パラメータ、母音の順）
+    LAppImpostor _impostor; ///< 描画済みのテクスチャによる表示
+    Csm::csmBool _isImpostorSupported; ///< テクスチャで代替表示できるモデルか
+    Csm::Rendering::CubismRenderCommandList _drawCommandList; ///< RecordDrawで記録した描画コマンド
+    Csm::csmBool _isDrawRecorded; ///< _drawCommandListに記録できたか
 
     Csm::Rendering::CubismOffscreenSurface_OpenGLES2 _renderBuffer;
 };
@@ -17,6 +17,8 @@
 #import <CubismString.hpp>
 #import <CubismIdManager.hpp>
 #import <CubismMotionQueueEntry.hpp>
+#import <CubismMath.hpp>
+#import <CubismProfiler.hpp>
 #import "LAppDefine.h"
 #import "LAppPal.h"
 
@@ -50,7 +52,11 @@ namespace {
 LAppModel::LAppModel()
 : CubismUserModel()
 , _modelSetting(NULL)
+, _sharedSource(NULL)
 , _userTimeSeconds(0.0f)
+, _offscreenElapsedSeconds(0.0f)
+, _isImpostorSupported(false)
+, _isDrawRecorded(false)
 {
     if (DebugLogEnable)
     {
@@ -63,12 +69,24 @@ LAppModel::LAppModel()
     _idParamBodyAngleX = CubismFramework::GetIdManager()->GetId(ParamBodyAngleX);
     _idParamEyeBallX = CubismFramework::GetIdManager()->GetId(ParamEyeBallX);
     _idParamEyeBallY = CubismFramework::GetIdManager()->GetId(ParamEyeBallY);
+
+    memset(&_visemeFrame, 0, sizeof(_visemeFrame));
+    for (csmInt32 i = 0; i < LAppVowelAnalyzer::Vowel_Count; ++i)
+    {
+        _vowelParameterIndices[i] = -1;
+    }
 }
 
 LAppModel::~LAppModel()
 {
     _renderBuffer.DestroyOffscreenSurface();
 
+    // 共有しているデータは共有元が解放する
+    if (_sharedSource != NULL)
+    {
+        return;
+    }
+
     ReleaseMotions();
     ReleaseExpressions();
 
@@ -103,9 +121,41 @@ void LAppModel::LoadAssets(const csmChar* dir, const csmChar* fileName)
         LAppPal::PrintLogLn("Failed to LoadAssets().");
         return;
     }
-    
+
+    _isImpostorSupported = LAppImpostor::IsSupported(_model);
+
+    CreateRenderer();
+
+    SetupTextures();
+}
+
+void LAppModel::LoadAssetsShared(LAppModel* source)
+{
+    if (source == NULL || source->_sharedSource != NULL || source->GetModel() == NULL)
+    {
+        LAppPal::PrintLogLn("Failed to LoadAssetsShared().");
+        return;
+    }
+
+    _sharedSource = source;
+    _modelHomeDir = source->_modelHomeDir;
+
+    SetupModel(source->_modelSetting);
+
+    if (_model == NULL)
+    {
+        LAppPal::PrintLogLn("Failed to LoadAssetsShared().");
+        return;
+    }
+
+    _isImpostorSupported = source->_isImpostorSupported;
+
     CreateRenderer();
 
+    // マスクは描画の度に生成するため、同じモデル同士で1組のバッファを使い回せる
+    GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->ShareClippingMask(source->GetRenderer<Rendering::CubismRenderer_OpenGLES2>());
+
+    // テクスチャはテクスチャマネージャがファイル名で共有する
     SetupTextures();
 }
 
@@ -120,7 +170,11 @@ void LAppModel::SetupModel(ICubismModelSetting* setting)
     csmSizeInt size;
 
     //Cubism Model
-    if (strcmp(_modelSetting->GetModelFileName(), "") != 0)
+    if (_sharedSource != NULL)
+    {
+        ShareModel(_sharedSource);
+    }
+    else if (strcmp(_modelSetting->GetModelFileName(), "") != 0)
     {
         csmString path = _modelSetting->GetModelFileName();
         path = _modelHomeDir + path;
@@ -131,12 +185,17 @@ void LAppModel::SetupModel(ICubismModelSetting* setting)
         }
 
         buffer = CreateBuffer(path.GetRawString(), &size);
-        LoadModel(buffer, size);
+        LoadModel(buffer, size, MocConsistencyValidationEnable);
         DeleteBuffer(buffer, path.GetRawString());
     }
 
     //Expression
-    if (_modelSetting->GetExpressionCount() > 0)
+    if (_sharedSource != NULL)
+    {
+        // フェードの状態は表情マネージャとキューのエントリが持つ
+        _expressions = _sharedSource->_expressions;
+    }
+    else if (_modelSetting->GetExpressionCount() > 0)
     {
         const csmInt32 count = _modelSetting->GetExpressionCount();
         for (csmInt32 i = 0; i < count; i++)
@@ -163,7 +222,12 @@ void LAppModel::SetupModel(ICubismModelSetting* setting)
     }
 
     //Physics
-    if (strcmp(_modelSetting->GetPhysicsFileName(), "") != 0)
+    if (_sharedSource != NULL)
+    {
+        // 設定は共有元と共有し、物理点の状態だけを確保する
+        SharePhysics(_sharedSource);
+    }
+    else if (strcmp(_modelSetting->GetPhysicsFileName(), "") != 0)
     {
         csmString path = _modelSetting->GetPhysicsFileName();
         path = _modelHomeDir + path;
@@ -173,6 +237,11 @@ void LAppModel::SetupModel(ICubismModelSetting* setting)
         DeleteBuffer(buffer, path.GetRawString());
     }
 
+    if (_physics != NULL)
+    {
+        _physics->SetParallelFor(LAppPal::ParallelFor);
+    }
+
     //Pose
     if (strcmp(_modelSetting->GetPoseFileName(), "") != 0)
     {
@@ -233,6 +302,19 @@ void LAppModel::SetupModel(ICubismModelSetting* setting)
         }
     }
 
+    // 母音リップシンク用パラメータ（モデルに存在するものだけ使用する）
+    if (_model != NULL)
+    {
+        for (csmInt32 i = 0; i < LAppVowelAnalyzer::Vowel_Count; ++i)
+        {
+            const CubismIdHandle vowelId = CubismFramework::GetIdManager()->GetId(LipSyncVowelParameterIds[i]);
+            const csmInt32 index = _model->GetParameterIndex(vowelId);
+            _vowelParameterIndices[i] = index < _model->GetParameterCount() ? index : -1;
+        }
+
+        SetupParameterUpdates();
+    }
+
     if (_modelSetting == NULL || _modelMatrix == NULL)
     {
         LAppPal::PrintLogLn("Failed to SetupModel().");
@@ -246,10 +328,18 @@ void LAppModel::SetupModel(ICubismModelSetting* setting)
 
     _model->SaveParameters();
 
-    for (csmInt32 i = 0; i < _modelSetting->GetMotionGroupCount(); i++)
+    if (_sharedSource != NULL)
     {
-        const csmChar* group = _modelSetting->GetMotionGroupName(i);
-        PreloadMotionGroup(group);
+        // 再生中の状態はモーションキューのエントリが持つため、カーブのデータだけを共有できる
+        _motions = _sharedSource->_motions;
+    }
+    else
+    {
+        for (csmInt32 i = 0; i < _modelSetting->GetMotionGroupCount(); i++)
+        {
+            const csmChar* group = _modelSetting->GetMotionGroupName(i);
+            PreloadMotionGroup(group);
+        }
     }
 
     _motionManager->StopAllMotions();
@@ -258,6 +348,42 @@ void LAppModel::SetupModel(ICubismModelSetting* setting)
     _initialized = true;
 }
 
+void LAppModel::SetupParameterUpdates()
+{
+    const CubismIdHandle dragParameterIds[] =
+    {
+        _idParamAngleX, _idParamAngleY, _idParamAngleZ, _idParamBodyAngleX, _idParamEyeBallX, _idParamEyeBallY,
+    };
+    const csmInt32 dragParameterCount = sizeof(dragParameterIds) / sizeof(dragParameterIds[0]);
+
+    CubismModel::ParameterUpdate update;
+    update.Operation = CubismModel::ParameterOperation_Add;
+    update.Value = 0.0f;
+    update.Weight = 1.0f;
+
+    _dragParameterUpdates.Clear();
+    for (csmInt32 i = 0; i < dragParameterCount; ++i)
+    {
+        update.Index = _model->GetParameterIndex(dragParameterIds[i]);
+        _dragParameterUpdates.PushBack(update);
+    }
+
+    _lipSyncParameterUpdates.Clear();
+    for (csmUint32 i = 0; i < _lipSyncIds.GetSize(); ++i)
+    {
+        update.Index = _model->GetParameterIndex(_lipSyncIds[i]);
+        _lipSyncParameterUpdates.PushBack(update);
+    }
+
+    // 母音はステップ毎に有効・無効を切り替えるため、インデックスは適用時に設定する
+    update.Operation = CubismModel::ParameterOperation_Set;
+    update.Index = -1;
+    for (csmInt32 i = 0; i < LAppVowelAnalyzer::Vowel_Count; ++i)
+    {
+        _lipSyncParameterUpdates.PushBack(update);
+    }
+}
+
 void LAppModel::PreloadMotionGroup(const csmChar* group)
 {
     const csmInt32 count = _modelSetting->GetMotionCount(group);
@@ -283,6 +409,16 @@ void LAppModel::PreloadMotionGroup(const csmChar* group)
         {
             tmpMotion->SetEffectIds(_eyeBlinkIds, _lipSyncIds);
 
+            if (MotionBakeEnable)
+            {
+                const CubismMotion::BakeReport report = tmpMotion->Bake(MotionBakeSampleRate, MotionBakeMaxError);
+                if (_debugMode)
+                {
+                    LAppPal::PrintLogLn("[APP]bake motion: [%s_%d] %s, %d frames, %u bytes, max error %.4f",
+                        group, i, report.IsBaked ? "baked" : "analytic", report.FrameCount, static_cast<csmUint32>(report.MemorySize), report.MaxError);
+                }
+            }
+
             if (_motions[name] != NULL)
             {
                 ACubismMotion::Delete(_motions[name]);
@@ -330,7 +466,89 @@ void LAppModel::ReleaseExpressions()
 
 void LAppModel::Update()
 {
-    const csmFloat32 deltaTimeSeconds = LAppPal::GetDeltaTime();
+    const CubismFrameTimer& frameTimer = LAppPal::GetFrameTimer();
+    const csmInt32 parameterCount = _model->GetParameterCount();
+    csmInt32 stepCount = frameTimer.GetStepCount();
+    csmBool isFirstStep = false;
+
+    if (static_cast<csmInt32>(_currentParameterValues.GetSize()) != parameterCount)
+    {
+        // 補間元の状態が無いため、必ず1ステップ更新する
+        _previousParameterValues.Clear();
+        _currentParameterValues.Clear();
+        _blendedParameterValues.Clear();
+        _previousParameterValues.UpdateSize(parameterCount, 0.0f, true);
+        _currentParameterValues.UpdateSize(parameterCount, 0.0f, true);
+        _blendedParameterValues.UpdateSize(parameterCount, 0.0f, true);
+        isFirstStep = true;
+        if (stepCount < 1)
+        {
+            stepCount = 1;
+        }
+    }
+
+    for (csmInt32 step = 0; step < stepCount; ++step)
+    {
+        UpdateSimulation(frameTimer.GetFixedDeltaTime());
+
+        for (csmInt32 i = 0; i < parameterCount; ++i)
+        {
+            _previousParameterValues[i] = _currentParameterValues[i];
+        }
+        _model->CaptureParameters(_currentParameterValues.GetPtr());
+
+        if (isFirstStep)
+        {
+            for (csmInt32 i = 0; i < parameterCount; ++i)
+            {
+                _previousParameterValues[i] = _currentParameterValues[i];
+            }
+            isFirstStep = false;
+        }
+    }
+
+    // 描画には直近2ステップの状態を補間した値を使用する
+    const csmFloat32 alpha = frameTimer.GetInterpolationAlpha();
+    for (csmInt32 i = 0; i < parameterCount; ++i)
+    {
+        _blendedParameterValues[i] = _previousParameterValues[i] + (_currentParameterValues[i] - _previousParameterValues[i]) * alpha;
+    }
+    _model->RestoreParameters(_blendedParameterValues.GetPtr());
+
+    CSM_PROFILE_ZONE("CubismModel::Update");
+    _model->Update();
+
+    _offscreenElapsedSeconds = 0.0f;
+}
+
+void LAppModel::UpdateOffscreen(csmFloat32 deltaTimeSeconds)
+{
+    const csmInt32 parameterCount = _model->GetParameterCount();
+
+    _offscreenElapsedSeconds += deltaTimeSeconds;
+    if (_offscreenElapsedSeconds < OffscreenModelUpdateInterval || static_cast<csmInt32>(_currentParameterValues.GetSize()) != parameterCount)
+    {
+        return;
+    }
+
+    // 見えないため補間はせず、経過時間をまとめて1ステップで進める
+    UpdateSimulation(_offscreenElapsedSeconds);
+    _offscreenElapsedSeconds = 0.0f;
+
+    _model->CaptureParameters(_currentParameterValues.GetPtr());
+    for (csmInt32 i = 0; i < parameterCount; ++i)
+    {
+        _previousParameterValues[i] = _currentParameterValues[i];
+    }
+
+    _model->Update();
+    GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->UpdateModelBounds();
+}
+
+void LAppModel::UpdateSimulation(csmFloat32 deltaTimeSeconds)
+{
+    CSM_PROFILE_ZONE("LAppModel::UpdateSimulation");
+
     _userTimeSeconds += deltaTimeSeconds;
 
     _dragManager->Update(deltaTimeSeconds);
@@ -349,6 +567,7 @@ void LAppModel::Update()
     }
     else
     {
+        CSM_PROFILE_ZONE("Motion");
         motionUpdated = _motionManager->UpdateMotion(_model, deltaTimeSeconds); // モーションを更新
     }
     _model->SaveParameters(); // 状態を保存
@@ -363,36 +582,42 @@ void LAppModel::Update()
         if (_eyeBlink != NULL)
         {
             // メインモーションの更新がないとき
+            CSM_PROFILE_ZONE("EyeBlink");
             _eyeBlink->UpdateParameters(_model, deltaTimeSeconds); // 目パチ
         }
     }
 
     if (_expressionManager != NULL)
     {
+        CSM_PROFILE_ZONE("Expression");
         _expressionManager->UpdateMotion(_model, deltaTimeSeconds); // 表情でパラメータ更新（相対変化）
     }
 
     //ドラッグによる変化
     //ドラッグによる顔の向きの調整
-    _model->AddParameterValue(_idParamAngleX, _dragX * 30); // -30から30の値を加える
-    _model->AddParameterValue(_idParamAngleY, _dragY * 30);
-    _model->AddParameterValue(_idParamAngleZ, _dragX * _dragY * -30);
+    _dragParameterUpdates[0].Value = _dragX * 30; // -30から30の値を加える
+    _dragParameterUpdates[1].Value = _dragY * 30;
+    _dragParameterUpdates[2].Value = _dragX * _dragY * -30;
 
     //ドラッグによる体の向きの調整
-    _model->AddParameterValue(_idParamBodyAngleX, _dragX * 10); // -10から10の値を加える
+    _dragParameterUpdates[3].Value = _dragX * 10; // -10から10の値を加える
 
     //ドラッグによる目の向きの調整
-    _model->AddParameterValue(_idParamEyeBallX, _dragX); // -1から1の値を加える
-    _model->AddParameterValue(_idParamEyeBallY, _dragY);
+    _dragParameterUpdates[4].Value = _dragX; // -1から1の値を加える
+    _dragParameterUpdates[5].Value = _dragY;
+
+    _model->ApplyParameterUpdates(_dragParameterUpdates.GetPtr(), _dragParameterUpdates.GetSize());
     // 呼吸など
     if (_breath != NULL)
     {
+        CSM_PROFILE_ZONE("Breath");
         _breath->UpdateParameters(_model, deltaTimeSeconds);
     }
 
     // 物理演算の設定
     if (_physics != NULL)
     {
+        CSM_PROFILE_ZONE("Physics");
         _physics->Evaluate(_model, deltaTimeSeconds);
     }
 
@@ -401,20 +626,35 @@ void LAppModel::Update()
     {
         csmFloat32 value = NYLDModelManager.shared.mouthOpenRate; // リアルタイムでリップシンクを行う場合、システムから音量を取得して0〜1の範囲で値を入力します。
 
-        for (csmUint32 i = 0; i < _lipSyncIds.GetSize(); ++i)
+        // 音声解析が動作している場合は、解析結果の口の開き具合も考慮する
+        if (_visemeFrame.mouthOpen > value)
+        {
+            value = _visemeFrame.mouthOpen;
+        }
+
+        const csmInt32 lipSyncIdCount = static_cast<csmInt32>(_lipSyncIds.GetSize());
+        for (csmInt32 i = 0; i < lipSyncIdCount; ++i)
         {
-            _model->AddParameterValue(_lipSyncIds[i], value, 1.0f);
+            _lipSyncParameterUpdates[i].Value = value;
         }
+
+        // 母音リップシンクの設定
+        for (csmInt32 i = 0; i < LAppVowelAnalyzer::Vowel_Count; ++i)
+        {
+            CubismModel::ParameterUpdate& vowelUpdate = _lipSyncParameterUpdates[lipSyncIdCount + i];
+            vowelUpdate.Index = (_visemeFrame.blockIndex != 0) ? _vowelParameterIndices[i] : -1;
+            vowelUpdate.Value = _visemeFrame.weights[i];
+        }
+
+        _model->ApplyParameterUpdates(_lipSyncParameterUpdates.GetPtr(), _lipSyncParameterUpdates.GetSize());
     }
 
     // ポーズの設定
     if (_pose != NULL)
     {
+        CSM_PROFILE_ZONE("Pose");
         _pose->UpdateParameters(_model, deltaTimeSeconds);
     }
-
-    _model->Update();
-
 }
 
 CubismMotionQueueEntryHandle LAppModel::StartMotion(const csmChar* group, csmInt32 no, csmInt32 priority, ACubismMotion::FinishedMotionCallback onFinishedMotionHandler, ACubismMotion::BeganMotionCallback onBeganMotionHandler)
@@ -447,7 +687,7 @@ CubismMotionQueueEntryHandle LAppModel::StartMotion(const csmChar* group, csmInt
         csmByte* buffer;
         csmSizeInt size;
         buffer = CreateBuffer(path.GetRawString(), &size);
-        motion = static_cast<CubismMotion*>(LoadMotion(buffer, size, NULL, onFinishedMotionHandler, onBeganMotionHandler, _modelSetting, group, no));
+        motion = static_cast<CubismMotion*>(LoadMotion(buffer, size, NULL, NULL, NULL, _modelSetting, group, no));
 
         if (motion)
         {
@@ -457,11 +697,6 @@ CubismMotionQueueEntryHandle LAppModel::StartMotion(const csmChar* group, csmInt
 
         DeleteBuffer(buffer, path.GetRawString());
     }
-    else
-    {
-        motion->SetBeganMotionHandler(onBeganMotionHandler);
-        motion->SetFinishedMotionHandler(onFinishedMotionHandler);
-    }
 
     //voice
     csmString voice = _modelSetting->GetMotionSoundFileName(group, no);
@@ -475,7 +710,17 @@ CubismMotionQueueEntryHandle LAppModel::StartMotion(const csmChar* group, csmInt
     {
         LAppPal::PrintLogLn("[APP]start motion: [%s_%d]", group, no);
     }
-    return  _motionManager->StartMotionPriority(motion, autoDelete, priority);
+    const CubismMotionQueueEntryHandle handle = _motionManager->StartMotionPriority(motion, autoDelete, priority);
+
+    // モーションは他のインスタンスと共有しているため、コールバックはモーションではなく今回の再生に設定する
+    CubismMotionQueueEntry* entry = _motionManager->GetCubismMotionQueueEntry(handle);
+    if (entry != NULL)
+    {
+        entry->SetBeganMotionHandler(onBeganMotionHandler);
+        entry->SetFinishedMotionHandler(onFinishedMotionHandler);
+    }
+
+    return handle;
 }
 
 CubismMotionQueueEntryHandle LAppModel::StartRandomMotion(const csmChar* group, csmInt32 priority, ACubismMotion::FinishedMotionCallback onFinishedMotionHandler, ACubismMotion::BeganMotionCallback onBeganMotionHandler)
@@ -514,6 +759,80 @@ void LAppModel::Draw(CubismMatrix44& matrix)
     DoDraw();
 }
 
+void LAppModel::DrawWithImpostor(CubismMatrix44& matrix, csmFloat32 viewportWidth, csmFloat32 viewportHeight, csmFloat32 deltaTimeSeconds)
+{
+    if (_model == NULL)
+    {
+        return;
+    }
+
+    matrix.MultiplyByMatrix(_modelMatrix);
+
+    Rendering::CubismRenderer_OpenGLES2* renderer = GetRenderer<Rendering::CubismRenderer_OpenGLES2>();
+    if (_isImpostorSupported && _impostor.Draw(_model, renderer, matrix, viewportWidth, viewportHeight, deltaTimeSeconds))
+    {
+        return;
+    }
+
+    renderer->SetMvpMatrix(&matrix);
+
+    DoDraw();
+}
+
+void LAppModel::PrepareRecordDraw()
+{
+    if (_model == NULL)
+    {
+        return;
+    }
+
+    GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->PrepareRecordDrawModel(_drawCommandList);
+}
+
+void LAppModel::RecordDraw(CubismMatrix44& matrix)
+{
+    _isDrawRecorded = false;
+
+    if (_model == NULL)
+    {
+        return;
+    }
+
+    matrix.MultiplyByMatrix(_modelMatrix);
+
+    Rendering::CubismRenderer_OpenGLES2* renderer = GetRenderer<Rendering::CubismRenderer_OpenGLES2>();
+    renderer->SetMvpMatrix(&matrix);
+
+    _isDrawRecorded = renderer->RecordDrawModel(_drawCommandList);
+}
+
+void LAppModel::ExecuteRecordedDraw()
+{
+    if (_model == NULL)
+    {
+        return;
+    }
+
+    if (!_isDrawRecorded)
+    {
+        // RecordDrawで設定したMVP行列でそのまま描画する
+        DoDraw();
+        return;
+    }
+
+    GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->ExecuteCommandList(_drawCommandList);
+}
+
+LAppModel* LAppModel::GetSharedSource() const
+{
+    return _sharedSource;
+}
+
+csmBool LAppModel::IsImpostorSupported() const
+{
+    return _isImpostorSupported;
+}
+
 csmBool LAppModel::HitTest(const csmChar* hitAreaName, csmFloat32 x, csmFloat32 y)
 {
     // 透明時は当たり判定なし。
@@ -578,15 +897,25 @@ void LAppModel::SetRandomExpression()
 
 void LAppModel::ReloadRenderer()
 {
+    _impostor.Release();
+
     DeleteRenderer();
 
     CreateRenderer();
 
+    if (_sharedSource != NULL)
+    {
+        GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->ShareClippingMask(_sharedSource->GetRenderer<Rendering::CubismRenderer_OpenGLES2>());
+    }
+
     SetupTextures();
 }
 
 void LAppModel::SetupTextures()
 {
+    // モデルの全テクスチャをまとめてデコードするため、先にパスを収集する
+    csmVector<csmInt32> textureNumbers;
+    csmVector<std::string> texturePaths;
     for (csmInt32 modelTextureNumber = 0; modelTextureNumber < _modelSetting->GetTextureCount(); modelTextureNumber++)
     {
         // テクスチャ名が空文字だった場合はロード・バインド処理をスキップ
@@ -595,16 +924,28 @@ void LAppModel::SetupTextures()
             continue;
         }
 
-        //OpenGLのテクスチャユニットにテクスチャをロードする
         csmString texturePath = _modelSetting->GetTextureFileName(modelTextureNumber);
         texturePath = _modelHomeDir + texturePath;
 
-//        AppDelegate *delegate = (AppDelegate *) [[UIApplication sharedApplication] delegate];
-        TextureInfo *texture = [[NYLDModelManager shared].textureManager createTextureFromPngFile:texturePath.GetRawString()];
-        csmInt32 glTextueNumber = texture->textureId;
+        textureNumbers.PushBack(modelTextureNumber);
+        texturePaths.PushBack(texturePath.GetRawString());
+    }
+
+    //OpenGLのテクスチャユニットにテクスチャをロードする
+    csmVector<TextureInfo*> textures = [[NYLDModelManager shared].textureManager createTexturesFromPngFiles:texturePaths];
+
+    for (csmUint32 i = 0; i < textures.GetSize(); i++)
+    {
+        if (textures[i] == NULL)
+        {
+            LAppPal::PrintLogLn("Failed to load texture: %s", texturePaths[i].c_str());
+            continue;
+        }
+
+        csmInt32 glTextueNumber = textures[i]->textureId;
 
         //OpenGL
-        GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->BindTexture(modelTextureNumber, glTextueNumber);
+        GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->BindTexture(textureNumbers[i], glTextueNumber);
     }
 
 #ifdef PREMULTIPLIED_ALPHA_ENABLE
@@ -619,6 +960,56 @@ void LAppModel::MotionEventFired(const csmString& eventValue)
     CubismLogInfo("%s is fired on LAppModel!!", eventValue.GetRawString());
 }
 
+void LAppModel::SetLipSyncVisemes(const LAppVowelAnalyzer::VisemeFrame& frame)
+{
+    _visemeFrame = frame;
+}
+
+void LAppModel::UpdatePhysicsLevelOfDetail(CubismMatrix44& projection, csmFloat32 viewportHeight)
+{
+    if (_model == NULL || _physics == NULL)
+    {
+        return;
+    }
+
+    // Drawと同じ順序でモデル行列を掛け、キャンバスの高さをピクセルに換算する
+    csmFloat32 mvp[16];
+    CubismMatrix44::Multiply(_modelMatrix->GetArray(), projection.GetArray(), mvp);
+    const csmFloat32 projectedHeight = CubismMath::AbsF(mvp[5]) * _model->GetCanvasHeight() * 0.5f * viewportHeight;
+
+    CubismPhysics::LevelOfDetail level = CubismPhysics::LevelOfDetail_Full;
+    if (projectedHeight < PhysicsFrozenLevelHeight)
+    {
+        level = CubismPhysics::LevelOfDetail_Frozen;
+    }
+    else if (projectedHeight < PhysicsReducedLevelHeight)
+    {
+        level = CubismPhysics::LevelOfDetail_Reduced;
+    }
+
+    _physics->SetLevelOfDetail(level);
+}
+
+csmBool LAppModel::IsInViewport(CubismMatrix44& projection)
+{
+    if (_model == NULL)
+    {
+        return false;
+    }
+
+    // Drawと同じ順序でモデル行列を掛ける
+    CubismMatrix44 mvp;
+    CubismMatrix44::Multiply(_modelMatrix->GetArray(), projection.GetArray(), mvp.GetArray());
+
+    if (GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->IsInViewport(mvp, OffscreenModelMargin))
+    {
+        return true;
+    }
+
+    CSM_PROFILE_COUNTER_ADD(Counter_CulledModels, 1);
+    return false;
+}
+
 Csm::Rendering::CubismOffscreenSurface_OpenGLES2& LAppModel::GetRenderBuffer()
 {
     return _renderBuffer;
@@ -9,6 +9,8 @@
 #define LAppPal_h
 
 #import <CubismFramework.hpp>
+#import <CubismPhysics.hpp>
+#import <CubismFrameTimer.hpp>
 #import <string>
 
 /**
@@ -31,6 +33,16 @@ public:
      */
     static Csm::csmByte* LoadFileAsBytes(const std::string filePath, Csm::csmSizeInt* outSize);
 
+    /**
+     * @brief リソースバンドル内のファイルの絶対パスを取得する
+     *
+     * ファイル全体を読み込まずに、ストリーミング等で直接開く場合に使用する
+     *
+     * @param[in]   filePath    LoadFileAsBytesと同じ形式のファイルパス
+     * @return                  絶対パス。見つからない場合は空文字列
+     */
+    static std::string GetResourceFilePath(const std::string filePath);
+
 
     /**
      * @brief バイトデータを解放する
@@ -44,16 +56,46 @@ public:
     /**
      * @biref   デルタ時間（前回フレームとの差分）を取得する
      *
-     * @return  デルタ時間[ms]
+     * 単調増加するクロックから求め、ヒッチ時はLAppDefine::MaxFrameDeltaTimeで切り詰めた値を返す。
+     *
+     * @return  デルタ時間[秒]
+     *
+     */
+    static double GetDeltaTime() {return s_frameTimer.GetFrameDeltaTime();}
+
+    /**
+     * @brief   フレームタイマーを取得する
+     *
+     * 固定ステップのステップ数・補間の重みやフレーム時間の統計を参照する。
+     *
+     * @return  フレームタイマー
+     */
+    static const Csm::CubismFrameTimer& GetFrameTimer() {return s_frameTimer;}
+
+    /**
+     * @brief 時間の計測を開始する。
      *
+     * LAppDefineの設定を反映し、統計をリセットする。
      */
-    static double GetDeltaTime() {return s_deltaTime;}
+    static void InitializeTime();
 
     /**
      * @brief 時間を更新する。
      */
     static void UpdateTime();
 
+    /**
+     * @brief タスクを並列に実行する
+     *
+     * GCDのdispatch_apply_fで0〜count-1の各インデックスについてtaskを呼び出し、全ての完了を待ってから戻る。
+     * CubismPhysics::SetParallelForに渡して使用する。
+     *
+     * @param[in]   count       タスクの数
+     * @param[in]   context     taskに渡すデータ
+     * @param[in]   task        実行するタスク
+     */
+    static void ParallelFor(Csm::csmInt32 count, void* context, Csm::CubismPhysics::TaskFunction task);
+
     /**
     * @brief ログを出力し最後に改行する
     *
@@ -76,9 +118,7 @@ public:
     static void PrintMessageLn(const Csm::csmChar* message);
 
 private:
-    static double s_currentFrame;
-    static double s_lastFrame;
-    static double s_deltaTime;
+    static Csm::CubismFrameTimer s_frameTimer;
 };
 
 #endif /* LAppPal_h */
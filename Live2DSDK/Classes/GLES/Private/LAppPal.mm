@@ -13,6 +13,7 @@
 #import <sys/stat.h>
 #import <iostream>
 #import <fstream>
+#import <dispatch/dispatch.h>
 #import <OpenGLES/ES2/gl.h>
 #import <OpenGLES/ES2/glext.h>
 #import "LAppDefine.h"
@@ -23,25 +24,42 @@ using namespace Csm;
 using namespace std;
 using namespace LAppDefine;
 
-double LAppPal::s_currentFrame = 0.0;
-double LAppPal::s_lastFrame = 0.0;
-double LAppPal::s_deltaTime = 0.0;
+CubismFrameTimer LAppPal::s_frameTimer;
+
+namespace {
+    struct ParallelForContext
+    {
+        void* context;
+        CubismPhysics::TaskFunction task;
+    };
+
+    void ParallelForWorker(void* context, size_t index)
+    {
+        const ParallelForContext* parallelFor = static_cast<const ParallelForContext*>(context);
+        parallelFor->task(parallelFor->context, static_cast<csmInt32>(index));
+    }
+
+    NSString* ResourcePathForFile(const string& filePath)
+    {
+        int path_i = static_cast<int>(filePath.find_last_of("/")+1);
+        int ext_i = static_cast<int>(filePath.find_last_of("."));
+        std::string pathname = filePath.substr(0,path_i);
+        std::string extname = filePath.substr(ext_i,filePath.size()-ext_i);
+        std::string filename = filePath.substr(path_i,ext_i-path_i);
+
+        NSBundle* bundle = [NYLDModelManager shared].modelBundle;
+        NYLog(@"JSON bundle: %@", bundle);
+        return [bundle
+                pathForResource:[NSString stringWithUTF8String:filename.c_str()]
+                ofType:[NSString stringWithUTF8String:extname.c_str()]
+                inDirectory:[NSString stringWithUTF8String:pathname.c_str()]];
+    }
+}
 
 csmByte* LAppPal::LoadFileAsBytes(const string filePath, csmSizeInt* outSize)
 {
-    int path_i = static_cast<int>(filePath.find_last_of("/")+1);
-    int ext_i = static_cast<int>(filePath.find_last_of("."));
-    std::string pathname = filePath.substr(0,path_i);
-    std::string extname = filePath.substr(ext_i,filePath.size()-ext_i);
-    std::string filename = filePath.substr(path_i,ext_i-path_i);
-    
-    NSBundle* bundle = [NYLDModelManager shared].modelBundle;
-    NYLog(@"JSON bundle: %@", bundle);
-    NSString* castFilePath = [bundle
-                              pathForResource:[NSString stringWithUTF8String:filename.c_str()]
-                              ofType:[NSString stringWithUTF8String:extname.c_str()]
-                              inDirectory:[NSString stringWithUTF8String:pathname.c_str()]];
-    
+    NSString* castFilePath = ResourcePathForFile(filePath);
+
     NSError *errorMsg = nil;
     NSData *data = [NSData dataWithContentsOfFile:castFilePath options:NULL error: &errorMsg];
     NYLog(@"JSON data: %@", data);
@@ -59,18 +77,48 @@ csmByte* LAppPal::LoadFileAsBytes(const string filePath, csmSizeInt* outSize)
     return static_cast<Csm::csmByte*>(byteData);
 }
 
+std::string LAppPal::GetResourceFilePath(const string filePath)
+{
+    NSString* castFilePath = ResourcePathForFile(filePath);
+    if (castFilePath == nil)
+    {
+        return std::string();
+    }
+    return std::string([castFilePath fileSystemRepresentation]);
+}
+
 void LAppPal::ReleaseBytes(csmByte* byteData)
 {
     free(byteData);
 }
 
+void LAppPal::InitializeTime()
+{
+    s_frameTimer.SetFixedDeltaTime(1.0f / SimulationFps);
+    s_frameTimer.SetMaxFrameDeltaTime(MaxFrameDeltaTime);
+    s_frameTimer.SetMaxStepCount(MaxSimulationStepCount);
+    s_frameTimer.SetHitchThreshold(FrameHitchThreshold);
+    s_frameTimer.Reset();
+    s_frameTimer.Tick();
+}
+
 void LAppPal::UpdateTime()
 {
-    NSDate *now = [NSDate date];
-    double unixtime = [now timeIntervalSince1970];
-    s_currentFrame = unixtime;
-    s_deltaTime = s_currentFrame - s_lastFrame;
-    s_lastFrame = s_currentFrame;
+    s_frameTimer.Tick();
+}
+
+void LAppPal::ParallelFor(csmInt32 count, void* context, CubismPhysics::TaskFunction task)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    ParallelForContext parallelFor;
+    parallelFor.context = context;
+    parallelFor.task = task;
+
+    dispatch_apply_f(static_cast<size_t>(count), DISPATCH_APPLY_AUTO, &parallelFor, ParallelForWorker);
 }
 
 void LAppPal::PrintLogLn(const csmChar* format, ...)
@@ -0,0 +1,118 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#ifndef LAppTextureDecoder_h
+#define LAppTextureDecoder_h
+
+#import <CubismFramework.hpp>
+#import <csmVector.hpp>
+
+/**
+ * @brief テクスチャファイルのデコードとプリマルチプライ処理を行うクラス
+ *
+ * GLに依存しない処理のみを扱い、複数のPNG画像のデコードをワーカースレッドで並列に実行する。
+ * GPU圧縮テクスチャ（KTX2）はコンテナの解析のみを行う。
+ * テクスチャの生成（GLへのアップロード）は呼び出し側のGLスレッドで行うこと。
+ *
+ */
+class LAppTextureDecoder
+{
+public:
+    /**
+     * @brief デコード1件分の入出力
+     */
+    struct DecodeJob
+    {
+        const Csm::csmByte* fileData;   ///< [in]  PNGファイルのバイトデータ
+        Csm::csmSizeInt fileSize;       ///< [in]  PNGファイルのサイズ
+        Csm::csmByte* pixels;           ///< [out] RGBA8のピクセルデータ。失敗時はNULL
+        Csm::csmInt32 width;            ///< [out] 横幅
+        Csm::csmInt32 height;           ///< [out] 高さ
+    };
+
+    /**
+     * @brief KTX2ファイルのミップレベル1段分の情報
+     */
+    struct Ktx2Level
+    {
+        const Csm::csmByte* data;       ///< 圧縮データの先頭
+        Csm::csmSizeInt size;           ///< 圧縮データのサイズ
+        Csm::csmInt32 width;            ///< このレベルの横幅
+        Csm::csmInt32 height;           ///< このレベルの高さ
+    };
+
+    /**
+     * @brief KTX2ファイルの解析結果
+     *
+     * levelsはファイルデータを直接指すため、ファイルデータの解放後は使用できない。
+     */
+    struct Ktx2Image
+    {
+        Csm::csmUint32 vkFormat;                    ///< VkFormatの値
+        Csm::csmInt32 width;                        ///< 横幅
+        Csm::csmInt32 height;                       ///< 高さ
+        Csm::csmBool isPremultiplied;               ///< データフォーマット記述子でアルファがプリマルチプライ済みと指定されている場合はtrue
+        Csm::csmVector<Ktx2Level> levels;           ///< ミップレベルの配列。[0]が最大解像度
+    };
+
+    static const Csm::csmUint32 VkFormatEtc2R8G8B8A8Unorm = 151;   ///< VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+    static const Csm::csmUint32 VkFormatAstc4x4Unorm = 157;        ///< VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+    static const Csm::csmUint32 VkFormatAstc6x6Unorm = 165;        ///< VK_FORMAT_ASTC_6x6_UNORM_BLOCK
+    static const Csm::csmUint32 VkFormatAstc8x8Unorm = 171;        ///< VK_FORMAT_ASTC_8x8_UNORM_BLOCK
+
+    /**
+     * @brief KTX2ファイルのヘッダとレベルインデックスを解析する
+     *
+     * 2Dテクスチャ1枚（レイヤー・キューブ面なし）で、スーパーコンプレッションなしのものだけを受け付ける。
+     * ピクセルデータのデコードは行わない。データフォーマット記述子からはアルファの扱いだけを読む。
+     *
+     * @param[in]   fileData    KTX2ファイルのバイトデータ
+     * @param[in]   fileSize    KTX2ファイルのサイズ
+     * @param[out]  outImage    解析結果
+     * @return  解析に成功した場合はtrue
+     */
+    static Csm::csmBool ParseKtx2(const Csm::csmByte* fileData, Csm::csmSizeInt fileSize, Ktx2Image& outImage);
+
+    /**
+     * @brief 複数のPNG画像をまとめてデコードする
+     *
+     * ジョブ数とハードウェアスレッド数の小さい方の数だけワーカーを起動し、各ジョブを並列にデコードする。
+     * 全ジョブの完了を待ってから戻る。
+     *
+     * @param[in,out]   jobs            デコードジョブの配列
+     * @param[in]       jobCount        ジョブの数
+     * @param[in]       premultiply     trueの場合、デコード後にプリマルチプライ処理を行う
+     */
+    static void DecodePngBatch(DecodeJob* jobs, Csm::csmUint32 jobCount, Csm::csmBool premultiply);
+
+    /**
+     * @brief PNG画像を1件デコードする
+     *
+     * @param[in,out]   job             デコードジョブ
+     * @param[in]       premultiply     trueの場合、デコード後にプリマルチプライ処理を行う
+     */
+    static void DecodePng(DecodeJob& job, Csm::csmBool premultiply);
+
+    /**
+     * @brief RGBA8のピクセル列にプリマルチプライ処理を行う
+     *
+     * 各色成分を c * (a + 1) >> 8 で置き換える。NEON / SSE2が利用できる環境ではSIMDで処理する。
+     *
+     * @param[in,out]   rgba        RGBA8のピクセルデータ
+     * @param[in]       pixelCount  ピクセル数
+     */
+    static void PremultiplyAlpha(Csm::csmByte* rgba, Csm::csmUint32 pixelCount);
+
+    /**
+     * @brief デコードしたピクセルデータを解放する
+     *
+     * @param[in]   pixels  DecodeJob::pixels
+     */
+    static void ReleasePixels(Csm::csmByte* pixels);
+};
+
+#endif /* LAppTextureDecoder_h */
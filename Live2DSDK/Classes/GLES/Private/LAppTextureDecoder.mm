@@ -0,0 +1,250 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#import "LAppTextureDecoder.h"
+#import <atomic>
+#import <cstring>
+#import <thread>
+#import <vector>
+#define STBI_NO_STDIO
+#define STBI_ONLY_PNG
+#import "stb_image.h"
+
+// CSM_NO_SIMDが定義されている場合はスカラーの処理だけでビルドする
+#if defined(CSM_NO_SIMD)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#import <arm_neon.h>
+#define LAPP_TEXTURE_DECODER_NEON
+#elif defined(__SSE2__)
+#import <emmintrin.h>
+#define LAPP_TEXTURE_DECODER_SSE2
+#endif
+
+using namespace Csm;
+
+namespace {
+    void PremultiplyAlphaScalar(csmByte* rgba, csmUint32 pixelCount)
+    {
+        for (csmUint32 i = 0; i < pixelCount; i++)
+        {
+            csmByte* p = rgba + i * 4;
+            const csmUint32 alpha = p[3] + 1;
+            p[0] = static_cast<csmByte>((p[0] * alpha) >> 8);
+            p[1] = static_cast<csmByte>((p[1] * alpha) >> 8);
+            p[2] = static_cast<csmByte>((p[2] * alpha) >> 8);
+        }
+    }
+
+    const csmByte Ktx2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+    const csmSizeInt Ktx2LevelIndexOffset = 80;
+    const csmSizeInt Ktx2LevelIndexEntrySize = 24;
+    // データフォーマット記述子は全体サイズ(4バイト)に続く基本ブロックで、flagsはその12バイト目
+    const csmSizeInt Ktx2DfdFlagsOffset = 4 + 11;
+    const csmByte Ktx2DfdFlagAlphaPremultiplied = 0x01;
+
+    csmUint32 ReadUint32LE(const csmByte* p)
+    {
+        return static_cast<csmUint32>(p[0])
+            | (static_cast<csmUint32>(p[1]) << 8)
+            | (static_cast<csmUint32>(p[2]) << 16)
+            | (static_cast<csmUint32>(p[3]) << 24);
+    }
+
+    csmUint64 ReadUint64LE(const csmByte* p)
+    {
+        return static_cast<csmUint64>(ReadUint32LE(p)) | (static_cast<csmUint64>(ReadUint32LE(p + 4)) << 32);
+    }
+
+    void DecodeWorker(LAppTextureDecoder::DecodeJob* jobs, csmUint32 jobCount, csmBool premultiply, std::atomic<csmUint32>* nextJob)
+    {
+        for (;;)
+        {
+            const csmUint32 index = nextJob->fetch_add(1);
+            if (index >= jobCount)
+            {
+                break;
+            }
+
+            LAppTextureDecoder::DecodePng(jobs[index], premultiply);
+        }
+    }
+}
+
+csmBool LAppTextureDecoder::ParseKtx2(const csmByte* fileData, csmSizeInt fileSize, Ktx2Image& outImage)
+{
+    outImage.levels.Clear();
+
+    if (fileData == NULL || fileSize < Ktx2LevelIndexOffset || memcmp(fileData, Ktx2Identifier, sizeof(Ktx2Identifier)) != 0)
+    {
+        return false;
+    }
+
+    const csmUint32 vkFormat = ReadUint32LE(fileData + 12);
+    const csmUint32 pixelWidth = ReadUint32LE(fileData + 20);
+    const csmUint32 pixelHeight = ReadUint32LE(fileData + 24);
+    const csmUint32 pixelDepth = ReadUint32LE(fileData + 28);
+    const csmUint32 layerCount = ReadUint32LE(fileData + 32);
+    const csmUint32 faceCount = ReadUint32LE(fileData + 36);
+    const csmUint32 levelCount = ReadUint32LE(fileData + 40);
+    const csmUint32 supercompressionScheme = ReadUint32LE(fileData + 44);
+
+    if (pixelWidth == 0 || pixelHeight == 0 || pixelDepth > 1 || layerCount > 1 || faceCount != 1 || supercompressionScheme != 0)
+    {
+        return false;
+    }
+
+    // levelCountが0の場合は実行時にミップマップを生成する指定だが、圧縮テクスチャでは生成できないため1段として扱う
+    const csmUint32 storedLevelCount = levelCount > 0 ? levelCount : 1;
+    if (storedLevelCount > 32 || Ktx2LevelIndexOffset + storedLevelCount * Ktx2LevelIndexEntrySize > fileSize)
+    {
+        return false;
+    }
+
+    for (csmUint32 i = 0; i < storedLevelCount; i++)
+    {
+        const csmByte* entry = fileData + Ktx2LevelIndexOffset + i * Ktx2LevelIndexEntrySize;
+        const csmUint64 byteOffset = ReadUint64LE(entry);
+        const csmUint64 byteLength = ReadUint64LE(entry + 8);
+
+        if (byteLength == 0 || byteOffset > fileSize || byteLength > fileSize - byteOffset)
+        {
+            outImage.levels.Clear();
+            return false;
+        }
+
+        Ktx2Level level;
+        level.data = fileData + byteOffset;
+        level.size = static_cast<csmSizeInt>(byteLength);
+        level.width = static_cast<csmInt32>(pixelWidth >> i) > 0 ? static_cast<csmInt32>(pixelWidth >> i) : 1;
+        level.height = static_cast<csmInt32>(pixelHeight >> i) > 0 ? static_cast<csmInt32>(pixelHeight >> i) : 1;
+        outImage.levels.PushBack(level);
+    }
+
+    // 記述子が無い・範囲外の場合はストレートアルファとして扱う
+    const csmUint32 dfdByteOffset = ReadUint32LE(fileData + 48);
+    const csmUint32 dfdByteLength = ReadUint32LE(fileData + 52);
+    const csmBool hasDfdFlags = dfdByteLength > Ktx2DfdFlagsOffset && dfdByteOffset <= fileSize && dfdByteLength <= fileSize - dfdByteOffset;
+
+    outImage.vkFormat = vkFormat;
+    outImage.width = static_cast<csmInt32>(pixelWidth);
+    outImage.height = static_cast<csmInt32>(pixelHeight);
+    outImage.isPremultiplied = hasDfdFlags && (fileData[dfdByteOffset + Ktx2DfdFlagsOffset] & Ktx2DfdFlagAlphaPremultiplied) != 0;
+
+    return true;
+}
+
+void LAppTextureDecoder::DecodePngBatch(DecodeJob* jobs, csmUint32 jobCount, csmBool premultiply)
+{
+    if (jobCount == 0)
+    {
+        return;
+    }
+
+    csmUint32 workerCount = std::thread::hardware_concurrency();
+    if (workerCount == 0 || workerCount > jobCount)
+    {
+        workerCount = jobCount;
+    }
+
+    std::atomic<csmUint32> nextJob(0);
+
+    // 呼び出し元スレッドもワーカーの1つとして処理する
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount - 1);
+    for (csmUint32 i = 1; i < workerCount; i++)
+    {
+        workers.push_back(std::thread(DecodeWorker, jobs, jobCount, premultiply, &nextJob));
+    }
+
+    DecodeWorker(jobs, jobCount, premultiply, &nextJob);
+
+    for (csmUint32 i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+}
+
+void LAppTextureDecoder::DecodePng(DecodeJob& job, csmBool premultiply)
+{
+    job.pixels = NULL;
+    job.width = 0;
+    job.height = 0;
+
+    if (job.fileData == NULL)
+    {
+        return;
+    }
+
+    int width, height, channels;
+    job.pixels = stbi_load_from_memory(
+                                       job.fileData,
+                                       static_cast<int>(job.fileSize),
+                                       &width,
+                                       &height,
+                                       &channels,
+                                       STBI_rgb_alpha);
+
+    if (job.pixels == NULL)
+    {
+        return;
+    }
+
+    job.width = width;
+    job.height = height;
+
+    if (premultiply)
+    {
+        PremultiplyAlpha(job.pixels, static_cast<csmUint32>(width * height));
+    }
+}
+
+void LAppTextureDecoder::PremultiplyAlpha(csmByte* rgba, csmUint32 pixelCount)
+{
+    csmUint32 i = 0;
+
+#if defined(LAPP_TEXTURE_DECODER_NEON)
+    // 8ピクセルずつチャンネル毎に分解して処理する
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        uint8x8x4_t px = vld4_u8(rgba + i * 4);
+        const uint8x8_t alpha = px.val[3];
+        px.val[0] = vshrn_n_u16(vaddw_u8(vmull_u8(px.val[0], alpha), px.val[0]), 8);
+        px.val[1] = vshrn_n_u16(vaddw_u8(vmull_u8(px.val[1], alpha), px.val[1]), 8);
+        px.val[2] = vshrn_n_u16(vaddw_u8(vmull_u8(px.val[2], alpha), px.val[2]), 8);
+        vst4_u8(rgba + i * 4, px);
+    }
+#elif defined(LAPP_TEXTURE_DECODER_SSE2)
+    // 4ピクセルずつ16bitに展開して処理する
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m128i* p = reinterpret_cast<__m128i*>(rgba + i * 4);
+        const __m128i src = _mm_loadu_si128(p);
+
+        __m128i lo = _mm_unpacklo_epi8(src, zero);
+        __m128i hi = _mm_unpackhi_epi8(src, zero);
+
+        __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+        lo = _mm_srli_epi16(_mm_mullo_epi16(lo, _mm_add_epi16(alphaLo, one)), 8);
+        hi = _mm_srli_epi16(_mm_mullo_epi16(hi, _mm_add_epi16(alphaHi, one)), 8);
+
+        const __m128i color = _mm_packus_epi16(lo, hi);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_andnot_si128(alphaMask, color), _mm_and_si128(alphaMask, src)));
+    }
+#endif
+
+    PremultiplyAlphaScalar(rgba + i * 4, pixelCount - i);
+}
+
+void LAppTextureDecoder::ReleasePixels(csmByte* pixels)
+{
+    stbi_image_free(pixels);
+}
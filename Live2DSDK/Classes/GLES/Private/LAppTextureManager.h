@@ -59,6 +59,18 @@ typedef struct
  */
 - (TextureInfo*)createTextureFromPngFile:(std::string)fileName;
 
+/**
+ * @brief 複数の画像をまとめて読み込む
+ *
+ * PNGのデコードとプリマルチプライ処理をワーカースレッドで並列に行い、GLへのアップロードは呼び出し元スレッドで行う。
+ * 同じ場所に拡張子を.ktx2に置き換えたファイルがあり、その圧縮形式（ETC2 / ASTC）をGPUがサポートしている場合は
+ * PNGの代わりにそちらをglCompressedTexImage2Dで読み込む。
+ *
+ * @param[in] fileNames  読み込む画像ファイルパス名の配列
+ * @return fileNamesと同じ順序の画像情報の配列。読み込み失敗した要素はNULL
+ */
+- (Csm::csmVector<TextureInfo*>)createTexturesFromPngFiles:(const Csm::csmVector<std::string>&)fileNames;
+
 /**
  * @brief 画像の解放
  *
@@ -18,6 +18,7 @@
 #import "stb_image.h"
 #pragma clang diagnostic pop
 #import "LAppPal.h"
+#import "LAppTextureDecoder.h"
 
 
 @interface LAppTextureManager()
@@ -26,6 +27,19 @@
 
 @end
 
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_6x6_KHR
+#define GL_COMPRESSED_RGBA_ASTC_6x6_KHR 0x93B4
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_8x8_KHR
+#define GL_COMPRESSED_RGBA_ASTC_8x8_KHR 0x93B7
+#endif
+
 @implementation LAppTextureManager
 
 - (id)init
@@ -40,10 +54,8 @@
 }
 
 
-- (TextureInfo*) createTextureFromPngFile:(std::string)fileName
+- (TextureInfo*)findTextureByName:(const std::string&)fileName
 {
-
-    //search loaded texture already.
     for (Csm::csmUint32 i = 0; i < _textures.GetSize(); i++)
     {
         if (_textures[i]->fileName == fileName)
@@ -51,60 +63,210 @@
             return _textures[i];
         }
     }
+    return NULL;
+}
 
-    GLuint textureId;
-    int width, height, channels;
-    unsigned int size;
-    unsigned char* png;
-    unsigned char* address;
+- (BOOL)isCompressedFormatSupported:(Csm::csmUint32)vkFormat glFormat:(GLenum*)outGlFormat
+{
+    static BOOL checked = NO;
+    static BOOL astcSupported = NO;
+    static BOOL etc2Supported = NO;
 
-    address = LAppPal::LoadFileAsBytes(fileName, &size);
+    if (!checked)
+    {
+        const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+        const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+        astcSupported = extensions != NULL && strstr(extensions, "GL_KHR_texture_compression_astc_ldr") != NULL;
+        // ETC2はOpenGL ES 3.0以降のコア機能
+        etc2Supported = version != NULL && strstr(version, "OpenGL ES 3") != NULL;
+        checked = YES;
+    }
 
-    // png情報を取得する
-    png = stbi_load_from_memory(
-                                address,
-                                static_cast<int>(size),
-                                &width,
-                                &height,
-                                &channels,
-                                STBI_rgb_alpha);
+    switch (vkFormat)
+    {
+    case LAppTextureDecoder::VkFormatEtc2R8G8B8A8Unorm:
+        *outGlFormat = GL_COMPRESSED_RGBA8_ETC2_EAC;
+        return etc2Supported;
+    case LAppTextureDecoder::VkFormatAstc4x4Unorm:
+        *outGlFormat = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        return astcSupported;
+    case LAppTextureDecoder::VkFormatAstc6x6Unorm:
+        *outGlFormat = GL_COMPRESSED_RGBA_ASTC_6x6_KHR;
+        return astcSupported;
+    case LAppTextureDecoder::VkFormatAstc8x8Unorm:
+        *outGlFormat = GL_COMPRESSED_RGBA_ASTC_8x8_KHR;
+        return astcSupported;
+    default:
+        return NO;
+    }
+}
+
+- (TextureInfo*)createCompressedTextureForPngFile:(const std::string&)fileName
+{
+    // 同じディレクトリに拡張子違いで置かれたKTX2ファイルを探す
+    const std::string::size_type extIndex = fileName.find_last_of(".");
+    if (extIndex == std::string::npos)
+    {
+        return NULL;
+    }
+    const std::string ktx2FileName = fileName.substr(0, extIndex) + ".ktx2";
 
+    // KTX2は任意で同梱するファイルのため、無い場合は読み込み失敗のログを出さずにPNGを使う
+    if (LAppPal::GetResourceFilePath(ktx2FileName).empty())
     {
+        return NULL;
+    }
+
+    Csm::csmSizeInt size = 0;
+    Csm::csmByte* address = LAppPal::LoadFileAsBytes(ktx2FileName, &size);
+    if (address == NULL)
+    {
+        return NULL;
+    }
+
+    // PNGと同じアルファの扱いで書き出されたものだけを使う
 #ifdef PREMULTIPLIED_ALPHA_ENABLE
-        unsigned int* fourBytes = reinterpret_cast<unsigned int*>(png);
-        for (int i = 0; i < width * height; i++)
-        {
-            unsigned char* p = png + i * 4;
-            int tes = [self pemultiply:p[0] Green:p[1] Blue:p[2] Alpha:p[3]];
-            fourBytes[i] = tes;
-        }
+    const Csm::csmBool isPremultiplied = true;
+#else
+    const Csm::csmBool isPremultiplied = false;
 #endif
+
+    LAppTextureDecoder::Ktx2Image image;
+    GLenum glFormat;
+    if (!LAppTextureDecoder::ParseKtx2(address, size, image)
+        || image.isPremultiplied != isPremultiplied
+        || ![self isCompressedFormatSupported:image.vkFormat glFormat:&glFormat])
+    {
+        LAppPal::ReleaseBytes(address);
+        return NULL;
     }
 
-    // OpenGL用のテクスチャを生成する
+    // 以前のGL呼び出しで残ったエラーを、このテクスチャのアップロード失敗と取り違えないよう先に取り除く
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+
+    // OpenGL用のテクスチャを生成する。ミップマップはファイルに格納済みのものを使用する
+    GLuint textureId;
     glGenTextures(1, &textureId);
     glBindTexture(GL_TEXTURE_2D, textureId);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, png);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    for (Csm::csmUint32 i = 0; i < image.levels.GetSize(); i++)
+    {
+        const LAppTextureDecoder::Ktx2Level& level = image.levels[i];
+        glCompressedTexImage2D(GL_TEXTURE_2D, i, glFormat, level.width, level.height, 0, static_cast<GLsizei>(level.size), level.data);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, image.levels.GetSize() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glBindTexture(GL_TEXTURE_2D, 0);
 
-
-    // 解放処理
-    stbi_image_free(png);
     LAppPal::ReleaseBytes(address);
 
+    if (glGetError() != GL_NO_ERROR)
+    {
+        glDeleteTextures(1, &textureId);
+        return NULL;
+    }
+
+    // 元のPNGファイル名で登録し、通常のテクスチャと同じように検索・解放できるようにする
     TextureInfo* textureInfo = new TextureInfo;
     textureInfo->fileName = fileName;
-    textureInfo->width = width;
-    textureInfo->height = height;
+    textureInfo->width = image.width;
+    textureInfo->height = image.height;
     textureInfo->textureId = textureId;
     _textures.PushBack(textureInfo);
 
     return textureInfo;
 }
 
+- (TextureInfo*) createTextureFromPngFile:(std::string)fileName
+{
+    Csm::csmVector<std::string> fileNames;
+    fileNames.PushBack(fileName);
+    return [self createTexturesFromPngFiles:fileNames][0];
+}
+
+- (Csm::csmVector<TextureInfo*>)createTexturesFromPngFiles:(const Csm::csmVector<std::string>&)fileNames
+{
+    Csm::csmVector<TextureInfo*> result;
+    Csm::csmVector<LAppTextureDecoder::DecodeJob> jobs;
+    Csm::csmVector<Csm::csmUint32> jobIndices;
+
+    // 読み込み済みのものは再利用し、未読み込みのものだけファイルを読み込む
+    for (Csm::csmUint32 i = 0; i < fileNames.GetSize(); i++)
+    {
+        TextureInfo* textureInfo = [self findTextureByName:fileNames[i]];
+        if (textureInfo == NULL)
+        {
+            // GPU圧縮テクスチャがあればそちらを優先し、なければPNGにフォールバックする
+            textureInfo = [self createCompressedTextureForPngFile:fileNames[i]];
+        }
+        result.PushBack(textureInfo);
+        if (textureInfo != NULL)
+        {
+            continue;
+        }
+
+        LAppTextureDecoder::DecodeJob job;
+        job.fileSize = 0;
+        job.fileData = LAppPal::LoadFileAsBytes(fileNames[i], &job.fileSize);
+        jobs.PushBack(job);
+        jobIndices.PushBack(i);
+    }
+
+    if (jobs.GetSize() == 0)
+    {
+        return result;
+    }
+
+    // png情報を取得する
+#ifdef PREMULTIPLIED_ALPHA_ENABLE
+    LAppTextureDecoder::DecodePngBatch(jobs.GetPtr(), jobs.GetSize(), true);
+#else
+    LAppTextureDecoder::DecodePngBatch(jobs.GetPtr(), jobs.GetSize(), false);
+#endif
+
+    for (Csm::csmUint32 i = 0; i < jobs.GetSize(); i++)
+    {
+        const LAppTextureDecoder::DecodeJob& job = jobs[i];
+        const std::string& fileName = fileNames[jobIndices[i]];
+
+        // 同じファイルが複数回指定されていた場合は最初に生成したテクスチャを使う
+        TextureInfo* textureInfo = [self findTextureByName:fileName];
+        if (textureInfo == NULL && job.pixels != NULL)
+        {
+            // OpenGL用のテクスチャを生成する
+            GLuint textureId;
+            glGenTextures(1, &textureId);
+            glBindTexture(GL_TEXTURE_2D, textureId);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, job.width, job.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, job.pixels);
+            glGenerateMipmap(GL_TEXTURE_2D);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glBindTexture(GL_TEXTURE_2D, 0);
+
+            textureInfo = new TextureInfo;
+            textureInfo->fileName = fileName;
+            textureInfo->width = job.width;
+            textureInfo->height = job.height;
+            textureInfo->textureId = textureId;
+            _textures.PushBack(textureInfo);
+        }
+        result[jobIndices[i]] = textureInfo;
+
+        // 解放処理
+        if (job.pixels != NULL)
+        {
+            LAppTextureDecoder::ReleasePixels(job.pixels);
+        }
+        if (job.fileData != NULL)
+        {
+            LAppPal::ReleaseBytes(const_cast<Csm::csmByte*>(job.fileData));
+        }
+    }
+
+    return result;
+}
+
 - (unsigned int)pemultiply:(unsigned char)red Green:(unsigned char)green Blue:(unsigned char)blue Alpha:(unsigned char) alpha
 {
     return static_cast<unsigned>(\
@@ -0,0 +1,182 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#ifndef LAppVowelAnalyzer_h
+#define LAppVowelAnalyzer_h
+
+#import <CubismFramework.hpp>
+#import <atomic>
+
+/**
+ * @brief 音声から母音（A/I/U/E/O）の重みを推定するクラス
+ *
+ * オーディオスレッドからPushPcmでPCMをリングバッファに書き込み、Processで10ms単位のブロックを解析する。
+ * 解析はFFTのスペクトル包絡から第1・第2フォルマントを推定し、各母音の基準フォルマントとの距離から重みを求める。
+ * 解析結果はトリプルバッファで公開し、更新スレッドはGetLatestFrameで待ち無しに最新の結果を取得できる。
+ *
+ * スレッドモデル:
+ *  - PushPcmは1つの書き込みスレッドからのみ呼び出す
+ *  - Processは1つの解析スレッド（PushPcmと同じスレッドでもよい）からのみ呼び出す
+ *  - GetLatestFrameは1つの読み出しスレッドからのみ呼び出す
+ * Initialize以外はメモリ確保を行わない。
+ */
+class LAppVowelAnalyzer
+{
+public:
+    /**
+     * @brief 母音の種類
+     */
+    enum Vowel
+    {
+        Vowel_A = 0,
+        Vowel_I,
+        Vowel_U,
+        Vowel_E,
+        Vowel_O,
+        Vowel_Count
+    };
+
+    /**
+     * @brief 1ブロック分の解析結果
+     */
+    struct VisemeFrame
+    {
+        Csm::csmFloat32 weights[Vowel_Count];   ///< 各母音の重み（0〜1）。口の開き具合が掛け合わされている
+        Csm::csmFloat32 mouthOpen;              ///< 口の開き具合（0〜1）
+        Csm::csmUint64 blockIndex;              ///< 解析したブロックの通し番号。0の場合は未解析
+    };
+
+    /**
+     * @brief コンストラクタ
+     */
+    LAppVowelAnalyzer();
+
+    /**
+     * @brief デストラクタ
+     */
+    ~LAppVowelAnalyzer();
+
+    /**
+     * @brief サンプリングレートに合わせて内部バッファを確保する
+     *
+     * 解析中のスレッドが無い状態で呼び出すこと。
+     *
+     * @param[in]   samplingRate        サンプリングレート[Hz]
+     * @param[in]   blockBudgetSeconds  1ブロックあたりの処理時間の上限[秒]。超過した場合はGetOverrunCountに計上される
+     */
+    void Initialize(Csm::csmUint32 samplingRate, Csm::csmFloat32 blockBudgetSeconds = 0.001f);
+
+    /**
+     * @brief 現在のサンプリングレートを取得する
+     *
+     * @return サンプリングレート[Hz]。未初期化の場合は0
+     */
+    Csm::csmUint32 GetSamplingRate() const;
+
+    /**
+     * @brief モノラルのPCMをリングバッファに書き込む
+     *
+     * 空きが足りない場合は書き込めた分だけを書き込み、残りは破棄する。
+     *
+     * @param[in]   samples     -1〜1のPCMサンプル
+     * @param[in]   sampleCount サンプル数
+     * @return  書き込んだサンプル数
+     */
+    Csm::csmUint32 PushPcm(const Csm::csmFloat32* samples, Csm::csmUint32 sampleCount);
+
+    /**
+     * @brief リングバッファに溜まっている完全なブロックを全て解析し、最後の結果を公開する
+     *
+     * 解析が間に合わずブロックが溜まっている場合は古いブロックを読み飛ばす。
+     *
+     * @return  解析したブロック数
+     */
+    Csm::csmUint32 Process();
+
+    /**
+     * @brief 最新の解析結果を取得する
+     *
+     * @return  最新の解析結果。次回の呼び出しまで有効
+     */
+    const VisemeFrame& GetLatestFrame();
+
+    /**
+     * @brief 処理時間の上限を超過したブロック数を取得する
+     */
+    Csm::csmUint32 GetOverrunCount() const;
+
+    /**
+     * @brief リングバッファが一杯で破棄したサンプル数を取得する
+     */
+    Csm::csmUint32 GetDroppedSampleCount() const;
+
+private:
+    // コピー禁止
+    LAppVowelAnalyzer(const LAppVowelAnalyzer&);
+    LAppVowelAnalyzer& operator=(const LAppVowelAnalyzer&);
+
+    /**
+     * @brief 内部バッファを解放する
+     */
+    void Release();
+
+    /**
+     * @brief _windowに溜まっている1ブロック分を解析し、_frames[_backFrame]に書き込む
+     */
+    void AnalyzeBlock();
+
+    /**
+     * @brief _fftReal / _fftImagに対してその場でFFTを行う
+     */
+    void Fft();
+
+    /**
+     * @brief 周波数帯域内でスペクトル包絡のピーク周波数を探す
+     *
+     * @param[in]   minHz   探索する下限周波数
+     * @param[in]   maxHz   探索する上限周波数
+     * @return  ピーク周波数[Hz]
+     */
+    Csm::csmFloat32 FindPeakFrequency(Csm::csmFloat32 minHz, Csm::csmFloat32 maxHz) const;
+
+    /**
+     * @brief _backFrameを公開し、空いているバッファを次の書き込み先にする
+     */
+    void PublishFrame();
+
+    Csm::csmUint32 _samplingRate;           ///< サンプリングレート
+    Csm::csmUint32 _blockSize;              ///< 1ブロック（10ms）のサンプル数
+    Csm::csmUint32 _fftSize;                ///< FFTのサイズ（2の累乗、_blockSize以上）
+    Csm::csmFloat32 _blockBudgetSeconds;    ///< 1ブロックあたりの処理時間の上限
+
+    Csm::csmFloat32* _ring;                 ///< PCMのリングバッファ
+    Csm::csmUint32 _ringMask;               ///< リングバッファのサイズ - 1
+    std::atomic<Csm::csmUint32> _ringWrite; ///< 書き込み位置（書き込みスレッドのみ更新）
+    std::atomic<Csm::csmUint32> _ringRead;  ///< 読み出し位置（解析スレッドのみ更新）
+
+    Csm::csmFloat32* _window;               ///< 直近_fftSize分のPCM
+    Csm::csmFloat32* _hann;                 ///< 窓関数
+    Csm::csmFloat32* _fftReal;              ///< FFT作業領域（実部）
+    Csm::csmFloat32* _fftImag;              ///< FFT作業領域（虚部）
+    Csm::csmFloat32* _twiddleCos;           ///< 回転因子（cos）
+    Csm::csmFloat32* _twiddleSin;           ///< 回転因子（sin）
+    Csm::csmFloat32* _envelope;             ///< 平滑化したパワースペクトル
+
+    Csm::csmFloat32 _smoothedWeights[Vowel_Count];  ///< 時間方向に平滑化した母音の重み
+    Csm::csmFloat32 _smoothedOpen;                  ///< 時間方向に平滑化した口の開き具合
+    Csm::csmUint64 _blockIndex;                     ///< 解析済みブロック数
+
+    VisemeFrame _frames[3];                 ///< トリプルバッファ
+    Csm::csmUint32 _backFrame;              ///< 解析スレッドが書き込むバッファ
+    Csm::csmUint32 _frontFrame;             ///< 読み出しスレッドが参照するバッファ
+    std::atomic<Csm::csmUint32> _middleFrame;   ///< 受け渡し中のバッファ。新しい結果があればDirtyビットが立つ
+
+    std::atomic<Csm::csmUint32> _overrunCount;      ///< 処理時間超過ブロック数
+    std::atomic<Csm::csmUint32> _droppedSamples;    ///< 破棄したサンプル数
+};
+
+#endif /* LAppVowelAnalyzer_h */
@@ -0,0 +1,420 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#import "LAppVowelAnalyzer.h"
+#import <chrono>
+#import <cmath>
+#import <cstring>
+
+using namespace Csm;
+
+namespace {
+    const csmUint32 FrameIndexMask = 0x3;
+    const csmUint32 FrameDirtyBit = 0x4;
+
+    const csmFloat32 Pi = 3.14159265358979323846f;
+
+    const csmUint32 BlocksPerSecond = 100;      ///< 1ブロック = 10ms
+    const csmUint32 RingBlocks = 16;            ///< リングバッファに保持できるブロック数
+
+    const csmFloat32 SilenceDb = -50.0f;        ///< これ以下の音量は無音とみなす
+    const csmFloat32 FullOpenDb = -20.0f;       ///< この音量で口が全開になる
+    const csmFloat32 EnvelopeSmoothHz = 120.0f; ///< スペクトル包絡を求める際の平滑化幅
+
+    const csmFloat32 AttackRate = 0.5f;         ///< 値が増加する際の1ブロックあたりの追従率
+    const csmFloat32 ReleaseRate = 0.2f;        ///< 値が減少する際の1ブロックあたりの追従率
+    const csmFloat32 VowelSigma = 0.3f;         ///< 基準フォルマントからの距離（対数周波数）に対する重みの広がり
+
+    /**
+     * @brief 各母音の基準フォルマント[Hz]（第1, 第2）
+     */
+    const csmFloat32 VowelFormants[LAppVowelAnalyzer::Vowel_Count][2] =
+    {
+        { 850.0f, 1400.0f },    // A
+        { 350.0f, 2700.0f },    // I
+        { 400.0f, 1500.0f },    // U
+        { 550.0f, 2300.0f },    // E
+        { 550.0f, 950.0f },     // O
+    };
+
+    csmUint32 NextPowerOfTwo(csmUint32 value)
+    {
+        csmUint32 result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    csmFloat32 Follow(csmFloat32 current, csmFloat32 target)
+    {
+        const csmFloat32 rate = target > current ? AttackRate : ReleaseRate;
+        return current + (target - current) * rate;
+    }
+}
+
+LAppVowelAnalyzer::LAppVowelAnalyzer()
+    : _samplingRate(0)
+    , _blockSize(0)
+    , _fftSize(0)
+    , _blockBudgetSeconds(0.0f)
+    , _ring(NULL)
+    , _ringMask(0)
+    , _ringWrite(0)
+    , _ringRead(0)
+    , _window(NULL)
+    , _hann(NULL)
+    , _fftReal(NULL)
+    , _fftImag(NULL)
+    , _twiddleCos(NULL)
+    , _twiddleSin(NULL)
+    , _envelope(NULL)
+    , _smoothedOpen(0.0f)
+    , _blockIndex(0)
+    , _backFrame(0)
+    , _frontFrame(1)
+    , _middleFrame(2)
+    , _overrunCount(0)
+    , _droppedSamples(0)
+{
+    memset(_smoothedWeights, 0, sizeof(_smoothedWeights));
+    memset(_frames, 0, sizeof(_frames));
+}
+
+LAppVowelAnalyzer::~LAppVowelAnalyzer()
+{
+    Release();
+}
+
+void LAppVowelAnalyzer::Initialize(csmUint32 samplingRate, csmFloat32 blockBudgetSeconds)
+{
+    Release();
+
+    if (samplingRate < BlocksPerSecond)
+    {
+        return;
+    }
+
+    _samplingRate = samplingRate;
+    _blockSize = samplingRate / BlocksPerSecond;
+    _fftSize = NextPowerOfTwo(_blockSize);
+    _blockBudgetSeconds = blockBudgetSeconds;
+
+    const csmUint32 ringSize = NextPowerOfTwo(_blockSize * RingBlocks);
+    _ring = static_cast<csmFloat32*>(CSM_MALLOC(sizeof(csmFloat32) * ringSize));
+    _ringMask = ringSize - 1;
+    _ringWrite.store(0);
+    _ringRead.store(0);
+
+    _window = static_cast<csmFloat32*>(CSM_MALLOC(sizeof(csmFloat32) * _fftSize));
+    _hann = static_cast<csmFloat32*>(CSM_MALLOC(sizeof(csmFloat32) * _fftSize));
+    _fftReal = static_cast<csmFloat32*>(CSM_MALLOC(sizeof(csmFloat32) * _fftSize));
+    _fftImag = static_cast<csmFloat32*>(CSM_MALLOC(sizeof(csmFloat32) * _fftSize));
+    _twiddleCos = static_cast<csmFloat32*>(CSM_MALLOC(sizeof(csmFloat32) * (_fftSize / 2)));
+    _twiddleSin = static_cast<csmFloat32*>(CSM_MALLOC(sizeof(csmFloat32) * (_fftSize / 2)));
+    _envelope = static_cast<csmFloat32*>(CSM_MALLOC(sizeof(csmFloat32) * (_fftSize / 2 + 1)));
+
+    memset(_window, 0, sizeof(csmFloat32) * _fftSize);
+    for (csmUint32 i = 0; i < _fftSize; i++)
+    {
+        _hann[i] = 0.5f - 0.5f * cosf(2.0f * Pi * i / (_fftSize - 1));
+    }
+    for (csmUint32 i = 0; i < _fftSize / 2; i++)
+    {
+        _twiddleCos[i] = cosf(2.0f * Pi * i / _fftSize);
+        _twiddleSin[i] = -sinf(2.0f * Pi * i / _fftSize);
+    }
+
+    memset(_smoothedWeights, 0, sizeof(_smoothedWeights));
+    memset(_frames, 0, sizeof(_frames));
+    _smoothedOpen = 0.0f;
+    _blockIndex = 0;
+    _backFrame = 0;
+    _frontFrame = 1;
+    _middleFrame.store(2);
+    _overrunCount.store(0);
+    _droppedSamples.store(0);
+}
+
+csmUint32 LAppVowelAnalyzer::GetSamplingRate() const
+{
+    return _samplingRate;
+}
+
+void LAppVowelAnalyzer::Release()
+{
+    CSM_FREE(_ring);
+    CSM_FREE(_window);
+    CSM_FREE(_hann);
+    CSM_FREE(_fftReal);
+    CSM_FREE(_fftImag);
+    CSM_FREE(_twiddleCos);
+    CSM_FREE(_twiddleSin);
+    CSM_FREE(_envelope);
+
+    _ring = NULL;
+    _window = NULL;
+    _hann = NULL;
+    _fftReal = NULL;
+    _fftImag = NULL;
+    _twiddleCos = NULL;
+    _twiddleSin = NULL;
+    _envelope = NULL;
+    _samplingRate = 0;
+}
+
+csmUint32 LAppVowelAnalyzer::PushPcm(const csmFloat32* samples, csmUint32 sampleCount)
+{
+    if (_ring == NULL)
+    {
+        return 0;
+    }
+
+    const csmUint32 write = _ringWrite.load(std::memory_order_relaxed);
+    const csmUint32 read = _ringRead.load(std::memory_order_acquire);
+    const csmUint32 space = (_ringMask + 1) - (write - read);
+
+    const csmUint32 count = sampleCount < space ? sampleCount : space;
+    for (csmUint32 i = 0; i < count; i++)
+    {
+        _ring[(write + i) & _ringMask] = samples[i];
+    }
+    _ringWrite.store(write + count, std::memory_order_release);
+
+    if (count < sampleCount)
+    {
+        _droppedSamples.fetch_add(sampleCount - count, std::memory_order_relaxed);
+    }
+    return count;
+}
+
+csmUint32 LAppVowelAnalyzer::Process()
+{
+    if (_ring == NULL)
+    {
+        return 0;
+    }
+
+    csmUint32 read = _ringRead.load(std::memory_order_relaxed);
+    const csmUint32 write = _ringWrite.load(std::memory_order_acquire);
+
+    csmUint32 blockCount = (write - read) / _blockSize;
+    if (blockCount == 0)
+    {
+        return 0;
+    }
+
+    // 解析が遅れている場合は、窓を埋めるのに必要な分だけを残して古いブロックを読み飛ばす
+    const csmUint32 blocksPerWindow = (_fftSize + _blockSize - 1) / _blockSize;
+    if (blockCount > blocksPerWindow)
+    {
+        read += (blockCount - blocksPerWindow) * _blockSize;
+        blockCount = blocksPerWindow;
+    }
+
+    for (csmUint32 block = 0; block < blockCount; block++)
+    {
+        const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+        // 窓を1ブロック分ずらして新しいサンプルを追加する
+        memmove(_window, _window + _blockSize, sizeof(csmFloat32) * (_fftSize - _blockSize));
+        for (csmUint32 i = 0; i < _blockSize; i++)
+        {
+            _window[_fftSize - _blockSize + i] = _ring[(read + i) & _ringMask];
+        }
+        read += _blockSize;
+
+        AnalyzeBlock();
+
+        const std::chrono::duration<csmFloat32> elapsed = std::chrono::steady_clock::now() - begin;
+        if (elapsed.count() > _blockBudgetSeconds)
+        {
+            _overrunCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    _ringRead.store(read, std::memory_order_release);
+
+    PublishFrame();
+
+    return blockCount;
+}
+
+const LAppVowelAnalyzer::VisemeFrame& LAppVowelAnalyzer::GetLatestFrame()
+{
+    if (_middleFrame.load(std::memory_order_relaxed) & FrameDirtyBit)
+    {
+        _frontFrame = _middleFrame.exchange(_frontFrame, std::memory_order_acq_rel) & FrameIndexMask;
+    }
+    return _frames[_frontFrame];
+}
+
+csmUint32 LAppVowelAnalyzer::GetOverrunCount() const
+{
+    return _overrunCount.load(std::memory_order_relaxed);
+}
+
+csmUint32 LAppVowelAnalyzer::GetDroppedSampleCount() const
+{
+    return _droppedSamples.load(std::memory_order_relaxed);
+}
+
+void LAppVowelAnalyzer::PublishFrame()
+{
+    _backFrame = _middleFrame.exchange(_backFrame | FrameDirtyBit, std::memory_order_acq_rel) & FrameIndexMask;
+}
+
+void LAppVowelAnalyzer::AnalyzeBlock()
+{
+    // 音量（直近1ブロック分のRMS）
+    csmFloat32 sumOfSquares = 0.0f;
+    for (csmUint32 i = _fftSize - _blockSize; i < _fftSize; i++)
+    {
+        sumOfSquares += _window[i] * _window[i];
+    }
+    const csmFloat32 rms = sqrtf(sumOfSquares / _blockSize);
+    const csmFloat32 db = 20.0f * log10f(rms + 1.0e-9f);
+
+    csmFloat32 open = (db - SilenceDb) / (FullOpenDb - SilenceDb);
+    open = open < 0.0f ? 0.0f : (open > 1.0f ? 1.0f : open);
+
+    csmFloat32 targetWeights[Vowel_Count] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+    if (open > 0.0f)
+    {
+        for (csmUint32 i = 0; i < _fftSize; i++)
+        {
+            _fftReal[i] = _window[i] * _hann[i];
+            _fftImag[i] = 0.0f;
+        }
+
+        Fft();
+
+        // パワースペクトルの累積和から移動平均を取り、スペクトル包絡とする
+        const csmUint32 binCount = _fftSize / 2 + 1;
+        const csmFloat32 binHz = static_cast<csmFloat32>(_samplingRate) / _fftSize;
+        csmInt32 halfWidth = static_cast<csmInt32>(EnvelopeSmoothHz / binHz / 2.0f);
+        halfWidth = halfWidth < 1 ? 1 : halfWidth;
+
+        csmFloat32 cumulative = 0.0f;
+        for (csmUint32 k = 0; k < binCount; k++)
+        {
+            cumulative += _fftReal[k] * _fftReal[k] + _fftImag[k] * _fftImag[k];
+            _fftImag[k] = cumulative;
+        }
+        for (csmInt32 k = 0; k < static_cast<csmInt32>(binCount); k++)
+        {
+            const csmInt32 lo = (k - halfWidth - 1) < 0 ? -1 : (k - halfWidth - 1);
+            const csmInt32 hi = (k + halfWidth) >= static_cast<csmInt32>(binCount) ? static_cast<csmInt32>(binCount) - 1 : (k + halfWidth);
+            const csmFloat32 sum = _fftImag[hi] - (lo < 0 ? 0.0f : _fftImag[lo]);
+            _envelope[k] = sum / (hi - lo);
+        }
+
+        const csmFloat32 f1 = FindPeakFrequency(250.0f, 1000.0f);
+        const csmFloat32 f2 = FindPeakFrequency(f1 + 300.0f > 800.0f ? f1 + 300.0f : 800.0f, 3200.0f);
+
+        // 基準フォルマントとの対数周波数上の距離から重みを求め、合計が1になるよう正規化する
+        csmFloat32 total = 0.0f;
+        for (csmUint32 v = 0; v < Vowel_Count; v++)
+        {
+            const csmFloat32 d1 = logf(f1 / VowelFormants[v][0]);
+            const csmFloat32 d2 = logf(f2 / VowelFormants[v][1]);
+            targetWeights[v] = expf(-(d1 * d1 + d2 * d2) / (VowelSigma * VowelSigma));
+            total += targetWeights[v];
+        }
+        for (csmUint32 v = 0; v < Vowel_Count; v++)
+        {
+            targetWeights[v] = total > 0.0f ? targetWeights[v] / total * open : 0.0f;
+        }
+    }
+
+    VisemeFrame& frame = _frames[_backFrame];
+    for (csmUint32 v = 0; v < Vowel_Count; v++)
+    {
+        _smoothedWeights[v] = Follow(_smoothedWeights[v], targetWeights[v]);
+        frame.weights[v] = _smoothedWeights[v];
+    }
+    _smoothedOpen = Follow(_smoothedOpen, open);
+    frame.mouthOpen = _smoothedOpen;
+    frame.blockIndex = ++_blockIndex;
+}
+
+void LAppVowelAnalyzer::Fft()
+{
+    const csmUint32 n = _fftSize;
+
+    // ビット反転並べ替え
+    for (csmUint32 i = 1, j = 0; i < n; i++)
+    {
+        csmUint32 bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if (i < j)
+        {
+            const csmFloat32 tr = _fftReal[i];
+            _fftReal[i] = _fftReal[j];
+            _fftReal[j] = tr;
+            const csmFloat32 ti = _fftImag[i];
+            _fftImag[i] = _fftImag[j];
+            _fftImag[j] = ti;
+        }
+    }
+
+    for (csmUint32 length = 2; length <= n; length <<= 1)
+    {
+        const csmUint32 half = length >> 1;
+        const csmUint32 step = n / length;
+        for (csmUint32 start = 0; start < n; start += length)
+        {
+            for (csmUint32 k = 0; k < half; k++)
+            {
+                const csmFloat32 wr = _twiddleCos[k * step];
+                const csmFloat32 wi = _twiddleSin[k * step];
+                const csmUint32 a = start + k;
+                const csmUint32 b = a + half;
+                const csmFloat32 xr = _fftReal[b] * wr - _fftImag[b] * wi;
+                const csmFloat32 xi = _fftReal[b] * wi + _fftImag[b] * wr;
+                _fftReal[b] = _fftReal[a] - xr;
+                _fftImag[b] = _fftImag[a] - xi;
+                _fftReal[a] += xr;
+                _fftImag[a] += xi;
+            }
+        }
+    }
+}
+
+csmFloat32 LAppVowelAnalyzer::FindPeakFrequency(csmFloat32 minHz, csmFloat32 maxHz) const
+{
+    const csmFloat32 binHz = static_cast<csmFloat32>(_samplingRate) / _fftSize;
+    const csmUint32 lastBin = _fftSize / 2;
+
+    csmUint32 begin = static_cast<csmUint32>(minHz / binHz);
+    csmUint32 end = static_cast<csmUint32>(maxHz / binHz);
+    begin = begin < 1 ? 1 : begin;
+    end = end > lastBin ? lastBin : end;
+
+    if (begin >= end)
+    {
+        return minHz;
+    }
+
+    csmUint32 peak = begin;
+    for (csmUint32 k = begin + 1; k <= end; k++)
+    {
+        if (_envelope[k] > _envelope[peak])
+        {
+            peak = k;
+        }
+    }
+
+    return peak * binHz;
+}
@@ -9,10 +9,14 @@
 
 #import <CubismFramework.hpp>
 #import <csmVector.hpp>
+#import <cstdio>
 
  /**
   * @brief wavファイルハンドラ
-  * @attention 16bit wav ファイル読み込みのみ実装済み
+  *
+  * ファイル全体をメモリに展開せず、dataチャンクを固定サイズのチャンク単位で必要な分だけ読み込む。
+  * RMSは直近の一定区間（スライディングウィンドウ）について、2乗和を逐次更新して求める。
+  * @attention 8/16/24bit リニアPCM wav ファイル読み込みのみ実装済み
   */
 class LAppWavFileHandler
 {
@@ -52,19 +56,32 @@ public:
     /**
      * @brief wavファイルハンドラの内部状態更新
      *
+     * 経過時間が大きい場合は、RMSの計測に使う直近のウィンドウ1つ分だけを読み込む。
+     *
      * @param[in]   deltaTimeSeconds    デルタ時間[秒]
      * @retval  true    更新されている
-     * @retval  false   更新されていない
+     * @retval  false   更新されていない（dataチャンクの末尾に達した場合を含む）
      */
     Csm::csmBool Update(Csm::csmFloat32 deltaTimeSeconds);
 
     /**
      * @brief 引数で指定したwavファイルの読み込みを開始する
      *
+     * ヘッダのみを解析し、波形データはUpdateの進行に合わせて読み込む。
+     *
      * @param[in] filePath wavファイルのパス
      */
     void Start(const Csm::csmString& filePath);
 
+    /**
+     * @brief RMSを計測するウィンドウの長さを設定する
+     *
+     * 次回のStartから有効になる。
+     *
+     * @param[in] seconds ウィンドウの長さ[秒]
+     */
+    void SetRmsWindowSeconds(Csm::csmFloat32 seconds);
+
     /**
      * @brief 現在のRMS値取得
      *
@@ -80,33 +97,31 @@ public:
     const WavFileInfo& GetWavFileInfo() const;
 
     /**
-     * @brief 正規化前のデータを取得
+     * @brief 現在読み込まれているチャンクの正規化前のデータを取得
      *
      * @retval  正規化前のデータ
      */
     const Csm::csmByte* GetRawData() const;
 
     /**
-     * @brief 正規化前のデータの大きさを取得
+     * @brief 現在読み込まれているチャンクの正規化前のデータの大きさを取得
      *
      * @retval  正規化前のデータの大きさ
      */
     Csm::csmUint64 GetRawDataSize() const;
 
     /**
-     * @brief 正規化データを取得する
+     * @brief 引数で指定したチャンネル・範囲の正規化データをファイルから読み込む
      *
-     * @retval 正規化データ
-     */
-    Csm::csmVector<Csm::csmFloat32> GetPcmData() const;
-
-    /**
-     * @brief 引数で指定したチャンネルの正規化データを取得する
+     * Updateの再生位置には影響しない。
      *
-     * @param[in] dst 格納先
+     * @param[in] dst 格納先。sampleCount個分の領域が必要
      * @param[in] useChannel 使用するチャンネル
+     * @param[in] sampleOffset 読み込み開始位置[サンプル]
+     * @param[in] sampleCount 読み込むサンプル数
+     * @retval  実際に読み込んだサンプル数
      */
-    void GetPcmDataChannel(Csm::csmFloat32* dst, Csm::csmUint32 useChannel) const;
+    Csm::csmUint32 GetPcmDataChannel(Csm::csmFloat32* dst, Csm::csmUint32 useChannel, Csm::csmUint32 sampleOffset, Csm::csmUint32 sampleCount);
 
     /**
      * @brief -1～1の範囲の1サンプル取得
@@ -121,7 +136,7 @@ public:
 
 private:
     /**
-     * @brief wavファイルのロード
+     * @brief wavファイルを開きヘッダを解析する
      *
      * @param[in] filePath wavファイルのパス
      * @retval  true    読み込み成功
@@ -130,9 +145,17 @@ private:
     Csm::csmBool LoadWavFile(const Csm::csmString& filePath);
 
     /**
-     * @brief PCMデータの解放
+     * @brief 開いているファイルとチャンクバッファを解放する
      */
-    void ReleasePcmData();
+    void CloseWavFile();
+
+    /**
+     * @brief 指定したサンプル位置から1チャンク分の波形データを読み込む
+     *
+     * @param[in] sampleOffset 読み込み開始位置[サンプル]
+     * @retval  読み込んだサンプル数
+     */
+    Csm::csmUint32 LoadChunk(Csm::csmUint32 sampleOffset);
 
     /**
      * @brief -1～1の範囲の1サンプル取得
@@ -220,15 +243,24 @@ private:
                 && (getSignature[2] == referenceString[2]) && (getSignature[3] == referenceString[3]);
         }
 
-        Csm::csmByte* _fileByte; ///< ロードしたファイルのバイト列
-        Csm::csmSizeInt _fileSize; ///< ファイルサイズ
-        Csm::csmUint32 _readOffset; ///< ファイル参照位置
+        Csm::csmByte* _fileByte; ///< 読み込んだチャンクのバイト列
+        Csm::csmSizeInt _fileSize; ///< チャンクのサイズ
+        Csm::csmUint32 _readOffset; ///< チャンク内の参照位置
     } _byteReader;
 
-    Csm::csmByte* _rawData; ///< 正規化される前のバイト列
-    Csm::csmUint64 _rawDataSize; ///< 正規化される前のバイト列の大きさ
-    Csm::csmFloat32** _pcmData; ///< -1から1の範囲で表現された音声データ配列
+    static const Csm::csmUint32 ChunkSamples = 4096; ///< 1チャンクあたりのサンプル数（1チャンネルあたり）
+
+    FILE* _file; ///< 読み込み中のwavファイル
+    Csm::csmUint64 _dataOffset; ///< ファイル内のdataチャンク波形データの開始位置
+    Csm::csmByte* _chunkData; ///< チャンクの読み込み先
+    Csm::csmUint32 _chunkSampleOffset; ///< 読み込まれているチャンクの先頭サンプル位置
+    Csm::csmUint32 _chunkSampleCount; ///< 読み込まれているチャンクのサンプル数
     Csm::csmUint32 _sampleOffset; ///< サンプル参照位置
     Csm::csmFloat32 _lastRms; ///< 最後に計測したRMS値
     Csm::csmFloat32 _userTimeSeconds; ///< デルタ時間の積算値[秒]
+    Csm::csmFloat32 _rmsWindowSeconds; ///< RMS計測ウィンドウの長さ[秒]
+    Csm::csmVector<Csm::csmFloat32> _rmsWindow; ///< ウィンドウ内の各サンプルの全チャンネル2乗和（リングバッファ）
+    Csm::csmUint32 _rmsWindowHead; ///< リングバッファの書き込み位置
+    Csm::csmUint32 _rmsWindowCount; ///< ウィンドウ内の有効なサンプル数
+    double _rmsSumOfSquares; ///< ウィンドウ内の2乗和
  };
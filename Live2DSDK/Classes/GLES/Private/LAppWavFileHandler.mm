@@ -8,37 +8,58 @@
 #import "LAppWavFileHandler.h"
 #import <cmath>
 #import <cstdint>
+#import <cstring>
 #import "LAppPal.h"
 
+namespace {
+    const Csm::csmFloat32 DefaultRmsWindowSeconds = 1.0f / 30.0f;
+
+    /**
+     * @brief ヘッダ解析用にファイルから指定バイト数を読み込む
+     */
+    Csm::csmBool ReadHeaderBytes(FILE* file, Csm::csmByte* dst, Csm::csmUint32 size)
+    {
+        return fread(dst, 1, size, file) == size;
+    }
+
+    Csm::csmUint32 ToUint32LittleEndian(const Csm::csmByte* data)
+    {
+        return (data[3] << 24) | (data[2] << 16) | (data[1] << 8) | data[0];
+    }
+
+    Csm::csmUint16 ToUint16LittleEndian(const Csm::csmByte* data)
+    {
+        return static_cast<Csm::csmUint16>((data[1] << 8) | data[0]);
+    }
+}
+
 LAppWavFileHandler::LAppWavFileHandler()
-    : _rawData(NULL)
-    , _pcmData(NULL)
+    : _file(NULL)
+    , _dataOffset(0)
+    , _chunkData(NULL)
+    , _chunkSampleOffset(0)
+    , _chunkSampleCount(0)
     , _userTimeSeconds(0.0f)
     , _lastRms(0.0f)
     , _sampleOffset(0)
+    , _rmsWindowSeconds(DefaultRmsWindowSeconds)
+    , _rmsWindowHead(0)
+    , _rmsWindowCount(0)
+    , _rmsSumOfSquares(0.0)
 {
 }
 
 LAppWavFileHandler::~LAppWavFileHandler()
 {
-    if (_rawData != NULL)
-    {
-        CSM_FREE(_rawData);
-    }
-
-    if (_pcmData != NULL)
-    {
-        ReleasePcmData();
-    }
+    CloseWavFile();
 }
 
 Csm::csmBool LAppWavFileHandler::Update(Csm::csmFloat32 deltaTimeSeconds)
 {
     Csm::csmUint32 goalOffset;
-    Csm::csmFloat32 rms;
 
     // データロード前/ファイル末尾に達した場合は更新しない
-    if ((_pcmData == NULL)
+    if ((_file == NULL)
         || (_sampleOffset >= _wavFileInfo._samplesPerChannel))
     {
         _lastRms = 0.0f;
@@ -53,20 +74,63 @@ Csm::csmBool LAppWavFileHandler::Update(Csm::csmFloat32 deltaTimeSeconds)
         goalOffset = _wavFileInfo._samplesPerChannel;
     }
 
-    // RMS計測
-    rms = 0.0f;
-    for (Csm::csmUint32 channelCount = 0; channelCount < _wavFileInfo._numberOfChannels; channelCount++)
+    // バックグラウンドからの復帰などで経過時間が大きい場合も、RMSに影響する直近のウィンドウ1つ分だけを読み込む
+    const Csm::csmUint32 windowSize = _rmsWindow.GetSize();
+    if (goalOffset > _sampleOffset && goalOffset - _sampleOffset > windowSize)
     {
-        for (Csm::csmUint32 sampleCount = _sampleOffset; sampleCount < goalOffset; sampleCount++)
+        _sampleOffset = goalOffset - windowSize;
+        _rmsWindowHead = 0;
+        _rmsWindowCount = 0;
+        _rmsSumOfSquares = 0.0;
+    }
+
+    // 経過したサンプルだけをウィンドウに追加し、押し出されたサンプルの2乗和を差し引く
+    while (_sampleOffset < goalOffset)
+    {
+        if (_sampleOffset >= _chunkSampleOffset + _chunkSampleCount || _sampleOffset < _chunkSampleOffset)
+        {
+            if (LoadChunk(_sampleOffset) == 0)
+            {
+                // dataチャンクの途中で読めなくなった位置を末尾とし、次回から更新を終える
+                _wavFileInfo._samplesPerChannel = _sampleOffset;
+                break;
+            }
+        }
+
+        _byteReader._readOffset = (_sampleOffset - _chunkSampleOffset) * _wavFileInfo._blockAlign;
+
+        Csm::csmFloat32 squares = 0.0f;
+        for (Csm::csmUint32 channelCount = 0; channelCount < _wavFileInfo._numberOfChannels; channelCount++)
+        {
+            const Csm::csmFloat32 pcm = GetPcmSample();
+            squares += pcm * pcm;
+        }
+
+        if (_rmsWindowCount == windowSize)
         {
-            Csm::csmFloat32 pcm = _pcmData[channelCount][sampleCount];
-            rms += pcm * pcm;
+            _rmsSumOfSquares -= _rmsWindow[_rmsWindowHead];
         }
+        else
+        {
+            _rmsWindowCount++;
+        }
+        _rmsWindow[_rmsWindowHead] = squares;
+        _rmsSumOfSquares += squares;
+        _rmsWindowHead = (_rmsWindowHead + 1) % windowSize;
+
+        _sampleOffset++;
+    }
+
+    // 加減算の丸め誤差で負にならないようにする
+    if (_rmsSumOfSquares < 0.0)
+    {
+        _rmsSumOfSquares = 0.0;
     }
-    rms = sqrt(rms / (_wavFileInfo._numberOfChannels * (goalOffset - _sampleOffset)));
 
-    _lastRms = rms;
-    _sampleOffset = goalOffset;
+    if (_rmsWindowCount > 0)
+    {
+        _lastRms = static_cast<Csm::csmFloat32>(sqrt(_rmsSumOfSquares / (_wavFileInfo._numberOfChannels * _rmsWindowCount)));
+    }
     return true;
 }
 
@@ -82,8 +146,23 @@ void LAppWavFileHandler::Start(const Csm::csmString& filePath)
     _sampleOffset = 0;
     _userTimeSeconds = 0.0f;
 
-    // RMS値をリセット
+    // RMS値とウィンドウをリセット
     _lastRms = 0.0f;
+    Csm::csmUint32 windowSize = static_cast<Csm::csmUint32>(_rmsWindowSeconds * _wavFileInfo._samplingRate);
+    if (windowSize == 0)
+    {
+        windowSize = 1;
+    }
+    _rmsWindow.Clear();
+    _rmsWindow.UpdateSize(windowSize, 0.0f, false);
+    _rmsWindowHead = 0;
+    _rmsWindowCount = 0;
+    _rmsSumOfSquares = 0.0;
+}
+
+void LAppWavFileHandler::SetRmsWindowSeconds(Csm::csmFloat32 seconds)
+{
+    _rmsWindowSeconds = seconds;
 }
 
 Csm::csmFloat32 LAppWavFileHandler::GetRms() const
@@ -98,35 +177,45 @@ const LAppWavFileHandler::WavFileInfo& LAppWavFileHandler::GetWavFileInfo() cons
 
 const Csm::csmByte* LAppWavFileHandler::GetRawData() const
 {
-    return _rawData;
+    return _chunkData;
 }
 
 Csm::csmUint64 LAppWavFileHandler::GetRawDataSize() const
 {
-    return _rawDataSize;
+    return static_cast<Csm::csmUint64>(_wavFileInfo._blockAlign) * _chunkSampleCount;
 }
 
-Csm::csmVector<Csm::csmFloat32> LAppWavFileHandler::GetPcmData() const
+Csm::csmUint32 LAppWavFileHandler::GetPcmDataChannel(Csm::csmFloat32* dst, Csm::csmUint32 useChannel, Csm::csmUint32 sampleOffset, Csm::csmUint32 sampleCount)
 {
-    Csm::csmVector<Csm::csmFloat32> buffer;
+    if (_file == NULL || useChannel >= _wavFileInfo._numberOfChannels)
+    {
+        return 0;
+    }
 
-    for (Csm::csmUint32 sampleCount = 0; sampleCount < _wavFileInfo._samplesPerChannel; sampleCount++)
+    Csm::csmUint32 readCount = 0;
+    while (readCount < sampleCount)
     {
-        for (Csm::csmUint32 channelCount = 0; channelCount < _wavFileInfo._numberOfChannels; channelCount++)
+        const Csm::csmUint32 position = sampleOffset + readCount;
+        if (position >= _wavFileInfo._samplesPerChannel)
         {
-            buffer.PushBack(_pcmData[channelCount][sampleCount]);
+            break;
         }
-    }
 
-    return buffer;
-}
+        if (position >= _chunkSampleOffset + _chunkSampleCount || position < _chunkSampleOffset)
+        {
+            if (LoadChunk(position) == 0)
+            {
+                break;
+            }
+        }
 
-void LAppWavFileHandler::GetPcmDataChannel(Csm::csmFloat32* dst, Csm::csmUint32 useChannel) const
-{
-    for (Csm::csmUint32 sampleCount = 0; sampleCount < _wavFileInfo._samplesPerChannel; sampleCount++)
-    {
-        dst[sampleCount] = _pcmData[useChannel][sampleCount];
+        const Csm::csmUint32 bytesPerSample = _wavFileInfo._bitsPerSample / 8;
+        _byteReader._readOffset = (position - _chunkSampleOffset) * _wavFileInfo._blockAlign + useChannel * bytesPerSample;
+        dst[readCount] = GetPcmSample();
+        readCount++;
     }
+
+    return readCount;
 }
 
 Csm::csmFloat32 LAppWavFileHandler::NormalizePcmSample(Csm::csmUint32 bitsPerSample, Csm::csmByte* data, Csm::csmUint32 dataSize)
@@ -193,24 +282,20 @@ Csm::csmFloat32 LAppWavFileHandler::NormalizePcmSample(Csm::csmUint32 bitsPerSam
 Csm::csmBool LAppWavFileHandler::LoadWavFile(const Csm::csmString& filePath)
 {
     Csm::csmBool ret;
+    Csm::csmByte header[16];
 
-    // 既にwavファイルロード済みならば領域開放
-    if (_rawData != NULL)
-    {
-        CSM_FREE(_rawData);
-        _rawDataSize = 0;
-    }
-    if (_pcmData != NULL)
+    // 既にwavファイルを開いていれば閉じる
+    CloseWavFile();
+
+    // バンドル内のリソースとして見つからない場合はそのままのパスで開く
+    std::string resolvedPath = LAppPal::GetResourceFilePath(filePath.GetRawString());
+    if (resolvedPath.empty())
     {
-        ReleasePcmData();
+        resolvedPath = filePath.GetRawString();
     }
 
-    // ファイルロード
-    _byteReader._fileByte = LAppPal::LoadFileAsBytes(filePath.GetRawString(), &(_byteReader._fileSize));
-    _byteReader._readOffset = 0;
-
-    // ファイルロードに失敗しているか、先頭のシグネチャ"RIFF"を入れるサイズもない場合は失敗
-    if ((_byteReader._fileByte == NULL) || (_byteReader._fileSize < 4))
+    _file = fopen(resolvedPath.c_str(), "rb");
+    if (_file == NULL)
     {
         return false;
     }
@@ -219,100 +304,160 @@ Csm::csmBool LAppWavFileHandler::LoadWavFile(const Csm::csmString& filePath)
     _wavFileInfo._fileName = filePath;
 
     do {
-        // シグネチャ "RIFF"
-        if (!_byteReader.GetCheckSignature("RIFF"))
+        // シグネチャ "RIFF"、ファイルサイズ-8（読み飛ばし）、シグネチャ "WAVE"
+        if (!ReadHeaderBytes(_file, header, 12)
+            || memcmp(header, "RIFF", 4) != 0
+            || memcmp(header + 8, "WAVE", 4) != 0)
         {
             ret = false;
             break;
         }
-        // ファイルサイズ-8（読み飛ばし）
-        _byteReader.Get32LittleEndian();
-        // シグネチャ "WAVE"
-        if (!_byteReader.GetCheckSignature("WAVE"))
+        // シグネチャ "fmt " とfmtチャンクサイズ
+        if (!ReadHeaderBytes(_file, header, 8) || memcmp(header, "fmt ", 4) != 0)
         {
             ret = false;
             break;
         }
-        // シグネチャ "fmt "
-        if (!_byteReader.GetCheckSignature("fmt "))
+        const Csm::csmUint32 fmtChunkSize = ToUint32LittleEndian(header + 4);
+        if (fmtChunkSize < 16 || !ReadHeaderBytes(_file, header, 16))
         {
             ret = false;
             break;
         }
-        // fmtチャンクサイズ
-        const Csm::csmUint32 fmtChunkSize = _byteReader.Get32LittleEndian();
         // フォーマットIDは1（リニアPCM）以外受け付けない
-        if (_byteReader.Get16LittleEndian() != 1)
+        if (ToUint16LittleEndian(header) != 1)
         {
             ret = false;
             break;
         }
         // チャンネル数
-        _wavFileInfo._numberOfChannels = _byteReader.Get16LittleEndian();
+        _wavFileInfo._numberOfChannels = ToUint16LittleEndian(header + 2);
         // サンプリングレート
-        _wavFileInfo._samplingRate = _byteReader.Get32LittleEndian();
+        _wavFileInfo._samplingRate = ToUint32LittleEndian(header + 4);
         // 平均データ速度
-        _wavFileInfo._avgBytesPerSec = _byteReader.Get32LittleEndian();
+        _wavFileInfo._avgBytesPerSec = ToUint32LittleEndian(header + 8);
         // ブロックサイズ
-        _wavFileInfo._blockAlign = _byteReader.Get16LittleEndian();
+        _wavFileInfo._blockAlign = ToUint16LittleEndian(header + 12);
         // 量子化ビット数
-        _wavFileInfo._bitsPerSample = _byteReader.Get16LittleEndian();
+        _wavFileInfo._bitsPerSample = ToUint16LittleEndian(header + 14);
+        if (_wavFileInfo._numberOfChannels == 0 || _wavFileInfo._bitsPerSample == 0 || _wavFileInfo._blockAlign == 0)
+        {
+            ret = false;
+            break;
+        }
         // fmtチャンクの拡張部分の読み飛ばし
         if (fmtChunkSize > 16)
         {
-            _byteReader._readOffset += (fmtChunkSize - 16);
+            fseek(_file, fmtChunkSize - 16, SEEK_CUR);
         }
         // "data"チャンクが出現するまで読み飛ばし
-        while (!(_byteReader.GetCheckSignature("data"))
-            && (_byteReader._readOffset < _byteReader._fileSize))
+        Csm::csmBool foundData = false;
+        while (ReadHeaderBytes(_file, header, 8))
         {
-            _byteReader._readOffset += _byteReader.Get32LittleEndian();
+            if (memcmp(header, "data", 4) == 0)
+            {
+                foundData = true;
+                break;
+            }
+            fseek(_file, ToUint32LittleEndian(header + 4), SEEK_CUR);
         }
         // ファイル内に"data"チャンクが出現しなかった
-        if (_byteReader._readOffset >= _byteReader._fileSize)
+        if (!foundData)
         {
             ret = false;
             break;
         }
         // サンプル数
         {
-            const Csm::csmUint32 dataChunkSize = _byteReader.Get32LittleEndian();
+            const Csm::csmUint32 dataChunkSize = ToUint32LittleEndian(header + 4);
             _wavFileInfo._samplesPerChannel = (dataChunkSize * 8) / (_wavFileInfo._bitsPerSample * _wavFileInfo._numberOfChannels);
         }
-        // 領域確保
-        _rawDataSize = static_cast<Csm::csmUint64>(_wavFileInfo._blockAlign) * static_cast<Csm::csmUint64>(_wavFileInfo._samplesPerChannel);
-        _rawData = static_cast<Csm::csmByte*>(CSM_MALLOC(sizeof(Csm::csmByte) * _rawDataSize));
-        _pcmData = static_cast<Csm::csmFloat32**>(CSM_MALLOC(sizeof(Csm::csmFloat32*) * _wavFileInfo._numberOfChannels));
-        for (Csm::csmUint32 channelCount = 0; channelCount < _wavFileInfo._numberOfChannels; channelCount++)
-        {
-            _pcmData[channelCount] = static_cast<Csm::csmFloat32*>(CSM_MALLOC(sizeof(Csm::csmFloat32) * _wavFileInfo._samplesPerChannel));
-        }
-        // 波形データ取得
-        Csm::csmUint64 rawPos = 0;
-        for (Csm::csmUint32 sampleCount = 0; sampleCount < _wavFileInfo._samplesPerChannel; sampleCount++)
+        _dataOffset = static_cast<Csm::csmUint64>(ftell(_file));
+
+        // ファイルが途中で切れていてdataチャンクのサイズに満たない場合は、実際にあるサンプル数に合わせる
+        if (fseek(_file, 0, SEEK_END) == 0)
         {
-            for (Csm::csmUint32 channelCount = 0; channelCount < _wavFileInfo._numberOfChannels; channelCount++)
+            const long fileSize = ftell(_file);
+            if (fileSize >= 0 && static_cast<Csm::csmUint64>(fileSize) >= _dataOffset)
             {
-                // 正規化前
-                for (Csm::csmUint32 byteCount = 0; byteCount < _wavFileInfo._bitsPerSample / 8; byteCount++)
+                const Csm::csmUint64 availableSamples = (static_cast<Csm::csmUint64>(fileSize) - _dataOffset) / _wavFileInfo._blockAlign;
+                if (availableSamples < _wavFileInfo._samplesPerChannel)
                 {
-                    _rawData[rawPos++] = _byteReader._fileByte[_byteReader._readOffset + byteCount];
+                    _wavFileInfo._samplesPerChannel = static_cast<Csm::csmUint32>(availableSamples);
                 }
-                // 正規化後
-                _pcmData[channelCount][sampleCount] = GetPcmSample();
             }
         }
 
+        // チャンク領域確保
+        _chunkData = static_cast<Csm::csmByte*>(CSM_MALLOC(sizeof(Csm::csmByte) * _wavFileInfo._blockAlign * ChunkSamples));
+        _byteReader._fileByte = _chunkData;
+        _byteReader._fileSize = 0;
+        _byteReader._readOffset = 0;
+
         ret = true;
 
     }  while (false);
 
-    // ファイル開放
-    LAppPal::ReleaseBytes(_byteReader._fileByte);
+    if (!ret)
+    {
+        CloseWavFile();
+    }
+
+    return ret;
+}
+
+void LAppWavFileHandler::CloseWavFile()
+{
+    if (_file != NULL)
+    {
+        fclose(_file);
+        _file = NULL;
+    }
+    if (_chunkData != NULL)
+    {
+        CSM_FREE(_chunkData);
+        _chunkData = NULL;
+    }
     _byteReader._fileByte = NULL;
     _byteReader._fileSize = 0;
+    _byteReader._readOffset = 0;
+    _chunkSampleOffset = 0;
+    _chunkSampleCount = 0;
+}
 
-    return ret;
+Csm::csmUint32 LAppWavFileHandler::LoadChunk(Csm::csmUint32 sampleOffset)
+{
+    Csm::csmUint32 sampleCount = ChunkSamples;
+    if (sampleOffset >= _wavFileInfo._samplesPerChannel)
+    {
+        sampleCount = 0;
+    }
+    else if (sampleOffset + sampleCount > _wavFileInfo._samplesPerChannel)
+    {
+        sampleCount = _wavFileInfo._samplesPerChannel - sampleOffset;
+    }
+
+    if (sampleCount > 0)
+    {
+        const Csm::csmUint64 position = _dataOffset + static_cast<Csm::csmUint64>(sampleOffset) * _wavFileInfo._blockAlign;
+        if (fseek(_file, static_cast<long>(position), SEEK_SET) != 0)
+        {
+            sampleCount = 0;
+        }
+        else
+        {
+            // ファイルが途中で切れている場合は読めた分だけを有効とする
+            const size_t readBytes = fread(_chunkData, 1, sampleCount * _wavFileInfo._blockAlign, _file);
+            sampleCount = static_cast<Csm::csmUint32>(readBytes / _wavFileInfo._blockAlign);
+        }
+    }
+
+    _chunkSampleOffset = sampleOffset;
+    _chunkSampleCount = sampleCount;
+    _byteReader._fileSize = sampleCount * _wavFileInfo._blockAlign;
+    _byteReader._readOffset = 0;
+
+    return sampleCount;
 }
 
 Csm::csmFloat32 LAppWavFileHandler::GetPcmSample()
@@ -340,13 +485,3 @@ Csm::csmFloat32 LAppWavFileHandler::GetPcmSample()
 
     return static_cast<Csm::csmFloat32>(pcm32) / INT32_MAX;
 }
-
-void LAppWavFileHandler::ReleasePcmData()
-{
-    for (Csm::csmUint32 channelCount = 0; channelCount < _wavFileInfo._numberOfChannels; channelCount++)
-    {
-        CSM_FREE(_pcmData[channelCount]);
-    }
-    CSM_FREE(_pcmData);
-    _pcmData = NULL;
-}
@@ -38,6 +38,15 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)changeScene:(NSInteger)sceneIndex;
 
+/**
+ * @brief   同じモデルを複数体並べて表示するシーンに切り替える
+ *          2体目以降はMOC・モーション・テクスチャ・クリッピングマスクを1体目と共有する
+ *
+ * @param[in]   sceneIndex      モデルのインデックス
+ * @param[in]   instanceCount   表示する体数
+ */
+- (void)changeScene:(NSInteger)sceneIndex instanceCount:(NSInteger)instanceCount;
+
 
 /**
  * @brief  現在のシーンで保持している全てのモデルを解放する
@@ -90,6 +99,55 @@ NS_ASSUME_NONNULL_BEGIN
 - (BOOL)modelExistsWithIndex:(int)index;
 
 - (GLuint)modelTextureIdWithIndex:(int)index;
+
+/**
+ * @brief   音声解析による母音リップシンクを開始する
+ *          メインスレッドから呼び出す。入力中に呼び出した場合は、appendLipSyncPCM:count:の処理が終わるのを待ってから解析をやり直す
+ *
+ * @param[in]   sampleRate  入力するPCMのサンプリングレート
+ */
+- (void)startLipSyncAnalysisWithSampleRate:(double)sampleRate;
+
+/**
+ * @brief   母音リップシンク用のPCMを入力して解析する
+ *          オーディオスレッドから呼び出す。内部でロックやメモリ確保は行わない
+ *
+ * @param[in]   samples     -1〜1のモノラルPCM
+ * @param[in]   count       サンプル数
+ */
+- (void)appendLipSyncPCM:(const float *)samples count:(NSInteger)count;
+
+/**
+ * @brief   音声解析による母音リップシンクを終了する
+ *          メインスレッドから呼び出す。処理中のappendLipSyncPCM:count:があれば終わるまで待つ
+ */
+- (void)stopLipSyncAnalysis;
+
+/**
+ * @brief   モーションを連番画像に書き出す
+ *          メインスレッドから呼び出し、すぐに戻る。モデルの読み込みと更新に使うCubismIdManagerとアロケータがスレッドセーフではないため、
+ *          モデルの更新と描画はメインキューに1フレームずつ積んで行い、その間も画面の更新は止まらない。
+ *          OpenGLは使わず、描画と画像の書き出しはワーカースレッドで並列に行う
+ *
+ * @param[in]   sceneIndex          モデルのインデックス
+ * @param[in]   group               モーショングループ名
+ * @param[in]   motionIndex         グループ内の番号
+ * @param[in]   framesPerSecond     1秒あたりのフレーム数
+ * @param[in]   width               画像の幅[px]
+ * @param[in]   height              画像の高さ[px]
+ * @param[in]   rawStream           YESの場合はPNGではなく、全フレームを1つのファイルにRGBA8で書き出す
+ * @param[in]   outputDirectory     書き出し先のディレクトリ
+ * @param[in]   completion          全フレームを書き出した後にメインキューで呼ばれる。引数は書き出したフレーム数で、失敗した場合は-1
+ */
+- (void)exportMotionFramesWithSceneIndex:(NSInteger)sceneIndex
+                                   group:(NSString *)group
+                             motionIndex:(NSInteger)motionIndex
+                         framesPerSecond:(float)framesPerSecond
+                                   width:(NSInteger)width
+                                  height:(NSInteger)height
+                               rawStream:(BOOL)rawStream
+                         outputDirectory:(NSString *)outputDirectory
+                              completion:(void (^)(NSInteger frameCount))completion;
 @end
 
 NS_ASSUME_NONNULL_END
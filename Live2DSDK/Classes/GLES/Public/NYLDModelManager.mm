@@ -11,9 +11,14 @@
 #import <CubismMatrix44.hpp>
 #import <csmVector.hpp>
 #import <csmString.hpp>
+#import <CubismMocConsistencyCache.hpp>
 #import "LAppModel.h"
+#import "LAppFrameExporter.h"
 #import <CubismUserModel.hpp>
 #import "LAppTextureManager.h"
+#import "LAppVowelAnalyzer.h"
+#import <atomic>
+#import <thread>
 #import <string.h>
 #import <stdlib.h>
 
@@ -33,12 +38,44 @@ void NYLDFinishedMotion(Csm::ACubismMotion* motion)
     LAppPal::PrintLogLn("Motion Finished: %x", motion);
 }
 
+namespace {
+
+/// Input of RecordDrawTask.
+struct RecordDrawContext
+{
+    Csm::csmVector<LAppModel*>* Models;
+    Csm::csmVector<Csm::CubismMatrix44>* Projections;
+    Csm::csmVector<Csm::csmUint32>* OwnerIndices;
+    Csm::csmVector<Csm::csmBool>* Targets;
+};
+
+/// Records the draws of one mask owner and of every model sharing its clipping mask.
+/// Sharing models also share the clipping manager, so they are recorded in sequence by the same task.
+void RecordDrawTask(void* context, Csm::csmInt32 index)
+{
+    RecordDrawContext* recordContext = static_cast<RecordDrawContext*>(context);
+    Csm::csmVector<LAppModel*>& models = *recordContext->Models;
+    const Csm::csmUint32 ownerIndex = (*recordContext->OwnerIndices)[index];
+    LAppModel* owner = models[ownerIndex];
+
+    for (Csm::csmUint32 i = 0; i < models.GetSize(); ++i)
+    {
+        if ((*recordContext->Targets)[i] && (i == ownerIndex || models[i]->GetSharedSource() == owner))
+        {
+            models[i]->RecordDraw((*recordContext->Projections)[i]);
+        }
+    }
+}
+
+}
+
 @interface NYLDModelManager()
 
 @property (nonatomic) Csm::CubismMatrix44 *viewMatrix; //モデル描画に用いるView行列
 @property (nonatomic) Csm::csmVector<LAppModel*> models; //モデルインスタンスのコンテナ
 
 @property (nonatomic) Csm::csmVector<Csm::csmString> modelDir; ///< モデルディレクトリ名のコンテナ
+@property (nonatomic) LAppVowelAnalyzer *vowelAnalyzer; ///< 母音リップシンク用の音声解析
 
 @property (nonatomic, strong, readwrite) NSBundle *modelBundle;
 @property (nonatomic, strong, readwrite) NSString *resourcePath;
@@ -52,6 +89,14 @@ void NYLDFinishedMotion(Csm::ACubismMotion* motion)
 @end
 
 @implementation NYLDModelManager
+{
+    std::atomic<bool> _lipSyncAnalysisActive; ///< オーディオスレッドへPCM入力の受付を知らせるフラグ
+    std::atomic<Csm::csmInt32> _lipSyncProducerCount; ///< appendLipSyncPCMで解析器を使用中のスレッド数
+    Csm::csmVector<Csm::CubismMatrix44> _recordProjections; ///< 描画コマンドを記録するモデルごとのView-Projection行列
+    Csm::csmVector<Csm::csmUint32> _recordOwnerIndices; ///< クリッピングマスクを保持しているモデルの番号
+    Csm::csmVector<Csm::csmBool> _recordTargets; ///< このフレームで描画コマンドを記録するモデル
+    Csm::csmVector<Csm::csmBool> _impostorTargets; ///< このフレームで描画済みのテクスチャで表示するモデル
+}
 
 + (instancetype)shared {
     static NYLDModelManager *sharedInstance = nil;
@@ -95,6 +140,9 @@ void NYLDFinishedMotion(Csm::ACubismMotion* motion)
 {
     delete _viewMatrix;
     _viewMatrix = nil;
+    [self stopLipSyncAnalysis];
+    delete _vowelAnalyzer;
+    _vowelAnalyzer = NULL;
     [_modelDirectories removeAllObjects];
     _modelDirectories = nil;
     [_modelJSONs removeAllObjects];
@@ -105,7 +153,8 @@ void NYLDFinishedMotion(Csm::ACubismMotion* motion)
 
 - (void)releaseAllModel
 {
-    for (Csm::csmUint32 i = 0; i < _models.GetSize(); i++)
+    // データを共有しているモデルを共有元より先に解放するため、後ろから解放する
+    for (Csm::csmInt32 i = static_cast<Csm::csmInt32>(_models.GetSize()) - 1; i >= 0; i--)
     {
         delete _models[i];
     }
@@ -213,6 +262,66 @@ void NYLDFinishedMotion(Csm::ACubismMotion* motion)
     }
     
     NYLog(@"modelDirectories: %@", self.modelDirectories);
+
+    [self validateMocConsistencyInBackground];
+}
+
+/**
+ * @brief   全モデルのMOC3の整合性をバックグラウンドで検証する
+ *          結果はCachesディレクトリに保存し、次回以降は内容が同じファイルの検証を省略する。
+ *          モデル読み込み時の検証も同じ結果を参照する。
+ *          LAppDefine::MocConsistencyValidationEnableが有効な場合のみ行う。
+ */
+- (void)validateMocConsistencyInBackground
+{
+    if (!LAppDefine::MocConsistencyValidationEnable)
+    {
+        return;
+    }
+
+    NSString *cacheDirectory = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    NSString *cachePath = [cacheDirectory stringByAppendingPathComponent:[NSString stringWithUTF8String:LAppDefine::MocConsistencyCacheFileName]];
+    NSArray<NSString *> *directories = [NSArray arrayWithArray:self.modelDirectories];
+
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        NSData *cache = [NSData dataWithContentsOfFile:cachePath];
+        if (cache != nil)
+        {
+            Csm::CubismMocConsistencyCache::Deserialize(static_cast<const Csm::csmByte*>([cache bytes]), static_cast<Csm::csmSizeInt>([cache length]));
+        }
+
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        for (NSString *directory in directories)
+        {
+            for (NSString *fileName in [fileManager contentsOfDirectoryAtPath:directory error:nil])
+            {
+                if (![[fileName pathExtension] isEqualToString:@"moc3"])
+                {
+                    continue;
+                }
+
+                @autoreleasepool {
+                    NSString *mocPath = [directory stringByAppendingPathComponent:fileName];
+                    // マップしたファイルはcsmAlignofMocに揃っているとは限らないが、HasMocConsistencyが揃えたバッファへ複製して検証する
+                    NSData *moc = [NSData dataWithContentsOfFile:mocPath options:NSDataReadingMappedIfSafe error:nil];
+                    if (moc != nil && !Csm::CubismMocConsistencyCache::HasMocConsistency(static_cast<const Csm::csmByte*>([moc bytes]), static_cast<Csm::csmSizeInt>([moc length])))
+                    {
+                        LAppPal::PrintLogLn("[APP]inconsistent moc3: %s", [mocPath UTF8String]);
+                    }
+                }
+            }
+        }
+
+        // csmVectorはCubismFrameworkのアロケータを使うため、書き出しはメインスレッドで行う
+        dispatch_async(dispatch_get_main_queue(), ^{
+            Csm::csmVector<Csm::csmByte> serialized;
+            Csm::CubismMocConsistencyCache::Serialize(serialized);
+            NSData *data = [NSData dataWithBytes:serialized.GetPtr() length:serialized.GetSize()];
+            dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+                [data writeToFile:cachePath atomically:YES];
+            });
+        });
+    });
 }
 
 - (LAppModel*)getModel:(Csm::csmUint32)no
@@ -271,7 +380,26 @@ void NYLDFinishedMotion(Csm::ACubismMotion* motion)
 //    ViewController* view = [delegate viewController];
 
     Csm::csmUint32 modelCount = _models.GetSize();
-    
+
+    // 描画をワーカースレッドで並列に記録してから、モデルの順にまとめて実行する
+    // インポスターで表示するモデルは記録せず、同じ順番の中で描画スレッドで描画する
+    const bool recordDraw = LAppDefine::RenderCommandRecordingEnable;
+    if (recordDraw)
+    {
+        _recordProjections.UpdateSize(modelCount, Csm::CubismMatrix44(), true);
+        _recordOwnerIndices.UpdateSize(0, 0, false);
+        _recordTargets.Assign(modelCount, false, false);
+        _impostorTargets.Assign(modelCount, false, false);
+    }
+
+    // 母音解析の結果は1フレームに1度だけ取得し、全モデルで共有する
+    LAppVowelAnalyzer::VisemeFrame visemeFrame;
+    memset(&visemeFrame, 0, sizeof(visemeFrame));
+    if (_vowelAnalyzer != NULL && _lipSyncAnalysisActive.load())
+    {
+        visemeFrame = _vowelAnalyzer->GetLatestFrame();
+    }
+
     for (Csm::csmUint32 i = 0; i < modelCount; ++i)
     {
         Csm::CubismMatrix44 projection;
@@ -302,11 +430,86 @@ void NYLDFinishedMotion(Csm::ACubismMotion* motion)
 
 //        [view PreModelDraw:*model];
 
+        const bool isInViewport = !LAppDefine::OffscreenModelSkipEnable || model->IsInViewport(projection);
+        const bool useImpostor = LAppDefine::ImpostorEnable && model->IsImpostorSupported();
+        if (recordDraw)
+        {
+            _recordProjections[i] = projection;
+            _recordTargets[i] = isInViewport && !useImpostor;
+            _impostorTargets[i] = isInViewport && useImpostor;
+            if (model->GetSharedSource() == NULL)
+            {
+                _recordOwnerIndices.PushBack(i);
+            }
+        }
+
+        // 前回の描画で画面外だったモデルは描画せず、矩形が追従する程度に低い頻度で更新する
+        if (!isInViewport)
+        {
+            model->UpdateOffscreen(static_cast<Csm::csmFloat32>(LAppPal::GetDeltaTime()));
+            continue;
+        }
+
+        model->SetLipSyncVisemes(visemeFrame);
+        model->UpdatePhysicsLevelOfDetail(projection, height * [[UIScreen mainScreen] scale]);
         model->Update();
-        model->Draw(projection);///< 参照渡しなのでprojectionは変質する
+
+        // 描画を記録する場合は、全モデルの更新後にまとめて記録・実行する
+        if (recordDraw)
+        {
+            continue;
+        }
+
+        if (useImpostor)
+        {
+            const CGFloat screenScale = [[UIScreen mainScreen] scale];
+            model->DrawWithImpostor(projection, width * screenScale, height * screenScale, static_cast<Csm::csmFloat32>(LAppPal::GetDeltaTime()));///< 参照渡しなのでprojectionは変質する
+        }
+        else
+        {
+            model->Draw(projection);///< 参照渡しなのでprojectionは変質する
+        }
 
 //        [view PostModelDraw:*model];
     }
+
+    if (recordDraw)
+    {
+        // 記録中はワーカースレッドでCubismFrameworkのアロケータを使わないよう、必要なメモリを先に確保する
+        for (Csm::csmUint32 i = 0; i < modelCount; ++i)
+        {
+            if (_recordTargets[i])
+            {
+                [self getModel:i]->PrepareRecordDraw();
+            }
+        }
+
+        RecordDrawContext recordContext;
+        recordContext.Models = &_models;
+        recordContext.Projections = &_recordProjections;
+        recordContext.OwnerIndices = &_recordOwnerIndices;
+        recordContext.Targets = &_recordTargets;
+        LAppPal::ParallelFor(static_cast<Csm::csmInt32>(_recordOwnerIndices.GetSize()), &recordContext, RecordDrawTask);
+
+        const CGFloat screenScale = [[UIScreen mainScreen] scale];
+        for (Csm::csmUint32 i = 0; i < modelCount; ++i)
+        {
+            LAppModel* model = [self getModel:i];
+            if (model->GetModel() == NULL)
+            {
+                continue;
+            }
+
+            if (_recordTargets[i])
+            {
+                model->ExecuteRecordedDraw();
+            }
+            else if (_impostorTargets[i])
+            {
+                model->DrawWithImpostor(_recordProjections[i], width * screenScale, height * screenScale, static_cast<Csm::csmFloat32>(LAppPal::GetDeltaTime()));///< 参照渡しなのでprojectionは変質する
+            }
+        }
+    }
 }
 
 - (void)nextScene;
@@ -316,6 +519,11 @@ void NYLDFinishedMotion(Csm::ACubismMotion* motion)
 }
 
 - (void)changeScene:(NSInteger)index;
+{
+    [self changeScene:index instanceCount:1];
+}
+
+- (void)changeScene:(NSInteger)index instanceCount:(NSInteger)instanceCount;
 {
     if (index < 0 || index >= self.modelJSONs.count ) {
         NYLog(@"Invalid Index!!!!");
@@ -343,6 +551,22 @@ void NYLDFinishedMotion(Csm::ACubismMotion* motion)
     _models.PushBack(new LAppModel());
     _models[0]->LoadAssets(modelPath.GetRawString(), modelJsonName.GetRawString());
 
+    // 2体目以降は1体目のデータを共有し、横に並べる
+    for (NSInteger i = 1; i < instanceCount; ++i)
+    {
+        LAppModel* instance = new LAppModel();
+        instance->LoadAssetsShared(_models[0]);
+        _models.PushBack(instance);
+    }
+    if (instanceCount > 1)
+    {
+        for (Csm::csmUint32 i = 0; i < _models.GetSize(); ++i)
+        {
+            const Csm::csmFloat32 offset = (static_cast<Csm::csmFloat32>(i) - static_cast<Csm::csmFloat32>(_models.GetSize() - 1) * 0.5f) * LAppDefine::CrowdInstanceSpacing;
+            _models[i]->GetModelMatrix()->TranslateX(offset);
+        }
+    }
+
     /*
      * モデル半透明表示を行うサンプルを提示する。
      * ここでUSE_RENDER_TARGET、USE_MODEL_RENDER_TARGETが定義されている場合
@@ -400,6 +624,109 @@ void NYLDFinishedMotion(Csm::ACubismMotion* motion)
     return textureId;
 }
 
+- (void)startLipSyncAnalysisWithSampleRate:(double)sampleRate
+{
+    // 入力中のオーディオスレッドが解析器から抜けるのを待ってから再初期化する
+    [self stopLipSyncAnalysis];
+    if (_vowelAnalyzer == NULL)
+    {
+        _vowelAnalyzer = new LAppVowelAnalyzer();
+    }
+    _vowelAnalyzer->Initialize(static_cast<Csm::csmUint32>(sampleRate));
+    _lipSyncAnalysisActive.store(true);
+}
+
+- (void)appendLipSyncPCM:(const float *)samples count:(NSInteger)count
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    // 先に使用中であることを知らせてからフラグを確認する。
+    // stopLipSyncAnalysisはフラグを下ろした後に使用中のスレッドが無くなるのを待つため、
+    // フラグが立っていれば抜けるまで解析器が再初期化・解放されることはない
+    _lipSyncProducerCount.fetch_add(1);
+    if (_lipSyncAnalysisActive.load() && _vowelAnalyzer != NULL)
+    {
+        _vowelAnalyzer->PushPcm(samples, static_cast<Csm::csmUint32>(count));
+        _vowelAnalyzer->Process();
+    }
+    _lipSyncProducerCount.fetch_sub(1);
+}
+
+- (void)stopLipSyncAnalysis
+{
+    _lipSyncAnalysisActive.store(false);
+
+    // 1回分のPushPcm/Processは短時間で終わるため、ロックは使わずに抜けるのを待つ
+    while (_lipSyncProducerCount.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+- (void)exportMotionFramesWithSceneIndex:(NSInteger)sceneIndex
+                                   group:(NSString *)group
+                             motionIndex:(NSInteger)motionIndex
+                         framesPerSecond:(float)framesPerSecond
+                                   width:(NSInteger)width
+                                  height:(NSInteger)height
+                               rawStream:(BOOL)rawStream
+                         outputDirectory:(NSString *)outputDirectory
+                              completion:(void (^)(NSInteger frameCount))completion
+{
+    // CubismIdManagerとアロケータは表示中のモデルと共有しており、スレッドセーフではない
+    NSAssert([NSThread isMainThread], @"exportMotionFramesWithSceneIndex must be called on the main thread.");
+
+    void (^failed)(void) = ^{
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(-1);
+        });
+    };
+
+    if (![NSThread isMainThread]) {
+        NYLog(@"exportMotionFramesWithSceneIndex must be called on the main thread.");
+        failed();
+        return;
+    }
+
+    if (sceneIndex < 0 || sceneIndex >= _modelDir.GetSize()) {
+        NYLog(@"Invalid Index!!!!");
+        failed();
+        return;
+    }
+
+    // changeSceneと同じ規則でmodel3.jsonのパスを決定する
+    const Csm::csmString& model = _modelDir[(int)sceneIndex];
+
+    Csm::csmString modelPath(self.resPath.UTF8String);
+    modelPath.Append(1, '/');
+    modelPath += model;
+    modelPath.Append(1, '/');
+
+    Csm::csmString modelJsonName(model);
+    modelJsonName += ".model3.json";
+
+    // 表示中のモデルとは別のインスタンスで書き出すため、表示には影響しない
+    LAppFrameExporter* exporter = new LAppFrameExporter();
+    if (!exporter->LoadAssets(modelPath.GetRawString(), modelJsonName.GetRawString()))
+    {
+        delete exporter;
+        failed();
+        return;
+    }
+
+    exporter->ExportMotion(group.UTF8String, (Csm::csmInt32)motionIndex, framesPerSecond,
+                           (Csm::csmUint32)width, (Csm::csmUint32)height,
+                           rawStream ? LAppFrameExporter::OutputFormat_Raw : LAppFrameExporter::OutputFormat_Png,
+                           outputDirectory.UTF8String,
+                           ^(Csm::csmInt32 frameCount) {
+                               delete exporter;
+                               completion(frameCount);
+                           });
+}
+
 + (void)setup {
     [[NYLDModelManager shared] setup];
     [[NYLDModelManager shared] changeScene:0];
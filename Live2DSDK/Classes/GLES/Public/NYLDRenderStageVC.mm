@@ -26,6 +26,8 @@
 #include "CubismOffscreenSurface_OpenGLES2.hpp"
 #import "LAppModel.h"
 #import "NYGLTextureLoader.h"
+#import <CubismProfiler.hpp>
+#import <CubismShader_OpenGLES2.hpp>
 
 #define BUFFER_OFFSET(bytes) ((GLubyte *)NULL + (bytes))
 
@@ -100,6 +102,8 @@ using namespace LAppDefine;
     // set context
     [EAGLContext setCurrentContext:view.context];
 
+    [self prepareShaderPrograms];
+
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -119,6 +123,30 @@ using namespace LAppDefine;
     [self changeBackgroundWithImagePath:[NYLDModelManager backgroundDirFilePathsWithError:nil].firstObject];
     self.paused = false;
 }
+- (void)prepareShaderPrograms
+{
+    // 前回の起動で保存したプログラムバイナリを読み込み、最初の描画の前に全てのシェーダを用意する
+    NSString *cacheDirectory = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    NSString *cachePath = [cacheDirectory stringByAppendingPathComponent:[NSString stringWithUTF8String:LAppDefine::ShaderProgramCacheFileName]];
+    Csm::Rendering::CubismShader_OpenGLES2* shader = Csm::Rendering::CubismShader_OpenGLES2::GetInstance();
+
+    NSData *cache = [NSData dataWithContentsOfFile:cachePath];
+    if (cache != nil)
+    {
+        shader->DeserializeProgramBinaryCache(static_cast<const Csm::csmByte*>([cache bytes]), static_cast<Csm::csmSizeInt>([cache length]));
+    }
+
+    shader->PrepareShaderPrograms();
+
+    // ドライバが変わった場合など、コンパイルし直したときだけ書き出す
+    if (shader->IsProgramBinaryCacheUpdated())
+    {
+        Csm::csmVector<Csm::csmByte> serialized;
+        shader->SerializeProgramBinaryCache(serialized);
+        [[NSData dataWithBytes:serialized.GetPtr() length:serialized.GetSize()] writeToFile:cachePath atomically:YES];
+    }
+}
+
 - (void)viewWillAppear:(BOOL)animated {
     [super viewWillAppear:animated];
     self.paused = false;
@@ -175,6 +203,7 @@ using namespace LAppDefine;
     
     if(mOpenGLRun)
     {
+        CSM_PROFILE_ZONE("Frame");
         
         // 画面クリア
 //        glClear(GL_COLOR_BUFFER_BIT);
@@ -218,6 +247,8 @@ using namespace LAppDefine;
 
         glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     }
+
+    CSM_PROFILE_FRAME();
 }
 
 
@@ -25,6 +25,21 @@ NS_ASSUME_NONNULL_BEGIN
 /// resume when foreground
 + (void)resume;
 
+/// Frame profile in Chrome trace JSON format (chrome://tracing, Perfetto).
+/// Returns nil unless the framework is built with CSM_PROFILE.
++ (nullable NSString *)profilerTraceJSON;
+
+/// Clear the profile and start recording. Call on the main thread.
+/// Does nothing unless the framework is built with CSM_PROFILE.
++ (void)beginProfilerCapture;
+
+/// Stop recording and return the profile recorded since beginProfilerCapture in Chrome trace JSON format.
+/// Returns nil unless the framework is built with CSM_PROFILE.
++ (nullable NSString *)endProfilerCapture;
+
+/// Clear the profile. Recording continues if it was running. Call on the main thread.
++ (void)resetProfiler;
+
 @end
 
 NS_ASSUME_NONNULL_END
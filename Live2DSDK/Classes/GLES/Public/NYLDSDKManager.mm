@@ -15,6 +15,7 @@
 #import "LAppDefine.h"
 
 #import <CubismMatrix44.hpp>
+#import <CubismProfiler.hpp>
 #import "LAppTextureManager.h"
 #import "NYLDModelManager.h"
 #import "NYLDRenderStageVC.h"
@@ -57,7 +58,10 @@
     Csm::CubismFramework::StartUp(&_cubismAllocator,&_cubismOption);
     Csm::CubismFramework::Initialize();
     Csm::CubismMatrix44 projection;
-    LAppPal::UpdateTime();
+    LAppPal::InitializeTime();
+#ifdef CSM_PROFILE
+    Csm::Utils::CubismProfiler::SetEnabled(true);
+#endif
 
 }
 
@@ -98,4 +102,34 @@
     [[NYLDSDKManager shared] resume];
 }
 
++ (NSString *)profilerTraceJSON {
+#ifdef CSM_PROFILE
+    Csm::csmString trace = Csm::Utils::CubismProfiler::ExportChromeTrace();
+    return [NSString stringWithUTF8String:trace.GetRawString()];
+#else
+    return nil;
+#endif
+}
+
++ (void)beginProfilerCapture {
+#ifdef CSM_PROFILE
+    Csm::Utils::CubismProfiler::BeginCapture();
+#endif
+}
+
++ (NSString *)endProfilerCapture {
+#ifdef CSM_PROFILE
+    Csm::Utils::CubismProfiler::EndCapture();
+    return [self profilerTraceJSON];
+#else
+    return nil;
+#endif
+}
+
++ (void)resetProfiler {
+#ifdef CSM_PROFILE
+    Csm::Utils::CubismProfiler::Reset();
+#endif
+}
+
 @end
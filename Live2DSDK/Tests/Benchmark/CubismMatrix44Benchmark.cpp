@@ -0,0 +1,158 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <vector>
+#include <Math/CubismMatrix44.hpp>
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+/// Number of matrices processed per iteration, so that the loop overhead does not dominate.
+const csmInt32 MatrixCount = 256;
+
+void FillMatrices(std::vector<csmFloat32>& matrices)
+{
+    matrices.resize(MatrixCount * 16);
+
+    for (csmInt32 n = 0; n < MatrixCount; ++n)
+    {
+        csmFloat32* m = &matrices[n * 16];
+        memset(m, 0, sizeof(csmFloat32) * 16);
+        m[0] = 1.0f + n * 0.01f;
+        m[1] = 0.1f;
+        m[4] = -0.1f;
+        m[5] = 1.0f - n * 0.001f;
+        m[10] = 1.0f;
+        m[12] = n * 0.5f;
+        m[13] = -n * 0.25f;
+        m[15] = 1.0f;
+    }
+}
+
+/// Scalar multiply, identical to the fallback path of CubismMatrix44::Multiply. Baseline for BM_Multiply.
+void BM_MultiplyScalar(benchmark::State& state)
+{
+    std::vector<csmFloat32> matrices;
+    FillMatrices(matrices);
+    csmFloat32 dst[16];
+
+    for (auto _ : state)
+    {
+        for (csmInt32 n = 0; n + 1 < MatrixCount; ++n)
+        {
+            const csmFloat32* a = &matrices[n * 16];
+            const csmFloat32* b = &matrices[(n + 1) * 16];
+            csmFloat32 c[16] = { 0.0f };
+
+            for (csmInt32 i = 0; i < 4; ++i)
+            {
+                for (csmInt32 j = 0; j < 4; ++j)
+                {
+                    for (csmInt32 k = 0; k < 4; ++k)
+                    {
+                        c[j + i * 4] += a[k + i * 4] * b[j + k * 4];
+                    }
+                }
+            }
+
+            memcpy(dst, c, sizeof(c));
+            benchmark::DoNotOptimize(dst);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * (MatrixCount - 1));
+}
+
+void BM_Multiply(benchmark::State& state)
+{
+    std::vector<csmFloat32> matrices;
+    FillMatrices(matrices);
+    csmFloat32 dst[16];
+
+    for (auto _ : state)
+    {
+        for (csmInt32 n = 0; n + 1 < MatrixCount; ++n)
+        {
+            CubismMatrix44::Multiply(&matrices[n * 16], &matrices[(n + 1) * 16], dst);
+            benchmark::DoNotOptimize(dst);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * (MatrixCount - 1));
+}
+
+void BM_Invert(benchmark::State& state)
+{
+    std::vector<csmFloat32> matrices;
+    FillMatrices(matrices);
+    csmFloat32 dst[16];
+
+    for (auto _ : state)
+    {
+        for (csmInt32 n = 0; n < MatrixCount; ++n)
+        {
+            benchmark::DoNotOptimize(CubismMatrix44::Invert(&matrices[n * 16], dst));
+            benchmark::DoNotOptimize(dst);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * MatrixCount);
+}
+
+/// Transforms one point at a time with TransformX/TransformY. Baseline for BM_TransformPoints.
+void BM_TransformXY(benchmark::State& state)
+{
+    const csmInt32 pointCount = static_cast<csmInt32>(state.range(0));
+    std::vector<csmFloat32> src(pointCount * 2, 0.5f);
+    std::vector<csmFloat32> dst(pointCount * 2);
+
+    CubismMatrix44 matrix;
+    matrix.Scale(1.5f, 0.75f);
+    matrix.Translate(0.25f, -0.5f);
+
+    for (auto _ : state)
+    {
+        for (csmInt32 i = 0; i < pointCount; ++i)
+        {
+            dst[i * 2] = matrix.TransformX(src[i * 2]);
+            dst[i * 2 + 1] = matrix.TransformY(src[i * 2 + 1]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * pointCount);
+}
+
+void BM_TransformPoints(benchmark::State& state)
+{
+    const csmInt32 pointCount = static_cast<csmInt32>(state.range(0));
+    std::vector<csmFloat32> src(pointCount * 2, 0.5f);
+    std::vector<csmFloat32> dst(pointCount * 2);
+
+    CubismMatrix44 matrix;
+    matrix.Scale(1.5f, 0.75f);
+    matrix.Translate(0.25f, -0.5f);
+
+    for (auto _ : state)
+    {
+        matrix.TransformPoints(&src[0], &dst[0], pointCount);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * pointCount);
+}
+
+}
+
+BENCHMARK(BM_MultiplyScalar);
+BENCHMARK(BM_Multiply);
+BENCHMARK(BM_Invert);
+BENCHMARK(BM_TransformXY)->RangeMultiplier(8)->Range(64, 4096);
+BENCHMARK(BM_TransformPoints)->RangeMultiplier(8)->Range(64, 4096);
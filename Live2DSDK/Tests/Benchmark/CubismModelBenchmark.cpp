@@ -0,0 +1,388 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <benchmark/benchmark.h>
+#include <Motion/CubismExpressionMotion.hpp>
+#include <Utils/CubismJson.hpp>
+#include "CubismTestModel.hpp"
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+const csmFloat32 FrameSeconds = 1.0f / 60.0f;
+
+/// Index range covering every bundled model (Haru, Hiyori, Mao, tororo, hijiki, kei_vowels_pro).
+const csmInt32 LastModelIndex = 5;
+
+const CubismTest::BundledModel& GetModel(benchmark::State& state)
+{
+    const CubismTest::BundledModel& bundledModel = CubismTest::GetBundledModels()[state.range(0)];
+    state.SetLabel(bundledModel.Name);
+    return bundledModel;
+}
+
+/// Loads the model or marks the benchmark as failed.
+csmBool LoadModel(benchmark::State& state, CubismTest::TestModel& model)
+{
+    if (!model.LoadAssets(GetModel(state)))
+    {
+        state.SkipWithError("Failed to load the model.");
+        return false;
+    }
+
+    return true;
+}
+
+/// Every JSON file the model setting refers to.
+std::vector<std::string> ListJsonFiles(CubismTest::TestModel& model, const CubismTest::BundledModel& bundledModel)
+{
+    ICubismModelSetting* setting = model.GetModelSetting();
+    std::vector<std::string> files;
+
+    files.push_back(bundledModel.Directory + bundledModel.FileName);
+
+    const csmChar* singleFiles[] =
+    {
+        setting->GetPhysicsFileName(), setting->GetPoseFileName(), setting->GetDisplayInfoFileName(), setting->GetUserDataFile(),
+    };
+    for (csmUint32 i = 0; i < sizeof(singleFiles) / sizeof(singleFiles[0]); ++i)
+    {
+        if (singleFiles[i][0] != '\0')
+        {
+            files.push_back(bundledModel.Directory + singleFiles[i]);
+        }
+    }
+
+    for (csmInt32 i = 0; i < setting->GetExpressionCount(); ++i)
+    {
+        files.push_back(bundledModel.Directory + setting->GetExpressionFileName(i));
+    }
+
+    for (csmInt32 i = 0; i < setting->GetMotionGroupCount(); ++i)
+    {
+        const csmChar* group = setting->GetMotionGroupName(i);
+        for (csmInt32 j = 0; j < setting->GetMotionCount(group); ++j)
+        {
+            files.push_back(bundledModel.Directory + setting->GetMotionFileName(group, j));
+        }
+    }
+
+    return files;
+}
+
+void BM_ModelLoad(benchmark::State& state)
+{
+    const CubismTest::BundledModel& bundledModel = GetModel(state);
+
+    // スタブmocの生成は計測に含めない
+    if (CubismTest::GetStubMoc(bundledModel).empty())
+    {
+        state.SkipWithError("Failed to build the stub moc.");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        CubismTest::TestModel model;
+        benchmark::DoNotOptimize(model.LoadAssets(bundledModel));
+    }
+}
+
+void BM_JsonParse(benchmark::State& state)
+{
+    CubismTest::TestModel model;
+    if (!LoadModel(state, model))
+    {
+        return;
+    }
+
+    const std::vector<std::string> paths = ListJsonFiles(model, GetModel(state));
+    std::vector<std::vector<csmByte> > files(paths.size());
+    csmInt64 totalBytes = 0;
+
+    for (std::vector<std::string>::size_type i = 0; i < paths.size(); ++i)
+    {
+        CubismTest::LoadFile(paths[i], files[i]);
+        totalBytes += static_cast<csmInt64>(files[i].size());
+    }
+
+    for (auto _ : state)
+    {
+        for (std::vector<std::vector<csmByte> >::size_type i = 0; i < files.size(); ++i)
+        {
+            if (files[i].empty())
+            {
+                continue;
+            }
+
+            Utils::CubismJson* json = Utils::CubismJson::Create(&files[i][0], static_cast<csmSizeInt>(files[i].size()));
+            benchmark::DoNotOptimize(json);
+            Utils::CubismJson::Delete(json);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * totalBytes);
+}
+
+void BM_MotionEvaluation(benchmark::State& state)
+{
+    CubismTest::TestModel model;
+    if (!LoadModel(state, model))
+    {
+        return;
+    }
+
+    CubismModel* cubismModel = model.GetModel();
+    CubismMotionManager* motionManager = model.GetMotionManager();
+    csmInt32 motionIndex = 0;
+
+    for (auto _ : state)
+    {
+        if (motionManager->IsFinished())
+        {
+            model.StartMotion(motionIndex);
+            motionIndex = (motionIndex + 1) % model.GetMotionCount();
+        }
+
+        cubismModel->LoadParameters();
+        motionManager->UpdateMotion(cubismModel, FrameSeconds);
+        cubismModel->SaveParameters();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Builds exp3 files mixing all blend types for models that ship without expressions.
+void CreateSyntheticExpressions(CubismTest::TestModel& model, csmVector<ACubismMotion*>& expressions)
+{
+    const char* blends[] = { "Add", "Multiply", "Overwrite" };
+    CubismModel* cubismModel = model.GetModel();
+    const csmInt32 parameterCount = cubismModel->GetParameterCount();
+
+    for (csmInt32 i = 0; i < 4; ++i)
+    {
+        std::string json = "{\"Type\":\"Live2D Expression\",\"Parameters\":[";
+
+        for (csmInt32 j = 0; j < 8 && j < parameterCount; ++j)
+        {
+            const csmInt32 index = (i * 8 + j) % parameterCount;
+            const char* blend = blends[(i + j) % 3];
+            const csmFloat32 value = (blend == blends[1]) ? 1.5f : cubismModel->GetParameterMaximumValue(index) * 0.5f;
+
+            json += (j > 0) ? "," : "";
+            json += "{\"Id\":\"" + std::string(cubismModel->GetParameterId(index)->GetString().GetRawString())
+                  + "\",\"Value\":" + std::to_string(value) + ",\"Blend\":\"" + blend + "\"}";
+        }
+
+        json += "]}";
+
+        ACubismMotion* expression = CubismExpressionMotion::Create(reinterpret_cast<const csmByte*>(json.c_str()), static_cast<csmSizeInt>(json.size()));
+        if (expression)
+        {
+            expressions.PushBack(expression);
+        }
+    }
+}
+
+void BM_ExpressionBlending(benchmark::State& state)
+{
+    CubismTest::TestModel model;
+    if (!LoadModel(state, model))
+    {
+        return;
+    }
+
+    // 表情を持たないモデルでも同じ条件で計測できるように、合成用の表情を生成する
+    csmVector<ACubismMotion*> syntheticExpressions;
+    if (model.GetExpressionCount() == 0)
+    {
+        CreateSyntheticExpressions(model, syntheticExpressions);
+        state.SetLabel(GetModel(state).Name + " (synthetic)");
+    }
+
+    const csmInt32 expressionCount = (model.GetExpressionCount() > 0) ? model.GetExpressionCount() : static_cast<csmInt32>(syntheticExpressions.GetSize());
+    if (expressionCount == 0)
+    {
+        state.SkipWithError("Failed to create expressions.");
+        return;
+    }
+
+    CubismModel* cubismModel = model.GetModel();
+    CubismExpressionMotionManager* expressionManager = model.GetExpressionManager();
+    csmInt32 frame = 0;
+
+    for (auto _ : state)
+    {
+        // 0.5秒毎に表情を切り替え、フェード中の複数の表情を常に合成させる
+        if (frame % 30 == 0)
+        {
+            const csmInt32 index = (frame / 30) % expressionCount;
+
+            if (syntheticExpressions.GetSize() > 0)
+            {
+                expressionManager->StartMotion(syntheticExpressions[index], false);
+            }
+            else
+            {
+                model.SetExpression(index);
+            }
+        }
+        ++frame;
+
+        expressionManager->UpdateMotion(cubismModel, FrameSeconds);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    // マネージャが参照しなくなってから表情を破棄する
+    expressionManager->StopAllMotions();
+    for (csmUint32 i = 0; i < syntheticExpressions.GetSize(); ++i)
+    {
+        ACubismMotion::Delete(syntheticExpressions[i]);
+    }
+}
+
+/// Evaluates the physics while the first motion keeps moving its inputs. Only the physics is timed.
+void RunPhysics(benchmark::State& state, CubismTest::TestModel& model, CubismPhysics* physics)
+{
+    CubismModel* cubismModel = model.GetModel();
+
+    model.StartMotion(0);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        if (model.GetMotionManager()->IsFinished())
+        {
+            model.StartMotion(0);
+        }
+        cubismModel->LoadParameters();
+        model.GetMotionManager()->UpdateMotion(cubismModel, FrameSeconds);
+        cubismModel->SaveParameters();
+        state.ResumeTiming();
+
+        physics->Evaluate(cubismModel, FrameSeconds);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Physics(benchmark::State& state)
+{
+    CubismTest::TestModel model;
+    if (!LoadModel(state, model))
+    {
+        return;
+    }
+
+    if (model.GetPhysics() == NULL)
+    {
+        state.SkipWithError("The model has no physics.");
+        return;
+    }
+
+    RunPhysics(state, model, model.GetPhysics());
+}
+
+/// Same physics3.json with every parameter added as a zero-weight input, so that every parameter is cached.
+/// Baseline for BM_Physics: the difference is the cost of caching parameters the rig does not use,
+/// plus the evaluation of the added inputs.
+void BM_PhysicsDenseCache(benchmark::State& state)
+{
+    CubismTest::TestModel model;
+    if (!LoadModel(state, model))
+    {
+        return;
+    }
+
+    const CubismTest::BundledModel& bundledModel = GetModel(state);
+    const csmChar* fileName = model.GetModelSetting()->GetPhysicsFileName();
+    std::vector<csmByte> physicsJson;
+    if (fileName[0] == '\0' || !CubismTest::LoadFile(bundledModel.Directory + fileName, physicsJson) || physicsJson.empty())
+    {
+        state.SkipWithError("The model has no physics.");
+        return;
+    }
+
+    const std::string denseJson = CubismTest::CreateDensePhysicsJson(physicsJson, model.GetModel());
+    CubismPhysics* physics = denseJson.empty() ? NULL : CubismPhysics::Create(reinterpret_cast<const csmByte*>(denseJson.c_str()), static_cast<csmSizeInt>(denseJson.size()));
+    if (physics == NULL)
+    {
+        state.SkipWithError("Failed to create the physics.");
+        return;
+    }
+
+    RunPhysics(state, model, physics);
+
+    CubismPhysics::Delete(physics);
+}
+
+/// Builds a pose3 file switching pairs of parts for models that ship without a pose.
+CubismPose* CreateSyntheticPose(CubismTest::TestModel& model)
+{
+    CubismModel* cubismModel = model.GetModel();
+    const csmInt32 partCount = cubismModel->GetPartCount();
+    std::string json = "{\"Type\":\"Live2D Pose\",\"Groups\":[";
+
+    for (csmInt32 i = 0; i + 1 < partCount && i < 8; i += 2)
+    {
+        json += (i > 0) ? "," : "";
+        json += "[{\"Id\":\"" + std::string(cubismModel->GetPartId(i)->GetString().GetRawString()) + "\",\"Link\":[]},"
+              + "{\"Id\":\"" + std::string(cubismModel->GetPartId(i + 1)->GetString().GetRawString()) + "\",\"Link\":[]}]";
+    }
+
+    json += "]}";
+
+    return CubismPose::Create(reinterpret_cast<const csmByte*>(json.c_str()), static_cast<csmSizeInt>(json.size()));
+}
+
+void BM_Pose(benchmark::State& state)
+{
+    CubismTest::TestModel model;
+    if (!LoadModel(state, model))
+    {
+        return;
+    }
+
+    CubismPose* syntheticPose = NULL;
+    if (model.GetPose() == NULL)
+    {
+        syntheticPose = CreateSyntheticPose(model);
+        state.SetLabel(GetModel(state).Name + " (synthetic)");
+    }
+
+    CubismModel* cubismModel = model.GetModel();
+    CubismPose* pose = (syntheticPose != NULL) ? syntheticPose : model.GetPose();
+    if (pose == NULL)
+    {
+        state.SkipWithError("Failed to create the pose.");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        pose->UpdateParameters(cubismModel, FrameSeconds);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (syntheticPose != NULL)
+    {
+        CubismPose::Delete(syntheticPose);
+    }
+}
+
+}
+
+BENCHMARK(BM_ModelLoad)->DenseRange(0, LastModelIndex)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_JsonParse)->DenseRange(0, LastModelIndex)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MotionEvaluation)->DenseRange(0, LastModelIndex);
+BENCHMARK(BM_ExpressionBlending)->DenseRange(0, LastModelIndex);
+BENCHMARK(BM_Physics)->DenseRange(0, LastModelIndex);
+BENCHMARK(BM_PhysicsDenseCache)->DenseRange(0, LastModelIndex);
+BENCHMARK(BM_Pose)->DenseRange(0, LastModelIndex);
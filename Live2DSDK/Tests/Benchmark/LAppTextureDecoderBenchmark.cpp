@@ -0,0 +1,141 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "LAppTextureDecoder.h"
+#include "CubismTestSupport.hpp"
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+const csmInt32 LastModelIndex = 5;
+
+/// Loads every *.2048/texture_*.png of a bundled model.
+csmBool LoadTextures(benchmark::State& state, std::vector<std::vector<csmByte> >& files)
+{
+    const CubismTest::BundledModel& bundledModel = CubismTest::GetBundledModels()[state.range(0)];
+    const std::vector<std::string> paths = CubismTest::ListFiles(bundledModel.Directory + bundledModel.Name + ".2048/", ".png");
+
+    state.SetLabel(bundledModel.Name);
+    files.resize(paths.size());
+
+    for (std::vector<std::string>::size_type i = 0; i < paths.size(); ++i)
+    {
+        if (!CubismTest::LoadFile(paths[i], files[i]) || files[i].empty())
+        {
+            state.SkipWithError("Failed to read a texture.");
+            return false;
+        }
+    }
+
+    if (files.empty())
+    {
+        state.SkipWithError("The model has no textures.");
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<LAppTextureDecoder::DecodeJob> CreateJobs(std::vector<std::vector<csmByte> >& files)
+{
+    std::vector<LAppTextureDecoder::DecodeJob> jobs(files.size());
+
+    for (std::vector<std::vector<csmByte> >::size_type i = 0; i < files.size(); ++i)
+    {
+        jobs[i].fileData = &files[i][0];
+        jobs[i].fileSize = static_cast<csmSizeInt>(files[i].size());
+    }
+
+    return jobs;
+}
+
+void ReleaseJobs(std::vector<LAppTextureDecoder::DecodeJob>& jobs)
+{
+    for (std::vector<LAppTextureDecoder::DecodeJob>::size_type i = 0; i < jobs.size(); ++i)
+    {
+        LAppTextureDecoder::ReleasePixels(jobs[i].pixels);
+        jobs[i].pixels = NULL;
+    }
+}
+
+/// Decodes the textures one by one on the calling thread. Baseline for BM_DecodePngBatch.
+void BM_DecodePngSequential(benchmark::State& state)
+{
+    std::vector<std::vector<csmByte> > files;
+    if (!LoadTextures(state, files))
+    {
+        return;
+    }
+
+    std::vector<LAppTextureDecoder::DecodeJob> jobs = CreateJobs(files);
+
+    for (auto _ : state)
+    {
+        for (std::vector<LAppTextureDecoder::DecodeJob>::size_type i = 0; i < jobs.size(); ++i)
+        {
+            LAppTextureDecoder::DecodePng(jobs[i], true);
+        }
+
+        state.PauseTiming();
+        ReleaseJobs(jobs);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<csmInt64>(jobs.size()));
+}
+
+void BM_DecodePngBatch(benchmark::State& state)
+{
+    std::vector<std::vector<csmByte> > files;
+    if (!LoadTextures(state, files))
+    {
+        return;
+    }
+
+    std::vector<LAppTextureDecoder::DecodeJob> jobs = CreateJobs(files);
+
+    for (auto _ : state)
+    {
+        LAppTextureDecoder::DecodePngBatch(&jobs[0], static_cast<csmUint32>(jobs.size()), true);
+
+        state.PauseTiming();
+        ReleaseJobs(jobs);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<csmInt64>(jobs.size()));
+}
+
+void BM_PremultiplyAlpha(benchmark::State& state)
+{
+    const csmUint32 pixelCount = 2048 * 2048;
+    std::vector<csmByte> source(pixelCount * 4);
+
+    for (csmUint32 i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<csmByte>(i * 2654435761u >> 24);
+    }
+
+    std::vector<csmByte> pixels(source);
+
+    for (auto _ : state)
+    {
+        LAppTextureDecoder::PremultiplyAlpha(&pixels[0], pixelCount);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<csmInt64>(source.size()));
+}
+
+}
+
+BENCHMARK(BM_DecodePngSequential)->DenseRange(0, LastModelIndex)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_DecodePngBatch)->DenseRange(0, LastModelIndex)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_PremultiplyAlpha)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,747 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "Live2DCubismCoreStub.h"
+#include <algorithm>
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+namespace {
+
+const char StubMagic[4] = { 'S', 'M', 'O', 'C' };
+
+std::atomic<unsigned long long> s_updateCount(0);
+
+csmLogFunction s_logFunction = NULL;
+
+/// Sections of a validated stub moc.
+struct StubMoc
+{
+    const csmStubMocHeader* Header;
+    const csmStubParameter* Parameters;
+    const csmStubPart* Parts;
+    const csmStubDrawable* Drawables;
+    const csmStubBinding* Bindings;
+    const int* Masks;
+    const csmVector2* Positions;
+    const csmVector2* Uvs;
+    const unsigned short* Indices;
+};
+
+/// Model instance. Every array lives in the memory handed to csmInitializeModelInPlace.
+struct StubModel
+{
+    StubMoc Moc;
+
+    const char** ParameterIds;
+    csmParameterType* ParameterTypes;
+    float* ParameterMinimumValues;
+    float* ParameterMaximumValues;
+    float* ParameterDefaultValues;
+    float* ParameterValues;
+    float* AppliedParameterValues;
+    int* ParameterKeyCounts;
+    const float** ParameterKeyValues;
+    float* ParameterKeyStorage;
+
+    const char** PartIds;
+    float* PartOpacities;
+    int* PartParentPartIndices;
+
+    const char** DrawableIds;
+    csmFlags* ConstantFlags;
+    csmFlags* DynamicFlags;
+    int* TextureIndices;
+    int* DrawOrders;
+    int* RenderOrders;
+    float* Opacities;
+    int* MaskCounts;
+    const int** Masks;
+    int* VertexCounts;
+    const csmVector2** VertexPositions;
+    csmVector2* VertexPositionStorage;
+    const csmVector2** VertexUvs;
+    int* IndexCounts;
+    const unsigned short** Indices;
+    csmVector4* MultiplyColors;
+    csmVector4* ScreenColors;
+    int* DrawableParentPartIndices;
+
+    int IsFirstUpdate;
+    int IsResetPending;
+};
+
+void Log(const char* message)
+{
+    if (s_logFunction)
+    {
+        s_logFunction(message);
+    }
+}
+
+unsigned int Align4(unsigned int size)
+{
+    return (size + 3u) & ~3u;
+}
+
+/// Splits a moc into its sections. Returns false if any section or reference is out of range.
+bool ReadMoc(const void* address, unsigned int size, StubMoc& moc)
+{
+    if (!address || (reinterpret_cast<uintptr_t>(address) % csmAlignofMoc) != 0)
+    {
+        Log("[STUB] moc address is not aligned to csmAlignofMoc.");
+        return false;
+    }
+
+    if (size < sizeof(csmStubMocHeader))
+    {
+        return false;
+    }
+
+    const csmStubMocHeader* header = static_cast<const csmStubMocHeader*>(address);
+
+    if (memcmp(header->Magic, StubMagic, sizeof(StubMagic)) != 0 || header->FileSize != size)
+    {
+        return false;
+    }
+
+    // 個数が大きすぎる場合はオフセットの計算が溢れるので先に弾く
+    const unsigned int limit = 1u << 24;
+    if (header->ParameterCount > limit || header->PartCount > limit || header->DrawableCount > limit
+        || header->BindingCount > limit || header->MaskCount > limit || header->VertexCount > limit
+        || header->IndexCount > limit)
+    {
+        return false;
+    }
+
+    uint64_t offset = sizeof(csmStubMocHeader);
+    const char* base = static_cast<const char*>(address);
+
+    moc.Header = header;
+    moc.Parameters = reinterpret_cast<const csmStubParameter*>(base + offset);
+    offset += sizeof(csmStubParameter) * static_cast<uint64_t>(header->ParameterCount);
+    moc.Parts = reinterpret_cast<const csmStubPart*>(base + offset);
+    offset += sizeof(csmStubPart) * static_cast<uint64_t>(header->PartCount);
+    moc.Drawables = reinterpret_cast<const csmStubDrawable*>(base + offset);
+    offset += sizeof(csmStubDrawable) * static_cast<uint64_t>(header->DrawableCount);
+    moc.Bindings = reinterpret_cast<const csmStubBinding*>(base + offset);
+    offset += sizeof(csmStubBinding) * static_cast<uint64_t>(header->BindingCount);
+    moc.Masks = reinterpret_cast<const int*>(base + offset);
+    offset += sizeof(int) * static_cast<uint64_t>(header->MaskCount);
+    moc.Positions = reinterpret_cast<const csmVector2*>(base + offset);
+    offset += sizeof(csmVector2) * static_cast<uint64_t>(header->VertexCount);
+    moc.Uvs = reinterpret_cast<const csmVector2*>(base + offset);
+    offset += sizeof(csmVector2) * static_cast<uint64_t>(header->VertexCount);
+    moc.Indices = reinterpret_cast<const unsigned short*>(base + offset);
+    offset += Align4(sizeof(unsigned short) * header->IndexCount);
+
+    if (offset != size)
+    {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < header->ParameterCount; ++i)
+    {
+        const csmStubParameter& parameter = moc.Parameters[i];
+        if (memchr(parameter.Id, 0, csmStubIdLength) == NULL || !(parameter.MinimumValue <= parameter.MaximumValue))
+        {
+            return false;
+        }
+    }
+
+    for (unsigned int i = 0; i < header->PartCount; ++i)
+    {
+        const csmStubPart& part = moc.Parts[i];
+        if (memchr(part.Id, 0, csmStubIdLength) == NULL
+            || part.ParentPartIndex < -1 || part.ParentPartIndex >= static_cast<int>(i))
+        {
+            // 親は自身より前に置く。循環を防ぐため
+            return false;
+        }
+    }
+
+    for (unsigned int i = 0; i < header->DrawableCount; ++i)
+    {
+        const csmStubDrawable& drawable = moc.Drawables[i];
+        if (memchr(drawable.Id, 0, csmStubIdLength) == NULL
+            || drawable.ParentPartIndex < -1 || drawable.ParentPartIndex >= static_cast<int>(header->PartCount)
+            || drawable.TextureIndex < 0
+            || static_cast<uint64_t>(drawable.BindingOffset) + drawable.BindingCount > header->BindingCount
+            || static_cast<uint64_t>(drawable.MaskOffset) + drawable.MaskCount > header->MaskCount
+            || static_cast<uint64_t>(drawable.VertexOffset) + drawable.VertexCount > header->VertexCount
+            || static_cast<uint64_t>(drawable.IndexOffset) + drawable.IndexCount > header->IndexCount
+            || drawable.VertexCount > 0xFFFFu
+            || (drawable.IndexCount % 3) != 0)
+        {
+            return false;
+        }
+
+        for (unsigned int j = 0; j < drawable.BindingCount; ++j)
+        {
+            const int parameterIndex = moc.Bindings[drawable.BindingOffset + j].ParameterIndex;
+            if (parameterIndex < 0 || parameterIndex >= static_cast<int>(header->ParameterCount))
+            {
+                return false;
+            }
+        }
+
+        for (unsigned int j = 0; j < drawable.MaskCount; ++j)
+        {
+            const int maskIndex = moc.Masks[drawable.MaskOffset + j];
+            if (maskIndex < 0 || maskIndex >= static_cast<int>(header->DrawableCount))
+            {
+                return false;
+            }
+        }
+
+        for (unsigned int j = 0; j < drawable.IndexCount; ++j)
+        {
+            if (moc.Indices[drawable.IndexOffset + j] >= drawable.VertexCount)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/// Bump allocator used both to size and to lay out a model.
+struct ModelLayout
+{
+    char* Base;
+    unsigned int Size;
+
+    template <class T>
+    T* Take(unsigned int count)
+    {
+        Size = (Size + 15u) & ~15u;
+        T* result = Base ? reinterpret_cast<T*>(Base + Size) : NULL;
+        Size += static_cast<unsigned int>(sizeof(T)) * count;
+        return result;
+    }
+};
+
+void LayoutModel(const StubMoc& moc, ModelLayout& layout, StubModel*& model)
+{
+    const csmStubMocHeader& header = *moc.Header;
+
+    model = layout.Take<StubModel>(1);
+    StubModel dummy;
+    StubModel& m = model ? *model : dummy;
+
+    m.ParameterIds = layout.Take<const char*>(header.ParameterCount);
+    m.ParameterTypes = layout.Take<csmParameterType>(header.ParameterCount);
+    m.ParameterMinimumValues = layout.Take<float>(header.ParameterCount);
+    m.ParameterMaximumValues = layout.Take<float>(header.ParameterCount);
+    m.ParameterDefaultValues = layout.Take<float>(header.ParameterCount);
+    m.ParameterValues = layout.Take<float>(header.ParameterCount);
+    m.AppliedParameterValues = layout.Take<float>(header.ParameterCount);
+    m.ParameterKeyCounts = layout.Take<int>(header.ParameterCount);
+    m.ParameterKeyValues = layout.Take<const float*>(header.ParameterCount);
+    m.ParameterKeyStorage = layout.Take<float>(header.ParameterCount * 2);
+
+    m.PartIds = layout.Take<const char*>(header.PartCount);
+    m.PartOpacities = layout.Take<float>(header.PartCount);
+    m.PartParentPartIndices = layout.Take<int>(header.PartCount);
+
+    m.DrawableIds = layout.Take<const char*>(header.DrawableCount);
+    m.ConstantFlags = layout.Take<csmFlags>(header.DrawableCount);
+    m.DynamicFlags = layout.Take<csmFlags>(header.DrawableCount);
+    m.TextureIndices = layout.Take<int>(header.DrawableCount);
+    m.DrawOrders = layout.Take<int>(header.DrawableCount);
+    m.RenderOrders = layout.Take<int>(header.DrawableCount);
+    m.Opacities = layout.Take<float>(header.DrawableCount);
+    m.MaskCounts = layout.Take<int>(header.DrawableCount);
+    m.Masks = layout.Take<const int*>(header.DrawableCount);
+    m.VertexCounts = layout.Take<int>(header.DrawableCount);
+    m.VertexPositions = layout.Take<const csmVector2*>(header.DrawableCount);
+    m.VertexPositionStorage = layout.Take<csmVector2>(header.VertexCount);
+    m.VertexUvs = layout.Take<const csmVector2*>(header.DrawableCount);
+    m.IndexCounts = layout.Take<int>(header.DrawableCount);
+    m.Indices = layout.Take<const unsigned short*>(header.DrawableCount);
+    m.MultiplyColors = layout.Take<csmVector4>(header.DrawableCount);
+    m.ScreenColors = layout.Take<csmVector4>(header.DrawableCount);
+    m.DrawableParentPartIndices = layout.Take<int>(header.DrawableCount);
+}
+
+float GetPartChainOpacity(const StubModel& model, int partIndex)
+{
+    float opacity = 1.0f;
+
+    while (partIndex >= 0)
+    {
+        opacity *= model.PartOpacities[partIndex];
+        partIndex = model.PartParentPartIndices[partIndex];
+    }
+
+    return opacity;
+}
+
+void UpdateDrawable(StubModel& model, unsigned int drawableIndex)
+{
+    const csmStubDrawable& drawable = model.Moc.Drawables[drawableIndex];
+    csmFlags flags = model.DynamicFlags[drawableIndex];
+
+    // 不透明度と表示状態
+    const float opacity = drawable.Opacity * GetPartChainOpacity(model, drawable.ParentPartIndex);
+    const csmFlags visible = (opacity > 0.0f) ? csmIsVisible : 0;
+
+    if (model.IsFirstUpdate || opacity != model.Opacities[drawableIndex])
+    {
+        flags |= csmOpacityDidChange;
+    }
+
+    if (model.IsFirstUpdate || visible != (flags & csmIsVisible))
+    {
+        flags |= csmVisibilityDidChange;
+    }
+
+    flags = static_cast<csmFlags>((flags & ~csmIsVisible) | visible);
+    model.Opacities[drawableIndex] = opacity;
+
+    // 頂点の変形。関係するパラメータが変わったときだけ計算し直す
+    int isDeformed = model.IsFirstUpdate;
+    for (unsigned int i = 0; i < drawable.BindingCount && !isDeformed; ++i)
+    {
+        const int parameterIndex = model.Moc.Bindings[drawable.BindingOffset + i].ParameterIndex;
+        isDeformed = (model.ParameterValues[parameterIndex] != model.AppliedParameterValues[parameterIndex]);
+    }
+
+    if (isDeformed)
+    {
+        float deltaX = 0.0f;
+        float deltaY = 0.0f;
+
+        for (unsigned int i = 0; i < drawable.BindingCount; ++i)
+        {
+            const csmStubBinding& binding = model.Moc.Bindings[drawable.BindingOffset + i];
+            const csmStubParameter& parameter = model.Moc.Parameters[binding.ParameterIndex];
+            const float range = parameter.MaximumValue - parameter.MinimumValue;
+            const float amount = (range > 0.0f)
+                               ? (model.ParameterValues[binding.ParameterIndex] - parameter.DefaultValue) / range
+                               : 0.0f;
+
+            deltaX += amount * binding.DeltaX;
+            deltaY += amount * binding.DeltaY;
+        }
+
+        const csmVector2* positions = model.Moc.Positions + drawable.VertexOffset;
+        const csmVector2* uvs = model.Moc.Uvs + drawable.VertexOffset;
+        csmVector2* output = model.VertexPositionStorage + drawable.VertexOffset;
+
+        for (unsigned int i = 0; i < drawable.VertexCount; ++i)
+        {
+            const float weight = 0.25f + 0.75f * uvs[i].Y;
+            output[i].X = positions[i].X + deltaX * weight;
+            output[i].Y = positions[i].Y + deltaY * weight;
+        }
+
+        flags |= csmVertexPositionsDidChange;
+    }
+
+    if (model.IsFirstUpdate)
+    {
+        flags |= csmDrawOrderDidChange | csmRenderOrderDidChange | csmBlendColorDidChange;
+    }
+
+    model.DynamicFlags[drawableIndex] = flags;
+}
+
+}
+
+extern "C"
+{
+
+csmVersion csmGetVersion()
+{
+    return 0x05000000;
+}
+
+csmMocVersion csmGetLatestMocVersion()
+{
+    return csmMocVersion_50;
+}
+
+csmMocVersion csmGetMocVersion(const void* address, const unsigned int size)
+{
+    if (!address || size < sizeof(csmStubMocHeader))
+    {
+        return csmMocVersion_Unknown;
+    }
+
+    const csmStubMocHeader* header = static_cast<const csmStubMocHeader*>(address);
+    if (memcmp(header->Magic, StubMagic, sizeof(StubMagic)) != 0)
+    {
+        return csmMocVersion_Unknown;
+    }
+
+    return header->MocVersion;
+}
+
+int csmHasMocConsistency(void* address, const unsigned int size)
+{
+    StubMoc moc;
+    return ReadMoc(address, size, moc) ? 1 : 0;
+}
+
+csmLogFunction csmGetLogFunction()
+{
+    return s_logFunction;
+}
+
+void csmSetLogFunction(csmLogFunction handler)
+{
+    s_logFunction = handler;
+}
+
+csmMoc* csmReviveMocInPlace(void* address, const unsigned int size)
+{
+    StubMoc moc;
+    if (!ReadMoc(address, size, moc))
+    {
+        Log("[STUB] failed to revive moc.");
+        return NULL;
+    }
+
+    if (moc.Header->MocVersion > csmGetLatestMocVersion())
+    {
+        Log("[STUB] unsupported moc version.");
+        return NULL;
+    }
+
+    return static_cast<csmMoc*>(address);
+}
+
+unsigned int csmGetSizeofModel(const csmMoc* moc)
+{
+    StubMoc sections;
+    const csmStubMocHeader* header = reinterpret_cast<const csmStubMocHeader*>(moc);
+    if (!header || !ReadMoc(moc, header->FileSize, sections))
+    {
+        return 0;
+    }
+
+    ModelLayout layout = { NULL, 0 };
+    StubModel* model = NULL;
+    LayoutModel(sections, layout, model);
+
+    return layout.Size;
+}
+
+csmModel* csmInitializeModelInPlace(const csmMoc* moc, void* address, const unsigned int size)
+{
+    if (!address || (reinterpret_cast<uintptr_t>(address) % csmAlignofModel) != 0)
+    {
+        Log("[STUB] model address is not aligned to csmAlignofModel.");
+        return NULL;
+    }
+
+    StubMoc sections;
+    const csmStubMocHeader* header = reinterpret_cast<const csmStubMocHeader*>(moc);
+    if (!header || !ReadMoc(moc, header->FileSize, sections))
+    {
+        return NULL;
+    }
+
+    ModelLayout layout = { NULL, 0 };
+    StubModel* model = NULL;
+    LayoutModel(sections, layout, model);
+    if (size < layout.Size)
+    {
+        return NULL;
+    }
+
+    memset(address, 0, layout.Size);
+    layout.Base = static_cast<char*>(address);
+    layout.Size = 0;
+    LayoutModel(sections, layout, model);
+
+    model->Moc = sections;
+
+    for (unsigned int i = 0; i < header->ParameterCount; ++i)
+    {
+        const csmStubParameter& parameter = sections.Parameters[i];
+        model->ParameterIds[i] = parameter.Id;
+        model->ParameterTypes[i] = parameter.Type;
+        model->ParameterMinimumValues[i] = parameter.MinimumValue;
+        model->ParameterMaximumValues[i] = parameter.MaximumValue;
+        model->ParameterDefaultValues[i] = parameter.DefaultValue;
+        model->ParameterValues[i] = parameter.DefaultValue;
+        model->AppliedParameterValues[i] = parameter.DefaultValue;
+        model->ParameterKeyCounts[i] = 2;
+        model->ParameterKeyStorage[i * 2 + 0] = parameter.MinimumValue;
+        model->ParameterKeyStorage[i * 2 + 1] = parameter.MaximumValue;
+        model->ParameterKeyValues[i] = model->ParameterKeyStorage + i * 2;
+    }
+
+    for (unsigned int i = 0; i < header->PartCount; ++i)
+    {
+        model->PartIds[i] = sections.Parts[i].Id;
+        model->PartOpacities[i] = sections.Parts[i].DefaultOpacity;
+        model->PartParentPartIndices[i] = sections.Parts[i].ParentPartIndex;
+    }
+
+    for (unsigned int i = 0; i < header->DrawableCount; ++i)
+    {
+        const csmStubDrawable& drawable = sections.Drawables[i];
+        model->DrawableIds[i] = drawable.Id;
+        model->ConstantFlags[i] = static_cast<csmFlags>(drawable.ConstantFlags);
+        model->TextureIndices[i] = drawable.TextureIndex;
+        model->DrawOrders[i] = drawable.DrawOrder;
+        model->MaskCounts[i] = static_cast<int>(drawable.MaskCount);
+        model->Masks[i] = sections.Masks + drawable.MaskOffset;
+        model->VertexCounts[i] = static_cast<int>(drawable.VertexCount);
+        model->VertexPositions[i] = model->VertexPositionStorage + drawable.VertexOffset;
+        model->VertexUvs[i] = sections.Uvs + drawable.VertexOffset;
+        model->IndexCounts[i] = static_cast<int>(drawable.IndexCount);
+        model->Indices[i] = sections.Indices + drawable.IndexOffset;
+        model->MultiplyColors[i] = drawable.MultiplyColor;
+        model->ScreenColors[i] = drawable.ScreenColor;
+        model->DrawableParentPartIndices[i] = drawable.ParentPartIndex;
+    }
+
+    // 描画順（DrawOrderの昇順、同じ値はインデックス順）を描画順位に変換する
+    int* sortedIndices = model->RenderOrders;
+    for (unsigned int i = 0; i < header->DrawableCount; ++i)
+    {
+        sortedIndices[i] = static_cast<int>(i);
+    }
+    std::stable_sort(sortedIndices, sortedIndices + header->DrawableCount, [&sections](int a, int b)
+    {
+        return sections.Drawables[a].DrawOrder < sections.Drawables[b].DrawOrder;
+    });
+    int* renderOrders = new int[header->DrawableCount];
+    for (unsigned int i = 0; i < header->DrawableCount; ++i)
+    {
+        renderOrders[sortedIndices[i]] = static_cast<int>(i);
+    }
+    memcpy(model->RenderOrders, renderOrders, sizeof(int) * header->DrawableCount);
+    delete[] renderOrders;
+
+    model->IsFirstUpdate = 1;
+    csmUpdateModel(reinterpret_cast<csmModel*>(model));
+
+    return reinterpret_cast<csmModel*>(model);
+}
+
+void csmUpdateModel(csmModel* model)
+{
+    StubModel& m = *reinterpret_cast<StubModel*>(model);
+    const csmStubMocHeader& header = *m.Moc.Header;
+
+    ++s_updateCount;
+
+    if (m.IsResetPending)
+    {
+        for (unsigned int i = 0; i < header.DrawableCount; ++i)
+        {
+            m.DynamicFlags[i] &= csmIsVisible;
+        }
+        m.IsResetPending = 0;
+    }
+
+    for (unsigned int i = 0; i < header.ParameterCount; ++i)
+    {
+        if (m.ParameterValues[i] < m.ParameterMinimumValues[i])
+        {
+            m.ParameterValues[i] = m.ParameterMinimumValues[i];
+        }
+        else if (m.ParameterValues[i] > m.ParameterMaximumValues[i])
+        {
+            m.ParameterValues[i] = m.ParameterMaximumValues[i];
+        }
+    }
+
+    for (unsigned int i = 0; i < header.DrawableCount; ++i)
+    {
+        UpdateDrawable(m, i);
+    }
+
+    memcpy(m.AppliedParameterValues, m.ParameterValues, sizeof(float) * header.ParameterCount);
+    m.IsFirstUpdate = 0;
+}
+
+void csmReadCanvasInfo(const csmModel* model, csmVector2* outSizeInPixels, csmVector2* outOriginInPixels, float* outPixelsPerUnit)
+{
+    const csmStubMocHeader& header = *reinterpret_cast<const StubModel*>(model)->Moc.Header;
+
+    outSizeInPixels->X = header.CanvasWidth;
+    outSizeInPixels->Y = header.CanvasHeight;
+    outOriginInPixels->X = header.OriginX;
+    outOriginInPixels->Y = header.OriginY;
+    *outPixelsPerUnit = header.PixelsPerUnit;
+}
+
+int csmGetParameterCount(const csmModel* model)
+{
+    return static_cast<int>(reinterpret_cast<const StubModel*>(model)->Moc.Header->ParameterCount);
+}
+
+const char** csmGetParameterIds(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->ParameterIds;
+}
+
+const csmParameterType* csmGetParameterTypes(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->ParameterTypes;
+}
+
+const float* csmGetParameterMinimumValues(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->ParameterMinimumValues;
+}
+
+const float* csmGetParameterMaximumValues(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->ParameterMaximumValues;
+}
+
+const float* csmGetParameterDefaultValues(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->ParameterDefaultValues;
+}
+
+float* csmGetParameterValues(csmModel* model)
+{
+    return reinterpret_cast<StubModel*>(model)->ParameterValues;
+}
+
+const int* csmGetParameterKeyCounts(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->ParameterKeyCounts;
+}
+
+const float** csmGetParameterKeyValues(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->ParameterKeyValues;
+}
+
+int csmGetPartCount(const csmModel* model)
+{
+    return static_cast<int>(reinterpret_cast<const StubModel*>(model)->Moc.Header->PartCount);
+}
+
+const char** csmGetPartIds(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->PartIds;
+}
+
+float* csmGetPartOpacities(csmModel* model)
+{
+    return reinterpret_cast<StubModel*>(model)->PartOpacities;
+}
+
+const int* csmGetPartParentPartIndices(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->PartParentPartIndices;
+}
+
+int csmGetDrawableCount(const csmModel* model)
+{
+    return static_cast<int>(reinterpret_cast<const StubModel*>(model)->Moc.Header->DrawableCount);
+}
+
+const char** csmGetDrawableIds(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->DrawableIds;
+}
+
+const csmFlags* csmGetDrawableConstantFlags(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->ConstantFlags;
+}
+
+const csmFlags* csmGetDrawableDynamicFlags(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->DynamicFlags;
+}
+
+const int* csmGetDrawableTextureIndices(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->TextureIndices;
+}
+
+const int* csmGetDrawableDrawOrders(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->DrawOrders;
+}
+
+const int* csmGetDrawableRenderOrders(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->RenderOrders;
+}
+
+const float* csmGetDrawableOpacities(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->Opacities;
+}
+
+const int* csmGetDrawableMaskCounts(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->MaskCounts;
+}
+
+const int** csmGetDrawableMasks(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->Masks;
+}
+
+const int* csmGetDrawableVertexCounts(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->VertexCounts;
+}
+
+const csmVector2** csmGetDrawableVertexPositions(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->VertexPositions;
+}
+
+const csmVector2** csmGetDrawableVertexUvs(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->VertexUvs;
+}
+
+const int* csmGetDrawableIndexCounts(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->IndexCounts;
+}
+
+const unsigned short** csmGetDrawableIndices(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->Indices;
+}
+
+const csmVector4* csmGetDrawableMultiplyColors(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->MultiplyColors;
+}
+
+const csmVector4* csmGetDrawableScreenColors(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->ScreenColors;
+}
+
+const int* csmGetDrawableParentPartIndices(const csmModel* model)
+{
+    return reinterpret_cast<const StubModel*>(model)->DrawableParentPartIndices;
+}
+
+void csmResetDrawableDynamicFlags(csmModel* model)
+{
+    // 実際のCoreと同様、フラグは次の更新まで読み取れるようにし、次の更新の開始時に変化フラグを消す
+    reinterpret_cast<StubModel*>(model)->IsResetPending = 1;
+}
+
+unsigned long long csmStubGetUpdateCount()
+{
+    return s_updateCount.load();
+}
+
+}
@@ -0,0 +1,148 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#ifndef LIVE2D_CUBISM_CORE_STUB_H
+#define LIVE2D_CUBISM_CORE_STUB_H
+
+/**
+ * Deterministic stand-in for the Live2D Cubism Core used by the Linux test and benchmark targets.
+ *
+ * The real Core only ships as a prebuilt library for the app platforms and cannot parse anything
+ * but .moc3 files. The stub implements the whole 'Live2DCubismCore.h' C API on top of a small
+ * "stub moc" format described below, which the test support code generates from a model's
+ * cdi3/physics3/motion3/pose3 metadata (or from hand-built scenes).
+ *
+ * Layout of a stub moc (little endian, every section 4-byte aligned, in this order):
+ *
+ *   csmStubMocHeader
+ *   csmStubParameter  x ParameterCount
+ *   csmStubPart       x PartCount
+ *   csmStubDrawable   x DrawableCount
+ *   csmStubBinding    x BindingCount
+ *   int               x MaskCount          (drawable indices used as masks)
+ *   csmVector2        x VertexCount        (vertex positions at the default pose)
+ *   csmVector2        x VertexCount        (UVs)
+ *   unsigned short    x IndexCount         (padded to a multiple of 2 entries)
+ *
+ * Deformation: on csmUpdateModel every vertex of a drawable is displaced by
+ *   sum over bindings of (value - default) / (maximum - minimum) * (DeltaX, DeltaY) * (0.25 + 0.75 * uv.Y)
+ * and the drawable opacity is its base opacity multiplied by the opacities of its parent part chain.
+ */
+
+#include "Live2DCubismCore.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+    /** Constants of the stub moc format. */
+    enum
+    {
+        /** Length of the fixed-size ID fields including the terminator. */
+        csmStubIdLength = 64,
+
+        /** Size of the header in bytes. */
+        csmStubHeaderSize = 64
+    };
+
+    /** Stub moc header. */
+    typedef struct
+    {
+        /** 'S', 'M', 'O', 'C'. */
+        char Magic[4];
+
+        /** Reported moc version (csmMocVersion). */
+        unsigned int MocVersion;
+
+        /** Size of the whole stub moc in bytes. */
+        unsigned int FileSize;
+
+        unsigned int ParameterCount;
+        unsigned int PartCount;
+        unsigned int DrawableCount;
+
+        /** Total number of bindings of all drawables. */
+        unsigned int BindingCount;
+
+        /** Total number of mask references of all drawables. */
+        unsigned int MaskCount;
+
+        /** Total number of vertices of all drawables. */
+        unsigned int VertexCount;
+
+        /** Total number of vertex indices of all drawables. */
+        unsigned int IndexCount;
+
+        /** Canvas info as returned by csmReadCanvasInfo. */
+        float CanvasWidth;
+        float CanvasHeight;
+        float OriginX;
+        float OriginY;
+        float PixelsPerUnit;
+
+        unsigned int Reserved;
+    } csmStubMocHeader;
+
+    /** Parameter record. */
+    typedef struct
+    {
+        char Id[csmStubIdLength];
+        float MinimumValue;
+        float MaximumValue;
+        float DefaultValue;
+        int Type;
+    } csmStubParameter;
+
+    /** Part record. */
+    typedef struct
+    {
+        char Id[csmStubIdLength];
+        int ParentPartIndex;
+        float DefaultOpacity;
+    } csmStubPart;
+
+    /** Drawable record. Offsets index into the shared sections of the moc. */
+    typedef struct
+    {
+        char Id[csmStubIdLength];
+        int TextureIndex;
+        int DrawOrder;
+        int ParentPartIndex;
+        unsigned int ConstantFlags;
+        float Opacity;
+        csmVector4 MultiplyColor;
+        csmVector4 ScreenColor;
+        unsigned int BindingOffset;
+        unsigned int BindingCount;
+        unsigned int MaskOffset;
+        unsigned int MaskCount;
+        unsigned int VertexOffset;
+        unsigned int VertexCount;
+        unsigned int IndexOffset;
+        unsigned int IndexCount;
+    } csmStubDrawable;
+
+    /** Links a parameter to the displacement of a drawable. */
+    typedef struct
+    {
+        int ParameterIndex;
+        float DeltaX;
+        float DeltaY;
+    } csmStubBinding;
+
+    /**
+     * Gets the number of times csmUpdateModel ran since the process started.
+     * Used by tests to check that model updates were skipped.
+     */
+    unsigned long long csmStubGetUpdateCount();
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -0,0 +1,249 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismGlTestSupport.hpp"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <Math/CubismMatrix44.hpp>
+#include <Math/CubismModelMatrix.hpp>
+#include "LAppTextureDecoder.h"
+
+using namespace Live2D::Cubism::Framework;
+using namespace Live2D::Cubism::Framework::Rendering;
+
+namespace CubismTest {
+
+bool MakeGlContextCurrent()
+{
+    static bool isInitialized = false;
+    static bool isAvailable = false;
+
+    if (isInitialized)
+    {
+        return isAvailable;
+    }
+    isInitialized = true;
+
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay == NULL)
+    {
+        return false;
+    }
+
+    EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL) || !eglBindAPI(EGL_OPENGL_API))
+    {
+        return false;
+    }
+
+    const EGLint configAttributes[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0)
+    {
+        return false;
+    }
+
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, NULL);
+    isAvailable = context != EGL_NO_CONTEXT && eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context);
+    return isAvailable;
+}
+
+GlRenderTarget::GlRenderTarget()
+    : _framebuffer(0)
+    , _texture(0)
+{
+    glGenTextures(1, &_texture);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, GlImageWidth, GlImageHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _texture, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+GlRenderTarget::~GlRenderTarget()
+{
+    glDeleteFramebuffers(1, &_framebuffer);
+    glDeleteTextures(1, &_texture);
+}
+
+bool GlRenderTarget::IsComplete()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    const bool isComplete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return isComplete;
+}
+
+void GlRenderTarget::Begin()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    glViewport(0, 0, GlImageWidth, GlImageHeight);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+std::vector<csmByte> GlRenderTarget::End()
+{
+    std::vector<csmByte> pixels(GlImageWidth * GlImageHeight * 4);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, GlImageWidth, GlImageHeight, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return pixels;
+}
+
+GlRenderedModel::GlRenderedModel()
+    : _renderer(NULL)
+{ }
+
+GlRenderedModel::~GlRenderedModel()
+{
+    if (_renderer != NULL)
+    {
+        CubismRenderer::Delete(_renderer);
+    }
+
+    if (!_textures.empty())
+    {
+        glDeleteTextures(static_cast<GLsizei>(_textures.size()), &_textures[0]);
+    }
+}
+
+bool GlRenderedModel::Load(const BundledModel& bundledModel)
+{
+    if (!_model.LoadAssets(bundledModel))
+    {
+        return false;
+    }
+
+    _renderer = static_cast<CubismRenderer_OpenGLES2*>(CubismRenderer::Create());
+    _renderer->Initialize(_model.GetModel());
+    _renderer->IsPremultipliedAlpha(true);
+
+    ICubismModelSetting* setting = _model.GetModelSetting();
+    for (csmInt32 i = 0; i < setting->GetTextureCount(); ++i)
+    {
+        std::vector<csmByte> file;
+        if (!LoadFile(bundledModel.Directory + setting->GetTextureFileName(i), file) || file.empty())
+        {
+            return false;
+        }
+
+        LAppTextureDecoder::DecodeJob job;
+        job.fileData = &file[0];
+        job.fileSize = static_cast<csmSizeInt>(file.size());
+        LAppTextureDecoder::DecodePng(job, true);
+        if (job.pixels == NULL)
+        {
+            return false;
+        }
+
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, job.width, job.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, job.pixels);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        LAppTextureDecoder::ReleasePixels(job.pixels);
+
+        _textures.push_back(texture);
+        _renderer->BindTexture(i, texture);
+    }
+
+    csmMap<csmString, csmFloat32> layout;
+    setting->GetLayoutMap(layout);
+    _model.GetModelMatrix()->SetupFromLayout(layout);
+
+    return true;
+}
+
+void GlRenderedModel::Animate(csmFloat32 seconds)
+{
+    if (_model.GetMotionCount() > 0 && _model.GetMotionManager()->IsFinished())
+    {
+        _model.StartMotion(0);
+    }
+
+    const csmFloat32 deltaTimeSeconds = 1.0f / 30.0f;
+    for (csmFloat32 time = 0.0f; time < seconds; time += deltaTimeSeconds)
+    {
+        _model.UpdateSimulation(deltaTimeSeconds);
+    }
+
+    _model.GetModel()->Update();
+}
+
+void GlRenderedModel::Draw()
+{
+    SetMvpMatrix();
+    _renderer->DrawModel();
+}
+
+void GlRenderedModel::PrepareRecord()
+{
+    _renderer->PrepareRecordDrawModel(_commandList);
+}
+
+bool GlRenderedModel::Record()
+{
+    SetMvpMatrix();
+    return _renderer->RecordDrawModel(_commandList);
+}
+
+void GlRenderedModel::Execute()
+{
+    _renderer->ExecuteCommandList(_commandList);
+}
+
+const CubismRenderCommandList& GlRenderedModel::GetCommandList() const
+{
+    return _commandList;
+}
+
+TestModel& GlRenderedModel::GetTestModel()
+{
+    return _model;
+}
+
+CubismRenderer_OpenGLES2* GlRenderedModel::GetRenderer() const
+{
+    return _renderer;
+}
+
+void GlRenderedModel::SetMvpMatrix()
+{
+    CubismModelMatrix* modelMatrix = _model.GetModelMatrix();
+    CubismMatrix44 projection;
+    if (_model.GetModel()->GetCanvasWidth() > 1.0f && GlImageWidth < GlImageHeight)
+    {
+        modelMatrix->SetWidth(2.0f);
+        projection.Scale(1.0f, static_cast<csmFloat32>(GlImageWidth) / static_cast<csmFloat32>(GlImageHeight));
+    }
+    else
+    {
+        projection.Scale(static_cast<csmFloat32>(GlImageHeight) / static_cast<csmFloat32>(GlImageWidth), 1.0f);
+    }
+    projection.MultiplyByMatrix(modelMatrix);
+
+    _renderer->SetMvpMatrix(&projection);
+}
+
+csmUint32 CountCoveredPixels(const std::vector<csmByte>& pixels)
+{
+    csmUint32 count = 0;
+    for (std::vector<csmByte>::size_type i = 3; i < pixels.size(); i += 4)
+    {
+        count += pixels[i] > 0 ? 1 : 0;
+    }
+    return count;
+}
+
+}
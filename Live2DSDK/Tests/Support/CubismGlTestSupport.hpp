@@ -0,0 +1,137 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <vector>
+#include <CubismRenderer_OpenGLES2.hpp>
+#include <Rendering/CubismRenderCommandList.hpp>
+#include "CubismTestModel.hpp"
+#include "CubismTestSupport.hpp"
+
+/**
+ * @brief OpenGLのレンダラを使うテストで共通に使う処理
+ */
+namespace CubismTest {
+
+/**
+ * @brief 描画先の幅・高さ[px]
+ */
+const Csm::csmUint32 GlImageWidth = 96;
+const Csm::csmUint32 GlImageHeight = 144;
+
+/**
+ * @brief Mesa surfacelessのEGLでOpenGLのコンテキストを作成し、カレントにする
+ *
+ * テストプログラム全体で1度だけ作成する。レンダラが作成したシェーダをテスト間で使い続けられるよう、コンテキストは破棄しない。
+ *
+ * @return  コンテキストを使える場合はtrue
+ */
+bool MakeGlContextCurrent();
+
+/**
+ * @brief モデルを描画し、読み出すフレームバッファ
+ */
+class GlRenderTarget
+{
+public:
+    GlRenderTarget();
+
+    ~GlRenderTarget();
+
+    /**
+     * @brief フレームバッファが使えるか
+     */
+    bool IsComplete();
+
+    /**
+     * @brief フレームバッファをバインドしてクリアする
+     */
+    void Begin();
+
+    /**
+     * @brief 描画結果を読み出し、フレームバッファのバインドを解除する
+     *
+     * @return  下の行から順に並べたRGBA8のピクセル
+     */
+    std::vector<Csm::csmByte> End();
+
+private:
+    GLuint _framebuffer;
+    GLuint _texture;
+};
+
+/**
+ * @brief 同梱モデルをテクスチャと一緒に読み込み、OpenGLのレンダラで直接またはコマンドリストを通して描画する
+ */
+class GlRenderedModel
+{
+public:
+    GlRenderedModel();
+
+    ~GlRenderedModel();
+
+    /**
+     * @brief 同梱モデルとテクスチャを読み込み、レンダラを作成する
+     *
+     * @return  読み込めた場合はtrue
+     */
+    bool Load(const BundledModel& bundledModel);
+
+    /**
+     * @brief 最初のモーションを30fpsで指定した時間再生し、モデルを更新する
+     */
+    void Animate(Csm::csmFloat32 seconds);
+
+    /**
+     * @brief 描画先に合わせた行列を設定して直接描画する
+     */
+    void Draw();
+
+    /**
+     * @brief 記録に必要なメモリをコマンドリストに確保する。別のスレッドで記録する前にテストのスレッドで呼ぶ
+     */
+    void PrepareRecord();
+
+    /**
+     * @brief 描画をコマンドリストに記録する。OpenGLを呼ばないため、どのスレッドからでも呼べる
+     *
+     * @return  記録できた場合はtrue
+     */
+    bool Record();
+
+    /**
+     * @brief 記録したコマンドリストを実行する
+     */
+    void Execute();
+
+    const Csm::Rendering::CubismRenderCommandList& GetCommandList() const;
+
+    TestModel& GetTestModel();
+
+    Csm::Rendering::CubismRenderer_OpenGLES2* GetRenderer() const;
+
+private:
+    /**
+     * @brief CubismRendererSoftwareTestと同じ配置になる行列を設定する
+     */
+    void SetMvpMatrix();
+
+    TestModel _model;
+    Csm::Rendering::CubismRenderer_OpenGLES2* _renderer;
+    Csm::Rendering::CubismRenderCommandList _commandList;
+    std::vector<GLuint> _textures;
+};
+
+/**
+ * @brief アルファが0でないピクセルを数える
+ *
+ * @param[in]   pixels  RGBA8のピクセル
+ */
+Csm::csmUint32 CountCoveredPixels(const std::vector<Csm::csmByte>& pixels);
+
+}
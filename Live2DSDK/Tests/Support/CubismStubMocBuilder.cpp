@@ -0,0 +1,774 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismStubMocBuilder.hpp"
+#include <algorithm>
+#include <ctype.h>
+#include <map>
+#include <string.h>
+#include <CubismModelSettingJson.hpp>
+#include <Id/CubismId.hpp>
+#include <Utils/CubismJson.hpp>
+#include "CubismTestSupport.hpp"
+
+using namespace Live2D::Cubism::Framework;
+using namespace Live2D::Cubism::Core;
+
+namespace {
+
+/// Values a parameter was seen with in the model's JSON files.
+struct ParameterObservation
+{
+    ParameterObservation()
+        : Minimum(0.0f)
+        , Maximum(0.0f)
+        , HasValue(false)
+    { }
+
+    void Observe(csmFloat32 value)
+    {
+        Minimum = HasValue ? std::min(Minimum, value) : value;
+        Maximum = HasValue ? std::max(Maximum, value) : value;
+        HasValue = true;
+    }
+
+    csmFloat32 Minimum;
+    csmFloat32 Maximum;
+    csmBool HasValue;
+};
+
+/// Parameter and part IDs in first-seen order.
+struct ModelMetadata
+{
+    void AddParameter(const std::string& id)
+    {
+        if (id.empty())
+        {
+            return;
+        }
+
+        if (Observations.find(id) == Observations.end())
+        {
+            ParameterIds.push_back(id);
+            Observations[id] = ParameterObservation();
+        }
+    }
+
+    void ObserveParameter(const std::string& id, csmFloat32 value)
+    {
+        AddParameter(id);
+
+        if (!id.empty())
+        {
+            Observations[id].Observe(value);
+        }
+    }
+
+    void AddPart(const std::string& id)
+    {
+        if (!id.empty() && std::find(PartIds.begin(), PartIds.end(), id) == PartIds.end())
+        {
+            PartIds.push_back(id);
+        }
+    }
+
+    void AddArtMesh(const std::string& id)
+    {
+        if (!id.empty() && std::find(ArtMeshIds.begin(), ArtMeshIds.end(), id) == ArtMeshIds.end())
+        {
+            ArtMeshIds.push_back(id);
+        }
+    }
+
+    std::vector<std::string> ParameterIds;
+    std::map<std::string, ParameterObservation> Observations;
+    std::vector<std::string> PartIds;
+    std::vector<std::string> ArtMeshIds;
+};
+
+/// xorshift32 seeded from an FNV-1a hash so that the generated shapes only depend on IDs.
+class DeterministicRandom
+{
+public:
+    explicit DeterministicRandom(const std::string& seed)
+        : _state(2166136261u)
+    {
+        for (std::string::size_type i = 0; i < seed.size(); ++i)
+        {
+            _state = (_state ^ static_cast<csmUint8>(seed[i])) * 16777619u;
+        }
+
+        if (_state == 0)
+        {
+            _state = 1;
+        }
+    }
+
+    csmUint32 Next()
+    {
+        _state ^= _state << 13;
+        _state ^= _state >> 17;
+        _state ^= _state << 5;
+        return _state;
+    }
+
+    csmInt32 Range(csmInt32 minimum, csmInt32 maximum)
+    {
+        return minimum + static_cast<csmInt32>(Next() % static_cast<csmUint32>(maximum - minimum + 1));
+    }
+
+    csmFloat32 Range(csmFloat32 minimum, csmFloat32 maximum)
+    {
+        return minimum + (maximum - minimum) * (static_cast<csmFloat32>(Next() & 0xFFFFFFu) / static_cast<csmFloat32>(0xFFFFFFu));
+    }
+
+private:
+    csmUint32 _state;
+};
+
+std::string ToLower(const std::string& text)
+{
+    std::string result(text);
+
+    for (std::string::size_type i = 0; i < result.size(); ++i)
+    {
+        result[i] = static_cast<char>(tolower(static_cast<unsigned char>(result[i])));
+    }
+
+    return result;
+}
+
+/// Parses a JSON file relative to the model directory. Returns NULL if it is missing or broken.
+Utils::CubismJson* LoadJson(const std::string& modelDirectory, const csmChar* fileName)
+{
+    if (!fileName || fileName[0] == '\0')
+    {
+        return NULL;
+    }
+
+    std::vector<csmByte> buffer;
+    if (!CubismTest::LoadFile(modelDirectory + fileName, buffer) || buffer.empty())
+    {
+        return NULL;
+    }
+
+    return Utils::CubismJson::Create(&buffer[0], static_cast<csmSizeInt>(buffer.size()));
+}
+
+void ReadDisplayInfo(Utils::Value& root, ModelMetadata& metadata)
+{
+    Utils::Value& parameters = root["Parameters"];
+    for (csmInt32 i = 0; i < parameters.GetSize(); ++i)
+    {
+        metadata.AddParameter(parameters[i]["Id"].GetRawString());
+    }
+
+    Utils::Value& parts = root["Parts"];
+    for (csmInt32 i = 0; i < parts.GetSize(); ++i)
+    {
+        metadata.AddPart(parts[i]["Id"].GetRawString());
+    }
+}
+
+void ReadMotion(Utils::Value& root, ModelMetadata& metadata)
+{
+    Utils::Value& curves = root["Curves"];
+    for (csmInt32 i = 0; i < curves.GetSize(); ++i)
+    {
+        Utils::Value& curve = curves[i];
+        const std::string target = curve["Target"].GetRawString();
+        const std::string id = curve["Id"].GetRawString();
+
+        if (target == "PartOpacity")
+        {
+            metadata.AddPart(id);
+            continue;
+        }
+
+        if (target != "Parameter")
+        {
+            continue;
+        }
+
+        // 先頭の点の後に「種類, 点...」が続く。ベジェは3点、それ以外は1点
+        Utils::Value& segments = curve["Segments"];
+        const csmInt32 segmentCount = segments.GetSize();
+        if (segmentCount >= 2)
+        {
+            metadata.ObserveParameter(id, segments[1].ToFloat());
+        }
+
+        for (csmInt32 position = 2; position < segmentCount;)
+        {
+            const csmInt32 pointCount = (segments[position].ToInt() == 1) ? 3 : 1;
+
+            for (csmInt32 point = 0; point < pointCount && position + 2 + point * 2 < segmentCount; ++point)
+            {
+                metadata.ObserveParameter(id, segments[position + 2 + point * 2].ToFloat());
+            }
+
+            position += 1 + pointCount * 2;
+        }
+    }
+}
+
+void ReadExpression(Utils::Value& root, ModelMetadata& metadata)
+{
+    Utils::Value& parameters = root["Parameters"];
+    for (csmInt32 i = 0; i < parameters.GetSize(); ++i)
+    {
+        const std::string id = parameters[i]["Id"].GetRawString();
+
+        // 乗算の値は倍率なので範囲の決定には使わない
+        if (strcmp(parameters[i]["Blend"].GetRawString(), "Multiply") == 0)
+        {
+            metadata.AddParameter(id);
+        }
+        else
+        {
+            metadata.ObserveParameter(id, parameters[i]["Value"].ToFloat());
+        }
+    }
+}
+
+void ReadPhysics(Utils::Value& root, ModelMetadata& metadata)
+{
+    Utils::Value& settings = root["PhysicsSettings"];
+    for (csmInt32 i = 0; i < settings.GetSize(); ++i)
+    {
+        Utils::Value& inputs = settings[i]["Input"];
+        for (csmInt32 j = 0; j < inputs.GetSize(); ++j)
+        {
+            metadata.AddParameter(inputs[j]["Source"]["Id"].GetRawString());
+        }
+
+        Utils::Value& outputs = settings[i]["Output"];
+        for (csmInt32 j = 0; j < outputs.GetSize(); ++j)
+        {
+            metadata.AddParameter(outputs[j]["Destination"]["Id"].GetRawString());
+        }
+    }
+}
+
+void ReadPose(Utils::Value& root, ModelMetadata& metadata)
+{
+    Utils::Value& groups = root["Groups"];
+    for (csmInt32 i = 0; i < groups.GetSize(); ++i)
+    {
+        for (csmInt32 j = 0; j < groups[i].GetSize(); ++j)
+        {
+            metadata.AddPart(groups[i][j]["Id"].GetRawString());
+
+            Utils::Value& links = groups[i][j]["Link"];
+            for (csmInt32 k = 0; k < links.GetSize(); ++k)
+            {
+                metadata.AddPart(links[k].GetRawString());
+            }
+        }
+    }
+}
+
+void ReadUserData(Utils::Value& root, ModelMetadata& metadata)
+{
+    Utils::Value& userData = root["UserData"];
+    for (csmInt32 i = 0; i < userData.GetSize(); ++i)
+    {
+        if (strcmp(userData[i]["Target"].GetRawString(), "ArtMesh") == 0)
+        {
+            metadata.AddArtMesh(userData[i]["Id"].GetRawString());
+        }
+    }
+}
+
+/// Runs reader on a JSON file and releases it.
+csmBool ReadJsonFile(const std::string& modelDirectory, const csmChar* fileName, void (*reader)(Utils::Value&, ModelMetadata&), ModelMetadata& metadata)
+{
+    Utils::CubismJson* json = LoadJson(modelDirectory, fileName);
+    if (!json)
+    {
+        return false;
+    }
+
+    reader(json->GetRoot(), metadata);
+    Utils::CubismJson::Delete(json);
+
+    return true;
+}
+
+/// Appends a random deformable drawable to builder.
+void AddRandomDrawable(CubismStubMocBuilder& builder, DeterministicRandom& random, const std::string& id, csmInt32 parentPartIndex,
+                       csmInt32 textureCount, csmInt32 parameterCount)
+{
+    const csmFloat32 width = random.Range(0.05f, 0.4f);
+    const csmFloat32 height = random.Range(0.05f, 0.4f);
+    const csmFloat32 left = random.Range(-0.5f, 0.5f - width);
+    const csmFloat32 bottom = random.Range(-0.75f, 0.75f - height);
+    const csmFloat32 uvLeft = random.Range(0.0f, 0.75f);
+    const csmFloat32 uvBottom = random.Range(0.0f, 0.75f);
+
+    CubismStubMocBuilder::Drawable drawable = CubismStubMocBuilder::CreateGrid(
+        id, left, bottom, left + width, bottom + height, random.Range(3, 10), random.Range(3, 10),
+        uvLeft, uvBottom, uvLeft + 0.25f, uvBottom + 0.25f);
+
+    drawable.TextureIndex = random.Range(0, std::max(textureCount, 1) - 1);
+    drawable.DrawOrder = random.Range(400, 600);
+    drawable.ParentPartIndex = parentPartIndex;
+
+    if (parameterCount > 0)
+    {
+        const csmInt32 bindingCount = random.Range(1, 3);
+        for (csmInt32 i = 0; i < bindingCount; ++i)
+        {
+            CubismStubMocBuilder::Binding binding;
+            binding.ParameterIndex = random.Range(0, parameterCount - 1);
+            binding.DeltaX = random.Range(-0.08f, 0.08f);
+            binding.DeltaY = random.Range(-0.08f, 0.08f);
+            drawable.Bindings.push_back(binding);
+        }
+    }
+
+    const csmInt32 drawableIndex = builder.GetDrawableCount();
+    if (drawableIndex > 0 && random.Range(0, 4) == 0)
+    {
+        drawable.Masks.push_back(random.Range(0, drawableIndex - 1));
+
+        if (random.Range(0, 3) == 0)
+        {
+            drawable.ConstantFlags |= csmIsInvertedMask;
+        }
+    }
+
+    const csmInt32 blend = random.Range(0, 19);
+    if (blend == 0)
+    {
+        drawable.ConstantFlags |= csmBlendAdditive;
+    }
+    else if (blend == 1)
+    {
+        drawable.ConstantFlags |= csmBlendMultiplicative;
+    }
+
+    builder.AddDrawable(drawable);
+}
+
+}
+
+CubismStubMocBuilder::Drawable::Drawable()
+    : TextureIndex(0)
+    , DrawOrder(500)
+    , ParentPartIndex(-1)
+    , ConstantFlags(csmIsDoubleSided)
+    , Opacity(1.0f)
+{
+    MultiplyColor.X = MultiplyColor.Y = MultiplyColor.Z = MultiplyColor.W = 1.0f;
+    ScreenColor.X = ScreenColor.Y = ScreenColor.Z = 0.0f;
+    ScreenColor.W = 1.0f;
+}
+
+CubismStubMocBuilder::CubismStubMocBuilder()
+{
+    memset(&_header, 0, sizeof(_header));
+    memcpy(_header.Magic, "SMOC", sizeof(_header.Magic));
+    _header.MocVersion = csmMocVersion_50;
+    SetCanvas(2048.0f, 2048.0f, 1024.0f, 1024.0f, 2048.0f);
+}
+
+void CubismStubMocBuilder::SetCanvas(csmFloat32 width, csmFloat32 height, csmFloat32 originX, csmFloat32 originY, csmFloat32 pixelsPerUnit)
+{
+    _header.CanvasWidth = width;
+    _header.CanvasHeight = height;
+    _header.OriginX = originX;
+    _header.OriginY = originY;
+    _header.PixelsPerUnit = pixelsPerUnit;
+}
+
+void CubismStubMocBuilder::SetMocVersion(csmUint32 version)
+{
+    _header.MocVersion = version;
+}
+
+csmInt32 CubismStubMocBuilder::AddParameter(const std::string& id, csmFloat32 minimum, csmFloat32 maximum, csmFloat32 defaultValue)
+{
+    const csmInt32 index = FindParameter(id);
+
+    if (index >= 0)
+    {
+        Parameter& parameter = _parameters[index];
+        parameter.Minimum = std::min(parameter.Minimum, minimum);
+        parameter.Maximum = std::max(parameter.Maximum, maximum);
+        return index;
+    }
+
+    Parameter parameter;
+    parameter.Id = id;
+    parameter.Minimum = minimum;
+    parameter.Maximum = maximum;
+    parameter.Default = defaultValue;
+    _parameters.push_back(parameter);
+
+    return static_cast<csmInt32>(_parameters.size()) - 1;
+}
+
+csmInt32 CubismStubMocBuilder::AddPart(const std::string& id, csmInt32 parentPartIndex, csmFloat32 opacity)
+{
+    const csmInt32 index = FindPart(id);
+
+    if (index >= 0)
+    {
+        return index;
+    }
+
+    Part part;
+    part.Id = id;
+    part.ParentPartIndex = parentPartIndex;
+    part.Opacity = opacity;
+    _parts.push_back(part);
+
+    return static_cast<csmInt32>(_parts.size()) - 1;
+}
+
+csmInt32 CubismStubMocBuilder::AddDrawable(const Drawable& drawable)
+{
+    _drawables.push_back(drawable);
+    return static_cast<csmInt32>(_drawables.size()) - 1;
+}
+
+csmInt32 CubismStubMocBuilder::FindParameter(const std::string& id) const
+{
+    for (std::vector<Parameter>::size_type i = 0; i < _parameters.size(); ++i)
+    {
+        if (_parameters[i].Id == id)
+        {
+            return static_cast<csmInt32>(i);
+        }
+    }
+
+    return -1;
+}
+
+csmInt32 CubismStubMocBuilder::FindPart(const std::string& id) const
+{
+    for (std::vector<Part>::size_type i = 0; i < _parts.size(); ++i)
+    {
+        if (_parts[i].Id == id)
+        {
+            return static_cast<csmInt32>(i);
+        }
+    }
+
+    return -1;
+}
+
+csmInt32 CubismStubMocBuilder::GetDrawableCount() const
+{
+    return static_cast<csmInt32>(_drawables.size());
+}
+
+CubismStubMocBuilder::Drawable CubismStubMocBuilder::CreateGrid(const std::string& id, csmFloat32 left, csmFloat32 bottom, csmFloat32 right, csmFloat32 top,
+                                                                csmInt32 columns, csmInt32 rows,
+                                                                csmFloat32 uvLeft, csmFloat32 uvBottom, csmFloat32 uvRight, csmFloat32 uvTop)
+{
+    Drawable drawable;
+    drawable.Id = id;
+
+    for (csmInt32 j = 0; j <= rows; ++j)
+    {
+        const csmFloat32 v = static_cast<csmFloat32>(j) / static_cast<csmFloat32>(rows);
+
+        for (csmInt32 i = 0; i <= columns; ++i)
+        {
+            const csmFloat32 u = static_cast<csmFloat32>(i) / static_cast<csmFloat32>(columns);
+
+            csmVector2 position;
+            position.X = left + (right - left) * u;
+            position.Y = bottom + (top - bottom) * v;
+            drawable.Positions.push_back(position);
+
+            csmVector2 uv;
+            uv.X = uvLeft + (uvRight - uvLeft) * u;
+            uv.Y = uvBottom + (uvTop - uvBottom) * v;
+            drawable.Uvs.push_back(uv);
+        }
+    }
+
+    for (csmInt32 j = 0; j < rows; ++j)
+    {
+        for (csmInt32 i = 0; i < columns; ++i)
+        {
+            const csmUint16 corner = static_cast<csmUint16>(j * (columns + 1) + i);
+            const csmUint16 above = static_cast<csmUint16>(corner + columns + 1);
+
+            drawable.Indices.push_back(corner);
+            drawable.Indices.push_back(static_cast<csmUint16>(corner + 1));
+            drawable.Indices.push_back(above);
+            drawable.Indices.push_back(static_cast<csmUint16>(corner + 1));
+            drawable.Indices.push_back(static_cast<csmUint16>(above + 1));
+            drawable.Indices.push_back(above);
+        }
+    }
+
+    return drawable;
+}
+
+csmBool CubismStubMocBuilder::AddModelMetadata(const std::string& modelDirectory, const std::string& modelFileName)
+{
+    std::vector<csmByte> buffer;
+    if (!CubismTest::LoadFile(modelDirectory + modelFileName, buffer) || buffer.empty())
+    {
+        return false;
+    }
+
+    CubismModelSettingJson setting(&buffer[0], static_cast<csmSizeInt>(buffer.size()));
+    ModelMetadata metadata;
+
+    ReadJsonFile(modelDirectory, setting.GetDisplayInfoFileName(), ReadDisplayInfo, metadata);
+
+    for (csmInt32 i = 0; i < setting.GetEyeBlinkParameterCount(); ++i)
+    {
+        metadata.AddParameter(setting.GetEyeBlinkParameterId(i)->GetString().GetRawString());
+    }
+
+    for (csmInt32 i = 0; i < setting.GetLipSyncParameterCount(); ++i)
+    {
+        metadata.AddParameter(setting.GetLipSyncParameterId(i)->GetString().GetRawString());
+    }
+
+    for (csmInt32 i = 0; i < setting.GetMotionGroupCount(); ++i)
+    {
+        const csmChar* group = setting.GetMotionGroupName(i);
+
+        for (csmInt32 j = 0; j < setting.GetMotionCount(group); ++j)
+        {
+            ReadJsonFile(modelDirectory, setting.GetMotionFileName(group, j), ReadMotion, metadata);
+        }
+    }
+
+    for (csmInt32 i = 0; i < setting.GetExpressionCount(); ++i)
+    {
+        ReadJsonFile(modelDirectory, setting.GetExpressionFileName(i), ReadExpression, metadata);
+    }
+
+    ReadJsonFile(modelDirectory, setting.GetPhysicsFileName(), ReadPhysics, metadata);
+    ReadJsonFile(modelDirectory, setting.GetPoseFileName(), ReadPose, metadata);
+    ReadJsonFile(modelDirectory, setting.GetUserDataFile(), ReadUserData, metadata);
+
+    for (csmInt32 i = 0; i < setting.GetHitAreasCount(); ++i)
+    {
+        metadata.AddArtMesh(setting.GetHitAreaId(i)->GetString().GetRawString());
+    }
+
+    // パラメータの範囲。角度系は±30、それ以外は観測値が負にならなければ0〜1、なれば±1を基本にする
+    for (std::vector<std::string>::size_type i = 0; i < metadata.ParameterIds.size(); ++i)
+    {
+        const std::string& id = metadata.ParameterIds[i];
+        const ParameterObservation& observation = metadata.Observations[id];
+        const std::string lowerId = ToLower(id);
+
+        csmFloat32 minimum = -1.0f;
+        csmFloat32 maximum = 1.0f;
+
+        if (lowerId.find("angle") != std::string::npos)
+        {
+            minimum = -30.0f;
+            maximum = 30.0f;
+        }
+        else if (observation.HasValue && observation.Minimum >= 0.0f)
+        {
+            minimum = 0.0f;
+        }
+
+        if (observation.HasValue)
+        {
+            minimum = std::min(minimum, observation.Minimum);
+            maximum = std::max(maximum, observation.Maximum);
+        }
+
+        const csmBool isEyeOpen = lowerId.find("eye") != std::string::npos && lowerId.find("open") != std::string::npos;
+        const csmFloat32 defaultValue = isEyeOpen ? maximum : std::max(minimum, std::min(0.0f, maximum));
+
+        AddParameter(id, minimum, maximum, defaultValue);
+    }
+
+    if (metadata.PartIds.empty())
+    {
+        metadata.AddPart("PartCore");
+    }
+
+    for (std::vector<std::string>::size_type i = 0; i < metadata.PartIds.size(); ++i)
+    {
+        AddPart(metadata.PartIds[i]);
+    }
+
+    const csmInt32 textureCount = setting.GetTextureCount();
+    const csmInt32 parameterCount = static_cast<csmInt32>(_parameters.size());
+
+    for (std::vector<std::string>::size_type i = 0; i < metadata.PartIds.size(); ++i)
+    {
+        const std::string& partId = metadata.PartIds[i];
+        DeterministicRandom random(partId);
+        const csmInt32 drawableCount = random.Range(1, 4);
+
+        for (csmInt32 j = 0; j < drawableCount; ++j)
+        {
+            const std::string id = "ArtMesh_" + partId + "_" + std::to_string(j);
+            AddRandomDrawable(*this, random, id, FindPart(partId), textureCount, parameterCount);
+        }
+    }
+
+    for (std::vector<std::string>::size_type i = 0; i < metadata.ArtMeshIds.size(); ++i)
+    {
+        const std::string& id = metadata.ArtMeshIds[i];
+        DeterministicRandom random(id);
+        AddRandomDrawable(*this, random, id, 0, textureCount, parameterCount);
+    }
+
+    SetCanvas(2400.0f, 3600.0f, 1200.0f, 1800.0f, 2400.0f);
+
+    return true;
+}
+
+std::vector<csmByte> CubismStubMocBuilder::Build() const
+{
+    csmStubMocHeader header = _header;
+    std::vector<csmStubParameter> parameters(_parameters.size());
+    std::vector<csmStubPart> parts(_parts.size());
+    std::vector<csmStubDrawable> drawables(_drawables.size());
+    std::vector<csmStubBinding> bindings;
+    std::vector<csmInt32> masks;
+    std::vector<csmVector2> positions;
+    std::vector<csmVector2> uvs;
+    std::vector<csmUint16> indices;
+
+    for (std::vector<Parameter>::size_type i = 0; i < _parameters.size(); ++i)
+    {
+        csmStubParameter& parameter = parameters[i];
+        memset(&parameter, 0, sizeof(parameter));
+        strncpy(parameter.Id, _parameters[i].Id.c_str(), csmStubIdLength - 1);
+        parameter.MinimumValue = _parameters[i].Minimum;
+        parameter.MaximumValue = _parameters[i].Maximum;
+        parameter.DefaultValue = _parameters[i].Default;
+        parameter.Type = csmParameterType_Normal;
+    }
+
+    for (std::vector<Part>::size_type i = 0; i < _parts.size(); ++i)
+    {
+        csmStubPart& part = parts[i];
+        memset(&part, 0, sizeof(part));
+        strncpy(part.Id, _parts[i].Id.c_str(), csmStubIdLength - 1);
+        part.ParentPartIndex = _parts[i].ParentPartIndex;
+        part.DefaultOpacity = _parts[i].Opacity;
+    }
+
+    for (std::vector<Drawable>::size_type i = 0; i < _drawables.size(); ++i)
+    {
+        const Drawable& source = _drawables[i];
+        csmStubDrawable& drawable = drawables[i];
+        memset(&drawable, 0, sizeof(drawable));
+        strncpy(drawable.Id, source.Id.c_str(), csmStubIdLength - 1);
+        drawable.TextureIndex = source.TextureIndex;
+        drawable.DrawOrder = source.DrawOrder;
+        drawable.ParentPartIndex = source.ParentPartIndex;
+        drawable.ConstantFlags = source.ConstantFlags;
+        drawable.Opacity = source.Opacity;
+        drawable.MultiplyColor = source.MultiplyColor;
+        drawable.ScreenColor = source.ScreenColor;
+
+        drawable.BindingOffset = static_cast<csmUint32>(bindings.size());
+        drawable.BindingCount = static_cast<csmUint32>(source.Bindings.size());
+        for (std::vector<Binding>::size_type j = 0; j < source.Bindings.size(); ++j)
+        {
+            csmStubBinding binding;
+            binding.ParameterIndex = source.Bindings[j].ParameterIndex;
+            binding.DeltaX = source.Bindings[j].DeltaX;
+            binding.DeltaY = source.Bindings[j].DeltaY;
+            bindings.push_back(binding);
+        }
+
+        drawable.MaskOffset = static_cast<csmUint32>(masks.size());
+        drawable.MaskCount = static_cast<csmUint32>(source.Masks.size());
+        masks.insert(masks.end(), source.Masks.begin(), source.Masks.end());
+
+        drawable.VertexOffset = static_cast<csmUint32>(positions.size());
+        drawable.VertexCount = static_cast<csmUint32>(source.Positions.size());
+        positions.insert(positions.end(), source.Positions.begin(), source.Positions.end());
+        uvs.insert(uvs.end(), source.Uvs.begin(), source.Uvs.end());
+
+        drawable.IndexOffset = static_cast<csmUint32>(indices.size());
+        drawable.IndexCount = static_cast<csmUint32>(source.Indices.size());
+        indices.insert(indices.end(), source.Indices.begin(), source.Indices.end());
+    }
+
+    header.ParameterCount = static_cast<csmUint32>(parameters.size());
+    header.PartCount = static_cast<csmUint32>(parts.size());
+    header.DrawableCount = static_cast<csmUint32>(drawables.size());
+    header.BindingCount = static_cast<csmUint32>(bindings.size());
+    header.MaskCount = static_cast<csmUint32>(masks.size());
+    header.VertexCount = static_cast<csmUint32>(positions.size());
+    header.IndexCount = static_cast<csmUint32>(indices.size());
+
+    const csmSizeType indexBytes = (sizeof(csmUint16) * indices.size() + 3u) & ~static_cast<csmSizeType>(3u);
+    const csmSizeType size = sizeof(header)
+                           + sizeof(csmStubParameter) * parameters.size()
+                           + sizeof(csmStubPart) * parts.size()
+                           + sizeof(csmStubDrawable) * drawables.size()
+                           + sizeof(csmStubBinding) * bindings.size()
+                           + sizeof(csmInt32) * masks.size()
+                           + sizeof(csmVector2) * positions.size() * 2
+                           + indexBytes;
+    header.FileSize = static_cast<csmUint32>(size);
+
+    std::vector<csmByte> output(size, 0);
+    csmByte* cursor = &output[0];
+
+    memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+
+    if (!parameters.empty())
+    {
+        memcpy(cursor, &parameters[0], sizeof(csmStubParameter) * parameters.size());
+        cursor += sizeof(csmStubParameter) * parameters.size();
+    }
+
+    if (!parts.empty())
+    {
+        memcpy(cursor, &parts[0], sizeof(csmStubPart) * parts.size());
+        cursor += sizeof(csmStubPart) * parts.size();
+    }
+
+    if (!drawables.empty())
+    {
+        memcpy(cursor, &drawables[0], sizeof(csmStubDrawable) * drawables.size());
+        cursor += sizeof(csmStubDrawable) * drawables.size();
+    }
+
+    if (!bindings.empty())
+    {
+        memcpy(cursor, &bindings[0], sizeof(csmStubBinding) * bindings.size());
+        cursor += sizeof(csmStubBinding) * bindings.size();
+    }
+
+    if (!masks.empty())
+    {
+        memcpy(cursor, &masks[0], sizeof(csmInt32) * masks.size());
+        cursor += sizeof(csmInt32) * masks.size();
+    }
+
+    if (!positions.empty())
+    {
+        memcpy(cursor, &positions[0], sizeof(csmVector2) * positions.size());
+        cursor += sizeof(csmVector2) * positions.size();
+        memcpy(cursor, &uvs[0], sizeof(csmVector2) * uvs.size());
+        cursor += sizeof(csmVector2) * uvs.size();
+    }
+
+    if (!indices.empty())
+    {
+        memcpy(cursor, &indices[0], sizeof(csmUint16) * indices.size());
+    }
+
+    return output;
+}
@@ -0,0 +1,173 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <CubismFramework.hpp>
+#include "Live2DCubismCoreStub.hpp"
+
+/**
+ * @brief スタブCore用のmocを組み立てるクラス
+ *
+ * テストでは描画シーンを直接組み立て、ベンチマークではモデルのメタデータ
+ * （cdi3・physics3・motion3・exp3・pose3・userdata3）から同程度の規模のmocを生成する。
+ */
+class CubismStubMocBuilder
+{
+public:
+    /**
+     * @brief 頂点の変形に使うパラメータ
+     */
+    struct Binding
+    {
+        Csm::csmInt32 ParameterIndex;
+        Csm::csmFloat32 DeltaX;
+        Csm::csmFloat32 DeltaY;
+    };
+
+    /**
+     * @brief Drawable1件分の定義
+     */
+    struct Drawable
+    {
+        Drawable();
+
+        std::string Id;
+        Csm::csmInt32 TextureIndex;
+        Csm::csmInt32 DrawOrder;
+        Csm::csmInt32 ParentPartIndex;
+        Csm::csmUint32 ConstantFlags;       ///< csmBlendAdditive・csmIsDoubleSidedなどの組み合わせ
+        Csm::csmFloat32 Opacity;
+        Live2D::Cubism::Core::csmVector4 MultiplyColor;
+        Live2D::Cubism::Core::csmVector4 ScreenColor;
+        std::vector<Live2D::Cubism::Core::csmVector2> Positions;   ///< モデル座標
+        std::vector<Live2D::Cubism::Core::csmVector2> Uvs;
+        std::vector<Csm::csmUint16> Indices;
+        std::vector<Csm::csmInt32> Masks;   ///< マスクに使うDrawableのインデックス
+        std::vector<Binding> Bindings;
+    };
+
+    /**
+     * @brief コンストラクタ
+     *
+     * キャンバスは2048x2048ピクセル、原点は中央、1単位 = 2048ピクセル。
+     */
+    CubismStubMocBuilder();
+
+    /**
+     * @brief キャンバス情報を設定する
+     */
+    void SetCanvas(Csm::csmFloat32 width, Csm::csmFloat32 height, Csm::csmFloat32 originX, Csm::csmFloat32 originY, Csm::csmFloat32 pixelsPerUnit);
+
+    /**
+     * @brief mocのバージョンを設定する
+     */
+    void SetMocVersion(Csm::csmUint32 version);
+
+    /**
+     * @brief パラメータを追加する。同じIDが既にある場合は範囲を広げる
+     *
+     * @return  パラメータのインデックス
+     */
+    Csm::csmInt32 AddParameter(const std::string& id, Csm::csmFloat32 minimum, Csm::csmFloat32 maximum, Csm::csmFloat32 defaultValue);
+
+    /**
+     * @brief パーツを追加する。同じIDが既にある場合は追加しない
+     *
+     * @return  パーツのインデックス
+     */
+    Csm::csmInt32 AddPart(const std::string& id, Csm::csmInt32 parentPartIndex = -1, Csm::csmFloat32 opacity = 1.0f);
+
+    /**
+     * @brief Drawableを追加する
+     *
+     * @return  Drawableのインデックス
+     */
+    Csm::csmInt32 AddDrawable(const Drawable& drawable);
+
+    /**
+     * @brief IDからパラメータのインデックスを探す
+     *
+     * @return  見つからない場合は-1
+     */
+    Csm::csmInt32 FindParameter(const std::string& id) const;
+
+    /**
+     * @brief IDからパーツのインデックスを探す
+     *
+     * @return  見つからない場合は-1
+     */
+    Csm::csmInt32 FindPart(const std::string& id) const;
+
+    /**
+     * @brief Drawableの数を取得する
+     */
+    Csm::csmInt32 GetDrawableCount() const;
+
+    /**
+     * @brief 格子状に分割した矩形のDrawableを作る
+     *
+     * @param[in]   id          DrawableのID
+     * @param[in]   left        左端（モデル座標）
+     * @param[in]   bottom      下端（モデル座標）
+     * @param[in]   right       右端（モデル座標）
+     * @param[in]   top         上端（モデル座標）
+     * @param[in]   columns     横の分割数
+     * @param[in]   rows        縦の分割数
+     * @param[in]   uvLeft      左端のU
+     * @param[in]   uvBottom    下端のV
+     * @param[in]   uvRight     右端のU
+     * @param[in]   uvTop       上端のV
+     */
+    static Drawable CreateGrid(const std::string& id, Csm::csmFloat32 left, Csm::csmFloat32 bottom, Csm::csmFloat32 right, Csm::csmFloat32 top,
+                               Csm::csmInt32 columns, Csm::csmInt32 rows,
+                               Csm::csmFloat32 uvLeft = 0.0f, Csm::csmFloat32 uvBottom = 0.0f, Csm::csmFloat32 uvRight = 1.0f, Csm::csmFloat32 uvTop = 1.0f);
+
+    /**
+     * @brief model3.jsonと関連ファイルのメタデータからモデルを組み立てる
+     *
+     * パラメータはcdi3・モーション・表情・物理演算・まばたき/リップシンクで参照されるもの、
+     * パーツはcdi3・ポーズ・モーションで参照されるものを登録する。
+     * パラメータの範囲はモーション・表情で使われる値が収まるように決め、
+     * Drawableはパーツごとに、IDから決まる乱数で形・変形・マスク・ブレンドを割り当てる。
+     * フレームワークの初期化後に呼ぶこと。
+     *
+     * @param[in]   modelDirectory  model3.jsonのあるディレクトリ（末尾に/を含む）
+     * @param[in]   modelFileName   model3.jsonのファイル名
+     *
+     * @return  読み込めた場合はtrue
+     */
+    Csm::csmBool AddModelMetadata(const std::string& modelDirectory, const std::string& modelFileName);
+
+    /**
+     * @brief mocのバイト列を作る
+     */
+    std::vector<Csm::csmByte> Build() const;
+
+private:
+    struct Parameter
+    {
+        std::string Id;
+        Csm::csmFloat32 Minimum;
+        Csm::csmFloat32 Maximum;
+        Csm::csmFloat32 Default;
+    };
+
+    struct Part
+    {
+        std::string Id;
+        Csm::csmInt32 ParentPartIndex;
+        Csm::csmFloat32 Opacity;
+    };
+
+    Live2D::Cubism::Core::csmStubMocHeader _header;
+    std::vector<Parameter> _parameters;
+    std::vector<Part> _parts;
+    std::vector<Drawable> _drawables;
+};
@@ -0,0 +1,336 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismTestModel.hpp"
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <CubismDefaultParameterId.hpp>
+#include <CubismModelSettingJson.hpp>
+#include <Effect/CubismBreath.hpp>
+#include <Effect/CubismEyeBlink.hpp>
+#include <Id/CubismIdManager.hpp>
+#include <Motion/CubismMotion.hpp>
+#include "CubismStubMocBuilder.hpp"
+
+using namespace Live2D::Cubism::Framework;
+using namespace Live2D::Cubism::Framework::DefaultParameterId;
+
+namespace CubismTest {
+
+TestModel::TestModel()
+    : CubismUserModel()
+    , _modelSetting(NULL)
+{ }
+
+TestModel::~TestModel()
+{
+    for (csmUint32 i = 0; i < _motions.GetSize(); ++i)
+    {
+        ACubismMotion::Delete(_motions[i]);
+    }
+
+    for (csmUint32 i = 0; i < _expressions.GetSize(); ++i)
+    {
+        ACubismMotion::Delete(_expressions[i]);
+    }
+
+    delete _modelSetting;
+}
+
+csmBool TestModel::LoadAssets(const BundledModel& bundledModel)
+{
+    _modelHomeDir = bundledModel.Directory;
+
+    std::vector<csmByte> buffer;
+    if (!LoadRelativeFile(bundledModel.FileName.c_str(), buffer))
+    {
+        return false;
+    }
+
+    _modelSetting = new CubismModelSettingJson(&buffer[0], static_cast<csmSizeInt>(buffer.size()));
+
+    const std::vector<csmByte>& moc = GetStubMoc(bundledModel);
+    if (moc.empty())
+    {
+        return false;
+    }
+
+    LoadModel(&moc[0], static_cast<csmSizeInt>(moc.size()));
+    if (_model == NULL)
+    {
+        return false;
+    }
+
+    for (csmInt32 i = 0; i < _modelSetting->GetExpressionCount(); ++i)
+    {
+        if (LoadRelativeFile(_modelSetting->GetExpressionFileName(i), buffer))
+        {
+            ACubismMotion* expression = LoadExpression(&buffer[0], static_cast<csmSizeInt>(buffer.size()), _modelSetting->GetExpressionName(i));
+            if (expression)
+            {
+                _expressions.PushBack(expression);
+            }
+        }
+    }
+
+    if (LoadRelativeFile(_modelSetting->GetPhysicsFileName(), buffer))
+    {
+        LoadPhysics(&buffer[0], static_cast<csmSizeInt>(buffer.size()));
+    }
+
+    if (LoadRelativeFile(_modelSetting->GetPoseFileName(), buffer))
+    {
+        LoadPose(&buffer[0], static_cast<csmSizeInt>(buffer.size()));
+    }
+
+    if (LoadRelativeFile(_modelSetting->GetUserDataFile(), buffer))
+    {
+        LoadUserData(&buffer[0], static_cast<csmSizeInt>(buffer.size()));
+    }
+
+    if (_modelSetting->GetEyeBlinkParameterCount() > 0)
+    {
+        _eyeBlink = CubismEyeBlink::Create(_modelSetting);
+    }
+
+    {
+        CubismIdManager* idManager = CubismFramework::GetIdManager();
+        csmVector<CubismBreath::BreathParameterData> breathParameters;
+
+        breathParameters.PushBack(CubismBreath::BreathParameterData(idManager->GetId(ParamAngleX), 0.0f, 15.0f, 6.5345f, 0.5f));
+        breathParameters.PushBack(CubismBreath::BreathParameterData(idManager->GetId(ParamAngleY), 0.0f, 8.0f, 3.5345f, 0.5f));
+        breathParameters.PushBack(CubismBreath::BreathParameterData(idManager->GetId(ParamAngleZ), 0.0f, 10.0f, 5.5345f, 0.5f));
+        breathParameters.PushBack(CubismBreath::BreathParameterData(idManager->GetId(ParamBodyAngleX), 0.0f, 4.0f, 15.5345f, 0.5f));
+        breathParameters.PushBack(CubismBreath::BreathParameterData(idManager->GetId(ParamBreath), 0.5f, 0.5f, 3.2345f, 0.5f));
+
+        _breath = CubismBreath::Create();
+        _breath->SetParameters(breathParameters);
+    }
+
+    for (csmInt32 i = 0; i < _modelSetting->GetEyeBlinkParameterCount(); ++i)
+    {
+        _eyeBlinkIds.PushBack(_modelSetting->GetEyeBlinkParameterId(i));
+    }
+
+    for (csmInt32 i = 0; i < _modelSetting->GetLipSyncParameterCount(); ++i)
+    {
+        _lipSyncIds.PushBack(_modelSetting->GetLipSyncParameterId(i));
+    }
+
+    for (csmInt32 i = 0; i < _modelSetting->GetMotionGroupCount(); ++i)
+    {
+        const csmChar* group = _modelSetting->GetMotionGroupName(i);
+
+        for (csmInt32 j = 0; j < _modelSetting->GetMotionCount(group); ++j)
+        {
+            if (!LoadRelativeFile(_modelSetting->GetMotionFileName(group, j), buffer))
+            {
+                continue;
+            }
+
+            CubismMotion* motion = static_cast<CubismMotion*>(LoadMotion(&buffer[0], static_cast<csmSizeInt>(buffer.size()), NULL,
+                                                                         NULL, NULL, _modelSetting, group, j));
+            if (motion)
+            {
+                motion->SetEffectIds(_eyeBlinkIds, _lipSyncIds);
+                _motions.PushBack(motion);
+            }
+        }
+    }
+
+    _model->SaveParameters();
+    _initialized = true;
+
+    return true;
+}
+
+void TestModel::UpdateSimulation(csmFloat32 deltaTimeSeconds)
+{
+    csmBool motionUpdated = false;
+
+    _model->LoadParameters();
+    if (!_motionManager->IsFinished())
+    {
+        motionUpdated = _motionManager->UpdateMotion(_model, deltaTimeSeconds);
+    }
+    _model->SaveParameters();
+
+    if (!motionUpdated && _eyeBlink != NULL)
+    {
+        _eyeBlink->UpdateParameters(_model, deltaTimeSeconds);
+    }
+
+    if (_expressionManager != NULL)
+    {
+        _expressionManager->UpdateMotion(_model, deltaTimeSeconds);
+    }
+
+    if (_breath != NULL)
+    {
+        _breath->UpdateParameters(_model, deltaTimeSeconds);
+    }
+
+    if (_physics != NULL)
+    {
+        _physics->Evaluate(_model, deltaTimeSeconds);
+    }
+
+    if (_pose != NULL)
+    {
+        _pose->UpdateParameters(_model, deltaTimeSeconds);
+    }
+}
+
+CubismMotionQueueEntryHandle TestModel::StartMotion(csmInt32 index, csmInt32 priority)
+{
+    if (index < 0 || index >= GetMotionCount())
+    {
+        return InvalidMotionQueueEntryHandleValue;
+    }
+
+    return _motionManager->StartMotionPriority(_motions[index], false, priority);
+}
+
+void TestModel::SetExpression(csmInt32 index)
+{
+    if (index < 0 || index >= GetExpressionCount())
+    {
+        return;
+    }
+
+    _expressionManager->StartMotion(_expressions[index], false);
+}
+
+csmInt32 TestModel::GetMotionCount() const
+{
+    return static_cast<csmInt32>(_motions.GetSize());
+}
+
+ACubismMotion* TestModel::GetMotion(csmInt32 index) const
+{
+    return _motions[index];
+}
+
+csmInt32 TestModel::GetExpressionCount() const
+{
+    return static_cast<csmInt32>(_expressions.GetSize());
+}
+
+ACubismMotion* TestModel::GetExpression(csmInt32 index) const
+{
+    return _expressions[index];
+}
+
+CubismMotionManager* TestModel::GetMotionManager() const
+{
+    return _motionManager;
+}
+
+CubismExpressionMotionManager* TestModel::GetExpressionManager() const
+{
+    return _expressionManager;
+}
+
+CubismPhysics* TestModel::GetPhysics() const
+{
+    return _physics;
+}
+
+CubismPose* TestModel::GetPose() const
+{
+    return _pose;
+}
+
+ICubismModelSetting* TestModel::GetModelSetting() const
+{
+    return _modelSetting;
+}
+
+csmBool TestModel::LoadRelativeFile(const csmChar* fileName, std::vector<csmByte>& output) const
+{
+    if (fileName == NULL || strcmp(fileName, "") == 0)
+    {
+        return false;
+    }
+
+    return LoadFile(_modelHomeDir + fileName, output) && !output.empty();
+}
+
+const std::vector<csmByte>& GetStubMoc(const BundledModel& bundledModel)
+{
+    static std::map<std::string, std::vector<csmByte> > mocs;
+
+    std::map<std::string, std::vector<csmByte> >::iterator found = mocs.find(bundledModel.Name);
+    if (found != mocs.end())
+    {
+        return found->second;
+    }
+
+    CubismStubMocBuilder builder;
+    std::vector<csmByte>& moc = mocs[bundledModel.Name];
+
+    if (builder.AddModelMetadata(bundledModel.Directory, bundledModel.FileName))
+    {
+        moc = builder.Build();
+    }
+
+    return moc;
+}
+
+std::string CreateDensePhysicsJson(const std::vector<csmByte>& physicsJson, CubismModel* model)
+{
+    std::string json(physicsJson.begin(), physicsJson.end());
+
+    // 入力の総数を書き換える
+    const std::string totalInputCountKey = "\"TotalInputCount\"";
+    const std::string::size_type countKey = json.find(totalInputCountKey);
+    if (countKey == std::string::npos)
+    {
+        return std::string();
+    }
+    const std::string::size_type countBegin = json.find_first_of("0123456789", countKey + totalInputCountKey.size());
+    const std::string::size_type countEnd = json.find_first_not_of("0123456789", countBegin);
+    if (countBegin == std::string::npos || countEnd == std::string::npos)
+    {
+        return std::string();
+    }
+    const csmInt32 totalInputCount = atoi(json.substr(countBegin, countEnd - countBegin).c_str()) + model->GetParameterCount();
+
+    char countText[16];
+    snprintf(countText, sizeof(countText), "%d", totalInputCount);
+    json.replace(countBegin, countEnd - countBegin, countText);
+
+    // 最初の設定の入力の先頭に追加する
+    const std::string::size_type settings = json.find("\"PhysicsSettings\"");
+    const std::string::size_type input = settings == std::string::npos ? std::string::npos : json.find("\"Input\"", settings);
+    const std::string::size_type inputArray = input == std::string::npos ? std::string::npos : json.find('[', input);
+    if (inputArray == std::string::npos)
+    {
+        return std::string();
+    }
+
+    std::string inputs;
+    for (csmInt32 i = 0; i < model->GetParameterCount(); ++i)
+    {
+        inputs += (i > 0) ? "," : "";
+        inputs += "{\"Source\":{\"Target\":\"Parameter\",\"Id\":\"";
+        inputs += model->GetParameterId(i)->GetString().GetRawString();
+        inputs += "\"},\"Weight\":0,\"Type\":\"X\",\"Reflect\":false}";
+    }
+    const std::string::size_type firstInput = json.find_first_not_of(" \t\r\n", inputArray + 1);
+    if (firstInput != std::string::npos && json[firstInput] != ']')
+    {
+        inputs += ",";
+    }
+    json.insert(inputArray + 1, inputs);
+
+    return json;
+}
+
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <CubismFramework.hpp>
+#include <ICubismModelSetting.hpp>
+#include <Model/CubismUserModel.hpp>
+#include <Motion/CubismExpressionMotionManager.hpp>
+#include <Motion/CubismMotionManager.hpp>
+#include <Physics/CubismPhysics.hpp>
+#include <Effect/CubismPose.hpp>
+#include "CubismTestSupport.hpp"
+
+namespace CubismTest {
+
+/**
+ * @brief 同梱モデルのJSONとスタブCore用のmocから組み立てたモデル
+ *
+ * アプリのLAppModelと同じ順序でモーション・表情・まばたき・呼吸・物理演算・ポーズを更新する。
+ */
+class TestModel : public Csm::CubismUserModel
+{
+public:
+    TestModel();
+
+    virtual ~TestModel();
+
+    /**
+     * @brief 同梱モデルを読み込む
+     *
+     * @param[in]   bundledModel    読み込むモデル
+     *
+     * @return  読み込めた場合はtrue
+     */
+    Csm::csmBool LoadAssets(const BundledModel& bundledModel);
+
+    /**
+     * @brief モデルの状態を1ステップ進める（CubismModel::Updateは呼ばない）
+     *
+     * @param[in]   deltaTimeSeconds    経過時間[秒]
+     */
+    void UpdateSimulation(Csm::csmFloat32 deltaTimeSeconds);
+
+    /**
+     * @brief 読み込んだ順で数えたモーションを再生する
+     */
+    Csm::CubismMotionQueueEntryHandle StartMotion(Csm::csmInt32 index, Csm::csmInt32 priority = 2);
+
+    /**
+     * @brief 読み込んだ順で数えた表情を設定する
+     */
+    void SetExpression(Csm::csmInt32 index);
+
+    Csm::csmInt32 GetMotionCount() const;
+    Csm::ACubismMotion* GetMotion(Csm::csmInt32 index) const;
+    Csm::csmInt32 GetExpressionCount() const;
+    Csm::ACubismMotion* GetExpression(Csm::csmInt32 index) const;
+
+    Csm::CubismMotionManager* GetMotionManager() const;
+    Csm::CubismExpressionMotionManager* GetExpressionManager() const;
+    Csm::CubismPhysics* GetPhysics() const;
+    Csm::CubismPose* GetPose() const;
+
+    /**
+     * @brief モデル設定を取得する
+     */
+    Csm::ICubismModelSetting* GetModelSetting() const;
+
+    /**
+     * @brief モデルのディレクトリからの相対パスでファイルを読み込む
+     */
+    Csm::csmBool LoadRelativeFile(const Csm::csmChar* fileName, std::vector<Csm::csmByte>& output) const;
+
+private:
+    Csm::ICubismModelSetting* _modelSetting;
+    std::string _modelHomeDir;
+    Csm::csmVector<Csm::ACubismMotion*> _motions;
+    Csm::csmVector<Csm::ACubismMotion*> _expressions;
+    Csm::csmVector<Csm::CubismIdHandle> _eyeBlinkIds;
+    Csm::csmVector<Csm::CubismIdHandle> _lipSyncIds;
+};
+
+/**
+ * @brief 同梱モデルのスタブmocを取得する。生成したmocはプロセス内でキャッシュする
+ *
+ * @param[in]   bundledModel    対象のモデル
+ *
+ * @return  mocのバイト列。生成できない場合は空
+ */
+const std::vector<Csm::csmByte>& GetStubMoc(const BundledModel& bundledModel);
+
+/**
+ * @brief 全てのパラメータを物理演算の入力として参照するphysics3.jsonを作成する
+ *
+ * 最初の物理演算の設定に、モデルの全パラメータを重み0の入力として追加する。
+ * 重み0の入力は演算結果を変えないため、元のファイルと同じ結果になるはずの比較対象として使う。
+ *
+ * @param[in]   physicsJson     元のphysics3.json
+ * @param[in]   model           対象のモデル
+ *
+ * @return  作成したphysics3.json。元のファイルの形式が想定と異なる場合は空
+ */
+std::string CreateDensePhysicsJson(const std::vector<Csm::csmByte>& physicsJson, Csm::CubismModel* model);
+
+}
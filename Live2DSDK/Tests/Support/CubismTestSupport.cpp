@@ -0,0 +1,428 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismTestSupport.hpp"
+#include <algorithm>
+#include <atomic>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <zlib.h>
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+CubismTest::TestAllocator s_allocator;
+CubismFramework::Option s_option;
+
+void PrintMessage(const csmChar* message)
+{
+    fprintf(stderr, "%s", message);
+}
+
+std::string WithTrailingSlash(const char* directory)
+{
+    std::string result(directory);
+
+    if (!result.empty() && result[result.size() - 1] != '/')
+    {
+        result += '/';
+    }
+
+    return result;
+}
+
+csmUint32 ReadUint32(const csmByte* data)
+{
+    return static_cast<csmUint32>(data[0]) | (static_cast<csmUint32>(data[1]) << 8)
+         | (static_cast<csmUint32>(data[2]) << 16) | (static_cast<csmUint32>(data[3]) << 24);
+}
+
+csmUint16 ReadUint16(const csmByte* data)
+{
+    return static_cast<csmUint16>(data[0] | (data[1] << 8));
+}
+
+void AppendUint32BigEndian(std::vector<csmByte>& output, csmUint32 value)
+{
+    output.push_back(static_cast<csmByte>(value >> 24));
+    output.push_back(static_cast<csmByte>(value >> 16));
+    output.push_back(static_cast<csmByte>(value >> 8));
+    output.push_back(static_cast<csmByte>(value));
+}
+
+/// Appends a PNG chunk (length, type, data and CRC).
+void AppendPngChunk(std::vector<csmByte>& output, const char* type, const std::vector<csmByte>& data)
+{
+    AppendUint32BigEndian(output, static_cast<csmUint32>(data.size()));
+
+    const size_t typeOffset = output.size();
+    output.insert(output.end(), type, type + 4);
+    output.insert(output.end(), data.begin(), data.end());
+
+    const uLong crc = crc32(0L, &output[typeOffset], static_cast<uInt>(output.size() - typeOffset));
+    AppendUint32BigEndian(output, static_cast<csmUint32>(crc));
+}
+
+struct ParallelForContext
+{
+    std::atomic<csmInt32> NextIndex;
+    csmInt32 Count;
+    void* TaskContext;
+    void (*Task)(void* context, csmInt32 index);
+};
+
+void RunParallelForTasks(ParallelForContext* context)
+{
+    for (csmInt32 index = context->NextIndex.fetch_add(1); index < context->Count; index = context->NextIndex.fetch_add(1))
+    {
+        context->Task(context->TaskContext, index);
+    }
+}
+
+}
+
+namespace CubismTest {
+
+TestAllocator::TestAllocator()
+    : _allocationCount(0)
+{ }
+
+void* TestAllocator::Allocate(const csmSizeType size)
+{
+    ++_allocationCount;
+    return malloc(size);
+}
+
+void TestAllocator::Deallocate(void* memory)
+{
+    free(memory);
+}
+
+void* TestAllocator::AllocateAligned(const csmSizeType size, const csmUint32 alignment)
+{
+    size_t offset, shift, alignedAddress;
+    void* allocation;
+    void** preamble;
+
+    offset = alignment - 1 + sizeof(void*);
+
+    allocation = Allocate(size + static_cast<csmUint32>(offset));
+
+    alignedAddress = reinterpret_cast<size_t>(allocation) + sizeof(void*);
+
+    shift = alignedAddress % alignment;
+
+    if (shift)
+    {
+        alignedAddress += (alignment - shift);
+    }
+
+    preamble = reinterpret_cast<void**>(alignedAddress);
+    preamble[-1] = allocation;
+
+    return reinterpret_cast<void*>(alignedAddress);
+}
+
+void TestAllocator::DeallocateAligned(void* alignedMemory)
+{
+    void** preamble;
+
+    preamble = static_cast<void**>(alignedMemory);
+
+    Deallocate(preamble[-1]);
+}
+
+csmUint64 TestAllocator::GetAllocationCount() const
+{
+    return _allocationCount;
+}
+
+void StartUpFramework()
+{
+    if (CubismFramework::IsInitialized())
+    {
+        return;
+    }
+
+    s_option.LogFunction = PrintMessage;
+    s_option.LoggingLevel = CubismFramework::Option::LogLevel_Warning;
+
+    CubismFramework::StartUp(&s_allocator, &s_option);
+    CubismFramework::Initialize();
+}
+
+void DisposeFramework()
+{
+    if (!CubismFramework::IsInitialized())
+    {
+        return;
+    }
+
+    CubismFramework::Dispose();
+    CubismFramework::CleanUp();
+}
+
+TestAllocator& GetAllocator()
+{
+    return s_allocator;
+}
+
+std::string GetAssetsDirectory()
+{
+    const char* directory = getenv("CSM_TEST_ASSETS_DIR");
+
+    return WithTrailingSlash(directory ? directory : CSM_TEST_ASSETS_DIR);
+}
+
+std::string GetTestDataDirectory()
+{
+    const char* directory = getenv("CSM_TEST_DATA_DIR");
+
+    return WithTrailingSlash(directory ? directory : CSM_TEST_DATA_DIR);
+}
+
+const std::vector<BundledModel>& GetBundledModels()
+{
+    static std::vector<BundledModel> models;
+
+    if (models.empty())
+    {
+        const std::string assets = GetAssetsDirectory();
+        const char* bundled[] = { "Haru", "Hiyori", "Mao", "tororo" };
+        const char* standalone[] = { "hijiki", "kei_vowels_pro" };
+
+        for (csmUint32 i = 0; i < sizeof(bundled) / sizeof(bundled[0]); ++i)
+        {
+            BundledModel model;
+            model.Name = bundled[i];
+            model.Directory = assets + "Live2DModels.bundle/Resources/" + bundled[i] + "/";
+            model.FileName = std::string(bundled[i]) + ".model3.json";
+            models.push_back(model);
+        }
+
+        for (csmUint32 i = 0; i < sizeof(standalone) / sizeof(standalone[0]); ++i)
+        {
+            BundledModel model;
+            model.Name = standalone[i];
+            model.Directory = assets + standalone[i] + "/";
+            model.FileName = std::string(standalone[i]) + ".model3.json";
+            models.push_back(model);
+        }
+    }
+
+    return models;
+}
+
+void PrintTo(const BundledModel& model, std::ostream* os)
+{
+    *os << model.Name;
+}
+
+const BundledModel* FindBundledModel(const std::string& name)
+{
+    const std::vector<BundledModel>& models = GetBundledModels();
+
+    for (std::vector<BundledModel>::size_type i = 0; i < models.size(); ++i)
+    {
+        if (models[i].Name == name)
+        {
+            return &models[i];
+        }
+    }
+
+    return NULL;
+}
+
+bool LoadFile(const std::string& path, std::vector<csmByte>& output)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    output.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    const bool isRead = output.empty() || fread(&output[0], 1, output.size(), file) == output.size();
+    fclose(file);
+
+    return isRead;
+}
+
+std::vector<std::string> ListFiles(const std::string& directory, const std::string& suffix)
+{
+    std::vector<std::string> files;
+
+    DIR* dir = opendir(directory.c_str());
+    if (!dir)
+    {
+        return files;
+    }
+
+    for (dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir))
+    {
+        const std::string name = entry->d_name;
+
+        if (name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+            files.push_back(directory + name);
+        }
+    }
+
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+
+    return files;
+}
+
+bool LoadWavMono(const std::string& path, std::vector<csmFloat32>& samples, csmUint32& samplingRate)
+{
+    std::vector<csmByte> file;
+    if (!LoadFile(path, file) || file.size() < 12
+        || memcmp(&file[0], "RIFF", 4) != 0 || memcmp(&file[8], "WAVE", 4) != 0)
+    {
+        return false;
+    }
+
+    csmUint16 channelCount = 0;
+    csmUint16 bitsPerSample = 0;
+    samplingRate = 0;
+
+    for (size_t position = 12; position + 8 <= file.size();)
+    {
+        const csmUint32 chunkSize = ReadUint32(&file[position + 4]);
+        const size_t body = position + 8;
+
+        if (body + chunkSize > file.size())
+        {
+            return false;
+        }
+
+        if (memcmp(&file[position], "fmt ", 4) == 0 && chunkSize >= 16)
+        {
+            if (ReadUint16(&file[body]) != 1)
+            {
+                // リニアPCM以外は扱わない
+                return false;
+            }
+
+            channelCount = ReadUint16(&file[body + 2]);
+            samplingRate = ReadUint32(&file[body + 4]);
+            bitsPerSample = ReadUint16(&file[body + 14]);
+        }
+        else if (memcmp(&file[position], "data", 4) == 0)
+        {
+            if (channelCount == 0 || bitsPerSample != 16)
+            {
+                return false;
+            }
+
+            const csmUint32 frameCount = chunkSize / (2u * channelCount);
+            samples.resize(frameCount);
+
+            for (csmUint32 frame = 0; frame < frameCount; ++frame)
+            {
+                csmFloat32 sum = 0.0f;
+
+                for (csmUint16 channel = 0; channel < channelCount; ++channel)
+                {
+                    const csmInt16 value = static_cast<csmInt16>(ReadUint16(&file[body + (frame * channelCount + channel) * 2u]));
+                    sum += static_cast<csmFloat32>(value) / 32768.0f;
+                }
+
+                samples[frame] = sum / static_cast<csmFloat32>(channelCount);
+            }
+
+            return true;
+        }
+
+        position = body + chunkSize + (chunkSize & 1u);
+    }
+
+    return false;
+}
+
+bool WritePng(const std::string& path, const csmByte* pixels, csmUint32 width, csmUint32 height)
+{
+    // 各行の先頭にフィルタ無し(0)を付ける
+    const size_t stride = static_cast<size_t>(width) * 4;
+    std::vector<csmByte> scanlines;
+    scanlines.reserve((stride + 1) * height);
+    for (csmUint32 y = 0; y < height; ++y)
+    {
+        scanlines.push_back(0);
+        scanlines.insert(scanlines.end(), pixels + y * stride, pixels + (y + 1) * stride);
+    }
+
+    uLongf compressedSize = compressBound(static_cast<uLong>(scanlines.size()));
+    std::vector<csmByte> compressed(compressedSize);
+    if (compress2(&compressed[0], &compressedSize, &scanlines[0], static_cast<uLong>(scanlines.size()), Z_BEST_COMPRESSION) != Z_OK)
+    {
+        return false;
+    }
+    compressed.resize(compressedSize);
+
+    std::vector<csmByte> header;
+    AppendUint32BigEndian(header, width);
+    AppendUint32BigEndian(header, height);
+    header.push_back(8);    // ビット深度
+    header.push_back(6);    // RGBA
+    header.push_back(0);
+    header.push_back(0);
+    header.push_back(0);
+
+    const csmByte signature[] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    std::vector<csmByte> png(signature, signature + sizeof(signature));
+    AppendPngChunk(png, "IHDR", header);
+    AppendPngChunk(png, "IDAT", compressed);
+    AppendPngChunk(png, "IEND", std::vector<csmByte>());
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        return false;
+    }
+
+    const bool isWritten = fwrite(&png[0], 1, png.size(), file) == png.size();
+    fclose(file);
+
+    return isWritten;
+}
+
+void ParallelFor(csmInt32 count, void* context, void (*task)(void* context, csmInt32 index))
+{
+    ParallelForContext parallelForContext;
+    parallelForContext.NextIndex.store(0);
+    parallelForContext.Count = count;
+    parallelForContext.TaskContext = context;
+    parallelForContext.Task = task;
+
+    const csmUint32 hardwareThreadCount = std::thread::hardware_concurrency();
+    const csmInt32 threadCount = std::min<csmInt32>(count, std::max<csmInt32>(2, static_cast<csmInt32>(hardwareThreadCount)));
+
+    // 呼び出し元のスレッドも1つのワーカーとして使う
+    std::vector<std::thread> threads;
+    for (csmInt32 i = 1; i < threadCount; ++i)
+    {
+        threads.push_back(std::thread(RunParallelForTasks, &parallelForContext));
+    }
+    RunParallelForTasks(&parallelForContext);
+
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    }
+}
+
+}
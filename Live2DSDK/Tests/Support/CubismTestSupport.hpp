@@ -0,0 +1,167 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <CubismFramework.hpp>
+#include <ICubismAllocator.hpp>
+
+/**
+ * @brief テスト・ベンチマークで共通に使う処理
+ */
+namespace CubismTest {
+
+/**
+ * @brief 同梱モデル1体分の場所
+ */
+struct BundledModel
+{
+    std::string Name;           ///< モデル名
+    std::string Directory;      ///< model3.jsonのあるディレクトリ（末尾に/を含む）
+    std::string FileName;       ///< model3.jsonのファイル名
+};
+
+/**
+ * @brief 同梱モデルごとのパラメータ化テストに、モデル名をテスト名として付ける
+ *
+ * INSTANTIATE_TEST_SUITE_Pに::testing::ValuesIn(GetBundledModels())と一緒に渡す。
+ */
+struct BundledModelName
+{
+    template <class ParamInfo>
+    std::string operator()(const ParamInfo& info) const
+    {
+        return info.param.Name;
+    }
+};
+
+/**
+ * @brief gtestが失敗したテストのパラメータとしてモデル名を表示するための関数
+ */
+void PrintTo(const BundledModel& model, std::ostream* os);
+
+/**
+ * @brief mallocで確保するアロケータ。確保回数を数える
+ *
+ * 複数のスレッドから同時に呼び出してよい。
+ */
+class TestAllocator : public Csm::ICubismAllocator
+{
+public:
+    TestAllocator();
+
+    virtual void* Allocate(const Csm::csmSizeType size);
+    virtual void Deallocate(void* memory);
+    virtual void* AllocateAligned(const Csm::csmSizeType size, const Csm::csmUint32 alignment);
+    virtual void DeallocateAligned(void* alignedMemory);
+
+    /**
+     * @brief これまでに確保した回数を取得する
+     */
+    Csm::csmUint64 GetAllocationCount() const;
+
+private:
+    std::atomic<Csm::csmUint64> _allocationCount;   ///< 複数のスレッドから確保されるため不可分に数える
+};
+
+/**
+ * @brief フレームワークを起動・初期化する。2回目以降の呼び出しは何もしない
+ */
+void StartUpFramework();
+
+/**
+ * @brief フレームワークを破棄する
+ */
+void DisposeFramework();
+
+/**
+ * @brief フレームワークが使うアロケータを取得する
+ */
+TestAllocator& GetAllocator();
+
+/**
+ * @brief 同梱モデルのAssetsディレクトリを取得する（末尾に/を含む）
+ */
+std::string GetAssetsDirectory();
+
+/**
+ * @brief テスト用データ（ゴールデンイメージなど）のディレクトリを取得する（末尾に/を含む）
+ */
+std::string GetTestDataDirectory();
+
+/**
+ * @brief ベンチマーク対象の同梱モデル（Haru・Hiyori・Mao・tororo・hijiki・kei_vowels_pro）を取得する
+ */
+const std::vector<BundledModel>& GetBundledModels();
+
+/**
+ * @brief 名前から同梱モデルを探す
+ *
+ * @return  見つからない場合はNULL
+ */
+const BundledModel* FindBundledModel(const std::string& name);
+
+/**
+ * @brief ファイルを読み込む
+ *
+ * @param[in]   path    ファイルパス
+ * @param[out]  output  ファイルの内容
+ *
+ * @return  読み込めた場合はtrue
+ */
+bool LoadFile(const std::string& path, std::vector<Csm::csmByte>& output);
+
+/**
+ * @brief ディレクトリ内の、指定した拡張子を持つファイルを名前順に列挙する
+ *
+ * @param[in]   directory   ディレクトリ（末尾に/を含む）
+ * @param[in]   suffix      拡張子を含むファイル名の末尾（例: ".motion3.json"）
+ *
+ * @return  ファイルパスの一覧
+ */
+std::vector<std::string> ListFiles(const std::string& directory, const std::string& suffix);
+
+/**
+ * @brief 16bit PCMのWAVファイルをモノラルの浮動小数サンプルに変換して読み込む
+ *
+ * @param[in]   path            ファイルパス
+ * @param[out]  samples         -1〜1のサンプル。複数チャンネルの場合は平均する
+ * @param[out]  samplingRate    サンプリングレート[Hz]
+ *
+ * @return  読み込めた場合はtrue
+ */
+bool LoadWavMono(const std::string& path, std::vector<Csm::csmFloat32>& samples, Csm::csmUint32& samplingRate);
+
+/**
+ * @brief RGBA8のピクセルをPNGファイルに書き出す（ゴールデンイメージの更新用）
+ *
+ * @param[in]   path    ファイルパス
+ * @param[in]   pixels  上の行から順に並べたRGBA8のピクセル
+ * @param[in]   width   幅[px]
+ * @param[in]   height  高さ[px]
+ *
+ * @return  書き出せた場合はtrue
+ */
+bool WritePng(const std::string& path, const Csm::csmByte* pixels, Csm::csmUint32 width, Csm::csmUint32 height);
+
+/**
+ * @brief 複数のスレッドでタスクを並列実行する
+ *
+ * CubismPhysics::ParallelForFunction・CubismRenderer_Software::ParallelForFunctionと同じ形式。
+ * 1コアの環境でも並列に実行されるよう、少なくとも2つのスレッドを使う。
+ *
+ * @param[in]   count       タスクの数
+ * @param[in]   context     taskに渡すコンテキスト
+ * @param[in]   task        タスクの関数
+ */
+void ParallelFor(Csm::csmInt32 count, void* context, void (*task)(void* context, Csm::csmInt32 index));
+
+}
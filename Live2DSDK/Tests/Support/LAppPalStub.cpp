@@ -0,0 +1,15 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+// アプリではLAppPal.mmがNSBundleを使って実装する。テストではリソースバンドルが無いため、
+// 渡されたパスをそのまま開かせる
+#include "LAppPal.h"
+
+std::string LAppPal::GetResourceFilePath(const std::string filePath)
+{
+    return std::string();
+}
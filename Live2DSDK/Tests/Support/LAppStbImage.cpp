@@ -0,0 +1,12 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+// アプリではLAppTextureManager.mmが実装を持つ。テストではObjective-C部分を使わないため、ここで実装する
+#define STBI_NO_STDIO
+#define STBI_ONLY_PNG
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
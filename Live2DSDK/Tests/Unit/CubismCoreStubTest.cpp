@@ -0,0 +1,266 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <CubismFramework.hpp>
+#include <CubismRenderer_Software.hpp>
+#include <Id/CubismIdManager.hpp>
+#include <Model/CubismMoc.hpp>
+#include <Model/CubismMocConsistencyCache.hpp>
+#include <Model/CubismModel.hpp>
+#include "CubismStubMocBuilder.hpp"
+#include "CubismTestModel.hpp"
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+/// One drawable bound to one parameter, under one part.
+std::vector<csmByte> BuildSingleDrawableMoc()
+{
+    CubismStubMocBuilder builder;
+    const csmInt32 parameter = builder.AddParameter("ParamMove", -1.0f, 1.0f, 0.0f);
+    const csmInt32 part = builder.AddPart("PartBody");
+
+    CubismStubMocBuilder::Drawable drawable = CubismStubMocBuilder::CreateGrid("ArtMeshBody", -0.25f, -0.25f, 0.25f, 0.25f, 2, 2);
+    drawable.ParentPartIndex = part;
+
+    CubismStubMocBuilder::Binding binding;
+    binding.ParameterIndex = parameter;
+    binding.DeltaX = 0.5f;
+    binding.DeltaY = 0.0f;
+    drawable.Bindings.push_back(binding);
+    builder.AddDrawable(drawable);
+
+    return builder.Build();
+}
+
+std::string ToHex(const CubismMocConsistencyCache::Hash& hash)
+{
+    static const char Digits[] = "0123456789abcdef";
+    std::string text;
+    for (csmInt32 i = 0; i < CubismMocConsistencyCache::HashSize; ++i)
+    {
+        text += Digits[hash.Bytes[i] >> 4];
+        text += Digits[hash.Bytes[i] & 0x0F];
+    }
+    return text;
+}
+
+std::string HashText(const std::string& text)
+{
+    return ToHex(CubismMocConsistencyCache::ComputeHash(reinterpret_cast<const csmByte*>(text.data()), static_cast<csmSizeInt>(text.size())));
+}
+
+}
+
+TEST(CubismCoreStubTest, RejectsBrokenMoc)
+{
+    std::vector<csmByte> moc = BuildSingleDrawableMoc();
+
+    EXPECT_TRUE(CubismMoc::HasMocConsistencyFromUnrevivedMoc(&moc[0], static_cast<csmSizeInt>(moc.size())));
+
+    moc[8] ^= 0x01;  // FileSize
+    EXPECT_FALSE(CubismMoc::HasMocConsistencyFromUnrevivedMoc(&moc[0], static_cast<csmSizeInt>(moc.size())));
+}
+
+TEST(CubismCoreStubTest, ChecksUnalignedMocFromWorkerThreads)
+{
+    const std::vector<csmByte> moc = BuildSingleDrawableMoc();
+    const csmSizeInt size = static_cast<csmSizeInt>(moc.size());
+
+    // メモリマップしたファイルと同様に、csmAlignofMocに揃っていない位置に置く
+    std::vector<csmByte> unaligned(size + 1);
+    std::vector<csmByte> brokenUnaligned(size + 1);
+    memcpy(&unaligned[1], &moc[0], size);
+    memcpy(&brokenUnaligned[1], &moc[0], size);
+    brokenUnaligned[1 + 8] ^= 0x01;  // FileSize
+
+    CubismMocConsistencyCache::Clear();
+
+    const csmInt32 threadCount = 4;
+    csmBool results[threadCount][2];
+    std::vector<std::thread> threads;
+    for (csmInt32 i = 0; i < threadCount; ++i)
+    {
+        threads.push_back(std::thread([&, i]() {
+            results[i][0] = CubismMocConsistencyCache::HasMocConsistency(&unaligned[1], size);
+            results[i][1] = CubismMocConsistencyCache::HasMocConsistency(&brokenUnaligned[1], size);
+        }));
+    }
+    for (csmInt32 i = 0; i < threadCount; ++i)
+    {
+        threads[i].join();
+    }
+
+    for (csmInt32 i = 0; i < threadCount; ++i)
+    {
+        EXPECT_TRUE(results[i][0]) << "thread " << i;
+        EXPECT_FALSE(results[i][1]) << "thread " << i;
+    }
+
+    // 検証結果はキャッシュされ、モデル読み込み時に再利用される
+    csmBool isConsistent = false;
+    EXPECT_TRUE(CubismMocConsistencyCache::Find(CubismMocConsistencyCache::ComputeHash(&moc[0], size), size, isConsistent));
+    EXPECT_TRUE(isConsistent);
+
+    CubismMocConsistencyCache::Clear();
+}
+
+TEST(CubismCoreStubTest, MocConsistencyCacheKeyIsSha256)
+{
+    // FIPS 180-4のテストベクタ。64バイトの区切りをまたぐ長さも確認する
+    EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", HashText(""));
+    EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", HashText("abc"));
+    EXPECT_EQ("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", HashText("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+    EXPECT_EQ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", HashText(std::string(1000000, 'a')));
+}
+
+TEST(CubismCoreStubTest, MocConsistencyCacheRoundTrips)
+{
+    const std::vector<csmByte> moc = BuildSingleDrawableMoc();
+    const csmSizeInt size = static_cast<csmSizeInt>(moc.size());
+    std::vector<csmByte> brokenMoc = moc;
+    brokenMoc[8] ^= 0x01;  // FileSize
+
+    const CubismMocConsistencyCache::Hash hash = CubismMocConsistencyCache::ComputeHash(&moc[0], size);
+    const CubismMocConsistencyCache::Hash brokenHash = CubismMocConsistencyCache::ComputeHash(&brokenMoc[0], size);
+
+    CubismMocConsistencyCache::Clear();
+    CubismMocConsistencyCache::Store(hash, size, true);
+    CubismMocConsistencyCache::Store(brokenHash, size, false);
+
+    csmVector<csmByte> serialized;
+    CubismMocConsistencyCache::Serialize(serialized);
+    CubismMocConsistencyCache::Clear();
+    ASSERT_TRUE(CubismMocConsistencyCache::Deserialize(serialized.GetPtr(), serialized.GetSize()));
+
+    csmBool isConsistent = false;
+    EXPECT_TRUE(CubismMocConsistencyCache::Find(hash, size, isConsistent));
+    EXPECT_TRUE(isConsistent);
+    EXPECT_TRUE(CubismMocConsistencyCache::Find(brokenHash, size, isConsistent));
+    EXPECT_FALSE(isConsistent);
+
+    // サイズが異なれば別の内容として扱う
+    EXPECT_FALSE(CubismMocConsistencyCache::Find(hash, size + 1, isConsistent));
+
+    // 64ビットのハッシュを使っていた以前の形式は読み込まない
+    const csmByte previousFormat[] = { 'M', 'C', 'C', '1', 0, 0, 0, 0 };
+    CubismMocConsistencyCache::Clear();
+    EXPECT_FALSE(CubismMocConsistencyCache::Deserialize(previousFormat, sizeof(previousFormat)));
+
+    CubismMocConsistencyCache::Clear();
+}
+
+TEST(CubismCoreStubTest, DeformsBoundDrawable)
+{
+    const std::vector<csmByte> mocBuffer = BuildSingleDrawableMoc();
+    CubismMoc* moc = CubismMoc::Create(&mocBuffer[0], static_cast<csmSizeInt>(mocBuffer.size()));
+    ASSERT_TRUE(moc != NULL);
+
+    CubismModel* model = moc->CreateModel();
+    ASSERT_TRUE(model != NULL);
+    ASSERT_EQ(1, model->GetDrawableCount());
+
+    const csmFloat32 restX = model->GetDrawableVertexPositions(0)[0].X;
+
+    // 下端の頂点は (0.25 + 0.75 * 0) の重みで動く
+    model->SetParameterValue(0, 1.0f);
+    model->Update();
+    EXPECT_FLOAT_EQ(restX + 0.5f * 0.5f * 0.25f, model->GetDrawableVertexPositions(0)[0].X);
+    EXPECT_TRUE(model->GetDrawableDynamicFlagVertexPositionsDidChange(0));
+
+    // パーツが透明になると描画されない
+    model->SetPartOpacity(0, 0.0f);
+    model->Update();
+    EXPECT_FALSE(model->GetDrawableDynamicFlagIsVisible(0));
+    EXPECT_TRUE(model->GetDrawableDynamicFlagVisibilityDidChange(0));
+
+    moc->DeleteModel(model);
+    CubismMoc::Delete(moc);
+}
+
+TEST(CubismCoreStubTest, UpdatesModelBoundsWithoutDrawing)
+{
+    const std::vector<csmByte> mocBuffer = BuildSingleDrawableMoc();
+    CubismMoc* moc = CubismMoc::Create(&mocBuffer[0], static_cast<csmSizeInt>(mocBuffer.size()));
+    ASSERT_TRUE(moc != NULL);
+
+    CubismModel* model = moc->CreateModel();
+    ASSERT_TRUE(model != NULL);
+    model->Update();
+
+    Rendering::CubismRenderer_Software* renderer = Rendering::CubismRenderer_Software::Create();
+    renderer->Initialize(model);
+
+    // 描画オブジェクトが左の画面外に来るように平行移動する
+    CubismMatrix44 mvp;
+    mvp.TranslateX(-1.3f);
+
+    // 矩形を計算するまでは判定できないため画面内として扱う
+    EXPECT_TRUE(renderer->IsInViewport(mvp, 0.0f));
+    renderer->UpdateModelBounds();
+    EXPECT_FALSE(renderer->IsInViewport(mvp, 0.0f));
+
+    // 描画しなくても、更新後に矩形を計算し直せば画面内に戻ったことを検出できる
+    model->SetParameterValue(0, 1.0f);
+    model->Update();
+    EXPECT_FALSE(renderer->IsInViewport(mvp, 0.0f));
+    renderer->UpdateModelBounds();
+    EXPECT_TRUE(renderer->IsInViewport(mvp, 0.0f));
+
+    Rendering::CubismRenderer::Delete(renderer);
+    moc->DeleteModel(model);
+    CubismMoc::Delete(moc);
+}
+
+TEST(CubismCoreStubTest, LoadsBundledModels)
+{
+    const std::vector<CubismTest::BundledModel>& models = CubismTest::GetBundledModels();
+    ASSERT_EQ(6u, models.size());
+
+    for (std::vector<CubismTest::BundledModel>::size_type i = 0; i < models.size(); ++i)
+    {
+        SCOPED_TRACE(models[i].Name);
+
+        CubismTest::TestModel model;
+        ASSERT_TRUE(model.LoadAssets(models[i]));
+        EXPECT_GT(model.GetModel()->GetParameterCount(), 0);
+        EXPECT_GT(model.GetModel()->GetDrawableCount(), 0);
+        EXPECT_GT(model.GetMotionCount(), 0);
+        EXPECT_TRUE(model.GetPhysics() != NULL);
+
+        // 参照されるパラメータはすべてmocに含まれる
+        ICubismModelSetting* setting = model.GetModelSetting();
+        for (csmInt32 j = 0; j < setting->GetEyeBlinkParameterCount(); ++j)
+        {
+            EXPECT_LT(model.GetModel()->GetParameterIndex(setting->GetEyeBlinkParameterId(j)), model.GetModel()->GetParameterCount());
+        }
+
+        model.StartMotion(0);
+        for (csmInt32 frame = 0; frame < 60; ++frame)
+        {
+            model.UpdateSimulation(1.0f / 60.0f);
+            model.GetModel()->Update();
+        }
+    }
+}
+
+TEST(CubismCoreStubTest, GeneratesSameMocForSameModel)
+{
+    const CubismTest::BundledModel* haru = CubismTest::FindBundledModel("Haru");
+    ASSERT_TRUE(haru != NULL);
+
+    CubismStubMocBuilder first;
+    CubismStubMocBuilder second;
+    ASSERT_TRUE(first.AddModelMetadata(haru->Directory, haru->FileName));
+    ASSERT_TRUE(second.AddModelMetadata(haru->Directory, haru->FileName));
+
+    EXPECT_EQ(first.Build(), second.Build());
+}
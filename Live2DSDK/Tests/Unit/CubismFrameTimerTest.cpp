@@ -0,0 +1,240 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string.h>
+#include <vector>
+#include <Utils/CubismFrameTimer.hpp>
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+/// Per-frame result of replaying a frame-time trace.
+struct ReplayedFrame
+{
+    csmInt32 StepCount;
+    csmFloat32 FrameDeltaTime;
+    csmFloat32 InterpolationAlpha;
+};
+
+std::vector<ReplayedFrame> Replay(CubismFrameTimer& timer, const std::vector<csmFloat32>& trace)
+{
+    std::vector<ReplayedFrame> frames;
+
+    for (std::vector<csmFloat32>::size_type i = 0; i < trace.size(); ++i)
+    {
+        timer.Advance(trace[i]);
+
+        ReplayedFrame frame;
+        frame.StepCount = timer.GetStepCount();
+        frame.FrameDeltaTime = timer.GetFrameDeltaTime();
+        frame.InterpolationAlpha = timer.GetInterpolationAlpha();
+        frames.push_back(frame);
+    }
+
+    return frames;
+}
+
+/// Frame times recorded from a display running at roughly 60 fps with jitter and dropped frames, optionally with a long stall.
+std::vector<csmFloat32> CreateJitteryTrace(bool stall)
+{
+    std::vector<csmFloat32> trace;
+    csmUint32 state = 1;
+
+    for (csmInt32 frame = 0; frame < 1000; ++frame)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        csmFloat32 delta = 1.0f / 60.0f + (static_cast<csmFloat32>(state & 0xFFFF) / 65535.0f - 0.5f) * 0.004f;
+        if (frame % 89 == 0)
+        {
+            delta *= 3.0f;
+        }
+        if (stall && frame == 500)
+        {
+            delta = 0.8f;
+        }
+        trace.push_back(delta);
+    }
+
+    return trace;
+}
+
+/// Nearest-rank percentile, computed independently of the ring buffer.
+csmFloat32 GetNearestRankPercentile(std::vector<csmFloat32> samples, csmInt32 percentile)
+{
+    std::sort(samples.begin(), samples.end());
+    const std::vector<csmFloat32>::size_type rank = (samples.size() * percentile + 99) / 100;
+    return samples[rank == 0 ? 0 : rank - 1];
+}
+
+}
+
+TEST(CubismFrameTimerTest, SteadyFrameRateStepsOncePerFrame)
+{
+    CubismFrameTimer timer;
+    const std::vector<csmFloat32> trace(600, 1.0f / 60.0f);
+    const std::vector<ReplayedFrame> frames = Replay(timer, trace);
+
+    for (std::vector<ReplayedFrame>::size_type i = 0; i < frames.size(); ++i)
+    {
+        ASSERT_EQ(1, frames[i].StepCount) << "frame " << i;
+        ASSERT_EQ(0.0f, frames[i].InterpolationAlpha) << "frame " << i;
+    }
+    EXPECT_EQ(600u, timer.GetFrameCount());
+    EXPECT_EQ(0u, timer.GetHitchCount());
+}
+
+TEST(CubismFrameTimerTest, HighRefreshRateInterpolatesBetweenSteps)
+{
+    CubismFrameTimer timer;
+    const std::vector<csmFloat32> trace(240, 1.0f / 120.0f);
+    const std::vector<ReplayedFrame> frames = Replay(timer, trace);
+
+    // 2フレームに1回演算し、その間は半分の重みで補間する
+    for (std::vector<ReplayedFrame>::size_type i = 0; i < frames.size(); ++i)
+    {
+        ASSERT_EQ(i % 2 == 0 ? 0 : 1, frames[i].StepCount) << "frame " << i;
+        ASSERT_FLOAT_EQ(i % 2 == 0 ? 0.5f : 0.0f, frames[i].InterpolationAlpha) << "frame " << i;
+    }
+}
+
+TEST(CubismFrameTimerTest, ClampsHitches)
+{
+    CubismFrameTimer timer;
+    timer.SetMaxFrameDeltaTime(0.25f);
+    timer.SetMaxStepCount(4);
+    timer.SetHitchThreshold(0.05f);
+
+    timer.Advance(1.0f / 60.0f);
+    EXPECT_EQ(1, timer.GetStepCount());
+
+    // 経過時間は上限で切り詰め、ステップ数の上限を超える分の時間は破棄する
+    timer.Advance(1.0f);
+    EXPECT_EQ(0.25f, timer.GetFrameDeltaTime());
+    EXPECT_EQ(4, timer.GetStepCount());
+    EXPECT_EQ(0.0f, timer.GetInterpolationAlpha());
+    EXPECT_EQ(1u, timer.GetHitchCount());
+
+    // 次のフレームには持ち越さない
+    timer.Advance(1.0f / 60.0f);
+    EXPECT_EQ(1, timer.GetStepCount());
+    EXPECT_EQ(1u, timer.GetHitchCount());
+
+    // 負の経過時間は0として扱う
+    timer.Advance(-1.0f);
+    EXPECT_EQ(0.0f, timer.GetFrameDeltaTime());
+    EXPECT_EQ(0, timer.GetStepCount());
+    EXPECT_EQ(4u, timer.GetFrameCount());
+}
+
+TEST(CubismFrameTimerTest, SimulatedTimeFollowsTrace)
+{
+    CubismFrameTimer timer;
+    const std::vector<csmFloat32> trace = CreateJitteryTrace(false);
+    const std::vector<ReplayedFrame> frames = Replay(timer, trace);
+
+    double elapsedTime = 0.0;
+    csmInt32 totalStepCount = 0;
+    for (std::vector<ReplayedFrame>::size_type i = 0; i < frames.size(); ++i)
+    {
+        ASSERT_EQ(trace[i], frames[i].FrameDeltaTime) << "frame " << i;
+        ASSERT_GE(frames[i].StepCount, 0) << "frame " << i;
+        ASSERT_LE(frames[i].StepCount, 4) << "frame " << i;
+        ASSERT_GE(frames[i].InterpolationAlpha, 0.0f) << "frame " << i;
+        ASSERT_LT(frames[i].InterpolationAlpha, 1.0f) << "frame " << i;
+
+        // 演算した時間と補間で進める時間の合計は、それまでの経過時間に一致する
+        elapsedTime += trace[i];
+        totalStepCount += frames[i].StepCount;
+        const double simulatedTime = (totalStepCount + frames[i].InterpolationAlpha) * static_cast<double>(timer.GetFixedDeltaTime());
+        ASSERT_NEAR(elapsedTime, simulatedTime, 1.0e-4) << "frame " << i;
+    }
+
+    // 停止を挟むと、切り詰めと破棄の分だけ演算する時間が短くなる
+    CubismFrameTimer stalledTimer;
+    const std::vector<csmFloat32> stalledTrace = CreateJitteryTrace(true);
+    const std::vector<ReplayedFrame> stalledFrames = Replay(stalledTimer, stalledTrace);
+
+    csmInt32 stalledStepCount = 0;
+    for (std::vector<ReplayedFrame>::size_type i = 0; i < stalledFrames.size(); ++i)
+    {
+        stalledStepCount += stalledFrames[i].StepCount;
+    }
+    EXPECT_EQ(0.25f, stalledFrames[500].FrameDeltaTime);
+    EXPECT_EQ(4, stalledFrames[500].StepCount);
+    EXPECT_EQ(0.0f, stalledFrames[500].InterpolationAlpha);
+    EXPECT_NEAR(totalStepCount + 3, stalledStepCount, 1);
+}
+
+TEST(CubismFrameTimerTest, ReplayIsDeterministic)
+{
+    const std::vector<csmFloat32> trace = CreateJitteryTrace(true);
+
+    CubismFrameTimer first;
+    CubismFrameTimer second;
+    const std::vector<ReplayedFrame> expected = Replay(first, trace);
+    const std::vector<ReplayedFrame> actual = Replay(second, trace);
+
+    // Resetした後に再生しても同じ結果になる
+    first.Reset();
+    const std::vector<ReplayedFrame> afterReset = Replay(first, trace);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    ASSERT_EQ(expected.size(), afterReset.size());
+    for (std::vector<ReplayedFrame>::size_type i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_EQ(0, memcmp(&expected[i], &actual[i], sizeof(ReplayedFrame))) << "frame " << i;
+        ASSERT_EQ(0, memcmp(&expected[i], &afterReset[i], sizeof(ReplayedFrame))) << "frame " << i;
+    }
+    EXPECT_EQ(second.GetHitchCount(), first.GetHitchCount());
+}
+
+TEST(CubismFrameTimerTest, PercentilesMatchTrace)
+{
+    CubismFrameTimer timer;
+    EXPECT_EQ(0.0f, timer.GetFrameTimePercentile(50.0f));
+
+    const std::vector<csmFloat32> trace = CreateJitteryTrace(true);
+    std::vector<csmFloat32> recent;
+    csmUint32 hitchCount = 0;
+    for (std::vector<csmFloat32>::size_type i = 0; i < trace.size(); ++i)
+    {
+        timer.Advance(trace[i]);
+        hitchCount += trace[i] > 0.05f ? 1 : 0;
+
+        // 統計は直近のフレームだけを対象にする
+        recent.push_back(trace[i]);
+        if (recent.size() > static_cast<std::vector<csmFloat32>::size_type>(CubismFrameTimer::FrameTimeSampleCount))
+        {
+            recent.erase(recent.begin());
+        }
+
+        if (i == 99 || i == 255 || i == 600 || i + 1 == trace.size())
+        {
+            SCOPED_TRACE(i);
+            EXPECT_EQ(GetNearestRankPercentile(recent, 50), timer.GetFrameTimePercentile(50.0f));
+            EXPECT_EQ(GetNearestRankPercentile(recent, 95), timer.GetFrameTimePercentile(95.0f));
+            EXPECT_EQ(GetNearestRankPercentile(recent, 99), timer.GetFrameTimePercentile(99.0f));
+            EXPECT_EQ(GetNearestRankPercentile(recent, 100), timer.GetMaxFrameTime());
+            EXPECT_EQ(GetNearestRankPercentile(recent, 0), timer.GetFrameTimePercentile(0.0f));
+        }
+
+        // 切り詰める前の時間で記録する
+        if (i == 600)
+        {
+            EXPECT_EQ(0.8f, timer.GetMaxFrameTime());
+        }
+    }
+
+    EXPECT_EQ(hitchCount, timer.GetHitchCount());
+    EXPECT_EQ(static_cast<csmUint32>(trace.size()), timer.GetFrameCount());
+}
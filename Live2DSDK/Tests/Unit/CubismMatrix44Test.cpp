@@ -0,0 +1,332 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <string.h>
+#include <vector>
+#include <Math/CubismMatrix44.hpp>
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+/// Scalar multiply, identical to the fallback path of CubismMatrix44::Multiply.
+void MultiplyReference(const csmFloat32* a, const csmFloat32* b, csmFloat32* dst)
+{
+    csmFloat32 c[16] = { 0.0f };
+
+    for (csmInt32 i = 0; i < 4; ++i)
+    {
+        for (csmInt32 j = 0; j < 4; ++j)
+        {
+            for (csmInt32 k = 0; k < 4; ++k)
+            {
+                c[j + i * 4] += a[k + i * 4] * b[j + k * 4];
+            }
+        }
+    }
+
+    memcpy(dst, c, sizeof(c));
+}
+
+/// Inverse by Gauss-Jordan elimination in double precision.
+bool InvertReference(const csmFloat32* src, double* dst)
+{
+    double m[4][8];
+    for (csmInt32 i = 0; i < 4; ++i)
+    {
+        for (csmInt32 j = 0; j < 4; ++j)
+        {
+            m[i][j] = src[i * 4 + j];
+            m[i][j + 4] = i == j ? 1.0 : 0.0;
+        }
+    }
+
+    for (csmInt32 column = 0; column < 4; ++column)
+    {
+        csmInt32 pivot = column;
+        for (csmInt32 row = column + 1; row < 4; ++row)
+        {
+            pivot = fabs(m[row][column]) > fabs(m[pivot][column]) ? row : pivot;
+        }
+        if (m[pivot][column] == 0.0)
+        {
+            return false;
+        }
+        for (csmInt32 j = 0; j < 8; ++j)
+        {
+            const double swap = m[column][j];
+            m[column][j] = m[pivot][j];
+            m[pivot][j] = swap;
+        }
+
+        const double scale = 1.0 / m[column][column];
+        for (csmInt32 j = 0; j < 8; ++j)
+        {
+            m[column][j] *= scale;
+        }
+        for (csmInt32 row = 0; row < 4; ++row)
+        {
+            if (row == column)
+            {
+                continue;
+            }
+            const double factor = m[row][column];
+            for (csmInt32 j = 0; j < 8; ++j)
+            {
+                m[row][j] -= factor * m[column][j];
+            }
+        }
+    }
+
+    for (csmInt32 i = 0; i < 4; ++i)
+    {
+        for (csmInt32 j = 0; j < 4; ++j)
+        {
+            dst[i * 4 + j] = m[i][j + 4];
+        }
+    }
+    return true;
+}
+
+/// Deterministic values in [-range, range].
+class RandomFloats
+{
+public:
+    explicit RandomFloats(csmUint32 seed)
+        : _state(seed)
+    { }
+
+    csmFloat32 Next(csmFloat32 range)
+    {
+        _state ^= _state << 13;
+        _state ^= _state >> 17;
+        _state ^= _state << 5;
+        return (static_cast<csmFloat32>(_state & 0xFFFFFF) / static_cast<csmFloat32>(0xFFFFFF) * 2.0f - 1.0f) * range;
+    }
+
+private:
+    csmUint32 _state;
+};
+
+/// Matrices the framework actually builds: scale, translation and a rotation in the xy plane.
+void MakeTransform(RandomFloats& random, csmFloat32* m)
+{
+    const csmFloat32 angle = random.Next(3.1f);
+    const csmFloat32 sx = 0.2f + fabsf(random.Next(4.0f));
+    const csmFloat32 sy = 0.2f + fabsf(random.Next(4.0f));
+
+    CubismMatrix44 matrix;
+    csmFloat32* tr = matrix.GetArray();
+    tr[0] = cosf(angle) * sx;
+    tr[1] = sinf(angle) * sx;
+    tr[4] = -sinf(angle) * sy;
+    tr[5] = cosf(angle) * sy;
+    tr[12] = random.Next(10.0f);
+    tr[13] = random.Next(10.0f);
+    memcpy(m, tr, sizeof(csmFloat32) * 16);
+}
+
+}
+
+TEST(CubismMatrix44Test, MultiplyMatchesScalarPath)
+{
+    RandomFloats random(1);
+
+    for (csmInt32 n = 0; n < 1000; ++n)
+    {
+        csmFloat32 a[16];
+        csmFloat32 b[16];
+        for (csmInt32 i = 0; i < 16; ++i)
+        {
+            a[i] = random.Next(100.0f);
+            b[i] = random.Next(100.0f);
+        }
+
+        csmFloat32 expected[16];
+        csmFloat32 actual[16];
+        MultiplyReference(a, b, expected);
+        CubismMatrix44::Multiply(a, b, actual);
+
+        // 積和の順序が同じなので結果はビット単位で一致する
+        ASSERT_EQ(0, memcmp(expected, actual, sizeof(expected))) << "matrix " << n;
+    }
+}
+
+TEST(CubismMatrix44Test, MultiplyAllowsAliasedDestination)
+{
+    RandomFloats random(2);
+
+    csmFloat32 a[16];
+    csmFloat32 b[16];
+    for (csmInt32 i = 0; i < 16; ++i)
+    {
+        a[i] = random.Next(10.0f);
+        b[i] = random.Next(10.0f);
+    }
+
+    csmFloat32 expected[16];
+    MultiplyReference(a, b, expected);
+
+    csmFloat32 intoA[16];
+    memcpy(intoA, a, sizeof(a));
+    CubismMatrix44::Multiply(intoA, b, intoA);
+    EXPECT_EQ(0, memcmp(expected, intoA, sizeof(expected)));
+
+    csmFloat32 intoB[16];
+    memcpy(intoB, b, sizeof(b));
+    CubismMatrix44::Multiply(a, intoB, intoB);
+    EXPECT_EQ(0, memcmp(expected, intoB, sizeof(expected)));
+}
+
+TEST(CubismMatrix44Test, InvertMatchesReference)
+{
+    RandomFloats random(3);
+
+    for (csmInt32 n = 0; n < 1000; ++n)
+    {
+        csmFloat32 m[16];
+        if (n % 2 == 0)
+        {
+            MakeTransform(random, m);
+        }
+        else
+        {
+            // 対角優位にして、条件数の悪い行列で誤差を評価しないようにする
+            for (csmInt32 i = 0; i < 16; ++i)
+            {
+                m[i] = random.Next(1.0f) + (i % 5 == 0 ? 4.0f : 0.0f);
+            }
+        }
+
+        double expected[16];
+        ASSERT_TRUE(InvertReference(m, expected));
+
+        csmFloat32 actual[16];
+        ASSERT_TRUE(CubismMatrix44::Invert(m, actual));
+
+        for (csmInt32 i = 0; i < 16; ++i)
+        {
+            ASSERT_NEAR(expected[i], actual[i], 1.0e-5 * (1.0 + fabs(expected[i]))) << "matrix " << n << " element " << i;
+        }
+
+        // 元の行列との積は単位行列になる
+        csmFloat32 identity[16];
+        CubismMatrix44::Multiply(m, actual, identity);
+        for (csmInt32 i = 0; i < 16; ++i)
+        {
+            ASSERT_NEAR(i % 5 == 0 ? 1.0f : 0.0f, identity[i], 1.0e-4f) << "matrix " << n << " element " << i;
+        }
+    }
+}
+
+TEST(CubismMatrix44Test, InvertInPlace)
+{
+    RandomFloats random(4);
+
+    csmFloat32 m[16];
+    MakeTransform(random, m);
+
+    csmFloat32 expected[16];
+    ASSERT_TRUE(CubismMatrix44::Invert(m, expected));
+
+    ASSERT_TRUE(CubismMatrix44::Invert(m, m));
+    EXPECT_EQ(0, memcmp(expected, m, sizeof(expected)));
+}
+
+TEST(CubismMatrix44Test, InvertRejectsSingularMatrix)
+{
+    csmFloat32 singular[16] =
+    {
+        1.0f, 2.0f, 3.0f, 4.0f,
+        2.0f, 4.0f, 6.0f, 8.0f,
+        0.0f, 1.0f, 0.0f, 1.0f,
+        1.0f, 0.0f, 1.0f, 0.0f,
+    };
+
+    csmFloat32 dst[16];
+    for (csmInt32 i = 0; i < 16; ++i)
+    {
+        dst[i] = -1.0f;
+    }
+
+    EXPECT_FALSE(CubismMatrix44::Invert(singular, dst));
+    for (csmInt32 i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(-1.0f, dst[i]);
+    }
+
+    CubismMatrix44 matrix;
+    matrix.SetMatrix(singular);
+    const CubismMatrix44 inverse = matrix.GetInvert();
+    CubismMatrix44 identity;
+    EXPECT_EQ(0, memcmp(identity.GetArray(), const_cast<CubismMatrix44&>(inverse).GetArray(), sizeof(csmFloat32) * 16));
+}
+
+TEST(CubismMatrix44Test, TransformPointsMatchesScalarPath)
+{
+    RandomFloats random(5);
+
+    // SIMDの幅で割り切れない個数も含めて、端数処理を通す
+    for (csmInt32 pointCount = 0; pointCount <= 33; ++pointCount)
+    {
+        SCOPED_TRACE(pointCount);
+
+        csmFloat32 m[16];
+        MakeTransform(random, m);
+
+        std::vector<csmFloat32> src(pointCount * 2 + 1);
+        for (std::vector<csmFloat32>::size_type i = 0; i < src.size(); ++i)
+        {
+            src[i] = random.Next(2.0f);
+        }
+
+        std::vector<csmFloat32> expected(src.size());
+        for (csmInt32 i = 0; i < pointCount; ++i)
+        {
+            const csmFloat32 x = src[i * 2];
+            const csmFloat32 y = src[i * 2 + 1];
+            expected[i * 2] = m[0] * x + m[4] * y + m[12];
+            expected[i * 2 + 1] = m[1] * x + m[5] * y + m[13];
+        }
+
+        // 末尾の番兵は書き換えられない
+        const csmFloat32 sentinel = 12345.0f;
+        expected.back() = sentinel;
+        std::vector<csmFloat32> actual(src.size(), 0.0f);
+        actual.back() = sentinel;
+
+        CubismMatrix44::TransformPoints(m, &src[0], &actual[0], pointCount);
+        ASSERT_EQ(0, memcmp(&expected[0], &actual[0], sizeof(csmFloat32) * expected.size()));
+
+        // 同じ配列への書き出し
+        std::vector<csmFloat32> inPlace(src);
+        inPlace.back() = sentinel;
+        CubismMatrix44::TransformPoints(m, &inPlace[0], &inPlace[0], pointCount);
+        ASSERT_EQ(0, memcmp(&expected[0], &inPlace[0], sizeof(csmFloat32) * expected.size()));
+    }
+}
+
+TEST(CubismMatrix44Test, TransformPointsMatchesTransformXY)
+{
+    RandomFloats random(6);
+
+    CubismMatrix44 matrix;
+    matrix.Scale(1.5f, 0.75f);
+    matrix.Translate(0.25f, -0.5f);
+
+    const csmFloat32 src[] = { 0.0f, 0.0f, 1.0f, -1.0f, random.Next(3.0f), random.Next(3.0f) };
+    csmFloat32 dst[6];
+    matrix.TransformPoints(src, dst, 3);
+
+    for (csmInt32 i = 0; i < 3; ++i)
+    {
+        EXPECT_FLOAT_EQ(matrix.TransformX(src[i * 2]), dst[i * 2]);
+        EXPECT_FLOAT_EQ(matrix.TransformY(src[i * 2 + 1]), dst[i * 2 + 1]);
+    }
+}
@@ -0,0 +1,530 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <CubismFramework.hpp>
+#include <Id/CubismIdManager.hpp>
+#include <Model/CubismModel.hpp>
+#include "CubismTestModel.hpp"
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+const csmInt32 BatchCount = 20;
+const csmInt32 BatchSize = 64;
+
+/// xorshift32, so that the generated updates are the same on every run.
+class Random
+{
+public:
+    Random()
+        : _state(0x9E3779B9u)
+    { }
+
+    csmUint32 Next()
+    {
+        _state ^= _state << 13;
+        _state ^= _state >> 17;
+        _state ^= _state << 5;
+        return _state;
+    }
+
+    /// Uniform value in [minimum, maximum].
+    csmFloat32 Range(csmFloat32 minimum, csmFloat32 maximum)
+    {
+        return minimum + (maximum - minimum) * static_cast<csmFloat32>(Next() & 0xFFFF) / 65535.0f;
+    }
+
+private:
+    csmUint32 _state;
+};
+
+/// Random updates covering every operation, values outside the parameter range, partial weights,
+/// the same parameter several times in one batch, skipped entries and a parameter that is not in the model.
+std::vector<CubismModel::ParameterUpdate> CreateUpdates(Random& random, CubismModel* model, csmInt32 notExistIndex)
+{
+    std::vector<CubismModel::ParameterUpdate> updates(BatchSize);
+    const csmInt32 parameterCount = model->GetParameterCount();
+
+    for (csmInt32 i = 0; i < BatchSize; ++i)
+    {
+        CubismModel::ParameterUpdate& update = updates[i];
+
+        const csmUint32 target = random.Next() % 16;
+        if (target == 0)
+        {
+            update.Index = notExistIndex;
+        }
+        else if (target == 1 && i > 0)
+        {
+            update.Index = updates[i - 1].Index;
+        }
+        else
+        {
+            update.Index = static_cast<csmInt32>(random.Next() % static_cast<csmUint32>(parameterCount));
+        }
+
+        update.Operation = static_cast<csmInt32>(random.Next() % 3);
+
+        const csmFloat32 minimum = (update.Index < parameterCount) ? model->GetParameterMinimumValue(update.Index) : -1.0f;
+        const csmFloat32 maximum = (update.Index < parameterCount) ? model->GetParameterMaximumValue(update.Index) : 1.0f;
+        const csmFloat32 range = maximum - minimum;
+        switch (update.Operation)
+        {
+        case CubismModel::ParameterOperation_Add:
+            update.Value = random.Range(-range, range);
+            break;
+        case CubismModel::ParameterOperation_Multiply:
+            update.Value = random.Range(0.0f, 2.5f);
+            break;
+        default:
+            update.Value = random.Range(minimum - range * 0.5f, maximum + range * 0.5f);
+            break;
+        }
+
+        const csmUint32 weightKind = random.Next() % 4;
+        update.Weight = (weightKind < 2) ? 1.0f : random.Range(0.0f, 1.0f);
+    }
+
+    // 負のインデックスは読み飛ばす
+    updates[BatchSize / 2].Index = -1;
+
+    return updates;
+}
+
+/// Applies one update with the individual setters.
+void ApplyIndividually(CubismModel* model, const CubismModel::ParameterUpdate& update)
+{
+    if (update.Index < 0)
+    {
+        return;
+    }
+
+    switch (update.Operation)
+    {
+    case CubismModel::ParameterOperation_Add:
+        model->AddParameterValue(update.Index, update.Value, update.Weight);
+        break;
+    case CubismModel::ParameterOperation_Multiply:
+        model->MultiplyParameterValue(update.Index, update.Value, update.Weight);
+        break;
+    default:
+        model->SetParameterValue(update.Index, update.Value, update.Weight);
+        break;
+    }
+}
+
+/// Values of the first parameter and part that the changes below start from and move to.
+struct ChangeValues
+{
+    csmFloat32 From;
+    csmFloat32 To;
+};
+
+ChangeValues GetParameterChangeValues(CubismModel* model)
+{
+    const csmFloat32 minimum = model->GetParameterMinimumValue(0);
+    const csmFloat32 range = model->GetParameterMaximumValue(0) - minimum;
+
+    ChangeValues values;
+    values.From = minimum + range * 0.3f;
+    values.To = minimum + range * 0.7f;
+    return values;
+}
+
+/// A way of changing the first parameter or part, run after the model has been updated from GetParameterChangeValues().From
+/// and an opacity of 0.5 for the first part.
+struct ModelChange
+{
+    const csmChar* Name;
+    void (*Apply)(CubismModel* model, const ChangeValues& values);
+};
+
+void SetParameterByIndex(CubismModel* model, const ChangeValues& values)
+{
+    model->SetParameterValue(0, values.To);
+}
+
+void SetParameterById(CubismModel* model, const ChangeValues& values)
+{
+    model->SetParameterValue(model->GetParameterId(0), values.To);
+}
+
+void AddParameterByIndex(CubismModel* model, const ChangeValues& values)
+{
+    model->AddParameterValue(0, values.To - values.From);
+}
+
+void AddParameterById(CubismModel* model, const ChangeValues& values)
+{
+    model->AddParameterValue(model->GetParameterId(0), values.To - values.From);
+}
+
+void MultiplyParameterByIndex(CubismModel* model, const ChangeValues& values)
+{
+    model->MultiplyParameterValue(0, values.To / values.From);
+}
+
+void MultiplyParameterById(CubismModel* model, const ChangeValues& values)
+{
+    model->MultiplyParameterValue(model->GetParameterId(0), values.To / values.From);
+}
+
+void SetPartOpacityByIndex(CubismModel* model, const ChangeValues& values)
+{
+    model->SetPartOpacity(0, 1.0f);
+}
+
+void SetPartOpacityById(CubismModel* model, const ChangeValues& values)
+{
+    model->SetPartOpacity(model->GetPartId(0), 1.0f);
+}
+
+/// Updates the model with another value, and then loads the saved one back.
+void LoadSavedParameters(CubismModel* model, const ChangeValues& values)
+{
+    model->SaveParameters();
+    model->SetParameterValue(0, values.To);
+    model->Update();
+    model->LoadParameters();
+}
+
+/// Updates the model with another value, and then restores the captured one.
+void RestoreCapturedParameters(CubismModel* model, const ChangeValues& values)
+{
+    std::vector<csmFloat32> snapshot(model->GetParameterCount());
+    model->CaptureParameters(&snapshot[0]);
+    model->SetParameterValue(0, values.To);
+    model->Update();
+    model->RestoreParameters(&snapshot[0]);
+}
+
+void ApplyParameterDiff(CubismModel* model, const ChangeValues& values)
+{
+    CubismModel::ParameterDiff diff;
+    diff.Index = 0;
+    diff.Value = values.To;
+    model->ApplyParameterDiffs(&diff, 1);
+}
+
+void ApplyParameterUpdate(CubismModel* model, const ChangeValues& values)
+{
+    CubismModel::ParameterUpdate update;
+    update.Index = 0;
+    update.Operation = CubismModel::ParameterOperation_Set;
+    update.Value = values.To;
+    update.Weight = 1.0f;
+    model->ApplyParameterUpdates(&update, 1);
+}
+
+const ModelChange ModelChanges[] = {
+    { "SetParameterValue(index)", SetParameterByIndex },
+    { "SetParameterValue(id)", SetParameterById },
+    { "AddParameterValue(index)", AddParameterByIndex },
+    { "AddParameterValue(id)", AddParameterById },
+    { "MultiplyParameterValue(index)", MultiplyParameterByIndex },
+    { "MultiplyParameterValue(id)", MultiplyParameterById },
+    { "SetPartOpacity(index)", SetPartOpacityByIndex },
+    { "SetPartOpacity(id)", SetPartOpacityById },
+    { "LoadParameters", LoadSavedParameters },
+    { "RestoreParameters", RestoreCapturedParameters },
+    { "ApplyParameterDiffs", ApplyParameterDiff },
+    { "ApplyParameterUpdates", ApplyParameterUpdate },
+};
+
+/// Writes that leave the first parameter and part as they are.
+const ModelChange ModelNoChanges[] = {
+    { "SetParameterValue(index)", SetParameterByIndex },
+    { "AddParameterValue(index)", AddParameterByIndex },
+    { "MultiplyParameterValue(index)", MultiplyParameterByIndex },
+    { "ApplyParameterDiffs", ApplyParameterDiff },
+    { "ApplyParameterUpdates", ApplyParameterUpdate },
+};
+
+/// Sets the starting values of ModelChange and updates the model until the next update is skipped.
+void PrepareChange(CubismModel* model, const ChangeValues& values)
+{
+    model->SetParameterValue(0, values.From);
+    model->SetPartOpacity(0, 0.5f);
+    model->Update();
+    model->Update();
+}
+
+/// Whether any parameter value differs between the two snapshots.
+bool HasDifference(const std::vector<csmFloat32>& before, const std::vector<csmFloat32>& after)
+{
+    for (std::vector<csmFloat32>::size_type i = 0; i < before.size(); ++i)
+    {
+        if (before[i] != after[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+class CubismModelTest : public ::testing::TestWithParam<CubismTest::BundledModel>
+{
+protected:
+    void LoadModel(CubismTest::TestModel& model)
+    {
+        ASSERT_TRUE(model.LoadAssets(GetParam())) << "Failed to load " << GetParam().Name;
+    }
+};
+
+}
+
+TEST_P(CubismModelTest, ApplyParameterUpdatesMatchesIndividualSetters)
+{
+    CubismTest::TestModel individualModel;
+    CubismTest::TestModel batchedModel;
+    LoadModel(individualModel);
+    LoadModel(batchedModel);
+    ASSERT_FALSE(HasFatalFailure());
+
+    CubismModel* individual = individualModel.GetModel();
+    CubismModel* batched = batchedModel.GetModel();
+
+    // モデルに存在しないIDは、どちらのモデルでも同じインデックスになる
+    const CubismIdHandle notExistId = CubismFramework::GetIdManager()->GetId("ParamNotInModel");
+    const csmInt32 notExistIndex = individual->GetParameterIndex(notExistId);
+    ASSERT_EQ(notExistIndex, batched->GetParameterIndex(notExistId));
+    ASSERT_GE(notExistIndex, individual->GetParameterCount());
+
+    Random random;
+    for (csmInt32 batch = 0; batch < BatchCount; ++batch)
+    {
+        const std::vector<CubismModel::ParameterUpdate> updates = CreateUpdates(random, individual, notExistIndex);
+
+        for (csmInt32 i = 0; i < BatchSize; ++i)
+        {
+            ApplyIndividually(individual, updates[i]);
+        }
+        batched->ApplyParameterUpdates(&updates[0], BatchSize);
+
+        for (csmInt32 i = 0; i < individual->GetParameterCount(); ++i)
+        {
+            ASSERT_EQ(individual->GetParameterValue(i), batched->GetParameterValue(i)) << "batch " << batch << " parameter " << i;
+
+            // 範囲外の値は個別の設定と同じく範囲内に収める
+            ASSERT_GE(batched->GetParameterValue(i), batched->GetParameterMinimumValue(i));
+            ASSERT_LE(batched->GetParameterValue(i), batched->GetParameterMaximumValue(i));
+        }
+        ASSERT_EQ(individual->GetParameterValue(notExistIndex), batched->GetParameterValue(notExistIndex)) << "batch " << batch;
+    }
+}
+
+TEST_P(CubismModelTest, ParameterDiffsReproduceSetterResults)
+{
+    CubismTest::TestModel sourceModel;
+    CubismTest::TestModel targetModel;
+    LoadModel(sourceModel);
+    LoadModel(targetModel);
+    ASSERT_FALSE(HasFatalFailure());
+
+    CubismModel* source = sourceModel.GetModel();
+    CubismModel* target = targetModel.GetModel();
+    const csmInt32 parameterCount = source->GetParameterCount();
+    const csmInt32 notExistIndex = source->GetParameterIndex(CubismFramework::GetIdManager()->GetId("ParamNotInModel"));
+
+    std::vector<csmFloat32> initialValues(parameterCount);
+    source->CaptureParameters(&initialValues[0]);
+    for (csmInt32 i = 0; i < parameterCount; ++i)
+    {
+        ASSERT_EQ(source->GetParameterValue(i), initialValues[i]);
+    }
+
+    Random random;
+    for (csmInt32 batch = 0; batch < BatchCount; ++batch)
+    {
+        std::vector<csmFloat32> snapshot(parameterCount);
+        source->CaptureParameters(&snapshot[0]);
+
+        const std::vector<CubismModel::ParameterUpdate> updates = CreateUpdates(random, source, notExistIndex);
+        for (csmInt32 i = 0; i < BatchSize; ++i)
+        {
+            ApplyIndividually(source, updates[i]);
+        }
+
+        // 変化したパラメータだけが差分に含まれる
+        std::vector<CubismModel::ParameterDiff> diffs(parameterCount);
+        const csmInt32 diffCount = source->DiffParameters(&snapshot[0], 0.0f, &diffs[0]);
+        csmInt32 changedCount = 0;
+        for (csmInt32 i = 0; i < parameterCount; ++i)
+        {
+            changedCount += (source->GetParameterValue(i) != snapshot[i]) ? 1 : 0;
+        }
+        ASSERT_EQ(changedCount, diffCount) << "batch " << batch;
+
+        // 差分を適用すると、同じ状態から始めたもう1体が同じ値になる
+        target->ApplyParameterDiffs(&diffs[0], diffCount);
+        for (csmInt32 i = 0; i < parameterCount; ++i)
+        {
+            ASSERT_EQ(source->GetParameterValue(i), target->GetParameterValue(i)) << "batch " << batch << " parameter " << i;
+        }
+    }
+
+    // 閾値以下の差は含めない
+    std::vector<csmFloat32> snapshot(parameterCount);
+    source->CaptureParameters(&snapshot[0]);
+    const csmFloat32 range = source->GetParameterMaximumValue(0) - source->GetParameterMinimumValue(0);
+    const csmFloat32 smallValue = source->GetParameterMinimumValue(0) + range * 0.5f;
+    snapshot[0] = smallValue;
+    source->SetParameterValue(0, smallValue + range * 0.001f);
+    std::vector<CubismModel::ParameterDiff> diffs(parameterCount);
+    EXPECT_EQ(0, source->DiffParameters(&snapshot[0], range * 0.01f, &diffs[0]));
+    ASSERT_EQ(1, source->DiffParameters(&snapshot[0], range * 0.0001f, &diffs[0]));
+    EXPECT_EQ(0, diffs[0].Index);
+    EXPECT_EQ(source->GetParameterValue(0), diffs[0].Value);
+
+    // 復元すると最初の状態に戻り、SetParameterValueで同じ値を設定した場合と同じになる
+    source->RestoreParameters(&initialValues[0]);
+    for (csmInt32 i = 0; i < parameterCount; ++i)
+    {
+        target->SetParameterValue(i, initialValues[i]);
+    }
+    for (csmInt32 i = 0; i < parameterCount; ++i)
+    {
+        EXPECT_EQ(initialValues[i], source->GetParameterValue(i)) << "parameter " << i;
+        EXPECT_EQ(target->GetParameterValue(i), source->GetParameterValue(i)) << "parameter " << i;
+    }
+}
+
+TEST_P(CubismModelTest, RestoreParametersDoesNotClamp)
+{
+    CubismTest::TestModel testModel;
+    LoadModel(testModel);
+    ASSERT_FALSE(HasFatalFailure());
+
+    CubismModel* model = testModel.GetModel();
+    const csmInt32 parameterCount = model->GetParameterCount();
+
+    std::vector<csmFloat32> values(parameterCount);
+    model->CaptureParameters(&values[0]);
+    values[0] = model->GetParameterMaximumValue(0) + 1.0f;
+
+    // 復元は値をそのまま書き込み、SetParameterValueは範囲内に収める
+    model->RestoreParameters(&values[0]);
+    EXPECT_EQ(values[0], model->GetParameterValue(0));
+
+    model->SetParameterValue(0, values[0]);
+    EXPECT_EQ(model->GetParameterMaximumValue(0), model->GetParameterValue(0));
+}
+
+TEST_P(CubismModelTest, ChangesClearUpdateSkip)
+{
+    CubismTest::TestModel testModel;
+    LoadModel(testModel);
+    ASSERT_FALSE(HasFatalFailure());
+
+    CubismModel* model = testModel.GetModel();
+    const ChangeValues values = GetParameterChangeValues(model);
+    ASSERT_NE(0.0f, values.From);
+
+    for (csmUint32 i = 0; i < sizeof(ModelChanges) / sizeof(ModelChanges[0]); ++i)
+    {
+        SCOPED_TRACE(ModelChanges[i].Name);
+        PrepareChange(model, values);
+        ASSERT_TRUE(model->IsUpdateSkipped());
+
+        // 値が変わったら次の更新は省略しない
+        ModelChanges[i].Apply(model, values);
+        model->Update();
+        EXPECT_FALSE(model->IsUpdateSkipped());
+
+        // 変わらなければ、その次の更新は省略する
+        model->Update();
+        EXPECT_TRUE(model->IsUpdateSkipped());
+    }
+}
+
+TEST_P(CubismModelTest, UnchangedValuesKeepUpdateSkip)
+{
+    CubismTest::TestModel testModel;
+    LoadModel(testModel);
+    ASSERT_FALSE(HasFatalFailure());
+
+    CubismModel* model = testModel.GetModel();
+    ChangeValues values = GetParameterChangeValues(model);
+    ASSERT_NE(0.0f, values.From);
+
+    // 現在と同じ値を書き込んでも更新は省略したままにする
+    for (csmUint32 i = 0; i < sizeof(ModelNoChanges) / sizeof(ModelNoChanges[0]); ++i)
+    {
+        SCOPED_TRACE(ModelNoChanges[i].Name);
+        PrepareChange(model, values);
+
+        ChangeValues sameValues;
+        sameValues.From = values.From;
+        sameValues.To = values.From;
+        ModelNoChanges[i].Apply(model, sameValues);
+        model->SetPartOpacity(0, 0.5f);
+        model->Update();
+        EXPECT_TRUE(model->IsUpdateSkipped());
+    }
+}
+
+TEST_P(CubismModelTest, PhysicsOutputsClearUpdateSkip)
+{
+    CubismTest::TestModel testModel;
+    LoadModel(testModel);
+    ASSERT_FALSE(HasFatalFailure());
+
+    CubismPhysics* physics = testModel.GetPhysics();
+    if (physics == NULL)
+    {
+        GTEST_SKIP() << "The model has no physics.";
+    }
+
+    CubismModel* model = testModel.GetModel();
+    const csmInt32 parameterCount = model->GetParameterCount();
+    std::vector<csmFloat32> before(parameterCount);
+    std::vector<csmFloat32> after(parameterCount);
+
+    // 入力を動かした分の更新を済ませてから物理演算を実行し、物理演算がパラメータへ直接書き込んだ分だけで判定する
+    csmInt32 changedStepCount = 0;
+    for (csmInt32 step = 0; step < 30; ++step)
+    {
+        SCOPED_TRACE(step);
+        for (csmInt32 i = 0; i < parameterCount; ++i)
+        {
+            model->SetParameterValue(i, (step % 10 < 5) ? model->GetParameterMaximumValue(i) : model->GetParameterMinimumValue(i));
+        }
+        model->Update();
+        model->Update();
+        ASSERT_TRUE(model->IsUpdateSkipped());
+
+        model->CaptureParameters(&before[0]);
+        if (step == 0)
+        {
+            physics->Stabilization(model);
+        }
+        else
+        {
+            physics->Evaluate(model, 1.0f / 30.0f);
+        }
+        model->CaptureParameters(&after[0]);
+
+        model->Update();
+        if (HasDifference(before, after))
+        {
+            EXPECT_FALSE(model->IsUpdateSkipped());
+            ++changedStepCount;
+        }
+        else
+        {
+            EXPECT_TRUE(model->IsUpdateSkipped());
+        }
+    }
+
+    // 物理演算の出力で値が変わる場合を含んでいること
+    EXPECT_GT(changedStepCount, 10);
+}
+
+INSTANTIATE_TEST_SUITE_P(BundledModels, CubismModelTest, ::testing::ValuesIn(CubismTest::GetBundledModels()), CubismTest::BundledModelName());
@@ -0,0 +1,603 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <Motion/CubismMotion.hpp>
+#include <Motion/CubismMotionInternal.hpp>
+#include <Motion/CubismMotionJson.hpp>
+#include <Motion/CubismMotionManager.hpp>
+#include <Motion/CubismMotionQueueEntry.hpp>
+#include <Motion/CubismExpressionMotionManager.hpp>
+#include "CubismTestModel.hpp"
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+const csmInt32 FrameCount = 300;
+const csmFloat32 DeltaTime = 1.0f / 30.0f;
+
+/// One-second looping motion with two user data events, for checking that events are tracked per playback.
+/// The framework's JSON parser expects every number to be followed by a newline or a comma, as in the exported files.
+const csmChar* EventMotionJson =
+    "{\n"
+    "\"Version\": 3,\n"
+    "\"Meta\": {\n"
+    "\"Duration\": 1.0,\n"
+    "\"Fps\": 30.0,\n"
+    "\"Loop\": true,\n"
+    "\"AreBeziersRestricted\": true,\n"
+    "\"CurveCount\": 1,\n"
+    "\"TotalSegmentCount\": 1,\n"
+    "\"TotalPointCount\": 2,\n"
+    "\"UserDataCount\": 2,\n"
+    "\"TotalUserDataSize\": 2\n"
+    "},\n"
+    "\"Curves\": [ { \"Target\": \"Parameter\", \"Id\": \"ParamAngleX\", \"Segments\": [ 0, 0, 0, 1, 30\n] } ],\n"
+    "\"UserData\": [ { \"Time\": 0.25,\n\"Value\": \"a\" }, { \"Time\": 0.75,\n\"Value\": \"b\" } ]\n"
+    "}\n";
+
+void RecordEvent(const CubismMotionQueueManager* caller, const csmString& eventValue, void* customData)
+{
+    static_cast<std::vector<std::string>*>(customData)->push_back(eventValue.GetRawString());
+}
+
+/// One second looped motion whose events are out of order in the file, share a timestamp,
+/// and lie close to both ends of the loop, including the extra frame of MotionBehavior_V2.
+const csmChar* EventCursorMotionJson =
+    "{\n"
+    "\"Version\": 3,\n"
+    "\"Meta\": {\n"
+    "\"Duration\": 1.0,\n"
+    "\"Fps\": 30.0,\n"
+    "\"Loop\": true,\n"
+    "\"AreBeziersRestricted\": true,\n"
+    "\"CurveCount\": 1,\n"
+    "\"TotalSegmentCount\": 1,\n"
+    "\"TotalPointCount\": 2,\n"
+    "\"UserDataCount\": 7,\n"
+    "\"TotalUserDataSize\": 20\n"
+    "},\n"
+    "\"Curves\": [ { \"Target\": \"Parameter\", \"Id\": \"ParamAngleX\", \"Segments\": [ 0, 0, 0, 1, 30\n] } ],\n"
+    "\"UserData\": [ { \"Time\": 0.05,\n\"Value\": \"start\" }, { \"Time\": 0.5,\n\"Value\": \"b1\" }, { \"Time\": 0.25,\n\"Value\": \"a\" },\n"
+    "{ \"Time\": 0.5,\n\"Value\": \"b2\" }, { \"Time\": 0.5,\n\"Value\": \"b3\" }, { \"Time\": 0.95,\n\"Value\": \"end1\" }, { \"Time\": 1.0,\n\"Value\": \"end2\" } ]\n"
+    "}\n";
+
+/// Values of the events of EventCursorMotionJson in firing order.
+const csmChar* EventCursorValues[] = { "start", "a", "b1", "b2", "b3", "end1", "end2" };
+const csmInt32 EventCursorEventCount = sizeof(EventCursorValues) / sizeof(EventCursorValues[0]);
+
+/// Events a linear scan over the events of EventCursorMotionJson fires for the interval (beforeCheckTimeSeconds, motionTimeSeconds].
+/// The fire times are read back from the file, so that they are rounded the same way as those the motion parses.
+std::vector<std::string> ScanEvents(csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds)
+{
+    CubismMotionJson json(reinterpret_cast<const csmByte*>(EventCursorMotionJson), static_cast<csmSizeInt>(strlen(EventCursorMotionJson)));
+
+    std::vector<std::string> events;
+    for (csmInt32 i = 0; i < EventCursorEventCount; ++i)
+    {
+        for (csmInt32 j = 0; j < json.GetEventCount(); ++j)
+        {
+            if (strcmp(json.GetEventValue(j), EventCursorValues[i]) != 0)
+            {
+                continue;
+            }
+
+            if (json.GetEventTime(j) > beforeCheckTimeSeconds && json.GetEventTime(j) <= motionTimeSeconds)
+            {
+                events.push_back(EventCursorValues[i]);
+            }
+        }
+    }
+    return events;
+}
+
+/// Events the motion fires for the interval, tracked by the cursor of the entry.
+std::vector<std::string> FireEvents(CubismMotion* motion, CubismMotionQueueEntry& entry, csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds)
+{
+    const csmVector<const csmString*>& fired = motion->GetFiredEvent(&entry, beforeCheckTimeSeconds, motionTimeSeconds);
+
+    std::vector<std::string> events;
+    for (csmUint32 i = 0; i < fired.GetSize(); ++i)
+    {
+        events.push_back(fired[i]->GetRawString());
+    }
+    return events;
+}
+
+/// Events of the given number of whole loops, followed by the events of the last loop up to motionTimeSeconds.
+std::vector<std::string> LoopEvents(csmInt32 loopCount, csmFloat32 motionTimeSeconds)
+{
+    std::vector<std::string> events;
+    for (csmInt32 loop = 0; loop < loopCount; ++loop)
+    {
+        events.insert(events.end(), EventCursorValues, EventCursorValues + EventCursorEventCount);
+    }
+    const std::vector<std::string> rest = ScanEvents(0.0f, motionTimeSeconds);
+    events.insert(events.end(), rest.begin(), rest.end());
+    return events;
+}
+
+CubismMotion* CreateEventCursorMotion()
+{
+    return CubismMotion::Create(reinterpret_cast<const csmByte*>(EventCursorMotionJson), static_cast<csmSizeInt>(strlen(EventCursorMotionJson)));
+}
+
+/// Samples taken in each Bezier segment when comparing evaluators.
+const csmInt32 BezierSampleCount = 64;
+
+/// Handle lengths, as a fraction of the segment duration, of the reshaped copies of each Bezier segment.
+/// Handles of zero length are left out, because the Cardano solve picks the wrong root at the ends of such segments.
+const csmFloat32 BezierHandleVariants[] = { 0.05f, 0.3f, 0.6f };
+const csmUint32 BezierHandleVariantCount = sizeof(BezierHandleVariants) / sizeof(BezierHandleVariants[0]) + 1;
+
+/// Largest difference from the previous evaluators allowed for the precomputed polynomial, relative to the value span of the segment.
+/// Restricted Beziers use the same t and only differ by rounding. Unrestricted ones also differ by the error of the Cardano solve,
+/// which stays below 1e-4 of the span on the bundled motions and their reshaped copies.
+const csmFloat32 RestrictedBezierTolerance = 1.0e-5f;
+const csmFloat32 CardanoBezierTolerance = 1.0e-4f;
+
+/// The bisection stops within 0.01 seconds of the time, so its value is compared against the values the curve takes over that interval.
+const csmFloat32 BisectionTimeTolerance = 0.01f;
+const csmInt32 BisectionWindowSampleCount = 8;
+
+/// Control points of a Bezier segment of a motion file.
+struct BezierSegment
+{
+    CubismMotionPoint Points[4];
+};
+
+/// Collects the Bezier segments of every motion of a model.
+std::vector<BezierSegment> LoadBezierSegments(const CubismTest::TestModel& model)
+{
+    std::vector<BezierSegment> segments;
+    ICubismModelSetting* setting = model.GetModelSetting();
+
+    for (csmInt32 group = 0; group < setting->GetMotionGroupCount(); ++group)
+    {
+        const csmChar* groupName = setting->GetMotionGroupName(group);
+        for (csmInt32 motion = 0; motion < setting->GetMotionCount(groupName); ++motion)
+        {
+            std::vector<csmByte> file;
+            if (!model.LoadRelativeFile(setting->GetMotionFileName(groupName, motion), file) || file.empty())
+            {
+                continue;
+            }
+
+            CubismMotionJson json(&file[0], static_cast<csmSizeInt>(file.size()));
+
+            for (csmInt32 curve = 0; curve < json.GetMotionCurveCount(); ++curve)
+            {
+                CubismMotionPoint last;
+                last.Time = json.GetMotionCurveSegment(curve, 0);
+                last.Value = json.GetMotionCurveSegment(curve, 1);
+
+                for (csmInt32 position = 2; position < json.GetMotionCurveSegmentCount(curve);)
+                {
+                    const csmInt32 type = static_cast<csmInt32>(json.GetMotionCurveSegment(curve, position));
+                    const csmInt32 pointCount = (type == CubismMotionSegmentType_Bezier) ? 3 : 1;
+
+                    BezierSegment segment;
+                    segment.Points[0] = last;
+                    for (csmInt32 i = 0; i < pointCount; ++i)
+                    {
+                        segment.Points[i + 1].Time = json.GetMotionCurveSegment(curve, position + 1 + i * 2);
+                        segment.Points[i + 1].Value = json.GetMotionCurveSegment(curve, position + 2 + i * 2);
+                    }
+
+                    if (type == CubismMotionSegmentType_Bezier)
+                    {
+                        segments.push_back(segment);
+                    }
+
+                    last = segment.Points[pointCount];
+                    position += 1 + pointCount * 2;
+                }
+            }
+        }
+    }
+
+    return segments;
+}
+
+/// Number of calls of each motion handler below.
+csmInt32 s_firstBeganCount;
+csmInt32 s_firstFinishedCount;
+csmInt32 s_secondBeganCount;
+csmInt32 s_secondFinishedCount;
+
+void CountFirstBegan(ACubismMotion* self) { ++s_firstBeganCount; }
+void CountFirstFinished(ACubismMotion* self) { ++s_firstFinishedCount; }
+void CountSecondBegan(ACubismMotion* self) { ++s_secondBeganCount; }
+void CountSecondFinished(ACubismMotion* self) { ++s_secondFinishedCount; }
+
+class CubismMotionTest : public ::testing::TestWithParam<CubismTest::BundledModel>
+{
+protected:
+    /// Loads the bundled model and optionally bakes its first motion.
+    void LoadModel(CubismTest::TestModel& model, csmBool bake)
+    {
+        const CubismTest::BundledModel& bundledModel = GetParam();
+        ASSERT_TRUE(model.LoadAssets(bundledModel)) << "Failed to load " << bundledModel.Name;
+
+        if (bake && model.GetMotionCount() > 0)
+        {
+            static_cast<CubismMotion*>(model.GetMotion(0))->Bake(0.0f, -1.0f);
+        }
+    }
+};
+
+}
+
+TEST_P(CubismMotionTest, SharedMotionMatchesOwnMotion)
+{
+    for (csmInt32 bake = 0; bake < 2; ++bake)
+    {
+        SCOPED_TRACE(bake ? "baked" : "analytic");
+
+        CubismTest::TestModel sourceModel;
+        CubismTest::TestModel sharingModel;
+        CubismTest::TestModel owningModel;
+        LoadModel(sourceModel, bake != 0);
+        LoadModel(sharingModel, bake != 0);
+        LoadModel(owningModel, bake != 0);
+        ASSERT_FALSE(HasFatalFailure());
+        if (sourceModel.GetMotionCount() == 0)
+        {
+            GTEST_SKIP() << "The model has no motions.";
+        }
+
+        ACubismMotion* sharedMotion = sourceModel.GetMotion(0);
+        ACubismMotion* ownMotion = owningModel.GetMotion(0);
+
+        // 共有元は先に再生を始め、再生位置をずらしておく
+        sourceModel.StartMotion(0);
+        for (csmInt32 frame = 0; frame < 20; ++frame)
+        {
+            sourceModel.UpdateSimulation(DeltaTime);
+        }
+
+        sharingModel.GetMotionManager()->StartMotionPriority(sharedMotion, false, 2);
+        owningModel.StartMotion(0);
+        if (sourceModel.GetExpressionCount() > 0)
+        {
+            sourceModel.SetExpression(0);
+            sharingModel.GetExpressionManager()->StartMotion(sourceModel.GetExpression(0), false);
+            owningModel.SetExpression(0);
+        }
+
+        for (csmInt32 frame = 0; frame < FrameCount; ++frame)
+        {
+            // 再生中にループへ切り替えると、共有している全ての再生で終了時刻を計算し直す
+            if (frame == 10)
+            {
+                sharedMotion->SetLoop(true);
+                ownMotion->SetLoop(true);
+            }
+
+            sourceModel.UpdateSimulation(DeltaTime);
+            sharingModel.UpdateSimulation(DeltaTime);
+            owningModel.UpdateSimulation(DeltaTime);
+
+            CubismModel* sharing = sharingModel.GetModel();
+            CubismModel* owning = owningModel.GetModel();
+            for (csmInt32 i = 0; i < sharing->GetParameterCount(); ++i)
+            {
+                ASSERT_EQ(owning->GetParameterValue(i), sharing->GetParameterValue(i)) << "frame " << frame << " parameter " << sharing->GetParameterId(i)->GetString().GetRawString();
+            }
+        }
+
+        EXPECT_FALSE(sharingModel.GetMotionManager()->IsFinished());
+    }
+}
+
+TEST_P(CubismMotionTest, BezierCoefficientsMatchPreviousEvaluators)
+{
+    CubismTest::TestModel model;
+    LoadModel(model, false);
+    ASSERT_FALSE(HasFatalFailure());
+
+    const std::vector<BezierSegment> segments = LoadBezierSegments(model);
+    if (segments.empty())
+    {
+        GTEST_SKIP() << "The model has no Bezier segments.";
+    }
+
+    // ファイルの評価方法によらず、全ての区間を両方の方法で評価する。
+    // 同梱モーションの制御点は時間方向にほぼ等間隔なので、制御点の時刻を動かして時間が非線形になる曲線も評価する
+    for (csmUint32 c = 0; c < segments.size() * BezierHandleVariantCount; ++c)
+    {
+        const std::vector<BezierSegment>::size_type s = c / BezierHandleVariantCount;
+        CubismMotionPoint points[4];
+        memcpy(points, segments[s].Points, sizeof(points));
+        if (c % BezierHandleVariantCount != 0)
+        {
+            const csmFloat32 handle = BezierHandleVariants[c % BezierHandleVariantCount - 1];
+            points[1].Time = points[0].Time + (points[3].Time - points[0].Time) * handle;
+            points[2].Time = points[3].Time - (points[3].Time - points[0].Time) * handle;
+        }
+        const CubismMotionBezier restricted = CreateBezier(points, true);
+        const CubismMotionBezier unrestricted = CreateBezier(points, false);
+
+        csmFloat32 minimum = points[0].Value;
+        csmFloat32 maximum = points[0].Value;
+        for (csmInt32 i = 1; i < 4; ++i)
+        {
+            minimum = (points[i].Value < minimum) ? points[i].Value : minimum;
+            maximum = (points[i].Value > maximum) ? points[i].Value : maximum;
+        }
+        const csmFloat32 span = (maximum - minimum > 1.0f) ? maximum - minimum : 1.0f;
+        const csmFloat32 duration = points[3].Time - points[0].Time;
+
+        for (csmInt32 i = 0; i <= BezierSampleCount; ++i)
+        {
+            const csmFloat32 time = points[0].Time + duration * static_cast<csmFloat32>(i) / static_cast<csmFloat32>(BezierSampleCount);
+
+            const csmFloat32 restrictedValue = BezierEvaluateCoefficients(restricted, time);
+            const csmFloat32 restrictedPrevious = BezierEvaluate(points, time);
+            ASSERT_LE(fabsf(restrictedValue - restrictedPrevious) / span, RestrictedBezierTolerance)
+                << "segment " << s << " time " << time << " value " << restrictedValue << " previous " << restrictedPrevious;
+
+            const csmFloat32 value = BezierEvaluateCoefficients(unrestricted, time);
+            const csmFloat32 cardano = BezierEvaluateCardanoInterpretation(points, time);
+            ASSERT_LE(fabsf(value - cardano) / span, CardanoBezierTolerance)
+                << "segment " << s << " variant " << c % BezierHandleVariantCount << " time " << time << " value " << value << " cardano " << cardano;
+
+            // 二分法の値は、時刻の誤差の範囲で曲線が取る値に収まる
+            csmFloat32 windowMinimum = value;
+            csmFloat32 windowMaximum = value;
+            for (csmInt32 j = -BisectionWindowSampleCount; j <= BisectionWindowSampleCount; ++j)
+            {
+                csmFloat32 windowTime = time + BisectionTimeTolerance * static_cast<csmFloat32>(j) / static_cast<csmFloat32>(BisectionWindowSampleCount);
+                windowTime = (windowTime < points[0].Time) ? points[0].Time : (windowTime > points[3].Time) ? points[3].Time : windowTime;
+                const csmFloat32 windowValue = BezierEvaluateCoefficients(unrestricted, windowTime);
+                windowMinimum = (windowValue < windowMinimum) ? windowValue : windowMinimum;
+                windowMaximum = (windowValue > windowMaximum) ? windowValue : windowMaximum;
+            }
+
+            const csmFloat32 bisection = BezierEvaluateBinarySearch(points, time);
+            ASSERT_GE(bisection, windowMinimum - CardanoBezierTolerance * span)
+                << "segment " << s << " variant " << c % BezierHandleVariantCount << " time " << time << " value " << value << " bisection " << bisection;
+            ASSERT_LE(bisection, windowMaximum + CardanoBezierTolerance * span)
+                << "segment " << s << " variant " << c % BezierHandleVariantCount << " time " << time << " value " << value << " bisection " << bisection;
+        }
+    }
+}
+
+TEST(CubismMotionSharingTest, EventsAreTrackedPerPlayback)
+{
+    CubismTest::TestModel firstModel;
+    CubismTest::TestModel secondModel;
+    ASSERT_TRUE(firstModel.LoadAssets(CubismTest::GetBundledModels()[0]));
+    ASSERT_TRUE(secondModel.LoadAssets(CubismTest::GetBundledModels()[0]));
+
+    CubismMotion* motion = CubismMotion::Create(reinterpret_cast<const csmByte*>(EventMotionJson), static_cast<csmSizeInt>(strlen(EventMotionJson)));
+    ASSERT_TRUE(motion != NULL);
+    motion->SetLoop(true);
+
+    std::vector<std::string> firstEvents;
+    std::vector<std::string> secondEvents;
+    firstModel.GetMotionManager()->SetEventCallback(RecordEvent, &firstEvents);
+    secondModel.GetMotionManager()->SetEventCallback(RecordEvent, &secondEvents);
+
+    // 同じモーションを、再生位置をずらして2体で再生する
+    firstModel.GetMotionManager()->StartMotionPriority(motion, false, 2);
+    for (csmInt32 frame = 0; frame < 90; ++frame)
+    {
+        if (frame == 10)
+        {
+            secondModel.GetMotionManager()->StartMotionPriority(motion, false, 2);
+        }
+
+        firstModel.UpdateSimulation(DeltaTime);
+        secondModel.UpdateSimulation(DeltaTime);
+    }
+
+    // それぞれの再生でイベントが1回ずつ順番に発火する
+    ASSERT_GE(firstEvents.size(), 5u);
+    ASSERT_GE(secondEvents.size(), 4u);
+    EXPECT_LE(secondEvents.size(), firstEvents.size());
+    for (std::vector<std::string>::size_type i = 0; i < firstEvents.size(); ++i)
+    {
+        EXPECT_EQ(i % 2 == 0 ? "a" : "b", firstEvents[i]) << "event " << i;
+    }
+    for (std::vector<std::string>::size_type i = 0; i < secondEvents.size(); ++i)
+    {
+        EXPECT_EQ(i % 2 == 0 ? "a" : "b", secondEvents[i]) << "event " << i;
+    }
+
+    firstModel.GetMotionManager()->StopAllMotions();
+    secondModel.GetMotionManager()->StopAllMotions();
+    ACubismMotion::Delete(motion);
+}
+
+TEST(CubismMotionEventTest, EqualTimestampsFireOnceInFileOrder)
+{
+    CubismMotion* motion = CreateEventCursorMotion();
+    ASSERT_TRUE(motion != NULL);
+    CubismMotionQueueEntry entry;
+
+    // 同じ時刻のイベントはファイルの順に、まとめて発火する
+    EXPECT_EQ(ScanEvents(0.0f, 0.4f), FireEvents(motion, entry, 0.0f, 0.4f));
+    EXPECT_EQ(ScanEvents(0.4f, 0.5f), FireEvents(motion, entry, 0.4f, 0.5f));
+    ASSERT_EQ(3u, ScanEvents(0.4f, 0.5f).size());
+
+    // 発火した時刻から続けて確認しても、もう一度は発火しない
+    EXPECT_TRUE(FireEvents(motion, entry, 0.5f, 0.5f).empty());
+    EXPECT_TRUE(FireEvents(motion, entry, 0.5f, 0.9f).empty());
+
+    // 同じ時刻の直前で止まった場合も、3つとも次の確認で発火する
+    CubismMotionQueueEntry splitEntry;
+    EXPECT_EQ(ScanEvents(0.0f, 0.49f), FireEvents(motion, splitEntry, 0.0f, 0.49f));
+    EXPECT_EQ(ScanEvents(0.49f, 0.5f), FireEvents(motion, splitEntry, 0.49f, 0.5f));
+
+    ACubismMotion::Delete(motion);
+}
+
+TEST(CubismMotionEventTest, BackwardSeekMatchesLinearScan)
+{
+    CubismMotion* motion = CreateEventCursorMotion();
+    ASSERT_TRUE(motion != NULL);
+    CubismMotionQueueEntry entry;
+
+    // 後ろへ戻る確認を含め、どの区間でも全イベントを走査した場合と同じになる
+    const csmFloat32 seeks[][2] = {
+        { 0.0f, 0.3f }, { 0.3f, 0.6f }, { 0.1f, 0.3f }, { 0.3f, 0.5f }, { 0.5f, 1.0f },
+        { 0.0f, 0.05f }, { 0.6f, 0.4f }, { 0.4f, 0.7f }, { -1.0f, 0.0f }, { 0.25f, 0.5f }
+    };
+    for (csmUint32 i = 0; i < sizeof(seeks) / sizeof(seeks[0]); ++i)
+    {
+        EXPECT_EQ(ScanEvents(seeks[i][0], seeks[i][1]), FireEvents(motion, entry, seeks[i][0], seeks[i][1])) << "seek " << i;
+    }
+
+    csmUint32 state = 0x2545F491u;
+    csmFloat32 before = 0.0f;
+    for (csmInt32 i = 0; i < 500; ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        // 多くは少しずつ進め、ときどき任意の位置へ移る
+        const csmFloat32 time = (state % 4 == 0) ? static_cast<csmFloat32>(state % 1200) / 1000.0f - 0.1f
+                                                 : before + static_cast<csmFloat32>(state % 100) / 1000.0f;
+        EXPECT_EQ(ScanEvents(before, time), FireEvents(motion, entry, before, time)) << "step " << i << " " << before << " -> " << time;
+        before = time;
+    }
+
+    ACubismMotion::Delete(motion);
+}
+
+TEST(CubismMotionEventTest, LoopFiresEveryEventOncePerLoop)
+{
+    CubismTest::TestModel model;
+    ASSERT_TRUE(model.LoadAssets(CubismTest::GetBundledModels()[0]));
+
+    CubismMotion* motion = CreateEventCursorMotion();
+    ASSERT_TRUE(motion != NULL);
+    motion->SetLoop(true);
+
+    std::vector<std::string> events;
+    model.GetMotionManager()->SetEventCallback(RecordEvent, &events);
+    model.GetMotionManager()->StartMotionPriority(motion, false, 2);
+
+    // 最初の更新で再生を開始し、以降はループの終端をまたぐたびに前のループの残りと次のループの先頭が発火する。
+    // 終端近くのイベントを確認の前に残すよう、フレームの間隔はループの長さを割り切らない値にする
+    const csmFloat32 frameDelta = 0.07f;
+    const csmInt32 frameCount = 60;
+    model.UpdateSimulation(DeltaTime);
+    for (csmInt32 frame = 0; frame < frameCount; ++frame)
+    {
+        model.UpdateSimulation(frameDelta);
+    }
+
+    const csmFloat32 loopDuration = 1.0f + 1.0f / 30.0f;
+    const csmFloat32 playedTime = frameDelta * static_cast<csmFloat32>(frameCount);
+    EXPECT_EQ(LoopEvents(static_cast<csmInt32>(playedTime / loopDuration), fmodf(playedTime, loopDuration)), events);
+
+    model.GetMotionManager()->StopAllMotions();
+    ACubismMotion::Delete(motion);
+}
+
+TEST(CubismMotionEventTest, DeltaLongerThanLoopFiresRestOfLoopOnce)
+{
+    CubismTest::TestModel model;
+    ASSERT_TRUE(model.LoadAssets(CubismTest::GetBundledModels()[0]));
+
+    CubismMotion* motion = CreateEventCursorMotion();
+    ASSERT_TRUE(motion != NULL);
+    motion->SetLoop(true);
+
+    std::vector<std::string> events;
+    model.GetMotionManager()->SetEventCallback(RecordEvent, &events);
+    model.GetMotionManager()->StartMotionPriority(motion, false, 2);
+
+    model.UpdateSimulation(DeltaTime);
+    model.UpdateSimulation(0.3f);
+    EXPECT_EQ(ScanEvents(0.0f, 0.3f), events);
+
+    // ループ2回分以上進めても、前のループの残りと現在のループの位置までが1回ずつ発火する
+    events.clear();
+    model.UpdateSimulation(2.5f);
+
+    const csmFloat32 loopDuration = 1.0f + 1.0f / 30.0f;
+    const csmFloat32 motionTime = fmodf(2.8f, loopDuration);
+    std::vector<std::string> expected = ScanEvents(0.3f, loopDuration);
+    const std::vector<std::string> current = ScanEvents(0.0f, motionTime);
+    expected.insert(expected.end(), current.begin(), current.end());
+    EXPECT_EQ(expected, events);
+
+    // 続く更新でも重複しない
+    events.clear();
+    model.UpdateSimulation(0.5f);
+    std::vector<std::string> next = ScanEvents(motionTime, loopDuration);
+    const std::vector<std::string> wrapped = ScanEvents(0.0f, motionTime + 0.5f - loopDuration);
+    next.insert(next.end(), wrapped.begin(), wrapped.end());
+    EXPECT_EQ(next, events);
+
+    model.GetMotionManager()->StopAllMotions();
+    ACubismMotion::Delete(motion);
+}
+
+TEST(CubismMotionSharingTest, HandlersArePerPlayback)
+{
+    CubismTest::TestModel firstModel;
+    CubismTest::TestModel secondModel;
+    ASSERT_TRUE(firstModel.LoadAssets(CubismTest::GetBundledModels()[0]));
+    ASSERT_TRUE(secondModel.LoadAssets(CubismTest::GetBundledModels()[0]));
+
+    CubismMotion* motion = CubismMotion::Create(reinterpret_cast<const csmByte*>(EventMotionJson), static_cast<csmSizeInt>(strlen(EventMotionJson)));
+    ASSERT_TRUE(motion != NULL);
+    motion->SetLoop(false);
+
+    s_firstBeganCount = 0;
+    s_firstFinishedCount = 0;
+    s_secondBeganCount = 0;
+    s_secondFinishedCount = 0;
+
+    // 同じモーションを2体で再生し、それぞれの再生にコールバックを設定する
+    CubismMotionQueueEntry* firstEntry = firstModel.GetMotionManager()->GetCubismMotionQueueEntry(firstModel.GetMotionManager()->StartMotionPriority(motion, false, 2));
+    ASSERT_TRUE(firstEntry != NULL);
+    firstEntry->SetBeganMotionHandler(CountFirstBegan);
+    firstEntry->SetFinishedMotionHandler(CountFirstFinished);
+
+    CubismMotionQueueEntry* secondEntry = secondModel.GetMotionManager()->GetCubismMotionQueueEntry(secondModel.GetMotionManager()->StartMotionPriority(motion, false, 2));
+    ASSERT_TRUE(secondEntry != NULL);
+    secondEntry->SetBeganMotionHandler(CountSecondBegan);
+    secondEntry->SetFinishedMotionHandler(CountSecondFinished);
+
+    for (csmInt32 frame = 0; frame < 60; ++frame)
+    {
+        firstModel.UpdateSimulation(DeltaTime);
+        secondModel.UpdateSimulation(DeltaTime);
+    }
+
+    // 後から設定したコールバックが先の再生のコールバックを上書きしない
+    EXPECT_EQ(1, s_firstBeganCount);
+    EXPECT_EQ(1, s_firstFinishedCount);
+    EXPECT_EQ(1, s_secondBeganCount);
+    EXPECT_EQ(1, s_secondFinishedCount);
+    EXPECT_TRUE(motion->GetBeganMotionHandler() == NULL);
+    EXPECT_TRUE(motion->GetFinishedMotionHandler() == NULL);
+
+    // モーションに設定したコールバックは、以降に開始した再生の初期値になる
+    motion->SetBeganMotionHandler(CountFirstBegan);
+    CubismMotionQueueEntry* thirdEntry = secondModel.GetMotionManager()->GetCubismMotionQueueEntry(secondModel.GetMotionManager()->StartMotionPriority(motion, false, 2));
+    ASSERT_TRUE(thirdEntry != NULL);
+    EXPECT_TRUE(thirdEntry->GetBeganMotionHandler() == CountFirstBegan);
+    EXPECT_TRUE(thirdEntry->GetFinishedMotionHandler() == NULL);
+
+    firstModel.GetMotionManager()->StopAllMotions();
+    secondModel.GetMotionManager()->StopAllMotions();
+    ACubismMotion::Delete(motion);
+}
+
+INSTANTIATE_TEST_SUITE_P(BundledModels, CubismMotionTest, ::testing::ValuesIn(CubismTest::GetBundledModels()), CubismTest::BundledModelName());
@@ -0,0 +1,363 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <set>
+#include <thread>
+#include <vector>
+#include <Physics/CubismPhysics.hpp>
+#include <Physics/CubismPhysicsJson.hpp>
+#include "CubismTestModel.hpp"
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+const csmInt32 FrameCount = 600;
+
+/// Moves every parameter along its own sine wave, so that all physics inputs keep changing.
+void DriveParameters(CubismModel* model, csmInt32 frame)
+{
+    for (csmInt32 i = 0; i < model->GetParameterCount(); ++i)
+    {
+        const csmFloat32 minimum = model->GetParameterMinimumValue(i);
+        const csmFloat32 maximum = model->GetParameterMaximumValue(i);
+        const csmFloat32 phase = static_cast<csmFloat32>(frame) * (0.05f + 0.013f * static_cast<csmFloat32>(i % 7)) + static_cast<csmFloat32>(i);
+        model->SetParameterValue(i, minimum + (maximum - minimum) * (0.5f + 0.5f * sinf(phase)));
+    }
+}
+
+/// Frame times of a display running at roughly 60 fps with occasional hitches.
+csmFloat32 GetDeltaTime(csmInt32 frame)
+{
+    if (frame % 97 == 0)
+    {
+        return 0.05f;
+    }
+
+    return (frame % 3 == 0) ? 1.0f / 50.0f : 1.0f / 60.0f;
+}
+
+/// Parameters referenced by the inputs or outputs of the physics3.json.
+std::set<csmInt32> GetPhysicsParameterIndices(const std::vector<csmByte>& physicsJson, CubismModel* model)
+{
+    std::set<csmInt32> indices;
+    CubismPhysicsJson json(&physicsJson[0], static_cast<csmSizeInt>(physicsJson.size()));
+
+    for (csmInt32 setting = 0; setting < json.GetSubRigCount(); ++setting)
+    {
+        for (csmInt32 i = 0; i < json.GetInputCount(setting); ++i)
+        {
+            indices.insert(model->GetParameterIndex(json.GetInputSourceId(setting, i)));
+        }
+        for (csmInt32 i = 0; i < json.GetOutputCount(setting); ++i)
+        {
+            indices.insert(model->GetParameterIndex(json.GetOutputsDestinationId(setting, i)));
+        }
+    }
+
+    return indices;
+}
+
+class CubismPhysicsTest : public ::testing::TestWithParam<CubismTest::BundledModel>
+{
+protected:
+    /// Loads the model and its physics3.json. Returns false if the model has no physics.
+    bool LoadModel(CubismTest::TestModel& model, std::vector<csmByte>& physicsJson)
+    {
+        const CubismTest::BundledModel& bundledModel = GetParam();
+        if (!model.LoadAssets(bundledModel))
+        {
+            ADD_FAILURE() << "Failed to load " << bundledModel.Name;
+            return false;
+        }
+
+        const csmChar* fileName = model.GetModelSetting()->GetPhysicsFileName();
+        return fileName[0] != '\0' && CubismTest::LoadFile(bundledModel.Directory + fileName, physicsJson) && !physicsJson.empty();
+    }
+};
+
+}
+
+TEST_P(CubismPhysicsTest, SparseCacheMatchesDenseCache)
+{
+    CubismTest::TestModel sparseModel;
+    CubismTest::TestModel denseModel;
+    std::vector<csmByte> physicsJson;
+    if (!LoadModel(sparseModel, physicsJson))
+    {
+        GTEST_SKIP() << "The model has no physics.";
+    }
+    std::vector<csmByte> unused;
+    ASSERT_TRUE(LoadModel(denseModel, unused));
+
+    // 全パラメータを重み0で入力に加えると、全パラメータのキャッシュを更新していた以前の処理と同じになる
+    const std::string denseJson = CubismTest::CreateDensePhysicsJson(physicsJson, denseModel.GetModel());
+    ASSERT_FALSE(denseJson.empty());
+
+    CubismPhysics* sparsePhysics = CubismPhysics::Create(&physicsJson[0], static_cast<csmSizeInt>(physicsJson.size()));
+    CubismPhysics* densePhysics = CubismPhysics::Create(reinterpret_cast<const csmByte*>(denseJson.c_str()), static_cast<csmSizeInt>(denseJson.size()));
+    ASSERT_TRUE(sparsePhysics != NULL);
+    ASSERT_TRUE(densePhysics != NULL);
+
+    CubismModel* sparse = sparseModel.GetModel();
+    CubismModel* dense = denseModel.GetModel();
+
+    DriveParameters(sparse, 0);
+    DriveParameters(dense, 0);
+    sparsePhysics->Stabilization(sparse);
+    densePhysics->Stabilization(dense);
+
+    std::vector<csmFloat32> driven(sparse->GetParameterCount());
+    csmInt32 changedCount = 0;
+    for (csmInt32 frame = 1; frame <= FrameCount; ++frame)
+    {
+        DriveParameters(sparse, frame);
+        DriveParameters(dense, frame);
+        for (csmInt32 i = 0; i < sparse->GetParameterCount(); ++i)
+        {
+            driven[i] = sparse->GetParameterValue(i);
+        }
+
+        sparsePhysics->Evaluate(sparse, GetDeltaTime(frame));
+        densePhysics->Evaluate(dense, GetDeltaTime(frame));
+
+        for (csmInt32 i = 0; i < sparse->GetParameterCount(); ++i)
+        {
+            ASSERT_EQ(dense->GetParameterValue(i), sparse->GetParameterValue(i)) << "frame " << frame << " parameter " << sparse->GetParameterId(i)->GetString().GetRawString();
+            changedCount += (sparse->GetParameterValue(i) != driven[i]) ? 1 : 0;
+        }
+    }
+
+    // 物理演算の出力が実際に書き込まれていること
+    EXPECT_GT(changedCount, FrameCount);
+
+    CubismPhysics::Delete(sparsePhysics);
+    CubismPhysics::Delete(densePhysics);
+}
+
+TEST_P(CubismPhysicsTest, LeavesUnreferencedParametersUntouched)
+{
+    CubismTest::TestModel model;
+    std::vector<csmByte> physicsJson;
+    if (!LoadModel(model, physicsJson))
+    {
+        GTEST_SKIP() << "The model has no physics.";
+    }
+
+    CubismModel* cubismModel = model.GetModel();
+    const std::set<csmInt32> referenced = GetPhysicsParameterIndices(physicsJson, cubismModel);
+    CubismPhysics* physics = model.GetPhysics();
+    ASSERT_TRUE(physics != NULL);
+
+    std::vector<csmFloat32> before(cubismModel->GetParameterCount());
+    for (csmInt32 frame = 0; frame < 60; ++frame)
+    {
+        DriveParameters(cubismModel, frame);
+        for (csmInt32 i = 0; i < cubismModel->GetParameterCount(); ++i)
+        {
+            before[i] = cubismModel->GetParameterValue(i);
+        }
+
+        physics->Evaluate(cubismModel, GetDeltaTime(frame));
+
+        for (csmInt32 i = 0; i < cubismModel->GetParameterCount(); ++i)
+        {
+            if (referenced.find(i) == referenced.end())
+            {
+                ASSERT_EQ(before[i], cubismModel->GetParameterValue(i)) << "frame " << frame << " parameter " << i;
+            }
+        }
+    }
+}
+
+TEST_P(CubismPhysicsTest, SharedRigMatchesOwnRig)
+{
+    CubismTest::TestModel sourceModel;
+    CubismTest::TestModel sharedModel;
+    CubismTest::TestModel ownModel;
+    std::vector<csmByte> physicsJson;
+    if (!LoadModel(sourceModel, physicsJson))
+    {
+        GTEST_SKIP() << "The model has no physics.";
+    }
+    std::vector<csmByte> unused;
+    ASSERT_TRUE(LoadModel(sharedModel, unused));
+    ASSERT_TRUE(LoadModel(ownModel, unused));
+
+    CubismPhysics* source = CubismPhysics::Create(&physicsJson[0], static_cast<csmSizeInt>(physicsJson.size()));
+    CubismPhysics* own = CubismPhysics::Create(&physicsJson[0], static_cast<csmSizeInt>(physicsJson.size()));
+    ASSERT_TRUE(source != NULL);
+    ASSERT_TRUE(own != NULL);
+    CubismPhysics* shared = CubismPhysics::CreateShared(source);
+    ASSERT_TRUE(shared != NULL);
+
+    CubismModel* sharing = sharedModel.GetModel();
+    CubismModel* owning = ownModel.GetModel();
+    CubismModel* other = sourceModel.GetModel();
+
+    for (csmInt32 frame = 0; frame < FrameCount; ++frame)
+    {
+        // 共有元は別の入力で動かし、状態が混ざらないことを確かめる
+        DriveParameters(sharing, frame);
+        DriveParameters(owning, frame);
+        DriveParameters(other, frame * 3 + 7);
+
+        shared->Evaluate(sharing, GetDeltaTime(frame));
+        own->Evaluate(owning, GetDeltaTime(frame));
+        if (source != NULL)
+        {
+            source->Evaluate(other, GetDeltaTime(frame));
+        }
+
+        for (csmInt32 i = 0; i < sharing->GetParameterCount(); ++i)
+        {
+            ASSERT_EQ(owning->GetParameterValue(i), sharing->GetParameterValue(i)) << "frame " << frame << " parameter " << i;
+        }
+
+        // 共有元を先に破棄しても設定は残る
+        if (frame == FrameCount / 2)
+        {
+            CubismPhysics::Delete(source);
+            source = NULL;
+        }
+    }
+
+    CubismPhysics::Delete(shared);
+    CubismPhysics::Delete(own);
+}
+
+TEST_P(CubismPhysicsTest, FrozenKeepsLastReducedOutput)
+{
+    CubismTest::TestModel model;
+    std::vector<csmByte> physicsJson;
+    if (!LoadModel(model, physicsJson))
+    {
+        GTEST_SKIP() << "The model has no physics.";
+    }
+
+    CubismPhysics* physics = CubismPhysics::Create(&physicsJson[0], static_cast<csmSizeInt>(physicsJson.size()));
+    ASSERT_TRUE(physics != NULL);
+    CubismModel* cubismModel = model.GetModel();
+
+    // 演算間隔を広げた状態で、演算と演算の間のフレームで止める
+    const csmFloat32 deltaTime = 1.0f / 60.0f;
+    const csmInt32 lastFrame = 62;
+    physics->SetLevelOfDetail(CubismPhysics::LevelOfDetail_Reduced);
+    for (csmInt32 frame = 0; frame <= lastFrame; ++frame)
+    {
+        DriveParameters(cubismModel, frame);
+        physics->Evaluate(cubismModel, deltaTime);
+    }
+
+    std::vector<csmFloat32> reduced(cubismModel->GetParameterCount());
+    for (csmInt32 i = 0; i < cubismModel->GetParameterCount(); ++i)
+    {
+        reduced[i] = cubismModel->GetParameterValue(i);
+    }
+
+    // 演算を止めた後も、最後に補間した出力のまま変わらない
+    physics->SetLevelOfDetail(CubismPhysics::LevelOfDetail_Frozen);
+    for (csmInt32 frame = 0; frame < 10; ++frame)
+    {
+        DriveParameters(cubismModel, lastFrame);
+        physics->Evaluate(cubismModel, deltaTime);
+
+        for (csmInt32 i = 0; i < cubismModel->GetParameterCount(); ++i)
+        {
+            ASSERT_EQ(reduced[i], cubismModel->GetParameterValue(i)) << "frame " << frame << " parameter " << cubismModel->GetParameterId(i)->GetString().GetRawString();
+        }
+    }
+
+    // 物理演算の出力が実際に書き込まれていること
+    DriveParameters(cubismModel, lastFrame);
+    csmInt32 changedCount = 0;
+    for (csmInt32 i = 0; i < cubismModel->GetParameterCount(); ++i)
+    {
+        changedCount += (reduced[i] != cubismModel->GetParameterValue(i)) ? 1 : 0;
+    }
+    EXPECT_GT(changedCount, 0);
+
+    CubismPhysics::Delete(physics);
+}
+
+TEST(CubismPhysicsSharingTest, SharedRigSurvivesConcurrentCreateAndDelete)
+{
+    const CubismTest::BundledModel* bundledModel = CubismTest::FindBundledModel("Hiyori");
+    ASSERT_TRUE(bundledModel != NULL);
+    CubismTest::TestModel sourceModel;
+    CubismTest::TestModel sharedModel;
+    CubismTest::TestModel ownModel;
+    ASSERT_TRUE(sourceModel.LoadAssets(*bundledModel));
+    ASSERT_TRUE(sharedModel.LoadAssets(*bundledModel));
+    ASSERT_TRUE(ownModel.LoadAssets(*bundledModel));
+
+    std::vector<csmByte> physicsJson;
+    ASSERT_TRUE(CubismTest::LoadFile(bundledModel->Directory + sourceModel.GetModelSetting()->GetPhysicsFileName(), physicsJson));
+    CubismPhysics* source = CubismPhysics::Create(&physicsJson[0], static_cast<csmSizeInt>(physicsJson.size()));
+    ASSERT_TRUE(source != NULL);
+
+    // 読み込み処理と同じように、複数のスレッドで共有インスタンスを作っては破棄する
+    const csmInt32 threadCount = 4;
+    std::vector<CubismPhysics*> longLived(threadCount, static_cast<CubismPhysics*>(NULL));
+    std::vector<std::thread> threads;
+    for (csmInt32 i = 0; i < threadCount; ++i)
+    {
+        threads.push_back(std::thread([source, &longLived, i]()
+        {
+            longLived[i] = CubismPhysics::CreateShared(source);
+            for (csmInt32 iteration = 0; iteration < 500; ++iteration)
+            {
+                CubismPhysics::Delete(CubismPhysics::CreateShared(source));
+            }
+        }));
+    }
+    for (csmInt32 i = 0; i < threadCount; ++i)
+    {
+        threads[i].join();
+    }
+
+    // 共有元と長く使うインスタンスを同時に破棄しても、最後の1つが残っている間は設定が解放されない
+    CubismPhysics* shared = CubismPhysics::CreateShared(source);
+    ASSERT_TRUE(shared != NULL);
+    threads.clear();
+    for (csmInt32 i = 0; i < threadCount; ++i)
+    {
+        threads.push_back(std::thread([&longLived, i]()
+        {
+            CubismPhysics::Delete(longLived[i]);
+        }));
+    }
+    CubismPhysics::Delete(source);
+    for (csmInt32 i = 0; i < threadCount; ++i)
+    {
+        threads[i].join();
+    }
+
+    CubismPhysics* own = CubismPhysics::Create(&physicsJson[0], static_cast<csmSizeInt>(physicsJson.size()));
+    ASSERT_TRUE(own != NULL);
+    CubismModel* sharing = sharedModel.GetModel();
+    CubismModel* owning = ownModel.GetModel();
+    for (csmInt32 frame = 0; frame < 60; ++frame)
+    {
+        DriveParameters(sharing, frame);
+        DriveParameters(owning, frame);
+        shared->Evaluate(sharing, GetDeltaTime(frame));
+        own->Evaluate(owning, GetDeltaTime(frame));
+
+        for (csmInt32 i = 0; i < sharing->GetParameterCount(); ++i)
+        {
+            ASSERT_EQ(owning->GetParameterValue(i), sharing->GetParameterValue(i)) << "frame " << frame << " parameter " << i;
+        }
+    }
+
+    CubismPhysics::Delete(shared);
+    CubismPhysics::Delete(own);
+}
+
+INSTANTIATE_TEST_SUITE_P(BundledModels, CubismPhysicsTest, ::testing::ValuesIn(CubismTest::GetBundledModels()), CubismTest::BundledModelName());
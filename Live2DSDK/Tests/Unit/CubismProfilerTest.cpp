@@ -0,0 +1,194 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Utils/CubismProfiler.hpp>
+
+using namespace Live2D::Cubism::Framework;
+using namespace Live2D::Cubism::Framework::Utils;
+
+namespace {
+
+/// Counts the occurrences of text in trace.
+csmInt32 CountOccurrences(const std::string& trace, const std::string& text)
+{
+    csmInt32 count = 0;
+    for (std::string::size_type position = trace.find(text); position != std::string::npos; position = trace.find(text, position + text.size()))
+    {
+        ++count;
+    }
+    return count;
+}
+
+std::string ExportTrace()
+{
+    return CubismProfiler::ExportChromeTrace().GetRawString();
+}
+
+/// Line of the first event with the given name in trace.
+std::string FindEventLine(const std::string& trace, const std::string& name)
+{
+    const std::string::size_type begin = trace.find("{\"name\":\"" + name + "\"");
+    if (begin == std::string::npos)
+    {
+        return std::string();
+    }
+    return trace.substr(begin, trace.find('\n', begin) - begin);
+}
+
+/// Number of distinct thread ids in trace.
+csmInt32 CountThreadIds(const std::string& trace)
+{
+    csmInt32 count = 0;
+    for (csmInt32 tid = 1; tid <= CubismProfiler::MaxThreadCount + 1; ++tid)
+    {
+        if (trace.find("\"tid\":" + std::to_string(tid) + ",") != std::string::npos)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void RecordWorkerZone()
+{
+    CSM_PROFILE_ZONE("Worker");
+}
+
+class CubismProfilerTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        CubismProfiler::BeginCapture();
+    }
+
+    virtual void TearDown()
+    {
+        CubismProfiler::EndCapture();
+        CubismProfiler::Reset();
+    }
+};
+
+}
+
+TEST_F(CubismProfilerTest, RecordsZonesAndCountersUntilEndCapture)
+{
+    {
+        CSM_PROFILE_ZONE("Zone");
+    }
+    CSM_PROFILE_COUNTER_ADD(Counter_DrawCalls, 3);
+    CSM_FREE(CSM_MALLOC(16));
+
+    EXPECT_EQ(3u, CubismProfiler::GetCounter(CubismProfiler::Counter_DrawCalls));
+    EXPECT_GE(CubismProfiler::GetCounter(CubismProfiler::Counter_Allocations), 1u);
+
+    CSM_PROFILE_FRAME();
+    EXPECT_EQ(0u, CubismProfiler::GetCounter(CubismProfiler::Counter_DrawCalls));
+
+    // 記録の終了後は何も記録しない
+    CubismProfiler::EndCapture();
+    {
+        CSM_PROFILE_ZONE("AfterCapture");
+    }
+    CSM_PROFILE_COUNTER_ADD(Counter_DrawCalls, 5);
+    CSM_PROFILE_FRAME();
+
+    const std::string trace = ExportTrace();
+    EXPECT_EQ(1, CountOccurrences(trace, "{\"name\":\"Zone\",\"ph\":\"X\""));
+    EXPECT_EQ(1, CountOccurrences(trace, "{\"name\":\"DrawCalls\",\"ph\":\"C\""));
+    EXPECT_NE(std::string::npos, FindEventLine(trace, "DrawCalls").find("\"args\":{\"value\":3}"));
+    EXPECT_EQ(0, CountOccurrences(trace, "AfterCapture"));
+    EXPECT_EQ(0u, CubismProfiler::GetCounter(CubismProfiler::Counter_DrawCalls));
+
+    // 次の記録は前の記録を含まない
+    CubismProfiler::BeginCapture();
+    EXPECT_EQ(0, CountOccurrences(ExportTrace(), "\"name\":"));
+}
+
+TEST_F(CubismProfilerTest, OverflowKeepsLatestEvents)
+{
+    const csmInt32 overflowCount = 100;
+    for (csmInt32 i = 0; i < overflowCount; ++i)
+    {
+        CubismProfiler::RecordZone("Old", i, i + 1);
+    }
+    for (csmInt32 i = 0; i < CubismProfiler::ThreadEventCapacity; ++i)
+    {
+        CubismProfiler::RecordZone("New", overflowCount + i, overflowCount + i + 1);
+    }
+
+    // 古いイベントから上書きされ、直近のThreadEventCapacity個が残る
+    const std::string trace = ExportTrace();
+    EXPECT_EQ(0, CountOccurrences(trace, "\"name\":\"Old\""));
+    EXPECT_EQ(CubismProfiler::ThreadEventCapacity, CountOccurrences(trace, "\"name\":\"New\""));
+    EXPECT_EQ(1, CountOccurrences(trace, "\"ts\":0.000,"));
+    EXPECT_EQ(0u, CubismProfiler::GetDroppedEventCount());
+}
+
+TEST_F(CubismProfilerTest, ReusesSlotsOfExitedThreads)
+{
+    RecordWorkerZone();
+
+    // 同時に存在するスレッドの数を超えなければ、何個のスレッドが順に記録しても捨てない
+    const csmInt32 threadCount = CubismProfiler::MaxThreadCount * 3;
+    for (csmInt32 i = 0; i < threadCount; ++i)
+    {
+        std::thread(RecordWorkerZone).join();
+    }
+
+    const std::string trace = ExportTrace();
+    EXPECT_EQ(threadCount + 1, CountOccurrences(trace, "\"name\":\"Worker\""));
+    EXPECT_EQ(0u, CubismProfiler::GetDroppedEventCount());
+}
+
+TEST_F(CubismProfilerTest, ConcurrentThreadsUseSeparateSlots)
+{
+    RecordWorkerZone();
+
+    // メインスレッドと合わせて全ての枠を使う
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<csmInt32> recordedCount(0);
+    std::vector<std::thread> threads;
+    for (csmInt32 i = 0; i < CubismProfiler::MaxThreadCount - 1; ++i)
+    {
+        threads.push_back(std::thread([&recordedCount, released]()
+        {
+            RecordWorkerZone();
+            ++recordedCount;
+            released.wait();
+        }));
+    }
+    while (recordedCount.load() < CubismProfiler::MaxThreadCount - 1)
+    {
+        std::this_thread::yield();
+    }
+
+    // 枠が空くまでは記録できない
+    std::thread(RecordWorkerZone).join();
+    EXPECT_EQ(1u, CubismProfiler::GetDroppedEventCount());
+
+    release.set_value();
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    }
+
+    // 終了したスレッドの枠で記録できる
+    std::thread(RecordWorkerZone).join();
+    EXPECT_EQ(1u, CubismProfiler::GetDroppedEventCount());
+
+    const std::string trace = ExportTrace();
+    EXPECT_EQ(CubismProfiler::MaxThreadCount + 1, CountOccurrences(trace, "\"name\":\"Worker\""));
+    EXPECT_EQ(CubismProfiler::MaxThreadCount, CountThreadIds(trace));
+}
@@ -0,0 +1,209 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+#include "CubismGlTestSupport.hpp"
+
+using namespace Live2D::Cubism::Framework;
+using namespace Live2D::Cubism::Framework::Rendering;
+
+namespace {
+
+/// Input of RecordTask.
+struct RecordContext
+{
+    std::vector<CubismTest::GlRenderedModel*>* Models;
+    std::vector<char>* Results;
+};
+
+void RecordTask(void* context, csmInt32 index)
+{
+    RecordContext* recordContext = static_cast<RecordContext*>(context);
+    (*recordContext->Results)[index] = (*recordContext->Models)[index]->Record() ? 1 : 0;
+}
+
+class CubismRenderCommandListTest : public ::testing::TestWithParam<CubismTest::BundledModel>
+{
+protected:
+    virtual void SetUp()
+    {
+        if (!CubismTest::MakeGlContextCurrent())
+        {
+            GTEST_SKIP() << "No OpenGL context is available.";
+        }
+    }
+};
+
+}
+
+TEST_P(CubismRenderCommandListTest, ReplayMatchesDirectDraw)
+{
+    CubismTest::GlRenderedModel direct;
+    CubismTest::GlRenderedModel recorded;
+    ASSERT_TRUE(direct.Load(GetParam()));
+    ASSERT_TRUE(recorded.Load(GetParam()));
+
+    CubismTest::GlRenderTarget target;
+    ASSERT_TRUE(target.IsComplete());
+
+    // 数フレーム分を続けて比べ、マスクを使い回すフレームも含める
+    for (csmInt32 frame = 0; frame < 3; ++frame)
+    {
+        SCOPED_TRACE(frame);
+        direct.Animate(0.5f);
+        recorded.Animate(0.5f);
+
+        target.Begin();
+        direct.Draw();
+        const std::vector<csmByte> expected = target.End();
+
+        ASSERT_TRUE(recorded.Record());
+        target.Begin();
+        recorded.Execute();
+        const std::vector<csmByte> actual = target.End();
+
+        // 何も描画されていない画像同士の一致を合格にしない
+        EXPECT_GT(CubismTest::CountCoveredPixels(expected), CubismTest::GlImageWidth * CubismTest::GlImageHeight / 20);
+        ASSERT_EQ(0, memcmp(&expected[0], &actual[0], expected.size()));
+    }
+    EXPECT_EQ(GL_NO_ERROR, glGetError());
+}
+
+TEST_P(CubismRenderCommandListTest, ReplayDrawsRecordedState)
+{
+    CubismTest::GlRenderedModel direct;
+    CubismTest::GlRenderedModel recorded;
+    ASSERT_TRUE(direct.Load(GetParam()));
+    ASSERT_TRUE(recorded.Load(GetParam()));
+
+    CubismTest::GlRenderTarget target;
+    ASSERT_TRUE(target.IsComplete());
+
+    direct.Animate(1.0f);
+    recorded.Animate(1.0f);
+    ASSERT_TRUE(recorded.Record());
+    const csmUint32 commandCount = recorded.GetCommandList().GetCommandCount();
+    EXPECT_GT(commandCount, 0u);
+
+    // 記録した後にモデルを更新しても、実行結果は記録した時点の状態になる
+    recorded.Animate(0.5f);
+    EXPECT_EQ(commandCount, recorded.GetCommandList().GetCommandCount());
+
+    target.Begin();
+    direct.Draw();
+    const std::vector<csmByte> expected = target.End();
+
+    target.Begin();
+    recorded.Execute();
+    const std::vector<csmByte> actual = target.End();
+
+    ASSERT_EQ(0, memcmp(&expected[0], &actual[0], expected.size()));
+
+    // 記録した後の更新で見た目が変わっていること
+    target.Begin();
+    recorded.Draw();
+    const std::vector<csmByte> updated = target.End();
+
+    EXPECT_NE(0, memcmp(&expected[0], &updated[0], expected.size()));
+}
+
+TEST_P(CubismRenderCommandListTest, ParallelRecordingMatchesDirectDraw)
+{
+    const csmInt32 modelCount = 4;
+    std::vector<CubismTest::GlRenderedModel*> directModels;
+    std::vector<CubismTest::GlRenderedModel*> recordedModels;
+    for (csmInt32 i = 0; i < modelCount; ++i)
+    {
+        directModels.push_back(new CubismTest::GlRenderedModel());
+        recordedModels.push_back(new CubismTest::GlRenderedModel());
+        ASSERT_TRUE(directModels[i]->Load(GetParam()));
+        ASSERT_TRUE(recordedModels[i]->Load(GetParam()));
+
+        // それぞれ異なる姿勢にする
+        directModels[i]->Animate(0.25f * (i + 1));
+        recordedModels[i]->Animate(0.25f * (i + 1));
+        recordedModels[i]->PrepareRecord();
+    }
+
+    // 別々のモデルは描画スレッド以外で同時に記録できる
+    std::vector<char> results(modelCount, 0);
+    RecordContext recordContext;
+    recordContext.Models = &recordedModels;
+    recordContext.Results = &results;
+    CubismTest::ParallelFor(modelCount, &recordContext, RecordTask);
+
+    CubismTest::GlRenderTarget target;
+    ASSERT_TRUE(target.IsComplete());
+    for (csmInt32 i = 0; i < modelCount; ++i)
+    {
+        SCOPED_TRACE(i);
+        ASSERT_EQ(1, results[i]);
+
+        target.Begin();
+        directModels[i]->Draw();
+        const std::vector<csmByte> expected = target.End();
+
+        target.Begin();
+        recordedModels[i]->Execute();
+        const std::vector<csmByte> actual = target.End();
+
+        EXPECT_EQ(0, memcmp(&expected[0], &actual[0], expected.size()));
+    }
+
+    for (csmInt32 i = 0; i < modelCount; ++i)
+    {
+        delete directModels[i];
+        delete recordedModels[i];
+    }
+}
+
+TEST_P(CubismRenderCommandListTest, PreparedRecordingDoesNotAllocate)
+{
+    const csmInt32 modelCount = 4;
+    std::vector<CubismTest::GlRenderedModel*> models;
+    for (csmInt32 i = 0; i < modelCount; ++i)
+    {
+        models.push_back(new CubismTest::GlRenderedModel());
+        ASSERT_TRUE(models[i]->Load(GetParam()));
+    }
+
+    // 記録するコマンドの数が変わるよう、姿勢を変えながら何フレームか記録する
+    for (csmInt32 frame = 0; frame < 3; ++frame)
+    {
+        SCOPED_TRACE(frame);
+
+        for (csmInt32 i = 0; i < modelCount; ++i)
+        {
+            models[i]->Animate(0.25f * (i + frame + 1));
+            models[i]->PrepareRecord();
+        }
+
+        // CubismFrameworkのアロケータはスレッドセーフではないため、同時に記録している間は確保しない
+        std::vector<char> results(modelCount, 0);
+        RecordContext recordContext;
+        recordContext.Models = &models;
+        recordContext.Results = &results;
+        const csmUint64 allocationCount = CubismTest::GetAllocator().GetAllocationCount();
+        CubismTest::ParallelFor(modelCount, &recordContext, RecordTask);
+        EXPECT_EQ(allocationCount, CubismTest::GetAllocator().GetAllocationCount());
+
+        for (csmInt32 i = 0; i < modelCount; ++i)
+        {
+            ASSERT_EQ(1, results[i]);
+            EXPECT_GT(models[i]->GetCommandList().GetCommandCount(), 0u);
+        }
+    }
+
+    for (csmInt32 i = 0; i < modelCount; ++i)
+    {
+        delete models[i];
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(BundledModels, CubismRenderCommandListTest, ::testing::ValuesIn(CubismTest::GetBundledModels()), CubismTest::BundledModelName());
@@ -0,0 +1,332 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+#include <Model/CubismMoc.hpp>
+#include "CubismGlTestSupport.hpp"
+#include "CubismStubMocBuilder.hpp"
+
+using namespace Live2D::Cubism::Framework;
+using namespace Live2D::Cubism::Framework::Rendering;
+
+namespace {
+
+/// Whether a visible drawable is masked.
+bool HasVisibleMaskedDrawable(CubismModel* model)
+{
+    for (csmInt32 i = 0; i < model->GetDrawableCount(); ++i)
+    {
+        if (model->GetDrawableMaskCounts()[i] > 0 && model->GetDrawableDynamicFlagIsVisible(i) && model->GetDrawableOpacity(i) > 0.0f)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Moves every parameter to its minimum or maximum and updates the model.
+/// The mask is drawn only from the drawables whose vertices changed in the last update, so this moves as many as possible.
+void MoveAllParameters(CubismModel* model, bool isMaximum)
+{
+    for (csmInt32 i = 0; i < model->GetParameterCount(); ++i)
+    {
+        model->SetParameterValue(i, isMaximum ? model->GetParameterMaximumValue(i) : model->GetParameterMinimumValue(i));
+    }
+    model->Update();
+}
+
+/// Pixels of every mask buffer of the renderer.
+std::vector<csmByte> ReadMaskBuffers(CubismRenderer_OpenGLES2* renderer)
+{
+    std::vector<csmByte> pixels;
+    for (csmInt32 i = 0; i < renderer->GetRenderTextureCount(); ++i)
+    {
+        CubismOffscreenSurface_OpenGLES2* maskBuffer = renderer->GetMaskBuffer(i);
+        const std::vector<csmByte>::size_type offset = pixels.size();
+        pixels.resize(offset + maskBuffer->GetBufferWidth() * maskBuffer->GetBufferHeight() * 4);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, maskBuffer->GetRenderTexture());
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, maskBuffer->GetBufferWidth(), maskBuffer->GetBufferHeight(), GL_RGBA, GL_UNSIGNED_BYTE, &pixels[offset]);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+    return pixels;
+}
+
+/// Draws the model directly, or records it and executes the command list.
+void DrawModel(CubismTest::GlRenderedModel& model, bool isRecorded)
+{
+    if (isRecorded)
+    {
+        model.Record();
+        model.Execute();
+    }
+    else
+    {
+        model.Draw();
+    }
+}
+
+class CubismRendererOpenGLES2Test : public ::testing::TestWithParam<CubismTest::BundledModel>
+{
+protected:
+    virtual void SetUp()
+    {
+        if (!CubismTest::MakeGlContextCurrent())
+        {
+            GTEST_SKIP() << "No OpenGL context is available.";
+        }
+    }
+};
+
+/// Margin around the model bounds used by LAppModel::IsInViewport (LAppDefine::OffscreenModelMargin).
+const csmFloat32 OffscreenModelMargin = 0.1f;
+
+/// One drawable that ParamMove moves from the centre of the canvas (0) to beyond its right edge (1).
+/// The stub moves the bottom row by only a quarter of the delta, so the delta is large enough for that row and the margin to leave too.
+/// At 0.25 the drawable straddles the right edge of the canvas.
+std::vector<csmByte> BuildMovingDrawableMoc()
+{
+    CubismStubMocBuilder builder;
+    const csmInt32 parameter = builder.AddParameter("ParamMove", 0.0f, 1.0f, 0.0f);
+    const csmInt32 part = builder.AddPart("PartBody");
+
+    CubismStubMocBuilder::Drawable drawable = CubismStubMocBuilder::CreateGrid("ArtMeshBody", -0.25f, -0.25f, 0.25f, 0.25f, 2, 2);
+    drawable.ParentPartIndex = part;
+
+    CubismStubMocBuilder::Binding binding;
+    binding.ParameterIndex = parameter;
+    binding.DeltaX = 8.0f;
+    binding.DeltaY = 0.0f;
+    drawable.Bindings.push_back(binding);
+    builder.AddDrawable(drawable);
+
+    return builder.Build();
+}
+
+class CubismRendererOpenGLES2CullingTest : public ::testing::Test
+{
+protected:
+    CubismRendererOpenGLES2CullingTest()
+        : _moc(NULL)
+        , _model(NULL)
+        , _renderer(NULL)
+        , _texture(0)
+    { }
+
+    virtual void SetUp()
+    {
+        if (!CubismTest::MakeGlContextCurrent())
+        {
+            GTEST_SKIP() << "No OpenGL context is available.";
+        }
+
+        _mocBuffer = BuildMovingDrawableMoc();
+        _moc = CubismMoc::Create(&_mocBuffer[0], static_cast<csmSizeInt>(_mocBuffer.size()));
+        ASSERT_TRUE(_moc != NULL);
+        _model = _moc->CreateModel();
+        ASSERT_TRUE(_model != NULL);
+        _model->Update();
+
+        const std::vector<csmByte> pixels(4 * 4 * 4, 255);
+        glGenTextures(1, &_texture);
+        glBindTexture(GL_TEXTURE_2D, _texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 4, 4, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        _renderer = static_cast<CubismRenderer_OpenGLES2*>(CubismRenderer::Create());
+        _renderer->Initialize(_model);
+        _renderer->IsPremultipliedAlpha(true);
+        _renderer->BindTexture(0, _texture);
+
+        // キャンバスの1単位が画面全体になる
+        _mvp.Scale(2.0f, 2.0f);
+    }
+
+    virtual void TearDown()
+    {
+        if (_renderer != NULL)
+        {
+            CubismRenderer::Delete(_renderer);
+        }
+        if (_texture != 0)
+        {
+            glDeleteTextures(1, &_texture);
+        }
+        if (_model != NULL)
+        {
+            _moc->DeleteModel(_model);
+        }
+        if (_moc != NULL)
+        {
+            CubismMoc::Delete(_moc);
+        }
+    }
+
+    /// Runs one frame the way NYLDModelManager does and returns the number of pixels drawn.
+    /// A model outside the viewport is updated and its bounds recomputed without drawing (LAppModel::UpdateOffscreen).
+    csmUint32 RunFrame(CubismTest::GlRenderTarget& target, csmFloat32 move, bool isRecorded, bool& isDrawn)
+    {
+        _model->SetParameterValue(0, move);
+        _model->Update();
+
+        isDrawn = _renderer->IsInViewport(_mvp, OffscreenModelMargin);
+        if (!isDrawn)
+        {
+            _renderer->UpdateModelBounds();
+            return 0;
+        }
+
+        _renderer->SetMvpMatrix(&_mvp);
+        target.Begin();
+        if (isRecorded)
+        {
+            _renderer->RecordDrawModel(_commandList);
+            _renderer->ExecuteCommandList(_commandList);
+        }
+        else
+        {
+            _renderer->DrawModel();
+        }
+        return CubismTest::CountCoveredPixels(target.End());
+    }
+
+    std::vector<csmByte> _mocBuffer;
+    CubismMoc* _moc;
+    CubismModel* _model;
+    CubismRenderer_OpenGLES2* _renderer;
+    CubismRenderCommandList _commandList;
+    GLuint _texture;
+    CubismMatrix44 _mvp;
+};
+
+}
+
+TEST_P(CubismRendererOpenGLES2Test, MaskIsRegeneratedWhenMaskDrawableChanges)
+{
+    CubismTest::GlRenderTarget target;
+    ASSERT_TRUE(target.IsComplete());
+
+    // 直接描画する場合とコマンドリストを通す場合の両方で確かめる
+    for (csmInt32 isRecorded = 0; isRecorded < 2; ++isRecorded)
+    {
+        SCOPED_TRACE(isRecorded ? "recorded" : "direct");
+
+        CubismTest::GlRenderedModel reused;
+        CubismTest::GlRenderedModel reference;
+        ASSERT_TRUE(reused.Load(GetParam()));
+        ASSERT_TRUE(reference.Load(GetParam()));
+
+        CubismModel* model = reused.GetTestModel().GetModel();
+        CubismModel* referenceModel = reference.GetTestModel().GetModel();
+        if (!HasVisibleMaskedDrawable(model))
+        {
+            GTEST_SKIP() << "The model shows no masked drawables.";
+        }
+
+        // 描画オブジェクトの更新フラグもマスクの描画に影響するため、2つのモデルに同じ更新を同じ順に行う
+        MoveAllParameters(model, false);
+        MoveAllParameters(referenceModel, false);
+
+        target.Begin();
+        DrawModel(reused, isRecorded != 0);
+        const std::vector<csmByte> before = target.End();
+        const std::vector<csmByte> beforeMasks = ReadMaskBuffers(reused.GetRenderer());
+        target.Begin();
+        DrawModel(reference, isRecorded != 0);
+        target.End();
+
+        // 何も変わらなければ更新を省略し、生成済みのマスクで同じ画像になる
+        model->Update();
+        referenceModel->Update();
+        ASSERT_TRUE(model->IsUpdateSkipped());
+        target.Begin();
+        DrawModel(reused, isRecorded != 0);
+        ASSERT_EQ(0, memcmp(&before[0], &target.End()[0], before.size()));
+        target.Begin();
+        DrawModel(reference, isRecorded != 0);
+        target.End();
+
+        // マスクの描画オブジェクトが動いたらマスクを作り直し、マスクを必ず作り直すレンダラと同じ画像になる
+        MoveAllParameters(model, true);
+        MoveAllParameters(referenceModel, true);
+        ASSERT_FALSE(model->IsUpdateSkipped());
+
+        target.Begin();
+        DrawModel(reused, isRecorded != 0);
+        const std::vector<csmByte> actual = target.End();
+
+        // 同じサイズを設定し直すと、比べる側のレンダラはマスクを必ず作り直す
+        const CubismVector2 bufferSize = reference.GetRenderer()->GetClippingMaskBufferSize();
+        reference.GetRenderer()->SetClippingMaskBufferSize(bufferSize.X, bufferSize.Y);
+        target.Begin();
+        DrawModel(reference, isRecorded != 0);
+        const std::vector<csmByte> expected = target.End();
+
+        const std::vector<csmByte> expectedMasks = ReadMaskBuffers(reference.GetRenderer());
+        if (expectedMasks == std::vector<csmByte>(expectedMasks.size(), 255))
+        {
+            GTEST_SKIP() << "The mask drawables leave no mark in the mask buffers.";
+        }
+        EXPECT_TRUE(beforeMasks != expectedMasks);
+        ASSERT_TRUE(expectedMasks == ReadMaskBuffers(reused.GetRenderer()));
+        ASSERT_EQ(0, memcmp(&expected[0], &actual[0], expected.size()));
+    }
+    EXPECT_EQ(GL_NO_ERROR, glGetError());
+}
+
+TEST_F(CubismRendererOpenGLES2CullingTest, ModelLeavingViewportIsCulledAndDrawnAgainOnReturn)
+{
+    CubismTest::GlRenderTarget target;
+    ASSERT_TRUE(target.IsComplete());
+
+    // 直接描画する場合とコマンドリストを通す場合の両方で確かめる
+    for (csmInt32 isRecorded = 0; isRecorded < 2; ++isRecorded)
+    {
+        SCOPED_TRACE(isRecorded ? "recorded" : "direct");
+        bool isDrawn = false;
+
+        // 画面内では描画される
+        EXPECT_GT(RunFrame(target, 0.0f, isRecorded != 0, isDrawn), 0u);
+        EXPECT_TRUE(isDrawn);
+        EXPECT_TRUE(_renderer->IsInViewport(_mvp, OffscreenModelMargin));
+
+        // 画面外に出たフレームは、前回の矩形では画面内なので描画を試み、レンダラが全体を画面外と判定して何も描かない
+        EXPECT_EQ(0u, RunFrame(target, 1.0f, isRecorded != 0, isDrawn));
+        EXPECT_TRUE(isDrawn);
+        if (isRecorded)
+        {
+            EXPECT_EQ(0u, _commandList.GetCommandCount());
+        }
+        EXPECT_FALSE(_renderer->IsInViewport(_mvp, OffscreenModelMargin));
+
+        // 以降は描画せずに更新だけを続ける
+        for (csmInt32 frame = 0; frame < 3; ++frame)
+        {
+            RunFrame(target, 1.0f, isRecorded != 0, isDrawn);
+            EXPECT_FALSE(isDrawn);
+        }
+
+        // 描画していなくても更新で矩形が追従するため、画面の端まで戻った時点で画面内と判定される
+        RunFrame(target, 0.25f, isRecorded != 0, isDrawn);
+        EXPECT_FALSE(isDrawn);
+        EXPECT_TRUE(_renderer->IsInViewport(_mvp, OffscreenModelMargin));
+
+        // 次のフレームから再び描画される
+        EXPECT_GT(RunFrame(target, 0.25f, isRecorded != 0, isDrawn), 0u);
+        EXPECT_TRUE(isDrawn);
+
+        RunFrame(target, 0.0f, isRecorded != 0, isDrawn);
+    }
+    EXPECT_EQ(GL_NO_ERROR, glGetError());
+}
+
+INSTANTIATE_TEST_SUITE_P(BundledModels, CubismRendererOpenGLES2Test, ::testing::ValuesIn(CubismTest::GetBundledModels()), CubismTest::BundledModelName());
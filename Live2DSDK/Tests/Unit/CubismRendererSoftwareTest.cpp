@@ -0,0 +1,424 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <CubismRenderer_Software.hpp>
+#include <Math/CubismMatrix44.hpp>
+#include <Math/CubismModelMatrix.hpp>
+#include <Model/CubismMoc.hpp>
+#include "LAppTextureDecoder.h"
+#include "CubismStubMocBuilder.hpp"
+#include "CubismTestModel.hpp"
+#include "CubismTestSupport.hpp"
+
+using namespace Live2D::Cubism::Framework;
+using namespace Live2D::Cubism::Framework::Rendering;
+
+namespace {
+
+const csmUint32 ImageWidth = 96;
+const csmUint32 ImageHeight = 144;
+
+/// Largest per-channel difference from the golden image that still counts as a match.
+/// Covers rounding differences between the SSE, NEON and scalar pixel paths.
+const csmInt32 ChannelTolerance = 2;
+
+/// Ratio of pixels allowed to exceed ChannelTolerance, for edge pixels whose coverage flips.
+const csmFloat32 MismatchTolerance = 0.002f;
+
+/// Set CSM_TEST_UPDATE_GOLDEN=1 to rewrite the golden images instead of comparing against them.
+bool IsUpdatingGoldenImages()
+{
+    const char* value = getenv("CSM_TEST_UPDATE_GOLDEN");
+    return value != NULL && strcmp(value, "0") != 0;
+}
+
+std::string GetGoldenImagePath(const std::string& modelName)
+{
+    return CubismTest::GetTestDataDirectory() + "Golden/" + modelName + ".png";
+}
+
+/// Loads a bundled model with its textures and renders it with the software renderer.
+class SoftwareRenderedModel
+{
+public:
+    SoftwareRenderedModel()
+        : _renderer(NULL)
+    { }
+
+    ~SoftwareRenderedModel()
+    {
+        if (_renderer != NULL)
+        {
+            CubismRenderer::Delete(_renderer);
+        }
+
+        for (size_t i = 0; i < _textures.size(); ++i)
+        {
+            LAppTextureDecoder::ReleasePixels(_textures[i]);
+        }
+    }
+
+    bool Load(const CubismTest::BundledModel& bundledModel)
+    {
+        if (!_model.LoadAssets(bundledModel))
+        {
+            return false;
+        }
+
+        _renderer = CubismRenderer_Software::Create();
+        _renderer->Initialize(_model.GetModel());
+        _renderer->IsPremultipliedAlpha(true);
+
+        ICubismModelSetting* setting = _model.GetModelSetting();
+        for (csmInt32 i = 0; i < setting->GetTextureCount(); ++i)
+        {
+            std::vector<csmByte> file;
+            if (!CubismTest::LoadFile(bundledModel.Directory + setting->GetTextureFileName(i), file) || file.empty())
+            {
+                return false;
+            }
+
+            LAppTextureDecoder::DecodeJob job;
+            job.fileData = &file[0];
+            job.fileSize = static_cast<csmSizeInt>(file.size());
+            LAppTextureDecoder::DecodePng(job, true);
+            if (job.pixels == NULL)
+            {
+                return false;
+            }
+
+            _textures.push_back(job.pixels);
+            _renderer->BindTexture(i, job.pixels, job.width, job.height);
+        }
+
+        csmMap<csmString, csmFloat32> layout;
+        setting->GetLayoutMap(layout);
+        _model.GetModelMatrix()->SetupFromLayout(layout);
+
+        return true;
+    }
+
+    /// Plays the first motion for the given time at 30 fps, so that parameters, physics and blend modes all take effect.
+    void Animate(csmFloat32 seconds)
+    {
+        _model.StartMotion(0);
+
+        const csmFloat32 deltaTimeSeconds = 1.0f / 30.0f;
+        for (csmFloat32 time = 0.0f; time < seconds; time += deltaTimeSeconds)
+        {
+            _model.UpdateSimulation(deltaTimeSeconds);
+        }
+
+        _model.GetModel()->Update();
+    }
+
+    /// Same layout as LAppFrameExporter::ExportMotion.
+    void Draw(CubismOffscreenSurface_Software& surface, CubismRenderer_Software::ParallelForFunction parallelFor)
+    {
+        CubismModelMatrix* modelMatrix = _model.GetModelMatrix();
+        CubismMatrix44 projection;
+        if (_model.GetModel()->GetCanvasWidth() > 1.0f && surface.GetBufferWidth() < surface.GetBufferHeight())
+        {
+            modelMatrix->SetWidth(2.0f);
+            projection.Scale(1.0f, static_cast<csmFloat32>(surface.GetBufferWidth()) / static_cast<csmFloat32>(surface.GetBufferHeight()));
+        }
+        else
+        {
+            projection.Scale(static_cast<csmFloat32>(surface.GetBufferHeight()) / static_cast<csmFloat32>(surface.GetBufferWidth()), 1.0f);
+        }
+        projection.MultiplyByMatrix(modelMatrix);
+
+        surface.Clear(0.0f, 0.0f, 0.0f, 0.0f);
+        _renderer->SetParallelFor(parallelFor);
+        _renderer->SetRenderTarget(&surface);
+        _renderer->SetMvpMatrix(&projection);
+        _renderer->DrawModel();
+    }
+
+private:
+    CubismTest::TestModel _model;
+    CubismRenderer_Software* _renderer;
+    std::vector<csmByte*> _textures;
+};
+
+/// Size of the image drawn from the synthetic scene.
+const csmUint32 SyntheticImageSize = 32;
+
+/// Largest per-channel difference from the pixels computed by hand.
+/// Covers the 8-bit texture, mask buffer and render target.
+const csmInt32 SyntheticChannelTolerance = 3;
+
+/// Color of the render target before drawing, and of the drawn drawable's texture, in straight alpha.
+const csmFloat32 Background[4] = { 0.2f, 0.4f, 0.6f, 0.8f };
+const csmFloat32 TextureColor[4] = { 0.9f, 0.5f, 0.3f, 0.6f };
+
+const csmFloat32 DrawableOpacity = 0.75f;
+const csmFloat32 MultiplyColor[3] = { 0.8f, 0.6f, 1.0f };
+const csmFloat32 ScreenColor[3] = { 0.1f, 0.2f, 0.0f };
+
+enum MaskMode
+{
+    MaskMode_None = 0,
+    MaskMode_Masked,
+    MaskMode_Inverted
+};
+
+/// One drawable covering the whole canvas, and one invisible drawable covering the left half that masks it.
+std::vector<csmByte> BuildSyntheticMoc(CubismRenderer::CubismBlendMode blendMode, MaskMode maskMode)
+{
+    CubismStubMocBuilder builder;
+
+    CubismStubMocBuilder::Drawable mask = CubismStubMocBuilder::CreateGrid("ArtMeshMask", -0.5f, -0.5f, 0.0f, 0.5f, 1, 1);
+    mask.TextureIndex = 1;
+    mask.DrawOrder = 400;
+    mask.Opacity = 0.0f;
+    const csmInt32 maskIndex = builder.AddDrawable(mask);
+
+    CubismStubMocBuilder::Drawable drawable = CubismStubMocBuilder::CreateGrid("ArtMeshDrawn", -0.5f, -0.5f, 0.5f, 0.5f, 1, 1);
+    drawable.Opacity = DrawableOpacity;
+    drawable.MultiplyColor.X = MultiplyColor[0];
+    drawable.MultiplyColor.Y = MultiplyColor[1];
+    drawable.MultiplyColor.Z = MultiplyColor[2];
+    drawable.ScreenColor.X = ScreenColor[0];
+    drawable.ScreenColor.Y = ScreenColor[1];
+    drawable.ScreenColor.Z = ScreenColor[2];
+    drawable.ConstantFlags |= (blendMode == CubismRenderer::CubismBlendMode_Additive) ? Live2D::Cubism::Core::csmBlendAdditive
+                            : (blendMode == CubismRenderer::CubismBlendMode_Multiplicative) ? Live2D::Cubism::Core::csmBlendMultiplicative
+                            : 0;
+    if (maskMode != MaskMode_None)
+    {
+        drawable.Masks.push_back(maskIndex);
+    }
+    if (maskMode == MaskMode_Inverted)
+    {
+        drawable.ConstantFlags |= Live2D::Cubism::Core::csmIsInvertedMask;
+    }
+    builder.AddDrawable(drawable);
+
+    return builder.Build();
+}
+
+/// Rounds a color in [0, 1] to 8 bits.
+csmByte ToByte(csmFloat32 value)
+{
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return static_cast<csmByte>(value * 255.0f + 0.5f);
+}
+
+/// Pixel computed by hand from the fragment shaders of CubismShader_OpenGLES2 and the blend functions of the blend mode.
+/// maskValue is the mask sampled at the pixel, 1 where the mask drawable covers it.
+void ComputeExpectedPixel(CubismRenderer::CubismBlendMode blendMode, MaskMode maskMode, csmBool isPremultipliedAlpha, csmFloat32 maskValue, csmFloat32* pixel)
+{
+    csmFloat32 source[4];
+    if (isPremultipliedAlpha)
+    {
+        // FragShaderSrcPremultipliedAlpha: the texture and u_baseColor are premultiplied
+        const csmFloat32 alpha = TextureColor[3];
+        for (csmInt32 i = 0; i < 3; ++i)
+        {
+            const csmFloat32 texColor = TextureColor[i] * alpha * MultiplyColor[i];
+            source[i] = (texColor + ScreenColor[i] * alpha - texColor * ScreenColor[i]) * DrawableOpacity;
+        }
+        source[3] = alpha * DrawableOpacity;
+    }
+    else
+    {
+        // FragShaderSrc: vec4(color.rgb * color.a, color.a)
+        const csmFloat32 alpha = TextureColor[3] * DrawableOpacity;
+        for (csmInt32 i = 0; i < 3; ++i)
+        {
+            const csmFloat32 texColor = TextureColor[i] * MultiplyColor[i];
+            source[i] = (texColor + ScreenColor[i] - texColor * ScreenColor[i]) * alpha;
+        }
+        source[3] = alpha;
+    }
+
+    // FragShaderSrcMask・FragShaderSrcMaskInvertedは最後にマスクの値を掛ける
+    const csmFloat32 clip = (maskMode == MaskMode_None) ? 1.0f : (maskMode == MaskMode_Inverted) ? 1.0f - maskValue : maskValue;
+    for (csmInt32 i = 0; i < 4; ++i)
+    {
+        source[i] *= clip;
+    }
+
+    for (csmInt32 i = 0; i < 3; ++i)
+    {
+        switch (blendMode)
+        {
+        case CubismRenderer::CubismBlendMode_Normal:
+        default:
+            pixel[i] = source[i] + Background[i] * (1.0f - source[3]);
+            break;
+        case CubismRenderer::CubismBlendMode_Additive:
+            pixel[i] = source[i] + Background[i];
+            break;
+        case CubismRenderer::CubismBlendMode_Multiplicative:
+            pixel[i] = source[i] * Background[i] + Background[i] * (1.0f - source[3]);
+            break;
+        }
+    }
+    pixel[3] = (blendMode == CubismRenderer::CubismBlendMode_Normal) ? source[3] + Background[3] * (1.0f - source[3]) : Background[3];
+}
+
+class CubismRendererSoftwareTest : public ::testing::TestWithParam<CubismTest::BundledModel>
+{ };
+
+}
+
+TEST_P(CubismRendererSoftwareTest, MatchesGoldenImage)
+{
+    const CubismTest::BundledModel& bundledModel = GetParam();
+
+    SoftwareRenderedModel model;
+    ASSERT_TRUE(model.Load(bundledModel));
+    model.Animate(1.0f);
+
+    CubismOffscreenSurface_Software surface;
+    ASSERT_TRUE(surface.CreateOffscreenSurface(ImageWidth, ImageHeight));
+    model.Draw(surface, NULL);
+
+    const std::string goldenPath = GetGoldenImagePath(bundledModel.Name);
+    if (IsUpdatingGoldenImages())
+    {
+        ASSERT_TRUE(CubismTest::WritePng(goldenPath, surface.GetPixels(), ImageWidth, ImageHeight));
+        return;
+    }
+
+    std::vector<csmByte> file;
+    ASSERT_TRUE(CubismTest::LoadFile(goldenPath, file) && !file.empty()) << goldenPath << " is missing. Run with CSM_TEST_UPDATE_GOLDEN=1 to create it.";
+
+    LAppTextureDecoder::DecodeJob golden;
+    golden.fileData = &file[0];
+    golden.fileSize = static_cast<csmSizeInt>(file.size());
+    LAppTextureDecoder::DecodePng(golden, false);
+    ASSERT_TRUE(golden.pixels != NULL);
+    ASSERT_EQ(static_cast<csmInt32>(ImageWidth), golden.width);
+    ASSERT_EQ(static_cast<csmInt32>(ImageHeight), golden.height);
+
+    const csmUint32 pixelCount = ImageWidth * ImageHeight;
+    const csmByte* actual = surface.GetPixels();
+    csmUint32 mismatchCount = 0;
+    csmUint32 coveredCount = 0;
+    for (csmUint32 i = 0; i < pixelCount; ++i)
+    {
+        csmInt32 maxDifference = 0;
+        for (csmUint32 channel = 0; channel < 4; ++channel)
+        {
+            const csmInt32 difference = abs(static_cast<csmInt32>(actual[i * 4 + channel]) - static_cast<csmInt32>(golden.pixels[i * 4 + channel]));
+            maxDifference = difference > maxDifference ? difference : maxDifference;
+        }
+        mismatchCount += maxDifference > ChannelTolerance ? 1 : 0;
+        coveredCount += actual[i * 4 + 3] > 0 ? 1 : 0;
+    }
+    LAppTextureDecoder::ReleasePixels(golden.pixels);
+
+    // 何も描画されていない画像同士の一致を合格にしない
+    EXPECT_GT(coveredCount, pixelCount / 20);
+    EXPECT_LE(mismatchCount, static_cast<csmUint32>(pixelCount * MismatchTolerance)) << "differs from " << goldenPath;
+}
+
+TEST_P(CubismRendererSoftwareTest, ParallelDrawMatchesSequentialDraw)
+{
+    SoftwareRenderedModel model;
+    ASSERT_TRUE(model.Load(GetParam()));
+    model.Animate(1.0f);
+
+    CubismOffscreenSurface_Software sequential;
+    CubismOffscreenSurface_Software parallel;
+    ASSERT_TRUE(sequential.CreateOffscreenSurface(ImageWidth * 2, ImageHeight * 2));
+    ASSERT_TRUE(parallel.CreateOffscreenSurface(ImageWidth * 2, ImageHeight * 2));
+
+    model.Draw(sequential, NULL);
+    model.Draw(parallel, CubismTest::ParallelFor);
+
+    EXPECT_EQ(0, memcmp(sequential.GetPixels(), parallel.GetPixels(), ImageWidth * 2 * ImageHeight * 2 * 4));
+}
+
+TEST(CubismRendererSoftwareSyntheticTest, MatchesShaderFormulas)
+{
+    const CubismRenderer::CubismBlendMode BlendModes[] = {
+        CubismRenderer::CubismBlendMode_Normal,
+        CubismRenderer::CubismBlendMode_Additive,
+        CubismRenderer::CubismBlendMode_Multiplicative,
+    };
+    const csmChar* BlendModeNames[] = { "normal", "additive", "multiplicative" };
+    const csmChar* MaskModeNames[] = { "unmasked", "masked", "inverted mask" };
+
+    // 一様な色のテクスチャなので、バイリニア補間しても同じ色になる
+    const csmUint32 TextureSize = 4;
+    std::vector<csmByte> maskTexture(TextureSize * TextureSize * 4, 255);
+
+    for (csmInt32 blendIndex = 0; blendIndex < 3; ++blendIndex)
+    {
+        for (csmInt32 maskMode = MaskMode_None; maskMode <= MaskMode_Inverted; ++maskMode)
+        {
+            for (csmInt32 isPremultipliedAlpha = 0; isPremultipliedAlpha < 2; ++isPremultipliedAlpha)
+            {
+                SCOPED_TRACE(std::string(BlendModeNames[blendIndex]) + ", " + MaskModeNames[maskMode] + (isPremultipliedAlpha ? ", premultiplied alpha" : ", straight alpha"));
+
+                const std::vector<csmByte> mocBuffer = BuildSyntheticMoc(BlendModes[blendIndex], static_cast<MaskMode>(maskMode));
+                CubismMoc* moc = CubismMoc::Create(&mocBuffer[0], static_cast<csmSizeInt>(mocBuffer.size()));
+                ASSERT_TRUE(moc != NULL);
+                CubismModel* model = moc->CreateModel();
+                ASSERT_TRUE(model != NULL);
+                model->Update();
+
+                std::vector<csmByte> texture(TextureSize * TextureSize * 4);
+                for (csmUint32 i = 0; i < TextureSize * TextureSize; ++i)
+                {
+                    for (csmInt32 channel = 0; channel < 4; ++channel)
+                    {
+                        const csmFloat32 premultiply = (isPremultipliedAlpha && channel < 3) ? TextureColor[3] : 1.0f;
+                        texture[i * 4 + channel] = ToByte(TextureColor[channel] * premultiply);
+                    }
+                }
+
+                CubismRenderer_Software* renderer = CubismRenderer_Software::Create();
+                renderer->Initialize(model);
+                renderer->IsPremultipliedAlpha(isPremultipliedAlpha != 0);
+                renderer->BindTexture(0, &texture[0], TextureSize, TextureSize);
+                renderer->BindTexture(1, &maskTexture[0], TextureSize, TextureSize);
+
+                // キャンバスの1単位が画面全体になるように描画する
+                CubismOffscreenSurface_Software surface;
+                ASSERT_TRUE(surface.CreateOffscreenSurface(SyntheticImageSize, SyntheticImageSize));
+                surface.Clear(Background[0], Background[1], Background[2], Background[3]);
+                CubismMatrix44 mvp;
+                mvp.Scale(2.0f, 2.0f);
+                renderer->SetRenderTarget(&surface);
+                renderer->SetMvpMatrix(&mvp);
+                renderer->DrawModel();
+
+                // マスクの描画オブジェクトが覆う左半分と、覆わない右半分の中央を調べる
+                const csmUint32 y = SyntheticImageSize / 2;
+                const csmUint32 xs[] = { SyntheticImageSize / 4, SyntheticImageSize * 3 / 4 };
+                for (csmInt32 side = 0; side < 2; ++side)
+                {
+                    SCOPED_TRACE(side == 0 ? "inside the mask" : "outside the mask");
+
+                    csmFloat32 expected[4];
+                    ComputeExpectedPixel(BlendModes[blendIndex], static_cast<MaskMode>(maskMode), isPremultipliedAlpha != 0, side == 0 ? 1.0f : 0.0f, expected);
+
+                    const csmByte* actual = surface.GetPixels() + (y * SyntheticImageSize + xs[side]) * 4;
+                    for (csmInt32 channel = 0; channel < 4; ++channel)
+                    {
+                        EXPECT_NEAR(ToByte(expected[channel]), actual[channel], SyntheticChannelTolerance) << "channel " << channel;
+                    }
+                }
+
+                CubismRenderer::Delete(renderer);
+                moc->DeleteModel(model);
+                CubismMoc::Delete(moc);
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(BundledModels, CubismRendererSoftwareTest, ::testing::ValuesIn(CubismTest::GetBundledModels()), CubismTest::BundledModelName());
@@ -0,0 +1,191 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+#include <CubismShader_OpenGLES2.hpp>
+#include "CubismGlTestSupport.hpp"
+
+using namespace Live2D::Cubism::Framework;
+using namespace Live2D::Cubism::Framework::Rendering;
+
+namespace {
+
+/// Layout of the cache written by SerializeProgramBinaryCache.
+const csmSizeInt CacheHeaderSize = 16;
+const csmSizeInt CacheDriverHashOffset = 4;
+const csmSizeInt CacheEntryCountOffset = 12;
+const csmSizeInt CacheEntryHeaderSize = 16;
+const csmSizeInt CacheEntrySizeOffset = 12;
+
+csmUint32 ReadUint32(const std::vector<csmByte>& cache, csmSizeInt offset)
+{
+    return static_cast<csmUint32>(cache[offset]) |
+           static_cast<csmUint32>(cache[offset + 1]) << 8 |
+           static_cast<csmUint32>(cache[offset + 2]) << 16 |
+           static_cast<csmUint32>(cache[offset + 3]) << 24;
+}
+
+csmUint32 GetEntryCount(const std::vector<csmByte>& cache)
+{
+    return ReadUint32(cache, CacheEntryCountOffset);
+}
+
+/// Offset of the binary of the last entry in the cache.
+csmSizeInt GetLastBinaryOffset(const std::vector<csmByte>& cache)
+{
+    csmSizeInt offset = CacheHeaderSize;
+    for (csmUint32 i = 0; i + 1 < GetEntryCount(cache); ++i)
+    {
+        offset += CacheEntryHeaderSize + ReadUint32(cache, offset + CacheEntrySizeOffset);
+    }
+    return offset + CacheEntryHeaderSize;
+}
+
+class CubismShaderOpenGLES2Test : public ::testing::Test
+{
+protected:
+    CubismShaderOpenGLES2Test()
+        : _isCacheUpdated(false)
+    { }
+
+    virtual void SetUp()
+    {
+        if (!CubismTest::MakeGlContextCurrent())
+        {
+            GTEST_SKIP() << "No OpenGL context is available.";
+        }
+
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        if (formatCount == 0)
+        {
+            GTEST_SKIP() << "The driver cannot retrieve program binaries.";
+        }
+
+        // ソースからコンパイルしたシェーダで描いた画像を正解とする
+        GenerateShaders(std::vector<csmByte>(), _cache);
+        ASSERT_TRUE(_isCacheUpdated);
+        ASSERT_GT(GetEntryCount(_cache), 0u);
+        DrawModel(_expected);
+    }
+
+    virtual void TearDown()
+    {
+        // 他のテストのレンダラがシェーダを作り直せるよう、キャッシュを持たないインスタンスに戻す
+        DeleteShaders();
+    }
+
+    /// Deletes the shader programs and the cache.
+    void DeleteShaders()
+    {
+        // 合成方法の異なるシェーダセットが同じプログラムを共有しており、解放時に同じプログラムを重ねて削除したエラーが残る
+        CubismShader_OpenGLES2::DeleteInstance();
+        while (glGetError() != GL_NO_ERROR)
+        { }
+    }
+
+    /// Creates the shader programs the way the app does at launch, from the given cache if it is not empty.
+    void GenerateShaders(const std::vector<csmByte>& cache, std::vector<csmByte>& output)
+    {
+        DeleteShaders();
+        CubismShader_OpenGLES2* shader = CubismShader_OpenGLES2::GetInstance();
+        if (!cache.empty())
+        {
+            ASSERT_TRUE(shader->DeserializeProgramBinaryCache(&cache[0], cache.size()));
+        }
+
+        shader->PrepareShaderPrograms();
+        EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR), glGetError());
+
+        _isCacheUpdated = shader->IsProgramBinaryCacheUpdated();
+        csmVector<csmByte> serialized;
+        shader->SerializeProgramBinaryCache(serialized);
+        output.assign(serialized.GetPtr(), serialized.GetPtr() + serialized.GetSize());
+    }
+
+    /// Draws the first bundled model with the current shader programs.
+    void DrawModel(std::vector<csmByte>& pixels)
+    {
+        CubismTest::GlRenderTarget target;
+        ASSERT_TRUE(target.IsComplete());
+
+        CubismTest::GlRenderedModel model;
+        ASSERT_TRUE(model.Load(CubismTest::GetBundledModels()[0]));
+        model.Animate(0.0f);
+
+        target.Begin();
+        model.Draw();
+        pixels = target.End();
+        ASSERT_GT(CubismTest::CountCoveredPixels(pixels), 0u);
+    }
+
+    std::vector<csmByte> _cache;
+    std::vector<csmByte> _expected;
+    bool _isCacheUpdated;
+};
+
+}
+
+TEST_F(CubismShaderOpenGLES2Test, StoredBinariesAreLoadedWithoutCompiling)
+{
+    std::vector<csmByte> output;
+    GenerateShaders(_cache, output);
+
+    // 全てバイナリから読み込めた場合はキャッシュを書き出し直さない
+    EXPECT_FALSE(_isCacheUpdated);
+    EXPECT_TRUE(_cache == output);
+
+    std::vector<csmByte> actual;
+    DrawModel(actual);
+    ASSERT_EQ(0, memcmp(&_expected[0], &actual[0], _expected.size()));
+}
+
+TEST_F(CubismShaderOpenGLES2Test, RejectedBinaryIsCompiledAndCacheRebuilt)
+{
+    // 最後のプログラムのバイナリを壊すと、それより前に読み込んだプログラムの後で拒否される
+    std::vector<csmByte> corrupted(_cache);
+    const csmSizeInt binaryOffset = GetLastBinaryOffset(corrupted);
+    for (csmSizeInt i = binaryOffset; i < corrupted.size(); ++i)
+    {
+        corrupted[i] = static_cast<csmByte>(~corrupted[i]);
+    }
+
+    std::vector<csmByte> rebuilt;
+    GenerateShaders(corrupted, rebuilt);
+    EXPECT_TRUE(_isCacheUpdated);
+
+    std::vector<csmByte> actual;
+    DrawModel(actual);
+    ASSERT_EQ(0, memcmp(&_expected[0], &actual[0], _expected.size()));
+
+    // 作り直したキャッシュには、拒否される前に読み込んだプログラムも含まれ、次回は全て読み込める
+    EXPECT_EQ(GetEntryCount(_cache), GetEntryCount(rebuilt));
+
+    std::vector<csmByte> output;
+    GenerateShaders(rebuilt, output);
+    EXPECT_FALSE(_isCacheUpdated);
+    EXPECT_TRUE(rebuilt == output);
+}
+
+TEST_F(CubismShaderOpenGLES2Test, CacheOfAnotherDriverIsReset)
+{
+    std::vector<csmByte> otherDriver(_cache);
+    otherDriver[CacheDriverHashOffset] = static_cast<csmByte>(~otherDriver[CacheDriverHashOffset]);
+
+    std::vector<csmByte> rebuilt;
+    GenerateShaders(otherDriver, rebuilt);
+
+    // 以前のバイナリは使わずにコンパイルし、現在のドライバのキャッシュとして作り直す
+    EXPECT_TRUE(_isCacheUpdated);
+    EXPECT_TRUE(_cache == rebuilt);
+
+    std::vector<csmByte> actual;
+    DrawModel(actual);
+    ASSERT_EQ(0, memcmp(&_expected[0], &actual[0], _expected.size()));
+}
@@ -0,0 +1,36 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include "CubismTestSupport.hpp"
+
+namespace {
+
+/// Starts the framework once for the whole test program.
+class FrameworkEnvironment : public ::testing::Environment
+{
+public:
+    virtual void SetUp()
+    {
+        CubismTest::StartUpFramework();
+    }
+
+    virtual void TearDown()
+    {
+        CubismTest::DisposeFramework();
+    }
+};
+
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new FrameworkEnvironment());
+
+    return RUN_ALL_TESTS();
+}
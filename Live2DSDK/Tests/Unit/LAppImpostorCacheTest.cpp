@@ -0,0 +1,226 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include "LAppImpostorCache.h"
+#include "CubismTestModel.hpp"
+#include "CubismTestSupport.hpp"
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+const csmFloat32 ParameterTolerance = 0.001f;
+const csmFloat32 ScaleTolerance = 0.15f;
+const csmFloat32 SmallModelHeight = 240.0f;
+const csmFloat32 SmallModelRefreshInterval = 0.2f;
+
+const csmFloat32 ViewportWidth = 800.0f;
+const csmFloat32 ViewportHeight = 1200.0f;
+const csmFloat32 DeltaTimeSeconds = 1.0f / 60.0f;
+
+class LAppImpostorCacheTest : public ::testing::Test
+{
+protected:
+    LAppImpostorCacheTest()
+        : _cache(ParameterTolerance, ScaleTolerance, SmallModelHeight, SmallModelRefreshInterval)
+    { }
+
+    virtual void SetUp()
+    {
+        ASSERT_TRUE(_model.LoadAssets(CubismTest::GetBundledModels()[0]));
+    }
+
+    /// View-projection matrix showing the model screenHeight pixels tall, rotated by angle radians and moved by (x, y).
+    CubismMatrix44 MakeMvp(csmFloat32 screenHeight, csmFloat32 angle = 0.0f, csmFloat32 x = 0.0f, csmFloat32 y = 0.0f)
+    {
+        const csmFloat32 scale = 2.0f * screenHeight / (GetModel()->GetCanvasHeight() * ViewportHeight);
+        const csmFloat32 aspect = ViewportHeight / ViewportWidth;
+        const csmFloat32 c = cosf(angle) * scale;
+        const csmFloat32 s = sinf(angle) * scale;
+
+        csmFloat32 array[16] =
+        {
+            aspect * c, s,    0.0f, 0.0f,
+            -aspect * s, c,   0.0f, 0.0f,
+            0.0f, 0.0f,       1.0f, 0.0f,
+            x, y,             0.0f, 1.0f,
+        };
+
+        CubismMatrix44 mvp;
+        mvp.SetMatrix(array);
+        return mvp;
+    }
+
+    LAppImpostorCache::Action Update(CubismMatrix44 mvp, csmFloat32 deltaTimeSeconds = DeltaTimeSeconds)
+    {
+        return _cache.Update(GetModel(), mvp, ViewportWidth, ViewportHeight, deltaTimeSeconds);
+    }
+
+    /// Renders the texture the way LAppImpostor does when the cache asks for it.
+    /// Until the state is first captured, the model counts as changing and is drawn directly once.
+    void Render(CubismMatrix44 mvp)
+    {
+        LAppImpostorCache::Action action = Update(mvp);
+        if (action == LAppImpostorCache::Action_DrawDirect)
+        {
+            action = Update(mvp);
+        }
+        ASSERT_EQ(LAppImpostorCache::Action_Refresh, action);
+        _cache.MarkRendered(GetModel());
+        ASSERT_EQ(LAppImpostorCache::Action_DrawCached, Update(mvp));
+    }
+
+    /// Moves the first parameter by the given amount towards the end of its range furthest away.
+    void MoveParameter(csmFloat32 amount)
+    {
+        const csmFloat32 value = GetModel()->GetParameterValue(0);
+        const csmFloat32 direction = (GetModel()->GetParameterMaximumValue(0) - value > value - GetModel()->GetParameterMinimumValue(0)) ? 1.0f : -1.0f;
+        GetModel()->SetParameterValue(0, value + direction * amount);
+    }
+
+    CubismModel* GetModel()
+    {
+        return _model.GetModel();
+    }
+
+    CubismTest::TestModel _model;
+    LAppImpostorCache _cache;
+};
+
+}
+
+TEST_F(LAppImpostorCacheTest, RefreshesOnceAndThenDrawsCached)
+{
+    // 最初のフレームは状態を記録するだけで直接描画し、次のフレームで描画する
+    const CubismMatrix44 mvp = MakeMvp(800.0f);
+    EXPECT_EQ(LAppImpostorCache::Action_DrawDirect, Update(mvp));
+    EXPECT_EQ(LAppImpostorCache::Action_Refresh, Update(mvp));
+    EXPECT_NEAR(800.0f, _cache.GetScreenHeight(), 0.01f);
+
+    _cache.MarkRendered(GetModel());
+    for (csmInt32 i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(LAppImpostorCache::Action_DrawCached, Update(mvp));
+    }
+
+    // レンダラを作り直した場合などは描き直す
+    _cache.Invalidate();
+    EXPECT_EQ(LAppImpostorCache::Action_Refresh, Update(mvp));
+}
+
+TEST_F(LAppImpostorCacheTest, ParameterChangeDrawsDirectlyUntilModelSettles)
+{
+    const CubismMatrix44 mvp = MakeMvp(800.0f);
+    Render(mvp);
+
+    // 許容範囲内の変化は無視する
+    MoveParameter(ParameterTolerance * 0.5f);
+    EXPECT_EQ(LAppImpostorCache::Action_DrawCached, Update(mvp));
+
+    // 動き続けている間は直接描画する
+    for (csmInt32 i = 0; i < 3; ++i)
+    {
+        MoveParameter(0.1f);
+        EXPECT_EQ(LAppImpostorCache::Action_DrawDirect, Update(mvp));
+    }
+
+    // 止まったフレームで描き直す
+    EXPECT_EQ(LAppImpostorCache::Action_Refresh, Update(mvp));
+    _cache.MarkRendered(GetModel());
+    EXPECT_EQ(LAppImpostorCache::Action_DrawCached, Update(mvp));
+}
+
+TEST_F(LAppImpostorCacheTest, OpacityChangesDrawDirectly)
+{
+    const CubismMatrix44 mvp = MakeMvp(800.0f);
+    ASSERT_GT(GetModel()->GetPartCount(), 0);
+
+    Render(mvp);
+    GetModel()->SetPartOpacity(0, GetModel()->GetPartOpacity(0) > 0.5f ? 0.25f : 0.75f);
+    EXPECT_EQ(LAppImpostorCache::Action_DrawDirect, Update(mvp));
+    EXPECT_EQ(LAppImpostorCache::Action_Refresh, Update(mvp));
+    _cache.MarkRendered(GetModel());
+
+    GetModel()->SetModelOpacity(0.5f);
+    EXPECT_EQ(LAppImpostorCache::Action_DrawDirect, Update(mvp));
+    EXPECT_EQ(LAppImpostorCache::Action_Refresh, Update(mvp));
+}
+
+TEST_F(LAppImpostorCacheTest, MovingOrRotatingKeepsTexture)
+{
+    Render(MakeMvp(800.0f));
+
+    EXPECT_EQ(LAppImpostorCache::Action_DrawCached, Update(MakeMvp(800.0f, 0.0f, 0.5f, -0.25f)));
+    EXPECT_EQ(LAppImpostorCache::Action_DrawCached, Update(MakeMvp(800.0f, 0.5f)));
+    EXPECT_EQ(LAppImpostorCache::Action_DrawCached, Update(MakeMvp(800.0f, 1.5707964f, -0.5f, 0.5f)));
+    EXPECT_NEAR(800.0f, _cache.GetScreenHeight(), 0.01f);
+    EXPECT_EQ(LAppImpostorCache::Action_DrawCached, Update(MakeMvp(800.0f, 3.1415927f)));
+}
+
+TEST_F(LAppImpostorCacheTest, ScaleChangeBeyondToleranceRefreshes)
+{
+    Render(MakeMvp(800.0f));
+
+    EXPECT_EQ(LAppImpostorCache::Action_DrawCached, Update(MakeMvp(800.0f * (1.0f + ScaleTolerance * 0.5f))));
+    EXPECT_EQ(LAppImpostorCache::Action_DrawCached, Update(MakeMvp(800.0f * (1.0f - ScaleTolerance * 0.5f))));
+    EXPECT_EQ(LAppImpostorCache::Action_Refresh, Update(MakeMvp(800.0f * (1.0f + ScaleTolerance * 2.0f))));
+    EXPECT_EQ(LAppImpostorCache::Action_Refresh, Update(MakeMvp(800.0f * (1.0f - ScaleTolerance * 2.0f), 0.5f)));
+}
+
+TEST_F(LAppImpostorCacheTest, SmallModelRefreshesAtInterval)
+{
+    const CubismMatrix44 mvp = MakeMvp(SmallModelHeight * 0.5f);
+    Render(mvp);
+
+    // 動いていてもテクスチャを使い、一定間隔でのみ描き直す
+    csmFloat32 elapsedSeconds = DeltaTimeSeconds;
+    for (csmInt32 frameCount = 0; frameCount < 100; ++frameCount)
+    {
+        MoveParameter(0.01f);
+        const LAppImpostorCache::Action action = Update(mvp, DeltaTimeSeconds);
+        ASSERT_NE(LAppImpostorCache::Action_DrawDirect, action);
+        elapsedSeconds += DeltaTimeSeconds;
+
+        if (action == LAppImpostorCache::Action_Refresh)
+        {
+            break;
+        }
+    }
+    EXPECT_GE(elapsedSeconds, SmallModelRefreshInterval);
+    EXPECT_LT(elapsedSeconds, SmallModelRefreshInterval + DeltaTimeSeconds * 2.0f);
+
+    // 動いていなければ間隔が過ぎても描き直さない
+    _cache.MarkRendered(GetModel());
+    EXPECT_EQ(LAppImpostorCache::Action_DrawCached, Update(mvp, SmallModelRefreshInterval * 2.0f));
+}
+
+TEST(LAppImpostorCacheSupportTest, BlendedModelsAreNotSupported)
+{
+    csmInt32 blendedModelCount = 0;
+    for (std::vector<CubismTest::BundledModel>::size_type i = 0; i < CubismTest::GetBundledModels().size(); ++i)
+    {
+        SCOPED_TRACE(CubismTest::GetBundledModels()[i].Name);
+
+        CubismTest::TestModel testModel;
+        ASSERT_TRUE(testModel.LoadAssets(CubismTest::GetBundledModels()[i]));
+        CubismModel* model = testModel.GetModel();
+
+        csmBool isBlended = false;
+        for (csmInt32 j = 0; j < model->GetDrawableCount(); ++j)
+        {
+            isBlended |= model->GetDrawableBlendMode(j) != Rendering::CubismRenderer::CubismBlendMode_Normal;
+        }
+
+        // 加算・乗算のDrawableは描画先の色と合成するため、透明な背景に描いたテクスチャでは代替できない
+        EXPECT_EQ(!isBlended, LAppImpostorCache::IsSupported(model));
+        blendedModelCount += isBlended ? 1 : 0;
+    }
+
+    EXPECT_GT(blendedModelCount, 0);
+}
@@ -0,0 +1,207 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+#include "LAppTextureDecoder.h"
+#include "CubismTestSupport.hpp"
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+/// Reference of the premultiply kernel: c * (a + 1) >> 8.
+void PremultiplyReference(csmByte* rgba, csmUint32 pixelCount)
+{
+    for (csmUint32 i = 0; i < pixelCount; ++i)
+    {
+        const csmUint32 alpha = rgba[i * 4 + 3] + 1u;
+        rgba[i * 4 + 0] = static_cast<csmByte>((rgba[i * 4 + 0] * alpha) >> 8);
+        rgba[i * 4 + 1] = static_cast<csmByte>((rgba[i * 4 + 1] * alpha) >> 8);
+        rgba[i * 4 + 2] = static_cast<csmByte>((rgba[i * 4 + 2] * alpha) >> 8);
+    }
+}
+
+void AppendUint32(std::vector<csmByte>& output, csmUint32 value)
+{
+    for (csmUint32 i = 0; i < 4; ++i)
+    {
+        output.push_back(static_cast<csmByte>(value >> (i * 8)));
+    }
+}
+
+/// Builds a KTX2 file with one 16-byte block per mip level and a basic data format descriptor carrying the given flags.
+std::vector<csmByte> CreateKtx2(csmUint32 width, csmUint32 height, csmUint32 levelCount, csmByte dfdFlags)
+{
+    const csmByte identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+    const csmUint32 dfdOffset = 80 + levelCount * 24;
+    const csmUint32 dfdLength = 44;
+    const csmUint32 levelSize = 16;
+
+    std::vector<csmByte> file(identifier, identifier + sizeof(identifier));
+    AppendUint32(file, LAppTextureDecoder::VkFormatAstc4x4Unorm);
+    AppendUint32(file, 1);              // typeSize
+    AppendUint32(file, width);
+    AppendUint32(file, height);
+    AppendUint32(file, 0);              // pixelDepth
+    AppendUint32(file, 0);              // layerCount
+    AppendUint32(file, 1);              // faceCount
+    AppendUint32(file, levelCount);
+    AppendUint32(file, 0);              // supercompressionScheme
+    AppendUint32(file, dfdOffset);
+    AppendUint32(file, dfdLength);
+    file.resize(80, 0);                 // kvd・sgdは無し
+
+    for (csmUint32 i = 0; i < levelCount; ++i)
+    {
+        AppendUint32(file, dfdOffset + dfdLength + i * levelSize);
+        AppendUint32(file, 0);
+        AppendUint32(file, levelSize);
+        AppendUint32(file, 0);
+        AppendUint32(file, levelSize);
+        AppendUint32(file, 0);
+    }
+
+    AppendUint32(file, dfdLength);
+    AppendUint32(file, 0);              // vendorId・descriptorType
+    AppendUint32(file, 2 | (40 << 16)); // versionNumber・descriptorBlockSize
+    file.push_back(166);                // colorModel (ASTC)
+    file.push_back(1);                  // colorPrimaries
+    file.push_back(2);                  // transferFunction
+    file.push_back(dfdFlags);
+    file.resize(dfdOffset + dfdLength, 0);
+
+    for (csmUint32 i = 0; i < levelCount * levelSize; ++i)
+    {
+        file.push_back(static_cast<csmByte>(i));
+    }
+
+    return file;
+}
+
+}
+
+TEST(LAppTextureDecoderTest, ParseKtx2ReadsLevelsAndAlphaMode)
+{
+    for (csmByte flags = 0; flags < 2; ++flags)
+    {
+        SCOPED_TRACE(static_cast<csmInt32>(flags));
+
+        const std::vector<csmByte> file = CreateKtx2(16, 8, 3, flags);
+        LAppTextureDecoder::Ktx2Image image;
+        ASSERT_TRUE(LAppTextureDecoder::ParseKtx2(&file[0], static_cast<csmSizeInt>(file.size()), image));
+
+        EXPECT_EQ(static_cast<csmUint32>(LAppTextureDecoder::VkFormatAstc4x4Unorm), image.vkFormat);
+        EXPECT_EQ(16, image.width);
+        EXPECT_EQ(8, image.height);
+        EXPECT_EQ(flags != 0, image.isPremultiplied);
+        ASSERT_EQ(3u, image.levels.GetSize());
+        EXPECT_EQ(4, image.levels[2].width);
+        EXPECT_EQ(2, image.levels[2].height);
+        EXPECT_EQ(16u, image.levels[2].size);
+        EXPECT_EQ(32, image.levels[2].data[0]);
+    }
+
+    // 記述子がファイルの外を指す場合はストレートアルファとして扱う
+    std::vector<csmByte> file = CreateKtx2(16, 8, 1, 1);
+    file[52] = 0xFF;
+    LAppTextureDecoder::Ktx2Image image;
+    ASSERT_TRUE(LAppTextureDecoder::ParseKtx2(&file[0], static_cast<csmSizeInt>(file.size()), image));
+    EXPECT_FALSE(image.isPremultiplied);
+
+    // レベルのデータが途中で切れている場合は受け付けない
+    file.resize(file.size() - 1);
+    EXPECT_FALSE(LAppTextureDecoder::ParseKtx2(&file[0], static_cast<csmSizeInt>(file.size()), image));
+}
+
+TEST(LAppTextureDecoderTest, PremultiplyMatchesReferenceForAllColorAlphaPairs)
+{
+    // 全ての (色, α) の組を、SIMDの幅で割り切れない長さにして端数処理も通す
+    std::vector<csmByte> pixels;
+    for (csmUint32 alpha = 0; alpha < 256; ++alpha)
+    {
+        for (csmUint32 color = 0; color < 256; ++color)
+        {
+            pixels.push_back(static_cast<csmByte>(color));
+            pixels.push_back(static_cast<csmByte>(255 - color));
+            pixels.push_back(static_cast<csmByte>(color ^ alpha));
+            pixels.push_back(static_cast<csmByte>(alpha));
+        }
+    }
+    for (csmUint32 i = 0; i < 7 * 4; ++i)
+    {
+        pixels.push_back(static_cast<csmByte>(i * 37));
+    }
+
+    for (csmUint32 offset = 0; offset < 8; ++offset)
+    {
+        SCOPED_TRACE(offset);
+
+        const csmUint32 pixelCount = static_cast<csmUint32>(pixels.size() / 4) - offset;
+        std::vector<csmByte> expected(pixels.begin() + offset * 4, pixels.end());
+        std::vector<csmByte> actual(expected);
+
+        PremultiplyReference(&expected[0], pixelCount);
+        LAppTextureDecoder::PremultiplyAlpha(&actual[0], pixelCount);
+
+        ASSERT_EQ(expected, actual);
+    }
+}
+
+TEST(LAppTextureDecoderTest, DecodePngBatchMatchesSequentialDecode)
+{
+    const CubismTest::BundledModel* haru = CubismTest::FindBundledModel("Haru");
+    ASSERT_TRUE(haru != NULL);
+
+    const std::vector<std::string> paths = CubismTest::ListFiles(haru->Directory + "Haru.2048/", ".png");
+    ASSERT_FALSE(paths.empty());
+
+    std::vector<std::vector<csmByte> > files(paths.size());
+    std::vector<LAppTextureDecoder::DecodeJob> batch(paths.size());
+    for (std::vector<std::string>::size_type i = 0; i < paths.size(); ++i)
+    {
+        ASSERT_TRUE(CubismTest::LoadFile(paths[i], files[i]));
+        batch[i].fileData = &files[i][0];
+        batch[i].fileSize = static_cast<csmSizeInt>(files[i].size());
+    }
+
+    LAppTextureDecoder::DecodePngBatch(&batch[0], static_cast<csmUint32>(batch.size()), true);
+
+    for (std::vector<std::string>::size_type i = 0; i < paths.size(); ++i)
+    {
+        SCOPED_TRACE(paths[i]);
+
+        LAppTextureDecoder::DecodeJob straight = batch[i];
+        LAppTextureDecoder::DecodePng(straight, false);
+        ASSERT_TRUE(straight.pixels != NULL);
+        ASSERT_TRUE(batch[i].pixels != NULL);
+        ASSERT_EQ(straight.width, batch[i].width);
+        ASSERT_EQ(straight.height, batch[i].height);
+
+        const csmUint32 pixelCount = static_cast<csmUint32>(straight.width * straight.height);
+        PremultiplyReference(straight.pixels, pixelCount);
+        EXPECT_EQ(0, memcmp(straight.pixels, batch[i].pixels, pixelCount * 4));
+
+        LAppTextureDecoder::ReleasePixels(straight.pixels);
+        LAppTextureDecoder::ReleasePixels(batch[i].pixels);
+    }
+}
+
+TEST(LAppTextureDecoderTest, DecodePngFailsOnBrokenData)
+{
+    const csmByte broken[] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A, 0x00 };
+
+    LAppTextureDecoder::DecodeJob job;
+    job.fileData = broken;
+    job.fileSize = sizeof(broken);
+    LAppTextureDecoder::DecodePng(job, true);
+
+    EXPECT_TRUE(job.pixels == NULL);
+    EXPECT_EQ(0, job.width);
+    EXPECT_EQ(0, job.height);
+}
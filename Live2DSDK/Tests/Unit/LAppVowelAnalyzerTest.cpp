@@ -0,0 +1,166 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+#include "LAppVowelAnalyzer.h"
+#include "CubismTestSupport.hpp"
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+/// Feeds the PCM to the analyzer in chunks of chunkSize samples and returns every newly published frame.
+std::vector<LAppVowelAnalyzer::VisemeFrame> Analyze(LAppVowelAnalyzer& analyzer, const std::vector<csmFloat32>& samples, csmUint32 chunkSize)
+{
+    std::vector<LAppVowelAnalyzer::VisemeFrame> frames;
+    csmUint64 lastBlockIndex = analyzer.GetLatestFrame().blockIndex;
+
+    for (std::vector<csmFloat32>::size_type offset = 0; offset < samples.size(); offset += chunkSize)
+    {
+        const csmUint32 count = static_cast<csmUint32>(samples.size() - offset < chunkSize ? samples.size() - offset : chunkSize);
+        analyzer.PushPcm(&samples[offset], count);
+        analyzer.Process();
+
+        const LAppVowelAnalyzer::VisemeFrame& frame = analyzer.GetLatestFrame();
+        if (frame.blockIndex != lastBlockIndex)
+        {
+            frames.push_back(frame);
+            lastBlockIndex = frame.blockIndex;
+        }
+    }
+
+    return frames;
+}
+
+std::vector<std::string> GetVoiceFiles()
+{
+    return CubismTest::ListFiles(CubismTest::GetAssetsDirectory() + "kei_vowels_pro/sounds/", ".wav");
+}
+
+}
+
+TEST(LAppVowelAnalyzerTest, ReturnsEmptyFrameBeforeAnalysis)
+{
+    LAppVowelAnalyzer analyzer;
+    EXPECT_EQ(0u, analyzer.GetLatestFrame().blockIndex);
+
+    analyzer.Initialize(48000);
+    EXPECT_EQ(48000u, analyzer.GetSamplingRate());
+    EXPECT_EQ(0u, analyzer.Process());
+    EXPECT_EQ(0u, analyzer.GetLatestFrame().blockIndex);
+    EXPECT_EQ(0.0f, analyzer.GetLatestFrame().mouthOpen);
+}
+
+TEST(LAppVowelAnalyzerTest, OpensMouthWhileSpeaking)
+{
+    const std::vector<std::string> paths = GetVoiceFiles();
+    ASSERT_FALSE(paths.empty());
+
+    for (std::vector<std::string>::size_type i = 0; i < paths.size(); ++i)
+    {
+        SCOPED_TRACE(paths[i]);
+
+        std::vector<csmFloat32> samples;
+        csmUint32 samplingRate = 0;
+        ASSERT_TRUE(CubismTest::LoadWavMono(paths[i], samples, samplingRate));
+
+        LAppVowelAnalyzer analyzer;
+        analyzer.Initialize(samplingRate, 1.0f);
+
+        // 1ブロックずつ入力するため、ブロックの読み飛ばしは起きない
+        const csmUint32 blockSize = samplingRate / 100;
+        const std::vector<LAppVowelAnalyzer::VisemeFrame> frames = Analyze(analyzer, samples, blockSize);
+        ASSERT_EQ(samples.size() / blockSize, frames.size());
+        EXPECT_EQ(0u, analyzer.GetDroppedSampleCount());
+
+        csmFloat32 maxOpen = 0.0f;
+        csmFloat32 maxWeights[LAppVowelAnalyzer::Vowel_Count] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        for (std::vector<LAppVowelAnalyzer::VisemeFrame>::size_type j = 0; j < frames.size(); ++j)
+        {
+            const LAppVowelAnalyzer::VisemeFrame& frame = frames[j];
+            ASSERT_EQ(j + 1, frame.blockIndex);
+            ASSERT_GE(frame.mouthOpen, 0.0f);
+            ASSERT_LE(frame.mouthOpen, 1.0f);
+
+            for (csmUint32 v = 0; v < LAppVowelAnalyzer::Vowel_Count; ++v)
+            {
+                ASSERT_GE(frame.weights[v], 0.0f);
+                ASSERT_LE(frame.weights[v], 1.0f);
+                maxWeights[v] = frame.weights[v] > maxWeights[v] ? frame.weights[v] : maxWeights[v];
+            }
+            maxOpen = frame.mouthOpen > maxOpen ? frame.mouthOpen : maxOpen;
+        }
+
+        EXPECT_GT(maxOpen, 0.5f);
+
+        // 話している間に複数の母音が現れる
+        csmUint32 vowelCount = 0;
+        for (csmUint32 v = 0; v < LAppVowelAnalyzer::Vowel_Count; ++v)
+        {
+            vowelCount += maxWeights[v] > 0.1f ? 1 : 0;
+        }
+        EXPECT_GE(vowelCount, 2u);
+
+        // 無音を0.5秒入力すると口が閉じる
+        const std::vector<csmFloat32> silence(samplingRate / 2, 0.0f);
+        const std::vector<LAppVowelAnalyzer::VisemeFrame> silentFrames = Analyze(analyzer, silence, blockSize);
+        ASSERT_FALSE(silentFrames.empty());
+        EXPECT_LT(silentFrames.back().mouthOpen, 0.01f);
+    }
+}
+
+TEST(LAppVowelAnalyzerTest, ResultDoesNotDependOnChunkSize)
+{
+    const std::vector<std::string> paths = GetVoiceFiles();
+    ASSERT_FALSE(paths.empty());
+
+    std::vector<csmFloat32> samples;
+    csmUint32 samplingRate = 0;
+    ASSERT_TRUE(CubismTest::LoadWavMono(paths[0], samples, samplingRate));
+
+    LAppVowelAnalyzer blockAnalyzer;
+    blockAnalyzer.Initialize(samplingRate, 1.0f);
+    const std::vector<LAppVowelAnalyzer::VisemeFrame> expected = Analyze(blockAnalyzer, samples, samplingRate / 100);
+
+    // オーディオスレッドのコールバックのように、ブロック長と揃わない長さで入力する
+    LAppVowelAnalyzer chunkAnalyzer;
+    chunkAnalyzer.Initialize(samplingRate, 1.0f);
+    const std::vector<LAppVowelAnalyzer::VisemeFrame> actual = Analyze(chunkAnalyzer, samples, 173);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (std::vector<LAppVowelAnalyzer::VisemeFrame>::size_type i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_EQ(0, memcmp(&expected[i], &actual[i], sizeof(LAppVowelAnalyzer::VisemeFrame))) << "block " << i;
+    }
+}
+
+TEST(LAppVowelAnalyzerTest, InitializeRestartsAnalysis)
+{
+    const std::vector<std::string> paths = GetVoiceFiles();
+    ASSERT_FALSE(paths.empty());
+
+    std::vector<csmFloat32> samples;
+    csmUint32 samplingRate = 0;
+    ASSERT_TRUE(CubismTest::LoadWavMono(paths[0], samples, samplingRate));
+
+    LAppVowelAnalyzer analyzer;
+    analyzer.Initialize(samplingRate, 1.0f);
+    const std::vector<LAppVowelAnalyzer::VisemeFrame> first = Analyze(analyzer, samples, samplingRate / 100);
+
+    // 途中で再初期化しても、新しく作った解析器と同じ結果になる
+    analyzer.Initialize(samplingRate, 1.0f);
+    EXPECT_EQ(0u, analyzer.GetLatestFrame().blockIndex);
+    const std::vector<LAppVowelAnalyzer::VisemeFrame> second = Analyze(analyzer, samples, samplingRate / 100);
+
+    ASSERT_EQ(first.size(), second.size());
+    for (std::vector<LAppVowelAnalyzer::VisemeFrame>::size_type i = 0; i < first.size(); ++i)
+    {
+        ASSERT_EQ(0, memcmp(&first[i], &second[i], sizeof(LAppVowelAnalyzer::VisemeFrame))) << "block " << i;
+    }
+}
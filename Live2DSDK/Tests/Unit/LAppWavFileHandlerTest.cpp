@@ -0,0 +1,136 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "LAppWavFileHandler.h"
+#include "CubismTestSupport.hpp"
+
+using namespace Live2D::Cubism::Framework;
+
+namespace {
+
+const csmUint32 SamplingRate = 16000;
+
+void AppendUint32(std::vector<csmByte>& output, csmUint32 value)
+{
+    for (csmUint32 i = 0; i < 4; ++i)
+    {
+        output.push_back(static_cast<csmByte>(value >> (i * 8)));
+    }
+}
+
+void AppendUint16(std::vector<csmByte>& output, csmUint16 value)
+{
+    output.push_back(static_cast<csmByte>(value));
+    output.push_back(static_cast<csmByte>(value >> 8));
+}
+
+/// Writes a mono 16-bit WAV file whose data chunk header declares declaredSampleCount samples,
+/// followed by the given samples only, as a file cut off while it was being written would be.
+std::string WriteWav(const std::string& name, const std::vector<csmInt16>& samples, csmUint32 declaredSampleCount)
+{
+    std::vector<csmByte> file;
+    file.insert(file.end(), "RIFF", "RIFF" + 4);
+    AppendUint32(file, 36 + declaredSampleCount * 2);
+    file.insert(file.end(), "WAVE", "WAVE" + 4);
+    file.insert(file.end(), "fmt ", "fmt " + 4);
+    AppendUint32(file, 16);
+    AppendUint16(file, 1);                  // リニアPCM
+    AppendUint16(file, 1);                  // チャンネル数
+    AppendUint32(file, SamplingRate);
+    AppendUint32(file, SamplingRate * 2);   // 平均データ速度
+    AppendUint16(file, 2);                  // ブロックサイズ
+    AppendUint16(file, 16);                 // 量子化ビット数
+    file.insert(file.end(), "data", "data" + 4);
+    AppendUint32(file, declaredSampleCount * 2);
+    for (std::vector<csmInt16>::size_type i = 0; i < samples.size(); ++i)
+    {
+        AppendUint16(file, static_cast<csmUint16>(samples[i]));
+    }
+
+    const std::string path = ::testing::TempDir() + name;
+    FILE* output = fopen(path.c_str(), "wb");
+    if (output == NULL)
+    {
+        return std::string();
+    }
+    const bool isWritten = fwrite(&file[0], 1, file.size(), output) == file.size();
+    fclose(output);
+
+    return isWritten ? path : std::string();
+}
+
+/// Sine wave whose amplitude rises over the whole length, so that the RMS depends on the playback position.
+std::vector<csmInt16> CreateRisingTone(csmUint32 sampleCount)
+{
+    std::vector<csmInt16> samples(sampleCount);
+    for (csmUint32 i = 0; i < sampleCount; ++i)
+    {
+        const csmFloat32 amplitude = 30000.0f * static_cast<csmFloat32>(i) / static_cast<csmFloat32>(sampleCount);
+        samples[i] = static_cast<csmInt16>(amplitude * sinf(static_cast<csmFloat32>(i) * 0.2f));
+    }
+    return samples;
+}
+
+}
+
+TEST(LAppWavFileHandlerTest, StopsAtEndOfTruncatedDataChunk)
+{
+    // ヘッダでは3秒分あるが、実際には0.75秒分しか書き込まれていない
+    const std::string path = WriteWav("truncated.wav", CreateRisingTone(SamplingRate * 3 / 4), SamplingRate * 3);
+    ASSERT_FALSE(path.empty());
+
+    LAppWavFileHandler handler;
+    handler.Start(path.c_str());
+    EXPECT_EQ(SamplingRate * 3 / 4, handler.GetWavFileInfo()._samplesPerChannel);
+
+    csmInt32 updateCount = 0;
+    while (handler.Update(1.0f / 8.0f))
+    {
+        EXPECT_GT(handler.GetRms(), 0.0f);
+        ASSERT_LT(++updateCount, 24) << "lip sync did not finish";
+    }
+
+    // 書き込まれた分を再生し終えたところで止まる
+    EXPECT_EQ(6, updateCount);
+    EXPECT_EQ(0.0f, handler.GetRms());
+
+    remove(path.c_str());
+}
+
+TEST(LAppWavFileHandlerTest, LargeDeltaMatchesSmallSteps)
+{
+    const std::string path = WriteWav("tone.wav", CreateRisingTone(SamplingRate), SamplingRate);
+    ASSERT_FALSE(path.empty());
+
+    LAppWavFileHandler stepped;
+    LAppWavFileHandler skipped;
+    stepped.Start(path.c_str());
+    skipped.Start(path.c_str());
+
+    // 1/64秒ずつ進めた場合と、同じ時間を1回で進めた場合で同じRMSになる
+    const csmInt32 stepCount = 51;
+    for (csmInt32 i = 0; i < stepCount; ++i)
+    {
+        ASSERT_TRUE(stepped.Update(1.0f / 64.0f));
+    }
+    ASSERT_TRUE(skipped.Update(static_cast<csmFloat32>(stepCount) / 64.0f));
+
+    EXPECT_GT(skipped.GetRms(), 0.1f);
+    EXPECT_NEAR(stepped.GetRms(), skipped.GetRms(), 1e-5f);
+
+    // 以降の更新も揃ったまま進む
+    ASSERT_TRUE(stepped.Update(1.0f / 64.0f));
+    ASSERT_TRUE(skipped.Update(1.0f / 64.0f));
+    EXPECT_NEAR(stepped.GetRms(), skipped.GetRms(), 1e-5f);
+
+    remove(path.c_str());
+}
@@ -0,0 +1,51 @@
+#!/bin/sh
+#
+# Convert Live2D model textures (texture_XX.png) into KTX2 containers with
+# ASTC payloads and a precomputed mip chain. LAppTextureManager picks up the
+# .ktx2 file placed next to each PNG and falls back to the PNG when the
+# device does not support the format.
+#
+# Requires `toktx` from KTX-Software (https://github.com/KhronosGroup/KTX-Software).
+#
+# Usage: sh convert_textures_to_ktx2.sh [-b 4x4|6x6|8x8] [model dir ...]
+#        (defaults: -b 6x6, every model under Live2DModels.bundle/Resources)
+#
+# Textures must match PREMULTIPLIED_ALPHA_ENABLE: when it is defined, feed
+# premultiplied PNGs to this script, since compressed data cannot be
+# premultiplied at load time.
+
+set -e
+
+BLOCK=6x6
+while getopts "b:" opt; do
+    case $opt in
+        b) BLOCK=$OPTARG ;;
+        *) echo "usage: $0 [-b 4x4|6x6|8x8] [model dir ...]"; exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+case $BLOCK in
+    4x4|6x6|8x8) ;;
+    *) echo "unsupported ASTC block size: $BLOCK"; exit 1 ;;
+esac
+
+if ! command -v toktx >/dev/null 2>&1; then
+    echo "toktx not found. Install KTX-Software first."
+    exit 1
+fi
+
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+if [ $# -eq 0 ]; then
+    set -- "$SCRIPT_DIR"/../Live2DSDK/Assets/Live2DModels.bundle/Resources/*/
+fi
+
+for MODEL_DIR in "$@"; do
+    find "$MODEL_DIR" -name 'texture_*.png' | while read -r PNG; do
+        KTX2="${PNG%.png}.ktx2"
+        echo "$PNG -> $KTX2 (ASTC $BLOCK)"
+        # Linear transfer keeps the format UNORM, matching how the PNGs are uploaded.
+        toktx --t2 --encode astc --astc_blk_d "$BLOCK" --astc_quality thorough \
+              --assign_oetf linear --genmipmap "$KTX2" "$PNG"
+    done
+done